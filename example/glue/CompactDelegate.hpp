@@ -77,8 +77,15 @@ public:
 	void
 	verifyHeap(MM_EnvironmentBase *env, MM_MarkMap *markMap) { }
 
+	/**
+	 * Update the root table, the object table and the thread saved objects to the new
+	 * locations of objects moved by the compact.
+	 *
+	 * @param env[in] the current thread
+	 * @param compactScheme[in] the compact scheme holding the forwarding information
+	 */
 	void
-	fixupRoots(MM_EnvironmentBase *env, MM_CompactScheme *compactScheme) { }
+	fixupRoots(MM_EnvironmentBase *env, MM_CompactScheme *compactScheme);
 
 	void
 	workerCleanupAfterGC(MM_EnvironmentBase *env) { }
@@ -221,6 +221,21 @@ public:
 	{
 		return U_8_MAX;
 	}
+
+	/**
+	 * Returns a key identifying the class of the object, used to learn hot fields from sampled dereferences
+	 * when scavengerLearnHotFields is enabled. Objects with the same key must have the same reference slot layout.
+	 *
+	 * Example objects have no class and every slot holds a reference, so the object size identifies the layout.
+	 *
+	 * @param objectPtr the object
+	 * @return the class key of the object, or 0 if the class can not be identified
+	 */
+	MMINLINE uintptr_t
+	getHotFieldClassKey(omrobjectptr_t objectPtr)
+	{
+		return getObjectSizeInBytesWithHeader(objectPtr);
+	}
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_VLHGC) */
 
 	/**
@@ -88,7 +88,7 @@ MM_VerboseManagerImpl::reconfigureVerboseGC(OMR_VM *omrVM)
 	 */
 	WriterType type = parseWriterType(NULL, filename, 0, 0); /* All parameters other than filename aren't used */
 	if (
-			((type == VERBOSE_WRITER_FILE_LOGGING_SYNCHRONOUS) || (type == VERBOSE_WRITER_FILE_LOGGING_BUFFERED))
+			((type == VERBOSE_WRITER_FILE_LOGGING_SYNCHRONOUS) || (type == VERBOSE_WRITER_FILE_LOGGING_BUFFERED) || (type == VERBOSE_WRITER_FILE_LOGGING_ASYNCHRONOUS) || (type == VERBOSE_WRITER_FILE_LOGGING_BINARY))
 			&& (NULL == strstr(filename, "%p")) && (NULL == strstr(filename, "%pid"))
 		) {
 #define MAX_PID_LENGTH 16
@@ -23,11 +23,15 @@
 #include "EnvironmentBase.hpp"
 #include "GCConfigTest.hpp"
 #include "ObjectAllocationModel.hpp"
+#include "ObjectHistogram.hpp"
+#include "ObjectIterator.hpp"
 #include "ObjectModel.hpp"
 #include "omrExampleVM.hpp"
 #include "omrgc.h"
+#include "ParallelGlobalGC.hpp"
 #include "SlotObject.hpp"
 #include "StandardWriteBarrier.hpp"
+#include "VerboseBinaryDecoder.hpp"
 #include "VerboseWriterChain.hpp"
 
 //#define OMRGCTEST_PRINTFILE
@@ -43,16 +47,40 @@
 const char *gcTests[] = {"fvtest/gctest/configuration/sample_GC_config.xml"
                         , "fvtest/gctest/configuration/test_system_gc.xml"
                         , "fvtest/gctest/configuration/global_GC_config.xml"
+                        , "fvtest/gctest/configuration/async_verbose_GC_config.xml"
+                        , "fvtest/gctest/configuration/binary_verbose_GC_config.xml"
+                        , "fvtest/gctest/configuration/free_list_size_class_index_GC_config.xml"
+                        , "fvtest/gctest/configuration/lock_free_packet_list_GC_config.xml"
+                        , "fvtest/gctest/configuration/marking_prefetch_GC_config.xml"
+#if defined(OMR_GC_SEGREGATED_HEAP)
+                        , "fvtest/gctest/configuration/segregated_size_class_tuning_GC_config.xml"
+                        , "fvtest/gctest/configuration/segregated_lazy_sweep_GC_config.xml"
+#endif
+#if defined(OMR_GC_MODRON_COMPACTION)
+                        , "fvtest/gctest/configuration/compact_increment_GC_config.xml"
+#endif
+#if defined(OMR_GC_LARGE_OBJECT_AREA)
+                        , "fvtest/gctest/configuration/loa_GC_config.xml"
+#endif
 #if defined(OMR_GC_MODRON_CONCURRENT_MARK)
                         , "fvtest/gctest/configuration/optavgpause_GC_config.xml"
+                        , "fvtest/gctest/configuration/optavgpause_pause_target_GC_config.xml"
+                        , "fvtest/gctest/configuration/optavgpause_card_cleaning_batch_GC_config.xml"
 #endif
 #if defined(OMR_GC_MODRON_SCAVENGER)
                         , "fvtest/gctest/configuration/scavenger_GC_config.xml"
                         , "fvtest/gctest/configuration/scavenger_GC_backout_config.xml"
+                        , "fvtest/gctest/configuration/scavenger_pause_target_GC_config.xml"
+                        , "fvtest/gctest/configuration/scavenger_numa_aware_nursery_GC_config.xml"
+                        , "fvtest/gctest/configuration/scavenger_work_stealing_GC_config.xml"
+                        , "fvtest/gctest/configuration/scavenger_remembered_set_prune_GC_config.xml"
 #endif
 #if defined(OMR_GC_MODRON_SCAVENGER) && defined(OMR_GC_MODRON_CONCURRENT_MARK)
                         , "fvtest/gctest/configuration/gencon_GC_config.xml"
                         , "fvtest/gctest/configuration/gencon_GC_backout_config.xml"
+#endif
+#if defined(OMR_GC_MODRON_SCAVENGER) && defined(OMR_GC_MODRON_CONCURRENT_MARK) && defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+                        , "fvtest/gctest/configuration/mark_map_epoch_GC_config.xml"
 #endif
                         };
 
@@ -145,6 +173,9 @@ GCConfigTest::TearDown()
 		exampleVM->objectTable = NULL;
 	}
 
+	/* Shut down collector background threads before the verbose streams they report to are closed */
+	ASSERT_EQ(OMR_GC_ShutdownCollector(exampleVM->_omrVM), OMR_ERROR_NONE);
+
 	/* close verboseManager and clean up verbose files */
 	if (NULL != verboseManager) {
 		verboseManager->closeStreams(env);
@@ -195,8 +226,8 @@ GCConfigTest::TearDown()
 	omr_error_t rc = OMR_Thread_Free(exampleVM->_omrVMThread);
 	ASSERT_EQ(OMR_ERROR_NONE, rc) << "TearDown(): OMR_Thread_Free failed, rc=" << rc;
 
-	/* Shut down collector */
-	ASSERT_EQ(OMR_GC_ShutdownHeapAndCollector(exampleVM->_omrVM), OMR_ERROR_NONE);
+	/* Shut down heap */
+	ASSERT_EQ(OMR_GC_ShutdownHeap(exampleVM->_omrVM), OMR_ERROR_NONE);
 
 	exampleVM->_omrVMThread = NULL;
 
@@ -794,6 +825,73 @@ done:
 	return rt;
 }
 
+typedef struct DecodedVerboseLog {
+	OMRPortLibrary *portLib;
+	char *text;
+	uintptr_t length;
+	uintptr_t size;
+	bool failed;
+} DecodedVerboseLog;
+
+static void
+appendDecodedVerboseLog(void *userData, const char *text, uintptr_t length)
+{
+	DecodedVerboseLog *log = (DecodedVerboseLog *)userData;
+	OMRPORT_ACCESS_FROM_OMRPORT(log->portLib);
+
+	if (log->failed) {
+		return;
+	}
+	if ((log->size - log->length) < length) {
+		uintptr_t size = (0 == log->size) ? 64 * 1024 : log->size;
+		while ((size - log->length) < length) {
+			size *= 2;
+		}
+		char *newText = (char *)omrmem_reallocate_memory(log->text, size, OMRMEM_CATEGORY_MM);
+		if (NULL == newText) {
+			log->failed = true;
+			return;
+		}
+		log->text = newText;
+		log->size = size;
+	}
+	memcpy(log->text + log->length, text, length);
+	log->length += length;
+}
+
+pugi::xml_parse_result
+GCConfigTest::loadVerboseLog(pugi::xml_document *verboseDoc, const char *name)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->portLib);
+
+	if (!MM_VerboseBinaryDecoder::isBinaryFile(gcTestEnv->portLib, name)) {
+		return verboseDoc->load_file(name);
+	}
+
+	/* Logs written with binaryVerboseLogging are decoded back to XML before being queried */
+	pugi::xml_parse_result result;
+	DecodedVerboseLog log = { gcTestEnv->portLib, NULL, 0, 0, false };
+	MM_VerboseBinaryDecoder *decoder = MM_VerboseBinaryDecoder::newInstance(gcTestEnv->portLib, MM_VerboseBinaryDecoder::OUTPUT_XML, appendDecodedVerboseLog, &log);
+	if (NULL == decoder) {
+		result.status = pugi::status_out_of_memory;
+	} else {
+		if (!decoder->decodeFile(name)) {
+			gcTestEnv->log(LEVEL_ERROR, "%s:%d Failed to decode binary verbose log %s.\n", __FILE__, __LINE__, name);
+			result.status = pugi::status_io_error;
+		} else if (log.failed) {
+			result.status = pugi::status_out_of_memory;
+		} else {
+			result = verboseDoc->load_buffer(log.text, log.length);
+		}
+		decoder->kill();
+	}
+	if (NULL != log.text) {
+		omrmem_free_memory(log.text);
+	}
+
+	return result;
+}
+
 #if defined(OMRGCTEST_PRINTFILE)
 void
 printFile(const char *name)
@@ -826,11 +924,14 @@ GCConfigTest::verifyVerboseGC(pugi::xpath_node_set verboseGCs)
 		isFound[i] = false;
 	}
 
+	/* Writers which defer their output (e.g. asyncVerboseLogging) must have written it out before the log is parsed */
+	verboseManager->getWriterChain()->flushPendingOutput(env);
+
 	/* Loop through multiple files if rolling log is enabled */
 	do {
 		pugi::xml_document verboseDoc;
 		if (0 == numOfFiles) {
-			verboseDoc.load_file(verboseFile);
+			loadVerboseLog(&verboseDoc, verboseFile);
 			gcTestEnv->log("Parsing verbose log %s:\n", verboseFile);
 #if defined(OMRGCTEST_PRINTFILE)
 			printFile(verboseFile);
@@ -838,7 +939,7 @@ GCConfigTest::verifyVerboseGC(pugi::xpath_node_set verboseGCs)
 		} else {
 			char currentVerboseFile[MAX_NAME_LENGTH];
 			omrstr_printf(currentVerboseFile, MAX_NAME_LENGTH, "%s.%03zu", verboseFile, seq++);
-			pugi::xml_parse_result result = verboseDoc.load_file(currentVerboseFile);
+			pugi::xml_parse_result result = loadVerboseLog(&verboseDoc, currentVerboseFile);
 			if (pugi::status_file_not_found == result.status) {
 				break;
 			}
@@ -973,9 +1074,175 @@ GCConfigTest::triggerOperation(pugi::xml_node node)
 			}
 			OMRGCTEST_CHECK_RT(rt);
 			verboseManager->getWriterChain()->endOfCycle(env);
+		} else if (0 == strcmp(node.name(), "heapHistogram")) {
+			rt = verifyHeapHistogram();
+			OMRGCTEST_CHECK_RT(rt);
+		} else if (0 == strcmp(node.name(), "heapIntegrity")) {
+			rt = verifyHeapIntegrity();
+			OMRGCTEST_CHECK_RT(rt);
+		}
+	}
+done:
+	return rt;
+}
+
+static void
+countHeapObject(OMR_VMThread *omrVMThread, MM_HeapRegionDescriptor *region, omrobjectptr_t object, void *userData)
+{
+	MM_GCExtensionsBase *extensions = MM_GCExtensionsBase::getExtensions(omrVMThread->_vm);
+	uintptr_t *counts = (uintptr_t *)userData;
+	counts[0] += 1;
+	counts[1] += extensions->objectModel.getConsumedSizeInBytesWithHeader(object);
+}
+
+int32_t
+GCConfigTest::verifyHeapHistogram()
+{
+	int32_t rt = 0;
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	MM_HeapWalker *heapWalker = ((MM_ParallelGlobalGC *)extensions->getGlobalCollector())->getHeapWalker();
+	uintptr_t counts[2] = {0, 0};
+	MM_ObjectHistogram *histogram = MM_ObjectHistogram::newInstance(env, NULL, NULL);
+
+	if (NULL == histogram) {
+		rt = 1;
+		gcTestEnv->log(LEVEL_ERROR, "%s:%d Failed to create object histogram.\n", __FILE__, __LINE__);
+		goto done;
+	}
+
+	/* the serial per object walk is the reference for the parallel, batched walk of the histogram */
+	heapWalker->allObjectsDo(env, countHeapObject, counts, MEMORY_TYPE_RAM, false, false, false);
+	if (!histogram->collect(env, heapWalker, MEMORY_TYPE_RAM, true, true)) {
+		rt = 1;
+		gcTestEnv->log(LEVEL_ERROR, "%s:%d Object histogram is incomplete.\n", __FILE__, __LINE__);
+	} else if ((counts[0] != histogram->getTotalObjectCount()) || (counts[1] != histogram->getTotalBytes())) {
+		rt = 1;
+		gcTestEnv->log(LEVEL_ERROR, "%s:%d Object histogram found %zu objects (%zu bytes), the heap walk found %zu objects (%zu bytes).\n",
+				__FILE__, __LINE__, histogram->getTotalObjectCount(), histogram->getTotalBytes(), counts[0], counts[1]);
+	} else {
+		gcTestEnv->log("Object histogram found %zu objects (%zu bytes) in %zu size buckets.\n",
+				histogram->getTotalObjectCount(), histogram->getTotalBytes(), histogram->getEntryCount());
+	}
+	histogram->kill(env);
+
+done:
+	return rt;
+}
+
+/**
+ * State of a heap integrity check: the start of every object in the heap, in address order.
+ */
+typedef struct HeapIntegrityState {
+	omrobjectptr_t *objects;
+	uintptr_t objectCount;
+	uintptr_t objectCapacity;
+} HeapIntegrityState;
+
+static void
+recordHeapObject(OMR_VMThread *omrVMThread, MM_HeapRegionDescriptor *region, omrobjectptr_t object, void *userData)
+{
+	HeapIntegrityState *state = (HeapIntegrityState *)userData;
+	if (state->objectCount < state->objectCapacity) {
+		state->objects[state->objectCount] = object;
+	}
+	state->objectCount += 1;
+}
+
+static int
+compareObjectAddresses(const void *left, const void *right)
+{
+	uintptr_t leftAddress = (uintptr_t)*(omrobjectptr_t *)left;
+	uintptr_t rightAddress = (uintptr_t)*(omrobjectptr_t *)right;
+	return (leftAddress < rightAddress) ? -1 : ((leftAddress > rightAddress) ? 1 : 0);
+}
+
+static bool
+isHeapObject(HeapIntegrityState *state, omrobjectptr_t object)
+{
+	return NULL != bsearch(&object, state->objects, state->objectCount, sizeof(omrobjectptr_t), compareObjectAddresses);
+}
+
+/**
+ * Check that the heap is walkable, and that every reference held by an object in the heap, by the root table
+ * or by the object table is the start of an object found by the walk. Run after collections which move objects.
+ */
+int32_t
+GCConfigTest::verifyHeapIntegrity()
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->portLib);
+	int32_t rt = 0;
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	MM_HeapWalker *heapWalker = ((MM_ParallelGlobalGC *)extensions->getGlobalCollector())->getHeapWalker();
+	HeapIntegrityState state = {NULL, 0, 0};
+	uintptr_t referenceCount = 0;
+	J9HashTableState tableState;
+
+	/* count, then record, the objects */
+	heapWalker->allObjectsDo(env, recordHeapObject, &state, MEMORY_TYPE_RAM, false, false, false);
+	state.objectCapacity = state.objectCount;
+	state.objects = (omrobjectptr_t *)omrmem_allocate_memory(sizeof(omrobjectptr_t) * (state.objectCapacity + 1), OMRMEM_CATEGORY_MM);
+	if (NULL == state.objects) {
+		rt = 1;
+		gcTestEnv->log(LEVEL_ERROR, "%s:%d Failed to allocate the heap integrity object table.\n", __FILE__, __LINE__);
+		goto done;
+	}
+	state.objectCount = 0;
+	heapWalker->allObjectsDo(env, recordHeapObject, &state, MEMORY_TYPE_RAM, false, false, false);
+	if (state.objectCount != state.objectCapacity) {
+		rt = 1;
+		gcTestEnv->log(LEVEL_ERROR, "%s:%d Heap walks found %zu then %zu objects.\n", __FILE__, __LINE__, state.objectCapacity, state.objectCount);
+		goto done;
+	}
+	qsort(state.objects, state.objectCount, sizeof(omrobjectptr_t), compareObjectAddresses);
+
+	for (uintptr_t i = 0; (0 == rt) && (i < state.objectCount); i++) {
+		GC_ObjectIterator objectIterator(exampleVM->_omrVM, state.objects[i]);
+		GC_SlotObject *slotObject = NULL;
+		while (NULL != (slotObject = objectIterator.nextSlot())) {
+			omrobjectptr_t reference = slotObject->readReferenceFromSlot();
+			if (NULL != reference) {
+				referenceCount += 1;
+				if (!isHeapObject(&state, reference)) {
+					rt = 1;
+					gcTestEnv->log(LEVEL_ERROR, "%s:%d Object %p holds %p, which is not an object in the heap.\n", __FILE__, __LINE__, state.objects[i], reference);
+					break;
+				}
+			}
 		}
 	}
+
+	if (0 == rt) {
+		RootEntry *rootEntry = (RootEntry *)hashTableStartDo(exampleVM->rootTable, &tableState);
+		while (NULL != rootEntry) {
+			if (!isHeapObject(&state, rootEntry->rootPtr)) {
+				rt = 1;
+				gcTestEnv->log(LEVEL_ERROR, "%s:%d Root %s is %p, which is not an object in the heap.\n", __FILE__, __LINE__, rootEntry->name, rootEntry->rootPtr);
+				break;
+			}
+			rootEntry = (RootEntry *)hashTableNextDo(&tableState);
+		}
+	}
+
+	if (0 == rt) {
+		ObjectEntry *objectEntry = (ObjectEntry *)hashTableStartDo(exampleVM->objectTable, &tableState);
+		while (NULL != objectEntry) {
+			if (!isHeapObject(&state, objectEntry->objPtr)) {
+				rt = 1;
+				gcTestEnv->log(LEVEL_ERROR, "%s:%d Object %s is %p, which is not an object in the heap.\n", __FILE__, __LINE__, objectEntry->name, objectEntry->objPtr);
+				break;
+			}
+			objectEntry = (ObjectEntry *)hashTableNextDo(&tableState);
+		}
+	}
+
+	if (0 == rt) {
+		gcTestEnv->log("Heap integrity verified for %zu objects holding %zu references.\n", state.objectCount, referenceCount);
+	}
+
 done:
+	if (NULL != state.objects) {
+		omrmem_free_memory(state.objects);
+	}
 	return rt;
 }
 
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "GCUnitTest.hpp"
+#include "omrgc.h"
+#include "StartupManagerTestExample.hpp"
+
+void
+GCUnitTest::SetUp()
+{
+	MM_StartupManagerTestExample startupManager(exampleVM->_omrVM, getConfigFile());
+
+	/* Initialize heap and collector */
+	omr_error_t rc = OMR_GC_IntializeHeapAndCollector(exampleVM->_omrVM, &startupManager);
+	ASSERT_EQ(OMR_ERROR_NONE, rc) << "SetUp(): OMR_GC_IntializeHeapAndCollector failed, rc=" << rc;
+
+	/* Attach calling thread to the VM */
+	rc = OMR_Thread_Init(exampleVM->_omrVM, NULL, &exampleVM->_omrVMThread, "OMRTestThread");
+	ASSERT_EQ(OMR_ERROR_NONE, rc) << "SetUp(): OMR_Thread_Init failed, rc=" << rc;
+
+	/* Kick off the dispatcher threads */
+	rc = OMR_GC_InitializeDispatcherThreads(exampleVM->_omrVMThread);
+	ASSERT_EQ(OMR_ERROR_NONE, rc) << "SetUp(): OMR_GC_InitializeDispatcherThreads failed, rc=" << rc;
+
+	env = MM_EnvironmentBase::getEnvironment(exampleVM->_omrVMThread);
+	extensions = env->getExtensions();
+}
+
+void
+GCUnitTest::TearDown()
+{
+	ASSERT_EQ(OMR_GC_ShutdownCollector(exampleVM->_omrVM), OMR_ERROR_NONE);
+
+	if (NULL != exampleVM->_omrVMThread) {
+		/* Shut down the dispatcher threads */
+		omr_error_t rc = OMR_GC_ShutdownDispatcherThreads(exampleVM->_omrVMThread);
+		ASSERT_EQ(OMR_ERROR_NONE, rc) << "TearDown(): OMR_GC_ShutdownDispatcherThreads failed, rc=" << rc;
+
+		/* Detach from VM */
+		rc = OMR_Thread_Free(exampleVM->_omrVMThread);
+		ASSERT_EQ(OMR_ERROR_NONE, rc) << "TearDown(): OMR_Thread_Free failed, rc=" << rc;
+		exampleVM->_omrVMThread = NULL;
+	}
+
+	/* Shut down heap */
+	ASSERT_EQ(OMR_GC_ShutdownHeap(exampleVM->_omrVM), OMR_ERROR_NONE);
+
+	env = NULL;
+	extensions = NULL;
+}
@@ -91,8 +91,14 @@ MM_StartupManagerTestExample::parseLanguageOptions(MM_GCExtensionsBase *extensio
 #else
 						gcTestEnv->log(LEVEL_ERROR, "WARNING: GCPolicy=gencon ignored, requires OMR_GC_MODRON_SCAVENGER (see configure_common.mk)\n");
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
+					} else if (0 == j9_cmdla_stricmp(attr.value(), "segregated")) {
+#if defined(OMR_GC_SEGREGATED_HEAP)
+						_useSegregatedGC = true;
+#else
+						gcTestEnv->log(LEVEL_ERROR, "WARNING: GCPolicy=segregated ignored, requires OMR_GC_SEGREGATED_HEAP (see configure_common.mk)\n");
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 					} else  if (0 != j9_cmdla_stricmp(attr.value(), "optavgpause")) {
-						gcTestEnv->log(LEVEL_ERROR, "Failed: Unrecognized GC policy (expected gencon or optavgpause): %s\n", attr.value());
+						gcTestEnv->log(LEVEL_ERROR, "Failed: Unrecognized GC policy (expected gencon, optavgpause or segregated): %s\n", attr.value());
 						result = false;
 					}
 				} else if (0 == strcmp(attr.name(), "concurrentMark")) {
@@ -101,12 +107,95 @@ MM_StartupManagerTestExample::parseLanguageOptions(MM_GCExtensionsBase *extensio
 #else
 					gcTestEnv->log(LEVEL_ERROR, "WARNING: concurrentMark=true ignored, requires OMR_GC_MODRON_CONCURRENT_MARK (see configure_common.mk)\n");
 #endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK)*/
+				} else if (0 == strcmp(attr.name(), "optimizeConcurrentWB")) {
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+					extensions->optimizeConcurrentWB = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+#else
+					gcTestEnv->log(LEVEL_ERROR, "WARNING: optimizeConcurrentWB ignored, requires OMR_GC_MODRON_CONCURRENT_MARK (see configure_common.mk)\n");
+#endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK)*/
+				} else if (0 == strcmp(attr.name(), "concurrentSlack")) {
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+					extensions->concurrentSlack = atoi(attr.value()) * unitSize;
+#else
+					gcTestEnv->log(LEVEL_ERROR, "WARNING: concurrentSlack ignored, requires OMR_GC_MODRON_CONCURRENT_MARK (see configure_common.mk)\n");
+#endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK)*/
+				} else if (0 == strcmp(attr.name(), "cardCleaningBatchSize")) {
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+					extensions->cardCleaningBatchSize = atoi(attr.value());
+#else
+					gcTestEnv->log(LEVEL_ERROR, "WARNING: cardCleaningBatchSize ignored, requires OMR_GC_MODRON_CONCURRENT_MARK (see configure_common.mk)\n");
+#endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK)*/
+				} else if (0 == strcmp(attr.name(), "concurrentFinalPauseTarget")) {
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+					extensions->concurrentFinalPauseTarget = atoi(attr.value());
+#else
+					gcTestEnv->log(LEVEL_ERROR, "WARNING: concurrentFinalPauseTarget ignored, requires OMR_GC_MODRON_CONCURRENT_MARK (see configure_common.mk)\n");
+#endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK)*/
+#if defined(OMR_GC_MODRON_COMPACTION)
+				} else if (0 == strcmp(attr.name(), "compactOnGlobalGC")) {
+					extensions->compactOnGlobalGC = atoi(attr.value());
+					extensions->noCompactOnGlobalGC = 0;
+				} else if (0 == strcmp(attr.name(), "compactIncrementSubAreas")) {
+					extensions->compactIncrementSubAreas = atoi(attr.value());
+#endif /* defined(OMR_GC_MODRON_COMPACTION) */
+				} else if (0 == strcmp(attr.name(), "heapUncommit")) {
+					extensions->heapUncommit = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+				} else if (0 == strcmp(attr.name(), "heapUncommitDelay")) {
+					extensions->heapUncommitDelay = atoi(attr.value());
+				} else if (0 == strcmp(attr.name(), "freeListSizeClassIndex")) {
+					extensions->freeListSizeClassIndex = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+#if defined(OMR_GC_SEGREGATED_HEAP)
+				} else if (0 == strcmp(attr.name(), "sizeClassTuning")) {
+					extensions->sizeClassTuning = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+				} else if (0 == strcmp(attr.name(), "sizeClassTuningWarmupCycles")) {
+					extensions->sizeClassTuningWarmupCycles = atoi(attr.value());
+				} else if (0 == strcmp(attr.name(), "segregatedLazySweep")) {
+					extensions->segregatedLazySweep = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
+				} else if (0 == strcmp(attr.name(), "packetListLockFree")) {
+					extensions->packetListLockFree = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+				} else if (0 == strcmp(attr.name(), "sATBBarrierPacketsThreadOwned")) {
+#if defined(OMR_GC_REALTIME)
+					extensions->sATBBarrierPacketsThreadOwned = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+#else
+					gcTestEnv->log(LEVEL_ERROR, "WARNING: sATBBarrierPacketsThreadOwned ignored, requires OMR_GC_REALTIME (see configure_common.mk)\n");
+#endif /* defined(OMR_GC_REALTIME) */
+				} else if (0 == strcmp(attr.name(), "markingPrefetchDistance")) {
+					extensions->markingPrefetchDistance = atoi(attr.value());
+				} else if (0 == strcmp(attr.name(), "markingCacheMissStats")) {
+					extensions->markingCacheMissStats = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+				} else if (0 == strcmp(attr.name(), "markMapEpochClearing")) {
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+					extensions->markMapEpochClearing = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+#else
+					gcTestEnv->log(LEVEL_ERROR, "WARNING: markMapEpochClearing ignored, requires OMR_GC_MARK_MAP_EPOCH_CLEARING\n");
+#endif /* defined(OMR_GC_MARK_MAP_EPOCH_CLEARING) */
 #if defined(OMR_GC_MODRON_SCAVENGER)
 				} else if (0 == strcmp(attr.name(), "forceBackOut")) {
 					extensions->fvtest_forceScavengerBackout = (0 == j9_cmdla_stricmp(attr.value(), "true"));
 				} else if (0 == strcmp(attr.name(), "forcePoisonEvacuate")) {
 					extensions->fvtest_forcePoisonEvacuate = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+				} else if (0 == strcmp(attr.name(), "scavengerPauseTarget")) {
+					extensions->scavengerPauseTarget = atoi(attr.value());
+				} else if (0 == strcmp(attr.name(), "numaAwareNursery")) {
+					extensions->numaAwareNursery = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+				} else if (0 == strcmp(attr.name(), "scavengerWorkStealing")) {
+					extensions->scavengerWorkStealing = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+				} else if (0 == strcmp(attr.name(), "scavengerConcurrentRememberedSetPrune")) {
+					extensions->scavengerConcurrentRememberedSetPrune = (0 == j9_cmdla_stricmp(attr.value(), "true"));
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
+#if defined(OMR_GC_LARGE_OBJECT_AREA)
+				} else if (0 == strcmp(attr.name(), "largeObjectArea")) {
+					extensions->largeObjectArea = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+				} else if (0 == strcmp(attr.name(), "largeObjectAreaBestFit")) {
+					extensions->largeObjectAreaBestFit = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+#endif /* defined(OMR_GC_LARGE_OBJECT_AREA) */
+				} else if (0 == strcmp(attr.name(), "asyncVerboseLogging")) {
+					extensions->asyncVerboseLogging = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+				} else if (0 == strcmp(attr.name(), "asyncVerboseLoggingBufferSize")) {
+					extensions->asyncVerboseLoggingBufferSize = atoi(attr.value()) * unitSize;
+				} else if (0 == strcmp(attr.name(), "binaryVerboseLogging")) {
+					extensions->binaryVerboseLogging = (0 == j9_cmdla_stricmp(attr.value(), "true"));
 				} else if ((0 == strcmp(attr.name(), "verboseLog")) || (0 == strcmp(attr.name(), "numOfFiles")) || (0 == strcmp(attr.name(), "numOfCycles")) || (0 == strcmp(attr.name(), "sizeUnit"))) {
 				} else {
 					gcTestEnv->log(LEVEL_ERROR, "Failed: Unrecognized option: %s\n", attr.name());
@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "CacheMissCounter.hpp"
+
+#include <gtest/gtest.h>
+
+#define CACHE_TEST_BYTES (4 * 1024 * 1024)
+
+static uint8_t cacheTestBuffer[CACHE_TEST_BYTES];
+
+/**
+ * Touch every cache line of a buffer larger than most last level caches.
+ */
+static uintptr_t
+touchBuffer()
+{
+	uintptr_t sum = 0;
+	for (uintptr_t i = 0; i < CACHE_TEST_BYTES; i += 64) {
+		cacheTestBuffer[i] += 1;
+		sum += cacheTestBuffer[i];
+	}
+	return sum;
+}
+
+/**
+ * A counter either fails every start, without retrying the open, or starts again after every
+ * stop with its counters kept open, accumulating into the caller's totals.
+ */
+TEST(TestCacheMissCounter, StartStopReusesCounters)
+{
+	MM_CacheMissCounter counter;
+	uint64_t references = 0;
+	uint64_t misses = 0;
+
+	if (!counter.start()) {
+		/* performance counters are not permitted here; a failed open is not retried */
+		ASSERT_FALSE(counter.start());
+		counter.tearDown();
+		return;
+	}
+	touchBuffer();
+	counter.stop(&references, &misses);
+	ASSERT_LE(misses, references);
+
+	for (uintptr_t i = 0; i < 8; i++) {
+		uint64_t previousReferences = references;
+		uint64_t previousMisses = misses;
+		ASSERT_TRUE(counter.start());
+		touchBuffer();
+		counter.stop(&references, &misses);
+		ASSERT_GE(references, previousReferences);
+		ASSERT_GE(misses, previousMisses);
+	}
+
+	counter.tearDown();
+	/* counters may be opened again after tearDown */
+	ASSERT_TRUE(counter.start());
+	counter.stop(&references, &misses);
+	counter.tearDown();
+}
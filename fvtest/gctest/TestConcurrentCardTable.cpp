@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+
+#include "omrgcconsts.h"
+#include "omrmodroncore.h"
+
+#include "CardTable.hpp"
+#include "ConcurrentGC.hpp"
+#include "GCUnitTest.hpp"
+#include "Heap.hpp"
+#include "MemorySpace.hpp"
+#include "MemorySubSpace.hpp"
+
+#include <gtest/gtest.h>
+
+#define TEST_RESIZE_SIZE (1024 * 1024)
+
+class TestConcurrentCardTable : public GCUnitTest
+{
+protected:
+	virtual const char *getConfigFile() { return "fvtest/gctest/configuration/card_table_recommit_GC_config.xml"; }
+
+	uintptr_t
+	countDirtyCards(MM_CardTable *cardTable, void *low, void *high)
+	{
+		uintptr_t dirtyCards = 0;
+		Card *highCard = cardTable->heapAddrToCardAddr(env, high);
+		for (Card *card = cardTable->heapAddrToCardAddr(env, low); card < highCard; card++) {
+			if (CARD_CLEAN != *card) {
+				dirtyCards += 1;
+			}
+		}
+		return dirtyCards;
+	}
+};
+
+/*
+ * Card table memory committed for a range of heap stays committed, and keeps its cards, when the
+ * range is contracted without filling a page of cards.  Expanding into the range again while
+ * concurrent mark is running must hand back clean cards.
+ */
+TEST_F(TestConcurrentCardTable, reexpandedHeapHasCleanCards)
+{
+	MM_Heap *heap = extensions->heap;
+	MM_MemorySubSpace *subspace = heap->getDefaultMemorySpace()->getDefaultMemorySubSpace()->getTopLevelMemorySubSpace(MEMORY_TYPE_OLD);
+	MM_CardTable *cardTable = extensions->cardTable;
+	MM_ConcurrentGCStats *stats = ((MM_ConcurrentGC *)extensions->getGlobalCollector())->getConcurrentGCStats();
+	ASSERT_TRUE(NULL != cardTable);
+
+	uint8_t *low = (uint8_t *)heap->getHeapBase() + heap->getActiveMemorySize();
+	uint8_t *high = low + TEST_RESIZE_SIZE;
+	ASSERT_EQ((uintptr_t)TEST_RESIZE_SIZE, subspace->expand(env, TEST_RESIZE_SIZE));
+	ASSERT_EQ(countDirtyCards(cardTable, low, high), (uintptr_t)0);
+
+	cardTable->dirtyCardRange(env, low, high);
+	ASSERT_EQ(countDirtyCards(cardTable, low, high), (uintptr_t)(TEST_RESIZE_SIZE / CARD_SIZE));
+	ASSERT_EQ((uintptr_t)TEST_RESIZE_SIZE, subspace->contract(env, TEST_RESIZE_SIZE));
+
+	ASSERT_TRUE(stats->switchExecutionMode(CONCURRENT_OFF, CONCURRENT_INIT_COMPLETE));
+	uintptr_t expandSize = subspace->expand(env, TEST_RESIZE_SIZE);
+	ASSERT_TRUE(stats->switchExecutionMode(CONCURRENT_INIT_COMPLETE, CONCURRENT_OFF));
+	ASSERT_EQ((uintptr_t)TEST_RESIZE_SIZE, expandSize);
+
+	EXPECT_EQ(countDirtyCards(cardTable, low, high), (uintptr_t)0);
+}
+
+#endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK) */
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+
+#include "ConcurrentGCStats.hpp"
+#include "ConcurrentKickoffController.hpp"
+#include "GCUnitTest.hpp"
+
+#include <gtest/gtest.h>
+
+/* Far above the pause of an empty collection, so that only halted cycles count as over the target */
+#define TEST_PAUSE_TARGET 10000
+
+class TestConcurrentKickoffController : public GCUnitTest
+{
+protected:
+	MM_ConcurrentKickoffController controller;
+	MM_ConcurrentGCStats stats;
+	uintptr_t savedPauseTarget;
+
+	virtual void
+	SetUp()
+	{
+		GCUnitTest::SetUp();
+		savedPauseTarget = extensions->concurrentFinalPauseTarget;
+		extensions->concurrentFinalPauseTarget = TEST_PAUSE_TARGET;
+	}
+
+	virtual void
+	TearDown()
+	{
+		extensions->concurrentFinalPauseTarget = savedPauseTarget;
+		GCUnitTest::TearDown();
+	}
+
+	void
+	completeCycle(uintptr_t executionModeAtGC)
+	{
+		stats.setExecutionModeAtGC(executionModeAtGC);
+		controller.finalCollectionStarted(env);
+		controller.finalCollectionCompleted(env, &stats);
+	}
+};
+
+/**
+ * A cycle which reached the end of card cleaning before the heap was exhausted is complete, and a pause under the target leaves the fixed tuning.
+ */
+TEST_F(TestConcurrentKickoffController, ExhaustedCycleIsComplete)
+{
+	completeCycle(CONCURRENT_EXHAUSTED);
+	ASSERT_EQ(1.0f, controller.getKickoffScale());
+	ASSERT_EQ(1.0f, controller.getTraceRateScale());
+	ASSERT_EQ((uintptr_t)1000, controller.scaleKickoffThreshold(1000));
+
+	completeCycle(CONCURRENT_FINAL_COLLECTION);
+	ASSERT_EQ(1.0f, controller.getKickoffScale());
+}
+
+/**
+ * A cycle halted while tracing or cleaning cards counts as over the target, bringing kickoff forward and raising the trace rate within the tax limit.
+ */
+TEST_F(TestConcurrentKickoffController, HaltedCycleBringsKickoffForward)
+{
+	completeCycle(CONCURRENT_TRACE_ONLY);
+	ASSERT_LT(1.0f, controller.getKickoffScale());
+	ASSERT_LT(1000u, controller.scaleKickoffThreshold(1000));
+	ASSERT_LT(1.0f, controller.getTraceRateScale());
+	ASSERT_GE(extensions->concurrentAllocationTaxLimit, controller.getTraceRateScale());
+
+	float kickoffScale = controller.getKickoffScale();
+	completeCycle(CONCURRENT_CLEAN_TRACE);
+	ASSERT_LE(kickoffScale, controller.getKickoffScale());
+}
+
+/**
+ * The controller relaxes back to the fixed tuning once cycles complete under the target.
+ */
+TEST_F(TestConcurrentKickoffController, RelaxesWhenUnderTarget)
+{
+	completeCycle(CONCURRENT_TRACE_ONLY);
+	completeCycle(CONCURRENT_TRACE_ONLY);
+	ASSERT_LT(1.0f, controller.getKickoffScale());
+
+	for (uintptr_t i = 0; i < 4; i++) {
+		completeCycle(CONCURRENT_EXHAUSTED);
+	}
+	ASSERT_EQ(1.0f, controller.getKickoffScale());
+	ASSERT_EQ(1.0f, controller.getTraceRateScale());
+}
+
+/**
+ * Without a pause target the controller never moves from the fixed tuning.
+ */
+TEST_F(TestConcurrentKickoffController, DisabledWithoutTarget)
+{
+	extensions->concurrentFinalPauseTarget = 0;
+	completeCycle(CONCURRENT_TRACE_ONLY);
+	ASSERT_EQ(1.0f, controller.getKickoffScale());
+	ASSERT_EQ(1.0f, controller.getTraceRateScale());
+}
+
+#endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK) */
@@ -0,0 +1,217 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include "AtomicOperations.hpp"
+#include "CopyScanCacheDeque.hpp"
+#include "GCUnitTest.hpp"
+#include "omrthread.h"
+
+#include <gtest/gtest.h>
+
+#define DEQUE_TEST_CAPACITY 64
+#define DEQUE_TEST_RACE_ITEMS 200000
+#define DEQUE_TEST_THIEVES 3
+
+/* The deque never dereferences the caches it holds, so the tests push the addresses of tokens. */
+static uintptr_t dequeTestTokens[DEQUE_TEST_RACE_ITEMS];
+
+static MM_CopyScanCacheStandard *
+tokenCache(uintptr_t index)
+{
+	return (MM_CopyScanCacheStandard *)&dequeTestTokens[index];
+}
+
+static uintptr_t
+cacheToken(MM_CopyScanCacheStandard *cache)
+{
+	return (uintptr_t *)cache - dequeTestTokens;
+}
+
+class TestCopyScanCacheDeque : public GCUnitTest
+{
+protected:
+	MM_CopyScanCacheDeque deque;
+
+	virtual void
+	SetUp()
+	{
+		GCUnitTest::SetUp();
+		ASSERT_TRUE(deque.initialize(env, DEQUE_TEST_CAPACITY, 1));
+	}
+
+	virtual void
+	TearDown()
+	{
+		deque.tearDown(env);
+		GCUnitTest::TearDown();
+	}
+};
+
+TEST_F(TestCopyScanCacheDeque, OwnerPopsNewestFirst)
+{
+	EXPECT_TRUE(deque.isEmpty());
+	EXPECT_TRUE(NULL == deque.pop());
+
+	for (uintptr_t i = 0; i < 8; i++) {
+		ASSERT_TRUE(deque.push(tokenCache(i)));
+	}
+	EXPECT_FALSE(deque.isEmpty());
+	for (uintptr_t i = 8; i > 0; i--) {
+		EXPECT_EQ(tokenCache(i - 1), deque.pop());
+	}
+	EXPECT_TRUE(deque.isEmpty());
+	EXPECT_TRUE(NULL == deque.pop());
+}
+
+TEST_F(TestCopyScanCacheDeque, ThiefStealsOldestFirst)
+{
+	EXPECT_TRUE(NULL == deque.steal());
+
+	for (uintptr_t i = 0; i < 8; i++) {
+		ASSERT_TRUE(deque.push(tokenCache(i)));
+	}
+	EXPECT_EQ(tokenCache(0), deque.steal());
+	EXPECT_EQ(tokenCache(1), deque.steal());
+	EXPECT_EQ(tokenCache(7), deque.pop());
+	for (uintptr_t i = 2; i < 7; i++) {
+		EXPECT_EQ(tokenCache(i), deque.steal());
+	}
+	EXPECT_TRUE(deque.isEmpty());
+	EXPECT_TRUE(NULL == deque.steal());
+	EXPECT_TRUE(NULL == deque.pop());
+}
+
+TEST_F(TestCopyScanCacheDeque, PushFailsWhenFullAndWrapsAround)
+{
+	for (uintptr_t round = 0; round < 3; round++) {
+		for (uintptr_t i = 0; i < DEQUE_TEST_CAPACITY; i++) {
+			ASSERT_TRUE(deque.push(tokenCache(i)));
+		}
+		EXPECT_FALSE(deque.push(tokenCache(DEQUE_TEST_CAPACITY)));
+
+		/* a steal frees the oldest slot, which the next push reuses */
+		EXPECT_EQ(tokenCache(0), deque.steal());
+		EXPECT_TRUE(deque.push(tokenCache(DEQUE_TEST_CAPACITY)));
+		EXPECT_EQ(tokenCache(DEQUE_TEST_CAPACITY), deque.pop());
+		for (uintptr_t i = DEQUE_TEST_CAPACITY - 1; i > 0; i--) {
+			EXPECT_EQ(tokenCache(i), deque.pop());
+		}
+		EXPECT_TRUE(deque.isEmpty());
+	}
+}
+
+TEST_F(TestCopyScanCacheDeque, NextVictimStaysInRange)
+{
+	for (uintptr_t i = 0; i < 1000; i++) {
+		EXPECT_GT((uintptr_t)5, deque.nextVictim(5));
+	}
+}
+
+typedef struct DequeRaceState {
+	MM_CopyScanCacheDeque *deque;
+	volatile uintptr_t *taken;
+	volatile uintptr_t takenCount;
+	volatile uintptr_t stolenCount;
+	volatile uintptr_t finishedThieves;
+} DequeRaceState;
+
+static void
+recordTaken(DequeRaceState *state, MM_CopyScanCacheStandard *cache)
+{
+	/* a cache handed out twice shows up as a count above 1 */
+	MM_AtomicOperations::add(&state->taken[cacheToken(cache)], 1);
+	MM_AtomicOperations::add(&state->takenCount, 1);
+}
+
+static int J9THREAD_PROC
+dequeThief(void *arg)
+{
+	DequeRaceState *state = (DequeRaceState *)arg;
+	while (DEQUE_TEST_RACE_ITEMS != state->takenCount) {
+		MM_CopyScanCacheStandard *cache = state->deque->steal();
+		if (NULL != cache) {
+			recordTaken(state, cache);
+			MM_AtomicOperations::add(&state->stolenCount, 1);
+		}
+	}
+	MM_AtomicOperations::add(&state->finishedThieves, 1);
+	return 0;
+}
+
+TEST_F(TestCopyScanCacheDeque, EveryCacheIsTakenExactlyOnceUnderRaces)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->getPortLibrary());
+	DequeRaceState state;
+	state.deque = &deque;
+	state.taken = (volatile uintptr_t *)omrmem_allocate_memory(sizeof(uintptr_t) * DEQUE_TEST_RACE_ITEMS, OMRMEM_CATEGORY_MM);
+	ASSERT_TRUE(NULL != state.taken);
+	memset((void *)state.taken, 0, sizeof(uintptr_t) * DEQUE_TEST_RACE_ITEMS);
+	state.takenCount = 0;
+	state.stolenCount = 0;
+	state.finishedThieves = 0;
+
+	for (uintptr_t i = 0; i < DEQUE_TEST_THIEVES; i++) {
+		omrthread_t thief = NULL;
+		ASSERT_EQ(0, omrthread_create(&thief, 0, J9THREAD_PRIORITY_NORMAL, 0, dequeThief, &state));
+	}
+
+	/* the owner pushes in bursts and pops part of each burst, so that pops race steals for the last entry */
+	MM_CopyScanCacheStandard *cache = NULL;
+	uintptr_t next = 0;
+	while (next < DEQUE_TEST_RACE_ITEMS) {
+		uintptr_t burst = (next % 7) + 1;
+		while ((0 != burst) && (next < DEQUE_TEST_RACE_ITEMS) && deque.push(tokenCache(next))) {
+			next += 1;
+			burst -= 1;
+		}
+		cache = deque.pop();
+		if (NULL != cache) {
+			recordTaken(&state, cache);
+		}
+	}
+	while (NULL != (cache = deque.pop())) {
+		recordTaken(&state, cache);
+	}
+
+	while (DEQUE_TEST_THIEVES != state.finishedThieves) {
+		omrthread_yield();
+	}
+
+	EXPECT_EQ((uintptr_t)DEQUE_TEST_RACE_ITEMS, state.takenCount);
+	EXPECT_TRUE(deque.isEmpty());
+	uintptr_t wrong = 0;
+	for (uintptr_t i = 0; i < DEQUE_TEST_RACE_ITEMS; i++) {
+		if (1 != state.taken[i]) {
+			wrong += 1;
+		}
+	}
+	EXPECT_EQ((uintptr_t)0, wrong);
+	gcTestEnv->log(LEVEL_VERBOSE, "%zu of %d caches were stolen\n", state.stolenCount, DEQUE_TEST_RACE_ITEMS);
+
+	omrmem_free_memory((void *)state.taken);
+}
+
+#endif /* OMR_GC_MODRON_SCAVENGER */
@@ -0,0 +1,191 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "Forge.hpp"
+#include "gcTestHelpers.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace OMR::GC;
+
+TEST(TestForge, CategoryAccountingIsExact)
+{
+	Forge forge;
+	ASSERT_TRUE(forge.initialize(gcTestEnv->getPortLibrary()));
+
+	const ForgeCategoryStatistics *fixed = forge.getCategoryStatistics(AllocationCategory::FIXED);
+	const ForgeCategoryStatistics *workPackets = forge.getCategoryStatistics(AllocationCategory::WORK_PACKETS);
+
+	void *small = forge.allocate(24, AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	void *medium = forge.allocate(1000, AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	void *large = forge.allocate(1024 * 1024, AllocationCategory::WORK_PACKETS, OMR_GET_CALLSITE());
+	ASSERT_TRUE(NULL != small);
+	ASSERT_TRUE(NULL != medium);
+	ASSERT_TRUE(NULL != large);
+
+	EXPECT_EQ(fixed->liveBytes, (uintptr_t)1024);
+	EXPECT_EQ(fixed->liveAllocations, (uintptr_t)2);
+	EXPECT_EQ(workPackets->liveBytes, (uintptr_t)(1024 * 1024));
+	EXPECT_EQ(workPackets->liveAllocations, (uintptr_t)1);
+
+	forge.free(medium);
+	forge.free(large);
+	forge.free(small);
+
+	EXPECT_EQ(fixed->liveBytes, (uintptr_t)0);
+	EXPECT_EQ(fixed->liveAllocations, (uintptr_t)0);
+	EXPECT_EQ(fixed->peakBytes, (uintptr_t)1024);
+	EXPECT_EQ(fixed->totalAllocations, (uintptr_t)2);
+	EXPECT_EQ(workPackets->liveBytes, (uintptr_t)0);
+
+	ForgeArenaStatistics stats;
+	forge.getArenaStatistics(&stats);
+	EXPECT_EQ(stats.largeAllocations, (uintptr_t)1);
+	EXPECT_EQ(stats.arenaBytes, (uintptr_t)FORGE_ARENA_CHUNK_SIZE);
+
+	forge.tearDown();
+}
+
+TEST(TestForge, SlabBlocksAreReused)
+{
+	Forge forge;
+	ASSERT_TRUE(forge.initialize(gcTestEnv->getPortLibrary()));
+
+	void *blocks[1000];
+	for (uintptr_t i = 0; i < 1000; i++) {
+		blocks[i] = forge.allocate(48, AllocationCategory::OTHER, OMR_GET_CALLSITE());
+		ASSERT_TRUE(NULL != blocks[i]);
+		memset(blocks[i], 0xa5, 48);
+		EXPECT_EQ((uintptr_t)blocks[i] % sizeof(uintptr_t), (uintptr_t)0);
+	}
+	for (uintptr_t i = 0; i < 1000; i++) {
+		forge.free(blocks[i]);
+	}
+
+	/* the most recently freed block is handed out first */
+	void *reused = forge.allocate(40, AllocationCategory::OTHER, OMR_GET_CALLSITE());
+	EXPECT_EQ(reused, blocks[999]);
+	forge.free(reused);
+
+	ForgeArenaStatistics before;
+	forge.getArenaStatistics(&before);
+	for (uintptr_t i = 0; i < 1000; i++) {
+		blocks[i] = forge.allocate(48, AllocationCategory::OTHER, OMR_GET_CALLSITE());
+		ASSERT_TRUE(NULL != blocks[i]);
+	}
+	ForgeArenaStatistics after;
+	forge.getArenaStatistics(&after);
+	EXPECT_EQ(after.arenaBytes, before.arenaBytes);
+	EXPECT_GT(after.cachedAllocations, before.cachedAllocations);
+	EXPECT_GT(before.cacheFlushes, (uintptr_t)0);
+
+	for (uintptr_t i = 0; i < 1000; i++) {
+		forge.free(blocks[i]);
+	}
+	EXPECT_EQ(forge.getCategoryStatistics(AllocationCategory::OTHER)->liveAllocations, (uintptr_t)0);
+
+	forge.tearDown();
+}
+
+TEST(TestForge, SlabBlocksAreChargedToTheMemoryCategory)
+{
+	Forge forge;
+	ASSERT_TRUE(forge.initialize(gcTestEnv->getPortLibrary()));
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->getPortLibrary());
+	OMRMemCategory *category = omrmem_get_category(OMRMEM_CATEGORY_MM);
+
+	/* the first allocation creates the thread cache, which is charged as a port library allocation */
+	forge.free(forge.allocate(48, AllocationCategory::OTHER, OMR_GET_CALLSITE()));
+	uintptr_t liveBytes = category->liveBytes;
+	uintptr_t liveAllocations = category->liveAllocations;
+
+	const uintptr_t count = 4096;
+	void **blocks = (void **)omrmem_allocate_memory(count * sizeof(void *), OMRMEM_CATEGORY_PORT_LIBRARY);
+	ASSERT_TRUE(NULL != blocks);
+	for (uintptr_t i = 0; i < count; i++) {
+		blocks[i] = forge.allocate(48, AllocationCategory::OTHER, OMR_GET_CALLSITE());
+		ASSERT_TRUE(NULL != blocks[i]);
+	}
+
+	ForgeArenaStatistics stats;
+	forge.getArenaStatistics(&stats);
+	uintptr_t chunkCount = stats.arenaBytes / FORGE_ARENA_CHUNK_SIZE;
+	EXPECT_LT((uintptr_t)1, chunkCount);
+
+	/* the category sees each block, and only the port library tags of the chunks beyond that */
+	EXPECT_EQ(category->liveAllocations - liveAllocations, count);
+	EXPECT_LE(count * 64, category->liveBytes - liveBytes);
+	EXPECT_GT(count * 64 + chunkCount * 256, category->liveBytes - liveBytes);
+
+	for (uintptr_t i = 0; i < count; i++) {
+		forge.free(blocks[i]);
+	}
+	EXPECT_EQ(category->liveAllocations, liveAllocations);
+	EXPECT_GT(liveBytes + chunkCount * 256, category->liveBytes);
+
+	omrmem_free_memory(blocks);
+	forge.tearDown();
+}
+
+TEST(TestForge, EmptyArenaChunksAreReleased)
+{
+	Forge forge;
+	ASSERT_TRUE(forge.initialize(gcTestEnv->getPortLibrary()));
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->getPortLibrary());
+
+	const uintptr_t count = 8192;
+	void **blocks = (void **)omrmem_allocate_memory(count * sizeof(void *), OMRMEM_CATEGORY_PORT_LIBRARY);
+	ASSERT_TRUE(NULL != blocks);
+	for (uintptr_t i = 0; i < count; i++) {
+		blocks[i] = forge.allocate(100, AllocationCategory::OTHER, OMR_GET_CALLSITE());
+		ASSERT_TRUE(NULL != blocks[i]);
+	}
+
+	ForgeArenaStatistics before;
+	forge.getArenaStatistics(&before);
+	EXPECT_LE((uintptr_t)(16 * FORGE_ARENA_CHUNK_SIZE), before.arenaBytes);
+	EXPECT_EQ(before.arenaReleases, (uintptr_t)0);
+
+	for (uintptr_t i = 0; i < count; i++) {
+		forge.free(blocks[i]);
+	}
+
+	/* the thread cache keeps the most recently freed blocks, which come from the last two chunks at most */
+	ForgeArenaStatistics after;
+	forge.getArenaStatistics(&after);
+	EXPECT_GE((uintptr_t)(2 * FORGE_ARENA_CHUNK_SIZE), after.arenaBytes);
+	EXPECT_EQ(after.arenaBytes + after.arenaReleases * FORGE_ARENA_CHUNK_SIZE, before.arenaBytes);
+
+	/* released blocks are gone from the shared lists, so the blocks handed out again are all usable */
+	for (uintptr_t i = 0; i < count; i++) {
+		blocks[i] = forge.allocate(100, AllocationCategory::OTHER, OMR_GET_CALLSITE());
+		ASSERT_TRUE(NULL != blocks[i]);
+		memset(blocks[i], 0x5a, 100);
+	}
+	for (uintptr_t i = 0; i < count; i++) {
+		forge.free(blocks[i]);
+	}
+	EXPECT_EQ(forge.getCategoryStatistics(AllocationCategory::OTHER)->liveAllocations, (uintptr_t)0);
+
+	omrmem_free_memory(blocks);
+	forge.tearDown();
+}
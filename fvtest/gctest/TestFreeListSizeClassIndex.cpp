@@ -0,0 +1,182 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "AllocateDescription.hpp"
+#include "FreeEntrySizeClassStats.hpp"
+#include "GCUnitTest.hpp"
+#include "Heap.hpp"
+#include "LargeObjectAllocateStats.hpp"
+#include "Math.hpp"
+#include "MemoryPoolAddressOrderedList.hpp"
+#include "MemorySpace.hpp"
+#include "omrmodroncore.h"
+
+#include <gtest/gtest.h>
+
+#define INDEX_TEST_REQUEST_SIZE (64 * 1024)
+#define INDEX_TEST_ENTRY_COUNT 128
+#define INDEX_TEST_ENTRY_STRIDE (INDEX_TEST_REQUEST_SIZE + CARD_SIZE)
+#define INDEX_TEST_TOO_LARGE (16 * 1024 * 1024)
+
+class TestFreeListSizeClassIndex : public GCUnitTest
+{
+protected:
+	MM_MemoryPoolAddressOrderedList *pool;
+	void *bufferAllocation;
+	uint8_t *buffer;
+	bool savedFreeListSizeClassIndex;
+
+	virtual void
+	SetUp()
+	{
+		pool = NULL;
+		bufferAllocation = NULL;
+		buffer = NULL;
+		GCUnitTest::SetUp();
+		savedFreeListSizeClassIndex = extensions->freeListSizeClassIndex;
+		extensions->freeListSizeClassIndex = true;
+		pool = MM_MemoryPoolAddressOrderedList::newInstance(env, CARD_SIZE, "TestFreeListSizeClassIndex");
+		ASSERT_TRUE(NULL != pool);
+		/* only the owning subspace type is consulted by allocations; the base class setter skips the subspace hooks */
+		pool->MM_MemoryPool::setSubSpace(extensions->heap->getDefaultMemorySpace()->getTenureMemorySubSpace());
+		bufferAllocation = env->getForge()->allocate((INDEX_TEST_ENTRY_COUNT + 1) * INDEX_TEST_ENTRY_STRIDE, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+		ASSERT_TRUE(NULL != bufferAllocation);
+		buffer = (uint8_t *)MM_Math::roundToCeiling(CARD_SIZE, (uintptr_t)bufferAllocation);
+	}
+
+	virtual void
+	TearDown()
+	{
+		if (NULL != pool) {
+			pool->kill(env);
+			pool = NULL;
+		}
+		if (NULL != bufferAllocation) {
+			env->getForge()->free(bufferAllocation);
+			bufferAllocation = NULL;
+		}
+		extensions->freeListSizeClassIndex = savedFreeListSizeClassIndex;
+		GCUnitTest::TearDown();
+	}
+
+	void *
+	allocate(uintptr_t size)
+	{
+		MM_AllocateDescription allocDescription(size, 0, false, true);
+		return pool->allocateObject(env, &allocDescription);
+	}
+
+	/**
+	 * @return number of index lookups since the index was last rebuilt
+	 */
+	uintptr_t
+	indexLookupCount()
+	{
+		MM_FreeEntrySizeClassStats *stats = pool->getLargeObjectAllocateStats()->getFreeEntrySizeClassStats();
+		return stats->getIndexHitCount() + stats->getIndexMissCount();
+	}
+};
+
+/**
+ * When only the requested size class holds entries, and all but the first entry binned there are too
+ * small, the fitting entry is found through the size ordered tree rather than by walking the bin.
+ */
+TEST_F(TestFreeListSizeClassIndex, RequestedSizeClassIsNotScanned)
+{
+	MM_LargeObjectAllocateStats *stats = pool->getLargeObjectAllocateStats();
+	uintptr_t requestedSizeClass = stats->getSizeClassIndex(INDEX_TEST_REQUEST_SIZE);
+	uintptr_t entryCount = 0;
+
+	/* the only fitting entry is the lowest addressed, so the last one linked into its bin */
+	for (uintptr_t i = 0; i < INDEX_TEST_ENTRY_COUNT; i++) {
+		uintptr_t size = INDEX_TEST_REQUEST_SIZE - (i * 64);
+		if (stats->getSizeClassIndex(size) != requestedSizeClass) {
+			break;
+		}
+		uint8_t *base = buffer + (i * INDEX_TEST_ENTRY_STRIDE);
+		pool->expandWithRange(env, size, base, base + size, false);
+		entryCount += 1;
+	}
+	ASSERT_LT((uintptr_t)16, entryCount);
+
+	/* builds the index without consuming anything */
+	ASSERT_TRUE(NULL == allocate(INDEX_TEST_TOO_LARGE));
+	uintptr_t scanCountBefore = stats->getFreeEntrySizeClassStats()->getIndexScanCount();
+	ASSERT_EQ((void *)buffer, allocate(INDEX_TEST_REQUEST_SIZE));
+	uintptr_t scanCount = stats->getFreeEntrySizeClassStats()->getIndexScanCount() - scanCountBefore;
+
+	/* a tree search visits at most about 1.44 log2(n) nodes, where walking the bin would visit all n */
+	uintptr_t log2EntryCount = 0;
+	while (((uintptr_t)1 << log2EntryCount) < entryCount) {
+		log2EntryCount += 1;
+	}
+	ASSERT_GE(2 * log2EntryCount, scanCount);
+
+	/* every remaining entry is too small */
+	ASSERT_TRUE(NULL == allocate(INDEX_TEST_REQUEST_SIZE));
+}
+
+/**
+ * Expanding (with and without coalescing) and contracting the pool keep the index current, rather than
+ * discarding it for a rebuild, and allocations after each change see exactly the free memory of the pool.
+ */
+TEST_F(TestFreeListSizeClassIndex, ExpandAndContractKeepIndexCurrent)
+{
+	uint8_t *lowEntry = buffer;
+	uint8_t *highEntry = buffer + (4 * INDEX_TEST_ENTRY_STRIDE);
+
+	pool->expandWithRange(env, 16 * 1024, lowEntry, lowEntry + (16 * 1024), false);
+	pool->expandWithRange(env, 16 * 1024, highEntry, highEntry + (16 * 1024), false);
+	ASSERT_TRUE(NULL == allocate(INDEX_TEST_TOO_LARGE));
+	uintptr_t lookupCount = indexLookupCount();
+
+	/* grow the low entry at its top, and the high entry at its base */
+	pool->expandWithRange(env, 32 * 1024, lowEntry + (16 * 1024), lowEntry + (48 * 1024), true);
+	pool->expandWithRange(env, 16 * 1024, highEntry - (16 * 1024), highEntry, true);
+	highEntry -= 16 * 1024;
+	/* and add a separate entry between them */
+	uint8_t *middleEntry = buffer + (2 * INDEX_TEST_ENTRY_STRIDE);
+	pool->expandWithRange(env, 8 * 1024, middleEntry, middleEntry + (8 * 1024), true);
+
+	ASSERT_EQ((void *)lowEntry, allocate(40 * 1024));
+	ASSERT_EQ(lookupCount + 1, indexLookupCount());
+	ASSERT_EQ((void *)highEntry, allocate(32 * 1024));
+	ASSERT_EQ(lookupCount + 2, indexLookupCount());
+
+	/* split the middle entry, leaving 2KB below and 2KB above the contracted range */
+	ASSERT_EQ((void *)(middleEntry + (2 * 1024)), pool->contractWithRange(env, 4 * 1024, middleEntry + (2 * 1024), middleEntry + (6 * 1024)));
+
+	/* what is left: 8KB of the low entry, and the two pieces of the middle one */
+	uintptr_t allocatedBytes = 0;
+	void *allocated = NULL;
+	while (NULL != (allocated = allocate(2 * 1024))) {
+		uint8_t *address = (uint8_t *)allocated;
+		bool inLowEntry = (address >= lowEntry + (40 * 1024)) && (address + (2 * 1024) <= lowEntry + (48 * 1024));
+		bool inMiddleEntry = ((address >= middleEntry) && (address + (2 * 1024) <= middleEntry + (2 * 1024)))
+				|| ((address >= middleEntry + (6 * 1024)) && (address + (2 * 1024) <= middleEntry + (8 * 1024)));
+		ASSERT_TRUE(inLowEntry || inMiddleEntry) << "allocated " << allocated;
+		allocatedBytes += 2 * 1024;
+	}
+	ASSERT_EQ((uintptr_t)(12 * 1024), allocatedBytes);
+	/* the index was never rebuilt, which would have reset the lookup counts */
+	ASSERT_LE(lookupCount + 3, indexLookupCount());
+}
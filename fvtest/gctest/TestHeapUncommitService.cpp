@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_MODRON_STANDARD)
+
+#include "omrExampleVM.hpp"
+#include "omrgc.h"
+#include "omrport.h"
+#include "omrthread.h"
+#include "mmprivatehook.h"
+
+#include "GCUnitTest.hpp"
+#include "Heap.hpp"
+#include "ObjectAllocationModel.hpp"
+
+#include <gtest/gtest.h>
+
+#define TEST_OBJECT_COUNT 32
+#define TEST_OBJECT_PAGES 4
+#define PASS_TIMEOUT_MILLIS 10000
+
+class TestHeapUncommitService : public GCUnitTest
+{
+protected:
+	omrthread_monitor_t monitor;
+	uintptr_t passCount;
+	MM_HeapUncommitEvent lastPass;
+	J9HookInterface **privateHooks;
+	RootEntry roots[TEST_OBJECT_COUNT];
+	char rootNames[TEST_OBJECT_COUNT][16];
+
+	virtual const char *getConfigFile() { return "fvtest/gctest/configuration/heap_uncommit_GC_config.xml"; }
+
+	static void
+	heapUncommitted(J9HookInterface **hook, uintptr_t eventNum, void *eventData, void *userData)
+	{
+		TestHeapUncommitService *test = (TestHeapUncommitService *)userData;
+		omrthread_monitor_enter(test->monitor);
+		test->lastPass = *(MM_HeapUncommitEvent *)eventData;
+		test->passCount += 1;
+		omrthread_monitor_notify_all(test->monitor);
+		omrthread_monitor_exit(test->monitor);
+	}
+
+	virtual void
+	SetUp()
+	{
+		passCount = 0;
+		ASSERT_EQ(0, omrthread_monitor_init_with_name(&monitor, 0, "TestHeapUncommitService::monitor"));
+		GCUnitTest::SetUp();
+		privateHooks = J9_HOOK_INTERFACE(extensions->privateHookInterface);
+		ASSERT_EQ(0, (*privateHooks)->J9HookRegisterWithCallSite(privateHooks, J9HOOK_MM_PRIVATE_HEAP_UNCOMMIT, heapUncommitted, OMR_GET_CALLSITE(), (void *)this));
+
+		/* the example collector scans these for roots */
+		OMRPORT_ACCESS_FROM_OMRVM(exampleVM->_omrVM);
+		exampleVM->rootTable = hashTableNew(OMRPORTLIB, OMR_GET_CALLSITE(), 0, sizeof(RootEntry), 0, 0, OMRMEM_CATEGORY_MM, rootTableHashFn, rootTableHashEqualFn, NULL, NULL);
+		exampleVM->objectTable = hashTableNew(OMRPORTLIB, OMR_GET_CALLSITE(), 0, sizeof(ObjectEntry), 0, 0, OMRMEM_CATEGORY_MM, objectTableHashFn, objectTableHashEqualFn, NULL, NULL);
+		ASSERT_TRUE((NULL != exampleVM->rootTable) && (NULL != exampleVM->objectTable));
+	}
+
+	virtual void
+	TearDown()
+	{
+		hashTableFree(exampleVM->rootTable);
+		exampleVM->rootTable = NULL;
+		hashTableFree(exampleVM->objectTable);
+		exampleVM->objectTable = NULL;
+		(*privateHooks)->J9HookUnregister(privateHooks, J9HOOK_MM_PRIVATE_HEAP_UNCOMMIT, heapUncommitted, (void *)this);
+		GCUnitTest::TearDown();
+		omrthread_monitor_destroy(monitor);
+	}
+
+	/**
+	 * Wait for the service to report a pass.
+	 * @param count the number of passes reported since SetUp() to wait for
+	 * @return true if the pass was reported, false on timeout
+	 */
+	bool
+	waitForPass(uintptr_t count)
+	{
+		OMRPORT_ACCESS_FROM_OMRVM(exampleVM->_omrVM);
+		int64_t deadline = omrtime_current_time_millis() + PASS_TIMEOUT_MILLIS;
+		omrthread_monitor_enter(monitor);
+		while ((passCount < count) && (omrtime_current_time_millis() < deadline)) {
+			omrthread_monitor_wait_timed(monitor, 100, 0);
+		}
+		bool reported = (passCount >= count);
+		omrthread_monitor_exit(monitor);
+		return reported;
+	}
+
+	/**
+	 * Allocate objects of a few pages and root every other one, so that a global GC leaves a free entry between each pair.
+	 */
+	void
+	fragmentHeap()
+	{
+		OMRPORT_ACCESS_FROM_OMRVM(exampleVM->_omrVM);
+		uintptr_t objectSize = TEST_OBJECT_PAGES * extensions->heap->getPageSize();
+		for (uintptr_t i = 0; i < TEST_OBJECT_COUNT; i++) {
+			MM_ObjectAllocationModel allocationModel(env, objectSize);
+			omrobjectptr_t objectPtr = OMR_GC_AllocateObject(exampleVM->_omrVMThread, &allocationModel);
+			ASSERT_TRUE(NULL != objectPtr);
+			if (0 == (i % 2)) {
+				omrstr_printf(rootNames[i], sizeof(rootNames[i]), "root%zu", i);
+				roots[i].name = rootNames[i];
+				roots[i].rootPtr = objectPtr;
+				ASSERT_TRUE(NULL != hashTableAdd(exampleVM->rootTable, &roots[i]));
+			}
+		}
+	}
+};
+
+TEST_F(TestHeapUncommitService, releasesTheFreeHeapWithoutAGlobalGC)
+{
+	/* the delay runs from startup, no collection is needed to start the first pass */
+	ASSERT_TRUE(waitForPass(1));
+	EXPECT_LT((uintptr_t)0, lastPass.releasedBytes);
+	EXPECT_EQ(lastPass.releasedBytes, lastPass.trackedBytes);
+	EXPECT_EQ((uintptr_t)0, lastPass.refaultedBytes);
+	EXPECT_EQ((uintptr_t)0, lastPass.yielded);
+}
+
+TEST_F(TestHeapUncommitService, resumesBatchesAfterTheLastEntryVisited)
+{
+	ASSERT_TRUE(waitForPass(1));
+
+	/* release one entry per batch and visit two entries per lock hold */
+	extensions->heapUncommitBatchSize = extensions->heap->getPageSize();
+	extensions->heapUncommitBatchEntryCount = 2;
+	fragmentHeap();
+
+	ASSERT_EQ(OMR_ERROR_NONE, OMR_GC_SystemCollect(exampleVM->_omrVMThread, 0));
+	ASSERT_TRUE(waitForPass(2));
+	EXPECT_LT((uintptr_t)0, lastPass.releasedBytes);
+	/* one batch for each entry freed between the rooted objects, the last of which reaches into the free tail of the heap */
+	EXPECT_LE((uintptr_t)TEST_OBJECT_COUNT / 2, lastPass.batchCount);
+	uintptr_t trackedBytes = lastPass.trackedBytes;
+
+	/* Nothing moved, so every released range is still free. Had a batch visited an entry twice, or skipped one, the
+	 * accounting walk at the start of the GC would report refaults, or the pass would release pages again.
+	 */
+	ASSERT_EQ(OMR_ERROR_NONE, OMR_GC_SystemCollect(exampleVM->_omrVMThread, 0));
+	ASSERT_TRUE(waitForPass(3));
+	EXPECT_EQ((uintptr_t)0, lastPass.refaultedBytes);
+	EXPECT_EQ((uintptr_t)0, lastPass.releasedBytes);
+	EXPECT_EQ(trackedBytes, lastPass.trackedBytes);
+}
+
+#endif /* defined(OMR_GC_MODRON_STANDARD) */
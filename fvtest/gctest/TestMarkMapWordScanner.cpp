@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "MarkMapWordScanner.hpp"
+#include "gcTestHelpers.hpp"
+
+#include <gtest/gtest.h>
+
+#define SCANNER_TEST_WORDS 1024
+
+/**
+ * Every kernel must stop at exactly the word the scalar kernel stops at, for every start word
+ * and alignment, whether the range holds a non-empty word or runs off its top.
+ */
+TEST(TestMarkMapWordScanner, KernelsStopWhereScalarStops)
+{
+	OMRPortLibrary *portLibrary = gcTestEnv->getPortLibrary();
+	uintptr_t markMap[SCANNER_TEST_WORDS];
+	uintptr_t *top = markMap + SCANNER_TEST_WORDS;
+	MM_MarkMapWordScanner::FindNonEmptyWordFunction scalar = MM_MarkMapWordScanner::getKernelFunction(MM_MarkMapWordScanner::kernel_scalar);
+
+	for (uintptr_t kernel = MM_MarkMapWordScanner::kernel_avx2; kernel <= MM_MarkMapWordScanner::kernel_avx512; kernel++) {
+		if (!MM_MarkMapWordScanner::isKernelSupported(portLibrary, (MM_MarkMapWordScanner::Kernel)kernel)) {
+			continue;
+		}
+		MM_MarkMapWordScanner::FindNonEmptyWordFunction vector = MM_MarkMapWordScanner::getKernelFunction((MM_MarkMapWordScanner::Kernel)kernel);
+
+		/* gaps from none to longer than any vector unroll, with set bits at both ends of a word */
+		for (uintptr_t gap = 1; gap < 200; gap += 7) {
+			memset(markMap, 0, sizeof(markMap));
+			uintptr_t bit = 0;
+			for (uintptr_t i = gap; i < SCANNER_TEST_WORDS; i += gap) {
+				markMap[i] = (uintptr_t)1 << bit;
+				bit = (bit + 13) % (sizeof(uintptr_t) * 8);
+			}
+			for (uintptr_t start = 0; start < SCANNER_TEST_WORDS; start++) {
+				ASSERT_EQ(scalar(markMap + start, top), vector(markMap + start, top))
+					<< "kernel " << kernel << " gap " << gap << " start " << start;
+			}
+		}
+
+		/* an empty map runs off the top from every start */
+		memset(markMap, 0, sizeof(markMap));
+		for (uintptr_t start = 0; start <= SCANNER_TEST_WORDS; start++) {
+			ASSERT_EQ(scalar(markMap + start, top), vector(markMap + start, top))
+				<< "kernel " << kernel << " empty start " << start;
+		}
+	}
+}
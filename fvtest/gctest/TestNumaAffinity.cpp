@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "GCUnitTest.hpp"
+#include "omrthread.h"
+
+#include <gtest/gtest.h>
+
+class TestNumaAffinity : public GCUnitTest
+{
+};
+
+/**
+ * A thread bound to nodes keeps its first bound node. A thread which is not bound is associated with
+ * the node it runs on, rather than with no node, and refreshing follows it to the node it runs on now.
+ */
+TEST_F(TestNumaAffinity, UnboundThreadTakesCurrentNode)
+{
+	uintptr_t boundNode = env->getNumaAffinity();
+	uintptr_t maxNode = omrthread_numa_get_max_node();
+
+	env->cacheNumaAffinity();
+	if (0 != boundNode) {
+		ASSERT_EQ(boundNode, env->getCachedNumaAffinity());
+		env->refreshNumaAffinity();
+		ASSERT_EQ(boundNode, env->getCachedNumaAffinity());
+		return;
+	}
+
+	ASSERT_GE(OMR_MAX(maxNode, 1), env->getCachedNumaAffinity());
+	for (uintptr_t i = 0; i < 100; i++) {
+		env->refreshNumaAffinity();
+		uintptr_t cachedNode = env->getCachedNumaAffinity();
+		uintptr_t currentNode = omrthread_numa_get_current_node();
+		if (maxNode <= 1) {
+			/* nowhere to migrate to */
+			ASSERT_EQ(currentNode, cachedNode);
+		} else {
+			ASSERT_NE((uintptr_t)0, cachedNode);
+			ASSERT_GE(maxNode, cachedNode);
+		}
+	}
+}
@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include <math.h>
+
+#include "GCUnitTest.hpp"
+#include "NurserySizingModel.hpp"
+
+#include <gtest/gtest.h>
+
+#define FIXED_PAUSE_MICROS 2000.0
+#define PAUSE_MICROS_PER_BYTE 0.001
+#define SURVIVAL_RATE 0.1
+#define ALLOCATION_RATE 100 /* bytes per microsecond */
+
+class TestNurserySizingModel : public GCUnitTest
+{
+protected:
+	MM_NurserySizingModel model;
+	uintptr_t savedPauseTarget;
+	double savedExpectedRatioMaximum;
+	bool savedDynamicNewSpaceSizing;
+
+	virtual void
+	SetUp()
+	{
+		GCUnitTest::SetUp();
+		savedPauseTarget = extensions->scavengerPauseTarget;
+		savedExpectedRatioMaximum = extensions->dnssExpectedRatioMaximum._valueSpecified;
+		savedDynamicNewSpaceSizing = extensions->dynamicNewSpaceSizing;
+		extensions->dnssExpectedRatioMaximum._valueSpecified = 0.05;
+		extensions->dynamicNewSpaceSizing = true;
+	}
+
+	virtual void
+	TearDown()
+	{
+		extensions->scavengerPauseTarget = savedPauseTarget;
+		extensions->dnssExpectedRatioMaximum._valueSpecified = savedExpectedRatioMaximum;
+		extensions->dynamicNewSpaceSizing = savedDynamicNewSpaceSizing;
+		GCUnitTest::TearDown();
+	}
+
+	/**
+	 * Add a scavenge of young objects only whose pause is exactly fixedMicros + microsPerByte * copied bytes.
+	 */
+	void
+	addScavenge(uintptr_t allocatedBytes, double fixedMicros, double microsPerByte, double weight)
+	{
+		uintptr_t copiedBytes = (uintptr_t)(allocatedBytes * SURVIVAL_RATE);
+		uint64_t pauseMicros = (uint64_t)(fixedMicros + (microsPerByte * copiedBytes));
+		model.addScavenge(allocatedBytes, allocatedBytes / ALLOCATION_RATE, copiedBytes, copiedBytes, copiedBytes, copiedBytes, pauseMicros, weight);
+	}
+
+	/**
+	 * Add scavenges of 1M to 2M allocated bytes, so the copied volume varies enough to fit both costs.
+	 */
+	void
+	addScavenges(uintptr_t count, double fixedMicros, double microsPerByte)
+	{
+		for (uintptr_t i = 0; i < count; i++) {
+			addScavenge((1 + (i % 8)) * 128 * 1024 + 1024 * 1024, fixedMicros, microsPerByte, 1.0);
+		}
+	}
+};
+
+TEST_F(TestNurserySizingModel, fitsFixedAndPerByteCosts)
+{
+	addScavenges(NURSERY_SIZING_MODEL_WARMUP_SAMPLES - 1, FIXED_PAUSE_MICROS, PAUSE_MICROS_PER_BYTE);
+	EXPECT_FALSE(model.isReady());
+	addScavenges(8, FIXED_PAUSE_MICROS, PAUSE_MICROS_PER_BYTE);
+	EXPECT_TRUE(model.isReady());
+
+	/* pauses are truncated to whole microseconds */
+	EXPECT_NEAR(FIXED_PAUSE_MICROS, model.getFixedPauseMicros(), 2.0);
+	EXPECT_NEAR(PAUSE_MICROS_PER_BYTE, model.getPauseMicrosPerByte(), PAUSE_MICROS_PER_BYTE / 100.0);
+}
+
+TEST_F(TestNurserySizingModel, attributesAConstantVolumePauseToCopying)
+{
+	for (uintptr_t i = 0; i < 8; i++) {
+		addScavenge(1024 * 1024, FIXED_PAUSE_MICROS, PAUSE_MICROS_PER_BYTE, 1.0);
+	}
+
+	double copiedBytes = 1024 * 1024 * SURVIVAL_RATE;
+	double pauseMicros = floor(FIXED_PAUSE_MICROS + (PAUSE_MICROS_PER_BYTE * (uintptr_t)copiedBytes));
+	EXPECT_EQ(0.0, model.getFixedPauseMicros());
+	EXPECT_NEAR(pauseMicros / (uintptr_t)copiedBytes, model.getPauseMicrosPerByte(), 1.0e-9);
+}
+
+TEST_F(TestNurserySizingModel, forgetsOlderScavenges)
+{
+	addScavenges(16, FIXED_PAUSE_MICROS / 4, PAUSE_MICROS_PER_BYTE / 4);
+	addScavenges(64, FIXED_PAUSE_MICROS, PAUSE_MICROS_PER_BYTE);
+
+	EXPECT_NEAR(FIXED_PAUSE_MICROS, model.getFixedPauseMicros(), FIXED_PAUSE_MICROS / 100.0);
+	EXPECT_NEAR(PAUSE_MICROS_PER_BYTE, model.getPauseMicrosPerByte(), PAUSE_MICROS_PER_BYTE / 100.0);
+}
+
+TEST_F(TestNurserySizingModel, weighsStarvedScavengesLess)
+{
+	MM_NurserySizingModel fullWeight;
+	for (uintptr_t i = 0; i < 16; i++) {
+		uintptr_t allocatedBytes = (1 + (i % 8)) * 128 * 1024 + 1024 * 1024;
+		/* every eighth pause is stretched by a serial tail */
+		bool starved = (4 == (i % 8));
+		double fixedMicros = starved ? (2 * FIXED_PAUSE_MICROS) : FIXED_PAUSE_MICROS;
+		double weight = starved ? 0.25 : 1.0;
+		addScavenge(allocatedBytes, fixedMicros, PAUSE_MICROS_PER_BYTE, weight);
+		uintptr_t copiedBytes = (uintptr_t)(allocatedBytes * SURVIVAL_RATE);
+		fullWeight.addScavenge(allocatedBytes, allocatedBytes / ALLOCATION_RATE, copiedBytes, copiedBytes, copiedBytes, copiedBytes,
+			(uint64_t)(fixedMicros + (PAUSE_MICROS_PER_BYTE * copiedBytes)), 1.0);
+	}
+
+	EXPECT_LT(fabs(model.getFixedPauseMicros() - FIXED_PAUSE_MICROS), fabs(fullWeight.getFixedPauseMicros() - FIXED_PAUSE_MICROS));
+}
+
+TEST_F(TestNurserySizingModel, sizesForThePauseTarget)
+{
+	addScavenges(16, FIXED_PAUSE_MICROS, PAUSE_MICROS_PER_BYTE);
+	/* 3ms leaves 1000us for copying 1M bytes, 10M allocated, below the 20M keeping a 2% scavenge ratio */
+	extensions->scavengerPauseTarget = 3;
+	extensions->dnssExpectedRatioMaximum._valueSpecified = 0.02;
+	uintptr_t maximumSize = 64 * 1024 * 1024;
+
+	uintptr_t desiredSize = model.calculateDesiredSize(env, 4 * 1024 * 1024, 1024 * 1024, maximumSize);
+	EXPECT_EQ(NURSERY_SIZING_PAUSE_TARGET, model.getReason());
+	double allocateSize = 1000.0 / (PAUSE_MICROS_PER_BYTE * SURVIVAL_RATE);
+	/* the nursery also holds the bytes flipped by the scavenge */
+	EXPECT_GT(desiredSize, (uintptr_t)(allocateSize * 0.99));
+	EXPECT_LT(desiredSize, (uintptr_t)(allocateSize * 1.5));
+}
+
+TEST_F(TestNurserySizingModel, keepsTheScavengeRatioWhenThePauseTargetIsUnreachable)
+{
+	addScavenges(16, FIXED_PAUSE_MICROS, PAUSE_MICROS_PER_BYTE);
+	extensions->scavengerPauseTarget = 1;
+	uintptr_t currentSize = 4 * 1024 * 1024;
+	uintptr_t minimumSize = 1024 * 1024;
+	uintptr_t maximumSize = 64 * 1024 * 1024;
+
+	/* ratio = (fixed + perByte * survival * size) * rate / size = 0.05 once size is 4M (2000 * 100 / 0.04) */
+	uintptr_t desiredSize = model.calculateDesiredSize(env, currentSize, minimumSize, maximumSize);
+	EXPECT_EQ(NURSERY_SIZING_PAUSE_TARGET_UNREACHABLE, model.getReason());
+	double ratioSize = (FIXED_PAUSE_MICROS * ALLOCATION_RATE) / (0.05 - (ALLOCATION_RATE * PAUSE_MICROS_PER_BYTE * SURVIVAL_RATE));
+	EXPECT_GT(desiredSize, (uintptr_t)(ratioSize * 0.99));
+	EXPECT_LT(desiredSize, (uintptr_t)(ratioSize * 1.5));
+
+	/* copying alone takes more than the expected ratio, no size helps */
+	extensions->dnssExpectedRatioMaximum._valueSpecified = (ALLOCATION_RATE * PAUSE_MICROS_PER_BYTE * SURVIVAL_RATE) / 2;
+	desiredSize = model.calculateDesiredSize(env, currentSize, minimumSize, maximumSize);
+	EXPECT_EQ(NURSERY_SIZING_PAUSE_TARGET_UNREACHABLE, model.getReason());
+	EXPECT_EQ(currentSize, desiredSize);
+}
+
+TEST_F(TestNurserySizingModel, reportsAFixedSizeWithoutDynamicSizing)
+{
+	addScavenges(16, FIXED_PAUSE_MICROS, PAUSE_MICROS_PER_BYTE);
+	extensions->scavengerPauseTarget = 3;
+	extensions->dynamicNewSpaceSizing = false;
+
+	model.reportDecision(env, 4 * 1024 * 1024, 0);
+	EXPECT_EQ(NURSERY_SIZING_SIZE_FIXED, model.getReason());
+}
+
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
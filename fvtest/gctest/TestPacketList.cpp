@@ -0,0 +1,208 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "AtomicOperations.hpp"
+#include "GCUnitTest.hpp"
+#include "omrthread.h"
+#include "Packet.hpp"
+#include "PacketList.hpp"
+
+#include <gtest/gtest.h>
+
+#define PACKET_LIST_TEST_PACKETS 64
+#define PACKET_LIST_TEST_SPLIT 4
+#define PACKET_LIST_TEST_THREADS 4
+#define PACKET_LIST_TEST_ITERATIONS 20000
+
+class TestPacketList : public GCUnitTest
+{
+protected:
+	MM_PacketList *list;
+	MM_Packet packets[PACKET_LIST_TEST_PACKETS];
+	MM_Packet *packetTable[PACKET_LIST_TEST_PACKETS];
+	uintptr_t savedPacketListSplit;
+
+	virtual void
+	SetUp()
+	{
+		list = NULL;
+		GCUnitTest::SetUp();
+		savedPacketListSplit = extensions->packetListSplit;
+		extensions->packetListSplit = PACKET_LIST_TEST_SPLIT;
+		list = (MM_PacketList *)env->getForge()->allocate(sizeof(MM_PacketList), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+		ASSERT_TRUE(NULL != list);
+		new (list) MM_PacketList(env);
+		ASSERT_TRUE(list->initialize(env));
+		for (uintptr_t i = 0; i < PACKET_LIST_TEST_PACKETS; i++) {
+			packets[i].setPacketIndex(i);
+			packetTable[i] = &packets[i];
+		}
+		list->setPacketTable(packetTable);
+	}
+
+	virtual void
+	TearDown()
+	{
+		if (NULL != list) {
+			list->tearDown(env);
+			env->getForge()->free(list);
+			list = NULL;
+		}
+		extensions->packetListSplit = savedPacketListSplit;
+		GCUnitTest::TearDown();
+	}
+
+	/**
+	 * Drain the list and check that every packet was on it exactly once.
+	 */
+	void
+	expectEveryPacketOnce()
+	{
+		uint8_t seen[PACKET_LIST_TEST_PACKETS];
+		memset(seen, 0, sizeof(seen));
+
+		uintptr_t expectedCount = list->getCount();
+		MM_Packet *head = NULL;
+		MM_Packet *tail = NULL;
+		uintptr_t count = 0;
+		ASSERT_TRUE(list->popList(&head, &tail, &count));
+		EXPECT_EQ(expectedCount, count);
+		EXPECT_TRUE(list->isEmpty());
+
+		uintptr_t walked = 0;
+		for (MM_Packet *packet = head; NULL != packet; packet = packet->_next) {
+			uintptr_t index = packet - packets;
+			ASSERT_GT((uintptr_t)PACKET_LIST_TEST_PACKETS, index);
+			EXPECT_EQ(0, seen[index]);
+			seen[index] += 1;
+			walked += 1;
+			if (packet == tail) {
+				EXPECT_TRUE(NULL == packet->_next);
+			}
+		}
+		EXPECT_EQ((uintptr_t)PACKET_LIST_TEST_PACKETS, walked);
+	}
+};
+
+TEST_F(TestPacketList, PushPopIsLastInFirstOut)
+{
+	EXPECT_TRUE(list->isLockFree());
+	EXPECT_TRUE(list->isEmpty());
+	EXPECT_TRUE(NULL == list->pop(env));
+
+	for (uintptr_t i = 0; i < PACKET_LIST_TEST_PACKETS; i++) {
+		list->push(env, &packets[i]);
+		EXPECT_EQ(i + 1, list->getCount());
+	}
+	for (uintptr_t i = PACKET_LIST_TEST_PACKETS; i > 0; i--) {
+		EXPECT_EQ(&packets[i - 1], list->pop(env));
+	}
+	EXPECT_TRUE(list->isEmpty());
+	EXPECT_TRUE(NULL == list->pop(env));
+}
+
+TEST_F(TestPacketList, PushListAndPopListKeepEveryPacket)
+{
+	/* chain half of the packets and push them in one go, push the rest one at a time */
+	uintptr_t half = PACKET_LIST_TEST_PACKETS / 2;
+	for (uintptr_t i = 0; i < half; i++) {
+		packets[i]._next = (i + 1 < half) ? &packets[i + 1] : NULL;
+	}
+	list->pushList(&packets[0], &packets[half - 1], half);
+	for (uintptr_t i = half; i < PACKET_LIST_TEST_PACKETS; i++) {
+		list->push(env, &packets[i]);
+	}
+	EXPECT_EQ((uintptr_t)PACKET_LIST_TEST_PACKETS, list->getCount());
+
+	/* getHead() reassembles the sublists into one without losing anything */
+	EXPECT_TRUE(NULL != list->getHead());
+	EXPECT_EQ((uintptr_t)PACKET_LIST_TEST_PACKETS, list->getCount());
+
+	expectEveryPacketOnce();
+}
+
+typedef struct PacketListRaceState {
+	OMR_VM *omrVM;
+	MM_PacketList *list;
+	volatile uintptr_t startedThreads;
+	volatile uintptr_t finishedThreads;
+	volatile uintptr_t failures;
+} PacketListRaceState;
+
+static int J9THREAD_PROC
+packetListWorker(void *arg)
+{
+	PacketListRaceState *state = (PacketListRaceState *)arg;
+	OMR_VMThread *omrVMThread = NULL;
+
+	if (OMR_ERROR_NONE != OMR_Thread_Init(state->omrVM, NULL, &omrVMThread, "PacketListTestThread")) {
+		MM_AtomicOperations::add(&state->failures, 1);
+	} else {
+		MM_EnvironmentBase *env = MM_EnvironmentBase::getEnvironment(omrVMThread);
+		MM_AtomicOperations::add(&state->startedThreads, 1);
+		while (PACKET_LIST_TEST_THREADS > (state->startedThreads + state->failures)) {
+			omrthread_yield();
+		}
+
+		/* each worker holds at most two packets at a time, so the list is never drained for long */
+		for (uintptr_t i = 0; i < PACKET_LIST_TEST_ITERATIONS; i++) {
+			MM_Packet *first = state->list->pop(env);
+			MM_Packet *second = state->list->pop(env);
+			if (NULL != first) {
+				state->list->push(env, first);
+			}
+			if (NULL != second) {
+				state->list->push(env, second);
+			}
+		}
+		OMR_Thread_Free(omrVMThread);
+	}
+
+	MM_AtomicOperations::add(&state->finishedThreads, 1);
+	return 0;
+}
+
+TEST_F(TestPacketList, ConcurrentPushPopNeitherLosesNorDuplicatesPackets)
+{
+	for (uintptr_t i = 0; i < PACKET_LIST_TEST_PACKETS; i++) {
+		list->push(env, &packets[i]);
+	}
+
+	PacketListRaceState state;
+	state.omrVM = exampleVM->_omrVM;
+	state.list = list;
+	state.startedThreads = 0;
+	state.finishedThreads = 0;
+	state.failures = 0;
+
+	for (uintptr_t i = 0; i < PACKET_LIST_TEST_THREADS; i++) {
+		omrthread_t worker = NULL;
+		ASSERT_EQ(0, omrthread_create(&worker, 0, J9THREAD_PRIORITY_NORMAL, 0, packetListWorker, &state));
+	}
+	while (PACKET_LIST_TEST_THREADS != state.finishedThreads) {
+		omrthread_yield();
+	}
+
+	EXPECT_EQ((uintptr_t)0, state.failures);
+	EXPECT_EQ((uintptr_t)PACKET_LIST_TEST_PACKETS, list->getCount());
+	expectEveryPacketOnce();
+}
@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include "EnvironmentStandard.hpp"
+#include "GCUnitTest.hpp"
+#include "ObjectAllocationModel.hpp"
+#include "ObjectModel.hpp"
+#include "omrgc.h"
+#include "Scavenger.hpp"
+#include "SlotObject.hpp"
+#include "SublistPool.hpp"
+#include "SublistPuddle.hpp"
+#include "SublistSlotIterator.hpp"
+
+#include <gtest/gtest.h>
+
+#define TEST_OBJECT_SIZE 64
+
+class TestRememberedSetPrune : public GCUnitTest
+{
+protected:
+	MM_SublistPool rememberedSet;
+
+	virtual const char *getConfigFile() { return "fvtest/gctest/configuration/scavenger_GC_config.xml"; }
+
+	virtual void
+	SetUp()
+	{
+		GCUnitTest::SetUp();
+		ASSERT_TRUE(rememberedSet.initialize(env, OMR::GC::AllocationCategory::REMEMBERED_SET));
+		rememberedSet.setGrowSize(OMR_SCV_REMSET_SIZE);
+	}
+
+	virtual void
+	TearDown()
+	{
+		rememberedSet.tearDown(env);
+		GCUnitTest::TearDown();
+	}
+
+	omrobjectptr_t
+	allocateObject(bool tenured)
+	{
+		MM_ObjectAllocationModel allocationModel(env, TEST_OBJECT_SIZE, MM_ObjectAllocationModel::selectObjectAllocationFlags(false, tenured, false, !tenured));
+		omrobjectptr_t objectPtr = OMR_GC_AllocateObject(exampleVM->_omrVMThread, &allocationModel);
+		EXPECT_TRUE(NULL != objectPtr);
+		EXPECT_EQ(tenured, extensions->isOld(objectPtr));
+		return objectPtr;
+	}
+
+	void
+	remember(omrobjectptr_t objectPtr, uintptr_t rememberedState, bool deferredRemove)
+	{
+		extensions->objectModel.setRememberedBits(objectPtr, rememberedState);
+		uintptr_t *element = rememberedSet.allocateElementNoContention(env);
+		ASSERT_TRUE(NULL != element);
+		*element = (uintptr_t)objectPtr | (deferredRemove ? DEFERRED_RS_REMOVE_FLAG : 0);
+		rememberedSet.incrementCount(1);
+	}
+
+	/**
+	 * Detach the list, as a scavenge does before handing it to the pruner, and prune every puddle of it.
+	 */
+	uintptr_t
+	prune()
+	{
+		MM_EnvironmentStandard *envStandard = MM_EnvironmentStandard::getEnvironment(env);
+		uintptr_t prunedCount = 0;
+		rememberedSet.startProcessingSublist();
+		MM_SublistPuddle *puddle = rememberedSet.popPreviousPuddle(NULL);
+		while (NULL != puddle) {
+			prunedCount += extensions->scavenger->prunePuddleConcurrently(envStandard, puddle);
+			puddle = rememberedSet.popPreviousPuddle(puddle);
+		}
+		return prunedCount;
+	}
+
+	void
+	flagForRemoval()
+	{
+		rememberedSet.startProcessingSublist();
+		MM_SublistPuddle *puddle = rememberedSet.popPreviousPuddle(NULL);
+		while (NULL != puddle) {
+			GC_SublistSlotIterator slotIterator(puddle);
+			uintptr_t *slotPtr = NULL;
+			while (NULL != (slotPtr = (uintptr_t *)slotIterator.nextSlot())) {
+				*slotPtr |= DEFERRED_RS_REMOVE_FLAG;
+			}
+			puddle = rememberedSet.popPreviousPuddle(puddle);
+		}
+	}
+};
+
+/**
+ * Objects tenured from the stack age by one state per prune, and only leave once flagged as a scavenge would flag them.
+ */
+TEST_F(TestRememberedSetPrune, AgesStackReferencedObjects)
+{
+	omrobjectptr_t objectPtr = allocateObject(true);
+	remember(objectPtr, OMR_TENURED_STACK_OBJECT_CURRENTLY_REFERENCED, false);
+
+	ASSERT_EQ((uintptr_t)0, prune());
+	ASSERT_EQ((uintptr_t)OMR_TENURED_STACK_OBJECT_RECENTLY_REFERENCED, extensions->objectModel.getRememberedBits(objectPtr));
+	ASSERT_EQ((uintptr_t)1, rememberedSet.countElements());
+
+	ASSERT_EQ((uintptr_t)0, prune());
+	ASSERT_EQ((uintptr_t)STATE_REMEMBERED, extensions->objectModel.getRememberedBits(objectPtr));
+	ASSERT_EQ((uintptr_t)1, rememberedSet.countElements());
+
+	ASSERT_EQ((uintptr_t)0, prune());
+	ASSERT_EQ((uintptr_t)STATE_REMEMBERED, extensions->objectModel.getRememberedBits(objectPtr));
+
+	flagForRemoval();
+	ASSERT_EQ((uintptr_t)1, prune());
+	ASSERT_FALSE(extensions->objectModel.isRemembered(objectPtr));
+	ASSERT_EQ((uintptr_t)0, rememberedSet.countElements());
+}
+
+/**
+ * A flagged object which is still referenced from a stack has no nursery references, so it goes as in the pause prune.
+ */
+TEST_F(TestRememberedSetPrune, RemovesFlaggedStackReferencedObjects)
+{
+	omrobjectptr_t currentlyReferenced = allocateObject(true);
+	omrobjectptr_t recentlyReferenced = allocateObject(true);
+	remember(currentlyReferenced, OMR_TENURED_STACK_OBJECT_CURRENTLY_REFERENCED, true);
+	remember(recentlyReferenced, OMR_TENURED_STACK_OBJECT_RECENTLY_REFERENCED, true);
+
+	ASSERT_EQ((uintptr_t)2, prune());
+	ASSERT_FALSE(extensions->objectModel.isRemembered(currentlyReferenced));
+	ASSERT_FALSE(extensions->objectModel.isRemembered(recentlyReferenced));
+	ASSERT_EQ((uintptr_t)0, rememberedSet.countElements());
+}
+
+/**
+ * A flagged object which a mutator pointed at the nursery after the pause stays remembered, and its flag is cleared.
+ */
+TEST_F(TestRememberedSetPrune, KeepsObjectsWithNurseryReferences)
+{
+	omrobjectptr_t parentPtr = allocateObject(true);
+	omrobjectptr_t childPtr = allocateObject(false);
+	GC_SlotObject slotObject(exampleVM->_omrVM, (fomrobject_t *)parentPtr + 1);
+	slotObject.writeReferenceToSlot(childPtr);
+	remember(parentPtr, STATE_REMEMBERED, true);
+
+	ASSERT_EQ((uintptr_t)0, prune());
+	ASSERT_EQ((uintptr_t)STATE_REMEMBERED, extensions->objectModel.getRememberedBits(parentPtr));
+	ASSERT_EQ((uintptr_t)1, rememberedSet.countElements());
+
+	/* The entry is no longer flagged: without the nursery reference it stays until the next scavenge flags it */
+	slotObject.writeReferenceToSlot(NULL);
+	ASSERT_EQ((uintptr_t)0, prune());
+	ASSERT_EQ((uintptr_t)STATE_REMEMBERED, extensions->objectModel.getRememberedBits(parentPtr));
+
+	flagForRemoval();
+	ASSERT_EQ((uintptr_t)1, prune());
+	ASSERT_FALSE(extensions->objectModel.isRemembered(parentPtr));
+}
+
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include "GCUnitTest.hpp"
+#include "ScavengerHotFieldTable.hpp"
+
+#include <gtest/gtest.h>
+
+#define TEST_CLASS_KEY 0x100
+
+class TestScavengerHotFieldTable : public GCUnitTest
+{
+protected:
+	MM_ScavengerHotFieldTable *table;
+
+	virtual void
+	SetUp()
+	{
+		GCUnitTest::SetUp();
+		table = MM_ScavengerHotFieldTable::newInstance(env, 16);
+		ASSERT_TRUE(NULL != table);
+	}
+
+	virtual void
+	TearDown()
+	{
+		table->kill(env);
+		GCUnitTest::TearDown();
+	}
+
+	void
+	recordSamples(uintptr_t classKey, uintptr_t offset, uintptr_t count)
+	{
+		for (uintptr_t i = 0; i < count; i++) {
+			table->recordSample(classKey, offset);
+		}
+	}
+};
+
+/**
+ * Nothing is published before the first scavenge, and the hottest candidates are published in order.
+ */
+TEST_F(TestScavengerHotFieldTable, PublishesHottestFirst)
+{
+	recordSamples(TEST_CLASS_KEY, 5, 4);
+	recordSamples(TEST_CLASS_KEY, 3, 9);
+	recordSamples(TEST_CLASS_KEY, 7, 2);
+	ASSERT_TRUE(NULL == table->getHotFieldOffsets(TEST_CLASS_KEY));
+
+	ASSERT_EQ((uintptr_t)1, table->publish(env));
+	const uint8_t *offsets = table->getHotFieldOffsets(TEST_CLASS_KEY);
+	ASSERT_TRUE(NULL != offsets);
+	ASSERT_EQ(3, offsets[0]);
+	ASSERT_EQ(5, offsets[1]);
+	ASSERT_EQ(7, offsets[2]);
+	ASSERT_TRUE(NULL == table->getHotFieldOffsets(TEST_CLASS_KEY + 1));
+}
+
+/**
+ * A sample of an untracked slot while every candidate is busy ages the candidates, which stop at 0 and are then replaced.
+ */
+TEST_F(TestScavengerHotFieldTable, AgesCandidatesToZero)
+{
+	for (uintptr_t offset = 1; offset <= MM_ScavengerHotFieldTable::CANDIDATE_COUNT; offset++) {
+		recordSamples(TEST_CLASS_KEY, offset, 1);
+	}
+	/* The first sample ages every candidate to 0, the others must not wrap the counts */
+	recordSamples(TEST_CLASS_KEY, 9, 1);
+	recordSamples(TEST_CLASS_KEY, 10, 1);
+	recordSamples(TEST_CLASS_KEY, 9, 2);
+
+	ASSERT_EQ((uintptr_t)1, table->publish(env));
+	const uint8_t *offsets = table->getHotFieldOffsets(TEST_CLASS_KEY);
+	ASSERT_TRUE(NULL != offsets);
+	ASSERT_EQ(9, offsets[0]);
+	ASSERT_EQ(10, offsets[1]);
+	ASSERT_EQ(U_8_MAX, offsets[2]);
+}
+
+/**
+ * Publishing halves the counts, so a field which is no longer dereferenced gives way to one that is.
+ */
+TEST_F(TestScavengerHotFieldTable, FollowsPhaseChanges)
+{
+	recordSamples(TEST_CLASS_KEY, 2, 8);
+	table->publish(env);
+	ASSERT_EQ(2, table->getHotFieldOffsets(TEST_CLASS_KEY)[0]);
+
+	recordSamples(TEST_CLASS_KEY, 6, 5);
+	table->publish(env);
+	ASSERT_EQ(6, table->getHotFieldOffsets(TEST_CLASS_KEY)[0]);
+	ASSERT_EQ(2, table->getHotFieldOffsets(TEST_CLASS_KEY)[1]);
+
+	for (uintptr_t i = 0; i < 8; i++) {
+		table->publish(env);
+	}
+	ASSERT_TRUE(NULL == table->getHotFieldOffsets(TEST_CLASS_KEY));
+}
+
+/**
+ * Samples the table can not describe (no class key, offset beyond a byte) are ignored.
+ */
+TEST_F(TestScavengerHotFieldTable, IgnoresUntrackableSamples)
+{
+	recordSamples(0, 3, 4);
+	recordSamples(TEST_CLASS_KEY, U_8_MAX, 4);
+	recordSamples(TEST_CLASS_KEY, U_8_MAX + 1, 4);
+
+	ASSERT_EQ((uintptr_t)0, table->publish(env));
+	ASSERT_TRUE(NULL == table->getHotFieldOffsets(0));
+	ASSERT_TRUE(NULL == table->getHotFieldOffsets(TEST_CLASS_KEY));
+	ASSERT_EQ((uintptr_t)0, table->getDroppedSamples());
+}
+
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
@@ -0,0 +1,180 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_SEGREGATED_HEAP)
+
+#include "omrport.h"
+
+#include "GCUnitTest.hpp"
+#include "SizeClassTuner.hpp"
+
+#include <gtest/gtest.h>
+
+#define TEST_TABLE_FILE "TestSizeClassTuner.table"
+
+class TestSizeClassTuner : public GCUnitTest
+{
+protected:
+	MM_SizeClassTuner *tuner;
+	uintptr_t histogram[MM_SizeClassTuner::HISTOGRAM_BUCKETS];
+	uintptr_t cellSizes[OMR_SIZECLASSES_NUM_SMALL + 1];
+
+	virtual void
+	SetUp()
+	{
+		GCUnitTest::SetUp();
+		memset(histogram, 0, sizeof(histogram));
+		memset(cellSizes, 0, sizeof(cellSizes));
+		tuner = MM_SizeClassTuner::newInstance(env);
+		ASSERT_TRUE(NULL != tuner);
+	}
+
+	virtual void
+	TearDown()
+	{
+		OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+		omrfile_unlink(TEST_TABLE_FILE);
+		tuner->kill(env);
+		GCUnitTest::TearDown();
+	}
+
+	/**
+	 * Fill the histogram from a linear congruential generator, favouring small sizes as allocations do.
+	 */
+	void
+	fillRandomHistogram(uint32_t seed)
+	{
+		for (uintptr_t i = 0; i < 4000; i++) {
+			seed = (seed * 1103515245) + 12345;
+			uintptr_t bucket = 2 + ((seed >> 8) % (MM_SizeClassTuner::HISTOGRAM_BUCKETS - 2));
+			seed = (seed * 1103515245) + 12345;
+			if (0 != ((seed >> 8) & 1)) {
+				bucket = 2 + ((bucket - 2) / 8);
+			}
+			histogram[bucket] += 1 + ((seed >> 12) % 50);
+		}
+	}
+
+	/**
+	 * Exhaustive search for the least waste, against which the tuned table is checked.
+	 */
+	uint64_t
+	leastWaste()
+	{
+		const uintptr_t buckets = MM_SizeClassTuner::HISTOGRAM_BUCKETS;
+		const uintptr_t minimumGranule = ((uintptr_t)1 << OMR_SIZECLASSES_LOG_SMALLEST) >> MM_SizeClassTuner::GRANULE_SHIFT;
+		uint64_t previous[MM_SizeClassTuner::HISTOGRAM_BUCKETS];
+		uint64_t current[MM_SizeClassTuner::HISTOGRAM_BUCKETS];
+
+		for (uintptr_t j = 0; j < buckets; j++) {
+			previous[j] = (j < minimumGranule) ? U_64_MAX : waste(0, j);
+		}
+		for (uintptr_t sizeClass = 2; sizeClass <= OMR_SIZECLASSES_NUM_SMALL; sizeClass++) {
+			for (uintptr_t j = 0; j < buckets; j++) {
+				current[j] = U_64_MAX;
+				for (uintptr_t i = 0; i < j; i++) {
+					if (U_64_MAX != previous[i]) {
+						current[j] = OMR_MIN(current[j], previous[i] + waste(i, j));
+					}
+				}
+			}
+			memcpy(previous, current, sizeof(previous));
+		}
+		return previous[buckets - 1];
+	}
+
+	uint64_t
+	waste(uintptr_t lower, uintptr_t upper)
+	{
+		uint64_t result = 0;
+		for (uintptr_t granule = lower + 1; granule <= upper; granule++) {
+			result += (uint64_t)histogram[granule] * (upper - granule) << MM_SizeClassTuner::GRANULE_SHIFT;
+		}
+		return result;
+	}
+};
+
+/**
+ * A histogram with no more distinct sizes than size classes is served without waste.
+ */
+TEST_F(TestSizeClassTuner, NoWasteForFewSizes)
+{
+	for (uintptr_t sizeClass = 1; sizeClass < OMR_SIZECLASSES_NUM_SMALL; sizeClass++) {
+		histogram[MM_SizeClassTuner::getHistogramBucket(16 + (sizeClass * 24))] = sizeClass * 10;
+	}
+	histogram[MM_SizeClassTuner::getHistogramBucket(OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES)] = 3;
+
+	ASSERT_TRUE(tuner->computeCellSizes(histogram, cellSizes));
+	ASSERT_TRUE(MM_SizeClassTuner::isValidCellSizeTable(cellSizes));
+	uintptr_t requestedBytes = 0;
+	ASSERT_EQ((uintptr_t)0, MM_SizeClassTuner::computeWaste(histogram, cellSizes, NULL, &requestedBytes));
+	ASSERT_LT((uintptr_t)0, requestedBytes);
+}
+
+/**
+ * The tuned table is valid and wastes no more than the best table an exhaustive search finds.
+ */
+TEST_F(TestSizeClassTuner, MatchesExhaustiveSearch)
+{
+	for (uint32_t seed = 1; seed <= 3; seed++) {
+		memset(histogram, 0, sizeof(histogram));
+		fillRandomHistogram(seed);
+
+		ASSERT_TRUE(tuner->computeCellSizes(histogram, cellSizes));
+		ASSERT_TRUE(MM_SizeClassTuner::isValidCellSizeTable(cellSizes));
+		ASSERT_EQ(leastWaste(), (uint64_t)MM_SizeClassTuner::computeWaste(histogram, cellSizes, NULL, NULL));
+	}
+}
+
+/**
+ * No table is computed from an empty histogram.
+ */
+TEST_F(TestSizeClassTuner, EmptyHistogram)
+{
+	ASSERT_FALSE(tuner->computeCellSizes(histogram, cellSizes));
+}
+
+/**
+ * A saved table is read back unchanged, and a table the size classes can not use is rejected.
+ */
+TEST_F(TestSizeClassTuner, SaveAndLoad)
+{
+	uintptr_t loaded[OMR_SIZECLASSES_NUM_SMALL + 1];
+	fillRandomHistogram(7);
+	ASSERT_TRUE(tuner->computeCellSizes(histogram, cellSizes));
+
+	ASSERT_TRUE(MM_SizeClassTuner::saveCellSizes(env, TEST_TABLE_FILE, cellSizes));
+	ASSERT_TRUE(MM_SizeClassTuner::loadCellSizes(env, TEST_TABLE_FILE, loaded));
+	for (uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL; sizeClass <= OMR_SIZECLASSES_MAX_SMALL; sizeClass++) {
+		ASSERT_EQ(cellSizes[sizeClass], loaded[sizeClass]);
+	}
+
+	cellSizes[OMR_SIZECLASSES_MIN_SMALL + 1] = cellSizes[OMR_SIZECLASSES_MIN_SMALL];
+	ASSERT_FALSE(MM_SizeClassTuner::isValidCellSizeTable(cellSizes));
+	ASSERT_TRUE(MM_SizeClassTuner::saveCellSizes(env, TEST_TABLE_FILE, cellSizes));
+	ASSERT_FALSE(MM_SizeClassTuner::loadCellSizes(env, TEST_TABLE_FILE, loaded));
+	ASSERT_FALSE(MM_SizeClassTuner::loadCellSizes(env, TEST_TABLE_FILE ".missing", loaded));
+}
+
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
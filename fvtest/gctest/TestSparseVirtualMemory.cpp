@@ -0,0 +1,199 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_SPARSE_HEAP_ALLOCATION)
+
+#include "omrExampleVM.hpp"
+#include "omrgc.h"
+#include "omrport.h"
+
+#include "GCUnitTest.hpp"
+#include "SparseAddressOrderedFixedSizeDataPool.hpp"
+#include "SparseVirtualMemory.hpp"
+
+#include <gtest/gtest.h>
+
+class TestSparseVirtualMemory : public GCUnitTest
+{
+protected:
+	MM_SparseVirtualMemory *sparseMemory;
+	uintptr_t savedPageSize;
+	uintptr_t savedPageFlags;
+	uintptr_t savedAllocationGranule;
+	uintptr_t savedDecommitBatchSize;
+	MM_SparseVirtualMemory *savedLargeObjectVirtualMemory;
+	uintptr_t pageSize;
+	uintptr_t proxies[8];
+
+	virtual void
+	SetUp()
+	{
+		sparseMemory = NULL;
+		GCUnitTest::SetUp();
+		savedPageSize = extensions->sparseHeapPageSize;
+		savedPageFlags = extensions->sparseHeapPageFlags;
+		savedAllocationGranule = extensions->sparseHeapAllocationGranule;
+		savedDecommitBatchSize = extensions->sparseHeapDecommitBatchSize;
+		savedLargeObjectVirtualMemory = extensions->largeObjectVirtualMemory;
+
+		/* default pages keep the reservation small and the sizes below exact */
+		OMRPORT_ACCESS_FROM_OMRVM(exampleVM->_omrVM);
+		pageSize = omrvmem_supported_page_sizes()[0];
+		extensions->sparseHeapPageSize = pageSize;
+		extensions->sparseHeapPageFlags = OMRPORT_VMEM_PAGE_FLAG_NOT_USED;
+	}
+
+	virtual void
+	TearDown()
+	{
+		extensions->largeObjectVirtualMemory = savedLargeObjectVirtualMemory;
+		if (NULL != sparseMemory) {
+			sparseMemory->decommitFreedSparseRegions(env);
+			sparseMemory->kill(env);
+			sparseMemory = NULL;
+		}
+		extensions->sparseHeapPageSize = savedPageSize;
+		extensions->sparseHeapPageFlags = savedPageFlags;
+		extensions->sparseHeapAllocationGranule = savedAllocationGranule;
+		extensions->sparseHeapDecommitBatchSize = savedDecommitBatchSize;
+		GCUnitTest::TearDown();
+	}
+
+	void
+	createSparseMemory(uintptr_t granule, uintptr_t decommitBatchSize)
+	{
+		extensions->sparseHeapAllocationGranule = granule;
+		extensions->sparseHeapDecommitBatchSize = decommitBatchSize;
+		sparseMemory = MM_SparseVirtualMemory::newInstance(env, OMRMEM_CATEGORY_MM, extensions->heap);
+		ASSERT_TRUE(NULL != sparseMemory);
+		ASSERT_EQ(pageSize, sparseMemory->getPageSize());
+	}
+
+	uintptr_t
+	dataSize(void *dataPtr)
+	{
+		return sparseMemory->getSparseDataPool()->findObjectDataSizeForSparseDataPtr(dataPtr);
+	}
+};
+
+TEST_F(TestSparseVirtualMemory, roundsOnlyDataOfAGranuleToGranules)
+{
+	uintptr_t granule = 4 * pageSize;
+	createSparseMemory(granule, 0);
+	ASSERT_EQ(granule, sparseMemory->getAllocationGranule());
+
+	void *large = sparseMemory->allocateSparseFreeEntryAndMapToHeapObject(&proxies[0], granule + 1);
+	ASSERT_TRUE(NULL != large);
+	EXPECT_EQ(2 * granule, dataSize(large));
+	EXPECT_EQ((uintptr_t)0, (uintptr_t)large % granule);
+
+	void *small = sparseMemory->allocateSparseFreeEntryAndMapToHeapObject(&proxies[1], pageSize + 1);
+	ASSERT_TRUE(NULL != small);
+	EXPECT_EQ(2 * pageSize, dataSize(small));
+
+	EXPECT_TRUE(sparseMemory->freeSparseRegionAndUnmapFromHeapObject(env, small));
+	EXPECT_TRUE(sparseMemory->freeSparseRegionAndUnmapFromHeapObject(env, large));
+}
+
+TEST_F(TestSparseVirtualMemory, holdsFreedDataUntilTheBatchIsFlushed)
+{
+	createSparseMemory(0, 64 * pageSize);
+
+	void *data[3];
+	for (uintptr_t i = 0; i < 3; i++) {
+		data[i] = sparseMemory->allocateSparseFreeEntryAndMapToHeapObject(&proxies[i], 2 * pageSize);
+		ASSERT_TRUE(NULL != data[i]);
+	}
+	/* the data is zeroed again by the decommit before it is reused */
+	memset(data[0], 0xA5, 2 * pageSize);
+
+	EXPECT_TRUE(sparseMemory->freeSparseRegionAndUnmapFromHeapObject(env, data[0]));
+	EXPECT_TRUE(sparseMemory->freeSparseRegionAndUnmapFromHeapObject(env, data[1]));
+	EXPECT_EQ(4 * pageSize, sparseMemory->getPendingDecommitBytes());
+	EXPECT_EQ((uintptr_t)0, dataSize(data[0]));
+
+	/* pending regions are not handed out again */
+	void *other = sparseMemory->allocateSparseFreeEntryAndMapToHeapObject(&proxies[3], 2 * pageSize);
+	ASSERT_TRUE(NULL != other);
+	EXPECT_NE(data[0], other);
+	EXPECT_NE(data[1], other);
+
+	EXPECT_TRUE(sparseMemory->decommitFreedSparseRegions(env));
+	EXPECT_EQ((uintptr_t)0, sparseMemory->getPendingDecommitBytes());
+
+	/* the two adjacent regions went back to the free list as one entry */
+	void *reused = sparseMemory->allocateSparseFreeEntryAndMapToHeapObject(&proxies[4], 4 * pageSize);
+	ASSERT_EQ(data[0], reused);
+	for (uintptr_t i = 0; i < (4 * pageSize); i++) {
+		ASSERT_EQ(0, ((uint8_t *)reused)[i]);
+	}
+
+	EXPECT_TRUE(sparseMemory->freeSparseRegionAndUnmapFromHeapObject(env, reused));
+	EXPECT_TRUE(sparseMemory->freeSparseRegionAndUnmapFromHeapObject(env, data[2]));
+	EXPECT_TRUE(sparseMemory->freeSparseRegionAndUnmapFromHeapObject(env, other));
+}
+
+TEST_F(TestSparseVirtualMemory, flushesTheBatchOnceItIsFull)
+{
+	createSparseMemory(0, 4 * pageSize);
+
+	void *first = sparseMemory->allocateSparseFreeEntryAndMapToHeapObject(&proxies[0], 2 * pageSize);
+	void *second = sparseMemory->allocateSparseFreeEntryAndMapToHeapObject(&proxies[1], 2 * pageSize);
+	ASSERT_TRUE((NULL != first) && (NULL != second));
+
+	EXPECT_TRUE(sparseMemory->freeSparseRegionAndUnmapFromHeapObject(env, first));
+	EXPECT_EQ(2 * pageSize, sparseMemory->getPendingDecommitBytes());
+	EXPECT_TRUE(sparseMemory->freeSparseRegionAndUnmapFromHeapObject(env, second));
+	EXPECT_EQ((uintptr_t)0, sparseMemory->getPendingDecommitBytes());
+}
+
+TEST_F(TestSparseVirtualMemory, flushesTheBatchAtTheEndOfACollection)
+{
+	createSparseMemory(0, 64 * pageSize);
+	extensions->largeObjectVirtualMemory = sparseMemory;
+
+	void *data = sparseMemory->allocateSparseFreeEntryAndMapToHeapObject(&proxies[0], 2 * pageSize);
+	ASSERT_TRUE(NULL != data);
+	EXPECT_TRUE(sparseMemory->freeSparseRegionAndUnmapFromHeapObject(env, data));
+	EXPECT_EQ(2 * pageSize, sparseMemory->getPendingDecommitBytes());
+
+	/* the example collector scans these for roots, an empty heap needs them empty */
+	OMRPORT_ACCESS_FROM_OMRVM(exampleVM->_omrVM);
+	exampleVM->rootTable = hashTableNew(OMRPORTLIB, OMR_GET_CALLSITE(), 0, sizeof(RootEntry), 0, 0, OMRMEM_CATEGORY_MM, rootTableHashFn, rootTableHashEqualFn, NULL, NULL);
+	exampleVM->objectTable = hashTableNew(OMRPORTLIB, OMR_GET_CALLSITE(), 0, sizeof(ObjectEntry), 0, 0, OMRMEM_CATEGORY_MM, objectTableHashFn, objectTableHashEqualFn, NULL, NULL);
+	ASSERT_TRUE((NULL != exampleVM->rootTable) && (NULL != exampleVM->objectTable));
+
+	omr_error_t rc = OMR_GC_SystemCollect(exampleVM->_omrVMThread, 0);
+
+	hashTableFree(exampleVM->rootTable);
+	exampleVM->rootTable = NULL;
+	hashTableFree(exampleVM->objectTable);
+	exampleVM->objectTable = NULL;
+
+	ASSERT_EQ(OMR_ERROR_NONE, rc);
+	EXPECT_EQ((uintptr_t)0, sparseMemory->getPendingDecommitBytes());
+}
+
+#endif /* defined(OMR_GC_SPARSE_HEAP_ALLOCATION) */
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "GCUnitTest.hpp"
+#include "TaskThreadScalingModel.hpp"
+
+#include <gtest/gtest.h>
+
+#define TEST_TASK_ID 7
+
+class TestTaskThreadScalingModel : public GCUnitTest
+{
+protected:
+	MM_TaskThreadScalingModel model;
+
+	/**
+	 * Record samples of T(n) = serial + parallel/n + coordination*n for every thread count up to maximumThreadCount.
+	 */
+	void
+	recordCurve(uintptr_t maximumThreadCount, double serial, double parallel, double coordination)
+	{
+		for (uintptr_t round = 0; round < 4; round++) {
+			for (uintptr_t threadCount = 1; threadCount <= maximumThreadCount; threadCount++) {
+				double time = serial + (parallel / (double)threadCount) + (coordination * (double)threadCount);
+				model.recordSample(env, TEST_TASK_ID, threadCount, (uint64_t)time);
+			}
+		}
+	}
+
+	/**
+	 * The fewest threads predicted to come within the tolerance of the minimum time of the curve.
+	 */
+	uintptr_t
+	expectedThreadCount(uintptr_t maximumThreadCount, double serial, double parallel, double coordination, double tolerance)
+	{
+		double bestTime = serial + parallel + coordination;
+		for (uintptr_t threadCount = 2; threadCount <= maximumThreadCount; threadCount++) {
+			bestTime = OMR_MIN(bestTime, serial + (parallel / (double)threadCount) + (coordination * (double)threadCount));
+		}
+		uintptr_t threadCount = 1;
+		while ((threadCount < maximumThreadCount) && ((serial + (parallel / (double)threadCount) + (coordination * (double)threadCount)) > (bestTime * (1.0 + tolerance)))) {
+			threadCount += 1;
+		}
+		return threadCount;
+	}
+};
+
+/**
+ * Before the curve is determined, the full, half and quarter thread counts are probed.
+ */
+TEST_F(TestTaskThreadScalingModel, ProbesUntilFitted)
+{
+	model.initialize(0.05f);
+	bool probed[17] = {false};
+	for (uintptr_t i = 0; i < 3; i++) {
+		uintptr_t threadCount = model.recommendThreadCount(env, TEST_TASK_ID, 16);
+		ASSERT_GE((uintptr_t)16, threadCount);
+		probed[threadCount] = true;
+	}
+	ASSERT_TRUE(probed[16]);
+	ASSERT_TRUE(probed[8]);
+	ASSERT_TRUE(probed[4]);
+
+	ASSERT_EQ((uintptr_t)1, model.recommendThreadCount(env, TEST_TASK_ID, 1));
+}
+
+/**
+ * Samples of a known curve are fitted well enough to recommend the thread count the curve itself would.
+ */
+TEST_F(TestTaskThreadScalingModel, FitsScalingCurve)
+{
+	model.initialize(0.05f);
+	recordCurve(16, 1000.0, 8000.0, 50.0);
+	ASSERT_EQ(expectedThreadCount(16, 1000.0, 8000.0, 50.0, 0.05), model.recommendThreadCount(env, TEST_TASK_ID, 16));
+
+	/* a task which does not scale runs single threaded */
+	model.initialize(0.05f);
+	recordCurve(16, 5000.0, 0.0, 0.0);
+	ASSERT_EQ((uintptr_t)1, model.recommendThreadCount(env, TEST_TASK_ID, 16));
+
+	/* a task which scales perfectly uses every thread the budget allows */
+	model.initialize(0.0f);
+	recordCurve(16, 0.0, 160000.0, 0.0);
+	ASSERT_EQ((uintptr_t)16, model.recommendThreadCount(env, TEST_TASK_ID, 16));
+}
+
+/**
+ * With a budget of two threads the model still learns whether the second thread pays for itself.
+ */
+TEST_F(TestTaskThreadScalingModel, LearnsWithTwoThreads)
+{
+	model.initialize(0.05f);
+	bool probed[3] = {false};
+	for (uintptr_t i = 0; i < 3; i++) {
+		probed[model.recommendThreadCount(env, TEST_TASK_ID, 2)] = true;
+	}
+	ASSERT_TRUE(probed[1]);
+	ASSERT_TRUE(probed[2]);
+
+	recordCurve(2, 1000.0, 0.0, 0.0);
+	ASSERT_EQ((uintptr_t)1, model.recommendThreadCount(env, TEST_TASK_ID, 2));
+
+	model.initialize(0.05f);
+	recordCurve(2, 100.0, 1000.0, 0.0);
+	ASSERT_EQ((uintptr_t)2, model.recommendThreadCount(env, TEST_TASK_ID, 2));
+}
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_REALTIME)
+
+#include "GCUnitTest.hpp"
+#include "Packet.hpp"
+#include "WorkPacketsSATB.hpp"
+
+#include <gtest/gtest.h>
+
+class TestWorkPacketsSATB : public GCUnitTest
+{
+protected:
+	MM_WorkPacketsSATB *workPackets;
+	bool savedThreadOwned;
+
+	virtual void
+	SetUp()
+	{
+		workPackets = NULL;
+		GCUnitTest::SetUp();
+		savedThreadOwned = extensions->sATBBarrierPacketsThreadOwned;
+	}
+
+	virtual void
+	TearDown()
+	{
+		if (NULL != workPackets) {
+			workPackets->resetAllPackets(env);
+			workPackets->kill(env);
+			workPackets = NULL;
+		}
+		extensions->sATBBarrierPacketsThreadOwned = savedThreadOwned;
+		GCUnitTest::TearDown();
+	}
+
+	void
+	createWorkPackets(bool threadOwned)
+	{
+		extensions->sATBBarrierPacketsThreadOwned = threadOwned;
+		workPackets = MM_WorkPacketsSATB::newInstance(env);
+		ASSERT_TRUE(NULL != workPackets);
+	}
+
+	MM_Packet *
+	getFilledBarrierPacket()
+	{
+		MM_Packet *packet = workPackets->getBarrierPacket(env);
+		if (NULL != packet) {
+			packet->push(env, (void *)packet);
+		}
+		return packet;
+	}
+
+	/**
+	 * @return the number of packets holding work which are no longer in use by the barrier
+	 */
+	uintptr_t
+	getPublishedPacketCount()
+	{
+		return workPackets->getNonEmptyPacketCount() - workPackets->getBarrierPacketCount();
+	}
+};
+
+/**
+ * By default barrier packets are kept on the shared in use list and moved to the non empty list at the final flush.
+ */
+TEST_F(TestWorkPacketsSATB, InUseListByDefault)
+{
+	createWorkPackets(false);
+	MM_Packet *packet = getFilledBarrierPacket();
+	ASSERT_TRUE(NULL != packet);
+
+	workPackets->putInUsePacket(env, packet);
+	ASSERT_TRUE(NULL == env->_satbBarrierPacket);
+	ASSERT_EQ((uintptr_t)1, workPackets->getBarrierPacketCount());
+
+	workPackets->moveInUseToNonEmpty(env);
+	ASSERT_EQ((uintptr_t)0, workPackets->getBarrierPacketCount());
+	ASSERT_EQ((uintptr_t)1, getPublishedPacketCount());
+}
+
+/**
+ * A thread owned packet is counted as in use, and the final flush publishes it from the owning thread.
+ */
+TEST_F(TestWorkPacketsSATB, FinalFlushPublishesThreadOwnedPacket)
+{
+	createWorkPackets(true);
+	MM_Packet *packet = getFilledBarrierPacket();
+	ASSERT_TRUE(NULL != packet);
+
+	workPackets->putInUsePacket(env, packet);
+	ASSERT_TRUE(packet == env->_satbBarrierPacket);
+	ASSERT_EQ((uintptr_t)1, workPackets->getBarrierPacketCount());
+	ASSERT_TRUE(workPackets->inUsePacketsAvailable(env));
+	ASSERT_EQ((uintptr_t)0, getPublishedPacketCount());
+
+	workPackets->moveInUseToNonEmpty(env);
+	ASSERT_TRUE(NULL == env->_satbBarrierPacket);
+	ASSERT_TRUE(NULL == env->_satbBarrierPacketOwner);
+	ASSERT_EQ((uintptr_t)0, workPackets->getBarrierPacketCount());
+	ASSERT_EQ((uintptr_t)1, getPublishedPacketCount());
+}
+
+/**
+ * Taking a new barrier packet publishes the one the thread still owned rather than dropping it.
+ */
+TEST_F(TestWorkPacketsSATB, NewPacketPublishesPreviousPacket)
+{
+	createWorkPackets(true);
+	MM_Packet *first = getFilledBarrierPacket();
+	MM_Packet *second = getFilledBarrierPacket();
+	ASSERT_TRUE((NULL != first) && (NULL != second));
+
+	workPackets->putInUsePacket(env, first);
+	workPackets->putInUsePacket(env, second);
+	ASSERT_TRUE(second == env->_satbBarrierPacket);
+	ASSERT_EQ((uintptr_t)1, workPackets->getBarrierPacketCount());
+	ASSERT_EQ((uintptr_t)1, getPublishedPacketCount());
+
+	/* A packet removed from use by its owner is no longer owned or counted */
+	workPackets->removePacketFromInUseList(env, second);
+	ASSERT_TRUE(NULL == env->_satbBarrierPacket);
+	ASSERT_EQ((uintptr_t)0, workPackets->getBarrierPacketCount());
+	workPackets->putFullPacket(env, second);
+}
+
+#endif /* defined(OMR_GC_REALTIME) */
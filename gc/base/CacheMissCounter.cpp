@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base
+ */
+
+#include "omrcfg.h"
+
+#include "CacheMissCounter.hpp"
+
+#if defined(LINUX)
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * Open a generic hardware counter for the calling thread, on any CPU, counting user mode only.
+ * The kernel maps the generic cache events onto the last level cache where the processor allows.
+ * @return the counter file descriptor, or -1 on failure
+ */
+static intptr_t
+openHardwareCounter(uint64_t event)
+{
+	struct perf_event_attr attributes;
+
+	memset(&attributes, 0, sizeof(attributes));
+	attributes.type = PERF_TYPE_HARDWARE;
+	attributes.size = sizeof(attributes);
+	attributes.config = event;
+	attributes.exclude_kernel = 1;
+	attributes.exclude_hv = 1;
+
+	return (intptr_t)syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+/**
+ * Read the running count of a counter.
+ * @return the count, or 0 if it could not be read
+ */
+static uint64_t
+readHardwareCounter(intptr_t counter)
+{
+	uint64_t count = 0;
+
+	if (sizeof(count) != read((int)counter, &count, sizeof(count))) {
+		count = 0;
+	}
+
+	return count;
+}
+#endif /* defined(LINUX) */
+
+bool
+MM_CacheMissCounter::open()
+{
+#if defined(LINUX)
+	_referencesCounter = openHardwareCounter(PERF_COUNT_HW_CACHE_REFERENCES);
+	if (-1 != _referencesCounter) {
+		_missesCounter = openHardwareCounter(PERF_COUNT_HW_CACHE_MISSES);
+		if (-1 == _missesCounter) {
+			close((int)_referencesCounter);
+			_referencesCounter = -1;
+		}
+	}
+#endif /* defined(LINUX) */
+
+	_unavailable = (-1 == _missesCounter);
+	return !_unavailable;
+}
+
+bool
+MM_CacheMissCounter::start()
+{
+	bool started = false;
+
+	if ((-1 != _missesCounter) || (!_unavailable && open())) {
+#if defined(LINUX)
+		_referencesAtStart = readHardwareCounter(_referencesCounter);
+		_missesAtStart = readHardwareCounter(_missesCounter);
+#endif /* defined(LINUX) */
+		started = true;
+	}
+
+	return started;
+}
+
+void
+MM_CacheMissCounter::stop(uint64_t *references, uint64_t *misses)
+{
+#if defined(LINUX)
+	if (-1 != _missesCounter) {
+		uint64_t referencesNow = readHardwareCounter(_referencesCounter);
+		uint64_t missesNow = readHardwareCounter(_missesCounter);
+		/* a failed read reports 0, which must not be taken as a huge delta */
+		if (referencesNow >= _referencesAtStart) {
+			*references += referencesNow - _referencesAtStart;
+		}
+		if (missesNow >= _missesAtStart) {
+			*misses += missesNow - _missesAtStart;
+		}
+	}
+#endif /* defined(LINUX) */
+}
+
+void
+MM_CacheMissCounter::tearDown()
+{
+#if defined(LINUX)
+	if (-1 != _missesCounter) {
+		close((int)_referencesCounter);
+		close((int)_missesCounter);
+		_referencesCounter = -1;
+		_missesCounter = -1;
+	}
+#endif /* defined(LINUX) */
+}
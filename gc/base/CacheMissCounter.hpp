@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base
+ */
+
+#if !defined(CACHEMISSCOUNTER_HPP_)
+#define CACHEMISSCOUNTER_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+
+/**
+ * Counts the last level cache references and misses of the owning thread using the
+ * processor's performance counters. Counting is only supported on Linux, and only when the
+ * operating system permits the process to open performance counters; otherwise start() fails
+ * and the caller should not report any counts.
+ *
+ * The counters are opened by the first start() and stay open, counting continuously, until
+ * tearDown(); each start()/stop() pair reports the difference between two reads. A counter must
+ * only be used by the thread which first started it.
+ * @ingroup GC_Base
+ */
+class MM_CacheMissCounter
+{
+	/*
+	 * Data members
+	 */
+private:
+	intptr_t _referencesCounter; /**< handle of the cache reference counter, or -1 if not open */
+	intptr_t _missesCounter; /**< handle of the cache miss counter, or -1 if not open */
+	bool _unavailable; /**< true once opening the counters has failed, so that it is not retried */
+	uint64_t _referencesAtStart; /**< cache references counted before the last start() */
+	uint64_t _missesAtStart; /**< cache misses counted before the last start() */
+
+	/*
+	 * Function members
+	 */
+private:
+	bool open();
+
+public:
+	/**
+	 * Start counting for the calling thread, opening the counters on first use.
+	 * @return true if the counters were started, false if they are unavailable
+	 */
+	bool start();
+
+	/**
+	 * Stop counting, adding the counts observed since start() to the given totals.
+	 * Must only be called by the thread which started the counters, after a successful start().
+	 * @param[in,out] references incremented by the number of cache references
+	 * @param[in,out] misses incremented by the number of cache misses
+	 */
+	void stop(uint64_t *references, uint64_t *misses);
+
+	/**
+	 * Close the counters, if they were opened.
+	 */
+	void tearDown();
+
+	MM_CacheMissCounter()
+		: _referencesCounter(-1)
+		, _missesCounter(-1)
+		, _unavailable(false)
+		, _referencesAtStart(0)
+		, _missesAtStart(0)
+	{
+	}
+};
+
+#endif /* CACHEMISSCOUNTER_HPP_ */
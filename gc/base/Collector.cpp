@@ -30,6 +30,9 @@
 #include "ModronAssertions.h"
 #include "ObjectAllocationInterface.hpp"
 #include "OMRVMThreadListIterator.hpp"
+#if defined(OMR_GC_SPARSE_HEAP_ALLOCATION)
+#include "SparseVirtualMemory.hpp"
+#endif /* defined(OMR_GC_SPARSE_HEAP_ALLOCATION) */
 
 class MM_MemorySubSpace;
 class MM_MemorySpace;
@@ -438,6 +441,13 @@ MM_Collector::postCollect(MM_EnvironmentBase* env, MM_MemorySubSpace* subSpace)
 
 	internalPostCollect(env, subSpace);
 
+#if defined(OMR_GC_SPARSE_HEAP_ALLOCATION)
+	if (NULL != extensions->largeObjectVirtualMemory) {
+		/* Sparse data freed by this collection is decommitted together now rather than held for a full batch */
+		extensions->largeObjectVirtualMemory->decommitFreedSparseRegions(env);
+	}
+#endif /* defined(OMR_GC_SPARSE_HEAP_ALLOCATION) */
+
 	extensions->bytesAllocatedMost = 0;
 	extensions->vmThreadAllocatedMost = NULL;
 
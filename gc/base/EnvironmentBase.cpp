@@ -47,6 +47,10 @@
 #include "SegregatedAllocationTracker.hpp"
 #endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 
+#if defined(OMR_GC_REALTIME)
+#include "WorkPacketsSATB.hpp"
+#endif /* defined(OMR_GC_REALTIME) */
+
 #include "EnvironmentBase.hpp"
 
 /* OMRTODO temporary workaround to allow both ut_j9mm.h and ut_omrmm.h to be included.
@@ -112,6 +116,13 @@ MM_EnvironmentBase::initialize(MM_GCExtensionsBase *extensions)
 	}
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_VLHGC) */
 
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	if (extensions->numaAwareNursery) {
+		/* TLH refreshes are served from the nursery slice of the node the thread is bound to */
+		cacheNumaAffinity();
+	}
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
+
 #if defined(OMR_GC_SEGREGATED_HEAP)
 	if (extensions->isSegregatedHeap()) {
 		_regionWorkList = MM_RegionPoolSegregated::allocateHeapRegionQueue(this, MM_HeapRegionList::HRL_KIND_LOCAL_WORK, true, false, false);
@@ -157,6 +168,15 @@ MM_EnvironmentBase::tearDown(MM_GCExtensionsBase *extensions)
 	}
 #endif /* OMR_GC_SEGREGATED_HEAP */
 
+	_cacheMissCounter.tearDown();
+
+#if defined(OMR_GC_REALTIME)
+	if (NULL != _satbBarrierPacketOwner) {
+		/* Publish the barrier packet this thread owned so that the values it recorded are still processed */
+		_satbBarrierPacketOwner->publishThreadOwnedPacket(this);
+	}
+#endif /* defined(OMR_GC_REALTIME) */
+
 	if(NULL != _objectAllocationInterface) {
 		_objectAllocationInterface->kill(this);
 		_objectAllocationInterface = NULL;
@@ -29,6 +29,7 @@
 #include "thread_api.h"
 
 #include "BaseVirtual.hpp"
+#include "CacheMissCounter.hpp"
 #include "CardCleaningStats.hpp"
 #include "CycleState.hpp"
 #include "CompactStats.hpp"
@@ -49,9 +50,11 @@ class MM_Collector;
 class MM_HeapRegionQueue;
 class MM_MemorySpace;
 class MM_ObjectAllocationInterface;
+class MM_Packet;
 class MM_SegregatedAllocationTracker;
 class MM_Task;
 class MM_Validator;
+class MM_WorkPacketsSATB;
 
 /* Allocation color values -- also used in bit in Metronome -- see Metronome.hpp */
 #define GC_UNMARK	0
@@ -66,7 +69,8 @@ typedef enum {
 	WRITE_BARRIER_THREAD,
 	CON_MARK_HELPER_THREAD,
 	GC_WORKER_THREAD,
-	GC_MAIN_THREAD
+	GC_MAIN_THREAD,
+	GC_SERVICE_THREAD /**< background thread which maintains the heap without scanning objects, such as the heap uncommit service */
 } ThreadType;
 
 /**
@@ -105,6 +109,8 @@ private:
 	bool _exclusiveAccessBeatenByOtherThread; /**< true if last exclusive access request had to wait for another GC thread */
 	uintptr_t _exclusiveCount; /**< count of number of times this thread has acquired but not yet released exclusive access */
 	OMR_VMThread* _cachedGCExclusiveAccessThreadId; /** only to be used when a thread requests a GC operation while already holding exclusive VM access */
+	uintptr_t _cachedNumaAffinity; /**< NUMA node of the thread when last sampled by cacheNumaAffinity() or refreshNumaAffinity(), where 1 is the first node (0 indicates none) */
+	bool _numaAffinityFromCurrentNode; /**< true if the thread is not bound to a node, so _cachedNumaAffinity is the node it was last seen running on */
 
 protected:
 	bool _allocationFailureReported;	/**< verbose: used to report af-start/af-end once per allocation failure even more then one GC cycle need to resolve AF */
@@ -155,6 +161,7 @@ public:
 	MM_Validator *_activeValidator; /**< Used to identify and report crashes inside Validators */
 
 	MM_MarkStats _markStats;
+	MM_CacheMissCounter _cacheMissCounter; /**< Cache miss counters of this thread, opened on first use by marking and closed at tearDown */
 
 	MM_RootScannerStats _rootScannerStats; /**< Per thread stats to track the performance of the root scanner */
 
@@ -163,6 +170,10 @@ public:
 #if defined(OMR_GC_SEGREGATED_HEAP)
 	MM_SegregatedAllocationTracker* _allocationTracker; /**< tracks bytes allocated per thread and periodically flushes allocation data to MM_MemoryPoolSegregated */
 #endif /* OMR_GC_SEGREGATED_HEAP */
+#if defined(OMR_GC_REALTIME)
+	MM_Packet *_satbBarrierPacket; /**< SATB barrier packet being filled privately by this thread (only used when sATBBarrierPacketsThreadOwned is set) */
+	MM_WorkPacketsSATB *_satbBarrierPacketOwner; /**< work packets the private SATB barrier packet must be published to when this thread detaches */
+#endif /* defined(OMR_GC_REALTIME) */
 
 	volatile uint32_t _allocationColor; /**< Flag field to indicate whether premarking is enabled on the thread */
 
@@ -347,6 +358,37 @@ public:
 	 * @return true on success, false on failure 
 	 */
 	MMINLINE bool setNumaAffinity(uintptr_t *numaNodes, uintptr_t arrayLength) { return 0 == omrthread_numa_set_node_affinity(_omrVMThread->_os_thread, numaNodes, arrayLength, 0); }
+
+	/**
+	 * Sample the NUMA node affinity of the thread so that allocation paths can consult it without a system call.
+	 * A thread which is not bound to a node (the usual case for mutators) is instead associated with the node
+	 * it is running on, which refreshNumaAffinity() updates as the thread migrates.
+	 * @see getNumaAffinity()
+	 */
+	MMINLINE void
+	cacheNumaAffinity()
+	{
+		_cachedNumaAffinity = (NULL == _omrVMThread) ? 0 : getNumaAffinity();
+		_numaAffinityFromCurrentNode = (NULL != _omrVMThread) && (0 == _cachedNumaAffinity);
+		refreshNumaAffinity();
+	}
+
+	/**
+	 * Update the node of a thread which is not bound to one to the node it is currently running on.
+	 * Threads bound to a node keep the node sampled by cacheNumaAffinity().
+	 */
+	MMINLINE void
+	refreshNumaAffinity()
+	{
+		if (_numaAffinityFromCurrentNode) {
+			_cachedNumaAffinity = omrthread_numa_get_current_node();
+		}
+	}
+
+	/**
+	 * @return the NUMA node recorded by the last call to cacheNumaAffinity() or refreshNumaAffinity(), where 1 is the first node (0 indicates none)
+	 */
+	MMINLINE uintptr_t getCachedNumaAffinity() const { return _cachedNumaAffinity; }
 		
 	/**
 	 * Get the threads worker id.
@@ -724,6 +766,8 @@ public:
 		,_exclusiveAccessBeatenByOtherThread(false)
 		,_exclusiveCount(0)
 		,_cachedGCExclusiveAccessThreadId(NULL)
+		,_cachedNumaAffinity(0)
+		,_numaAffinityFromCurrentNode(false)
 		,_allocationFailureReported(false)
 #if defined(OMR_GC_SEGREGATED_HEAP)
 		,_regionWorkList(NULL)
@@ -748,6 +792,10 @@ public:
 #if defined(OMR_GC_SEGREGATED_HEAP)
 		,_allocationTracker(NULL)
 #endif /* OMR_GC_SEGREGATED_HEAP */
+#if defined(OMR_GC_REALTIME)
+		,_satbBarrierPacket(NULL)
+		,_satbBarrierPacketOwner(NULL)
+#endif /* defined(OMR_GC_REALTIME) */
 #if defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_VLHGC)
 		,_hotFieldCopyDepthCount(0)
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_VLHGC) */
@@ -781,6 +829,8 @@ public:
 		,_exclusiveAccessBeatenByOtherThread(false)
 		,_exclusiveCount(0)
 		,_cachedGCExclusiveAccessThreadId(NULL)
+		,_cachedNumaAffinity(0)
+		,_numaAffinityFromCurrentNode(false)
 		,_allocationFailureReported(false)
 #if defined(OMR_GC_SEGREGATED_HEAP)
 		,_regionWorkList(NULL)
@@ -805,6 +855,10 @@ public:
 #if defined(OMR_GC_SEGREGATED_HEAP)
 		,_allocationTracker(NULL)
 #endif /* OMR_GC_SEGREGATED_HEAP */
+#if defined(OMR_GC_REALTIME)
+		,_satbBarrierPacket(NULL)
+		,_satbBarrierPacketOwner(NULL)
+#endif /* defined(OMR_GC_REALTIME) */
 #if defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_VLHGC)
 		,_hotFieldCopyDepthCount(0)
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_VLHGC) */
@@ -22,28 +22,173 @@
 
 #include "Forge.hpp"
 
+#include <string.h>
+
 #include "omrcomp.h"
+#include "ut_j9mm.h"
+#include "AtomicOperations.hpp"
 #include "EnvironmentBase.hpp"
 
+/**
+ * Bytes of blocks a thread cache keeps per size class before it returns half of them to the shared lists.
+ */
+#define FORGE_THREAD_CACHE_BYTES (16 * 1024)
+#define FORGE_LARGE_SIZE_CLASS FORGE_SLAB_SIZE_CLASS_COUNT
+
 namespace OMR {
 namespace GC {
 
+/**
+ * Arena chunk that slab blocks are carved from.  The header sits at the start of the chunk and the
+ * blocks follow it.
+ */
+struct ForgeArenaChunk {
+	ForgeArenaChunk *next;
+	ForgeArenaChunk *previous;
+	uintptr_t liveBlocks; /**< blocks carved from the chunk that are not on a shared free list */
+};
+
+/**
+ * Header preceding every block handed out by the forge.  It records what free needs to return
+ * the block and to keep the category accounting exact, and is padded so blocks keep the alignment
+ * of the port library.  The free list link of a slab block overlays the first word only, so the
+ * owning chunk survives while the block is free.
+ */
+typedef union ForgeBlockHeader {
+	struct {
+		uint16_t sizeClass;
+		uint16_t category;
+		uint32_t slabBytesRequested;
+		union {
+			uintptr_t bytesRequested; /**< size of a large allocation */
+			ForgeArenaChunk *chunk; /**< chunk a slab block was carved from */
+		} owner;
+	} block;
+	uint64_t alignment[2];
+} ForgeBlockHeader;
+
+#define FORGE_ARENA_CHUNK_HEADER_SIZE ((sizeof(ForgeArenaChunk) + sizeof(ForgeBlockHeader) - 1) & ~(sizeof(ForgeBlockHeader) - 1))
+
+/**
+ * Free slab blocks owned by one thread.  Only the owning thread touches the lists, so allocate and free
+ * take no lock until a list runs empty or grows past its limit.
+ */
+struct ForgeThreadCache {
+	Forge *forge;
+	ForgeThreadCache *next;
+	ForgeThreadCache *previous;
+	void *freeLists[FORGE_SLAB_SIZE_CLASS_COUNT];
+	uintptr_t counts[FORGE_SLAB_SIZE_CLASS_COUNT];
+	uintptr_t cachedAllocations;
+	uintptr_t cacheRefills;
+	uintptr_t cacheFlushes;
+};
+
+static MMINLINE uintptr_t
+blockSizeOfClass(uintptr_t sizeClass)
+{
+	return (uintptr_t)FORGE_SLAB_MINIMUM_BLOCK_SIZE << sizeClass;
+}
+
+static MMINLINE uintptr_t
+sizeClassOfBlock(uintptr_t blockSize)
+{
+	uintptr_t sizeClass = 0;
+	while ((sizeClass < FORGE_SLAB_SIZE_CLASS_COUNT) && (blockSizeOfClass(sizeClass) < blockSize)) {
+		sizeClass += 1;
+	}
+	return sizeClass;
+}
+
+static MMINLINE uintptr_t
+cacheLimitOfClass(uintptr_t sizeClass)
+{
+	uintptr_t limit = FORGE_THREAD_CACHE_BYTES / blockSizeOfClass(sizeClass);
+	return OMR_MAX(limit, 4);
+}
+
+static MMINLINE void *
+nextBlock(void *block)
+{
+	return *(void **)block;
+}
+
+static MMINLINE void
+setNextBlock(void *block, void *next)
+{
+	*(void **)block = next;
+}
+
+static MMINLINE ForgeArenaChunk *
+chunkOfBlock(void *block)
+{
+	return ((ForgeBlockHeader *)block)->block.owner.chunk;
+}
+
 bool
 Forge::initialize(OMRPortLibrary* port)
 {
 	_portLibrary = port;
+	/* the port library sets its categories up before the collector starts, so the lookup is made once */
+	_memoryCategory = port->mem_get_category(port, OMRMEM_CATEGORY_MM);
+	memset(_slabFreeLists, 0, sizeof(_slabFreeLists));
+	memset(_statistics, 0, sizeof(_statistics));
+	memset(&_arenaStatistics, 0, sizeof(_arenaStatistics));
+
+	if (0 != omrthread_monitor_init_with_name(&_slabLock, 0, "MM_Forge::slabLock")) {
+		_slabLock = NULL;
+		return false;
+	}
+
+	/* without a thread local slot every slab allocation takes the slab lock, which is slower but correct */
+	_cacheKeyAllocated = (0 == omrthread_tls_alloc_with_finalizer(&_cacheKey, threadCacheFinalizer));
+
 	return true;
 }
 
 void 
 Forge::tearDown()
 {
+	if (_cacheKeyAllocated) {
+		omrthread_tls_free(_cacheKey);
+		_cacheKeyAllocated = false;
+	}
+
+	if ((NULL != _portLibrary) && (NULL != _slabLock)) {
+		ForgeArenaStatistics stats;
+		getArenaStatistics(&stats);
+		Trc_MM_Forge_tearDown(stats.arenaBytes, stats.cachedAllocations, stats.cacheRefills, stats.cacheFlushes, stats.largeAllocations);
+
+		OMRPORT_ACCESS_FROM_OMRPORT(_portLibrary);
+		while (NULL != _threadCaches) {
+			ForgeThreadCache *cache = _threadCaches;
+			_threadCaches = cache->next;
+			omrmem_free_memory(cache);
+		}
+		while (NULL != _arenaChunks) {
+			ForgeArenaChunk *chunk = _arenaChunks;
+			_arenaChunks = chunk->next;
+			omrmem_categories_increment_counters(_memoryCategory, FORGE_ARENA_CHUNK_SIZE);
+			omrmem_free_memory(chunk);
+		}
+		_arenaAlloc = NULL;
+		_arenaTop = NULL;
+		memset(_slabFreeLists, 0, sizeof(_slabFreeLists));
+	}
+
+	if (NULL != _slabLock) {
+		omrthread_monitor_destroy(_slabLock);
+		_slabLock = NULL;
+	}
+
+	_memoryCategory = NULL;
 	_portLibrary = NULL;
 }
 
 /**
  * Allocates the amount of memory requested in bytesRequested.  Returns a pointer to the allocated memory, or NULL if the request could
- * not be performed.  This function is a wrapper of omrmem_allocate_memory.
+ * not be performed.  Requests that fit a slab block are served from the calling thread's cache, larger requests are passed to
+ * omrmem_allocate_memory.
  *
  * @param[in] byesRequested - the number of bytes to allocate
  * @param[in] category - the memory usage category for the allocated memory
@@ -53,12 +198,44 @@ Forge::tearDown()
 void* 
 Forge::allocate(std::size_t bytesRequested, OMR::GC::AllocationCategory::Enum category, const char* callsite)
 {
-	return _portLibrary->mem_allocate_memory(_portLibrary, bytesRequested, callsite, OMRMEM_CATEGORY_MM);
+	uintptr_t blockSize = bytesRequested + sizeof(ForgeBlockHeader);
+	if (blockSize < bytesRequested) {
+		return NULL;
+	}
+
+	ForgeBlockHeader *header = NULL;
+	uintptr_t sizeClass = sizeClassOfBlock(blockSize);
+	if (FORGE_LARGE_SIZE_CLASS > sizeClass) {
+		header = (ForgeBlockHeader *)allocateFromSlab(getThreadCache(), sizeClass);
+		if (NULL == header) {
+			return NULL;
+		}
+		/* the arena chunk is not charged to the category, the blocks in use out of it are */
+		_portLibrary->mem_categories_increment_counters(_memoryCategory, blockSize);
+		header->block.slabBytesRequested = (uint32_t)bytesRequested;
+	} else {
+		header = (ForgeBlockHeader *)_portLibrary->mem_allocate_memory(_portLibrary, blockSize, callsite, OMRMEM_CATEGORY_MM);
+		if (NULL == header) {
+			return NULL;
+		}
+		MM_AtomicOperations::add(&_arenaStatistics.largeAllocations, 1);
+		header->block.owner.bytesRequested = bytesRequested;
+	}
+
+	if ((uintptr_t)category >= AllocationCategory::CATEGORY_COUNT) {
+		category = AllocationCategory::OTHER;
+	}
+	header->block.sizeClass = (uint16_t)sizeClass;
+	header->block.category = (uint16_t)category;
+	recordAllocation(category, bytesRequested);
+
+	return (void *)(header + 1);
 }
 
 /**
  * Deallocate memory that has been allocated by the garbage collector.  This function should not be called to deallocate memory that has
- * not been allocated by either the allocate or reallocate functions.  This function is a wrapper of omrmem_free_memory.
+ * not been allocated by either the allocate or reallocate functions.  Slab blocks go back to the calling thread's cache, larger
+ * allocations are passed to omrmem_free_memory.
  *
  * @param[in] memoryPointer - a pointer to the memory that will be freed
  */
@@ -68,9 +245,332 @@ Forge::free(void* memoryPointer)
 	if (NULL == memoryPointer) {
 		return;
 	}
-	
+
+	ForgeBlockHeader *header = ((ForgeBlockHeader *)memoryPointer) - 1;
+	uintptr_t sizeClass = header->block.sizeClass;
+
+	if (FORGE_LARGE_SIZE_CLASS > sizeClass) {
+		uintptr_t bytesRequested = header->block.slabBytesRequested;
+		recordFree((AllocationCategory::Enum)header->block.category, bytesRequested);
+		_portLibrary->mem_categories_decrement_counters(_memoryCategory, bytesRequested + sizeof(ForgeBlockHeader));
+		freeToSlab(getThreadCache(), (void *)header, sizeClass);
+	} else {
+		recordFree((AllocationCategory::Enum)header->block.category, header->block.owner.bytesRequested);
+		OMRPORT_ACCESS_FROM_OMRPORT(_portLibrary);
+		omrmem_free_memory(header);
+	}
+}
+
+void
+Forge::getArenaStatistics(ForgeArenaStatistics *stats)
+{
+	omrthread_monitor_enter(_slabLock);
+	*stats = _arenaStatistics;
+	for (ForgeThreadCache *cache = _threadCaches; NULL != cache; cache = cache->next) {
+		stats->cachedAllocations += cache->cachedAllocations;
+		stats->cacheRefills += cache->cacheRefills;
+		stats->cacheFlushes += cache->cacheFlushes;
+	}
+	omrthread_monitor_exit(_slabLock);
+}
+
+ForgeThreadCache *
+Forge::getThreadCache()
+{
+	if (!_cacheKeyAllocated) {
+		return NULL;
+	}
+	omrthread_t self = omrthread_self();
+	if (NULL == self) {
+		return NULL;
+	}
+
+	ForgeThreadCache *cache = (ForgeThreadCache *)omrthread_tls_get(self, _cacheKey);
+	if (NULL == cache) {
+		cache = (ForgeThreadCache *)_portLibrary->mem_allocate_memory(_portLibrary, sizeof(ForgeThreadCache), OMR_GET_CALLSITE(), OMRMEM_CATEGORY_MM);
+		if (NULL != cache) {
+			memset(cache, 0, sizeof(ForgeThreadCache));
+			cache->forge = this;
+			omrthread_monitor_enter(_slabLock);
+			cache->next = _threadCaches;
+			if (NULL != _threadCaches) {
+				_threadCaches->previous = cache;
+			}
+			_threadCaches = cache;
+			omrthread_monitor_exit(_slabLock);
+			omrthread_tls_set(self, _cacheKey, cache);
+		}
+	}
+
+	return cache;
+}
+
+void *
+Forge::allocateFromSlab(ForgeThreadCache *cache, uintptr_t sizeClass)
+{
+	void *block = NULL;
+
+	if (NULL == cache) {
+		refillBlocks(sizeClass, &block, 1);
+	} else {
+		if (0 == cache->counts[sizeClass]) {
+			uintptr_t count = cacheLimitOfClass(sizeClass) / 2;
+			cache->counts[sizeClass] = refillBlocks(sizeClass, &cache->freeLists[sizeClass], count);
+			cache->cacheRefills += 1;
+		} else {
+			cache->cachedAllocations += 1;
+		}
+		block = cache->freeLists[sizeClass];
+		if (NULL != block) {
+			cache->freeLists[sizeClass] = nextBlock(block);
+			cache->counts[sizeClass] -= 1;
+		}
+	}
+
+	return block;
+}
+
+void
+Forge::freeToSlab(ForgeThreadCache *cache, void *block, uintptr_t sizeClass)
+{
+	if (NULL == cache) {
+		setNextBlock(block, NULL);
+		flushBlocks(sizeClass, block);
+		return;
+	}
+
+	setNextBlock(block, cache->freeLists[sizeClass]);
+	cache->freeLists[sizeClass] = block;
+	cache->counts[sizeClass] += 1;
+
+	uintptr_t limit = cacheLimitOfClass(sizeClass);
+	if (cache->counts[sizeClass] > limit) {
+		/* keep the most recently freed half, which is the most likely to still be in the data cache */
+		uintptr_t keep = limit / 2;
+		void *last = cache->freeLists[sizeClass];
+		for (uintptr_t i = 1; i < keep; i++) {
+			last = nextBlock(last);
+		}
+		void *surplus = nextBlock(last);
+		setNextBlock(last, NULL);
+		flushBlocks(sizeClass, surplus);
+		cache->counts[sizeClass] = keep;
+		cache->cacheFlushes += 1;
+	}
+}
+
+/**
+ * Move up to count blocks of a size class onto list, taking them from the shared free list first and
+ * carving the rest from the arena.
+ * @return the number of blocks moved, less than count only if the arena could not grow
+ */
+uintptr_t
+Forge::refillBlocks(uintptr_t sizeClass, void **list, uintptr_t count)
+{
+	uintptr_t blockSize = blockSizeOfClass(sizeClass);
+	uintptr_t found = 0;
+
+	omrthread_monitor_enter(_slabLock);
+	while ((found < count) && (NULL != _slabFreeLists[sizeClass])) {
+		void *block = _slabFreeLists[sizeClass];
+		_slabFreeLists[sizeClass] = nextBlock(block);
+		chunkOfBlock(block)->liveBlocks += 1;
+		setNextBlock(block, *list);
+		*list = block;
+		found += 1;
+	}
+	while (found < count) {
+		/* the tail of the current chunk is left unused when it is smaller than the block being carved */
+		if (((uintptr_t)(_arenaTop - _arenaAlloc) < blockSize) && !allocateArenaChunk()) {
+			break;
+		}
+		ForgeBlockHeader *block = (ForgeBlockHeader *)_arenaAlloc;
+		_arenaAlloc += blockSize;
+		block->block.owner.chunk = _arenaChunks;
+		_arenaChunks->liveBlocks += 1;
+		setNextBlock(block, *list);
+		*list = block;
+		found += 1;
+	}
+	omrthread_monitor_exit(_slabLock);
+
+	return found;
+}
+
+/**
+ * Return a list of blocks of a size class to the shared list, and release the arena chunks, other
+ * than the current one, that no longer have a block outside the shared lists.
+ */
+void
+Forge::flushBlocks(uintptr_t sizeClass, void *list)
+{
+	bool emptiedChunk = false;
+
+	omrthread_monitor_enter(_slabLock);
+	void *last = list;
+	while (true) {
+		ForgeArenaChunk *chunk = chunkOfBlock(last);
+		chunk->liveBlocks -= 1;
+		emptiedChunk = emptiedChunk || (0 == chunk->liveBlocks);
+		if (NULL == nextBlock(last)) {
+			break;
+		}
+		last = nextBlock(last);
+	}
+	setNextBlock(last, _slabFreeLists[sizeClass]);
+	_slabFreeLists[sizeClass] = list;
+
+	if (emptiedChunk) {
+		ForgeArenaChunk *chunk = _arenaChunks->next;
+		while (NULL != chunk) {
+			ForgeArenaChunk *next = chunk->next;
+			if (0 == chunk->liveBlocks) {
+				releaseArenaChunk(chunk);
+			}
+			chunk = next;
+		}
+	}
+	omrthread_monitor_exit(_slabLock);
+}
+
+/**
+ * Make a new arena chunk current, releasing the previous one if none of its blocks are in use.  The
+ * chunk is moved out of the port library category, which is charged for its blocks as they are
+ * allocated instead.  The slab lock must be held.
+ * @return true if the chunk was allocated
+ */
+bool
+Forge::allocateArenaChunk()
+{
+	ForgeArenaChunk *chunk = (ForgeArenaChunk *)_portLibrary->mem_allocate_memory(_portLibrary, FORGE_ARENA_CHUNK_SIZE, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_MM);
+	if (NULL == chunk) {
+		return false;
+	}
+	_portLibrary->mem_categories_decrement_counters(_memoryCategory, FORGE_ARENA_CHUNK_SIZE);
+
+	ForgeArenaChunk *previous = _arenaChunks;
+	chunk->next = previous;
+	chunk->previous = NULL;
+	chunk->liveBlocks = 0;
+	if (NULL != previous) {
+		previous->previous = chunk;
+	}
+	_arenaChunks = chunk;
+	_arenaAlloc = (uint8_t *)chunk + FORGE_ARENA_CHUNK_HEADER_SIZE;
+	_arenaTop = (uint8_t *)chunk + FORGE_ARENA_CHUNK_SIZE;
+	_arenaStatistics.arenaBytes += FORGE_ARENA_CHUNK_SIZE;
+
+	if ((NULL != previous) && (0 == previous->liveBlocks)) {
+		releaseArenaChunk(previous);
+	}
+
+	return true;
+}
+
+/**
+ * Unlink the blocks of an arena chunk from the shared lists and return the chunk to the port library.
+ * Every block carved from the chunk must be on a shared list, and the slab lock must be held.
+ */
+void
+Forge::releaseArenaChunk(ForgeArenaChunk *chunk)
+{
+	uint8_t *base = (uint8_t *)chunk;
+	uint8_t *top = base + FORGE_ARENA_CHUNK_SIZE;
+	for (uintptr_t sizeClass = 0; sizeClass < FORGE_SLAB_SIZE_CLASS_COUNT; sizeClass++) {
+		void **link = &_slabFreeLists[sizeClass];
+		while (NULL != *link) {
+			uint8_t *block = (uint8_t *)*link;
+			if ((base <= block) && (block < top)) {
+				*link = nextBlock(block);
+			} else {
+				link = (void **)block;
+			}
+		}
+	}
+
+	if (NULL != chunk->previous) {
+		chunk->previous->next = chunk->next;
+	} else {
+		_arenaChunks = chunk->next;
+	}
+	if (NULL != chunk->next) {
+		chunk->next->previous = chunk->previous;
+	}
+	_arenaStatistics.arenaBytes -= FORGE_ARENA_CHUNK_SIZE;
+	_arenaStatistics.arenaReleases += 1;
+
 	OMRPORT_ACCESS_FROM_OMRPORT(_portLibrary);
-	omrmem_free_memory(memoryPointer);
+	omrmem_categories_increment_counters(_memoryCategory, FORGE_ARENA_CHUNK_SIZE);
+	omrmem_free_memory(chunk);
+}
+
+/**
+ * Return every block of a thread cache to the shared lists.  A retired cache is also unlinked and its
+ * counts folded into the forge totals, so that it can be freed.
+ */
+void
+Forge::flushThreadCache(ForgeThreadCache *cache, bool retire)
+{
+	for (uintptr_t sizeClass = 0; sizeClass < FORGE_SLAB_SIZE_CLASS_COUNT; sizeClass++) {
+		if (NULL != cache->freeLists[sizeClass]) {
+			flushBlocks(sizeClass, cache->freeLists[sizeClass]);
+			cache->freeLists[sizeClass] = NULL;
+			cache->counts[sizeClass] = 0;
+		}
+	}
+
+	if (retire) {
+		omrthread_monitor_enter(_slabLock);
+		_arenaStatistics.cachedAllocations += cache->cachedAllocations;
+		_arenaStatistics.cacheRefills += cache->cacheRefills;
+		_arenaStatistics.cacheFlushes += cache->cacheFlushes;
+		if (NULL != cache->previous) {
+			cache->previous->next = cache->next;
+		} else {
+			_threadCaches = cache->next;
+		}
+		if (NULL != cache->next) {
+			cache->next->previous = cache->previous;
+		}
+		omrthread_monitor_exit(_slabLock);
+	}
+}
+
+void
+Forge::threadCacheFinalizer(void *cache)
+{
+	ForgeThreadCache *threadCache = (ForgeThreadCache *)cache;
+	Forge *forge = threadCache->forge;
+
+	forge->flushThreadCache(threadCache, true);
+	OMRPORT_ACCESS_FROM_OMRPORT(forge->_portLibrary);
+	omrmem_free_memory(threadCache);
+}
+
+void
+Forge::recordAllocation(AllocationCategory::Enum category, uintptr_t bytes)
+{
+	ForgeCategoryStatistics *stats = &_statistics[category];
+	uintptr_t liveBytes = MM_AtomicOperations::add(&stats->liveBytes, bytes);
+	MM_AtomicOperations::add(&stats->liveAllocations, 1);
+	MM_AtomicOperations::add(&stats->totalAllocations, 1);
+
+	uintptr_t peakBytes = stats->peakBytes;
+	while (liveBytes > peakBytes) {
+		uintptr_t oldPeakBytes = MM_AtomicOperations::lockCompareExchange(&stats->peakBytes, peakBytes, liveBytes);
+		if (oldPeakBytes == peakBytes) {
+			break;
+		}
+		peakBytes = oldPeakBytes;
+	}
+}
+
+void
+Forge::recordFree(AllocationCategory::Enum category, uintptr_t bytes)
+{
+	ForgeCategoryStatistics *stats = &_statistics[category];
+	MM_AtomicOperations::subtract(&stats->liveBytes, bytes);
+	MM_AtomicOperations::subtract(&stats->liveAllocations, 1);
 }
 
 } // namespace GC
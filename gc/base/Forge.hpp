@@ -35,16 +35,86 @@
 class MM_EnvironmentBase;
 class MM_GCExtensionsBase;
 
+/**
+ * Number of slab size classes served from the forge arena.  Class i holds blocks of
+ * FORGE_SLAB_MINIMUM_BLOCK_SIZE << i bytes, including the block header.
+ */
+#define FORGE_SLAB_SIZE_CLASS_COUNT 8
+#define FORGE_SLAB_MINIMUM_BLOCK_SIZE 32
+#define FORGE_SLAB_MAXIMUM_BLOCK_SIZE (FORGE_SLAB_MINIMUM_BLOCK_SIZE << (FORGE_SLAB_SIZE_CLASS_COUNT - 1))
+/**
+ * Size of the arena chunks that slab blocks are carved from.
+ */
+#define FORGE_ARENA_CHUNK_SIZE (64 * 1024)
+
 namespace OMR {
 namespace GC {
 
+/**
+ * Live and cumulative allocation counts of one allocation category.
+ */
+struct ForgeCategoryStatistics {
+	volatile uintptr_t liveBytes; /**< bytes requested by allocations not yet freed */
+	volatile uintptr_t liveAllocations; /**< number of allocations not yet freed */
+	volatile uintptr_t peakBytes; /**< highest value liveBytes has reached */
+	volatile uintptr_t totalAllocations; /**< number of allocations made since initialization */
+};
+
+/**
+ * Arena and cache counts of the forge as a whole.
+ */
+struct ForgeArenaStatistics {
+	uintptr_t arenaBytes; /**< bytes of arena chunks currently allocated from the port library */
+	uintptr_t arenaReleases; /**< arena chunks returned to the port library once every block carved from them was free */
+	uintptr_t cachedAllocations; /**< slab allocations served from a thread cache without locking */
+	uintptr_t cacheRefills; /**< times a thread cache was refilled from the shared slab lists */
+	uintptr_t cacheFlushes; /**< times a thread cache returned blocks to the shared slab lists */
+	volatile uintptr_t largeAllocations; /**< allocations too large for a slab, made directly through the port library */
+};
+
+struct ForgeThreadCache;
+struct ForgeArenaChunk;
+
+/**
+ * Allocator behind all native memory of the collector.  Small requests are carved from a single arena
+ * of chunks whose shared free lists are guarded by a single monitor; a per-thread cache of free blocks
+ * keeps most allocations and frees off that monitor, and only cache refills and flushes take it.  This
+ * is not a lock-free or multi-arena design, threads that miss their caches together serialize on the one
+ * monitor.  Slab blocks are charged to OMRMEM_CATEGORY_MM as they are allocated and freed rather than as
+ * whole arena chunks, and a chunk is returned to the port library once all of its blocks are on the shared
+ * free lists.
+ */
 class Forge {
 
 /* Data Members */
 private:
 	OMRPortLibrary* _portLibrary;
-	
+	OMRMemCategory *_memoryCategory; /**< port library category slab blocks are charged to */
+	omrthread_monitor_t _slabLock; /**< protects the shared slab lists, the arena and the thread cache list */
+	omrthread_tls_key_t _cacheKey; /**< thread local slot holding the calling thread's ForgeThreadCache */
+	bool _cacheKeyAllocated;
+	void *_slabFreeLists[FORGE_SLAB_SIZE_CLASS_COUNT]; /**< shared free blocks of each size class */
+	ForgeArenaChunk *_arenaChunks; /**< list of arena chunks, the current chunk first */
+	uint8_t *_arenaAlloc; /**< next unused byte of the current arena chunk */
+	uint8_t *_arenaTop; /**< end of the current arena chunk */
+	ForgeThreadCache *_threadCaches; /**< list of live thread caches */
+	ForgeCategoryStatistics _statistics[AllocationCategory::CATEGORY_COUNT];
+	ForgeArenaStatistics _arenaStatistics; /**< slow path counts, and the counts of retired thread caches */
+
 /* Function Members */
+private:
+	ForgeThreadCache *getThreadCache();
+	void *allocateFromSlab(ForgeThreadCache *cache, uintptr_t sizeClass);
+	void freeToSlab(ForgeThreadCache *cache, void *block, uintptr_t sizeClass);
+	uintptr_t refillBlocks(uintptr_t sizeClass, void **list, uintptr_t count);
+	void flushBlocks(uintptr_t sizeClass, void *list);
+	bool allocateArenaChunk();
+	void releaseArenaChunk(ForgeArenaChunk *chunk);
+	void flushThreadCache(ForgeThreadCache *cache, bool retire);
+	void recordAllocation(AllocationCategory::Enum category, uintptr_t bytes);
+	void recordFree(AllocationCategory::Enum category, uintptr_t bytes);
+	static void threadCacheFinalizer(void *cache);
+
 public:
 	/**
 	 * Initialize internal structures of the memory forge.  An instance of Forge must be initialized before
@@ -65,7 +135,9 @@ public:
 
 	/**
 	 * Allocates the amount of memory requested in bytesRequested.  Returns a pointer to the allocated memory, 
-	 * or NULL if the request could not be performed.  This function is a wrapper of omrmem_allocate_memory.
+	 * or NULL if the request could not be performed.  Small requests are served from size class slabs carved
+	 * out of arena chunks, through a per-thread cache that needs no locking; larger requests are passed to
+	 * omrmem_allocate_memory.  Every allocation is charged to category.
 	 *
 	 * @param[in] byesRequested - the number of bytes to allocate
 	 * @param[in] category - the memory usage category for the allocated memory
@@ -77,12 +149,41 @@ public:
 
 	/**
 	 * Deallocate memory that has been allocated by the garbage collector.  This function should not be called
-	 * to deallocate memory that has not been allocated by either the allocate or reallocate functions.  This 
-	 * function is a wrapper of omrmem_free_memory.
+	 * to deallocate memory that has not been allocated by either the allocate or reallocate functions.  Slab
+	 * blocks are returned to the calling thread's cache, larger allocations are passed to omrmem_free_memory.
 	 *
 	 * @param[in] memoryPointer - a pointer to the memory that will be freed
 	 */
 	void free(void* memoryPointer);
+
+	/**
+	 * Fetch the allocation counts of a category.  Live counts are exact at any point where no allocate
+	 * or free is in progress.
+	 *
+	 * @param[in] category - the memory usage category
+	 * @return the statistics of the category
+	 */
+	const ForgeCategoryStatistics *getCategoryStatistics(AllocationCategory::Enum category) { return &_statistics[category]; }
+
+	/**
+	 * Sum the arena and cache counts of the forge, including the caches of live threads.
+	 *
+	 * @param[out] stats - the structure to fill in
+	 */
+	void getArenaStatistics(ForgeArenaStatistics *stats);
+
+	Forge()
+		: _portLibrary(NULL)
+		, _memoryCategory(NULL)
+		, _slabLock(NULL)
+		, _cacheKey(0)
+		, _cacheKeyAllocated(false)
+		, _arenaChunks(NULL)
+		, _arenaAlloc(NULL)
+		, _arenaTop(NULL)
+		, _threadCaches(NULL)
+	{
+	}
 };
 
 } // namespace GC
@@ -148,6 +148,13 @@ MM_GCExtensionsBase::initialize(MM_EnvironmentBase* env)
 	requestedPageSize = SIXTY_FOUR_KB; /* Use 64K pages for AIX-32 and AIX-64 */
 #elif ((defined(LINUX) || defined(OSX)) && (defined(J9X86) || defined(J9HAMMER)))
 	requestedPageSize = TWO_MB; /* Use 2M pages for Linux/OSX x86-64 */
+#if defined(LINUX)
+	/* Sparse heap data is large and long lived: back it with 2M pages, or with transparent huge pages when 2M pages
+	 * are not available and THP is enabled for advised memory (see MM_SparseVirtualMemory::initialize)
+	 */
+	sparseHeapPageSize = TWO_MB;
+	sparseHeapAllocationGranule = TWO_MB;
+#endif /* defined(LINUX) */
 #elif (defined(LINUX) && defined(S390))
 	requestedPageSize = ONE_MB; /* Use 1M pages for zLinux-31 and zLinux-64 */
 #elif defined(J9ZOS390)
@@ -76,6 +76,7 @@ class MM_RememberedSetSATB;
 #endif /* defined(OMR_GC_REALTIME) */
 class MM_Scavenger;
 class MM_SizeClasses;
+class MM_SizeClassTuner;
 class MM_SparseVirtualMemory;
 class MM_SweepHeapSectioning;
 class MM_SweepPoolManager;
@@ -289,6 +290,8 @@ public:
 	uintptr_t gcmetadataPageFlags;	/**< Memory page flags for GC Meta data */
 	uintptr_t sparseHeapPageSize;	/**< Memory page size for Sparse Object Heap */
 	uintptr_t sparseHeapPageFlags;	/**< Memory page flags for Sparse Object Heap */
+	uintptr_t sparseHeapAllocationGranule;	/**< Sparse Object Heap data of at least this size is allocated in multiples of it (0 for the page size). A huge page size lets transparent huge pages back the data when sparseHeapPageSize is the default page size and THP is enabled for advised memory */
+	uintptr_t sparseHeapDecommitBatchSize;	/**< Bytes of freed Sparse Object Heap data collected before they are decommitted together (0 to decommit each region as it is freed) */
 
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	MM_SublistPool rememberedSet;
@@ -299,6 +302,7 @@ public:
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 #if defined(OMR_GC_REALTIME)
 	MM_RememberedSetSATB* sATBBarrierRememberedSet; /**< The snapshot at the beginning barrier remembered set used for the write barrier */
+	bool sATBBarrierPacketsThreadOwned; /**< if true, the SATB barrier packet being filled is held by the filling thread rather than on the locked in use list, and published once full */
 #endif /* defined(OMR_GC_REALTIME) */
 	ModronLnrlOptions lnrlOptions;
 
@@ -332,6 +336,7 @@ public:
 	uint32_t largeObjectAllocationProfilingTopK; /**< number of most allocation size we want to track/report in large object allocation profiling */
 	MM_FreeEntrySizeClassStats freeEntrySizeClassStatsSimulated; /**< snapshot of free memory status used for simulated allocator for fragmentation estimation */
 	uintptr_t freeMemoryProfileMaxSizeClasses; /**< maximum number of sizeClass maintained for heap free memory profile (computed from SizeClassRatio) */
+	bool freeListSizeClassIndex; /**< if true, address ordered memory pools index their free entries by size class so allocations do not walk the free list */
 
 	volatile OMR_VMThread* gcExclusiveAccessThreadId; /**< thread token that represents the current "winning" thread for performing garbage collection */
 	omrthread_monitor_t gcExclusiveAccessMutex; /**< Mutex used for acquiring gc priviledges as well as for signalling waiting threads that GC has been completed */
@@ -375,6 +380,8 @@ public:
 	double largeObjectAreaInitialRatio;
 	double largeObjectAreaMinimumRatio;
 	double largeObjectAreaMaximumRatio;
+	bool largeObjectAreaBestFit; /**< if true, LOA allocations take the smallest free entry that fits, found in a size ordered AVL tree of the LOA free entries */
+	double largeObjectAreaFragmentationThreshold; /**< fraction of free memory estimated unusable by large allocations (see MM_LargeObjectAllocateStats::estimateFragmentation) above which the LOA is expanded on a failed large allocation and never contracted as underutilized */
 	bool debugLOAFreelist;
 	bool debugLOAAllocate;
 	int loaFreeHistorySize; /**< max size of _loaFreeRatioHistory array */
@@ -412,8 +419,11 @@ public:
 	uintptr_t workpacketCount; /**< this value is ONLY set if -Xgcworkpackets is specified - otherwise the workpacket count is determined heuristically */
 	uintptr_t packetListSplit; /**< the number of ways to split packet lists, set by command line option, or determined heuristically based on the number of GC threads */
 	bool packetListSplitForced;  /**< Flag to distinguish if packetListSplit is externally enforced (for example, specified by command line) */
+	bool packetListLockFree; /**< if true, work packet sublists are maintained as lock-free tagged stacks rather than lock protected doubly linked lists */
 	uintptr_t markingArraySplitMaximumAmount; /**< maximum number of elements to split array scanning work in marking scheme */
 	uintptr_t markingArraySplitMinimumAmount; /**< minimum number of elements to split array scanning work in marking scheme */
+	uintptr_t markingPrefetchDistance; /**< number of objects popped from the work stack and prefetched ahead of being scanned in marking scheme (0 disables prefetching) */
+	bool markingCacheMissStats; /**< if true, last level cache references and misses are counted while marking, where performance counters are available */
 
 	bool rootScannerStatsEnabled; /**< Enable/disable recording of performance statistics for the root scanner.  Defaults to false. */
 	bool rootScannerStatsUsed; /**< Flag that indicates if rootScannerStats are used for in the last increment (by any thread, for any of its roots) */
@@ -469,6 +479,8 @@ public:
 	bool gcThreadCountSpecified; /**< true if number of GC threads is specified in command line options. */
 	bool gcThreadCountForced; /**< true if user forced a fixed number of GC threads. Default is false, but a command line option could set it if not wanting adaptive threading */
 	uintptr_t dispatcherHybridNotifyThreadBound; /**< Bound for determining hybrid notification type (Individual notifies for count < MIN(bound, maxThreads/2), otherwise notify_all) */
+	bool adaptiveTaskThreading; /**< if true, the dispatcher learns a scaling curve for each task from its measured wall times and dispatches it with the thread count minimizing its pause within the CPUs left idle by other processes. Tasks given a recommended thread count by their collector (STW scavenges under adaptive threading) keep that count */
+	float adaptiveTaskThreadingTolerance; /**< fraction by which the predicted pause of the chosen thread count may exceed the predicted minimum, so flat scaling curves use fewer threads */
 
 #if defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_VLHGC)
 	enum ScavengerScanOrdering {
@@ -507,6 +519,12 @@ public:
 	bool scavengerRsoScanUnsafe;
 	uintptr_t cacheListSplit; /**< the number of ways to split scanCache lists, set by command line option, or determined heuristically based on the number of GC threads */
 	bool cacheListSplitForced;/**< Flag to distinguish if cacheList is externally enforced (for example, specified by command line) */
+	bool scavengerWorkStealing; /**< if true, GC threads distribute scan caches through per-thread work-stealing deques rather than the shared scan lists */
+	uintptr_t scavengerWorkStealingDequeSize; /**< capacity of each per-thread scan cache deque (rounded up to a power of 2); caches that do not fit go to the shared scan lists */
+	bool scavengerLearnHotFields; /**< if true, hot fields are learned from mutator dereferences sampled through OMR_GC_SampleHotFieldDereference() and depth copied by dynamicBreadthFirstScanOrdering when the object model declares none */
+	uintptr_t scavengerHotFieldSampleInterval; /**< number of dereferences a mutator thread reports without recording between two samples taken for the learned hot field table */
+	uintptr_t scavengerHotFieldTableSize; /**< number of classes the learned hot field table can track (rounded up to a power of 2) */
+	bool scavengerConcurrentRememberedSetPrune; /**< if true, remembered set entries released by a scavenge are pruned by a background helper thread between scavenges rather than inside the pause. Generational write barriers must then fence between the slot store and the remembered state check (see standardWriteBarrier()) */
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 	bool softwareRangeCheckReadBarrier; /**< enable software read barrier instead of hardware guarded loads when running with CS, complimentary to concurrentScavengerHWSupport with CS active */
 	bool softwareRangeCheckReadBarrierForced; /**< true if usage of softwareRangeCheckReadBarrier is requested explicitly */
@@ -535,9 +553,11 @@ public:
 	bool dynamicNewSpaceSizing;
 	bool debugDynamicNewSpaceSizing;
 	bool dnssAvoidMovingObjects;
+	bool numaAwareNursery; /**< if true, nursery semi spaces are split into one slice per NUMA affinity leader and TLHs are refreshed from the slice local to the allocating thread */
 
 	MM_UserSpecifiedParameterDouble dnssExpectedRatioMinimum; /**< When the gc ratio for new/nursery space is below this value, new/nursery space should contract */
 	MM_UserSpecifiedParameterDouble dnssExpectedRatioMaximum; /**< When the gc ratio for new/nursery space is above this value, new/nursery space should expand */
+	uintptr_t scavengerPauseTarget; /**< target scavenge pause in milliseconds, sizing and tilting the nursery from an online model of survival, allocation and pause time (0 keeps dynamic new space sizing and tilting) */
 
 	double dnssWeightedTimeRatioFactorIncreaseSmall;
 	double dnssWeightedTimeRatioFactorIncreaseMedium;
@@ -591,6 +611,7 @@ public:
 	uintptr_t compactOnSystemGC;
 	uintptr_t nocompactOnSystemGC;
 	bool compactToSatisfyAllocate;
+	uintptr_t compactIncrementSubAreas; /**< if non-zero, each compaction evacuates at most this many contiguous sub areas, chosen as the window holding the most free memory, and only fixes up references elsewhere */
 #endif /* defined(OMR_GC_MODRON_COMPACTION) */
 
 	bool payAllocationTax;
@@ -606,6 +627,9 @@ public:
 	uintptr_t concurrentSlack; /**< number of bytes to add to the concurrent kickoff threshold buffer */
 	uintptr_t cardCleanPass2Boost;
 	uintptr_t cardCleaningPasses;
+	uintptr_t cardCleaningBatchSize; /**< maximum number of contiguous dirty cards a thread claims at once during final card cleaning (1, the default, claims cards one at a time) */
+	uintptr_t concurrentFinalPauseTarget; /**< target duration in milliseconds of the collection ending a concurrent mark cycle, steering kickoff and allocation tax (0 keeps the fixed tuning) */
+	float concurrentAllocationTaxLimit; /**< maximum factor by which the pause target controller may raise the allocation to trace rate */
 
 	UDATA fvtest_concurrentCardTablePreparationDelay; /**< Delay for concurrent card table preparation in milliseconds */
 
@@ -688,6 +712,11 @@ public:
 
 #if defined(OMR_GC_SEGREGATED_HEAP)
 	MM_SizeClasses* defaultSizeClasses;
+	MM_SizeClassTuner* sizeClassTuner; /**< Builds the small allocation size histogram when sizeClassTuning is enabled (NULL otherwise) */
+	bool sizeClassTuning; /**< if true, small allocation sizes are counted and a size class table minimizing internal fragmentation is computed after sizeClassTuningWarmupCycles global GCs */
+	uintptr_t sizeClassTuningWarmupCycles; /**< number of global GCs whose allocations make up the histogram the tuned size class table is computed from */
+	const char* sizeClassTableFile; /**< if set, size classes are loaded from this file at startup and a tuned table that wastes less than the current one is saved to it */
+	bool segregatedLazySweep; /**< if true, small regions are not swept in the collection pause but on demand by the first allocation that needs them */
 #endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 
 #if defined(OMR_GC_VLHGC_CONCURRENT_COPY_FORWARD)
@@ -724,6 +753,9 @@ public:
 	bool verboseExtensions;
 	bool verboseNewFormat; /**< a flag, enabled by -XXgc:verboseNewFormat, to enable the new verbose GC format */
 	bool bufferedLogging; /**< Enabled by -Xgc:bufferedLogging.  Use buffered filestreams when writing logs (e.g. verbose:gc) to a file */
+	bool asyncVerboseLogging; /**< Enabled by -Xgc:asyncLogging. Verbose output is queued in a ring buffer and written to file by a background thread, dropping events when the ring is full */
+	uintptr_t asyncVerboseLoggingBufferSize; /**< Size in bytes of the ring buffer used by asyncVerboseLogging (rounded up to a power of two of at least 64KB) */
+	bool binaryVerboseLogging; /**< Enabled by -Xgc:binaryLogging. Verbose output written to file is encoded in the compact binary format of VerboseBinaryFormat.hpp instead of XML */
 
 	uintptr_t lowAllocationThreshold; /**< the lower bound of the allocation threshold range */
 	uintptr_t highAllocationThreshold; /**< the upper bound of the allocation threshold range */
@@ -866,6 +898,15 @@ public:
 	bool pretouchHeapOnExpand; /**< True to pretouch memory during initial heap inflation or heap expansion */
 
 	uintptr_t decommitMinimumFree; /**< percentage of free heap to be retained as committed, default=0 for gencon, complete tenture free memory will be decommitted */
+	bool heapUncommit; /**< Enables the background service which releases free tenure pages to the OS after global GCs, default is false */
+	uintptr_t heapUncommitDelay; /**< Time in milliseconds without a global GC before the heap uncommit service releases pages, 0 to release right after each global GC */
+	uintptr_t heapUncommitMinimumFreeEntrySize; /**< Smallest free entry whose pages the heap uncommit service releases, never below the heap page size */
+	uintptr_t heapUncommitBatchSize; /**< Bytes the heap uncommit service releases while holding a free list lock before it checks for exclusive access requests */
+	uintptr_t heapUncommitBatchEntryCount; /**< Free entries the heap uncommit service visits while holding a free list lock before it checks for exclusive access requests */
+	uintptr_t parallelMemsetMinimumSize; /**< Smallest side metadata clear, in bytes, that is split across the dispatcher threads (0 to always clear on the calling thread) */
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	bool markMapEpochClearing; /**< Clear the mark map by advancing an epoch tagged on each chunk of it, zeroing a chunk the first time it is touched in the new epoch, default is false */
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 
 #if defined(OMR_GC_IDLE_HEAP_MANAGER)
 	bool gcOnIdle; /**< Enables releasing free heap pages if true while systemGarbageCollect invoked with IDLE GC code, default is false */
@@ -1198,6 +1239,20 @@ public:
 		return _concurrentGlobalGCInProgress;
 	}
 
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
+
+	/**
+	 * Determine whether thread counts are chosen from learned task scaling curves.
+	 * As with adaptive threading, the option is ignored if the GC thread count is forced.
+	 * @return TRUE if the dispatcher should consult its scaling model, FALSE otherwise
+	 */
+	MMINLINE bool
+	adaptiveTaskThreadingEnabled()
+	{
+		return (adaptiveTaskThreading && !gcThreadCountForced);
+	}
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
 	/**
 	 * Determine whether Adaptive Threading is enabled. AdaptiveGCThreading flag
 	 * is not sufficient; Adaptive threading must be ignored if GC thread count is forced.
@@ -1525,6 +1580,8 @@ public:
 		, gcmetadataPageFlags(OMRPORT_VMEM_PAGE_FLAG_NOT_USED)
 		, sparseHeapPageSize(0)
 		, sparseHeapPageFlags(OMRPORT_VMEM_PAGE_FLAG_NOT_USED)
+		, sparseHeapAllocationGranule(0)
+		, sparseHeapDecommitBatchSize(32 * 1024 * 1024)
 #if defined(OMR_GC_MODRON_SCAVENGER)
 		, rememberedSet()
 		, oldHeapSizeOnLastGlobalGC(UDATA_MAX)
@@ -1534,6 +1591,7 @@ public:
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 #if defined(OMR_GC_REALTIME)
 		, sATBBarrierRememberedSet(NULL)
+		, sATBBarrierPacketsThreadOwned(false)
 #endif /* defined(OMR_GC_REALTIME) */
 		, heapBaseForBarrierRange0(NULL)
 		, heapSizeForBarrierRange0(0)
@@ -1557,6 +1615,7 @@ public:
 		, largeObjectAllocationProfilingSizeClassRatio(120)
 		, largeObjectAllocationProfilingTopK(8)
 		, freeMemoryProfileMaxSizeClasses(0)
+		, freeListSizeClassIndex(false)
 		, gcExclusiveAccessThreadId(NULL)
 		, gcExclusiveAccessMutex(NULL)
 		, _lightweightNonReentrantLockPool(NULL)
@@ -1586,6 +1645,8 @@ public:
 		, largeObjectAreaInitialRatio(0.050) /* initial LOA 5% */
 		, largeObjectAreaMinimumRatio(0.01) /* initial LOA 1% */
 		, largeObjectAreaMaximumRatio(0.500) /* maximum LOA 50% */
+		, largeObjectAreaBestFit(false)
+		, largeObjectAreaFragmentationThreshold(0.25)
 		, debugLOAFreelist(false)
 		, debugLOAAllocate(false)
 		, loaFreeHistorySize(15)
@@ -1616,8 +1677,11 @@ public:
 		, workpacketCount(0) /* only set if -Xgcworkpackets specified */
 		, packetListSplit(0)
 		, packetListSplitForced(false)
+		, packetListLockFree(false)
 		, markingArraySplitMaximumAmount(DEFAULT_ARRAY_SPLIT_MAXIMUM_SIZE)
 		, markingArraySplitMinimumAmount(DEFAULT_ARRAY_SPLIT_MINIMUM_SIZE)
+		, markingPrefetchDistance(0)
+		, markingCacheMissStats(false)
 		, rootScannerStatsEnabled(false)
 		, rootScannerStatsUsed(false)
 		, fvtest_forceOldResize(0)
@@ -1664,6 +1728,8 @@ public:
 		, gcThreadCountSpecified(false)
 		, gcThreadCountForced(false)
 		, dispatcherHybridNotifyThreadBound(16)
+		, adaptiveTaskThreading(false)
+		, adaptiveTaskThreadingTolerance(0.05f)
 #if defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_VLHGC)
 		, scavengerScanOrdering(OMR_GC_SCAVENGER_SCANORDERING_NONE)
 		/* Start of options relating to dynamicBreadthFirstScanOrdering */
@@ -1696,6 +1762,12 @@ public:
 		, scavengerRsoScanUnsafe(false)
 		, cacheListSplit(0)
 		, cacheListSplitForced(false)
+		, scavengerWorkStealing(false)
+		, scavengerWorkStealingDequeSize(256)
+		, scavengerLearnHotFields(false)
+		, scavengerHotFieldSampleInterval(63)
+		, scavengerHotFieldTableSize(1024)
+		, scavengerConcurrentRememberedSetPrune(false)
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 		, softwareRangeCheckReadBarrier(false)
 		, softwareRangeCheckReadBarrierForced(false)
@@ -1724,8 +1796,10 @@ public:
 		, dynamicNewSpaceSizing(true)
 		, debugDynamicNewSpaceSizing(false)
 		, dnssAvoidMovingObjects(true)
+		, numaAwareNursery(false)
 		, dnssExpectedRatioMinimum()
 		, dnssExpectedRatioMaximum()
+		, scavengerPauseTarget(0)
 		, dnssWeightedTimeRatioFactorIncreaseSmall(0.2)
 		, dnssWeightedTimeRatioFactorIncreaseMedium(0.35)
 		, dnssWeightedTimeRatioFactorIncreaseLarge(0.5)
@@ -1763,6 +1837,7 @@ public:
 		, compactOnSystemGC(0)
 		, nocompactOnSystemGC(0)
 		, compactToSatisfyAllocate(false)
+		, compactIncrementSubAreas(0)
 #endif /* defined(OMR_GC_MODRON_COMPACTION) */
 		, payAllocationTax(false)
 #if defined(OMR_GC_MODRON_CONCURRENT_MARK)
@@ -1776,6 +1851,9 @@ public:
 		, concurrentSlack(0)
 		, cardCleanPass2Boost(2)
 		, cardCleaningPasses(2)
+		, cardCleaningBatchSize(1)
+		, concurrentFinalPauseTarget(0)
+		, concurrentAllocationTaxLimit(2.0f)
 		, fvtest_concurrentCardTablePreparationDelay(0)
 		, fvtest_forceConcurrentTLHMarkMapCommitFailure(0)
 		, fvtest_forceConcurrentTLHMarkMapCommitFailureCounter(0)
@@ -1836,6 +1914,11 @@ public:
 #endif /* defined(OMR_GC_REALTIME) || defined(OMR_GC_SEGREGATED_HEAP) */
 #if defined(OMR_GC_SEGREGATED_HEAP)
 		, defaultSizeClasses(NULL)
+		, sizeClassTuner(NULL)
+		, sizeClassTuning(false)
+		, sizeClassTuningWarmupCycles(5)
+		, sizeClassTableFile(NULL)
+		, segregatedLazySweep(false)
 #endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 #if defined(OMR_GC_VLHGC_CONCURRENT_COPY_FORWARD)
 		, heapRegionStateTable(NULL)
@@ -1863,6 +1946,9 @@ public:
 		, verboseExtensions(false)
 		, verboseNewFormat(true)
 		, bufferedLogging(false)
+		, asyncVerboseLogging(false)
+		, asyncVerboseLoggingBufferSize(1024 * 1024)
+		, binaryVerboseLogging(false)
 		, lowAllocationThreshold(UDATA_MAX)
 		, highAllocationThreshold(UDATA_MAX)
 		, disableInlineCacheForAllocationThreshold(false)
@@ -1965,6 +2051,15 @@ public:
 		, darkMatterSampleRate(32)
 		, pretouchHeapOnExpand(false)
 		, decommitMinimumFree(0)
+		, heapUncommit(false)
+		, heapUncommitDelay(0)
+		, heapUncommitMinimumFreeEntrySize(0)
+		, heapUncommitBatchSize(16 * 1024 * 1024)
+		, heapUncommitBatchEntryCount(1024)
+		, parallelMemsetMinimumSize(1024 * 1024)
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+		, markMapEpochClearing(false)
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 #if defined(OMR_GC_IDLE_HEAP_MANAGER)
 		, gcOnIdle(false)
 		, compactOnIdle(false)
@@ -62,8 +62,25 @@ MM_HeapMap::initialize(MM_EnvironmentBase *env)
 		_heapMapBits = (uintptr_t *)memoryManager->getHeapBase(&_heapMapMemoryHandle);
 		_heapBase = _extensions->heap->getHeapBase();
 		_heapMapBaseDelta = (uintptr_t)_heapBase;
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+		_heapMapSize = heapMapSizeRequired;
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 		result = true;
 	}
+
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	if (result && _useEpochTags) {
+		/* Every chunk starts out stale, so memory is zeroed the first time it is used rather than when it is committed */
+		_chunkEpochCount = MM_Math::roundToCeiling(J9MODRON_HEAPMAP_EPOCH_CHUNK_SIZE, heapMapSizeRequired) >> J9MODRON_HEAPMAP_EPOCH_CHUNK_SHIFT;
+		uintptr_t chunkEpochsSize = _chunkEpochCount * sizeof(uint32_t);
+		_chunkEpochs = (volatile uint32_t *)env->getForge()->allocate(chunkEpochsSize, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+		if (NULL == _chunkEpochs) {
+			result = false;
+		} else {
+			memset((void *)_chunkEpochs, 0, chunkEpochsSize);
+		}
+	}
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 	return result;
 }
 
@@ -74,8 +91,125 @@ MM_HeapMap::tearDown(MM_EnvironmentBase *env)
 	memoryManager->destroyVirtualMemory(env, &_heapMapMemoryHandle);
 	
 	_heapMapBits = NULL;
+
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	if (NULL != _chunkEpochs) {
+		env->getForge()->free((void *)_chunkEpochs);
+		_chunkEpochs = NULL;
+	}
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 }
 
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+/**
+ * Epoch tagged chunk maintenance
+ *
+ */
+void
+MM_HeapMap::advanceEpoch()
+{
+	uint32_t nextEpoch = _currentEpoch + 1;
+	if (J9MODRON_HEAPMAP_EPOCH_CLEARING == nextEpoch) {
+		/* The epoch wrapped, retag every chunk as stale so none of them aliases a restarted epoch */
+		for (uintptr_t chunkIndex = 0; chunkIndex < _chunkEpochCount; chunkIndex++) {
+			_chunkEpochs[chunkIndex] = J9MODRON_HEAPMAP_EPOCH_STALE;
+		}
+		nextEpoch = J9MODRON_HEAPMAP_EPOCH_STALE + 1;
+	}
+	_currentEpoch = nextEpoch;
+	MM_AtomicOperations::writeBarrier();
+}
+
+void
+MM_HeapMap::refreshChunk(uintptr_t chunkIndex)
+{
+	Assert_MM_true(chunkIndex < _chunkEpochCount);
+
+	volatile uint32_t *chunkEpoch = &_chunkEpochs[chunkIndex];
+	uint32_t currentEpoch = _currentEpoch;
+	uint32_t chunkValue = *chunkEpoch;
+
+	while (currentEpoch != chunkValue) {
+		if (J9MODRON_HEAPMAP_EPOCH_CLEARING == chunkValue) {
+			/* Another thread is zeroing the chunk, it can be used once that thread publishes the current epoch */
+			MM_AtomicOperations::yieldCPU();
+			chunkValue = *chunkEpoch;
+		} else if (chunkValue == MM_AtomicOperations::lockCompareExchangeU32(chunkEpoch, chunkValue, J9MODRON_HEAPMAP_EPOCH_CLEARING)) {
+			uintptr_t chunkOffset = chunkIndex << J9MODRON_HEAPMAP_EPOCH_CHUNK_SHIFT;
+			uintptr_t chunkSize = OMR_MIN(J9MODRON_HEAPMAP_EPOCH_CHUNK_SIZE, _heapMapSize - chunkOffset);
+			OMRZeroMemory((void *)(((uintptr_t)_heapMapBits) + chunkOffset), chunkSize);
+			/* The zeroed bits must be visible before the epoch that vouches for them */
+			MM_AtomicOperations::writeBarrier();
+			*chunkEpoch = currentEpoch;
+			chunkValue = currentEpoch;
+		} else {
+			chunkValue = *chunkEpoch;
+		}
+	}
+}
+
+void
+MM_HeapMap::invalidateChunk(uintptr_t chunkIndex)
+{
+	volatile uint32_t *chunkEpoch = &_chunkEpochs[chunkIndex];
+	uint32_t chunkValue = *chunkEpoch;
+
+	while (J9MODRON_HEAPMAP_EPOCH_STALE != chunkValue) {
+		if (J9MODRON_HEAPMAP_EPOCH_CLEARING == chunkValue) {
+			/* Let the zeroing thread publish the chunk before retiring it again */
+			MM_AtomicOperations::yieldCPU();
+			chunkValue = *chunkEpoch;
+		} else if (chunkValue == MM_AtomicOperations::lockCompareExchangeU32(chunkEpoch, chunkValue, J9MODRON_HEAPMAP_EPOCH_STALE)) {
+			chunkValue = J9MODRON_HEAPMAP_EPOCH_STALE;
+		} else {
+			chunkValue = *chunkEpoch;
+		}
+	}
+}
+
+void
+MM_HeapMap::ensureSlotsCurrent(uintptr_t baseIndex, uintptr_t topIndex)
+{
+	uintptr_t chunkIndexTop = topIndex >> J9MODRON_HEAPMAP_EPOCH_SLOT_SHIFT;
+	for (uintptr_t chunkIndex = baseIndex >> J9MODRON_HEAPMAP_EPOCH_SLOT_SHIFT; chunkIndex <= chunkIndexTop; chunkIndex++) {
+		if (_currentEpoch != _chunkEpochs[chunkIndex]) {
+			refreshChunk(chunkIndex);
+		}
+	}
+	MM_AtomicOperations::readBarrier();
+}
+
+/**
+ * Clear heap map slots baseIndex up to (not including) topIndex of an epoch tagged heap map.
+ * Chunks wholly inside the range are retired without being touched, only the partial chunks at either end are zeroed.
+ */
+void
+MM_HeapMap::clearSlotsInRange(uintptr_t baseIndex, uintptr_t topIndex)
+{
+	const uintptr_t slotsPerChunk = ((uintptr_t)1) << J9MODRON_HEAPMAP_EPOCH_SLOT_SHIFT;
+	uintptr_t fullChunkBase = MM_Math::roundToCeiling(slotsPerChunk, baseIndex);
+	uintptr_t fullChunkTop = MM_Math::roundToFloor(slotsPerChunk, topIndex);
+
+	if (fullChunkBase >= fullChunkTop) {
+		/* The range does not cover a whole chunk */
+		ensureSlotsCurrent(baseIndex, topIndex - 1);
+		OMRZeroMemory((void *)&(_heapMapBits[baseIndex]), (topIndex - baseIndex) * sizeof(uintptr_t));
+	} else {
+		if (baseIndex < fullChunkBase) {
+			ensureSlotsCurrent(baseIndex, fullChunkBase - 1);
+			OMRZeroMemory((void *)&(_heapMapBits[baseIndex]), (fullChunkBase - baseIndex) * sizeof(uintptr_t));
+		}
+		for (uintptr_t chunkIndex = fullChunkBase / slotsPerChunk; chunkIndex < (fullChunkTop / slotsPerChunk); chunkIndex++) {
+			invalidateChunk(chunkIndex);
+		}
+		if (fullChunkTop < topIndex) {
+			ensureSlotsCurrent(fullChunkTop, topIndex - 1);
+			OMRZeroMemory((void *)&(_heapMapBits[fullChunkTop]), (topIndex - fullChunkTop) * sizeof(uintptr_t));
+		}
+	}
+}
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+
 /**
  * Heap Map re-sizing
  *
@@ -265,6 +399,16 @@ MM_HeapMap::setBitsInRange(MM_EnvironmentBase *env, void *lowAddress, void *high
 	
 	bytesToSet= (topIndex - baseIndex) * sizeof(uintptr_t);
 		
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	if ((NULL != _chunkEpochs) && (0 != bytesToSet)) {
+		if (clear) {
+			clearSlotsInRange(baseIndex, topIndex);
+		} else {
+			ensureSlotsCurrent(baseIndex, topIndex - 1);
+			memset(&(_heapMapBits[baseIndex]), 0xFF, bytesToSet);
+		}
+	} else
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 	if (clear) {
 		OMRZeroMemory((void *)&(_heapMapBits[baseIndex]), bytesToSet);
 	} else {
@@ -307,6 +451,18 @@ MM_HeapMap::checkBitsForRegion(MM_EnvironmentBase *env, MM_HeapRegionDescriptor
 
 	bytesToCheck= (topIndex - baseIndex) * sizeof(uintptr_t);
 
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	if (NULL != _chunkEpochs) {
+		/* Slots in stale chunks read as clear, check them without refreshing their chunks */
+		for (uintptr_t slotIndex = baseIndex; slotIndex < topIndex; slotIndex++) {
+			if (0 != getSlot(slotIndex)) {
+				return false;
+			}
+		}
+		return true;
+	}
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+
 	uint8_t *markMapBytes = (uint8_t *)(&_heapMapBits[baseIndex]);
 	for (uintptr_t i = 0; i < bytesToCheck; i++) {
 		if (0 != markMapBytes[i]) {
@@ -78,6 +78,18 @@ class MM_HeapRegionDescriptor;
 #define J9MODRON_HEAP_BYTES_PER_HEAPMAP_BYTE (J9MODRON_HEAP_BYTES_PER_HEAPMAP_BIT * BITS_IN_BYTE)
 #define J9MODRON_HEAP_BYTES_PER_HEAPMAP_SLOT (J9MODRON_HEAP_BYTES_PER_HEAPMAP_BYTE * sizeof(uintptr_t))
 
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+/* Epoch tagged heap maps are retired chunk by chunk. A chunk is no larger than any page so it is either
+ * entirely committed or entirely uncommitted.
+ */
+#define J9MODRON_HEAPMAP_EPOCH_CHUNK_SHIFT ((uintptr_t)12)
+#define J9MODRON_HEAPMAP_EPOCH_CHUNK_SIZE (((uintptr_t)1) << J9MODRON_HEAPMAP_EPOCH_CHUNK_SHIFT)
+#define J9MODRON_HEAPMAP_EPOCH_SLOT_SHIFT (J9MODRON_HEAPMAP_EPOCH_CHUNK_SHIFT - (J9MODRON_HEAPMAP_LOG_SIZEOF_UDATA - 3))
+#define J9MODRON_HEAPMAP_EPOCH_SLOTS_PER_CHUNK (((uintptr_t)1) << J9MODRON_HEAPMAP_EPOCH_SLOT_SHIFT)
+#define J9MODRON_HEAPMAP_EPOCH_STALE ((uint32_t)0)
+#define J9MODRON_HEAPMAP_EPOCH_CLEARING ((uint32_t)0xFFFFFFFF)
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+
 /**
  * @todo Provide class documentation
  * @ingroup GC_Base_Core
@@ -89,6 +101,9 @@ class MM_HeapMap : public MM_BaseVirtual
  */
 private:
 	const bool _useCompressedHeapMap;	/* selects compressed/uncompressed heap map for realtime/nonrealtime contexts */
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	const bool _useEpochTags;	/* selects lazily cleared, epoch tagged chunks (see advanceEpoch()) */
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 
 protected:
 	const uintptr_t _heapMapIndexShift;	/* number of low-order bits to be shifted out of heap address to obtain heap map slot index */
@@ -106,12 +121,25 @@ protected:
 	
 	uintptr_t _maxHeapSize;
 
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	volatile uint32_t *_chunkEpochs;	/* epoch each heap map chunk was last zeroed in, NULL unless _useEpochTags; a chunk not tagged with _currentEpoch reads as clear */
+	uintptr_t _chunkEpochCount;	/* number of entries in _chunkEpochs */
+	uintptr_t _heapMapSize;	/* bytes of heap map reserved, bounds the last (partial) chunk */
+	volatile uint32_t _currentEpoch;	/* epoch in which the heap map is being populated */
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+
 public:
 	
 /*
  * Function members
  */
 private:
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	void refreshChunk(uintptr_t chunkIndex);
+	void invalidateChunk(uintptr_t chunkIndex);
+	void clearSlotsInRange(uintptr_t baseIndex, uintptr_t topIndex);
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+
 protected:
 	virtual bool initialize(MM_EnvironmentBase *env);
 	virtual void tearDown(MM_EnvironmentBase *env);
@@ -119,6 +147,37 @@ protected:
 	uintptr_t getMaximumHeapMapSize(MM_EnvironmentBase *env);
 	uintptr_t convertHeapIndexToHeapMapIndex(MM_EnvironmentBase *env, uintptr_t size, uintptr_t roundTo);
 	
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	/**
+	 * Advance the epoch, which leaves every chunk of the heap map reading as clear without touching it.
+	 * Must not race with any other access to the heap map.
+	 */
+	void advanceEpoch();
+
+	/**
+	 * Make sure that the chunks holding slots baseIndex through topIndex (inclusive) hold the bits of the current epoch,
+	 * zeroing any stale chunk among them.
+	 */
+	void ensureSlotsCurrent(uintptr_t baseIndex, uintptr_t topIndex);
+
+	/**
+	 * Zero the chunk holding a heap map slot if it is stale, before the slot is written.
+	 */
+	MMINLINE void
+	ensureSlotCurrent(uintptr_t slotIndex)
+	{
+		if (NULL != _chunkEpochs) {
+			uintptr_t chunkIndex = slotIndex >> J9MODRON_HEAPMAP_EPOCH_SLOT_SHIFT;
+			if (_currentEpoch != _chunkEpochs[chunkIndex]) {
+				refreshChunk(chunkIndex);
+			}
+			MM_AtomicOperations::readBarrier();
+		}
+	}
+#else /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+	MMINLINE void ensureSlotCurrent(uintptr_t slotIndex) {}
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+
 public:
 	void kill(MM_EnvironmentBase *env);
 	
@@ -127,6 +186,54 @@ public:
 	
 	MMINLINE void *getHeapBase() { return _heapBase; }
 
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	MMINLINE bool isEpochTagged() const { return NULL != _chunkEpochs; }
+	MMINLINE uint32_t getCurrentEpoch() const { return _currentEpoch; }
+
+	/**
+	 * Make sure that the raw heap map bits for a heap range hold the bits of the current epoch, zeroing stale chunks.
+	 * Only for code that writes the raw bits through getHeapMapBits() or getSlotPtr(), readers use isSlotCurrent().
+	 * @param lowAddress base of the heap range
+	 * @param highAddress top (non-inclusive) of the heap range
+	 */
+	MMINLINE void
+	ensureRangeCurrent(void *lowAddress, void *highAddress)
+	{
+		if ((NULL != _chunkEpochs) && (lowAddress < highAddress)) {
+			ensureSlotsCurrent(getSlotIndex((omrobjectptr_t)lowAddress), getSlotIndex((omrobjectptr_t)((uintptr_t)highAddress - 1)));
+		}
+	}
+
+	/**
+	 * Determine whether the chunk holding a heap map slot was zeroed in the current epoch. Slots in stale chunks
+	 * must be read as 0 and must not be written until the chunk is made current.
+	 */
+	MMINLINE bool
+	isSlotCurrent(uintptr_t slotIndex) const
+	{
+		bool current = true;
+		if (NULL != _chunkEpochs) {
+			current = (_currentEpoch == _chunkEpochs[slotIndex >> J9MODRON_HEAPMAP_EPOCH_SLOT_SHIFT]);
+			/* Order the read of the chunk's bits after the read of the epoch published once they were zeroed */
+			MM_AtomicOperations::readBarrier();
+		}
+		return current;
+	}
+#else /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+	MMINLINE bool isEpochTagged() const { return false; }
+	MMINLINE bool isSlotCurrent(uintptr_t slotIndex) const { return true; }
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+
+	/**
+	 * Read a raw heap map slot by address, a slot in a stale chunk of an epoch tagged map reads as 0.
+	 * @param slotAddress address of the slot, within getHeapMapBits()
+	 */
+	MMINLINE uintptr_t
+	readSlotAt(const uintptr_t *slotAddress) const
+	{
+		return isSlotCurrent((uintptr_t)(slotAddress - _heapMapBits)) ? *slotAddress : 0;
+	}
+
 	MMINLINE uintptr_t *getHeapMapBits() { return _heapMapBits; }
 	MMINLINE const uintptr_t *getHeapMapBits() const { return _heapMapBits; }
 
@@ -170,7 +277,7 @@ public:
 		/*  Just check if the lead bit of the object is set */
 		getSlotIndexAndMask(objectPtr, &slotIndex, &bitMask);
 	
-		return (_heapMapBits[slotIndex] & bitMask) ? true : false;
+		return (isSlotCurrent(slotIndex) && (0 != (_heapMapBits[slotIndex] & bitMask)));
 	}
 
 	MMINLINE bool 
@@ -182,6 +289,7 @@ public:
 		uintptr_t oldValue;
 			
 		getSlotIndexAndMask(objectPtr, &slotIndex, &bitMask);
+		ensureSlotCurrent(slotIndex);
 		slotAddress = &(_heapMapBits[slotIndex]);
 		
 		do {
@@ -202,6 +310,7 @@ public:
 		volatile uintptr_t *slotAddress = &(_heapMapBits[slotIndex]);
 		uintptr_t oldValue;
 		
+		ensureSlotCurrent(slotIndex);
 		do {
 			oldValue = *slotAddress;
 		} while(oldValue != MM_AtomicOperations::lockCompareExchange(slotAddress,
@@ -212,12 +321,13 @@ public:
 	MMINLINE uintptr_t 
 	getSlot(uintptr_t slotIndex)
 	{
-		return _heapMapBits[slotIndex];
+		return isSlotCurrent(slotIndex) ? _heapMapBits[slotIndex] : 0;
 	}
 	
 	MMINLINE void 
 	setSlot(uintptr_t slotIndex, uintptr_t slotValue)
 	{
+		ensureSlotCurrent(slotIndex);
 		_heapMapBits[slotIndex] = slotValue;
 	}
 
@@ -228,6 +338,7 @@ public:
 		uintptr_t *slotAddress;
 		
 		getSlotIndexAndMask(objectPtr, &slotIndex, &bitMask);
+		ensureSlotCurrent(slotIndex);
 		slotAddress = &(_heapMapBits[slotIndex]);
 		
 		if(*slotAddress & bitMask) {
@@ -244,6 +355,10 @@ public:
 		uintptr_t *slotAddress;
 		
 		getSlotIndexAndMask(objectPtr, &slotIndex, &bitMask);
+		if (!isSlotCurrent(slotIndex)) {
+			/* A stale chunk is already clear */
+			return false;
+		}
 		slotAddress = &(_heapMapBits[slotIndex]);
 	
 		/* If bit set then clear it */	
@@ -322,9 +437,12 @@ public:
 #define J9MODRON_HEAPMAP_SELECT_BIT_SHIFT(compress) (J9MODRON_HEAPMAP_BIT_SHIFT)
 #endif /* OMR_GC_SEGREGATED_HEAP */
 
-	MM_HeapMap(MM_EnvironmentBase *env, uintptr_t maxHeapSize, bool useCompressedHeapMap = false) :
+	MM_HeapMap(MM_EnvironmentBase *env, uintptr_t maxHeapSize, bool useCompressedHeapMap = false, bool useEpochTags = false) :
 		MM_BaseVirtual()
 		,_useCompressedHeapMap(useCompressedHeapMap)
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+		,_useEpochTags(useEpochTags)
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 		,_heapMapIndexShift(J9MODRON_HEAPMAP_SELECT_INDEX_SHIFT(useCompressedHeapMap))
 		,_heapMapBitMask(J9MODRON_HEAPMAP_SELECT_BIT_MASK(useCompressedHeapMap))
 		,_heapMapBitShift(J9MODRON_HEAPMAP_SELECT_BIT_SHIFT(useCompressedHeapMap))
@@ -335,6 +453,12 @@ public:
 		,_heapMapBaseDelta(0)
 		,_heapMapBits(NULL)
 		,_maxHeapSize(maxHeapSize)
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+		,_chunkEpochs(NULL)
+		,_chunkEpochCount(0)
+		,_heapMapSize(0)
+		,_currentEpoch(J9MODRON_HEAPMAP_EPOCH_STALE + 1)
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 	{
 		_typeId = __FUNCTION__;
 	}
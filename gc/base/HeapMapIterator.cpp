@@ -32,6 +32,9 @@ bool
 MM_HeapMapIterator::setHeapMap(MM_HeapMap *heapMap)
 {
 	uintptr_t heapOffsetInBytes = (uintptr_t)_heapSlotCurrent - (uintptr_t)heapMap->getHeapBase();
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	_heapMap = heapMap;
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 
 	_bitIndexHead = heapMap->getBitIndex((omrobjectptr_t)_heapSlotCurrent);
 
@@ -40,7 +43,7 @@ MM_HeapMapIterator::setHeapMap(MM_HeapMap *heapMap)
 
 	/* Cache the first heap map value ONLY if we are starting the iteration with at least 1 valid heap slot to scan */
 	if(_heapSlotCurrent < _heapChunkTop) {
-		_heapMapSlotValue = *_heapMapSlotCurrent;
+		_heapMapSlotValue = loadHeapMapSlot();
 		_heapMapSlotValue >>= _bitIndexHead;
 	}
 
@@ -53,6 +56,9 @@ MM_HeapMapIterator::reset(MM_HeapMap *heapMap, uintptr_t *heapChunkBase, uintptr
 	uintptr_t heapOffsetInBytes = (uintptr_t)heapChunkBase - (uintptr_t)heapMap->getHeapBase();
 	_heapChunkTop = heapChunkTop;
 	_heapSlotCurrent = heapChunkBase;
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	_heapMap = heapMap;
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 	
 	_bitIndexHead = heapMap->getBitIndex((omrobjectptr_t)heapChunkBase);
 	
@@ -61,7 +67,7 @@ MM_HeapMapIterator::reset(MM_HeapMap *heapMap, uintptr_t *heapChunkBase, uintptr
 
 	/* Cache the first heap map value ONLY if we are starting the iteration with at least 1 valid heap slot to scan */
 	if(_heapSlotCurrent < _heapChunkTop) {
-		_heapMapSlotValue = *_heapMapSlotCurrent;
+		_heapMapSlotValue = loadHeapMapSlot();
 		_heapMapSlotValue >>= _bitIndexHead;
 	}
 
@@ -112,7 +118,7 @@ MM_HeapMapIterator::nextObject()
 			if(0 != heapMapAdvance) {
 				if(_heapSlotCurrent < _heapChunkTop) {
 					/* Not adjusting the map will be inconsequential - the iteration is complete */
-					_heapMapSlotValue = *_heapMapSlotCurrent;
+					_heapMapSlotValue = loadHeapMapSlot();
 					_heapMapSlotValue >>= _bitIndexHead;
 				}
 			} else {
@@ -130,7 +136,7 @@ MM_HeapMapIterator::nextObject()
 		_heapMapSlotCurrent += 1;
 		_bitIndexHead = 0;
 		if(_heapSlotCurrent < _heapChunkTop) {
-			_heapMapSlotValue = *_heapMapSlotCurrent;
+			_heapMapSlotValue = loadHeapMapSlot();
 		}
 	}
 
@@ -53,8 +53,24 @@ private:
 	uintptr_t _bitIndexHead;  /**< Current bit index in heap map slot that is being scanned */
 	uintptr_t _heapMapSlotValue;  /**< Cached heap map slot value to avoid memory cache polution */
 	MM_GCExtensionsBase * const _extensions; /**< The GC extensions for the JVM */
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	MM_HeapMap *_heapMap; /**< The heap map being iterated, consulted for the epoch of each slot loaded */
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 	bool _useLargeObjectOptimization;	/**< Set to true if we want to read objects from the heap and determine their size in order to skip mark map bits which are inside the object.  If this is set to false, we will blindly return the addresses representing the set bits in the mark map */
 
+	/**
+	 * Load the current heap map slot, a slot in a stale chunk of an epoch tagged map reads as clear.
+	 */
+	MMINLINE uintptr_t
+	loadHeapMapSlot()
+	{
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+		return _heapMap->readSlotAt(_heapMapSlotCurrent);
+#else /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+		return *_heapMapSlotCurrent;
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+	}
+
 public:
 	omrobjectptr_t nextObject();
 
@@ -80,6 +96,9 @@ public:
 		, _bitIndexHead(0)
 		, _heapMapSlotValue(0)
 		, _extensions(extensions)
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+		, _heapMap(NULL)
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 		, _useLargeObjectOptimization(true)
 	{}
 
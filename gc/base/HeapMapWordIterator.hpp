@@ -75,7 +75,8 @@ public:
 		 */
 		volatile uintptr_t *mapPointer = (volatile uintptr_t *) ( ((uint8_t *)heapMap->getHeapMapBits()) + (heapOffsetInBytes / J9MODRON_HEAP_SLOTS_PER_HEAPMAP_SLOT) );
 		Assert_MM_true(0 == ((uintptr_t)mapPointer & (sizeof(uintptr_t) - 1)));
-		_cache = *mapPointer;
+		/* A word in a stale chunk of an epoch tagged map is clear */
+		_cache = heapMap->isSlotCurrent(heapMap->getSlotIndex((omrobjectptr_t)heapCardAddress)) ? *mapPointer : 0;
 		_heapSlotCurrent = (uintptr_t *)heapCardAddress;
 	}
 	
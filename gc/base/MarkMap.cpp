@@ -35,6 +35,7 @@
 #include "HeapRegionIterator.hpp"
 #include "HeapRegionManager.hpp"
 #include "MarkMap.hpp"
+#include "ModronAssertions.h"
 #include "ParallelDispatcher.hpp"
 #include "Task.hpp"
 
@@ -43,11 +44,11 @@
  * Object creation and destruction
  */
 MM_MarkMap *
-MM_MarkMap::newInstance(MM_EnvironmentBase *env, uintptr_t maxHeapSize)
+MM_MarkMap::newInstance(MM_EnvironmentBase *env, uintptr_t maxHeapSize, bool useEpochTags)
 {
 	MM_MarkMap *markMap = (MM_MarkMap *)env->getForge()->allocate(sizeof(MM_MarkMap), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
 	if (NULL != markMap) {
-		new(markMap) MM_MarkMap(env, maxHeapSize);
+		new(markMap) MM_MarkMap(env, maxHeapSize, useEpochTags);
 		if (!markMap->initialize(env)) {
 			markMap->kill(env);
 			markMap = NULL;
@@ -60,6 +61,17 @@ MM_MarkMap::newInstance(MM_EnvironmentBase *env, uintptr_t maxHeapSize)
 void
 MM_MarkMap::initializeMarkMap(MM_EnvironmentBase *env)
 {
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	if (isEpochTagged()) {
+		/* Retire the whole map at once, each chunk is zeroed the first time it is touched in the new epoch */
+		if (J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
+			advanceEpoch();
+			Trc_MM_MarkMap_initializeMarkMap_advanceEpoch(env->getLanguageVMThread(), getCurrentEpoch(), _chunkEpochCount);
+		}
+		return;
+	}
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+
 	/* TODO: The multiplier should really be some constant defined globally */
 	const uintptr_t MODRON_PARALLEL_MULTIPLIER = 32;
 	uintptr_t heapAlignment = _extensions->heapAlignment;
@@ -112,3 +124,19 @@ MM_MarkMap::initializeMarkMap(MM_EnvironmentBase *env)
 		}
 	}
 }
+
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+void
+MM_MarkMap::ensureCommittedRangesCurrent(MM_EnvironmentBase *env)
+{
+	if (isEpochTagged()) {
+		MM_HeapRegionDescriptor *region = NULL;
+		GC_HeapRegionIterator regionIterator(_extensions->getHeap()->getHeapRegionManager());
+		while (NULL != (region = regionIterator.nextRegion())) {
+			if (region->isCommitted() && (0 != region->getSize()) && J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
+				ensureRangeCurrent(region->getLowAddress(), region->getHighAddress());
+			}
+		}
+	}
+}
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
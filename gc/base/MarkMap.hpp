@@ -51,10 +51,23 @@ public:
 	MMINLINE bool isMarkMapValid() const { return _isMarkMapValid; }
 	MMINLINE void setMarkMapValid(bool isMarkMapValid) {  _isMarkMapValid = isMarkMapValid; }
 
- 	static MM_MarkMap *newInstance(MM_EnvironmentBase *env, uintptr_t maxHeapSize);
+	/**
+	 * Create a MarkMap object.
+	 * @param useEpochTags true to clear the map by advancing an epoch (see MM_GCExtensionsBase::markMapEpochClearing),
+	 * ignored unless OMR_GC_MARK_MAP_EPOCH_CLEARING is defined
+	 */
+ 	static MM_MarkMap *newInstance(MM_EnvironmentBase *env, uintptr_t maxHeapSize, bool useEpochTags = false);
  	
  	void initializeMarkMap(MM_EnvironmentBase *env);
 
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	/**
+	 * Zero any stale chunk of the mark map for committed heap, in parallel with the other threads of the current task.
+	 * Required before the raw bits are reused for something other than mark bits, as compaction does.
+	 */
+	void ensureCommittedRangesCurrent(MM_EnvironmentBase *env);
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+
 	MMINLINE void *getMarkBits() { return _heapMapBits; };
  	
 	MMINLINE uintptr_t getHeapMapBaseRegionRounded() { return _heapMapBaseDelta; }
@@ -77,6 +90,11 @@ public:
 	{
 		uintptr_t slotIndex;
 
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+		if ((NULL != _chunkEpochs) && (slotIndexLow <= slotIndexHigh)) {
+			ensureSlotsCurrent(slotIndexLow, slotIndexHigh);
+		}
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 		for (slotIndex = slotIndexLow; slotIndex <= slotIndexHigh; slotIndex++) {
 			_heapMapBits[slotIndex] = value;
 		}
@@ -88,13 +106,18 @@ public:
 		volatile uintptr_t *slotAddress;
 		uintptr_t oldValue;
 
+		ensureSlotCurrent(slotIndex);
 		slotAddress = &(_heapMapBits[slotIndex]);
-
-		do {
-			oldValue = *slotAddress;
-		} while(oldValue != MM_AtomicOperations::lockCompareExchange(slotAddress,
-			oldValue,
-			oldValue | bitMask));
+		oldValue = *slotAddress;
+
+		/* Skip the atomic (and taking the line exclusive) when every bit is already set */
+		while (bitMask != (oldValue & bitMask)) {
+			uintptr_t foundValue = MM_AtomicOperations::lockCompareExchange(slotAddress, oldValue, oldValue | bitMask);
+			if (foundValue == oldValue) {
+				break;
+			}
+			oldValue = foundValue;
+		}
 	}
 
 	MMINLINE uintptr_t
@@ -114,14 +137,15 @@ public:
 #if (8 != BITS_PER_BYTE) || (9 != CARD_SIZE_SHIFT)
 #error Card size has to be exactly 512 bytes
 #endif
-		return 0 != *(uint64_t*)getSlotPtrForAddress((omrobjectptr_t) heapAddress);
+		uintptr_t slotIndex = getSlotIndex((omrobjectptr_t) heapAddress);
+		return isSlotCurrent(slotIndex) && (0 != *(uint64_t*)getSlotPtr(slotIndex));
 	}
 
 	/**
 	 * Create a MarkMap object.
 	 */
-	MM_MarkMap(MM_EnvironmentBase *env, uintptr_t maxHeapSize) :
-		MM_HeapMap(env, maxHeapSize, env->getExtensions()->isSegregatedHeap())
+	MM_MarkMap(MM_EnvironmentBase *env, uintptr_t maxHeapSize, bool useEpochTags) :
+		MM_HeapMap(env, maxHeapSize, env->getExtensions()->isSegregatedHeap(), useEpochTags && !env->getExtensions()->isSegregatedHeap())
 		, _isMarkMapValid(false)
 	{
 		_typeId = __FUNCTION__;
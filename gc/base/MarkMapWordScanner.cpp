@@ -0,0 +1,225 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base
+ */
+
+#include "omrcfg.h"
+#include "omrport.h"
+
+#include "MarkMapWordScanner.hpp"
+
+#include "Bits.hpp"
+#include "EnvironmentBase.hpp"
+
+#if defined(OMR_GC_MARK_MAP_VECTOR_SCAN)
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#define MARK_MAP_TARGET_AVX2
+#define MARK_MAP_TARGET_AVX512
+#else /* defined(_MSC_VER) */
+#define MARK_MAP_TARGET_AVX2 __attribute__((target("avx2")))
+#define MARK_MAP_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif /* defined(_MSC_VER) */
+
+#define XCR0_AVX_STATE ((uint64_t)0x6) /* XMM and YMM state */
+#define XCR0_AVX512_STATE ((uint64_t)0xE6) /* XMM, YMM, opmask, ZMM_Hi256 and Hi16_ZMM state */
+
+#if defined(OMR_ENV_DATA64)
+#define MARK_MAP_TEST_WORDS_AVX512 _mm512_test_epi64_mask
+#else /* defined(OMR_ENV_DATA64) */
+#define MARK_MAP_TEST_WORDS_AVX512 _mm512_test_epi32_mask
+#endif /* defined(OMR_ENV_DATA64) */
+
+#define MARK_MAP_SCAN_PROLOGUE_WORDS 8 /* number of words of a run tested individually before using vectors */
+
+/**
+ * Check that the operating system saves the given vector register state across context switches.
+ * Must only be called if the processor reports OSXSAVE.
+ * @param mask the XCR0 bits which must all be set
+ * @return true if the state is enabled, false otherwise
+ */
+static bool
+isVectorStateEnabled(uint64_t mask)
+{
+#if defined(_MSC_VER)
+	uint64_t xcr0 = _xgetbv(0);
+#else /* defined(_MSC_VER) */
+	uint32_t eax = 0;
+	uint32_t edx = 0;
+	__asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+	uint64_t xcr0 = ((uint64_t)edx << 32) | eax;
+#endif /* defined(_MSC_VER) */
+	return (mask == (xcr0 & mask));
+}
+#endif /* defined(OMR_GC_MARK_MAP_VECTOR_SCAN) */
+
+void
+MM_MarkMapWordScanner::initialize(MM_EnvironmentBase *env)
+{
+	OMRPortLibrary *portLibrary = env->getPortLibrary();
+
+	if (isKernelSupported(portLibrary, kernel_avx512)) {
+		_kernel = kernel_avx512;
+	} else if (isKernelSupported(portLibrary, kernel_avx2)) {
+		_kernel = kernel_avx2;
+	} else {
+		_kernel = kernel_scalar;
+	}
+	_findNonEmptyWord = getKernelFunction(_kernel);
+}
+
+bool
+MM_MarkMapWordScanner::isKernelSupported(OMRPortLibrary *portLibrary, Kernel kernel)
+{
+	bool supported = (kernel_scalar == kernel);
+
+#if defined(OMR_GC_MARK_MAP_VECTOR_SCAN)
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	OMRProcessorDesc processorDescription;
+
+	if ((!supported)
+		&& (0 == omrsysinfo_get_processor_description(&processorDescription))
+		&& omrsysinfo_processor_has_feature(&processorDescription, OMR_FEATURE_X86_OSXSAVE)
+	) {
+		switch (kernel) {
+		case kernel_avx2:
+			supported = omrsysinfo_processor_has_feature(&processorDescription, OMR_FEATURE_X86_AVX2) && isVectorStateEnabled(XCR0_AVX_STATE);
+			break;
+		case kernel_avx512:
+			supported = omrsysinfo_processor_has_feature(&processorDescription, OMR_FEATURE_X86_AVX512F) && isVectorStateEnabled(XCR0_AVX512_STATE);
+			break;
+		default:
+			break;
+		}
+	}
+#endif /* defined(OMR_GC_MARK_MAP_VECTOR_SCAN) */
+
+	return supported;
+}
+
+MM_MarkMapWordScanner::FindNonEmptyWordFunction
+MM_MarkMapWordScanner::getKernelFunction(Kernel kernel)
+{
+	FindNonEmptyWordFunction function = findNonEmptyWordScalar;
+
+#if defined(OMR_GC_MARK_MAP_VECTOR_SCAN)
+	switch (kernel) {
+	case kernel_avx2:
+		function = findNonEmptyWordAVX2;
+		break;
+	case kernel_avx512:
+		function = findNonEmptyWordAVX512;
+		break;
+	default:
+		break;
+	}
+#endif /* defined(OMR_GC_MARK_MAP_VECTOR_SCAN) */
+
+	return function;
+}
+
+uintptr_t *
+MM_MarkMapWordScanner::findNonEmptyWordScalar(uintptr_t *current, uintptr_t *top)
+{
+	while ((current < top) && (0 == *current)) {
+		current += 1;
+	}
+	return current;
+}
+
+#if defined(OMR_GC_MARK_MAP_VECTOR_SCAN)
+/**
+ * Test the first few words of a run one at a time before switching to vectors, since short runs
+ * are common in densely populated regions and would otherwise be tested twice.
+ * @return the first non-empty word found, or the first untested word if they were all empty
+ */
+static MMINLINE uintptr_t *
+findNonEmptyWordPrologue(uintptr_t *current, uintptr_t *top)
+{
+	uintptr_t *prologueTop = current + MARK_MAP_SCAN_PROLOGUE_WORDS;
+
+	if (prologueTop > top) {
+		prologueTop = top;
+	}
+	while ((current < prologueTop) && (0 == *current)) {
+		current += 1;
+	}
+	return current;
+}
+
+MARK_MAP_TARGET_AVX2 uintptr_t *
+MM_MarkMapWordScanner::findNonEmptyWordAVX2(uintptr_t *current, uintptr_t *top)
+{
+	/* test a cache line (two 256 bit vectors) per iteration */
+	const uintptr_t wordsPerVector = sizeof(__m256i) / sizeof(uintptr_t);
+	const __m256i zero = _mm256_setzero_si256();
+
+	current = findNonEmptyWordPrologue(current, top);
+	while ((uintptr_t)(top - current) >= (2 * wordsPerVector)) {
+		__m256i low = _mm256_loadu_si256((const __m256i *)current);
+		__m256i high = _mm256_loadu_si256((const __m256i *)(current + wordsPerVector));
+		__m256i combined = _mm256_or_si256(low, high);
+		if (!_mm256_testz_si256(combined, combined)) {
+			/* locate the first non-zero byte, and from it the word containing it */
+			uint32_t nonZeroBytes = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, zero));
+			if (0 == nonZeroBytes) {
+				current += wordsPerVector;
+				nonZeroBytes = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, zero));
+			}
+			return current + (MM_Bits::leadingZeroes(nonZeroBytes) / sizeof(uintptr_t));
+		}
+		current += 2 * wordsPerVector;
+	}
+
+	/* finish the tail of the range, which is shorter than a cache line */
+	return findNonEmptyWordScalar(current, top);
+}
+
+MARK_MAP_TARGET_AVX512 uintptr_t *
+MM_MarkMapWordScanner::findNonEmptyWordAVX512(uintptr_t *current, uintptr_t *top)
+{
+	/* test two cache lines (two 512 bit vectors) per iteration */
+	const uintptr_t wordsPerVector = sizeof(__m512i) / sizeof(uintptr_t);
+
+	current = findNonEmptyWordPrologue(current, top);
+	while ((uintptr_t)(top - current) >= (2 * wordsPerVector)) {
+		__m512i low = _mm512_loadu_si512((const void *)current);
+		__m512i high = _mm512_loadu_si512((const void *)(current + wordsPerVector));
+		/* one mask bit per non-zero word */
+		uintptr_t nonZeroWords = (uintptr_t)MARK_MAP_TEST_WORDS_AVX512(low, low);
+		if (0 != nonZeroWords) {
+			return current + MM_Bits::leadingZeroes(nonZeroWords);
+		}
+		nonZeroWords = (uintptr_t)MARK_MAP_TEST_WORDS_AVX512(high, high);
+		if (0 != nonZeroWords) {
+			return current + wordsPerVector + MM_Bits::leadingZeroes(nonZeroWords);
+		}
+		current += 2 * wordsPerVector;
+	}
+
+	return findNonEmptyWordScalar(current, top);
+}
+#endif /* defined(OMR_GC_MARK_MAP_VECTOR_SCAN) */
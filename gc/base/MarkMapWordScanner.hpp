@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base
+ */
+
+#if !defined(MARKMAPWORDSCANNER_HPP_)
+#define MARKMAPWORDSCANNER_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrport.h"
+#include "modronbase.h"
+
+class MM_EnvironmentBase;
+
+#if defined(OMR_ARCH_X86) && (defined(__GNUC__) || defined(_MSC_VER))
+/* vector kernels are compiled with per function target attributes (or MSVC intrinsics) and selected at runtime */
+#define OMR_GC_MARK_MAP_VECTOR_SCAN
+#endif /* defined(OMR_ARCH_X86) && (defined(__GNUC__) || defined(_MSC_VER)) */
+
+/**
+ * Locates the end of a run of empty (all zero) mark map words.
+ * Sweep spends most of its time skipping over the mark map words covering dead objects, so the
+ * scan is done by a kernel which tests as many words at once as the processor allows.  The kernel
+ * is chosen once, when the scanner is initialized, from the features reported by the port library.
+ * @ingroup GC_Base
+ */
+class MM_MarkMapWordScanner
+{
+	/*
+	 * Data members
+	 */
+public:
+	typedef uintptr_t *(*FindNonEmptyWordFunction)(uintptr_t *current, uintptr_t *top);
+
+	enum Kernel {
+		kernel_scalar = 0,
+		kernel_avx2,
+		kernel_avx512
+	};
+
+private:
+	FindNonEmptyWordFunction _findNonEmptyWord; /**< kernel selected for this processor */
+	Kernel _kernel; /**< identifies the selected kernel */
+
+	/*
+	 * Function members
+	 */
+public:
+	/**
+	 * Select the fastest kernel supported by the processor and operating system.
+	 */
+	void initialize(MM_EnvironmentBase *env);
+
+	/**
+	 * @param portLibrary the port library used to query the processor features
+	 * @param kernel the kernel to check
+	 * @return true if the kernel can run on this processor and operating system, false otherwise
+	 */
+	static bool isKernelSupported(OMRPortLibrary *portLibrary, Kernel kernel);
+
+	/**
+	 * @return the function implementing the given kernel
+	 */
+	static FindNonEmptyWordFunction getKernelFunction(Kernel kernel);
+
+	/**
+	 * Find the first non-empty mark map word in the range [current, top).
+	 * The first word is tested inline, since most runs of empty words are short.
+	 * @param current first mark map word to test
+	 * @param top end of the range (exclusive)
+	 * @return the address of the first non-empty word, or top if all words in the range are empty
+	 */
+	MMINLINE uintptr_t *
+	findNonEmptyWord(uintptr_t *current, uintptr_t *top)
+	{
+		if ((current < top) && (0 == *current)) {
+			current = _findNonEmptyWord(current + 1, top);
+		}
+		return current;
+	}
+
+	MMINLINE Kernel getKernel() { return _kernel; }
+
+	static uintptr_t *findNonEmptyWordScalar(uintptr_t *current, uintptr_t *top);
+#if defined(OMR_GC_MARK_MAP_VECTOR_SCAN)
+	static uintptr_t *findNonEmptyWordAVX2(uintptr_t *current, uintptr_t *top);
+	static uintptr_t *findNonEmptyWordAVX512(uintptr_t *current, uintptr_t *top);
+#endif /* defined(OMR_GC_MARK_MAP_VECTOR_SCAN) */
+
+	MM_MarkMapWordScanner()
+		: _findNonEmptyWord(findNonEmptyWordScalar)
+		, _kernel(kernel_scalar)
+	{
+	}
+};
+
+#endif /* MARKMAPWORDSCANNER_HPP_ */
@@ -36,6 +36,7 @@
 #include "Heap.hpp"
 #include "MarkMap.hpp"
 #include "MarkingScheme.hpp"
+#include "Prefetch.hpp"
 #include "Task.hpp"
 #if defined(OMR_GC_REALTIME)
 #include "WorkPacketsSATB.hpp"
@@ -85,7 +86,11 @@ MM_MarkingScheme::kill(MM_EnvironmentBase *env)
 bool
 MM_MarkingScheme::initialize(MM_EnvironmentBase *env)
 {
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	_markMap = MM_MarkMap::newInstance(env, _extensions->heap->getMaximumPhysicalRange(), _extensions->markMapEpochClearing);
+#else /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 	_markMap = MM_MarkMap::newInstance(env, _extensions->heap->getMaximumPhysicalRange());
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
 
 	if (!_markMap) {
 		goto error_no_memory;
@@ -96,6 +101,8 @@ MM_MarkingScheme::initialize(MM_EnvironmentBase *env)
 		goto error_no_memory;
 	}
 
+	_prefetchDistance = OMR_MIN(_extensions->markingPrefetchDistance, MARKING_PREFETCH_DISTANCE_MAX);
+
 	return _delegate.initialize(env, this);
 
 error_no_memory:
@@ -321,9 +328,66 @@ MM_MarkingScheme::scanObject(MM_EnvironmentBase *env, omrobjectptr_t objectPtr)
 void
 MM_MarkingScheme::completeScan(MM_EnvironmentBase *env)
 {
+	bool countCacheMisses = _extensions->markingCacheMissStats && env->_cacheMissCounter.start();
+
+	if (0 != _prefetchDistance) {
+		completeScanWithPrefetch(env);
+	} else {
+		do {
+			omrobjectptr_t objectPtr = NULL;
+			while (NULL != (objectPtr = (omrobjectptr_t )env->_workStack.pop(env))) {
+				env->_markStats._bytesScanned += scanObject(env, objectPtr);
+				env->_markStats._objectsScanned += 1;
+			}
+		} while (_workPackets->handleWorkPacketOverflow(env));
+	}
+
+	if (countCacheMisses) {
+		env->_cacheMissCounter.stop(&env->_markStats._cacheReferences, &env->_markStats._cacheMisses);
+	}
+}
+
+void
+MM_MarkingScheme::completeScanWithPrefetch(MM_EnvironmentBase *env)
+{
+	omrobjectptr_t ring[MARKING_PREFETCH_DISTANCE_MAX];
+	uintptr_t ringHead = 0;
+	uintptr_t ringCount = 0;
+
 	do {
-		omrobjectptr_t objectPtr = NULL;
-		while (NULL != (objectPtr = (omrobjectptr_t )env->_workStack.pop(env))) {
+		while (true) {
+			omrobjectptr_t objectPtr = NULL;
+
+			/* Top up the ring. Block waiting for work only when the ring is empty, since a thread
+			 * still holding unscanned objects must not take part in termination detection.
+			 */
+			while (ringCount < _prefetchDistance) {
+				objectPtr = (omrobjectptr_t)((0 == ringCount) ? env->_workStack.pop(env) : env->_workStack.popNoWait(env));
+				if (NULL == objectPtr) {
+					break;
+				}
+				MM_Prefetch::prefetchRead(objectPtr);
+				MM_Prefetch::prefetchRead((uint8_t *)objectPtr + MARKING_PREFETCH_OBJECT_BYTES);
+
+				uintptr_t ringTail = ringHead + ringCount;
+				if (ringTail >= _prefetchDistance) {
+					ringTail -= _prefetchDistance;
+				}
+				ring[ringTail] = objectPtr;
+				ringCount += 1;
+			}
+
+			if (0 == ringCount) {
+				break;
+			}
+
+			objectPtr = ring[ringHead];
+			ringHead += 1;
+			if (ringHead == _prefetchDistance) {
+				ringHead = 0;
+			}
+			ringCount -= 1;
+
 			env->_markStats._bytesScanned += scanObject(env, objectPtr);
 			env->_markStats._objectsScanned += 1;
 		}
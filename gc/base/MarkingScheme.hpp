@@ -38,6 +38,9 @@
 #include "ObjectScannerState.hpp"
 #include "WorkStack.hpp"
 
+#define MARKING_PREFETCH_DISTANCE_MAX 32 /**< largest number of objects prefetched ahead of scanning */
+#define MARKING_PREFETCH_OBJECT_BYTES 64 /**< offset of the second line prefetched for each object (header and first slots) */
+
 /**
  * @todo Provide class documentation
  */
@@ -56,6 +59,7 @@ protected:
 	MM_WorkPackets *_workPackets;
 	void *_heapBase;
 	void *_heapTop;
+	uintptr_t _prefetchDistance; /**< Number of objects prefetched ahead of scanning in completeScan(), 0 if not prefetching */
 
 public:
 
@@ -76,6 +80,13 @@ private:
 	 */
 	MMINLINE uintptr_t scanObject(MM_EnvironmentBase *env, omrobjectptr_t objectPtr);
 
+	/**
+	 * Private internal. Called exclusively from completeScan() when prefetching is enabled.
+	 * Popped objects pass through a small ring before they are scanned so that their
+	 * headers and first slots are prefetched while earlier objects are being scanned.
+	 */
+	void completeScanWithPrefetch(MM_EnvironmentBase *env);
+
 	MM_WorkPackets *createWorkPackets(MM_EnvironmentBase *env);
 
 protected:
@@ -312,6 +323,7 @@ public:
 		, _workPackets(NULL)
 		, _heapBase(NULL)
 		, _heapTop(NULL)
+		, _prefetchDistance(0)
 	{
 		_typeId = __FUNCTION__;
 	}
@@ -46,32 +46,6 @@ public:
 	 * Function members
 	 */
 private:
-	/**
-	 * Check can GC Matadata allocation be done in Virtual Memory
-	 * An alternative is to use malloc (non-virtual memory)
-	 * This decision is platform-based
-	 *
-	 * @param env environment
-	 * @return true if Virtual Memory can be used
-	 */
-	MMINLINE bool isMetadataAllocatedInVirtualMemory(MM_EnvironmentBase *env)
-	{
-		bool result = true;
-
-#if (defined(AIXPPC) && !defined(PPC64))
-		result = false;
-#elif(defined(AIXPPC) && defined(OMR_GC_REALTIME))
-		MM_GCExtensionsBase *extensions = env->getExtensions();
-		if (extensions->isMetronomeGC()) {
-			result = false;
-		}
-#elif defined(J9ZOS39064)
-		result = false;
-#endif /* (defined(AIXPPC) && (!defined(PPC64) || defined(OMR_GC_REALTIME))) */
-
-		return result;
-	}
-
 	/**
 	 * Return memory segment size for preallocation purpose
 	 * Is used for preallocation-enabled platforms only
@@ -110,6 +84,32 @@ protected:
 	};
 
 public:
+	/**
+	 * Check can GC Matadata allocation be done in Virtual Memory
+	 * An alternative is to use malloc (non-virtual memory)
+	 * This decision is platform-based
+	 *
+	 * @param env environment
+	 * @return true if Virtual Memory can be used
+	 */
+	MMINLINE bool isMetadataAllocatedInVirtualMemory(MM_EnvironmentBase *env)
+	{
+		bool result = true;
+
+#if (defined(AIXPPC) && !defined(PPC64))
+		result = false;
+#elif(defined(AIXPPC) && defined(OMR_GC_REALTIME))
+		MM_GCExtensionsBase *extensions = env->getExtensions();
+		if (extensions->isMetronomeGC()) {
+			result = false;
+		}
+#elif defined(J9ZOS39064)
+		result = false;
+#endif /* (defined(AIXPPC) && (!defined(PPC64) || defined(OMR_GC_REALTIME))) */
+
+		return result;
+	}
+
 	/**
 	 * Create new instance for the class
 	 *
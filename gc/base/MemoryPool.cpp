@@ -518,3 +518,10 @@ MM_MemoryPool::releaseFreeMemoryPages(MM_EnvironmentBase* env)
         Assert_MM_unreachable();
 	return 0;
 }
+
+bool
+MM_MemoryPool::uncommitFreeMemoryPages(MM_EnvironmentBase* env, MM_HeapUncommitService *service)
+{
+	/* No free list to walk */
+	return true;
+}
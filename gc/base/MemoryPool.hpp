@@ -36,6 +36,7 @@
 #include "MemorySubSpace.hpp"
 
 class MM_HeapLinkedFreeHeader;
+class MM_HeapUncommitService;
 class MM_AllocateDescription;
 class MM_HeapRegionDescriptor;
 class MM_LargeObjectAllocateStats;
@@ -233,6 +234,16 @@ public:
 	
 	virtual void setLastFreeEntry(void * addr) {}
 	virtual MM_HeapLinkedFreeHeader *getLastFreeEntry() { return NULL; }
+
+	/**
+	 * Discard the NUMA slices of the pool (see GCExtensionsBase::numaAwareNursery).
+	 */
+	virtual void resetNUMASlices(MM_EnvironmentBase *env) {}
+	/**
+	 * Record that [lowAddress, highAddress) is bound to the given NUMA node, so that TLH refreshes of threads
+	 * bound to the node are served from it where possible. Slices are added in address order.
+	 */
+	virtual void addNUMASlice(MM_EnvironmentBase *env, uintptr_t j9NodeNumber, void *lowAddress, void *highAddress) {}
 	
 	/**
 	 * Allocates the contiguous portion of an object.  This means all mixed objects, all indexable objects outside of arraylet
@@ -423,6 +434,14 @@ public:
 	 */
 	virtual uintptr_t releaseFreeMemoryPages(MM_EnvironmentBase* env);
 
+	/**
+	 * Walk the free lists of the pool for the heap uncommit service, one batch at a time.
+	 * The free list lock is held for each batch only, so allocation can proceed between batches.
+	 * @see MM_HeapUncommitService::uncommitFreeEntries()
+	 * @return true if the pool was walked completely, false if the service yielded
+	 */
+	virtual bool uncommitFreeMemoryPages(MM_EnvironmentBase* env, MM_HeapUncommitService *service);
+
 #if defined(J9VM_OPT_CRIU_SUPPORT)
 	/**
 	 * Make adjustments to the Memory Pool to accommodate the restore configuration.
@@ -30,6 +30,7 @@
 #include "MemoryPoolAddressOrderedList.hpp"
 
 #include "AllocateDescription.hpp"
+#include "Bits.hpp"
 #include "Debug.hpp"
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
@@ -40,6 +41,7 @@
 #include "HeapRegionDescriptor.hpp"
 #include "LargeObjectAllocateStats.hpp"
 #include "HeapLinkedFreeHeader.hpp"
+#include "HeapUncommitService.hpp"
 #include "Heap.hpp"
 #include "Math.hpp"
 
@@ -76,12 +78,22 @@ MM_MemoryPoolAddressOrderedList::newInstance(MM_EnvironmentBase *env, uintptr_t
  */
 MM_MemoryPoolAddressOrderedList *
 MM_MemoryPoolAddressOrderedList::newInstance(MM_EnvironmentBase *env, uintptr_t minimumFreeEntrySize, const char *name)
+{
+	return newInstance(env, minimumFreeEntrySize, name, false);
+}
+
+/**
+ * Create and initialize a new instance of the receiver.
+ */
+MM_MemoryPoolAddressOrderedList *
+MM_MemoryPoolAddressOrderedList::newInstance(MM_EnvironmentBase *env, uintptr_t minimumFreeEntrySize, const char *name, bool bestFitIndex)
 {
 	MM_MemoryPoolAddressOrderedList *memoryPool;
 
 	memoryPool = (MM_MemoryPoolAddressOrderedList *)env->getForge()->allocate(sizeof(MM_MemoryPoolAddressOrderedList), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
 	if (memoryPool) {
 		memoryPool = new(memoryPool) MM_MemoryPoolAddressOrderedList(env, minimumFreeEntrySize, name);
+		memoryPool->_bestFitIndexEnabled = bestFitIndex;
 		if (!memoryPool->initialize(env)) {
 			memoryPool->kill(env);
 			memoryPool = NULL;
@@ -128,6 +140,54 @@ MM_MemoryPoolAddressOrderedList::initialize(MM_EnvironmentBase *env)
 		return false;
 	} 
 
+	/* The index keeps its links in the bodies of free entries, which valgrind would report as invalid accesses.
+	 * The best fit tree is maintained along with the size class index, so it enables it.
+	 */
+#if defined(OMR_VALGRIND_MEMCHECK)
+	_bestFitIndexEnabled = false;
+#else /* OMR_VALGRIND_MEMCHECK */
+	_sizeClassIndexEnabled = ext->freeListSizeClassIndex || _bestFitIndexEnabled;
+#endif /* OMR_VALGRIND_MEMCHECK */
+#if defined(OMR_GC_CONCURRENT_SWEEP)
+	if (ext->concurrentSweep) {
+		/* Concurrent sweep connects free entries to the list while it is being allocated from */
+		_sizeClassIndexEnabled = false;
+		_bestFitIndexEnabled = false;
+	}
+#endif /* OMR_GC_CONCURRENT_SWEEP */
+	if (_sizeClassIndexEnabled) {
+		memset(&_bestFitTree, 0, sizeof(_bestFitTree));
+		_bestFitTree.insertionComparator = compareBestFitTreeNodes;
+		_bestFitTree.portLibrary = env->getPortLibrary();
+	}
+	if (_sizeClassIndexEnabled) {
+		_sizeClassCount = _largeObjectAllocateStats->getMaxSizeClasses();
+		_sizeClassIndexMaximumSize = ext->heap->getMaximumMemorySize();
+		_sizeClassBins = (MM_HeapLinkedFreeHeader **)env->getForge()->allocate(sizeof(MM_HeapLinkedFreeHeader *) * _sizeClassCount, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+		if (NULL == _sizeClassBins) {
+			return false;
+		}
+		uintptr_t occupancyWords = (_sizeClassCount + J9BITS_BITS_IN_SLOT - 1) / J9BITS_BITS_IN_SLOT;
+		_sizeClassOccupancy = (uintptr_t *)env->getForge()->allocate(sizeof(uintptr_t) * occupancyWords, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+		if (NULL == _sizeClassOccupancy) {
+			return false;
+		}
+	}
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	/* Slices are only set on nursery pools, whose free lists are not connected by concurrent sweep */
+	if (ext->numaAwareNursery && !ext->isConcurrentSweepEnabled()) {
+		uintptr_t affinityLeaderCount = ext->_numaManager.getAffinityLeaderCount();
+		if (affinityLeaderCount > 1) {
+			_numaSlices = (MM_NUMASlice *)env->getForge()->allocate(sizeof(MM_NUMASlice) * affinityLeaderCount, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+			if (NULL == _numaSlices) {
+				return false;
+			}
+			_numaSliceCapacity = affinityLeaderCount;
+		}
+	}
+#endif /* OMR_GC_MODRON_SCAVENGER */
+
 	/* At this moment we do not know who is creator of this pool, so we do not set _largeObjectCollectorAllocateStats yet.
 	 * Tenure SubSpace for Gencon will set _largeObjectCollectorAllocateStats to _largeObjectAllocateStats (we append collector stats to mutator stats)
 	 * SemiSpace will leave _largeObjectCollectorAllocateStats at NULL (no interest in Collector stats)
@@ -206,6 +266,23 @@ MM_MemoryPoolAddressOrderedList::tearDown(MM_EnvironmentBase *env)
 	
 	_largeObjectCollectorAllocateStats = NULL;
 
+	if (NULL != _sizeClassBins) {
+		env->getForge()->free(_sizeClassBins);
+		_sizeClassBins = NULL;
+	}
+
+	if (NULL != _sizeClassOccupancy) {
+		env->getForge()->free(_sizeClassOccupancy);
+		_sizeClassOccupancy = NULL;
+	}
+
+	if (NULL != _numaSlices) {
+		env->getForge()->free(_numaSlices);
+		_numaSlices = NULL;
+	}
+	_numaSliceCapacity = 0;
+	_numaSliceCount = 0;
+
 	_heapLock.tearDown();
 	_resetLock.tearDown();
 }
@@ -433,6 +510,330 @@ MM_MemoryPoolAddressOrderedList::updateHintsBeyondEntry(MM_HeapLinkedFreeHeader
 	}
 }
 
+/****************************************
+ * Size Class Index Functionality
+ ****************************************
+ */
+/**
+ * Rebuild the size class index from the free list. Called at the end of a sweep (see buildFreeListIndex()),
+ * or lazily on the first allocation after any other free list update which did not maintain the index.
+ */
+void
+MM_MemoryPoolAddressOrderedList::rebuildSizeClassIndex(MM_EnvironmentBase *env)
+{
+	bool const compressed = compressObjectReferences();
+	MM_FreeEntrySizeClassStats *freeEntrySizeClassStats = _largeObjectAllocateStats->getFreeEntrySizeClassStats();
+	uintptr_t occupancyWords = (_sizeClassCount + J9BITS_BITS_IN_SLOT - 1) / J9BITS_BITS_IN_SLOT;
+	uintptr_t entryCount = 0;
+
+	memset(_sizeClassBins, 0, sizeof(MM_HeapLinkedFreeHeader *) * _sizeClassCount);
+	memset(_sizeClassOccupancy, 0, sizeof(uintptr_t) * occupancyWords);
+	_bestFitTree.rootNode = NULL;
+
+	MM_HeapLinkedFreeHeader *previousFreeEntry = NULL;
+	MM_HeapLinkedFreeHeader *currentFreeEntry = _heapFreeList;
+	while (NULL != currentFreeEntry) {
+		addToSizeClassIndex(currentFreeEntry, previousFreeEntry);
+		entryCount += 1;
+		previousFreeEntry = currentFreeEntry;
+		currentFreeEntry = currentFreeEntry->getNext(compressed);
+	}
+	_sizeClassIndexValid = true;
+
+	Trc_MM_MemoryPoolAddressOrderedList_sizeClassIndexRebuilt(env->getLanguageVMThread(), this, entryCount,
+		freeEntrySizeClassStats->getIndexHitCount(), freeEntrySizeClassStats->getIndexMissCount(), freeEntrySizeClassStats->getIndexScanCount());
+	freeEntrySizeClassStats->resetIndexCounts();
+}
+
+/**
+ * Rebuild a stale size class index while the collector still holds the heap, rather than on
+ * the first allocation after the collection.
+ */
+void
+MM_MemoryPoolAddressOrderedList::buildFreeListIndex(MM_EnvironmentBase *env)
+{
+	if (_sizeClassIndexEnabled && !_sizeClassIndexValid) {
+		rebuildSizeClassIndex(env);
+	}
+}
+
+/**
+ * Link a free entry, which is already on the free list, into the bin for its size class.
+ * The address ordered successor of the entry (if any) records the entry as its predecessor.
+ */
+void
+MM_MemoryPoolAddressOrderedList::addToSizeClassIndex(MM_HeapLinkedFreeHeader *freeEntry, MM_HeapLinkedFreeHeader *previousFreeEntry)
+{
+	bool const compressed = compressObjectReferences();
+	MM_FreeEntrySizeClassLinks *links = getSizeClassLinks(freeEntry);
+	uintptr_t sizeClass = _largeObjectAllocateStats->getSizeClassIndex(freeEntry->getSize());
+	MM_HeapLinkedFreeHeader *binHead = _sizeClassBins[sizeClass];
+
+	links->previousFreeEntry = previousFreeEntry;
+	links->previousInSizeClass = NULL;
+	links->nextInSizeClass = binHead;
+	links->sizeClass = sizeClass;
+	if (NULL != binHead) {
+		getSizeClassLinks(binHead)->previousInSizeClass = freeEntry;
+	}
+	_sizeClassBins[sizeClass] = freeEntry;
+	_sizeClassOccupancy[sizeClass / J9BITS_BITS_IN_SLOT] |= ((uintptr_t)1 << (sizeClass % J9BITS_BITS_IN_SLOT));
+
+	links->indexedSize = freeEntry->getSize();
+	links->treeNode.leftChild = 0;
+	links->treeNode.rightChild = 0;
+	J9AVLTreeNode *insertedNode = avl_insert(&_bestFitTree, &links->treeNode);
+	Assert_MM_true(&links->treeNode == insertedNode);
+
+	MM_HeapLinkedFreeHeader *nextFreeEntry = freeEntry->getNext(compressed);
+	if (NULL != nextFreeEntry) {
+		getSizeClassLinks(nextFreeEntry)->previousFreeEntry = freeEntry;
+	}
+}
+
+/**
+ * Unlink a free entry from its size class bin. Must be called while the entry is still intact, before
+ * it is allocated from, coalesced or unlinked from the free list. The address ordered successor of the
+ * entry (if any) inherits its predecessor.
+ */
+void
+MM_MemoryPoolAddressOrderedList::removeFromSizeClassIndex(MM_HeapLinkedFreeHeader *freeEntry)
+{
+	bool const compressed = compressObjectReferences();
+	MM_FreeEntrySizeClassLinks *links = getSizeClassLinks(freeEntry);
+	uintptr_t sizeClass = links->sizeClass;
+
+	if (NULL != links->previousInSizeClass) {
+		getSizeClassLinks(links->previousInSizeClass)->nextInSizeClass = links->nextInSizeClass;
+	} else {
+		Assert_MM_true(freeEntry == _sizeClassBins[sizeClass]);
+		_sizeClassBins[sizeClass] = links->nextInSizeClass;
+		if (NULL == links->nextInSizeClass) {
+			_sizeClassOccupancy[sizeClass / J9BITS_BITS_IN_SLOT] &= ~((uintptr_t)1 << (sizeClass % J9BITS_BITS_IN_SLOT));
+		}
+	}
+	if (NULL != links->nextInSizeClass) {
+		getSizeClassLinks(links->nextInSizeClass)->previousInSizeClass = links->previousInSizeClass;
+	}
+
+	J9AVLTreeNode *deletedNode = avl_delete(&_bestFitTree, &links->treeNode);
+	Assert_MM_true(&links->treeNode == deletedNode);
+
+	MM_HeapLinkedFreeHeader *nextFreeEntry = freeEntry->getNext(compressed);
+	if (NULL != nextFreeEntry) {
+		getSizeClassLinks(nextFreeEntry)->previousFreeEntry = links->previousFreeEntry;
+	}
+}
+
+/**
+ * @return the lowest size class, not below lowestSizeClass, whose bin is not empty; _sizeClassCount if there is none
+ */
+uintptr_t
+MM_MemoryPoolAddressOrderedList::findOccupiedSizeClass(uintptr_t lowestSizeClass)
+{
+	uintptr_t wordIndex = lowestSizeClass / J9BITS_BITS_IN_SLOT;
+	uintptr_t occupancyWords = (_sizeClassCount + J9BITS_BITS_IN_SLOT - 1) / J9BITS_BITS_IN_SLOT;
+
+	if (wordIndex < occupancyWords) {
+		/* mask off the size classes below lowestSizeClass in the first word */
+		uintptr_t word = _sizeClassOccupancy[wordIndex] & (UDATA_MAX << (lowestSizeClass % J9BITS_BITS_IN_SLOT));
+		while (0 == word) {
+			wordIndex += 1;
+			if (wordIndex == occupancyWords) {
+				return _sizeClassCount;
+			}
+			word = _sizeClassOccupancy[wordIndex];
+		}
+		/* MM_Bits::leadingZeroes() counts from the least significant bit */
+		return (wordIndex * J9BITS_BITS_IN_SLOT) + MM_Bits::leadingZeroes(word);
+	}
+
+	return _sizeClassCount;
+}
+
+/**
+ * Order of the best fit tree: by size, then by address, so that every free entry has a distinct key.
+ */
+intptr_t
+MM_MemoryPoolAddressOrderedList::compareBestFitTreeNodes(J9AVLTree *tree, J9AVLTreeNode *insertNode, J9AVLTreeNode *walkNode)
+{
+	MM_FreeEntrySizeClassLinks *insertLinks = getSizeClassLinksForTreeNode(insertNode);
+	MM_FreeEntrySizeClassLinks *walkLinks = getSizeClassLinksForTreeNode(walkNode);
+
+	if (insertLinks->indexedSize != walkLinks->indexedSize) {
+		return (insertLinks->indexedSize < walkLinks->indexedSize) ? -1 : 1;
+	} else if (insertNode != walkNode) {
+		return ((uintptr_t)insertNode < (uintptr_t)walkNode) ? -1 : 1;
+	}
+	return 0;
+}
+
+/**
+ * Find the smallest free entry of at least sizeRequired bytes (the lowest addressed one, among entries of that size).
+ * @param[out] visitCount number of tree nodes examined
+ * @return the entry, or NULL if every free entry is smaller than sizeRequired
+ */
+MM_HeapLinkedFreeHeader *
+MM_MemoryPoolAddressOrderedList::findBestFitInTree(uintptr_t sizeRequired, uintptr_t *visitCount)
+{
+	J9AVLTreeNode *bestFitNode = NULL;
+	J9AVLTreeNode *walkNode = AVL_GETNODE(_bestFitTree.rootNode);
+
+	while (NULL != walkNode) {
+		*visitCount += 1;
+		if (getSizeClassLinksForTreeNode(walkNode)->indexedSize >= sizeRequired) {
+			/* large enough: remember it and look for a smaller one */
+			bestFitNode = walkNode;
+			walkNode = J9AVLTREENODE_LEFTCHILD(walkNode);
+		} else {
+			walkNode = J9AVLTREENODE_RIGHTCHILD(walkNode);
+		}
+	}
+
+	if (NULL == bestFitNode) {
+		return NULL;
+	}
+	return ((MM_HeapLinkedFreeHeader *)getSizeClassLinksForTreeNode(bestFitNode)) - 1;
+}
+
+/**
+ * Find a free entry of at least sizeRequired bytes in the size class index.
+ * Every entry in a size class above that of sizeRequired is large enough, so the first entry of the
+ * lowest such non-empty bin is taken. Only if there is none, and only if searchRequestedSizeClass is set,
+ * is the requested size class itself searched: its entries may be smaller than sizeRequired, so the
+ * smallest fitting entry is taken from the tree rather than by walking the bin.
+ * Best fit pools always take the smallest entry that fits, whatever its size class.
+ *
+ * @param[out] previousFreeEntry address ordered predecessor of the returned entry
+ * @return a free entry of at least sizeRequired bytes, or NULL if the index holds none
+ */
+MM_HeapLinkedFreeHeader *
+MM_MemoryPoolAddressOrderedList::findInSizeClassIndex(uintptr_t sizeRequired, bool searchRequestedSizeClass, MM_HeapLinkedFreeHeader **previousFreeEntry)
+{
+	MM_HeapLinkedFreeHeader *freeEntry = NULL;
+	uintptr_t scanCount = 0;
+
+	if (_bestFitIndexEnabled) {
+		freeEntry = findBestFitInTree(sizeRequired, &scanCount);
+	} else if (sizeRequired <= _sizeClassIndexMaximumSize) {
+		uintptr_t sizeClass = _largeObjectAllocateStats->getSizeClassIndex(sizeRequired);
+		uintptr_t occupiedSizeClass = findOccupiedSizeClass(sizeClass + 1);
+		if (occupiedSizeClass < _sizeClassCount) {
+			freeEntry = _sizeClassBins[occupiedSizeClass];
+		} else if (searchRequestedSizeClass && (NULL != _sizeClassBins[sizeClass])) {
+			/* no higher class is occupied, so any entry the tree finds is in the requested class */
+			freeEntry = findBestFitInTree(sizeRequired, &scanCount);
+		}
+	}
+
+	_largeObjectAllocateStats->getFreeEntrySizeClassStats()->recordIndexLookup(NULL != freeEntry, scanCount);
+
+	if (NULL != freeEntry) {
+		*previousFreeEntry = getSizeClassLinks(freeEntry)->previousFreeEntry;
+	}
+
+	return freeEntry;
+}
+
+/****************************************
+ * NUMA Slice Functionality
+ ****************************************
+ */
+void
+MM_MemoryPoolAddressOrderedList::resetNUMASlices(MM_EnvironmentBase *env)
+{
+	_numaSliceCount = 0;
+}
+
+void
+MM_MemoryPoolAddressOrderedList::addNUMASlice(MM_EnvironmentBase *env, uintptr_t j9NodeNumber, void *lowAddress, void *highAddress)
+{
+	if (_numaSliceCount < _numaSliceCapacity) {
+		Assert_MM_true((0 == _numaSliceCount) || (_numaSlices[_numaSliceCount - 1].highAddress <= lowAddress));
+		MM_NUMASlice *slice = &_numaSlices[_numaSliceCount];
+		slice->lowAddress = lowAddress;
+		slice->highAddress = highAddress;
+		slice->j9NodeNumber = j9NodeNumber;
+		slice->cursor = NULL;
+		_numaSliceCount += 1;
+	}
+}
+
+/**
+ * Find the first free entry extending into the slice of the NUMA node the thread is bound to.
+ * The search resumes from where the previous search for the slice stopped, so the entries below
+ * the slice are walked once per free list rebuild rather than once per TLH refresh.
+ *
+ * @param[out] previousFreeEntry address ordered predecessor of the returned entry (NULL for the head of the list)
+ * @return the free entry, or NULL if the thread has no slice or its slice has no free memory left
+ */
+MM_HeapLinkedFreeHeader *
+MM_MemoryPoolAddressOrderedList::findInNUMASlice(MM_EnvironmentBase *env, MM_HeapLinkedFreeHeader **previousFreeEntry)
+{
+	bool const compressed = compressObjectReferences();
+	uintptr_t j9NodeNumber = env->getCachedNumaAffinity();
+	MM_NUMASlice *slice = NULL;
+
+	if (0 != j9NodeNumber) {
+		for (uintptr_t i = 0; i < _numaSliceCount; i++) {
+			if (j9NodeNumber == _numaSlices[i].j9NodeNumber) {
+				slice = &_numaSlices[i];
+				break;
+			}
+		}
+	}
+
+	if (NULL == slice) {
+		return NULL;
+	}
+
+	MM_HeapLinkedFreeHeader *previous = slice->cursor;
+	MM_HeapLinkedFreeHeader *current = (NULL == previous) ? _heapFreeList : previous->getNext(compressed);
+	while ((NULL != current) && ((void *)current->afterEnd() <= slice->lowAddress)) {
+		previous = current;
+		current = current->getNext(compressed);
+	}
+	slice->cursor = previous;
+
+	if ((NULL == current) || ((void *)current >= slice->highAddress)) {
+		return NULL;
+	}
+
+	if ((void *)current < slice->lowAddress) {
+		/* The entry straddles the base of the slice (typically the free tail of a semi space spanning all slices).
+		 * Split it there, so the TLH is carved from memory of the slice rather than from the bottom of the entry.
+		 */
+		uintptr_t lowSize = (uintptr_t)slice->lowAddress - (uintptr_t)current;
+		uintptr_t highSize = current->getSize() - lowSize;
+		if ((lowSize >= _minimumFreeEntrySize) && (highSize >= _minimumFreeEntrySize)) {
+			MM_HeapLinkedFreeHeader *highEntry = (MM_HeapLinkedFreeHeader *)slice->lowAddress;
+			if (_sizeClassIndexValid) {
+				removeFromSizeClassIndex(current);
+			}
+			_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(current->getSize());
+			internalRecycleHeapChunk(highEntry, (void *)current->afterEnd(), current->getNext(compressed));
+			current->setSize(lowSize);
+			current->setNext(highEntry, compressed);
+			_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(lowSize);
+			_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(highSize);
+			_freeEntryCount += 1;
+			if (_sizeClassIndexValid) {
+				addToSizeClassIndex(current, previous);
+				addToSizeClassIndex(highEntry, current);
+			}
+			if (getLastFreeEntry() == current) {
+				setLastFreeEntry(highEntry);
+			}
+			previous = current;
+			current = highEntry;
+			slice->cursor = previous;
+		}
+	}
+
+	*previousFreeEntry = previous;
+	return current;
+}
+
 /****************************************
  * Allocation
  ****************************************
@@ -448,6 +849,7 @@ MM_MemoryPoolAddressOrderedList::internalAllocate(MM_EnvironmentBase *env, uintp
 	J9ModronAllocateHint *allocateHintUsed;
 	void *addrBase;
 	uintptr_t largestFreeEntry = 0;
+	bool indexed = false;
 	
 	if (lockingRequired) {
 		_heapLock.acquire();
@@ -463,15 +865,24 @@ retry:
 	allocateHintUsed = NULL;
 	candidateHintSize = 0;
 
-	/* Large object - use a hint if it is available */
-	allocateHintUsed = findHint(sizeInBytesRequired);
-	if(allocateHintUsed) {
-		currentFreeEntry = allocateHintUsed->heapFreeHeader;
-		candidateHintSize = allocateHintUsed->size;
+	indexed = useSizeClassIndex(env);
+	if (indexed) {
+		currentFreeEntry = findInSizeClassIndex(sizeInBytesRequired, true, &previousFreeEntry);
+		if (NULL == currentFreeEntry) {
+			/* The index holds no entry this large, so every free entry is smaller than the request */
+			largestFreeEntry = sizeInBytesRequired - 1;
+		}
+	} else {
+		/* Large object - use a hint if it is available */
+		allocateHintUsed = findHint(sizeInBytesRequired);
+		if(allocateHintUsed) {
+			currentFreeEntry = allocateHintUsed->heapFreeHeader;
+			candidateHintSize = allocateHintUsed->size;
+		}
 	}
 
 
-	while(currentFreeEntry) {
+	while((!indexed) && (NULL != currentFreeEntry)) {
 		if (doesNeedCardAlignment(env, currentFreeEntry)) {
 			currentFreeEntry = doFreeEntryCardAlignmentUpTo(env, currentFreeEntry);
 			if (NULL == currentFreeEntry) {
@@ -531,10 +942,19 @@ retry:
 	addrBase = (void *)currentFreeEntry;
 	recycleEntry = (MM_HeapLinkedFreeHeader *)(((uint8_t *)currentFreeEntry) + sizeInBytesRequired);
 
+	if (indexed) {
+		/* The recycled remainder may overlay the index links of the entry, so unlink it first */
+		removeFromSizeClassIndex(currentFreeEntry);
+	}
+
 	if (recycleHeapChunk(recycleEntry, ((uint8_t *)recycleEntry) + recycleEntrySize, previousFreeEntry, currentFreeEntry->getNext(compressed))) {
 		updatePrevCardUnalignedFreeEntry(currentFreeEntry->getNext(compressed), recycleEntry);
 		updateHint(currentFreeEntry, recycleEntry);
+		updateFreeEntryCursors(currentFreeEntry, recycleEntry);
 		_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(recycleEntrySize);
+		if (indexed) {
+			addToSizeClassIndex(recycleEntry, previousFreeEntry);
+		}
 	} else {
 		updatePrevCardUnalignedFreeEntry(currentFreeEntry->getNext(compressed), previousFreeEntry);
 		/* Adjust the free memory size and count */
@@ -546,6 +966,7 @@ retry:
 
 		/* Removed from the free list - Kill the hint if necessary */
 		removeHint(currentFreeEntry);
+		updateFreeEntryCursors(currentFreeEntry, previousFreeEntry);
 	}
 	
 	/* Collector object allocate stats for Survivor are not interesting (_largeObjectCollectorAllocateStats is null for Survivor) */	
@@ -639,8 +1060,16 @@ MM_MemoryPoolAddressOrderedList::internalAllocateTLH(MM_EnvironmentBase *env, ui
 	void *topOfRecycledChunk = NULL;
 	MM_HeapLinkedFreeHeader *entryNext = NULL;
 	MM_HeapLinkedFreeHeader *freeEntry = NULL;
+	MM_HeapLinkedFreeHeader *previousFreeEntry = NULL;
+	MM_HeapLinkedFreeHeader *localFreeEntry = NULL;
 	uintptr_t consumedSize = 0;
 	uintptr_t recycleEntrySize = 0;
+	bool indexed = false;
+
+	if (0 != _numaSliceCount) {
+		/* an unbound thread takes its TLH from the slice of the node it is running on now, looked up outside the lock */
+		env->refreshNumaAffinity();
+	}
 	
 	if (lockingRequired) {
 		_heapLock.acquire();
@@ -648,6 +1077,8 @@ MM_MemoryPoolAddressOrderedList::internalAllocateTLH(MM_EnvironmentBase *env, ui
 
 retry:
 	freeEntry = _heapFreeList;
+	previousFreeEntry = NULL;
+	localFreeEntry = NULL;
 #if defined(OMR_GC_CONCURRENT_SWEEP)
 
 	/* Check if an entry was found */
@@ -672,10 +1103,30 @@ retry:
 		}
 	}
 
+	indexed = useSizeClassIndex(env);
+	if ((0 != _numaSliceCount) && !isAlignmentForParallelGCRequired() && (FREE_ENTRY_END == _firstCardUnalignedFreeEntry)) {
+		/* Prefer memory bound to the node of the thread over the head of the list */
+		localFreeEntry = findInNUMASlice(env, &previousFreeEntry);
+		if (NULL != localFreeEntry) {
+			freeEntry = localFreeEntry;
+		}
+	}
+	if (indexed && (NULL == localFreeEntry) && !isAlignmentForParallelGCRequired()) {
+		/* Prefer an entry that holds a whole TLH over the head of the list (TLHs aligned for parallel GC always come from the head) */
+		MM_HeapLinkedFreeHeader *fittingFreeEntry = findInSizeClassIndex(maximumSizeInBytesRequired, false, &previousFreeEntry);
+		if (NULL != fittingFreeEntry) {
+			freeEntry = fittingFreeEntry;
+		}
+	}
+
 	freeEntrySize = freeEntry->getSize();
 
 	_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(freeEntrySize);
 
+	if (indexed) {
+		removeFromSizeClassIndex(freeEntry);
+	}
+
 	if (0 == (consumedSize = getConsumedSizeForTLH(env, freeEntry, maximumSizeInBytesRequired))) {
 		goto retry;
 	}
@@ -705,9 +1156,16 @@ retry:
 	if (recycleEntrySize > 0) {
 		topOfRecycledChunk = ((uint8_t *)addrTop) + recycleEntrySize;
 		/* Recycle the remaining entry back onto the free list (if applicable) */
-		if (recycleHeapChunk(addrTop, topOfRecycledChunk, NULL, entryNext)) {
+		if (recycleHeapChunk(addrTop, topOfRecycledChunk, previousFreeEntry, entryNext)) {
 			updatePrevCardUnalignedFreeEntry(entryNext, (MM_HeapLinkedFreeHeader *)addrTop);
 			_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(recycleEntrySize);
+			if (indexed) {
+				addToSizeClassIndex((MM_HeapLinkedFreeHeader *)addrTop, previousFreeEntry);
+			}
+			if (NULL != previousFreeEntry) {
+				updateHint(freeEntry, (MM_HeapLinkedFreeHeader *)addrTop);
+			}
+			updateFreeEntryCursors(freeEntry, (MM_HeapLinkedFreeHeader *)addrTop);
 		} else {
 			updatePrevCardUnalignedFreeEntry(entryNext, FREE_ENTRY_END);
 			/* Adjust the free memory size and count */
@@ -715,11 +1173,21 @@ retry:
 			_freeEntryCount -= 1;
 
 			_allocDiscardedBytes += recycleEntrySize;
+			if (NULL != previousFreeEntry) {
+				removeHint(freeEntry);
+			}
+			updateFreeEntryCursors(freeEntry, previousFreeEntry);
 		}
 	} else {
 		updatePrevCardUnalignedFreeEntry(entryNext, FREE_ENTRY_END);
-		/* If not recycling just update the free list pointer to the next free entry */
-		_heapFreeList = entryNext;
+		/* If not recycling just unlink the free entry */
+		if (NULL != previousFreeEntry) {
+			previousFreeEntry->setNext(entryNext, compressed);
+			removeHint(freeEntry);
+		} else {
+			_heapFreeList = entryNext;
+		}
+		updateFreeEntryCursors(freeEntry, previousFreeEntry);
 		/* also update the freeEntryCount as recycleHeapChunk would do this */
 		_freeEntryCount -= 1;
 	}
@@ -759,6 +1227,7 @@ MM_MemoryPoolAddressOrderedList::getConsumedSizeForTLH(MM_EnvironmentBase *env,
 			MM_HeapLinkedFreeHeader *entryNext = freeEntry->getNext(compressed);
 
 			updatePrevCardUnalignedFreeEntry(entryNext, FREE_ENTRY_END);
+			updateFreeEntryCursors(freeEntry, NULL);
 
 			_heapFreeList = entryNext;
 			_freeEntryCount -= 1;
@@ -822,6 +1291,8 @@ MM_MemoryPoolAddressOrderedList::reset(Cause cause)
 	MM_MemoryPool::reset(cause);
 
 	clearHints();
+	invalidateSizeClassIndex();
+	resetFreeEntryCursors();
 	_heapFreeList = (MM_HeapLinkedFreeHeader *)NULL;
 	_scannableBytes = 0;
 	_nonScannableBytes = 0;
@@ -872,6 +1343,10 @@ MM_MemoryPoolAddressOrderedList::rebuildFreeListInRegion(MM_EnvironmentBase *env
 		/* we already did reset, so it's safe to call increment */
 		_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(rangeSize);
 
+		if (_sizeClassIndexEnabled) {
+			rebuildSizeClassIndex(env);
+		}
+
 		TRIGGER_J9HOOK_MM_PRIVATE_REBUILD_FREE_LIST(env->getExtensions()->privateHookInterface, env->getOmrVMThread(), rangeBase, rangeTop);
 	}
 	unlock(env);
@@ -923,6 +1398,9 @@ MM_MemoryPoolAddressOrderedList::expandWithRange(MM_EnvironmentBase *env, uintpt
 		return ;
 	}
 
+	/* The size class index is kept current below, the list having been walked anyway to find the insertion point */
+	resetFreeEntryCursors();
+
 	/* Find the free entries in the list the appear before/after the range being added */
 	previousFreeEntry = NULL;
 	nextFreeEntry = _heapFreeList;
@@ -938,12 +1416,20 @@ MM_MemoryPoolAddressOrderedList::expandWithRange(MM_EnvironmentBase *env, uintpt
 	if(canCoalesce) {
 		/* Check if the range can be fused to the tail previous free entry */
 		if(previousFreeEntry && (lowAddress == (void *) (((uintptr_t)previousFreeEntry) + previousFreeEntry->getSize()))) {
+			MM_HeapLinkedFreeHeader *previousPreviousFreeEntry = NULL;
+			if (_sizeClassIndexValid) {
+				previousPreviousFreeEntry = getSizeClassLinks(previousFreeEntry)->previousFreeEntry;
+				removeFromSizeClassIndex(previousFreeEntry);
+			}
 			_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(previousFreeEntry->getSize());
 			previousFreeEntry->expandSize(expandSize);
 
 			/* Update the free list information */
 			_freeMemorySize += expandSize;
 			_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(previousFreeEntry->getSize());
+			if (_sizeClassIndexValid) {
+				addToSizeClassIndex(previousFreeEntry, previousPreviousFreeEntry);
+			}
 
 			assume0(isMemoryPoolValid(env, true));
 			return ;
@@ -953,6 +1439,9 @@ MM_MemoryPoolAddressOrderedList::expandWithRange(MM_EnvironmentBase *env, uintpt
 			MM_HeapLinkedFreeHeader *newFreeEntry = (MM_HeapLinkedFreeHeader *)lowAddress;
 			assume0((NULL == nextFreeEntry->getNext(compressed)) || (newFreeEntry < nextFreeEntry->getNext(compressed)));
 
+			if (_sizeClassIndexValid) {
+				removeFromSizeClassIndex(nextFreeEntry);
+			}
 			_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(nextFreeEntry->getSize());
 
 			newFreeEntry->setNext(nextFreeEntry->getNext(compressed), compressed);
@@ -969,6 +1458,9 @@ MM_MemoryPoolAddressOrderedList::expandWithRange(MM_EnvironmentBase *env, uintpt
 			/* Update the free list information */
 			_freeMemorySize += expandSize;
 			_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(newFreeEntry->getSize());
+			if (_sizeClassIndexValid) {
+				addToSizeClassIndex(newFreeEntry, previousFreeEntry);
+			}
 
 			assume0(isMemoryPoolValid(env, true));
 			return ;
@@ -999,6 +1491,9 @@ MM_MemoryPoolAddressOrderedList::expandWithRange(MM_EnvironmentBase *env, uintpt
 	_freeEntryCount += 1;
 
 	_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(expandSize);
+	if (_sizeClassIndexValid) {
+		addToSizeClassIndex(freeEntry, previousFreeEntry);
+	}
 	
 	if (freeEntry->getSize() > _largestFreeEntry) {
 		_largestFreeEntry = freeEntry->getSize(); 
@@ -1024,11 +1519,16 @@ MM_MemoryPoolAddressOrderedList::contractWithRange(MM_EnvironmentBase *env, uint
 	MM_HeapLinkedFreeHeader *currentFreeEntry, *currentFreeEntryTop, *previousFreeEntry, *nextFreeEntry;
 	uintptr_t totalContractSize;
 	intptr_t contractCount;
+	bool leadingEntryCreated = false;
+	bool trailingEntryCreated = false;
 
 	if(0 == contractSize) {
 		return NULL;
 	}
 
+	/* The size class index is kept current below, the list having been walked anyway to find the entry */
+	resetFreeEntryCursors();
+
 	/* Find the free entry that encompasses the range to contract */
 	/* TODO: Could we use hints to find a better starting address?  Are hints still valid? */
 	previousFreeEntry = NULL;
@@ -1045,6 +1545,9 @@ MM_MemoryPoolAddressOrderedList::contractWithRange(MM_EnvironmentBase *env, uint
 
 	totalContractSize = contractSize;
 	contractCount = 1;
+	if (_sizeClassIndexValid) {
+		removeFromSizeClassIndex(currentFreeEntry);
+	}
 	_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(currentFreeEntry->getSize());
 
 	/* Record the next free entry after the current one which we are going to contract */
@@ -1061,6 +1564,7 @@ MM_MemoryPoolAddressOrderedList::contractWithRange(MM_EnvironmentBase *env, uint
 		if (createFreeEntry(env, highAddress, currentFreeEntryTop, NULL, nextFreeEntry)) {
 			/* The entry is a free list candidate */
 			nextFreeEntry = (MM_HeapLinkedFreeHeader *)highAddress;
+			trailingEntryCreated = true;
 			contractCount--;
 			_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(nextFreeEntry->getSize());
 		} else {
@@ -1074,6 +1578,7 @@ MM_MemoryPoolAddressOrderedList::contractWithRange(MM_EnvironmentBase *env, uint
 	if(currentFreeEntry != (MM_HeapLinkedFreeHeader *)lowAddress) {
 		if (createFreeEntry(env, currentFreeEntry, lowAddress, NULL, nextFreeEntry)) {
 			nextFreeEntry = currentFreeEntry;
+			leadingEntryCreated = true;
 			contractCount--;
 			_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(currentFreeEntry->getSize());
 		} else {
@@ -1091,6 +1596,18 @@ MM_MemoryPoolAddressOrderedList::contractWithRange(MM_EnvironmentBase *env, uint
 		_heapFreeList = nextFreeEntry;
 	}
 
+	/* Index the leading and trailing entries split from the contracted one, now that they are on the list */
+	if (_sizeClassIndexValid) {
+		MM_HeapLinkedFreeHeader *indexPreviousFreeEntry = previousFreeEntry;
+		if (leadingEntryCreated) {
+			addToSizeClassIndex(currentFreeEntry, previousFreeEntry);
+			indexPreviousFreeEntry = currentFreeEntry;
+		}
+		if (trailingEntryCreated) {
+			addToSizeClassIndex((MM_HeapLinkedFreeHeader *)highAddress, indexPreviousFreeEntry);
+		}
+	}
+
 	/* Adjust the free memory data */
 	_freeMemorySize -= totalContractSize;
 	_freeEntryCount -= contractCount;
@@ -1138,12 +1655,19 @@ MM_MemoryPoolAddressOrderedList::addFreeEntries(MM_EnvironmentBase *env,
 		currentFreeEntry = currentFreeEntry->getNext(compressed);
 	}
 
+	/* First entry (and its predecessor) to index once the list is linked in; an entry absorbing the head of the list is re-indexed */
+	MM_HeapLinkedFreeHeader *firstEntryToIndex = freeListHead;
+	MM_HeapLinkedFreeHeader *previousEntryToIndex = previousFreeEntry;
+
 	/* Appending at start of list ? */
 	if (previousFreeEntry == NULL) {
 		assume0(_heapFreeList == NULL || freeListTail < _heapFreeList);
 
 		/* Do we need to coalesce ?*/
 		if ((uint8_t*)freeListTail->afterEnd() == (uint8_t*)_heapFreeList) {
+			if (_sizeClassIndexValid) {
+				removeFromSizeClassIndex(_heapFreeList);
+			}
 			_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(_heapFreeList->getSize());
 			_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(freeListTail->getSize());
 			freeListTail->expandSize(_heapFreeList->getSize());
@@ -1162,6 +1686,11 @@ MM_MemoryPoolAddressOrderedList::addFreeEntries(MM_EnvironmentBase *env,
 		freeListTail->setNext(previousFreeEntry->getNext(compressed), compressed);
 		/* Do we need to coalesce ?*/
 		if ((uint8_t*)previousFreeEntry->afterEnd() == (uint8_t*)freeListHead) {
+			if (_sizeClassIndexValid) {
+				previousEntryToIndex = getSizeClassLinks(previousFreeEntry)->previousFreeEntry;
+				removeFromSizeClassIndex(previousFreeEntry);
+			}
+			firstEntryToIndex = previousFreeEntry;
 			_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(freeListHead->getSize());
 			_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(previousFreeEntry->getSize());
 			previousFreeEntry->expandSize(freeListHead->getSize());
@@ -1175,6 +1704,20 @@ MM_MemoryPoolAddressOrderedList::addFreeEntries(MM_EnvironmentBase *env,
 		}
 	}
 
+	if (_sizeClassIndexValid) {
+		/* Index the added entries; the last one to be added records itself as the predecessor of the entry following the added range */
+		MM_HeapLinkedFreeHeader *entryToIndex = firstEntryToIndex;
+		MM_HeapLinkedFreeHeader *lastEntryToIndex = freeListTail->getNext(compressed);
+		while (entryToIndex != lastEntryToIndex) {
+			addToSizeClassIndex(entryToIndex, previousEntryToIndex);
+			previousEntryToIndex = entryToIndex;
+			entryToIndex = entryToIndex->getNext(compressed);
+		}
+	}
+
+	/* Entries absorbed into the added ones may be referenced by slice cursors */
+	resetFreeEntryCursors();
+
 	/* Adjust the free memory data */
 	_freeMemorySize += freeListMemorySize;
 	_freeEntryCount += localFreeListMemoryCount;
@@ -1237,6 +1780,9 @@ MM_MemoryPoolAddressOrderedList::removeFreeEntriesWithinRange(MM_EnvironmentBase
 		return false;
 	}
 
+	invalidateSizeClassIndex();
+	resetFreeEntryCursors();
+
 	/* Remember the next free entry after the current one which we are going to consume at least part of */
 	nextFreeEntry = currentFreeEntry->getNext(compressed);
 
@@ -1587,6 +2133,9 @@ MM_MemoryPoolAddressOrderedList::moveHeap(MM_EnvironmentBase *env, void *srcBase
 	bool const compressed = compressObjectReferences();
 	MM_HeapLinkedFreeHeader *currentFreeEntry, *previousFreeEntry;
 
+	invalidateSizeClassIndex();
+	resetFreeEntryCursors();
+
 	previousFreeEntry = NULL;
 	currentFreeEntry = _heapFreeList;
 	while(currentFreeEntry) {
@@ -1665,6 +2214,9 @@ MM_MemoryPoolAddressOrderedList::recycleHeapChunk(MM_EnvironmentBase *env, void
 			next = nextFreeEntry;
 			freeEntryCount -= 1;
 			_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(currentFreeEntry->getSize());
+			if (_sizeClassIndexValid) {
+				removeFromSizeClassIndex(currentFreeEntry);
+			}
 		} else {
 			next = currentFreeEntry;
 		}
@@ -1674,6 +2226,9 @@ MM_MemoryPoolAddressOrderedList::recycleHeapChunk(MM_EnvironmentBase *env, void
 			prev = previousFreeEntry;
 			freeEntryCount -= 1;
 			_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(currentFreeEntry->getSize());
+			if (_sizeClassIndexValid) {
+				removeFromSizeClassIndex(currentFreeEntry);
+			}
 		} else {
 			prev = currentFreeEntry;
 		}
@@ -1683,6 +2238,9 @@ MM_MemoryPoolAddressOrderedList::recycleHeapChunk(MM_EnvironmentBase *env, void
 			next = nextFreeEntry->getNext(compressed);
 			freeEntryCount -= 1;
 			_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(nextFreeEntry->getSize());
+			if (_sizeClassIndexValid) {
+				removeFromSizeClassIndex(nextFreeEntry);
+			}
 		} else {
 			next = nextFreeEntry;
 		}
@@ -1690,10 +2248,15 @@ MM_MemoryPoolAddressOrderedList::recycleHeapChunk(MM_EnvironmentBase *env, void
 
 	recycled = recycleHeapChunk(base, top, prev, next);
 	Assert_MM_true(recycled);
+	if (_sizeClassIndexValid) {
+		addToSizeClassIndex((MM_HeapLinkedFreeHeader *)base, prev);
+	}
 	if ((NULL == prev) || (chunkTop != top)) {
 		/* inserted freeEntry before _heapFreeList, it might confuse the checking for staled Hint, so clear hints for avoiding the cases.  */
 		clearHints();
 	}
+	/* a free entry coalesced with the chunk may be referenced by slice cursors */
+	resetFreeEntryCursors();
 
 	_largeObjectAllocateStats->incrementFreeEntrySizeClassStats((uintptr_t)top - (uintptr_t)base);
 	_freeMemorySize += (uintptr_t)chunkTop - (uintptr_t)chunkBase;
@@ -1843,11 +2406,41 @@ MM_MemoryPoolAddressOrderedList::releaseFreeMemoryPages(MM_EnvironmentBase* env)
 {
 	uintptr_t releasedBytes = 0;
 	_heapLock.acquire();
+	/* decommitted pages may include the index links of free entries */
+	invalidateSizeClassIndex();
+	resetFreeEntryCursors();
 	releasedBytes = releaseFreeEntryMemoryPages(env, _heapFreeList);
 	_heapLock.release();
 	return releasedBytes;
 }
 
+#if defined(OMR_GC_MODRON_STANDARD)
+bool
+MM_MemoryPoolAddressOrderedList::uncommitFreeMemoryPages(MM_EnvironmentBase* env, MM_HeapUncommitService *service)
+{
+	bool const compressed = compressObjectReferences();
+	/* The index links follow the header of an entry and stay committed, so the index and the NUMA cursors survive the walk */
+	uintptr_t committedHeaderSize = sizeof(MM_HeapLinkedFreeHeader) + sizeof(MM_FreeEntrySizeClassLinks);
+	void *resumeAddress = NULL;
+	bool started = false;
+	bool complete = false;
+	do {
+		_heapLock.acquire();
+		MM_HeapLinkedFreeHeader *freeEntry = _heapFreeList;
+		if (started && (NULL != _uncommitCursor)) {
+			/* Allocations since the last batch kept the cursor on a free entry at or below the resume address */
+			freeEntry = _uncommitCursor->getNext(compressed);
+		}
+		_uncommitCursor = service->uncommitFreeEntries(env, freeEntry, committedHeaderSize, &resumeAddress);
+		complete = (NULL == _uncommitCursor);
+		started = true;
+		_heapLock.release();
+	} while (!complete && !service->shouldYield(env));
+
+	return complete;
+}
+#endif /* defined(OMR_GC_MODRON_STANDARD) */
+
 MM_HeapLinkedFreeHeader *
 MM_MemoryPoolAddressOrderedList::doFreeEntryCardAlignmentUpTo(MM_EnvironmentBase *env, MM_HeapLinkedFreeHeader *lastFreeEntryToAlign)
 {
@@ -1858,6 +2451,9 @@ MM_MemoryPoolAddressOrderedList::doFreeEntryCardAlignmentUpTo(MM_EnvironmentBase
 
 	uintptr_t lostToAlignment = 0;
 
+	invalidateSizeClassIndex();
+	resetFreeEntryCursors();
+
 	uintptr_t freeBytes = _freeMemorySize;
 	uintptr_t freeEntryCount = _freeEntryCount;
 	while ((currentFreeEntry <= lastFreeEntryToAlign) && (NULL != currentFreeEntry)) {
@@ -26,6 +26,7 @@
 #include "omrcfg.h"
 #include "omrcomp.h"
 #include "modronopt.h"
+#include "avl_api.h"
 
 #include "HeapLinkedFreeHeader.hpp"
 #include "LightweightNonReentrantLock.hpp"
@@ -41,6 +42,30 @@ class MM_ConcurrentSweepScheme;
 
 #define FREE_ENTRY_END ((MM_HeapLinkedFreeHeader *)OMRPORT_VMEM_MAX_ADDRESS)
 
+/**
+ * Size class index bookkeeping for a free entry. Stored in the body of each indexed free entry,
+ * immediately after its MM_HeapLinkedFreeHeader (free entries are never smaller than a card).
+ */
+struct MM_FreeEntrySizeClassLinks {
+	MM_HeapLinkedFreeHeader *previousFreeEntry; /**< address ordered predecessor of the entry, NULL for the head of the free list */
+	MM_HeapLinkedFreeHeader *previousInSizeClass; /**< previous entry in the same size class bin */
+	MM_HeapLinkedFreeHeader *nextInSizeClass; /**< next entry in the same size class bin */
+	uintptr_t sizeClass; /**< size class bin the entry is linked into */
+	uintptr_t indexedSize; /**< size of the entry when it was linked into the best fit tree, its key in the tree */
+	J9AVLTreeNode treeNode; /**< node of the entry in the tree of free entries ordered by size */
+};
+
+/**
+ * Range of a pool bound to one NUMA node (see GCExtensionsBase::numaAwareNursery). TLHs for threads
+ * bound to the node are taken from the free entries within the range where possible.
+ */
+struct MM_NUMASlice {
+	void *lowAddress; /**< base of the slice */
+	void *highAddress; /**< top of the slice (exclusive) */
+	uintptr_t j9NodeNumber; /**< node the slice memory is bound to, where 1 is the first node */
+	MM_HeapLinkedFreeHeader *cursor; /**< free entry ending below the slice to start the search for its first free entry from, NULL for the head of the free list */
+};
+
 /**
  * @todo Provide class documentation
  * @ingroup GC_Base_Core
@@ -68,6 +93,23 @@ private:
 
 	void *_parallelGCAlignmentBase; /**< Base address of the region where the pool resides */
 	uintptr_t _parallelGCAlignmentSize; /**<  Fixed Size used to determine boundaries for alignment. */
+
+	/* Size class index support */
+	bool _sizeClassIndexEnabled; /**< true if free entries are indexed by size class (GCExtensionsBase::freeListSizeClassIndex) */
+	bool _sizeClassIndexValid; /**< true if the size class index describes the current free list; otherwise rebuilt at the end of a sweep or on the next allocation */
+	uintptr_t _sizeClassCount; /**< number of size class bins */
+	MM_HeapLinkedFreeHeader **_sizeClassBins; /**< for each size class, list of the free entries in that class */
+	uintptr_t *_sizeClassOccupancy; /**< one bit per size class, set if its bin is not empty */
+	uintptr_t _sizeClassIndexMaximumSize; /**< largest size that can be mapped to a size class */
+	bool _bestFitIndexEnabled; /**< true if allocations take the smallest fitting entry from _bestFitTree rather than the first entry of the lowest fitting size class */
+	J9AVLTree _bestFitTree; /**< free entries of the size class index, ordered by size then address; also searched for entries of the requested size class */
+
+	/* NUMA slice support */
+	MM_NUMASlice *_numaSlices; /**< per node slices of the pool, in address order */
+	uintptr_t _numaSliceCapacity; /**< number of elements allocated for _numaSlices (the NUMA affinity leader count) */
+	uintptr_t _numaSliceCount; /**< number of slices currently set */
+
+	MM_HeapLinkedFreeHeader *_uncommitCursor; /**< last free entry visited by the current batch of the heap uncommit walk, NULL for the head of the free list */
 protected:
 public:
 	
@@ -81,6 +123,74 @@ private:
 	void updateHint(MM_HeapLinkedFreeHeader *oldFreeEntry, MM_HeapLinkedFreeHeader *newFreeEntry);
 	void clearHints();
 	void updateHintsBeyondEntry(MM_HeapLinkedFreeHeader *freeEntry);
+
+	MMINLINE MM_FreeEntrySizeClassLinks *getSizeClassLinks(MM_HeapLinkedFreeHeader *freeEntry)
+	{
+		return (MM_FreeEntrySizeClassLinks *)(freeEntry + 1);
+	}
+
+	/**
+	 * Mark the size class index stale. Called by any free list update that does not maintain the index;
+	 * the index is rebuilt on the next allocation.
+	 */
+	MMINLINE void invalidateSizeClassIndex()
+	{
+		_sizeClassIndexValid = false;
+	}
+
+	/**
+	 * @return true if allocations should be served from the size class index, rebuilding it first if it is stale
+	 */
+	MMINLINE bool useSizeClassIndex(MM_EnvironmentBase *env)
+	{
+		if (_sizeClassIndexEnabled && !_sizeClassIndexValid) {
+			rebuildSizeClassIndex(env);
+		}
+		return _sizeClassIndexValid;
+	}
+
+	void rebuildSizeClassIndex(MM_EnvironmentBase *env);
+	void addToSizeClassIndex(MM_HeapLinkedFreeHeader *freeEntry, MM_HeapLinkedFreeHeader *previousFreeEntry);
+	void removeFromSizeClassIndex(MM_HeapLinkedFreeHeader *freeEntry);
+	uintptr_t findOccupiedSizeClass(uintptr_t lowestSizeClass);
+	MM_HeapLinkedFreeHeader *findBestFitInTree(uintptr_t sizeRequired, uintptr_t *visitCount);
+
+	static MMINLINE MM_FreeEntrySizeClassLinks *getSizeClassLinksForTreeNode(J9AVLTreeNode *treeNode)
+	{
+		return (MM_FreeEntrySizeClassLinks *)((uintptr_t)treeNode - offsetof(MM_FreeEntrySizeClassLinks, treeNode));
+	}
+	static intptr_t compareBestFitTreeNodes(J9AVLTree *tree, J9AVLTreeNode *insertNode, J9AVLTreeNode *walkNode);
+	MM_HeapLinkedFreeHeader *findInSizeClassIndex(uintptr_t sizeRequired, bool searchRequestedSizeClass, MM_HeapLinkedFreeHeader **previousFreeEntry);
+
+	/**
+	 * Forget the search positions of all NUMA slices and of the heap uncommit walk. Called by any free list update that does not maintain them.
+	 */
+	MMINLINE void resetFreeEntryCursors()
+	{
+		for (uintptr_t i = 0; i < _numaSliceCount; i++) {
+			_numaSlices[i].cursor = NULL;
+		}
+		_uncommitCursor = NULL;
+	}
+
+	/**
+	 * Redirect the search positions of NUMA slices and of the heap uncommit walk that refer to a free entry which moved or left the free list.
+	 * @param oldFreeEntry the entry which moved or was removed
+	 * @param newFreeEntry the new location of the entry, or its predecessor (NULL for the head of the list) if it was removed
+	 */
+	MMINLINE void updateFreeEntryCursors(MM_HeapLinkedFreeHeader *oldFreeEntry, MM_HeapLinkedFreeHeader *newFreeEntry)
+	{
+		for (uintptr_t i = 0; i < _numaSliceCount; i++) {
+			if (oldFreeEntry == _numaSlices[i].cursor) {
+				_numaSlices[i].cursor = newFreeEntry;
+			}
+		}
+		if (oldFreeEntry == _uncommitCursor) {
+			_uncommitCursor = newFreeEntry;
+		}
+	}
+
+	MM_HeapLinkedFreeHeader *findInNUMASlice(MM_EnvironmentBase *env, MM_HeapLinkedFreeHeader **previousFreeEntry);
 	void *internalAllocate(MM_EnvironmentBase *env, uintptr_t sizeInBytesRequired, bool lockingRequired, MM_LargeObjectAllocateStats *largeObjectAllocateStats);
 	bool internalAllocateTLH(MM_EnvironmentBase *env, uintptr_t maximumSizeInBytesRequired, void * &addrBase, void * &addrTop, bool lockingRequired, MM_LargeObjectAllocateStats *largeObjectAllocateStats);
 	uintptr_t getConsumedSizeForTLH(MM_EnvironmentBase *env, MM_HeapLinkedFreeHeader *freeEntry, uintptr_t maximumSizeInBytesRequired);
@@ -119,6 +229,11 @@ protected:
 public:
 	static MM_MemoryPoolAddressOrderedList *newInstance(MM_EnvironmentBase *env, uintptr_t minimumFreeEntrySize); 
 	static MM_MemoryPoolAddressOrderedList *newInstance(MM_EnvironmentBase *env, uintptr_t minimumFreeEntrySize, const char *name);
+	/**
+	 * @param bestFitIndex if true, large allocations take the smallest free entry that fits, found in a size ordered tree
+	 * (see GCExtensionsBase::largeObjectAreaBestFit), instead of the first entry of a large enough size class
+	 */
+	static MM_MemoryPoolAddressOrderedList *newInstance(MM_EnvironmentBase *env, uintptr_t minimumFreeEntrySize, const char *name, bool bestFitIndex);
 
 	virtual void lock(MM_EnvironmentBase *env);
 	virtual void unlock(MM_EnvironmentBase *env);
@@ -186,10 +301,18 @@ public:
 	 */
 	virtual void recalculateMemoryPoolStatistics(MM_EnvironmentBase *env);
 
+	virtual void buildFreeListIndex(MM_EnvironmentBase *env);
+
 	virtual uintptr_t releaseFreeMemoryPages(MM_EnvironmentBase* env);
+#if defined(OMR_GC_MODRON_STANDARD)
+	virtual bool uncommitFreeMemoryPages(MM_EnvironmentBase* env, MM_HeapUncommitService *service);
+#endif /* defined(OMR_GC_MODRON_STANDARD) */
 
 	void setParallelGCAlignment(MM_EnvironmentBase *env, bool alignmentEnabled);
 
+	virtual void resetNUMASlices(MM_EnvironmentBase *env);
+	virtual void addNUMASlice(MM_EnvironmentBase *env, uintptr_t j9NodeNumber, void *lowAddress, void *highAddress);
+
 	/**
 	 * remove a free entry from freelist
 	 */
@@ -258,6 +381,17 @@ public:
 		,_prevCardUnalignedFreeEntry(FREE_ENTRY_END)
 		,_parallelGCAlignmentBase(NULL)
 		,_parallelGCAlignmentSize(0)
+		,_sizeClassIndexEnabled(false)
+		,_sizeClassIndexValid(false)
+		,_sizeClassCount(0)
+		,_sizeClassBins(NULL)
+		,_sizeClassOccupancy(NULL)
+		,_sizeClassIndexMaximumSize(0)
+		,_bestFitIndexEnabled(false)
+		,_numaSlices(NULL)
+		,_numaSliceCapacity(0)
+		,_numaSliceCount(0)
+		,_uncommitCursor(NULL)
 	{
 		_typeId = __FUNCTION__;
 	};
@@ -270,6 +404,17 @@ public:
 		,_prevCardUnalignedFreeEntry(FREE_ENTRY_END)
 		,_parallelGCAlignmentBase(NULL)
 		,_parallelGCAlignmentSize(0)
+		,_sizeClassIndexEnabled(false)
+		,_sizeClassIndexValid(false)
+		,_sizeClassCount(0)
+		,_sizeClassBins(NULL)
+		,_sizeClassOccupancy(NULL)
+		,_sizeClassIndexMaximumSize(0)
+		,_bestFitIndexEnabled(false)
+		,_numaSlices(NULL)
+		,_numaSliceCapacity(0)
+		,_numaSliceCount(0)
+		,_uncommitCursor(NULL)
 	{
 		_typeId = __FUNCTION__;
 	};
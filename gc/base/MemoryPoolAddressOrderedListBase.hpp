@@ -98,6 +98,12 @@ protected:
 	 * get the address of the last free entry in the pool
 	 */
 	virtual MM_HeapLinkedFreeHeader *getLastFreeEntry() { return _lastFreeEntry; }
+
+	/**
+	 * Build any index the pool keeps over its free list, once a collection has finished connecting the free list,
+	 * so that the first allocation after the collection does not build it under the pool lock.
+	 */
+	virtual void buildFreeListIndex(MM_EnvironmentBase *env) {}
 	
 #if defined(OMR_GC_LARGE_OBJECT_AREA)
 	/**
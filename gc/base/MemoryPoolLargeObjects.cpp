@@ -357,26 +357,46 @@ MM_MemoryPoolLargeObjects::calculateTargetLOARatio(MM_EnvironmentBase* env, uint
 	_minLOAFreeRatio = *std::min_element(_loaFreeRatioHistory, _loaFreeRatioHistory + _extensions->loaFreeHistorySize);
 
 	Assert_GC_true_with_message(env, ((0 <= _minLOAFreeRatio) && (1.0 >= _minLOAFreeRatio)), "minLOAFreeRatio(%zu) should be between 0 and 1.0.", _minLOAFreeRatio);
+
+	/* The last fragmentation estimate tells how much of the free memory large allocations could not use.
+	 * A fragmented heap is a reason to grow the LOA on a failed large allocation even while the LOA
+	 * itself still looks free enough, and never a time to give LOA memory back to the SOA.
+	 */
+	double fragmentedRatio = 0.0;
+	uintptr_t freeMemoryBeforeEstimate = _largeObjectAllocateStats->getFreeMemoryBeforeEstimate();
+	if (0 != freeMemoryBeforeEstimate) {
+		fragmentedRatio = (double)_largeObjectAllocateStats->getRemainingFreeMemoryAfterEstimate() / (double)freeMemoryBeforeEstimate;
+	}
+	bool fragmented = (fragmentedRatio > _extensions->largeObjectAreaFragmentationThreshold);
+	Trc_MM_LOAResize_calculateTargetLOARatio_fragmentation(env->getLanguageVMThread(), fragmentedRatio, _extensions->largeObjectAreaFragmentationThreshold, _minLOAFreeRatio);
+
 	/* If we have had an allocation failure in the LOA then we need to consider
 	 * whether its time we expanded the LOA
 	 */
 	if (allocSize >= _extensions->largeObjectMinimumSize) {
 		/* If the allocation size is 1/5 times greater than current LOA size..expand LOA */
+		LoaResizeReason expandReason = LOA_EXPAND_FAILED_ALLOCATE;
 		if (allocSize > _loaSize / LOA_EXPAND_TRGGER3) {
 			if (_currentLOARatio < _extensions->largeObjectAreaMaximumRatio) {
 				newLOARatio += LOA_RESIZE_AMOUNT_NORMAL;
 			}
 		} else if (_currentLOARatio >= _extensions->largeObjectAreaInitialRatio) {
-			if (_minLOAFreeRatio < LOA_EXPAND_TRIGGER1) {
+			if ((_minLOAFreeRatio < LOA_EXPAND_TRIGGER1) || fragmented) {
 				if (_currentLOARatio < _extensions->largeObjectAreaMaximumRatio) {
 					newLOARatio += LOA_RESIZE_AMOUNT_NORMAL;
+					if (_minLOAFreeRatio >= LOA_EXPAND_TRIGGER1) {
+						expandReason = LOA_EXPAND_FRAGMENTED;
+					}
 				}
 			}
 		} else {
 			/* currentLOARatio < _extensions->largeObjectAreaInitialRatio */
-			if (_minLOAFreeRatio < LOA_EXPAND_TRIGGER2) {
+			if ((_minLOAFreeRatio < LOA_EXPAND_TRIGGER2) || fragmented) {
 				assume0(_extensions->largeObjectAreaInitialRatio <= _extensions->largeObjectAreaMaximumRatio);
 				newLOARatio += LOA_RESIZE_AMOUNT_NORMAL;
+				if (_minLOAFreeRatio >= LOA_EXPAND_TRIGGER2) {
+					expandReason = LOA_EXPAND_FRAGMENTED;
+				}
 			}
 		}
 		/* Belt and braces check. Because _currentLOARatio is a float we need to check that
@@ -387,9 +407,9 @@ MM_MemoryPoolLargeObjects::calculateTargetLOARatio(MM_EnvironmentBase* env, uint
 		}
 
 		if (_currentLOARatio != newLOARatio) {
-			_extensions->heap->getResizeStats()->setLastLoaResizeReason(LOA_EXPAND_FAILED_ALLOCATE);
+			_extensions->heap->getResizeStats()->setLastLoaResizeReason(expandReason);
 		}
-	} else if (_minLOAFreeRatio > maxLOAFreeRatio) {
+	} else if ((_minLOAFreeRatio > maxLOAFreeRatio) && !fragmented) {
 		if (_currentLOARatio >= _extensions->largeObjectAreaMinimumRatio) {
 			newLOARatio -= LOA_RESIZE_AMOUNT_NORMAL;
 			/* Ensure we do not contract below minimum */
@@ -40,6 +40,7 @@
 #include "HeapRegionDescriptor.hpp"
 #include "HeapRegionManager.hpp"
 #include "HeapLinkedFreeHeader.hpp"
+#include "HeapUncommitService.hpp"
 #include "LargeObjectAllocateStats.hpp"
 #include "ParallelSweepChunk.hpp"
 #include "SweepHeapSectioning.hpp"
@@ -257,6 +258,7 @@ skipSearch:
 			_previousReservedFreeEntry = recycleEntry;
 		}
 		_heapFreeLists[curFreeList].updateHint(currentFreeEntry, recycleEntry);
+		updateUncommitCursor(currentFreeEntry, recycleEntry);
 		_largeObjectAllocateStatsForFreeList[curFreeList].incrementFreeEntrySizeClassStats(recycleEntrySize);
 	} else {
 		if (!skipReserved && isPreviousReservedFreeEntry(previousFreeEntry, curFreeList)) {
@@ -277,6 +279,7 @@ skipSearch:
 
 		/* Removed from the free list - Kill the hint if necessary */
 		_heapFreeLists[curFreeList].removeHint(currentFreeEntry);
+		updateUncommitCursor(currentFreeEntry, previousFreeEntry);
 	}
 
 	/* Was our initial or suggested freelist empty? If not, go back and use it more. */
@@ -449,6 +452,7 @@ skipSearch:
 		}
 		_allocDiscardedBytes += recycleEntrySize;
 		_heapFreeLists[curFreeList].removeHint(freeEntry);
+		updateUncommitCursor(freeEntry, previousFreeEntry);
 	} else {
 		if (!skipReserved && isPreviousReservedFreeEntry(previousFreeEntry, curFreeList)) {
 			_reservedFreeEntrySize = recycleEntrySize;
@@ -457,6 +461,7 @@ skipSearch:
 			_previousReservedFreeEntry = (MM_HeapLinkedFreeHeader*) addrTop;
 		}
 		_heapFreeLists[curFreeList].updateHint(freeEntry, (MM_HeapLinkedFreeHeader*)addrTop);
+		updateUncommitCursor(freeEntry, (MM_HeapLinkedFreeHeader*)addrTop);
 		_largeObjectAllocateStatsForFreeList[curFreeList].incrementFreeEntrySizeClassStats(recycleEntrySize);
 	}
 
@@ -1311,6 +1316,33 @@ MM_MemoryPoolSplitAddressOrderedList::releaseFreeMemoryPages(MM_EnvironmentBase*
 	return releasedMemory;
 }
 
+#if defined(OMR_GC_MODRON_STANDARD)
+bool
+MM_MemoryPoolSplitAddressOrderedList::uncommitFreeMemoryPages(MM_EnvironmentBase* env, MM_HeapUncommitService *service)
+{
+	bool const compressed = compressObjectReferences();
+	bool complete = true;
+	for (uintptr_t i = 0; complete && (i < _heapFreeListCount); i++) {
+		void *resumeAddress = NULL;
+		bool started = false;
+		do {
+			_heapFreeLists[i]._lock.acquire();
+			_heapFreeLists[i]._timesLocked += 1;
+			MM_HeapLinkedFreeHeader* freeEntry = _heapFreeLists[i]._freeList;
+			if (started && (NULL != _uncommitCursor)) {
+				/* Allocations since the last batch kept the cursor on a free entry at or below the resume address */
+				freeEntry = _uncommitCursor->getNext(compressed);
+			}
+			_uncommitCursor = service->uncommitFreeEntries(env, freeEntry, sizeof(MM_HeapLinkedFreeHeader), &resumeAddress);
+			complete = (NULL == _uncommitCursor);
+			started = true;
+			_heapFreeLists[i]._lock.release();
+		} while (!complete && !service->shouldYield(env));
+	}
+	return complete;
+}
+#endif /* defined(OMR_GC_MODRON_STANDARD) */
+
 #if defined(J9VM_OPT_CRIU_SUPPORT)
 bool
 MM_MemoryPoolSplitAddressOrderedList::reinitializeForRestore(MM_EnvironmentBase *env)
@@ -53,6 +53,7 @@ private:
   	MM_HeapLinkedFreeHeader* _previousReservedFreeEntry;	/**< combination _previousReservedFreeEntry and _reservedFreeListIndex are used to identify or update the reservedFreeEntry */
  	uintptr_t _reservedFreeListIndex;		/**< the reservedFreeEntry is initialized only once in first pass iterating after sweep, used/updated only in second pass */
 	bool _reservedFreeEntryAvaliable;	/**< True if the reserved Free Entry can be used */
+	MM_HeapLinkedFreeHeader* _uncommitCursor;	/**< last free entry visited by the current batch of the heap uncommit walk, NULL for the head of the free list being walked */
 protected:
 public:
 	/*
@@ -146,6 +147,18 @@ private:
 	}
 
 	/* helpers for maintaining reserved free entry - end */
+
+	/**
+	 * Redirect the position of the heap uncommit walk if it refers to a free entry which moved or left the free list.
+	 * @param[in] oldFreeEntry the entry which moved or was removed
+	 * @param[in] newFreeEntry the new location of the entry, or its predecessor (NULL for the head of the list) if it was removed
+	 */
+	MMINLINE void updateUncommitCursor(MM_HeapLinkedFreeHeader* oldFreeEntry, MM_HeapLinkedFreeHeader* newFreeEntry)
+	{
+		if (oldFreeEntry == _uncommitCursor) {
+			_uncommitCursor = newFreeEntry;
+		}
+	}
 	
 protected:
 	virtual void *internalAllocate(MM_EnvironmentBase *env, uintptr_t sizeInBytesRequired, bool lockingRequired, MM_LargeObjectAllocateStats *largeObjectAllocateStats);
@@ -169,6 +182,9 @@ public:
 	virtual void* contractWithRange(MM_EnvironmentBase* env, uintptr_t contractSize, void* lowAddress, void* highAddress);
 
 	virtual uintptr_t releaseFreeMemoryPages(MM_EnvironmentBase* env);
+#if defined(OMR_GC_MODRON_STANDARD)
+	virtual bool uncommitFreeMemoryPages(MM_EnvironmentBase* env, MM_HeapUncommitService *service);
+#endif /* defined(OMR_GC_MODRON_STANDARD) */
 
 #if defined(J9VM_OPT_CRIU_SUPPORT)
 	/**
@@ -189,6 +205,7 @@ public:
 		, _previousReservedFreeEntry((MM_HeapLinkedFreeHeader*) UDATA_MAX)
 		, _reservedFreeListIndex(splitAmount)
 		, _reservedFreeEntryAvaliable(false)
+		, _uncommitCursor(NULL)
 	{
 		_typeId = __FUNCTION__;
 	};
@@ -199,6 +216,7 @@ public:
 		, _previousReservedFreeEntry((MM_HeapLinkedFreeHeader*)UDATA_MAX)
 		, _reservedFreeListIndex(splitAmount)
 		, _reservedFreeEntryAvaliable(false)
+		, _uncommitCursor(NULL)
 	{
 		_typeId = __FUNCTION__;
 	};
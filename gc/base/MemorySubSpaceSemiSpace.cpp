@@ -29,8 +29,10 @@
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
 #include "Heap.hpp"
+#include "HeapVirtualMemory.hpp"
 #include "HeapRegionManager.hpp"
 #include "LargeObjectAllocateStats.hpp"
+#include "MemoryManager.hpp"
 #include "MemoryPool.hpp"
 #include "MemorySpace.hpp"
 #include "MemorySubSpace.hpp"
@@ -665,6 +667,71 @@ MM_MemorySubSpaceSemiSpace::mainTeardownForSuccessfulGC(MM_EnvironmentBase *env)
 	/* Adjust memory between the semi spaces where applicable */
 	checkResize(env);
 	performResize(env);
+
+	if (_extensions->numaAwareNursery) {
+		/* Both semi spaces may have been flipped, tilted or resized */
+		sliceForNUMA(env, _memorySubSpaceAllocate);
+		sliceForNUMA(env, _memorySubSpaceSurvivor);
+	}
+}
+
+/**
+ * Split the range of a semi space into one slice per NUMA affinity leader and record the slices in its memory pool,
+ * so TLH refreshes of mutators (allocate space) and copy caches of GC threads (survivor space) come from their local node.
+ * With physical NUMA enabled, the memory of each slice is bound to its node; pages already touched stay where they are.
+ * The slices of a semi space are only bound again when tilting or resizing has moved its range since they were last bound.
+ */
+void
+MM_MemorySubSpaceSemiSpace::sliceForNUMA(MM_EnvironmentBase *env, MM_MemorySubSpace *subSpace)
+{
+	MM_MemoryPool *memoryPool = subSpace->getMemoryPool();
+	uintptr_t affinityLeaderCount = 0;
+	J9MemoryNodeDetail const *affinityLeaders = _extensions->_numaManager.getAffinityLeaders(&affinityLeaderCount);
+
+	memoryPool->resetNUMASlices(env);
+
+	if (affinityLeaderCount > 1) {
+		void *base = NULL;
+		void *top = NULL;
+		cacheRanges(subSpace, &base, &top);
+
+		uintptr_t pageSize = _extensions->heap->getPageSize();
+		uintptr_t sliceSize = MM_Math::roundToFloor(pageSize, ((uintptr_t)top - (uintptr_t)base) / affinityLeaderCount);
+		if (0 != sliceSize) {
+			bool bindMemory = _extensions->_numaManager.isPhysicalNUMAEnabled();
+			if (bindMemory) {
+				uintptr_t boundIndex = (subSpace == _numaBoundSubSpaces[1]) ? 1 : 0;
+				if ((subSpace != _numaBoundSubSpaces[boundIndex]) && (NULL != _numaBoundSubSpaces[0])) {
+					boundIndex = 1;
+				}
+				if ((subSpace == _numaBoundSubSpaces[boundIndex]) && (base == _numaBoundBases[boundIndex]) && (top == _numaBoundTops[boundIndex])) {
+					/* the slices are unchanged and still bound */
+					bindMemory = false;
+				} else {
+					_numaBoundSubSpaces[boundIndex] = subSpace;
+					_numaBoundBases[boundIndex] = base;
+					_numaBoundTops[boundIndex] = top;
+				}
+			}
+			uintptr_t sliceBase = (uintptr_t)base;
+			for (uintptr_t i = 0; i < affinityLeaderCount; i++) {
+				uintptr_t sliceTop = ((affinityLeaderCount - 1) == i) ? (uintptr_t)top : (sliceBase + sliceSize);
+				uintptr_t j9NodeNumber = affinityLeaders[i].j9NodeNumber;
+				bool bound = false;
+				if (bindMemory) {
+					/* only whole pages can be bound */
+					uintptr_t bindBase = MM_Math::roundToCeiling(pageSize, sliceBase);
+					uintptr_t bindTop = MM_Math::roundToFloor(pageSize, sliceTop);
+					if (bindBase < bindTop) {
+						bound = _extensions->memoryManager->setNumaAffinity(((MM_HeapVirtualMemory *)_extensions->heap)->getVmemHandle(), j9NodeNumber, (void *)bindBase, bindTop - bindBase);
+					}
+				}
+				Trc_MM_MSSSS_sliceForNUMA(env->getLanguageVMThread(), subSpace, sliceBase, sliceTop, j9NodeNumber, bound ? "true" : "false");
+				memoryPool->addNUMASlice(env, j9NodeNumber, (void *)sliceBase, (void *)sliceTop);
+				sliceBase = sliceTop;
+			}
+		}
+	}
 }
 
 
@@ -774,6 +841,14 @@ MM_MemorySubSpaceSemiSpace::checkSubSpaceMemoryPostCollectTilt(MM_EnvironmentBas
 		double survivorSizeAmplification = 1.04 + extensions->dispatcher->threadCount() / 100.0;
 		double desiredSurvivorSize = (_tiltedAverageBytesFlipped + _tiltedAverageBytesFlippedDelta) * survivorSizeAmplification;
 
+		if ((0 != extensions->scavengerPauseTarget) && _nurserySizingModel.isReady()) {
+			/* Size for the predicted peak of bytes flipped rather than for the recent average */
+			desiredSurvivorSize = _nurserySizingModel.calculateSurvivorSpaceRatio(env, currentSize) * currentSize;
+			if (debug) {
+				omrtty_printf("\tnursery sizing model survivor size: %zu\n", (uintptr_t)desiredSurvivorSize);
+			}
+		}
+
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 		if (_extensions->isConcurrentScavengerEnabled()) {
 			/* Account for mutator allocated objects in hybrid survivor/allocated during concurrent phase of Concurrent Scavenger */
@@ -833,7 +908,9 @@ MM_MemorySubSpaceSemiSpace::checkSubSpaceMemoryPostCollectResize(MM_EnvironmentB
 	uintptr_t regionSize = extensions->getHeap()->getHeapRegionManager()->getRegionSize();
 	MM_Scavenger *scavenger = (MM_Scavenger *)_collector;
 
-	if (extensions->dynamicNewSpaceSizing) {
+	if (extensions->dynamicNewSpaceSizing && (0 != extensions->scavengerPauseTarget) && _nurserySizingModel.isReady()) {
+		checkSubSpaceMemoryPostCollectResizeFromModel(env);
+	} else if (extensions->dynamicNewSpaceSizing) {
 		bool doDynamicNewSpaceSizing = true;
 		bool debug = extensions->debugDynamicNewSpaceSizing;
 		OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
@@ -1017,6 +1094,45 @@ MM_MemorySubSpaceSemiSpace::checkSubSpaceMemoryPostCollectResize(MM_EnvironmentB
 	}
 }
 
+/**
+ * Resize the sub space to the size chosen by the nursery sizing model, moving at most by the
+ * dynamic new space sizing maximum expansion and contraction factors per scavenge.
+ */
+void
+MM_MemorySubSpaceSemiSpace::checkSubSpaceMemoryPostCollectResizeFromModel(MM_EnvironmentBase *env)
+{
+	MM_GCExtensionsBase *extensions = MM_GCExtensionsBase::getExtensions(env->getOmrVM());
+	uintptr_t regionSize = extensions->getHeap()->getHeapRegionManager()->getRegionSize();
+	uintptr_t currentSize = getCurrentSize();
+	uintptr_t desiredSize = _nurserySizingModel.calculateDesiredSize(env, currentSize, getMinimumSize(), getMaximumSize());
+
+	uintptr_t softMxForNursery = extensions->heap->getActualSoftMxSize(env, MEMORY_TYPE_NEW);
+	if (0 != softMxForNursery) {
+		desiredSize = OMR_MIN(desiredSize, softMxForNursery);
+	}
+
+	/* Ignore changes of less than a tenth of the nursery, the model is not that precise */
+	uintptr_t tolerance = currentSize / 10;
+	if (desiredSize > (currentSize + tolerance)) {
+		if ((NULL != _physicalSubArena) && _physicalSubArena->canExpand(env) && (0 != maxExpansionInSpace(env))) {
+			uintptr_t expansionSize = OMR_MIN(desiredSize - currentSize, (uintptr_t)(currentSize * extensions->dnssMaximumExpansion));
+			expansionSize = MM_Math::roundToCeiling(extensions->heapAlignment, expansionSize);
+			expansionSize = MM_Math::roundToCeiling(2 * regionSize, expansionSize);
+			_expansionSize = adjustExpansionWithinSoftMax(env, expansionSize, 0, MEMORY_TYPE_NEW);
+			extensions->heap->getResizeStats()->setLastExpandReason(NURSERY_SIZING_MODEL_EXPAND);
+		}
+	} else if ((desiredSize + tolerance) < currentSize) {
+		if ((NULL != _physicalSubArena) && _physicalSubArena->canContract(env) && (0 != maxContractionInSpace(env))) {
+			uintptr_t contractionSize = OMR_MIN(currentSize - desiredSize, (uintptr_t)(currentSize * extensions->dnssMaximumContraction));
+			contractionSize = MM_Math::roundToFloor(extensions->heapAlignment, contractionSize);
+			_contractionSize = MM_Math::roundToFloor(regionSize, contractionSize);
+			if (0 != _contractionSize) {
+				extensions->heap->getResizeStats()->setLastContractReason(NURSERY_SIZING_MODEL_CONTRACT);
+			}
+		}
+	}
+}
+
 /**
  * Adjust the sub space memory consumed after a collect.
  * Adjusting semi space memory consumed after a collect includes changing the tilt and/or
@@ -1032,8 +1148,16 @@ MM_MemorySubSpaceSemiSpace::checkResize(MM_EnvironmentBase *env, MM_AllocateDesc
 	if (_extensions->isConcurrentScavengerEnabled() && _extensions->isScavengerBackOutFlagRaised()) {
 		flip(env, MM_MemorySubSpaceSemiSpace::restore_tilt_after_percolate);
 	} else {
+		bool modelUpdated = false;
+		if (0 != _extensions->scavengerPauseTarget) {
+			MM_Scavenger *scavenger = (MM_Scavenger *)_collector;
+			modelUpdated = _nurserySizingModel.scavengeCompleted(env, scavenger->_cycleTimes.cycleStart, scavenger->_cycleTimes.cycleEnd);
+		}
 		checkSubSpaceMemoryPostCollectTilt(env);
 		checkSubSpaceMemoryPostCollectResize(env);
+		if (modelUpdated) {
+			_nurserySizingModel.reportDecision(env, getCurrentSize(), (intptr_t)_expansionSize - (intptr_t)_contractionSize);
+		}
 	}
 	env->popVMstate(oldVMState);
 }
@@ -30,6 +30,7 @@
 #if defined(OMR_GC_MODRON_SCAVENGER)
 
 #include "MemorySubSpace.hpp"
+#include "NurserySizingModel.hpp"
 
 class MM_AllocateDescription;
 class MM_EnvironmentBase;
@@ -78,6 +79,10 @@ private:
 	uint64_t _lastGCEndTime;
 
 	double _desiredSurvivorSpaceRatio;
+	MM_NurserySizingModel _nurserySizingModel; /**< sizes and tilts the nursery when a scavenger pause target is specified */
+	MM_MemorySubSpace *_numaBoundSubSpaces[2]; /**< the semi spaces whose NUMA slices have been bound to their nodes (see sliceForNUMA()) */
+	void *_numaBoundBases[2]; /**< base of the range of each semi space when its slices were bound */
+	void *_numaBoundTops[2]; /**< top of the range of each semi space when its slices were bound */
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 	uintptr_t _bytesAllocatedDuringConcurrent;
 	uintptr_t _avgBytesAllocatedDuringConcurrent;
@@ -102,6 +107,9 @@ private:
 
 	void checkSubSpaceMemoryPostCollectTilt(MM_EnvironmentBase *env);
 	void checkSubSpaceMemoryPostCollectResize(MM_EnvironmentBase *env);
+	void checkSubSpaceMemoryPostCollectResizeFromModel(MM_EnvironmentBase *env);
+
+	void sliceForNUMA(MM_EnvironmentBase *env, MM_MemorySubSpace *subSpace);
 
 protected:
 	virtual void *allocationRequestFailed(MM_EnvironmentBase *env, MM_AllocateDescription *allocateDescription, AllocationType allocationType, MM_ObjectAllocationInterface *objectAllocationInterface, MM_MemorySubSpace *baseSubSpace, MM_MemorySubSpace *previousSubSpace);
@@ -192,6 +200,10 @@ public:
 		,_averageScavengeTimeRatio(0.0)
 		,_lastGCEndTime(0)
 		,_desiredSurvivorSpaceRatio(0.0)
+		,_nurserySizingModel()
+		,_numaBoundSubSpaces()
+		,_numaBoundBases()
+		,_numaBoundTops()
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)		
 		,_bytesAllocatedDuringConcurrent(0)
 		,_avgBytesAllocatedDuringConcurrent(0)
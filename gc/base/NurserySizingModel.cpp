@@ -0,0 +1,302 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base
+ */
+
+#include <math.h>
+
+#include "omrcfg.h"
+#include "omrport.h"
+#include "gcutils.h"
+#include "mmprivatehook.h"
+#include "ModronAssertions.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include "NurserySizingModel.hpp"
+
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "Math.hpp"
+#include "ParallelDispatcher.hpp"
+#include "ScavengerCopyScanRatio.hpp"
+#include "ScavengerStats.hpp"
+
+#define NURSERY_SIZING_MODEL_SAMPLE_WEIGHT 0.1 /* weight of a new sample in the weighted means */
+#define NURSERY_SIZING_MODEL_DEVIATION_FACTOR 2.0
+#define NURSERY_SIZING_MODEL_FORGETTING_FACTOR 0.9 /* decay of the pause time fit per scavenge */
+#define NURSERY_SIZING_MODEL_MINIMUM_FIT_WEIGHT 0.25
+
+void
+MM_NurserySizingModel::updateEstimate(Estimate *estimate, double sample)
+{
+	if (0 == _sampleCount) {
+		estimate->mean = sample;
+	} else {
+		estimate->deviation = MM_Math::weightedAverage(estimate->deviation, fabs(sample - estimate->mean), 1.0 - NURSERY_SIZING_MODEL_SAMPLE_WEIGHT);
+		estimate->mean = MM_Math::weightedAverage(estimate->mean, sample, 1.0 - NURSERY_SIZING_MODEL_SAMPLE_WEIGHT);
+	}
+	estimate->history[_sampleCount % NURSERY_SIZING_MODEL_HISTORY_SIZE] = sample;
+}
+
+double
+MM_NurserySizingModel::getPeak(Estimate *estimate)
+{
+	double peak = estimate->mean + (NURSERY_SIZING_MODEL_DEVIATION_FACTOR * estimate->deviation);
+	uintptr_t count = OMR_MIN(_sampleCount, (uintptr_t)NURSERY_SIZING_MODEL_HISTORY_SIZE);
+	for (uintptr_t i = 0; i < count; i++) {
+		peak = OMR_MAX(peak, estimate->history[i]);
+	}
+	return peak;
+}
+
+double
+MM_NurserySizingModel::getRatePeak(Estimate *estimate)
+{
+	/* the deviation may carry the peak of a rate past the whole allocation */
+	return OMR_MIN(getPeak(estimate), 1.0);
+}
+
+void
+MM_NurserySizingModel::addScavenge(uintptr_t allocatedBytes, uint64_t mutatorMicros, uintptr_t firstCopiedBytes, uintptr_t firstFlippedBytes,
+	uintptr_t copiedBytes, uintptr_t flippedBytes, uint64_t pauseMicros, double weight)
+{
+	Assert_MM_true((0 != allocatedBytes) && (0 != mutatorMicros));
+	_lastPauseMicros = pauseMicros;
+
+	updateEstimate(&_survivalRate, OMR_MIN((double)firstCopiedBytes / (double)allocatedBytes, 1.0));
+	updateEstimate(&_flipRate, OMR_MIN((double)firstFlippedBytes / (double)allocatedBytes, 1.0));
+	updateEstimate(&_agedCopiedBytes, (double)(copiedBytes - OMR_MIN(copiedBytes, firstCopiedBytes)));
+	updateEstimate(&_agedFlippedBytes, (double)(flippedBytes - OMR_MIN(flippedBytes, firstFlippedBytes)));
+	double allocationRate = (double)allocatedBytes / (double)mutatorMicros;
+	_allocationRate = (0 == _sampleCount) ? allocationRate : MM_Math::weightedAverage(_allocationRate, allocationRate, 1.0 - NURSERY_SIZING_MODEL_SAMPLE_WEIGHT);
+	_sampleCount += 1;
+
+	/* Fit pause = fixed + perByte * copiedBytes, forgetting older scavenges geometrically */
+	double bytes = (double)copiedBytes;
+	double pause = (double)pauseMicros;
+	_sumWeight = (_sumWeight * NURSERY_SIZING_MODEL_FORGETTING_FACTOR) + weight;
+	_sumBytes = (_sumBytes * NURSERY_SIZING_MODEL_FORGETTING_FACTOR) + (weight * bytes);
+	_sumPause = (_sumPause * NURSERY_SIZING_MODEL_FORGETTING_FACTOR) + (weight * pause);
+	_sumBytesSquared = (_sumBytesSquared * NURSERY_SIZING_MODEL_FORGETTING_FACTOR) + (weight * bytes * bytes);
+	_sumBytesPause = (_sumBytesPause * NURSERY_SIZING_MODEL_FORGETTING_FACTOR) + (weight * bytes * pause);
+
+	double meanBytes = _sumBytes / _sumWeight;
+	double meanPause = _sumPause / _sumWeight;
+	double bytesVariance = (_sumBytesSquared / _sumWeight) - (meanBytes * meanBytes);
+	_fixedPauseMicros = meanPause;
+	_pauseMicrosPerByte = 0.0;
+	if (bytesVariance > (meanBytes * meanBytes * 1.0e-4)) {
+		double perByte = ((_sumBytesPause / _sumWeight) - (meanBytes * meanPause)) / bytesVariance;
+		double fixed = meanPause - (perByte * meanBytes);
+		if ((0.0 <= perByte) && (0.0 <= fixed)) {
+			_pauseMicrosPerByte = perByte;
+			_fixedPauseMicros = fixed;
+		}
+	}
+	if ((0.0 == _pauseMicrosPerByte) && (0.0 < _sumBytesSquared)) {
+		/* copied volume has not varied enough to separate the fixed cost, attribute the whole pause to the copying */
+		_pauseMicrosPerByte = _sumBytesPause / _sumBytesSquared;
+		_fixedPauseMicros = 0.0;
+	}
+}
+
+bool
+MM_NurserySizingModel::scavengeCompleted(MM_EnvironmentBase *env, uint64_t scavengeStartTime, uint64_t scavengeEndTime)
+{
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	MM_ScavengerStats *scavengerStats = &extensions->scavengerStats;
+
+	/* the clock may have been shifted backwards */
+	bool validInterval = (0 != _lastScavengeEndTime) && (_lastScavengeEndTime < scavengeStartTime) && (scavengeStartTime < scavengeEndTime);
+	uint64_t mutatorMicros = validInterval ? omrtime_hires_delta(_lastScavengeEndTime, scavengeStartTime, OMRPORT_TIME_DELTA_IN_MICROSECONDS) : 0;
+	_lastScavengeEndTime = scavengeEndTime;
+
+	/* bytes allocated in the nursery since the previous scavenge are recorded as age 0 of the previous flip history */
+	uintptr_t allocatedBytes = scavengerStats->getFlipHistory(1)->_flipBytes[0];
+	if ((0 == mutatorMicros) || (0 == allocatedBytes)) {
+		return false;
+	}
+
+	MM_ScavengerStats::FlipHistory *flipHistory = scavengerStats->getFlipHistory(0);
+	uintptr_t firstFlippedBytes = flipHistory->_flipBytes[1];
+	uintptr_t firstCopiedBytes = firstFlippedBytes + flipHistory->_tenureBytes[1];
+	/* objects which failed to flip are tenured, but they still ask for survivor space */
+	uintptr_t flippedBytes = scavengerStats->_flipBytes + scavengerStats->_failedFlipBytes;
+	uintptr_t copiedBytes = scavengerStats->_flipBytes + scavengerStats->_tenureAggregateBytes;
+
+	/* A low copy/scan scaling factor means GC threads were starved for scan work, so the pause was
+	 * set by a serial tail rather than by the copied volume.
+	 */
+	double scalingFactor = 0.0;
+	uintptr_t recordCount = 0;
+	uintptr_t scaledRecordCount = 0;
+	MM_ScavengerCopyScanRatio::UpdateHistory *history = extensions->copyScanRatio.getHistory(&recordCount);
+	for (uintptr_t i = 0; i < recordCount; i++) {
+		if (0 != history[i].majorUpdates) {
+			scalingFactor += extensions->copyScanRatio.getScalingFactor(env, &history[i]);
+			scaledRecordCount += 1;
+		}
+	}
+	double weight = (0 == scaledRecordCount) ? 1.0 : OMR_MAX(scalingFactor / (double)scaledRecordCount, NURSERY_SIZING_MODEL_MINIMUM_FIT_WEIGHT);
+
+	addScavenge(allocatedBytes, mutatorMicros, firstCopiedBytes, firstFlippedBytes, copiedBytes, flippedBytes,
+		omrtime_hires_delta(scavengeStartTime, scavengeEndTime, OMRPORT_TIME_DELTA_IN_MICROSECONDS), weight);
+
+	return true;
+}
+
+double
+MM_NurserySizingModel::getSurvivorSizeAmplification(MM_EnvironmentBase *env)
+{
+	/* same amplification as the averaged tilt */
+	return 1.04 + env->getExtensions()->dispatcher->threadCount() / 100.0;
+}
+
+double
+MM_NurserySizingModel::calculateAllocateSize(MM_EnvironmentBase *env, uintptr_t nurserySize)
+{
+	/* solve nurserySize = allocateSize + (flipRate * allocateSize + agedFlippedBytes) * amplification */
+	double amplification = getSurvivorSizeAmplification(env);
+	double allocateSize = ((double)nurserySize - (getPeak(&_agedFlippedBytes) * amplification)) / (1.0 + (getRatePeak(&_flipRate) * amplification));
+	return OMR_MAX(allocateSize, 0.0);
+}
+
+double
+MM_NurserySizingModel::calculateSurvivorSpaceRatio(MM_EnvironmentBase *env, uintptr_t nurserySize)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+
+	_survivorSpaceRatio = 1.0 - (calculateAllocateSize(env, nurserySize) / (double)nurserySize);
+	_survivorSpaceRatio = OMR_MAX(_survivorSpaceRatio, extensions->survivorSpaceMinimumSizeRatio);
+	_survivorSpaceRatio = OMR_MIN(_survivorSpaceRatio, extensions->survivorSpaceMaximumSizeRatio);
+
+	return _survivorSpaceRatio;
+}
+
+uintptr_t
+MM_NurserySizingModel::calculateDesiredSize(MM_EnvironmentBase *env, uintptr_t currentSize, uintptr_t minimumSize, uintptr_t maximumSize)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+
+	_desiredSize = currentSize;
+	if (!isReady()) {
+		_reason = NURSERY_SIZING_WARMING_UP;
+		return _desiredSize;
+	}
+
+	/* predicted pause = fixedMicros + perAllocatedByteMicros * allocateSize */
+	double fixedMicros = _fixedPauseMicros + (_pauseMicrosPerByte * getPeak(&_agedCopiedBytes));
+	double perAllocatedByteMicros = _pauseMicrosPerByte * getRatePeak(&_survivalRate);
+	double pauseTargetMicros = (double)extensions->scavengerPauseTarget * 1000.0;
+	double maximumAllocateSize = (double)maximumSize;
+
+	/* largest allocate space whose predicted pause meets the target */
+	double pauseBound = maximumAllocateSize;
+	if (0.0 < perAllocatedByteMicros) {
+		pauseBound = OMR_MIN((pauseTargetMicros - fixedMicros) / perAllocatedByteMicros, maximumAllocateSize);
+	}
+
+	/* Smallest allocate space keeping the scavenge time ratio, (fixed + perByte * size) * allocationRate / size,
+	 * within the expected maximum. It can not be met at any size if the copy cost alone exceeds it.
+	 */
+	double ratioBound = maximumAllocateSize;
+	double ratioMargin = extensions->dnssExpectedRatioMaximum._valueSpecified - (_allocationRate * perAllocatedByteMicros);
+	if (0.0 < ratioMargin) {
+		ratioBound = OMR_MIN((_allocationRate * fixedMicros) / ratioMargin, maximumAllocateSize);
+	}
+
+	double allocateSize = 0.0;
+	if (pauseTargetMicros <= fixedMicros) {
+		/* No nursery meets the target and a smaller one would only scavenge more often: keep the scavenge
+		 * time ratio if it can be met, the current size otherwise.
+		 */
+		_reason = NURSERY_SIZING_PAUSE_TARGET_UNREACHABLE;
+		if (0.0 >= ratioMargin) {
+			return _desiredSize;
+		}
+		allocateSize = ratioBound;
+	} else if (ratioBound <= pauseBound) {
+		_reason = NURSERY_SIZING_SCAVENGE_RATIO;
+		allocateSize = ratioBound;
+	} else {
+		_reason = NURSERY_SIZING_PAUSE_TARGET;
+		allocateSize = pauseBound;
+	}
+	double survivorSize = ((getRatePeak(&_flipRate) * allocateSize) + getPeak(&_agedFlippedBytes)) * getSurvivorSizeAmplification(env);
+	double desiredSize = OMR_MIN(allocateSize + survivorSize, (double)maximumSize);
+	_desiredSize = OMR_MAX((uintptr_t)desiredSize, minimumSize);
+
+	return _desiredSize;
+}
+
+void
+MM_NurserySizingModel::reportDecision(MM_EnvironmentBase *env, uintptr_t currentSize, intptr_t resizeAmount)
+{
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+
+	uintptr_t allocationRate = (uintptr_t)(_allocationRate * 1000.0);
+	double survivalRate = getRatePeak(&_survivalRate);
+	double flipRate = getRatePeak(&_flipRate);
+	uint64_t fixedPauseMicros = (uint64_t)(_fixedPauseMicros + (_pauseMicrosPerByte * getPeak(&_agedCopiedBytes)));
+	uint64_t predictedPauseMicros = 0;
+	if (isReady() && !extensions->dynamicNewSpaceSizing) {
+		/* the nursery size is not dynamic, the model only tilts it */
+		_reason = NURSERY_SIZING_SIZE_FIXED;
+		_desiredSize = currentSize;
+	}
+	if (NURSERY_SIZING_WARMING_UP == _reason) {
+		_desiredSize = currentSize;
+		calculateSurvivorSpaceRatio(env, currentSize);
+	} else {
+		double allocateSize = calculateAllocateSize(env, currentSize + resizeAmount);
+		predictedPauseMicros = fixedPauseMicros + (uint64_t)(_pauseMicrosPerByte * survivalRate * allocateSize);
+	}
+
+	Trc_MM_NurserySizingModel_calculateDesiredSize(env->getLanguageVMThread(), getNurserySizingReasonAsString(_reason), survivalRate, flipRate, allocationRate,
+		_lastPauseMicros, fixedPauseMicros, predictedPauseMicros, extensions->scavengerPauseTarget, currentSize, _desiredSize);
+
+	TRIGGER_J9HOOK_MM_PRIVATE_NURSERY_SIZING(
+		extensions->privateHookInterface,
+		env->getOmrVMThread(),
+		omrtime_hires_clock(),
+		J9HOOK_MM_PRIVATE_NURSERY_SIZING,
+		(uintptr_t)_reason,
+		(float)survivalRate,
+		(float)flipRate,
+		allocationRate,
+		_lastPauseMicros,
+		fixedPauseMicros,
+		predictedPauseMicros,
+		extensions->scavengerPauseTarget,
+		currentSize,
+		_desiredSize,
+		resizeAmount,
+		(float)_survivorSpaceRatio);
+}
+
+#endif /* OMR_GC_MODRON_SCAVENGER */
@@ -0,0 +1,209 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base
+ */
+
+#if !defined(NURSERYSIZINGMODEL_HPP_)
+#define NURSERYSIZINGMODEL_HPP_
+
+#include <string.h>
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrgcconsts.h"
+#include "modronbase.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+class MM_EnvironmentBase;
+
+#define NURSERY_SIZING_MODEL_HISTORY_SIZE 16
+#define NURSERY_SIZING_MODEL_WARMUP_SAMPLES 4
+
+/**
+ * Online model of the nursery used to size it, and to tilt it, towards a target scavenge pause at
+ * the lowest memory cost.
+ *
+ * Each scavenge feeds the model the bytes allocated since the previous scavenge, the bytes copied to
+ * survivor and tenure space by age and the pause time. Bytes surviving their first scavenge grow with
+ * the allocate space while the bytes of older objects copied again do not, so the two are estimated
+ * separately. Every estimate is kept as a slowly weighted mean and deviation together with its peak over
+ * the last NURSERY_SIZING_MODEL_HISTORY_SIZE scavenges, so a periodic allocation pattern is sized for its
+ * peaks rather than for whichever phase the last few scavenges fell in. Pause time is fitted as a fixed
+ * cost plus a cost per copied byte by least squares with exponential forgetting; scavenges whose
+ * copy/scan ratio shows starved GC threads are given less weight, as their pause measures a serial tail
+ * rather than the copy volume.
+ *
+ * The nursery is sized to the smallest allocate space which keeps the predicted scavenge time ratio
+ * under dnssExpectedRatioMaximum, bounded by the largest allocate space whose predicted pause meets
+ * scavengerPauseTarget, and the survivor space to the predicted peak of flipped bytes.
+ * @ingroup GC_Base
+ */
+class MM_NurserySizingModel
+{
+	/*
+	 * Data members
+	 */
+private:
+	typedef struct Estimate {
+		double mean; /**< weighted mean of the samples */
+		double deviation; /**< weighted mean absolute deviation of the samples */
+		double history[NURSERY_SIZING_MODEL_HISTORY_SIZE]; /**< samples of the most recent scavenges */
+	} Estimate;
+
+	uintptr_t _sampleCount; /**< number of scavenges observed */
+	uint64_t _lastScavengeEndTime; /**< hires clock at the end of the previous scavenge */
+
+	Estimate _survivalRate; /**< bytes surviving their first scavenge per byte allocated */
+	Estimate _flipRate; /**< bytes flipped to survivor space in their first scavenge per byte allocated */
+	Estimate _agedCopiedBytes; /**< bytes copied of objects which had survived a previous scavenge */
+	Estimate _agedFlippedBytes; /**< bytes flipped of objects which had survived a previous scavenge */
+	double _allocationRate; /**< weighted mean of bytes allocated per microsecond between scavenges */
+
+	double _sumWeight; /**< decayed sums of the pause time fit */
+	double _sumBytes;
+	double _sumPause;
+	double _sumBytesSquared;
+	double _sumBytesPause;
+
+	double _fixedPauseMicros; /**< fitted pause time independent of the copied bytes */
+	double _pauseMicrosPerByte; /**< fitted pause time per copied byte */
+	uint64_t _lastPauseMicros; /**< pause time of the last scavenge */
+
+	NurserySizingReason _reason; /**< reason for the last decision */
+	uintptr_t _desiredSize; /**< nursery size chosen by the last decision */
+	double _survivorSpaceRatio; /**< survivor space ratio chosen by the last decision */
+
+	/*
+	 * Function members
+	 */
+private:
+	void updateEstimate(Estimate *estimate, double sample);
+	double getPeak(Estimate *estimate);
+	double getRatePeak(Estimate *estimate);
+
+	/**
+	 * @return the amplification of flipped bytes to leave room for copy cache remainders in survivor space
+	 */
+	double getSurvivorSizeAmplification(MM_EnvironmentBase *env);
+
+	/**
+	 * @param nurserySize size of the nursery
+	 * @return the predicted peak of bytes allocated between scavenges once survivor space is set aside
+	 */
+	double calculateAllocateSize(MM_EnvironmentBase *env, uintptr_t nurserySize);
+
+public:
+	/**
+	 * Add a scavenge to the model.
+	 * @param allocatedBytes bytes allocated in the nursery since the previous scavenge
+	 * @param mutatorMicros time since the previous scavenge
+	 * @param firstCopiedBytes bytes copied of objects surviving their first scavenge
+	 * @param firstFlippedBytes bytes flipped of objects surviving their first scavenge
+	 * @param copiedBytes bytes copied to survivor and tenure space
+	 * @param flippedBytes bytes flipped, or failing to flip, to survivor space
+	 * @param pauseMicros pause time of the scavenge
+	 * @param weight weight of the scavenge in the pause time fit
+	 */
+	void addScavenge(uintptr_t allocatedBytes, uint64_t mutatorMicros, uintptr_t firstCopiedBytes, uintptr_t firstFlippedBytes,
+		uintptr_t copiedBytes, uintptr_t flippedBytes, uint64_t pauseMicros, double weight);
+
+	/**
+	 * Feed the model with the statistics of a scavenge which has just completed.
+	 * @param scavengeStartTime hires clock at the start of the scavenge
+	 * @param scavengeEndTime hires clock at the end of the scavenge
+	 * @return true if the scavenge was added to the model
+	 */
+	bool scavengeCompleted(MM_EnvironmentBase *env, uint64_t scavengeStartTime, uint64_t scavengeEndTime);
+
+	/**
+	 * @return true once the model has observed enough scavenges to be used for sizing decisions
+	 */
+	MMINLINE bool isReady() { return NURSERY_SIZING_MODEL_WARMUP_SAMPLES <= _sampleCount; }
+
+	/**
+	 * @return the fitted pause time independent of the copied bytes, in microseconds
+	 */
+	MMINLINE double getFixedPauseMicros() { return _fixedPauseMicros; }
+
+	/**
+	 * @return the fitted pause time per copied byte, in microseconds
+	 */
+	MMINLINE double getPauseMicrosPerByte() { return _pauseMicrosPerByte; }
+
+	/**
+	 * @return the reason for the last decision
+	 */
+	MMINLINE NurserySizingReason getReason() { return _reason; }
+
+	/**
+	 * Calculate the survivor space ratio needed to hold the predicted peak of flipped bytes.
+	 * @param nurserySize size of the nursery
+	 * @return the desired ratio of survivor space to nursery size
+	 */
+	double calculateSurvivorSpaceRatio(MM_EnvironmentBase *env, uintptr_t nurserySize);
+
+	/**
+	 * Choose the nursery size for the following scavenges and record the reason for the decision.
+	 * @param currentSize current size of the nursery
+	 * @param minimumSize minimum size of the nursery
+	 * @param maximumSize maximum size of the nursery
+	 * @return the desired size of the nursery
+	 */
+	uintptr_t calculateDesiredSize(MM_EnvironmentBase *env, uintptr_t currentSize, uintptr_t minimumSize, uintptr_t maximumSize);
+
+	/**
+	 * Report the last decision through the nursery sizing hook.
+	 * @param currentSize current size of the nursery
+	 * @param resizeAmount the amount by which the nursery will be expanded (positive) or contracted (negative)
+	 */
+	void reportDecision(MM_EnvironmentBase *env, uintptr_t currentSize, intptr_t resizeAmount);
+
+	MM_NurserySizingModel()
+		: _sampleCount(0)
+		, _lastScavengeEndTime(0)
+		, _allocationRate(0.0)
+		, _sumWeight(0.0)
+		, _sumBytes(0.0)
+		, _sumPause(0.0)
+		, _sumBytesSquared(0.0)
+		, _sumBytesPause(0.0)
+		, _fixedPauseMicros(0.0)
+		, _pauseMicrosPerByte(0.0)
+		, _lastPauseMicros(0)
+		, _reason(NURSERY_SIZING_WARMING_UP)
+		, _desiredSize(0)
+		, _survivorSpaceRatio(0.0)
+	{
+		memset(&_survivalRate, 0, sizeof(_survivalRate));
+		memset(&_flipRate, 0, sizeof(_flipRate));
+		memset(&_agedCopiedBytes, 0, sizeof(_agedCopiedBytes));
+		memset(&_agedFlippedBytes, 0, sizeof(_agedFlippedBytes));
+	}
+};
+
+#endif /* OMR_GC_MODRON_SCAVENGER */
+
+#endif /* NURSERYSIZINGMODEL_HPP_ */
@@ -813,6 +813,19 @@ public:
 		return _delegate.getHotFieldOffset3(forwardedHeader);
 	}
 
+	/**
+	 * Returns a key identifying the class of the object, used to learn hot fields from sampled dereferences.
+	 * Valid if scavengerLearnHotFields is enabled
+	 *
+	 * @param objectPtr the object
+	 * @return the class key of the object, or 0 if the class can not be identified
+	 */
+	MMINLINE uintptr_t
+	getHotFieldClassKey(omrobjectptr_t objectPtr)
+	{
+		return _delegate.getHotFieldClassKey(objectPtr);
+	}
+
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_VLHGC) */
 
 #if defined(OMR_GC_MODRON_SCAVENGER)
@@ -45,6 +45,7 @@ private:
 	uintptr_t *_topPtr;
 	uintptr_t *_currentPtr;
 	uintptr_t _sublistIndex;
+	uintptr_t _packetIndex; /**< Index of this packet in the MM_WorkPackets packet table, used by lock-free packet lists */
 	MM_EnvironmentBase *_owner;
 protected:
 public:
@@ -67,6 +68,22 @@ private:
 
 protected:
 public:
+	/**
+	 * Return the index of this packet in the packet table of its lock-free packet lists
+	 */
+	MMINLINE uintptr_t getPacketIndex()
+	{
+		return _packetIndex;
+	}
+
+	/**
+	 * Set the index of this packet in the packet table of its lock-free packet lists
+	 */
+	MMINLINE void setPacketIndex(uintptr_t packetIndex)
+	{
+		_packetIndex = packetIndex;
+	}
+
 	/**
 	 * Returns the number of free slots
 	 */
@@ -212,6 +229,7 @@ public:
 		_topPtr(NULL),
 		_currentPtr(NULL),
 		_sublistIndex(0),
+		_packetIndex(0),
 		_owner(NULL),
 		_next(NULL),
 		_previous(NULL)
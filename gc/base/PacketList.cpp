@@ -111,6 +111,24 @@ MM_PacketList::tearDown(MM_EnvironmentBase *env)
 	}
 }
 
+MM_Packet *
+MM_PacketList::detachLockFree(PacketSublist *list)
+{
+	uint64_t oldTaggedHead = MM_AtomicOperations::getU64(&list->_taggedHead);
+	MM_Packet *head = NULL;
+
+	while (NULL != (head = decodeTaggedHead(oldTaggedHead))) {
+		uint64_t observedTaggedHead = MM_AtomicOperations::lockCompareExchangeU64(&list->_taggedHead, oldTaggedHead, encodeTaggedHead(oldTaggedHead, NULL));
+		if (observedTaggedHead == oldTaggedHead) {
+			MM_AtomicOperations::loadSync();
+			break;
+		}
+		oldTaggedHead = observedTaggedHead;
+	}
+
+	return head;
+}
+
 void 
 MM_PacketList::pushList(MM_Packet *head, MM_Packet *tail, uintptr_t count)
 {
@@ -118,6 +136,27 @@ MM_PacketList::pushList(MM_Packet *head, MM_Packet *tail, uintptr_t count)
 	PacketSublist *list = &_sublists[0];
 	MM_Packet *current = head;
 	uintptr_t i;
+
+	if (isLockFree()) {
+		for (i = 0; i < count; ++i) {
+			current->_previous = NULL;
+			current->setSublistIndex(0);
+			current = current->_next;
+		}
+
+		MM_AtomicOperations::add(&_count, count);
+		uint64_t oldTaggedHead = MM_AtomicOperations::getU64(&list->_taggedHead);
+		while (true) {
+			tail->_next = decodeTaggedHead(oldTaggedHead);
+			MM_AtomicOperations::storeSync();
+			uint64_t observedTaggedHead = MM_AtomicOperations::lockCompareExchangeU64(&list->_taggedHead, oldTaggedHead, encodeTaggedHead(oldTaggedHead, head));
+			if (observedTaggedHead == oldTaggedHead) {
+				break;
+			}
+			oldTaggedHead = observedTaggedHead;
+		}
+		return;
+	}
 	
 	list->_lock.acquire();
 	
@@ -146,6 +185,31 @@ MM_PacketList::popList(MM_Packet **head, MM_Packet **tail, uintptr_t *count)
 	*head = NULL;
 	*tail = NULL;
 	*count = 0;
+
+	if (isLockFree()) {
+		/* detach each sublist in turn and walk it, since the lock-free sublists do not track their tails */
+		for (uintptr_t i = 0; i < _sublistCount; i++) {
+			MM_Packet *current = detachLockFree(&_sublists[i]);
+
+			if (NULL != current) {
+				didPop = true;
+
+				if (NULL == *head) {
+					*head = current;
+				} else {
+					(*tail)->_next = current;
+				}
+				while (NULL != current) {
+					*tail = current;
+					*count += 1;
+					current = current->_next;
+				}
+			}
+		}
+		MM_AtomicOperations::subtract(&_count, *count);
+
+		return didPop;
+	}
 	
 	/* acquire all of our locks */
 	for (uintptr_t i = 0; i < _sublistCount; i++) {
@@ -191,6 +255,9 @@ MM_PacketList::remove(MM_Packet *packetToRemove)
 	PacketSublist *list = &_sublists[packetToRemove->getSublistIndex()];
 	MM_Packet *previous = NULL;
 	MM_Packet *next = NULL;
+
+	/* lock-free sublists are singly linked and cannot have arbitrary packets unlinked */
+	Assert_MM_true(!isLockFree());
 	
 	list->_lock.acquire();
 	
@@ -233,7 +300,11 @@ MM_PacketList::getHead()
 	
 	if (popList(&head, &tail, &count)) {
 		pushList(head, tail, count);
-		result = _sublists[0]._head;
+		if (isLockFree()) {
+			result = decodeTaggedHead(_sublists[0]._taggedHead);
+		} else {
+			result = _sublists[0]._head;
+		}
 	}
 
 	return result;
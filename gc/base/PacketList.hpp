@@ -40,6 +40,9 @@
 
 class MM_GCExtensionsBase;
 
+#define PACKET_LIST_TAG_SHIFT 32
+#define PACKET_LIST_INDEX_MASK ((uint64_t)0xFFFFFFFF)
+
 class MM_PacketList: public MM_BaseNonVirtual
 {
 
@@ -48,6 +51,7 @@ public:
 	struct PacketSublist {
 		MM_Packet *_head;  /**< Head of the list */
 		MM_Packet *_tail;  /**< Tail of the list */
+		volatile uint64_t _taggedHead; /**< Head of the list when lock-free: ABA tag in the high 32 bits, packet index + 1 (0 for empty) in the low 32 bits */
 		MM_LightweightNonReentrantLock _lock;  /**< Lock for getting/putting packets */
 
 		bool initialize(MM_EnvironmentBase *env)
@@ -61,6 +65,7 @@ public:
 		PacketSublist()
 			: _head(NULL)
 			, _tail(NULL)
+			, _taggedHead(0)
 		{
 		}
 	};
@@ -72,6 +77,7 @@ private:
 	
 	uintptr_t _sublistCount; /**< The number of lists (split for parallelism). Must be at least 1 */
 	volatile uintptr_t _count;  /**< Number of items in the list */
+	MM_Packet **_packetTable; /**< Packets indexed by MM_Packet::_packetIndex, owned by MM_WorkPackets. Non-NULL if the list is lock-free */
 	
 /* Functionality Section */
 private:
@@ -120,6 +126,102 @@ private:
 	{
 		return env->getEnvironmentId() % _sublistCount;
 	}
+
+	/**
+	 * Decode the packet referenced by a lock-free sublist head.
+	 *
+	 * @param taggedHead the tagged head of a sublist
+	 *
+	 * @return the packet at the head of the sublist, or NULL if the sublist is empty
+	 */
+	MMINLINE MM_Packet *
+	decodeTaggedHead(uint64_t taggedHead)
+	{
+		uintptr_t index = (uintptr_t)(taggedHead & PACKET_LIST_INDEX_MASK);
+		return (0 == index) ? NULL : _packetTable[index - 1];
+	}
+
+	/**
+	 * Build the tagged head which replaces oldTaggedHead when the sublist head becomes newHead.
+	 * The tag is advanced on every update so that a stale head is never mistaken for the current one.
+	 *
+	 * @param oldTaggedHead the tagged head being replaced
+	 * @param newHead the new first packet of the sublist, or NULL if the sublist becomes empty
+	 *
+	 * @return the new tagged head
+	 */
+	MMINLINE uint64_t
+	encodeTaggedHead(uint64_t oldTaggedHead, MM_Packet *newHead)
+	{
+		uint64_t tag = (oldTaggedHead >> PACKET_LIST_TAG_SHIFT) + 1;
+		uint64_t index = (NULL == newHead) ? 0 : ((uint64_t)newHead->getPacketIndex() + 1);
+		return (tag << PACKET_LIST_TAG_SHIFT) | index;
+	}
+
+	/**
+	 * Push a packet on the specified sublist without taking its lock.
+	 *
+	 * @return the number of failed compare and swap attempts
+	 */
+	MMINLINE uintptr_t
+	pushLockFree(PacketSublist *list, MM_Packet *packet)
+	{
+		uintptr_t retries = 0;
+		uint64_t oldTaggedHead = MM_AtomicOperations::getU64(&list->_taggedHead);
+
+		/* the count is raised before the packet becomes visible so that it never under-reports the list contents */
+		MM_AtomicOperations::add(&_count, 1);
+		while (true) {
+			packet->_next = decodeTaggedHead(oldTaggedHead);
+			/* the packet contents and link must be visible before the packet is */
+			MM_AtomicOperations::storeSync();
+			uint64_t newTaggedHead = encodeTaggedHead(oldTaggedHead, packet);
+			uint64_t observedTaggedHead = MM_AtomicOperations::lockCompareExchangeU64(&list->_taggedHead, oldTaggedHead, newTaggedHead);
+			if (observedTaggedHead == oldTaggedHead) {
+				break;
+			}
+			oldTaggedHead = observedTaggedHead;
+			retries += 1;
+		}
+
+		return retries;
+	}
+
+	/**
+	 * Pop a packet from the specified sublist without taking its lock.
+	 *
+	 * @param[out] retries incremented by the number of failed compare and swap attempts
+	 *
+	 * @return the packet, or NULL if the sublist was empty
+	 */
+	MMINLINE MM_Packet *
+	popLockFree(PacketSublist *list, uintptr_t *retries)
+	{
+		MM_Packet *packet = NULL;
+		uint64_t oldTaggedHead = MM_AtomicOperations::getU64(&list->_taggedHead);
+
+		while (NULL != (packet = decodeTaggedHead(oldTaggedHead))) {
+			/* _next may be stale if the packet was concurrently popped, but then the tag will have moved and the exchange fails */
+			uint64_t newTaggedHead = encodeTaggedHead(oldTaggedHead, packet->_next);
+			uint64_t observedTaggedHead = MM_AtomicOperations::lockCompareExchangeU64(&list->_taggedHead, oldTaggedHead, newTaggedHead);
+			if (observedTaggedHead == oldTaggedHead) {
+				MM_AtomicOperations::subtract(&_count, 1);
+				MM_AtomicOperations::loadSync();
+				break;
+			}
+			oldTaggedHead = observedTaggedHead;
+			*retries += 1;
+		}
+
+		return packet;
+	}
+
+	/**
+	 * Detach every packet from the specified lock-free sublist.
+	 *
+	 * @return the first packet of the detached chain, or NULL if the sublist was empty
+	 */
+	MM_Packet *detachLockFree(PacketSublist *list);
 		
 protected:
 	
@@ -161,6 +263,17 @@ public:
 	{
 		uintptr_t index = getSublistIndex(env);
 		PacketSublist *list = &_sublists[index];
+
+		if (isLockFree()) {
+			packet->_previous = NULL;
+			packet->setSublistIndex(index);
+#if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
+			env->_workPacketStats.workPacketListCASRetries += pushLockFree(list, packet);
+#else /* J9MODRON_TGC_PARALLEL_STATISTICS */
+			pushLockFree(list, packet);
+#endif /* J9MODRON_TGC_PARALLEL_STATISTICS */
+			return;
+		}
 	
 		list->_lock.acquire();
 
@@ -188,6 +301,21 @@ public:
 		uintptr_t index = getSublistIndex(env);
 		MM_Packet *packet = NULL;
 
+		if (isLockFree()) {
+			uintptr_t retries = 0;
+			for (uintptr_t i = 0; i < _sublistCount; i++) {
+				packet = popLockFree(&_sublists[index], &retries);
+				if (NULL != packet) {
+					break;
+				}
+				index = (index + 1) % _sublistCount;
+			}
+#if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
+			env->_workPacketStats.workPacketListCASRetries += retries;
+#endif /* J9MODRON_TGC_PARALLEL_STATISTICS */
+			return packet;
+		}
+
 		for (uintptr_t i = 0; i < _sublistCount; i++) {
 			PacketSublist *list = &_sublists[index];
 
@@ -216,6 +344,27 @@ public:
 		return packet;
 	}
 	
+	/**
+	 * Switch the list to lock-free operation. Must be called before any packets are added.
+	 * In lock-free mode the sublists are singly linked tagged stacks: _head, _tail and
+	 * MM_Packet::_previous are not maintained and remove() is not supported.
+	 *
+	 * @param packetTable table of every packet which may be put on the list, indexed by MM_Packet::_packetIndex
+	 */
+	MMINLINE void setPacketTable(MM_Packet **packetTable)
+	{
+		Assert_MM_true(0 == _count);
+		_packetTable = packetTable;
+	}
+
+	/**
+	 * @return true if the sublists are lock-free, false if they are lock protected
+	 */
+	MMINLINE bool isLockFree()
+	{
+		return (NULL != _packetTable);
+	}
+
 	/**
 	 * Check to see if the list is empty
 	 *
@@ -263,6 +412,7 @@ public:
 		,_sublists(NULL)
 		,_sublistCount(0)
 		,_count(0)
+		,_packetTable(NULL)
 	{
 		_typeId = __FUNCTION__;
 	}
@@ -296,6 +296,8 @@ MM_ParallelDispatcher::initialize(MM_EnvironmentBase *env)
 	}
 	memset(_taskTable, 0, _threadCountMaximum * sizeof(MM_Task *));
 
+	_scalingModel.initialize(_extensions->adaptiveTaskThreadingTolerance);
+
 	return true;
 
 error_no_memory:
@@ -485,6 +487,16 @@ MM_ParallelDispatcher::recomputeActiveThreadCountForTask(MM_EnvironmentBase *env
 		Trc_MM_ParallelDispatcher_recomputeActiveThreadCountForTask_useCollectorRecommendedThreads(task->getRecommendedWorkingThreads(), taskActiveThreadCount);
 	}
 
+	/* Let the task's measured scaling curve choose among the threads the CPU budget allows, unless the caller or user fixed the count */
+	if (_extensions->adaptiveTaskThreadingEnabled() && (UDATA_MAX == threadCount) && (UDATA_MAX == task->getRecommendedWorkingThreads()) && !_extensions->isMetronomeGC()) {
+		uintptr_t budgetThreadCount = adjustThreadCountForCPUBudget(taskActiveThreadCount);
+		taskActiveThreadCount = _scalingModel.recommendThreadCount(env, task->getVMStateID(), budgetThreadCount);
+
+		_activeThreadCount = taskActiveThreadCount;
+
+		Trc_MM_ParallelDispatcher_recomputeActiveThreadCountForTask_useScalingModel(task->getVMStateID(), taskActiveThreadCount, budgetThreadCount);
+	}
+
 	task->setThreadCount(taskActiveThreadCount);
  	return taskActiveThreadCount;
 }
@@ -520,6 +532,29 @@ MM_ParallelDispatcher::adjustThreadCount(uintptr_t maxThreadCount)
 	return toReturn;
 }
 
+uintptr_t
+MM_ParallelDispatcher::adjustThreadCountForCPUBudget(uintptr_t maxThreadCount)
+{
+	uintptr_t toReturn = maxThreadCount;
+	MM_CPUUtilStats *cpuUtilStats = &_extensions->cpuUtilStats;
+
+	if (cpuUtilStats->_validData) {
+		/* CPU time used between GCs by everything but this process is not available to GC threads either */
+		float otherProcessUtil = cpuUtilStats->_avgCpuUtil - cpuUtilStats->_avgProcUtil;
+		if (otherProcessUtil > 0.0f) {
+			OMRPORT_ACCESS_FROM_OMRVM(_extensions->getOmrVM());
+			uintptr_t activeCPUs = omrsysinfo_get_number_CPUs_by_type(OMRPORT_CPU_TARGET);
+			uintptr_t idleCPUs = (uintptr_t)(activeCPUs * (1.0f - OMR_MIN(otherProcessUtil, 1.0f)) + 0.5f);
+			idleCPUs = OMR_MAX(idleCPUs, 1);
+			if (idleCPUs < toReturn) {
+				toReturn = idleCPUs;
+			}
+		}
+	}
+
+	return toReturn;
+}
+
 void
 MM_ParallelDispatcher::prepareThreadsForTask(MM_EnvironmentBase *env, MM_Task *task, uintptr_t threadCount)
 {
@@ -594,10 +629,15 @@ MM_ParallelDispatcher::cleanupAfterTask(MM_EnvironmentBase *env)
 void
 MM_ParallelDispatcher::run(MM_EnvironmentBase *env, MM_Task *task, uintptr_t newThreadCount)
 {
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
 	prepareThreadsForTask(env, task, newThreadCount);
+	uint64_t startTime = omrtime_hires_clock();
 	acceptTask(env);
 	task->run(env);
 	completeTask(env);
+	if (_extensions->adaptiveTaskThreadingEnabled()) {
+		_scalingModel.recordSample(env, task->getVMStateID(), task->getThreadCount(), omrtime_hires_delta(startTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS));
+	}
 	cleanupAfterTask(env);
 	task->mainCleanup(env);
 }
@@ -37,6 +37,7 @@
 #include "BaseVirtual.hpp"
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
+#include "TaskThreadScalingModel.hpp"
 
 class MM_EnvironmentBase;
 
@@ -78,6 +79,7 @@ protected:
 	uintptr_t _threadCount; /**< number of threads currently forked */
 	uintptr_t _activeThreadCount; /**< number of threads actively running a task */
 	uintptr_t _threadsToReserve; /**< Indicates number of threads remaining to dispatch tasks upon notify. Must be exactly 0 after tasks are dispatched. */
+	MM_TaskThreadScalingModel _scalingModel; /**< Per task scaling curves used to choose thread counts when adaptiveTaskThreading is enabled */
 
 	omrsig_handler_fn _handler;
 	void* _handler_arg;
@@ -163,6 +165,13 @@ protected:
 	void setThreadInitializationComplete(MM_EnvironmentBase *env);
 	
 	uintptr_t adjustThreadCount(uintptr_t maxThreadCount);
+
+	/**
+	 * Limit a thread count to the CPUs which other processes left idle since the last GC, as measured by the CPU utilization stats.
+	 * @param[in] maxThreadCount the thread count to limit
+	 * @return the number of threads the task may use without competing with other processes for CPUs (at least 1)
+	 */
+	uintptr_t adjustThreadCountForCPUBudget(uintptr_t maxThreadCount);
 	
 	/**
 	 * Main routine to fork and startup GC threads.
@@ -212,6 +221,7 @@ public:
 	MMINLINE uintptr_t threadCountMaximum() { return _threadCountMaximum; }
 	MMINLINE omrthread_t *getThreadTable() { return _threadTable; }
 	MMINLINE uintptr_t activeThreadCount() { return _activeThreadCount; }
+	MMINLINE bool isTaskDispatched() { return NULL != _task; }
 
 	MMINLINE omrsig_handler_fn getSignalHandler() {return _handler;}
 	MMINLINE void *getSignalHandlerArg() {return _handler_arg;}
@@ -238,6 +248,7 @@ public:
 		,_threadCount(1)
 		,_activeThreadCount(1)
 		,_threadsToReserve(0)		
+		,_scalingModel()
 		,_handler(handler)
 		,_handler_arg(handler_arg)
 		,_defaultOSStackSize(defaultOSStackSize)
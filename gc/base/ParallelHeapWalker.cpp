@@ -80,6 +80,47 @@ public:
 	}
 };
 
+/**
+ * Task handing the live objects of the heap to a batch function from all GC threads.
+ * @ingroup GC_Modron_Standard
+ */
+class MM_ParallelObjectBatchDoTask : public MM_ParallelTask
+{
+	/*
+	 * Data members
+	 */
+private:
+	MM_HeapWalkerObjectBatchFunc _function;
+	void *_userData;
+	uintptr_t _walkFlags;
+
+	MM_ParallelHeapWalker *_heapWalker;
+
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+public:
+	virtual uintptr_t getVMStateID() { return OMRVMSTATE_GC_PARALLEL_OBJECT_DO; };
+
+	virtual void run(MM_EnvironmentBase *env);
+
+	/*
+	 * Create a ParallelObjectBatchDoTask object.
+	 */
+	MM_ParallelObjectBatchDoTask(MM_EnvironmentBase *env, MM_ParallelHeapWalker *heapWalker, MM_HeapWalkerObjectBatchFunc function, void *userData, uintptr_t walkFlags)
+		: MM_ParallelTask(env, env->getExtensions()->dispatcher)
+		, _function(function)
+		, _userData(userData)
+		, _walkFlags(walkFlags)
+		, _heapWalker(heapWalker)
+	{
+		_typeId = __FUNCTION__;
+	}
+};
+
 /**
  * newInstance of Parallel Heap Walker
  */
@@ -100,6 +141,23 @@ MM_ParallelHeapWalker::newInstance(MM_ParallelGlobalGC *globalCollector, MM_Mark
 	return heapWalker;
 }
 
+uintptr_t
+MM_ParallelHeapWalker::getParallelChunkSize(MM_EnvironmentBase *env, uintptr_t *heapChunkFactor)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	uintptr_t threadCount = env->_currentTask->getThreadCount();
+	uintptr_t parallelChunkSize = extensions->heap->getMemorySize();
+
+	*heapChunkFactor = 1;
+	if ((threadCount > 1) && _markMap->isMarkMapValid() && (!extensions->usingSATBBarrier())) {
+		*heapChunkFactor = threadCount * 8;
+		parallelChunkSize = OMR_MIN(parallelChunkSize / *heapChunkFactor, PARALLEL_HEAP_WALKER_MAXIMUM_CHUNK_SIZE);
+		/* chunks must cover whole mark map slots so that no object is seen from two chunks */
+		parallelChunkSize = MM_Math::roundToCeiling(J9MODRON_HEAP_BYTES_PER_HEAPMAP_SLOT, parallelChunkSize);
+	}
+	return MM_Math::roundToCeiling(extensions->heapAlignment, parallelChunkSize);
+}
+
 /**
  * Walk through all live objects of the heap in parallel and apply the provided function.
  */
@@ -110,13 +168,8 @@ MM_ParallelHeapWalker::allObjectsDoParallel(MM_EnvironmentBase *env, MM_HeapWalk
 	MM_GCExtensionsBase *extensions = env->getExtensions();
 
 	/* determine the size of the segment chunks to use for parallel walks */
-	uintptr_t threadCount = env->_currentTask->getThreadCount();
 	uintptr_t heapChunkFactor = 1;
-	if ((threadCount > 1) && _markMap->isMarkMapValid() && (!extensions->usingSATBBarrier())) {
-		heapChunkFactor = threadCount * 8;
-	}
-	uintptr_t parallelChunkSize = extensions->heap->getMemorySize() / heapChunkFactor;
-	parallelChunkSize = MM_Math::roundToCeiling(extensions->heapAlignment, parallelChunkSize);
+	uintptr_t parallelChunkSize = getParallelChunkSize(env, &heapChunkFactor);
 
 	/* Perform the parallel object heap iteration */
 	uintptr_t objectsWalked = 0;
@@ -141,6 +194,53 @@ MM_ParallelHeapWalker::allObjectsDoParallel(MM_EnvironmentBase *env, MM_HeapWalk
 	Trc_MM_ParallelHeapWalker_allObjectsDoParallel_Exit(env->getLanguageVMThread(), heapChunkFactor, parallelChunkSize, objectsWalked);
 }
 
+/**
+ * Walk through all live objects of the heap in parallel, handing them to the provided function in batches.
+ */
+void
+MM_ParallelHeapWalker::allObjectsDoBatchedParallel(MM_EnvironmentBase *env, MM_HeapWalkerObjectBatchFunc function, void *userData, uintptr_t walkFlags)
+{
+	Trc_MM_ParallelHeapWalker_allObjectsDoBatchedParallel_Entry(env->getLanguageVMThread());
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+
+	uintptr_t heapChunkFactor = 1;
+	uintptr_t parallelChunkSize = getParallelChunkSize(env, &heapChunkFactor);
+
+	uintptr_t objectsWalked = 0;
+	uintptr_t batchesFlushed = 0;
+	omrobjectptr_t batch[HEAP_WALKER_OBJECT_BATCH_SIZE];
+	MM_HeapRegionManager *regionManager = extensions->heap->getHeapRegionManager();
+	regionManager->lock();
+	GC_HeapRegionIterator regionIterator(regionManager);
+	MM_HeapRegionDescriptor *region = NULL;
+	OMR_VMThread *omrVMThread = env->getOmrVMThread();
+
+	while (NULL != (region = regionIterator.nextRegion())) {
+		if (walkFlags == (region->getTypeFlags() & walkFlags)) {
+			GC_ParallelObjectHeapIterator objectHeapIterator(env, region, region->getLowAddress(), region->getHighAddress(), _markMap, parallelChunkSize);
+			uintptr_t batchCount = 0;
+			omrobjectptr_t object = NULL;
+			while (NULL != (object = objectHeapIterator.nextObject())) {
+				batch[batchCount++] = object;
+				if (HEAP_WALKER_OBJECT_BATCH_SIZE == batchCount) {
+					function(omrVMThread, region, batch, batchCount, userData);
+					objectsWalked += batchCount;
+					batchesFlushed += 1;
+					batchCount = 0;
+				}
+			}
+			/* batches never span regions, so flush what this thread collected before moving on */
+			if (0 != batchCount) {
+				function(omrVMThread, region, batch, batchCount, userData);
+				objectsWalked += batchCount;
+				batchesFlushed += 1;
+			}
+		}
+	}
+	regionManager->unlock();
+	Trc_MM_ParallelHeapWalker_allObjectsDoBatchedParallel_Exit(env->getLanguageVMThread(), heapChunkFactor, parallelChunkSize, objectsWalked, batchesFlushed);
+}
+
 /**
  * Walk through all live objects of the heap and apply the provided function.
  * If parallel is set to true, task is dispatched to GC threads and walks the heap segments in parallel,
@@ -162,6 +262,31 @@ MM_ParallelHeapWalker::allObjectsDo(MM_EnvironmentBase *env, MM_HeapWalkerObject
 	}
 }
 
+/**
+ * Walk through all live objects of the heap, handing them to the provided function in batches.
+ * If parallel is set to true, task is dispatched to GC threads which walk chunks of the heap in parallel,
+ * otherwise walk all objects in the heap in a single threaded linear fashion.
+ */
+void
+MM_ParallelHeapWalker::allObjectsDoBatched(MM_EnvironmentBase *env, MM_HeapWalkerObjectBatchFunc function, void *userData, uintptr_t walkFlags, bool parallel, bool prepareHeapForWalk)
+{
+	if (parallel) {
+		bool wasMarkMapValid = _markMap->isMarkMapValid();
+		GC_OMRVMInterface::flushCachesForWalk(env->getOmrVM());
+		if (prepareHeapForWalk) {
+			_globalCollector->prepareHeapForWalk(env);
+			/* the mark just run describes the live set exactly, so the walk can cut regions into chunks */
+			_markMap->setMarkMapValid(true);
+		}
+
+		MM_ParallelObjectBatchDoTask objectBatchDoTask(env, this, function, userData, walkFlags);
+		env->getExtensions()->dispatcher->run(env, &objectBatchDoTask);
+		_markMap->setMarkMapValid(wasMarkMapValid);
+	} else {
+		MM_HeapWalker::allObjectsDoBatched(env, function, userData, walkFlags, parallel, prepareHeapForWalk);
+	}
+}
+
 /**
  * gets the heap walker and calls the actual objectSlotsDo function
  */
@@ -170,3 +295,12 @@ MM_ParallelObjectDoTask::run(MM_EnvironmentBase *env)
 {
 	_heapWalker->allObjectsDoParallel(env, _function, _userData, _walkFlags);
 }
+
+/**
+ * gets the heap walker and calls the actual batched object walk
+ */
+void
+MM_ParallelObjectBatchDoTask::run(MM_EnvironmentBase *env)
+{
+	_heapWalker->allObjectsDoBatchedParallel(env, _function, _userData, _walkFlags);
+}
@@ -32,6 +32,9 @@ class MM_EnvironmentBase;
 class MM_ParallelGlobalGC;
 class MM_MarkMap;
 
+/* Largest chunk handed to a thread by a parallel walk, so that big heaps still split into enough work units to balance */
+#define PARALLEL_HEAP_WALKER_MAXIMUM_CHUNK_SIZE ((uintptr_t)64 * 1024 * 1024)
+
 class MM_ParallelHeapWalker : public MM_HeapWalker
 {
 	/*
@@ -47,6 +50,14 @@ public:
 	 * Function members
 	 */
 private:
+	/**
+	 * Determine the size of the chunks regions are cut into for a parallel walk. Chunks are only smaller than the heap
+	 * when the mark map is valid, since each one starts at its first marked object, and are aligned to mark map slots.
+	 * @param[out] heapChunkFactor the number of chunks the heap was divided into before capping the chunk size
+	 * @return the chunk size in bytes
+	 */
+	uintptr_t getParallelChunkSize(MM_EnvironmentBase *env, uintptr_t *heapChunkFactor);
+
 protected:
 public:	
 	/**
@@ -54,6 +65,13 @@ public:
 	 */
 	void allObjectsDoParallel(MM_EnvironmentBase *env, MM_HeapWalkerObjectFunc function, void *userData, uintptr_t walkFlags);
 
+	/**
+	 * Walk through all live objects of the heap in parallel, handing them to the provided function in batches.
+	 * Each thread collects the objects of the chunks it claims into its own buffer, which is flushed when full
+	 * and at the end of every region.
+	 */
+	void allObjectsDoBatchedParallel(MM_EnvironmentBase *env, MM_HeapWalkerObjectBatchFunc function, void *userData, uintptr_t walkFlags);
+
 	/**
 	 * Walk through all live objects of the heap and apply the provided function.
 	 * If parallel is set to true, task is dispatched to GC threads and walks the heap segments in parallel,
@@ -61,6 +79,13 @@ public:
 	 */
 	virtual void allObjectsDo(MM_EnvironmentBase *env, MM_HeapWalkerObjectFunc function, void *userData, uintptr_t walkFlags, bool parallel, bool prepareHeapForWalk, bool includeDeadObjects);
 
+	/**
+	 * Walk through all live objects of the heap, handing them to the provided function in batches.
+	 * If parallel is set to true, task is dispatched to GC threads which walk chunks of the heap in parallel,
+	 * otherwise walk all objects in the heap in a single threaded linear fashion.
+	 */
+	virtual void allObjectsDoBatched(MM_EnvironmentBase *env, MM_HeapWalkerObjectBatchFunc function, void *userData, uintptr_t walkFlags, bool parallel, bool prepareHeapForWalk);
+
 	MM_MarkMap *getMarkMap() {
 		return _markMap;
 	}
@@ -85,6 +110,7 @@ public:
 	 * Friends
 	 */
 	friend class MM_ParallelObjectDoTask;
+	friend class MM_ParallelObjectBatchDoTask;
 };
 
 #endif /* PARALLEL_HEAP_WALKER_HPP_ */
@@ -100,6 +100,15 @@ MM_ParallelMarkTask::cleanup(MM_EnvironmentBase *env)
 		env->_workPacketStats.workPacketsReleased,
 		env->_workPacketStats.workPacketsExchanged,
 		0/* TODO CRG figure out to get the array split size*/);
+#if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
+	/* retries are only counted when parallel statistics are compiled in */
+	if (env->getExtensions()->packetListLockFree) {
+		Trc_MM_ParallelMarkTask_packetListStats(
+			env->getLanguageVMThread(),
+			(uint32_t)env->getWorkerID(),
+			env->_workPacketStats.workPacketListCASRetries);
+	}
+#endif /* J9MODRON_TGC_PARALLEL_STATISTICS */
 }
 
 #if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
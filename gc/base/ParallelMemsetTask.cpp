@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#include <string.h>
+
+#include "ParallelMemsetTask.hpp"
+
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "ParallelDispatcher.hpp"
+
+#include "ut_j9mm.h"
+
+void
+MM_ParallelMemsetTask::run(MM_EnvironmentBase *env)
+{
+	for (uintptr_t i = 0; i < _rangeCount; i++) {
+		uint8_t *base = (uint8_t *)_ranges[i].base;
+		uint8_t *top = base + _ranges[i].size;
+		for (uint8_t *chunk = base; chunk < top; chunk += PARALLEL_MEMSET_CHUNK_SIZE) {
+			if (J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
+				uintptr_t chunkSize = OMR_MIN(PARALLEL_MEMSET_CHUNK_SIZE, (uintptr_t)(top - chunk));
+				memset(chunk, _value, chunkSize);
+			}
+		}
+	}
+}
+
+bool
+MM_ParallelMemsetTask::setRanges(MM_EnvironmentBase *env, MM_MemsetRange *ranges, uintptr_t rangeCount, uint8_t value)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	MM_ParallelDispatcher *dispatcher = extensions->dispatcher;
+
+	uintptr_t totalSize = 0;
+	for (uintptr_t i = 0; i < rangeCount; i++) {
+		totalSize += ranges[i].size;
+	}
+
+	/* heap ranges are added before the dispatcher threads start, and may be added by a thread
+	 * that is already running a task; both cases set the memory on the calling thread
+	 */
+	bool parallel = (0 != extensions->parallelMemsetMinimumSize)
+		&& (totalSize >= extensions->parallelMemsetMinimumSize)
+		&& (NULL != dispatcher)
+		&& (1 < dispatcher->threadCount())
+		&& (NULL == env->_currentTask)
+		&& (NULL != env->getOmrVMThread())
+		&& (0 < env->getOmrVMThread()->exclusiveCount)
+		&& !dispatcher->isTaskDispatched();
+
+	if (parallel) {
+		MM_ParallelMemsetTask memsetTask(env, dispatcher, ranges, rangeCount, value);
+		dispatcher->run(env, &memsetTask);
+	} else {
+		for (uintptr_t i = 0; i < rangeCount; i++) {
+			memset(ranges[i].base, value, ranges[i].size);
+		}
+	}
+
+	Trc_MM_ParallelMemsetTask_setRanges(env->getLanguageVMThread(), totalSize, rangeCount, parallel ? "parallel" : "serial");
+
+	return parallel;
+}
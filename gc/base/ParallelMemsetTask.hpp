@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base
+ */
+
+#if !defined(PARALLELMEMSETTASK_HPP_)
+#define PARALLELMEMSETTASK_HPP_
+
+#include "omrcfg.h"
+#include "omrmodroncore.h"
+
+#include "ParallelTask.hpp"
+
+class MM_EnvironmentBase;
+class MM_ParallelDispatcher;
+
+/**
+ * Bytes of a range set by one work unit of a parallel memset.
+ */
+#define PARALLEL_MEMSET_CHUNK_SIZE (256 * 1024)
+
+/**
+ * A byte range of side metadata to be set to one value.
+ */
+typedef struct MM_MemsetRange {
+	void *base;
+	uintptr_t size;
+} MM_MemsetRange;
+
+/**
+ * Sets byte ranges of side metadata (card tables, mark maps and the like) to a value, splitting
+ * them into work units shared by the GC dispatcher threads.
+ * @ingroup GC_Base
+ */
+class MM_ParallelMemsetTask : public MM_ParallelTask
+{
+private:
+	MM_MemsetRange *_ranges;
+	uintptr_t _rangeCount;
+	uint8_t _value;
+
+public:
+	virtual uintptr_t getVMStateID() { return OMRVMSTATE_GC_CLEANING_METADATA; };
+
+	virtual void run(MM_EnvironmentBase *env);
+
+	/**
+	 * Set the ranges to value, on the dispatcher threads if the calling thread can dispatch a task and
+	 * the ranges are large enough to repay waking the threads, otherwise on the calling thread.  Only a
+	 * thread holding exclusive VM access, outside of any other task, dispatches.
+	 * @param env[in] the calling thread
+	 * @param ranges[in] the ranges to set
+	 * @param rangeCount[in] the number of ranges
+	 * @param value[in] the byte value to store
+	 * @return true if the ranges were set by the dispatcher threads
+	 */
+	static bool setRanges(MM_EnvironmentBase *env, MM_MemsetRange *ranges, uintptr_t rangeCount, uint8_t value);
+
+	/**
+	 * Set a single range to value.
+	 * @see setRanges()
+	 */
+	static bool
+	setMemory(MM_EnvironmentBase *env, void *base, uintptr_t size, uint8_t value)
+	{
+		MM_MemsetRange range = { base, size };
+		return setRanges(env, &range, 1, value);
+	}
+
+	MM_ParallelMemsetTask(MM_EnvironmentBase *env, MM_ParallelDispatcher *dispatcher, MM_MemsetRange *ranges, uintptr_t rangeCount, uint8_t value) :
+		MM_ParallelTask(env, dispatcher)
+		,_ranges(ranges)
+		,_rangeCount(rangeCount)
+		,_value(value)
+	{
+		_typeId = __FUNCTION__;
+	};
+};
+
+#endif /* PARALLELMEMSETTASK_HPP_ */
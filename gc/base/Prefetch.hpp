@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base
+ */
+
+#if !defined(PREFETCH_HPP_)
+#define PREFETCH_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif /* defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64)) */
+
+/**
+ * Software prefetch hints. These never fault, so may be given any address, and compile
+ * to nothing on compilers without a prefetch intrinsic.
+ * @ingroup GC_Base
+ */
+class MM_Prefetch
+{
+public:
+	/**
+	 * Hint that the cache line containing address will soon be read.
+	 * @param address the address to prefetch
+	 */
+	static MMINLINE void
+	prefetchRead(const void *address)
+	{
+#if defined(__xlC__) && !defined(__clang__)
+		__dcbt((void *)address);
+#elif defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+		_mm_prefetch((const char *)address, _MM_HINT_T0);
+#endif /* defined(__xlC__) && !defined(__clang__) */
+	}
+};
+
+#endif /* PREFETCH_HPP_ */
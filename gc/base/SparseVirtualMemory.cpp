@@ -71,10 +71,25 @@ MM_SparseVirtualMemory::initialize(MM_EnvironmentBase *env, uint32_t memoryCateg
 	uintptr_t ceilLog2 = MM_Math::floorLog2(regionCount) + 1;
 
 	uintptr_t off_heap_size = (uintptr_t)((ceilLog2 * in_heap_size) / 2);
+	uintptr_t requestedGranule = env->getExtensions()->sparseHeapAllocationGranule;
+	if (requestedGranule > _pageSize) {
+		/* leave room to align the base to the granule */
+		off_heap_size = MM_Math::roundToCeiling(requestedGranule, off_heap_size) + requestedGranule;
+	}
 	bool success = MM_VirtualMemory::initialize(env, off_heap_size, NULL, NULL, 0, memoryCategory);
 
 	if (success) {
+		/* The page size is now the one actually reserved. If huge pages were not available, allocating whole
+		 * granules still lets transparent huge pages back the data, but only when THP is enabled "always" or,
+		 * in "madvise" mode, when the port library advises the reservation with MADV_HUGEPAGE: it does so while
+		 * vmemEnableMadvise is set, which it is in that mode unless OMRPORT_CTLDATA_VMEM_ADVISE_HUGEPAGE cleared it.
+		 * Granules are only aligned while the data is allocated in whole granules; smaller data packed in
+		 * between offsets later granules, which then have only their aligned interior backed by huge pages.
+		 */
+		_allocationGranule = OMR_MAX(_pageSize, requestedGranule);
+		Assert_MM_true(0 == (_allocationGranule % _pageSize));
 		void *sparseHeapBase = getHeapBase();
+		off_heap_size = MM_Math::roundToFloor(_allocationGranule, (uintptr_t)getHeapTop() - (uintptr_t)sparseHeapBase);
 		_sparseDataPool = MM_SparseAddressOrderedFixedSizeDataPool::newInstance(env, sparseHeapBase, off_heap_size);
 		if ((NULL == _sparseDataPool) || omrthread_monitor_init_with_name(&_largeObjectVirtualMemoryMutex, 0, "SparseVirtualMemory::_largeObjectVirtualMemoryMutex")) {
 			success = false;
@@ -125,11 +140,21 @@ MM_SparseVirtualMemory::updateSparseDataEntryAfterObjectHasMoved(void *dataPtr,
 void *
 MM_SparseVirtualMemory::allocateSparseFreeEntryAndMapToHeapObject(void *proxyObjPtr, uintptr_t size)
 {
-	/* Committing and de-committing memory sizes must be multiple of pagesize */
+	/* Committing and de-committing memory sizes must be multiple of pagesize. Data of at least a granule is
+	 * rounded up to whole granules so huge pages can back it, smaller data is not inflated to a granule.
+	 */
 	uintptr_t adjustedSize = MM_Math::roundToCeiling(_pageSize, size);
+	if (size >= _allocationGranule) {
+		adjustedSize = MM_Math::roundToCeiling(_allocationGranule, size);
+	}
 
 	omrthread_monitor_enter(_largeObjectVirtualMemoryMutex);
 	void *sparseHeapAddr = _sparseDataPool->findFreeListEntry(adjustedSize);
+	if ((NULL == sparseHeapAddr) && (0 != _pendingDecommitCount)) {
+		/* Regions waiting to be decommitted may be what is needed */
+		decommitPendingRegions(NULL);
+		sparseHeapAddr = _sparseDataPool->findFreeListEntry(adjustedSize);
+	}
 	bool success = MM_VirtualMemory::commitMemory(sparseHeapAddr, adjustedSize);
 
 #if defined(OSX) || defined(OMRZTPF)
@@ -162,7 +187,20 @@ MM_SparseVirtualMemory::freeSparseRegionAndUnmapFromHeapObject(MM_EnvironmentBas
 	uintptr_t dataSize = _sparseDataPool->findObjectDataSizeForSparseDataPtr(dataPtr);
 	bool ret = true;
 
-	if ((NULL != dataPtr) && (0 != dataSize)) {
+	if ((NULL != dataPtr) && (0 != dataSize) && (0 != env->getExtensions()->sparseHeapDecommitBatchSize)) {
+		Assert_MM_true(0 == (dataSize % _pageSize));
+		/* The region is not reused until it is decommitted, which zeroes it for its next allocation */
+		omrthread_monitor_enter(_largeObjectVirtualMemoryMutex);
+		ret = _sparseDataPool->unmapSparseDataPtrFromHeapProxyObjectPtr(dataPtr);
+		_pendingDecommits[_pendingDecommitCount].address = dataPtr;
+		_pendingDecommits[_pendingDecommitCount].size = dataSize;
+		_pendingDecommitCount += 1;
+		_pendingDecommitBytes += dataSize;
+		if ((SPARSE_HEAP_DECOMMIT_BATCH_MAXIMUM_RANGES == _pendingDecommitCount) || (_pendingDecommitBytes >= env->getExtensions()->sparseHeapDecommitBatchSize)) {
+			ret = decommitPendingRegions(env) && ret;
+		}
+		omrthread_monitor_exit(_largeObjectVirtualMemoryMutex);
+	} else if ((NULL != dataPtr) && (0 != dataSize)) {
 		Assert_MM_true(0 == (dataSize % _pageSize));
 		ret = decommitMemory(env, dataPtr, dataSize);
 		if (ret) {
@@ -179,6 +217,68 @@ MM_SparseVirtualMemory::freeSparseRegionAndUnmapFromHeapObject(MM_EnvironmentBas
 
 	return ret;
 }
+
+bool
+MM_SparseVirtualMemory::decommitFreedSparseRegions(MM_EnvironmentBase *env)
+{
+	omrthread_monitor_enter(_largeObjectVirtualMemoryMutex);
+	bool ret = decommitPendingRegions(env);
+	omrthread_monitor_exit(_largeObjectVirtualMemoryMutex);
+	return ret;
+}
+
+int
+MM_SparseVirtualMemory::compareDecommitRanges(const void *left, const void *right)
+{
+	uintptr_t leftAddress = (uintptr_t)((MM_SparseDecommitRange *)left)->address;
+	uintptr_t rightAddress = (uintptr_t)((MM_SparseDecommitRange *)right)->address;
+	if (leftAddress < rightAddress) {
+		return -1;
+	}
+	return (leftAddress > rightAddress) ? 1 : 0;
+}
+
+bool
+MM_SparseVirtualMemory::decommitPendingRegions(MM_EnvironmentBase *env)
+{
+	bool ret = true;
+	uintptr_t rangeCount = 0;
+
+	if (0 == _pendingDecommitCount) {
+		return ret;
+	}
+
+	J9_SORT(_pendingDecommits, _pendingDecommitCount, sizeof(MM_SparseDecommitRange), compareDecommitRanges);
+
+	uintptr_t index = 0;
+	while (index < _pendingDecommitCount) {
+		void *rangeBase = _pendingDecommits[index].address;
+		uintptr_t rangeSize = _pendingDecommits[index].size;
+		index += 1;
+		/* Regions freed next to each other are decommitted with one call */
+		while ((index < _pendingDecommitCount) && (((uintptr_t)rangeBase + rangeSize) == (uintptr_t)_pendingDecommits[index].address)) {
+			rangeSize += _pendingDecommits[index].size;
+			index += 1;
+		}
+
+		if (decommitMemory(env, rangeBase, rangeSize)) {
+			Trc_MM_SparseVirtualMemory_decommitMemory_success(rangeBase, (void *)rangeSize);
+			ret = _sparseDataPool->returnFreeListEntry(rangeBase, rangeSize) && ret;
+		} else {
+			Trc_MM_SparseVirtualMemory_decommitMemory_failure(rangeBase, (void *)rangeSize);
+			Assert_MM_true(false);
+			ret = false;
+		}
+		rangeCount += 1;
+	}
+
+	Trc_MM_SparseVirtualMemory_decommitPendingRegions(_pendingDecommitCount, rangeCount, _pendingDecommitBytes);
+	_pendingDecommitCount = 0;
+	_pendingDecommitBytes = 0;
+
+	return ret;
+}
+
 bool
 MM_SparseVirtualMemory::decommitMemory(MM_EnvironmentBase *env, void *address, uintptr_t size)
 {
@@ -36,12 +36,22 @@
 #include "BaseVirtual.hpp"
 #include "VirtualMemory.hpp"
 
+#define SPARSE_HEAP_DECOMMIT_BATCH_MAXIMUM_RANGES 64
+
 class MM_GCExtensions;
 class MM_GCExtensionsBase;
 class MM_Heap;
 class MM_SparseAddressOrderedFixedSizeDataPool;
 struct J9PortVmemParams;
 
+/**
+ * A freed sparse heap region waiting to be decommitted with the rest of its batch.
+ */
+struct MM_SparseDecommitRange {
+	void *address; /**< base of the freed region */
+	uintptr_t size; /**< size of the freed region in bytes */
+};
+
 /**
  * Large virtual memory for allocation of large objects (their data portion). It's sparsely
  * committed only for live objects (memory is eagerly committed/de-committed on allocate/free).
@@ -60,22 +70,38 @@ private:
 	MM_Heap *_heap; /**< reference to in-heap */
 	MM_SparseAddressOrderedFixedSizeDataPool *_sparseDataPool; /**< Structure that manages data and free region of sparse virtual memory */
 	omrthread_monitor_t _largeObjectVirtualMemoryMutex; /**< Monitor that manages access to sparse virtual memory */
+	uintptr_t _allocationGranule; /**< size and alignment of sparse data allocations, a multiple of the page size */
+	MM_SparseDecommitRange _pendingDecommits[SPARSE_HEAP_DECOMMIT_BATCH_MAXIMUM_RANGES]; /**< freed regions not yet decommitted nor returned to the free list */
+	uintptr_t _pendingDecommitCount; /**< number of entries in _pendingDecommits */
+	uintptr_t _pendingDecommitBytes; /**< total size of the regions in _pendingDecommits */
 protected:
 public:
 /*
  * Function members
  */
 private:
+	/**
+	 * Decommit the pending freed regions, coalescing adjacent ones into a single decommit, and return them
+	 * to the free list. Caller must hold _largeObjectVirtualMemoryMutex.
+	 *
+	 * @return true if every region was decommitted, false otherwise
+	 */
+	bool decommitPendingRegions(MM_EnvironmentBase *env);
+
+	static int compareDecommitRanges(const void *left, const void *right);
 
 protected:
 	bool initialize(MM_EnvironmentBase* env, uint32_t memoryCategory);
 	void tearDown(MM_EnvironmentBase *env);
 
 	MM_SparseVirtualMemory(MM_EnvironmentBase* env, uintptr_t pageSize, uintptr_t pageFlags, MM_Heap *in_heap)
-		: MM_VirtualMemory(env, env->getExtensions()->heapAlignment, pageSize, pageFlags, 0, OMRPORT_VMEM_MEMORY_MODE_READ | OMRPORT_VMEM_MEMORY_MODE_WRITE)
+		: MM_VirtualMemory(env, OMR_MAX(env->getExtensions()->heapAlignment, env->getExtensions()->sparseHeapAllocationGranule), pageSize, pageFlags, 0, OMRPORT_VMEM_MEMORY_MODE_READ | OMRPORT_VMEM_MEMORY_MODE_WRITE)
 		, _heap(in_heap)
 		, _sparseDataPool(NULL)
 		, _largeObjectVirtualMemoryMutex(NULL)
+		, _allocationGranule(pageSize)
+		, _pendingDecommitCount(0)
+		, _pendingDecommitBytes(0)
 	{
 		_typeId = __FUNCTION__;
 	}
@@ -115,6 +141,15 @@ public:
 	 */
 	bool freeSparseRegionAndUnmapFromHeapObject(MM_EnvironmentBase* env, void *dataPtr);
 
+	/**
+	 * Freed regions are decommitted in batches of sparseHeapDecommitBatchSize bytes. Decommit and
+	 * return to the free list whatever is pending now. Called at the end of every collection, so
+	 * data freed by its sweep is not held past it.
+	 *
+	 * @return true if every pending region was decommitted, false otherwise
+	 */
+	bool decommitFreedSparseRegions(MM_EnvironmentBase* env);
+
 	/**
 	 * Decommits/Releases memory, returning the associated pages to the OS
 	 *
@@ -135,6 +170,25 @@ public:
 		return _reserveSize;
 	}
 
+	/* the page size actually reserved, which is not the requested one if huge pages were not available */
+	using MM_VirtualMemory::getPageSize;
+
+	/**
+	 * Get the size (and alignment) of sparse data allocations of at least this size
+	 */
+	MMINLINE uintptr_t getAllocationGranule()
+	{
+		return _allocationGranule;
+	}
+
+	/**
+	 * Get the number of bytes freed but not yet decommitted
+	 */
+	MMINLINE uintptr_t getPendingDecommitBytes()
+	{
+		return _pendingDecommitBytes;
+	}
+
 	/**
 	 * Get the sparseDataPool for sparse virtual memory
 	 */
@@ -430,6 +430,8 @@ MM_SweepPoolManagerAddressOrderedListBase::connectFinalChunk(
 
 	/* Validate sweeps free space accounting */
 	assume0(memoryPool->isMemoryPoolValid(envModron, false));
+
+	((MM_MemoryPoolAddressOrderedListBase *)memoryPool)->buildFreeListIndex(envModron);
 }
 
 /**
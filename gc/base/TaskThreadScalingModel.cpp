@@ -0,0 +1,189 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base_Core
+ */
+
+#include <string.h>
+
+#include "omrcfg.h"
+
+#include "TaskThreadScalingModel.hpp"
+
+/**
+ * Weight kept by older samples each time a new one is recorded, so a task's curve reflects roughly its last ten runs.
+ */
+#define TASK_SCALING_SAMPLE_DECAY 0.9
+
+/**
+ * Minimum normalized determinant of the least squares system before the fit is trusted.
+ */
+#define TASK_SCALING_MINIMUM_DETERMINANT 1.0e-6
+
+void
+MM_TaskThreadScalingModel::initialize(float tolerance)
+{
+	memset(_tasks, 0, sizeof(_tasks));
+	_tolerance = tolerance;
+}
+
+MM_TaskThreadScalingModel::TaskSamples *
+MM_TaskThreadScalingModel::findTask(uintptr_t vmStateID, bool create)
+{
+	uintptr_t start = vmStateID % TASK_TABLE_SIZE;
+	for (uintptr_t probe = 0; probe < TASK_TABLE_SIZE; probe++) {
+		TaskSamples *task = &_tasks[(start + probe) % TASK_TABLE_SIZE];
+		if (vmStateID == task->vmStateID) {
+			return task;
+		}
+		if (0 == task->vmStateID) {
+			if (create) {
+				task->vmStateID = vmStateID;
+				return task;
+			}
+			break;
+		}
+	}
+	return NULL;
+}
+
+bool
+MM_TaskThreadScalingModel::fit(TaskSamples *task, double *coefficients)
+{
+	if (!task->multipleThreadCounts) {
+		return false;
+	}
+
+	/* Normal equations for T = a + b/n + c*n; the (1/n, n) cross terms sum to the sample weight */
+	double m00 = task->weight, m01 = task->inverse, m02 = task->threads;
+	double m11 = task->inverseSquared, m12 = task->weight, m22 = task->threadsSquared;
+	double r0 = task->time, r1 = task->inverseTime, r2 = task->threadsTime;
+
+	double c00 = (m11 * m22) - (m12 * m12);
+	double c01 = (m01 * m22) - (m12 * m02);
+	double c02 = (m01 * m12) - (m11 * m02);
+	double determinant = (m00 * c00) - (m01 * c01) + (m02 * c02);
+	double scale = m00 * m11 * m22;
+	if ((scale <= 0.0) || ((determinant / scale) < TASK_SCALING_MINIMUM_DETERMINANT)) {
+		/* Fewer than three distinct thread counts carry weight, so the curve is not determined yet */
+		return false;
+	}
+
+	/* Cramer's rule */
+	coefficients[0] = ((r0 * c00) - (m01 * ((r1 * m22) - (m12 * r2))) + (m02 * ((r1 * m12) - (m11 * r2)))) / determinant;
+	coefficients[1] = ((m00 * ((r1 * m22) - (m12 * r2))) - (r0 * c01) + (m02 * ((m01 * r2) - (r1 * m02)))) / determinant;
+	coefficients[2] = ((m00 * ((m11 * r2) - (r1 * m12))) - (m01 * ((m01 * r2) - (r1 * m02))) + (r0 * c02)) / determinant;
+	return true;
+}
+
+bool
+MM_TaskThreadScalingModel::fitWithoutCoordination(TaskSamples *task, double *coefficients)
+{
+	if (!task->multipleThreadCounts) {
+		return false;
+	}
+
+	/* Normal equations for T = a + b/n */
+	double m00 = task->weight, m01 = task->inverse, m11 = task->inverseSquared;
+	double r0 = task->time, r1 = task->inverseTime;
+
+	double determinant = (m00 * m11) - (m01 * m01);
+	double scale = m00 * m11;
+	if ((scale <= 0.0) || ((determinant / scale) < TASK_SCALING_MINIMUM_DETERMINANT)) {
+		return false;
+	}
+
+	coefficients[0] = ((r0 * m11) - (m01 * r1)) / determinant;
+	coefficients[1] = ((m00 * r1) - (m01 * r0)) / determinant;
+	coefficients[2] = 0.0;
+	return true;
+}
+
+uintptr_t
+MM_TaskThreadScalingModel::recommendThreadCount(MM_EnvironmentBase *env, uintptr_t vmStateID, uintptr_t maximumThreadCount)
+{
+	TaskSamples *task = findTask(vmStateID, true);
+	if ((NULL == task) || (maximumThreadCount < 2)) {
+		return maximumThreadCount;
+	}
+
+	task->dispatchCount += 1;
+
+	/* Below three threads the budget cannot spread samples over three distinct counts, so drop the coordination term */
+	double coefficients[3];
+	if (!fit(task, coefficients) && ((maximumThreadCount >= 3) || !fitWithoutCoordination(task, coefficients))) {
+		/* Probe the full, half and quarter thread counts to spread the samples over the curve */
+		uintptr_t threadCount = maximumThreadCount >> (task->dispatchCount % 3);
+		return OMR_MAX(threadCount, 1);
+	}
+
+	/* Find the predicted minimum, then the fewest threads predicted to come within the tolerance of it */
+	double bestTime = predictTime(coefficients, 1);
+	for (uintptr_t threadCount = 2; threadCount <= maximumThreadCount; threadCount++) {
+		bestTime = OMR_MIN(bestTime, predictTime(coefficients, threadCount));
+	}
+	double acceptableTime = bestTime + (((bestTime < 0.0) ? -bestTime : bestTime) * _tolerance);
+	uintptr_t recommended = 1;
+	while ((recommended < maximumThreadCount) && (predictTime(coefficients, recommended) > acceptableTime)) {
+		recommended += 1;
+	}
+
+	if (0 == (task->dispatchCount % PROBE_INTERVAL)) {
+		/* Alternate between a quarter more and a quarter fewer threads to keep the curve current around the choice */
+		uintptr_t step = OMR_MAX(recommended / 4, 1);
+		if (0 == ((task->dispatchCount / PROBE_INTERVAL) % 2)) {
+			recommended = OMR_MIN(recommended + step, maximumThreadCount);
+		} else {
+			recommended = (recommended > step) ? (recommended - step) : 1;
+		}
+	}
+
+	return recommended;
+}
+
+void
+MM_TaskThreadScalingModel::recordSample(MM_EnvironmentBase *env, uintptr_t vmStateID, uintptr_t threadCount, uint64_t elapsedMicros)
+{
+	TaskSamples *task = findTask(vmStateID, true);
+	if ((NULL == task) || (0 == threadCount)) {
+		return;
+	}
+
+	if ((0 != task->lastThreadCount) && (threadCount != task->lastThreadCount)) {
+		task->multipleThreadCounts = true;
+	}
+	task->lastThreadCount = threadCount;
+
+	double n = (double)threadCount;
+	double t = (double)elapsedMicros;
+	double decay = TASK_SCALING_SAMPLE_DECAY;
+	task->weight = (task->weight * decay) + 1.0;
+	task->inverse = (task->inverse * decay) + (1.0 / n);
+	task->threads = (task->threads * decay) + n;
+	task->inverseSquared = (task->inverseSquared * decay) + (1.0 / (n * n));
+	task->threadsSquared = (task->threadsSquared * decay) + (n * n);
+	task->time = (task->time * decay) + t;
+	task->inverseTime = (task->inverseTime * decay) + (t / n);
+	task->threadsTime = (task->threadsTime * decay) + (t * n);
+}
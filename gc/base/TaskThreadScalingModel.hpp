@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base_Core
+ */
+
+#if !defined(TASKTHREADSCALINGMODEL_HPP_)
+#define TASKTHREADSCALINGMODEL_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "modronbase.h"
+
+#include "BaseNonVirtual.hpp"
+
+class MM_EnvironmentBase;
+
+/**
+ * Per task scaling curves learned from the wall time of dispatched tasks.
+ * Each task type (identified by its VM state) is modelled as
+ *
+ *     T(n) = serial + parallel / n + coordination * n
+ *
+ * fitted by exponentially decayed least squares over the observed (thread count, wall time) samples.
+ * Until a task has been sampled at enough different thread counts the model probes the range of
+ * thread counts, and it keeps probing neighbouring counts periodically so the curve follows changes
+ * in the workload.
+ * @ingroup GC_Base_Core
+ */
+class MM_TaskThreadScalingModel : public MM_BaseNonVirtual
+{
+	/*
+	 * Data members
+	 */
+private:
+	struct TaskSamples {
+		uintptr_t vmStateID; /**< task type the samples belong to (0 if the entry is unused) */
+		uintptr_t dispatchCount; /**< number of times a thread count was recommended for the task */
+		uintptr_t lastThreadCount; /**< thread count of the most recent sample */
+		bool multipleThreadCounts; /**< true once the task has been sampled at more than one thread count */
+		double weight; /**< decayed number of samples */
+		double inverse; /**< decayed sum of 1/n */
+		double threads; /**< decayed sum of n */
+		double inverseSquared; /**< decayed sum of 1/n^2 */
+		double threadsSquared; /**< decayed sum of n^2 */
+		double time; /**< decayed sum of T */
+		double inverseTime; /**< decayed sum of T/n */
+		double threadsTime; /**< decayed sum of T*n */
+	};
+
+	enum {
+		TASK_TABLE_SIZE = 32, /**< number of distinct task types that can be modelled */
+		PROBE_INTERVAL = 16 /**< once fitted, every PROBE_INTERVAL'th dispatch of a task tries a neighbouring thread count */
+	};
+
+	TaskSamples _tasks[TASK_TABLE_SIZE];
+	float _tolerance; /**< fraction by which the predicted time of the recommended thread count may exceed the predicted minimum */
+
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+private:
+	TaskSamples *findTask(uintptr_t vmStateID, bool create);
+
+	/**
+	 * Solve the decayed least squares fit for the task.
+	 * @return true if the samples determine the curve, in which case coefficients holds serial, parallel and coordination time
+	 */
+	bool fit(TaskSamples *task, double *coefficients);
+
+	/**
+	 * Solve the decayed least squares fit for the task with no coordination term, which two thread counts determine.
+	 * @return true if the samples determine the curve, in which case coefficients holds serial, parallel and (zero) coordination time
+	 */
+	bool fitWithoutCoordination(TaskSamples *task, double *coefficients);
+
+	MMINLINE double predictTime(double *coefficients, uintptr_t threadCount)
+	{
+		return coefficients[0] + (coefficients[1] / (double)threadCount) + (coefficients[2] * (double)threadCount);
+	}
+
+protected:
+public:
+	/**
+	 * Recommend the number of threads to dispatch a task with.
+	 * @param vmStateID the type of the task
+	 * @param maximumThreadCount the most threads the task may use (the CPU budget)
+	 * @return a thread count between 1 and maximumThreadCount
+	 */
+	uintptr_t recommendThreadCount(MM_EnvironmentBase *env, uintptr_t vmStateID, uintptr_t maximumThreadCount);
+
+	/**
+	 * Record the wall time of a completed task.
+	 * @param vmStateID the type of the task
+	 * @param threadCount the number of threads the task ran with
+	 * @param elapsedMicros the wall time of the task
+	 */
+	void recordSample(MM_EnvironmentBase *env, uintptr_t vmStateID, uintptr_t threadCount, uint64_t elapsedMicros);
+
+	void initialize(float tolerance);
+
+	MM_TaskThreadScalingModel()
+		: MM_BaseNonVirtual()
+		, _tolerance(0.0f)
+	{
+		_typeId = __FUNCTION__;
+		initialize(0.0f);
+	}
+};
+
+#endif /* TASKTHREADSCALINGMODEL_HPP_ */
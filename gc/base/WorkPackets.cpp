@@ -152,6 +152,20 @@ MM_WorkPackets::initialize(MM_EnvironmentBase *env)
 	for (uintptr_t i = 0; i < _maxPacketsBlocks; i++) {
 		_packetsStart[i] = NULL;
 	}
+
+	if (_extensions->packetListLockFree) {
+		/* lock-free packet lists reference packets by index so that list heads fit in a single tagged word */
+		_packetTable = (MM_Packet **)env->getForge()->allocate(sizeof(MM_Packet *) * _maxPackets, OMR::GC::AllocationCategory::WORK_PACKETS, OMR_GET_CALLSITE());
+		if (NULL == _packetTable) {
+			return false;
+		}
+		_emptyPacketList.setPacketTable(_packetTable);
+		_fullPacketList.setPacketTable(_packetTable);
+		_nonEmptyPacketList.setPacketTable(_packetTable);
+		_relativelyFullPacketList.setPacketTable(_packetTable);
+		_deferredPacketList.setPacketTable(_packetTable);
+		_deferredFullPacketList.setPacketTable(_packetTable);
+	}
 	
 	/* now allocate the initial active packets */
 	while (initialPacketCount > _activePackets) {
@@ -220,6 +234,10 @@ MM_WorkPackets::initWorkPacketsBlock(MM_EnvironmentBase *env)
 	for (uintptr_t i = 0; i < _packetsPerBlock; i++) {
 		baseAddress = (uintptr_t *) (dataStart + (i * dataSize));
 		currentPtr->initialize(env, nextPtr, previousPtr, baseAddress, _slotsInPacket);
+		currentPtr->setPacketIndex(_activePackets + i);
+		if (NULL != _packetTable) {
+			_packetTable[_activePackets + i] = currentPtr;
+		}
 
 		previousPtr = currentPtr;
 		currentPtr += 1;
@@ -257,6 +275,11 @@ MM_WorkPackets::tearDown(MM_EnvironmentBase *env)
 		}
 	}
 
+	if (NULL != _packetTable) {
+		env->getForge()->free(_packetTable);
+		_packetTable = NULL;
+	}
+
 	if (NULL != _inputListMonitor) {
 		omrthread_monitor_destroy(_inputListMonitor);
 		_inputListMonitor = NULL;
@@ -73,6 +73,7 @@ protected:
 	uintptr_t _packetsBlocksTop;
 	omrthread_monitor_t _allocatingPackets;
 	MM_Packet *_packetsStart[_maxPacketsBlocks];
+	MM_Packet **_packetTable; /**< Every allocated packet, indexed by MM_Packet::_packetIndex. Only allocated when packet lists are lock-free */
 	MM_PacketList _emptyPacketList;  /**< List for empty packets */
 	MM_PacketList _fullPacketList;  /**< List for full packets */
 	MM_PacketList _relativelyFullPacketList;  /**< List for relatively full packets */
@@ -237,6 +238,7 @@ public:
 		_activePackets(0),
 		_packetsBlocksTop(0),
 		_allocatingPackets(NULL),
+		_packetTable(NULL),
 		_emptyPacketList(env),
 		_fullPacketList(env),
 		_relativelyFullPacketList(env),
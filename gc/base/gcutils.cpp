@@ -198,6 +198,8 @@ getContractReasonAsString(ContractReason reason)
 		return "forced nursery contract";
 	case SOFT_MX_CONTRACT:
 		return "satisfy softmx";
+	case NURSERY_SIZING_MODEL_CONTRACT:
+		return "nursery sizing model";
 	default:
 		return "unknown";
 	}
@@ -229,6 +231,8 @@ getExpandReasonAsString(ExpandReason reason)
 		return "forced nursery expand";
 	case HINT_PREVIOUS_RUNS:
 		return "hint from previous runs";
+	case NURSERY_SIZING_MODEL_EXPAND:
+		return "nursery sizing model";
 	default:
 		return "unknown";
 	}
@@ -242,6 +246,8 @@ getLoaResizeReasonAsString(LoaResizeReason reason)
 		return "expand to align heap";
 	case LOA_EXPAND_FAILED_ALLOCATE:
 		return "expand on failed allocate";
+	case LOA_EXPAND_FRAGMENTED:
+		return "expand on estimated fragmentation";
 	case LOA_CONTRACT_AGGRESSIVE:
 		return "contract on aggressive gc";
 	case LOA_CONTRACT_MIN_SOA:
@@ -253,6 +259,31 @@ getLoaResizeReasonAsString(LoaResizeReason reason)
 	}
 }
 
+#if defined(OMR_GC_MODRON_SCAVENGER)
+/**
+ * Return the reason for a nursery sizing model decision as a string
+ * @param reason reason code
+ */
+const char *
+getNurserySizingReasonAsString(NurserySizingReason reason)
+{
+	switch(reason) {
+	case NURSERY_SIZING_WARMING_UP:
+		return "warming up";
+	case NURSERY_SIZING_SCAVENGE_RATIO:
+		return "smallest nursery within expected scavenge time ratio";
+	case NURSERY_SIZING_PAUSE_TARGET:
+		return "largest nursery within pause target";
+	case NURSERY_SIZING_PAUSE_TARGET_UNREACHABLE:
+		return "fixed scavenge cost exceeds pause target";
+	case NURSERY_SIZING_SIZE_FIXED:
+		return "nursery size not dynamic";
+	default:
+		return "unknown";
+	}
+}
+#endif /* OMR_GC_MODRON_SCAVENGER */
+
 const char *
 getSystemGCReasonAsString(uint32_t gcCode)
 {
@@ -46,6 +46,7 @@
 #include "SegregatedAllocationTracker.hpp"
 #include "SegregatedGC.hpp"
 #include "SizeClasses.hpp"
+#include "SizeClassTuner.hpp"
 
 #if defined(OMR_GC_SEGREGATED_HEAP)
 
@@ -80,11 +81,13 @@ MM_ConfigurationSegregated::initialize(MM_EnvironmentBase *env)
 
 	bool success = false;
 
-	/* OMRTODO investigate why these must be equal or it segfaults. */
 	MM_GCExtensionsBase *extensions = env->getExtensions();
-	extensions->splitAvailableListSplitAmount = extensions->gcThreadCount;
 
 	if (MM_Configuration::initialize(env)) {
+		/* OMRTODO investigate why these must be equal or it segfaults.
+		 * The GC thread count is only defaulted by MM_Configuration::initialize().
+		 */
+		extensions->splitAvailableListSplitAmount = extensions->gcThreadCount;
 		env->getOmrVM()->_sizeClasses = _delegate.getSegregatedSizeClasses(env);
 		if (NULL != env->getOmrVM()->_sizeClasses) {
 			extensions->setSegregatedHeap(true);
@@ -101,6 +104,11 @@ MM_ConfigurationSegregated::tearDown(MM_EnvironmentBase* env)
 {
 	MM_GCExtensionsBase* extensions = env->getExtensions();
 
+	if (NULL != extensions->sizeClassTuner) {
+		extensions->sizeClassTuner->kill(env);
+		extensions->sizeClassTuner = NULL;
+	}
+
 	if (NULL != extensions->defaultSizeClasses) {
 		extensions->defaultSizeClasses->kill(env);
 		extensions->defaultSizeClasses = NULL;
@@ -129,6 +137,12 @@ MM_ConfigurationSegregated::createDefaultMemorySpace(MM_EnvironmentBase *env, MM
 		return NULL;
 	}
 
+	if (extensions->sizeClassTuning) {
+		if (NULL == (extensions->sizeClassTuner = MM_SizeClassTuner::newInstance(env))) {
+			return NULL;
+		}
+	}
+
 	regionPool = MM_RegionPoolSegregated::newInstance(env, extensions->heapRegionManager);
 	if (NULL == regionPool) {
 		return NULL;
@@ -399,7 +399,9 @@ MM_RegionPoolSegregated::allocateRegionFromArrayletSizeClass(MM_EnvironmentBase
 
 /**
  * Attempt to satisfy a region allocation request by sweeping a region to make
- * it eligible for further allocation.
+ * it eligible for further allocation. Regions reach this path while an incremental
+ * sweep is in progress or, when segregatedLazySweep is enabled, for the whole time
+ * between a mark and the next cycle.
  */
 MM_HeapRegionDescriptorSegregated *
 MM_RegionPoolSegregated::sweepAndAllocateRegionFromSmallSizeClass(MM_EnvironmentBase *env, uintptr_t sizeClass)
@@ -408,8 +410,8 @@ MM_RegionPoolSegregated::sweepAndAllocateRegionFromSmallSizeClass(MM_Environment
 
 	if (region != NULL) {
 		_sweepScheme->sweepRegion(env, region);
-		/* Keep maintaining the occupancy info even while doing nondeterministic sweeps */
-		_smallOccupancy[sizeClass] = (_smallOccupancy[sizeClass] * 0.9f) + (region->getMemoryPoolACL()->getMarkCount() / region->getNumCells() * 0.1f );
+		/* Keep maintaining the occupancy info even while doing nondeterministic (or lazy) sweeps */
+		updateOccupancy(sizeClass, (region->getMemoryPoolACL()->getMarkCount() * 100) / region->getNumCells());
 		decrementCurrentCountOfSweepRegions(sizeClass, 1);
 		decrementCurrentTotalCountOfSweepRegions(1);
 		_smallFullRegions[sizeClass]->enqueue(region);
@@ -34,6 +34,7 @@
 #include "MemorySpace.hpp"
 #include "MemorySubSpace.hpp"
 #include "SizeClasses.hpp"
+#include "SizeClassTuner.hpp"
 #include "ObjectHeapIteratorSegregated.hpp"
 
 #include "SegregatedAllocationInterface.hpp"
@@ -87,6 +88,16 @@ MM_SegregatedAllocationInterface::initialize(MM_EnvironmentBase *env)
 		_frequentObjectsStats = MM_FrequentObjectsStats::newInstance(env);
 		result = (NULL != _frequentObjectsStats);
 	}
+
+	if (result && extensions->sizeClassTuning) {
+		uintptr_t histogramSize = sizeof(uintptr_t) * MM_SizeClassTuner::HISTOGRAM_BUCKETS;
+		_sizeHistogram = (uintptr_t *)env->getForge()->allocate(histogramSize, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+		if (NULL == _sizeHistogram) {
+			result = false;
+		} else {
+			memset(_sizeHistogram, 0, histogramSize);
+		}
+	}
 	
 	if (result) {
 		_allocationCache = _languageAllocationCache.getLanguageSegregatedAllocationCacheStruct(env);
@@ -113,6 +124,13 @@ MM_SegregatedAllocationInterface::tearDown(MM_EnvironmentBase *env)
 		_frequentObjectsStats->kill(env);
 		_frequentObjectsStats = NULL;
 	}
+
+	if (NULL != _sizeHistogram) {
+		/* Don't lose the allocations of a detaching thread */
+		flushSizeHistogram(env);
+		env->getForge()->free(_sizeHistogram);
+		_sizeHistogram = NULL;
+	}
 }
 
 /**
@@ -188,6 +206,10 @@ MM_SegregatedAllocationInterface::allocateObject(MM_EnvironmentBase *env, MM_All
 		++_stats._allocationCount;
 	}
 
+	if ((NULL != cell) && (NULL != _sizeHistogram) && (sizeInBytes <= OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES)) {
+		_sizeHistogram[MM_SizeClassTuner::getHistogramBucket(sizeInBytes)] += 1;
+	}
+
 	return cell;
 }
 
@@ -264,6 +286,19 @@ MM_SegregatedAllocationInterface::flushCache(MM_EnvironmentBase *env)
 	memset(_allocationCache, 0, sizeof(LanguageSegregatedAllocationCache));
 	env->getExtensions()->allocationStats.merge(&_stats);
 	_stats.clear();
+	flushSizeHistogram(env);
+}
+
+/**
+ * Merge the allocation sizes counted by this thread into the size class tuner.
+ */
+void
+MM_SegregatedAllocationInterface::flushSizeHistogram(MM_EnvironmentBase *env)
+{
+	MM_SizeClassTuner *tuner = env->getExtensions()->sizeClassTuner;
+	if ((NULL != _sizeHistogram) && (NULL != tuner)) {
+		tuner->mergeThreadHistogram(env, _sizeHistogram);
+	}
 }
 
 /**
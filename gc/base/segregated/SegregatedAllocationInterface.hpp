@@ -59,6 +59,8 @@ private:
 	
 	uintptr_t *_allocationCacheBases[OMR_SIZECLASSES_NUM_SMALL + 1]; /**< The Base of each current cache (per size class). */
 
+	uintptr_t *_sizeHistogram; /**< Small allocations counted per size granule since the last flush (NULL unless size class tuning is enabled). */
+
 	/*
 	 * Function members
 	 */
@@ -102,7 +104,8 @@ protected:
 	MM_SegregatedAllocationInterface(MM_EnvironmentBase *env) :
 		MM_ObjectAllocationInterface(env),
 		_sizeClasses(NULL),
-		_cachedAllocationsEnabled(true)
+		_cachedAllocationsEnabled(true),
+		_sizeHistogram(NULL)
 	{
 		_typeId = __FUNCTION__;
 		memset(_allocationCacheBases, 0, sizeof(_allocationCacheBases));
@@ -110,6 +113,7 @@ protected:
 	
 private:
 	void updateFrequentObjectsStats(MM_EnvironmentBase *env, uintptr_t sizeClass);
+	void flushSizeHistogram(MM_EnvironmentBase *env);
 	
 };
 
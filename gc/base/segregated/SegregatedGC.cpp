@@ -33,6 +33,7 @@
 #include "SegregatedAllocationInterface.hpp"
 #include "SegregatedMarkingScheme.hpp"
 #include "SegregatedSweepTask.hpp"
+#include "SizeClassTuner.hpp"
 #include "SweepSchemeSegregated.hpp"
 #include "SweepStats.hpp"
 #include "WorkPackets.hpp"
@@ -94,6 +95,8 @@ MM_SegregatedGC::initialize(MM_EnvironmentBase *env)
 	}
 
 	_sweepScheme->setClearMarkMapAfterSweep(false);
+	/* The mark map is only reset when the next mark starts so small regions may be swept lazily by mutators */
+	_sweepScheme->setDeferSmallSweep(_extensions->segregatedLazySweep);
 	return true;
 }
 
@@ -292,6 +295,11 @@ MM_SegregatedGC::internalPostCollect(MM_EnvironmentBase *env, MM_MemorySubSpace
 
 	/* OMRTODO dynamically set the minimum free entry size. See realtime gc for reference */
 
+	/* Thread allocation size histograms were merged when the caches were flushed for this GC */
+	if (NULL != _extensions->sizeClassTuner) {
+		_extensions->sizeClassTuner->globalCollectionCompleted(env, _extensions->defaultSizeClasses);
+	}
+
 #if defined(OMR_GC_OBJECT_MAP)
 	_markingScheme->setLiveObjectsAsValidObjects();
 #endif
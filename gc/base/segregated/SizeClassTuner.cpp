@@ -0,0 +1,358 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "omrcfg.h"
+#include "omrport.h"
+
+#include <string.h>
+
+#include "AtomicOperations.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "SizeClasses.hpp"
+
+#include "SizeClassTuner.hpp"
+
+#include "ut_j9mm.h"
+
+#if defined(OMR_GC_SEGREGATED_HEAP)
+
+MM_SizeClassTuner *
+MM_SizeClassTuner::newInstance(MM_EnvironmentBase *env)
+{
+	MM_SizeClassTuner *tuner = (MM_SizeClassTuner *)env->getForge()->allocate(sizeof(MM_SizeClassTuner), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != tuner) {
+		new(tuner) MM_SizeClassTuner(env);
+		if (!tuner->initialize(env)) {
+			tuner->kill(env);
+			tuner = NULL;
+		}
+	}
+	return tuner;
+}
+
+void
+MM_SizeClassTuner::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+bool
+MM_SizeClassTuner::initialize(MM_EnvironmentBase *env)
+{
+	memset((void *)_cycleHistogram, 0, sizeof(_cycleHistogram));
+	memset(_warmupHistogram, 0, sizeof(_warmupHistogram));
+	memset(_cycleWaste, 0, sizeof(_cycleWaste));
+	memset(_tunedCellSizes, 0, sizeof(_tunedCellSizes));
+
+	/* The tables are too large for the stack of a thread completing a collection, so they are allocated once up front */
+	uintptr_t tableSize = sizeof(uint64_t) * HISTOGRAM_BUCKETS;
+	uintptr_t choicesSize = sizeof(uint16_t) * (OMR_SIZECLASSES_NUM_SMALL + 1) * HISTOGRAM_BUCKETS;
+	uint8_t *tables = (uint8_t *)env->getForge()->allocate((4 * tableSize) + choicesSize, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL == tables) {
+		return false;
+	}
+	_prefixCounts = (uint64_t *)tables;
+	_prefixGranules = (uint64_t *)(tables + tableSize);
+	_previousWaste = (uint64_t *)(tables + (2 * tableSize));
+	_currentWaste = (uint64_t *)(tables + (3 * tableSize));
+	_choices = (uint16_t *)(tables + (4 * tableSize));
+
+	return true;
+}
+
+void
+MM_SizeClassTuner::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _prefixCounts) {
+		env->getForge()->free(_prefixCounts);
+		_prefixCounts = NULL;
+		_prefixGranules = NULL;
+		_previousWaste = NULL;
+		_currentWaste = NULL;
+		_choices = NULL;
+	}
+}
+
+void
+MM_SizeClassTuner::mergeThreadHistogram(MM_EnvironmentBase *env, uintptr_t *threadHistogram)
+{
+	for (uintptr_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+		uintptr_t count = threadHistogram[bucket];
+		if (0 != count) {
+			MM_AtomicOperations::add(&_cycleHistogram[bucket], count);
+			threadHistogram[bucket] = 0;
+		}
+	}
+}
+
+void
+MM_SizeClassTuner::globalCollectionCompleted(MM_EnvironmentBase *env, MM_SizeClasses *sizeClasses)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	uintptr_t *histogram = _intervalHistogram;
+	uintptr_t currentCellSizes[OMR_SIZECLASSES_NUM_SMALL + 1];
+	uintptr_t requestedBytes = 0;
+
+	/* Snapshot (and reset) the allocations of the interval; threads detaching now merge into the next one */
+	for (uintptr_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+		uintptr_t allocations = _cycleHistogram[bucket];
+		if (0 != allocations) {
+			MM_AtomicOperations::subtract(&_cycleHistogram[bucket], allocations);
+		}
+		histogram[bucket] = allocations;
+	}
+
+	currentCellSizes[0] = 0;
+	for (uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL; sizeClass <= OMR_SIZECLASSES_MAX_SMALL; sizeClass++) {
+		currentCellSizes[sizeClass] = sizeClasses->getCellSize(sizeClass);
+	}
+	computeWaste(histogram, currentCellSizes, _cycleWaste, &requestedBytes);
+
+	_tunedTableComputed = false;
+	if (_cyclesObserved < extensions->sizeClassTuningWarmupCycles) {
+		for (uintptr_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+			_warmupHistogram[bucket] += histogram[bucket];
+		}
+		_cyclesObserved += 1;
+
+		if ((_cyclesObserved == extensions->sizeClassTuningWarmupCycles) && computeCellSizes(_warmupHistogram, _tunedCellSizes)) {
+			_currentWastedBytes = computeWaste(_warmupHistogram, currentCellSizes, NULL, &_warmupRequestedBytes);
+			_tunedWastedBytes = computeWaste(_warmupHistogram, _tunedCellSizes, NULL, NULL);
+			_tunedTableComputed = true;
+
+			bool saved = false;
+			if ((_tunedWastedBytes < _currentWastedBytes) && (NULL != extensions->sizeClassTableFile)) {
+				saved = saveCellSizes(env, extensions->sizeClassTableFile, _tunedCellSizes);
+			}
+			Trc_MM_SizeClassTuner_tableComputed(env->getLanguageVMThread(), _cyclesObserved, _warmupRequestedBytes, _currentWastedBytes, _tunedWastedBytes, saved ? "true" : "false");
+		}
+	}
+}
+
+bool
+MM_SizeClassTuner::computeCellSizes(const uintptr_t *histogram, uintptr_t *cellSizes)
+{
+	const uintptr_t granules = HISTOGRAM_BUCKETS - 1;
+	const uintptr_t minimumGranule = ((uintptr_t)1 << OMR_SIZECLASSES_LOG_SMALLEST) >> GRANULE_SHIFT;
+
+	/* Prefix sums make the waste of the granules (i, j] served by a cell of j granules O(1):
+	 * sum(h[k] * (j - k)) = j * (count[j] - count[i]) - (weight[j] - weight[i])
+	 */
+	uint64_t runningCount = 0;
+	uint64_t runningWeight = 0;
+	for (uintptr_t granule = 0; granule <= granules; granule++) {
+		runningCount += histogram[granule];
+		runningWeight += (uint64_t)histogram[granule] * granule;
+		_prefixCounts[granule] = runningCount;
+		_prefixGranules[granule] = runningWeight;
+	}
+	if (0 == runningCount) {
+		return false;
+	}
+
+	/* _previousWaste[j] is the least waste of covering granules [0, j] with m size classes, the largest being j granules */
+	for (uintptr_t j = 0; j <= granules; j++) {
+		_previousWaste[j] = (j < minimumGranule) ? U_64_MAX : intervalWaste(0, j);
+		_choices[HISTOGRAM_BUCKETS + j] = 0;
+	}
+
+	/* The interval waste satisfies the quadrangle inequality (waste(a, d) + waste(b, c) - waste(a, c) - waste(b, d)
+	 * = (d - c) * (count[b] - count[a]) >= 0 for a <= b <= c <= d), so the best next smaller class never moves down
+	 * as the largest class grows and each placement can be divided and conquered rather than searched exhaustively.
+	 */
+	for (uintptr_t sizeClass = 2; sizeClass <= OMR_SIZECLASSES_NUM_SMALL; sizeClass++) {
+		uintptr_t lowestJ = minimumGranule + sizeClass - 1;
+		for (uintptr_t j = 0; j < lowestJ; j++) {
+			_currentWaste[j] = U_64_MAX;
+			_choices[(sizeClass * HISTOGRAM_BUCKETS) + j] = 0;
+		}
+		placeSizeClass(sizeClass, lowestJ, granules, lowestJ - 1, granules - 1);
+		uint64_t *swap = _previousWaste;
+		_previousWaste = _currentWaste;
+		_currentWaste = swap;
+	}
+
+	/* The largest class always covers the largest small size */
+	uintptr_t j = granules;
+	cellSizes[0] = 0;
+	for (uintptr_t sizeClass = OMR_SIZECLASSES_NUM_SMALL; sizeClass >= OMR_SIZECLASSES_MIN_SMALL; sizeClass--) {
+		cellSizes[sizeClass] = j << GRANULE_SHIFT;
+		j = _choices[(sizeClass * HISTOGRAM_BUCKETS) + j];
+	}
+
+	return true;
+}
+
+void
+MM_SizeClassTuner::placeSizeClass(uintptr_t sizeClass, uintptr_t lowJ, uintptr_t highJ, uintptr_t lowI, uintptr_t highI)
+{
+	while (lowJ <= highJ) {
+		uintptr_t j = lowJ + ((highJ - lowJ) / 2);
+		uintptr_t bestI = lowI;
+		uint64_t bestWaste = U_64_MAX;
+		uintptr_t lastI = OMR_MIN(highI, j - 1);
+		for (uintptr_t i = lowI; i <= lastI; i++) {
+			uint64_t waste = _previousWaste[i] + intervalWaste(i, j);
+			if (waste < bestWaste) {
+				bestWaste = waste;
+				bestI = i;
+			}
+		}
+		_currentWaste[j] = bestWaste;
+		_choices[(sizeClass * HISTOGRAM_BUCKETS) + j] = (uint16_t)bestI;
+
+		/* Recurse into the smaller half, iterate over the larger, to bound the depth */
+		if ((j - lowJ) < (highJ - j)) {
+			if (j > lowJ) {
+				placeSizeClass(sizeClass, lowJ, j - 1, lowI, bestI);
+			}
+			lowJ = j + 1;
+			lowI = bestI;
+		} else {
+			if (j < highJ) {
+				placeSizeClass(sizeClass, j + 1, highJ, bestI, highI);
+			}
+			if (j == lowJ) {
+				break;
+			}
+			highJ = j - 1;
+			highI = bestI;
+		}
+	}
+}
+
+uintptr_t
+MM_SizeClassTuner::computeWaste(const uintptr_t *histogram, const uintptr_t *cellSizes, SizeClassWaste *waste, uintptr_t *requestedBytes)
+{
+	uintptr_t totalWasted = 0;
+	uintptr_t totalRequested = 0;
+	uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL;
+
+	if (NULL != waste) {
+		memset(waste, 0, sizeof(SizeClassWaste) * (OMR_SIZECLASSES_NUM_SMALL + 1));
+	}
+
+	/* Requests are accounted at the top of their granule, which is exact for word aligned sizes on 64 bit */
+	for (uintptr_t bucket = 1; bucket < HISTOGRAM_BUCKETS; bucket++) {
+		uintptr_t size = bucket << GRANULE_SHIFT;
+		while (size > cellSizes[sizeClass]) {
+			sizeClass += 1;
+		}
+		uintptr_t allocations = histogram[bucket];
+		if (0 != allocations) {
+			uintptr_t wasted = allocations * (cellSizes[sizeClass] - size);
+			totalWasted += wasted;
+			totalRequested += allocations * size;
+			if (NULL != waste) {
+				waste[sizeClass].allocations += allocations;
+				waste[sizeClass].requestedBytes += allocations * size;
+				waste[sizeClass].wastedBytes += wasted;
+			}
+		}
+	}
+
+	if (NULL != requestedBytes) {
+		*requestedBytes = totalRequested;
+	}
+	return totalWasted;
+}
+
+bool
+MM_SizeClassTuner::isValidCellSizeTable(const uintptr_t *cellSizes)
+{
+	if (cellSizes[OMR_SIZECLASSES_MIN_SMALL] < ((uintptr_t)1 << OMR_SIZECLASSES_LOG_SMALLEST)) {
+		return false;
+	}
+	if (OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES != cellSizes[OMR_SIZECLASSES_MAX_SMALL]) {
+		return false;
+	}
+	for (uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL; sizeClass <= OMR_SIZECLASSES_MAX_SMALL; sizeClass++) {
+		if (0 != (cellSizes[sizeClass] & (((uintptr_t)1 << GRANULE_SHIFT) - 1))) {
+			return false;
+		}
+		if ((sizeClass > OMR_SIZECLASSES_MIN_SMALL) && (cellSizes[sizeClass] <= cellSizes[sizeClass - 1])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool
+MM_SizeClassTuner::loadCellSizes(MM_EnvironmentBase *env, const char *fileName, uintptr_t *cellSizes)
+{
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+	char buffer[CELL_SIZES_BUFFER_SIZE];
+
+	intptr_t fd = omrfile_open(fileName, EsOpenRead, 0);
+	if (-1 == fd) {
+		return false;
+	}
+	intptr_t bytesRead = omrfile_read(fd, buffer, sizeof(buffer) - 1);
+	omrfile_close(fd);
+	if (bytesRead <= 0) {
+		return false;
+	}
+	buffer[bytesRead] = '\0';
+
+	const char *cursor = buffer;
+	cellSizes[0] = 0;
+	for (uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL; sizeClass <= OMR_SIZECLASSES_MAX_SMALL; sizeClass++) {
+		while ((' ' == *cursor) || ('\t' == *cursor)) {
+			cursor += 1;
+		}
+		if ((*cursor < '0') || (*cursor > '9')) {
+			return false;
+		}
+		uintptr_t value = 0;
+		while ((*cursor >= '0') && (*cursor <= '9') && (value <= OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES)) {
+			value = (value * 10) + (uintptr_t)(*cursor - '0');
+			cursor += 1;
+		}
+		cellSizes[sizeClass] = value;
+	}
+
+	return isValidCellSizeTable(cellSizes);
+}
+
+bool
+MM_SizeClassTuner::saveCellSizes(MM_EnvironmentBase *env, const char *fileName, const uintptr_t *cellSizes)
+{
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+	char buffer[CELL_SIZES_BUFFER_SIZE];
+	uintptr_t length = 0;
+
+	for (uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL; sizeClass <= OMR_SIZECLASSES_MAX_SMALL; sizeClass++) {
+		length += omrstr_printf(buffer + length, sizeof(buffer) - length, (OMR_SIZECLASSES_MAX_SMALL == sizeClass) ? "%zu\n" : "%zu ", cellSizes[sizeClass]);
+	}
+
+	intptr_t fd = omrfile_open(fileName, EsOpenWrite | EsOpenCreate | EsOpenTruncate, 0666);
+	if (-1 == fd) {
+		return false;
+	}
+	bool result = ((intptr_t)length == omrfile_write(fd, buffer, length));
+	omrfile_close(fd);
+	return result;
+}
+
+#endif /* OMR_GC_SEGREGATED_HEAP */
@@ -0,0 +1,197 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#if !defined(SIZECLASSTUNER_HPP_)
+#define SIZECLASSTUNER_HPP_
+
+#include "omrcfg.h"
+#include "modronbase.h"
+#include "sizeclasses.h"
+
+#include "BaseNonVirtual.hpp"
+
+#if defined(OMR_GC_SEGREGATED_HEAP)
+
+class MM_EnvironmentBase;
+class MM_SizeClasses;
+
+/**
+ * Builds a histogram of small allocation sizes and derives from it a size class table that minimizes
+ * internal fragmentation (the bytes by which cells exceed the requests they satisfy).
+ *
+ * Threads count their allocations privately and merge them when their allocation caches are flushed.
+ * Every global collection reports the waste of the current table for the allocations since the previous
+ * collection. Once sizeClassTuningWarmupCycles collections have been observed a tuned table is computed
+ * and, if it wastes less than the current table, saved to sizeClassTableFile to be used at the next startup.
+ * The live table cannot be switched in place since every small region derives its cell size from it.
+ */
+class MM_SizeClassTuner : public MM_BaseNonVirtual
+{
+	/*
+	 * Data members
+	 */
+public:
+	enum {
+		GRANULE_SHIFT = 3, /**< size classes are tuned in 8 byte granules, which keeps every cell size suitably aligned */
+		HISTOGRAM_BUCKETS = (OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES >> GRANULE_SHIFT) + 1, /**< bucket i counts allocations of (8 * (i - 1), 8 * i] bytes */
+		CELL_SIZES_BUFFER_SIZE = (OMR_SIZECLASSES_NUM_SMALL * 21) + 2 /**< a table printed as decimal cell sizes of up to 20 digits, separated by a space and terminated by a newline and NUL */
+	};
+
+	struct SizeClassWaste {
+		uintptr_t allocations; /**< number of allocations satisfied by the size class */
+		uintptr_t requestedBytes; /**< bytes requested by those allocations */
+		uintptr_t wastedBytes; /**< bytes by which the cells exceeded the requests */
+	};
+
+private:
+	volatile uintptr_t _cycleHistogram[HISTOGRAM_BUCKETS]; /**< allocations since the last global collection, merged from the thread histograms */
+	uintptr_t _warmupHistogram[HISTOGRAM_BUCKETS]; /**< allocations accumulated over the warm-up collections */
+	SizeClassWaste _cycleWaste[OMR_SIZECLASSES_NUM_SMALL + 1]; /**< waste of the current table over the last completed collection interval */
+	uintptr_t _cyclesObserved; /**< global collections whose allocations have been accumulated in _warmupHistogram */
+	bool _tunedTableComputed; /**< true if the last completed collection computed a tuned table */
+	uintptr_t _tunedCellSizes[OMR_SIZECLASSES_NUM_SMALL + 1]; /**< the tuned table (valid once computed) */
+	uintptr_t _tunedWastedBytes; /**< bytes the tuned table would have wasted over the warm-up allocations */
+	uintptr_t _currentWastedBytes; /**< bytes the current table wasted over the warm-up allocations */
+	uintptr_t _warmupRequestedBytes; /**< bytes requested by the warm-up allocations */
+	uintptr_t _intervalHistogram[HISTOGRAM_BUCKETS]; /**< snapshot of _cycleHistogram taken at the end of a collection */
+	uint64_t *_prefixCounts; /**< HISTOGRAM_BUCKETS running allocation counts used by computeCellSizes() */
+	uint64_t *_prefixGranules; /**< HISTOGRAM_BUCKETS running sums of allocations times granules used by computeCellSizes() */
+	uint64_t *_previousWaste; /**< HISTOGRAM_BUCKETS least waste with one size class fewer, used by computeCellSizes() */
+	uint64_t *_currentWaste; /**< HISTOGRAM_BUCKETS least waste with the size class being placed, used by computeCellSizes() */
+	uint16_t *_choices; /**< (OMR_SIZECLASSES_NUM_SMALL + 1) * HISTOGRAM_BUCKETS largest granule of the next smaller size class, used by computeCellSizes() */
+
+	/*
+	 * Function members
+	 */
+public:
+	static MM_SizeClassTuner *newInstance(MM_EnvironmentBase *env);
+	void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * @return the histogram bucket counting allocations of the given size
+	 */
+	static MMINLINE uintptr_t getHistogramBucket(uintptr_t sizeInBytes)
+	{
+		return (sizeInBytes + ((uintptr_t)1 << GRANULE_SHIFT) - 1) >> GRANULE_SHIFT;
+	}
+
+	/**
+	 * Add the counts of a thread histogram to the global histogram and clear them.
+	 * May be called concurrently by several threads.
+	 * @param threadHistogram[in/out] HISTOGRAM_BUCKETS counts
+	 */
+	void mergeThreadHistogram(MM_EnvironmentBase *env, uintptr_t *threadHistogram);
+
+	/**
+	 * Account the allocations since the previous global collection against the current size classes and,
+	 * once warmed up, compute (and save) the tuned table. Must be called by a single thread after the
+	 * thread histograms have been merged.
+	 */
+	void globalCollectionCompleted(MM_EnvironmentBase *env, MM_SizeClasses *sizeClasses);
+
+	/**
+	 * @return waste of the given size class over the last completed collection interval
+	 */
+	MMINLINE const SizeClassWaste *getCycleWaste(uintptr_t sizeClass) const { return &_cycleWaste[sizeClass]; }
+
+	MMINLINE bool tunedTableComputed() const { return _tunedTableComputed; }
+	MMINLINE const uintptr_t *getTunedCellSizes() const { return _tunedCellSizes; }
+	MMINLINE uintptr_t getTunedWastedBytes() const { return _tunedWastedBytes; }
+	MMINLINE uintptr_t getCurrentWastedBytes() const { return _currentWastedBytes; }
+	MMINLINE uintptr_t getWarmupRequestedBytes() const { return _warmupRequestedBytes; }
+
+	/**
+	 * Compute the size class table minimizing the bytes wasted for the given histogram.
+	 * The work is O(OMR_SIZECLASSES_NUM_SMALL * HISTOGRAM_BUCKETS * log(HISTOGRAM_BUCKETS)) and uses
+	 * no stack space beyond a few words.
+	 * @param histogram[in] HISTOGRAM_BUCKETS allocation counts
+	 * @param cellSizes[out] OMR_SIZECLASSES_NUM_SMALL + 1 cell sizes (index 0 unused)
+	 * @return false if the histogram is empty
+	 */
+	bool computeCellSizes(const uintptr_t *histogram, uintptr_t *cellSizes);
+
+	/**
+	 * Attribute the allocations of a histogram to the size classes of a table.
+	 * @param waste[out] per size class accounting, may be NULL
+	 * @param requestedBytes[out] total bytes requested
+	 * @return total bytes wasted
+	 */
+	static uintptr_t computeWaste(const uintptr_t *histogram, const uintptr_t *cellSizes, SizeClassWaste *waste, uintptr_t *requestedBytes);
+
+	/**
+	 * @return true if the table is usable as small size classes: strictly increasing multiples of the
+	 * granule, starting no lower than the smallest size class and ending at the largest small size
+	 */
+	static bool isValidCellSizeTable(const uintptr_t *cellSizes);
+
+	/**
+	 * Read a table saved by saveCellSizes().
+	 * @return true if the file exists and holds a valid table
+	 */
+	static bool loadCellSizes(MM_EnvironmentBase *env, const char *fileName, uintptr_t *cellSizes);
+
+	/**
+	 * Save a table as a line of OMR_SIZECLASSES_NUM_SMALL decimal cell sizes.
+	 * @return true on success
+	 */
+	static bool saveCellSizes(MM_EnvironmentBase *env, const char *fileName, const uintptr_t *cellSizes);
+
+	MM_SizeClassTuner(MM_EnvironmentBase *env)
+		: MM_BaseNonVirtual()
+		, _cyclesObserved(0)
+		, _tunedTableComputed(false)
+		, _tunedWastedBytes(0)
+		, _currentWastedBytes(0)
+		, _warmupRequestedBytes(0)
+		, _prefixCounts(NULL)
+		, _prefixGranules(NULL)
+		, _previousWaste(NULL)
+		, _currentWaste(NULL)
+		, _choices(NULL)
+	{
+		_typeId = __FUNCTION__;
+	}
+
+protected:
+	bool initialize(MM_EnvironmentBase *env);
+	void tearDown(MM_EnvironmentBase *env);
+
+private:
+	/**
+	 * @return the bytes wasted when the allocations of granules (lower, upper] are served by cells of upper granules
+	 */
+	MMINLINE uint64_t
+	intervalWaste(uintptr_t lower, uintptr_t upper)
+	{
+		return ((uint64_t)upper * (_prefixCounts[upper] - _prefixCounts[lower])) - (_prefixGranules[upper] - _prefixGranules[lower]);
+	}
+
+	/**
+	 * Place the largest of sizeClass size classes at each of the granules [lowJ, highJ], knowing that the best
+	 * next smaller size class for them lies in [lowI, highI].
+	 */
+	void placeSizeClass(uintptr_t sizeClass, uintptr_t lowJ, uintptr_t highJ, uintptr_t lowI, uintptr_t highI);
+};
+
+#endif /* OMR_GC_SEGREGATED_HEAP */
+
+#endif /* SIZECLASSTUNER_HPP_ */
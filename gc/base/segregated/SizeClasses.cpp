@@ -22,6 +22,10 @@
 #include "SizeClasses.hpp"
 
 #include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "SizeClassTuner.hpp"
+
+#include "ut_j9mm.h"
 
 #if defined(OMR_GC_SEGREGATED_HEAP)
 
@@ -56,12 +60,18 @@ MM_SizeClasses::kill(MM_EnvironmentBase *env)
 bool
 MM_SizeClasses::initialize(MM_EnvironmentBase *env)
 {
+	MM_GCExtensionsBase *extensions = env->getExtensions();
 	OMR_SizeClasses* sizeClasses = env->getOmrVM()->_sizeClasses;
 	_smallCellSizes = sizeClasses->smallCellSizes;
 	_smallNumCells = sizeClasses->smallNumCells;
 	_sizeClassIndex = sizeClasses->sizeClassIndex;
 	
-	memcpy(_smallCellSizes, initialCellSizes, sizeof(initialCellSizes));
+	/* Prefer a table tuned by a previous run (see MM_SizeClassTuner) */
+	if ((NULL != extensions->sizeClassTableFile) && MM_SizeClassTuner::loadCellSizes(env, extensions->sizeClassTableFile, _smallCellSizes)) {
+		Trc_MM_SizeClasses_tableLoaded(env->getLanguageVMThread(), extensions->sizeClassTableFile);
+	} else {
+		memcpy(_smallCellSizes, initialCellSizes, sizeof(initialCellSizes));
+	}
 	
 	_sizeClassIndex[0] = 0;
 	_smallNumCells[0] = 0;
@@ -39,6 +39,8 @@
 #include "SweepSchemeSegregated.hpp"
 #include "HeapRegionQueue.hpp"
 
+#include "ut_j9mm.h"
+
 #if defined(OMR_GC_SEGREGATED_HEAP)
 
 /**
@@ -79,6 +81,7 @@ MM_SweepSchemeSegregated::kill(MM_EnvironmentBase *env)
 bool
 MM_SweepSchemeSegregated::initialize(MM_EnvironmentBase *env)
 {
+	_markMapWordScanner.initialize(env);
 	return true;
 }
 
@@ -118,7 +121,16 @@ MM_SweepSchemeSegregated::sweep(MM_EnvironmentBase *env, MM_MemoryPoolSegregated
 		env->_currentTask->releaseSynchronizedGCThreads(env);
 	}
 
-	incrementalSweepSmall(env);
+	if (_deferSmallSweep && !_isFixHeapForWalk) {
+		/* Small regions stay on their sweep lists: mutators sweep them on demand when replenishing their caches
+		 * (see MM_RegionPoolSegregated::sweepAndAllocateRegionFromSmallSizeClass) and the next cycle sweeps the rest.
+		 */
+		if (env->isMainThread()) {
+			Trc_MM_SweepSchemeSegregated_smallSweepDeferred(env->getLanguageVMThread(), regionPool->getCurrentTotalCountOfSweepRegions());
+		}
+	} else {
+		incrementalSweepSmall(env);
+	}
 	regionPool->joinBucketListsForSplitIndex(env);
 
 	if (env->_currentTask->synchronizeGCThreadsAndReleaseMain(env, UNIQUE_ID)) {
@@ -255,10 +267,8 @@ MM_SweepSchemeSegregated::sweepSmallRegion(MM_EnvironmentBase *env, MM_HeapRegio
 		} else {
 	 		/* attempt block sweeping slots with all 0s */
 			if ((0 == _markMap->getSlot(initialSlotIndex)) && (initialSlotIndex < lastCellSlotIndex)) {
-				slotIndex = initialSlotIndex;
-				do {
-					slotIndex++;
-				} while ((0 == _markMap->getSlot(slotIndex)) && (slotIndex < lastCellSlotIndex));
+				uintptr_t *markBits = _markMap->getHeapMapBits();
+				slotIndex = _markMapWordScanner.findNonEmptyWord(markBits + initialSlotIndex + 1, markBits + lastCellSlotIndex) - markBits;
 				sweepCostCounter += (slotIndex - initialSlotIndex);
 				/* nextCell is the lowest possible address of a cell
 				 * that may have mark bit in slotIndex (first slot not being all 0s) */
@@ -27,6 +27,7 @@
 #include "MemoryPoolAggregatedCellList.hpp"
 
 #include "Base.hpp"
+#include "MarkMapWordScanner.hpp"
 
 #if defined(OMR_GC_SEGREGATED_HEAP)
 
@@ -54,6 +55,8 @@ protected:
 private:
 	bool _isFixHeapForWalk;
 	bool _clearMarkMapAfterSweep; /**< If a region should be unmarked after it is swept */
+	bool _deferSmallSweep; /**< If small regions are left on their sweep lists to be swept by the first allocation that needs them */
+	MM_MarkMapWordScanner _markMapWordScanner; /**< Finds the end of runs of empty mark map words using the widest kernel the processor supports */
 
 	/*
 	 * Function members
@@ -69,6 +72,13 @@ public:
 
 	bool isClearMarkMapAfterSweep() { return _clearMarkMapAfterSweep; }
 	void setClearMarkMapAfterSweep(bool clearMarkMapAfterSweep) { _clearMarkMapAfterSweep = clearMarkMapAfterSweep; }
+
+	/**
+	 * Small regions can only be swept lazily when their mark bits survive until the next mark starts,
+	 * so deferral requires the collector to keep the mark map after sweep.
+	 */
+	bool isDeferSmallSweep() { return _deferSmallSweep; }
+	void setDeferSmallSweep(bool deferSmallSweep) { _deferSmallSweep = deferSmallSweep; }
 protected:
 	bool initialize(MM_EnvironmentBase *env);
 	void tearDown(MM_EnvironmentBase *env);
@@ -88,6 +98,8 @@ protected:
 		,_extensions(env->getExtensions())
 		,_isFixHeapForWalk(false)
 		,_clearMarkMapAfterSweep(true)
+		,_deferSmallSweep(false)
+		,_markMapWordScanner()
 	{
 		_typeId = __FUNCTION__;
 	};
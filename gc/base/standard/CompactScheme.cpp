@@ -352,11 +352,15 @@ MM_CompactScheme::postObjectMove(MM_EnvironmentBase *env, omrobjectptr_t objectP
 }
 
 void
-MM_CompactScheme::workerSetupForGC(MM_EnvironmentStandard *env, bool singleThreaded)
+MM_CompactScheme::workerSetupForGC(MM_EnvironmentStandard *env, bool singleThreaded, bool incremental)
 {
 	createSubAreaTable(env, singleThreaded);
 	setRealLimitsSubAreas(env);
 	removeNullSubAreas(env);
+	if (incremental) {
+		/* Must run before completeSubAreaTable resets the free lists it scores the sub areas by */
+		selectIncrementSubAreas(env);
+	}
 	completeSubAreaTable(env);
 }
 
@@ -513,6 +517,107 @@ MM_CompactScheme::removeNullSubAreas(MM_EnvironmentStandard *env)
 	}
 }
 
+/**
+ *  Narrow evacuation to the most fragmented window of sub areas.
+ */
+void
+MM_CompactScheme::selectIncrementSubAreas(MM_EnvironmentStandard *env)
+{
+	if (env->_currentTask->synchronizeGCThreadsAndReleaseMain(env, UNIQUE_ID)) {
+		/* Only the first subAreaCount entries are valid after removeNullSubAreas, the last of them being an end_segment */
+		uintptr_t subAreaCount = 0;
+		GC_HeapRegionIteratorStandard regionIterator(_rootManager);
+		MM_HeapRegionDescriptorStandard *region = NULL;
+		while (NULL != (region = regionIterator.nextRegion())) {
+			if (!region->isCommitted() || (0 == region->getSize())) {
+				continue;
+			}
+			while (SubAreaEntry::end_segment != _subAreaTable[subAreaCount].state) {
+				_subAreaTable[subAreaCount].freeBytes = 0;
+				subAreaCount += 1;
+			}
+			_subAreaTable[subAreaCount].freeBytes = 0;
+			subAreaCount += 1;
+		}
+
+		/* Attribute the free memory found by the sweep to the sub areas which contain it */
+		MM_MemoryPool *memoryPool = NULL;
+		MM_HeapMemoryPoolIterator poolIterator(env, _heap);
+		while (NULL != (memoryPool = poolIterator.nextPool())) {
+			void *freeEntry = memoryPool->getFirstFreeStartingAddr(env);
+			while (NULL != freeEntry) {
+				uintptr_t freeBase = (uintptr_t)freeEntry;
+				uintptr_t freeTop = freeBase + ((MM_HeapLinkedFreeHeader *)freeEntry)->getSize();
+
+				/* Find the last sub area starting at or below the free entry */
+				uintptr_t low = 0;
+				uintptr_t high = subAreaCount;
+				while ((high - low) > 1) {
+					uintptr_t middle = (low + high) / 2;
+					if ((uintptr_t)_subAreaTable[middle].firstObject <= freeBase) {
+						low = middle;
+					} else {
+						high = middle;
+					}
+				}
+
+				/* Free entries may straddle sub areas, but never regions */
+				for (uintptr_t i = low; (freeBase < freeTop) && (SubAreaEntry::end_segment != _subAreaTable[i].state); i++) {
+					uintptr_t top = OMR_MIN(freeTop, (uintptr_t)_subAreaTable[i + 1].firstObject);
+					if (top > freeBase) {
+						_subAreaTable[i].freeBytes += top - freeBase;
+						freeBase = top;
+					}
+				}
+				freeEntry = memoryPool->getNextFreeStartingAddr(env, freeEntry);
+			}
+		}
+
+		/* Slide a window of at most compactIncrementSubAreas sub areas over each segment, keeping the one holding the most free memory */
+		uintptr_t windowSize = _extensions->compactIncrementSubAreas;
+		uintptr_t windowStart = 0;
+		uintptr_t windowFreeBytes = 0;
+		uintptr_t bestStart = 0;
+		uintptr_t bestEnd = 0;
+		uintptr_t bestFreeBytes = 0;
+		for (uintptr_t i = 0; i < subAreaCount; i++) {
+			if (SubAreaEntry::end_segment == _subAreaTable[i].state) {
+				windowStart = i + 1;
+				windowFreeBytes = 0;
+				continue;
+			}
+			windowFreeBytes += _subAreaTable[i].freeBytes;
+			if ((i - windowStart) == windowSize) {
+				windowFreeBytes -= _subAreaTable[windowStart].freeBytes;
+				windowStart += 1;
+			}
+			if ((bestStart == bestEnd) || (windowFreeBytes > bestFreeBytes)) {
+				bestStart = windowStart;
+				bestEnd = i + 1;
+				bestFreeBytes = windowFreeBytes;
+			}
+		}
+
+		/* Sub areas outside the window keep their objects in place, so forwarding is only needed within it */
+		for (uintptr_t i = 0; i < subAreaCount; i++) {
+			if ((SubAreaEntry::init == _subAreaTable[i].state) && ((i < bestStart) || (i >= bestEnd))) {
+				_subAreaTable[i].state = SubAreaEntry::fixup_only;
+			}
+		}
+		_compactFrom = _subAreaTable[bestStart].firstObject;
+		_compactTo = _subAreaTable[bestEnd].firstObject;
+
+		env->_compactStats._incrementSubAreas = bestEnd - bestStart;
+		env->_compactStats._incrementFreeBytes = bestFreeBytes;
+		env->_compactStats._incrementBase = (void *)_compactFrom;
+		env->_compactStats._incrementTop = (void *)_compactTo;
+
+		Trc_MM_CompactScheme_selectIncrementSubAreas(env->getLanguageVMThread(), _compactFrom, _compactTo, bestEnd - bestStart, bestFreeBytes);
+
+		env->_currentTask->releaseSynchronizedGCThreads(env);
+	}
+}
+
 /**
  *  Complete setup for each sub area.
  */
@@ -566,6 +671,11 @@ MM_CompactScheme::compact(MM_EnvironmentBase *envBase, bool rebuildMarkBits, boo
 		env->_currentTask->releaseSynchronizedGCThreads(env);
 	}
 
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	/* The compact table overlays the raw mark bits, so none of them may still be waiting to be zeroed lazily */
+	_markMap->ensureCommittedRangesCurrent(env);
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+
 	/* We force a single sub area compaction if:
 	 *  o the compaction is aggressive. We use a single sub area per segment to avoid potentially having
 	 *    multiple holes created per segment, thereby fragmenting the space. This will result in
@@ -576,8 +686,11 @@ MM_CompactScheme::compact(MM_EnvironmentBase *envBase, bool rebuildMarkBits, boo
 		singleThreaded = true;
 	}
 
+	/* An aggressive compaction is trying to satisfy an allocation, so it always covers the whole heap */
+	bool incremental = (0 != _extensions->compactIncrementSubAreas) && !aggressive;
+
 	env->_compactStats._setupStartTime = omrtime_hires_clock();
-	workerSetupForGC(env, singleThreaded);
+	workerSetupForGC(env, singleThreaded, incremental);
 	env->_compactStats._setupEndTime = omrtime_hires_clock();
 
 	/* If a single threaded compaction force compact to run on main thread. Required
@@ -679,7 +792,11 @@ void MM_CompactScheme::rebuildFreelist(MM_EnvironmentStandard *env)
 		poolState->_memoryPool = subAreaTable[i].memoryPool;
 
 		do {
-			if (NULL != subAreaTable[i].freeChunk) {
+			if (SubAreaEntry::fixup_only == subAreaTable[i].state) {
+				/* Objects were not moved out of this sub area, so reclaim the gaps between them in place */
+				currentFreeBase = addFreeEntriesForFixupOnlySubArea(env, memorySubSpace, poolState, currentFreeBase, subAreaTable[i].firstObject, subAreaTable[i + 1].firstObject);
+				currentFreeSize = 0;
+			} else if (NULL != subAreaTable[i].freeChunk) {
 				if (subAreaTable[i].freeChunk == subAreaTable[i].firstObject) {
 					/* The entire sub area is free */
 					if (NULL == currentFreeBase) {
@@ -727,6 +844,24 @@ void MM_CompactScheme::rebuildFreelist(MM_EnvironmentStandard *env)
 	}
 }
 
+void *
+MM_CompactScheme::addFreeEntriesForFixupOnlySubArea(MM_EnvironmentStandard *env, MM_MemorySubSpace *memorySubSpace, MM_CompactMemoryPoolState *poolState, void *currentFreeBase, omrobjectptr_t firstObject, omrobjectptr_t finish)
+{
+	uintptr_t freeBase = (uintptr_t)((NULL != currentFreeBase) ? currentFreeBase : firstObject);
+
+	/* The page holding finish may already carry forwarding data of the next sub area, but no marked object of this one */
+	MM_HeapMapIterator markedObjectIterator(_extensions, _markMap, (uintptr_t *)firstObject, (uintptr_t *)pageStart(pageIndex(finish)));
+	omrobjectptr_t objectPtr = NULL;
+	while (NULL != (objectPtr = markedObjectIterator.nextObject())) {
+		if ((uintptr_t)objectPtr > freeBase) {
+			addFreeEntry(env, memorySubSpace, poolState, (void *)freeBase, (uintptr_t)objectPtr - freeBase);
+		}
+		freeBase = (uintptr_t)objectPtr + _extensions->objectModel.getConsumedSizeInBytesWithHeader(objectPtr);
+	}
+
+	return (freeBase < (uintptr_t)finish) ? (void *)freeBase : NULL;
+}
+
 /*
  * Call appropriate Memory Pool to add a new free entry to the pool. If the free entry
  * spans more than one subpool then it will be split into 2 free entries.
@@ -1417,7 +1552,7 @@ MM_CompactScheme::rebuildMarkbits(MM_EnvironmentStandard *env)
 		intptr_t i;
         for (i = 0; subAreaTable[i].state != SubAreaEntry::end_segment; i++) {
         	/* We only have to rebuild the markbits for sub areas which contain moved objects */
-        	if (subAreaTable->state != SubAreaEntry::fixup_only) {
+        	if (subAreaTable[i].state != SubAreaEntry::fixup_only) {
 	        	if (changeSubAreaAction(env, &subAreaTable[i], SubAreaEntry::rebuilding_mark_bits)) {
 	        		rebuildMarkbitsInSubArea(env, region, subAreaTable, i);
 				}
@@ -1492,7 +1627,7 @@ MM_CompactScheme::parallelFixHeapForWalk(MM_EnvironmentBase *env)
         	if (subAreaTable[i].state == SubAreaEntry::fixup_only) {
 	        	if (changeSubAreaAction(env, &subAreaTable[i], SubAreaEntry::fixing_heap_for_walk)) {
 	        		omrobjectptr_t start = subAreaTable[i].firstObject;
-					omrobjectptr_t end   = subAreaTable[i].firstObject;
+					omrobjectptr_t end   = subAreaTable[i + 1].firstObject;
 					omrobjectptr_t alignedEnd = pageStart(pageIndex(end));
 
 					GC_ObjectHeapIteratorAddressOrderedList objectIterator(_extensions, start, end, false);
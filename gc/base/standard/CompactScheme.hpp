@@ -92,6 +92,7 @@ private:
 		omrobjectptr_t freeChunk;
 		volatile uintptr_t state;
 		volatile uintptr_t currentAction; /**< record the status of the subarea for parallelization */
+		uintptr_t freeBytes; /**< free memory found in the sub area by the preceding sweep, used to score incremental compaction windows */
         
 		/* legal values for currentAction */
 		enum {
@@ -168,6 +169,27 @@ protected:
 	 */
 	void setRealLimitsSubAreas(MM_EnvironmentStandard *env);
 	void removeNullSubAreas(MM_EnvironmentStandard *env);
+	/**
+	 * Restrict evacuation to the window of compactIncrementSubAreas contiguous sub areas which
+	 * holds the most free memory according to the memory pool free lists. All other sub areas
+	 * become fixup_only, and the compact range is narrowed to the window.
+	 *
+	 * @param env[in] the current thread
+	 */
+	void selectIncrementSubAreas(MM_EnvironmentStandard *env);
+	/**
+	 * Add free entries for the gaps between the marked objects of a fixup_only sub area, which
+	 * were not reclaimed by evacuation.
+	 *
+	 * @param env[in] the current thread
+	 * @param memorySubSpace[in] the subspace which owns the sub area
+	 * @param poolState[in] the free list being rebuilt
+	 * @param currentFreeBase[in] the start of free memory preceding the sub area, or NULL
+	 * @param firstObject[in] the first object in the sub area
+	 * @param finish[in] the first object of the following sub area
+	 * @return the start of the trailing free memory in the sub area, or NULL if the sub area ends with a live object
+	 */
+	void *addFreeEntriesForFixupOnlySubArea(MM_EnvironmentStandard *env, MM_MemorySubSpace *memorySubSpace, MM_CompactMemoryPoolState *poolState, void *currentFreeBase, omrobjectptr_t firstObject, omrobjectptr_t finish);
 	void completeSubAreaTable(MM_EnvironmentStandard *env);
 
 	void saveForwardingPtr(class CompactTableEntry&,
@@ -307,7 +329,7 @@ public:
 	
 	void kill(MM_EnvironmentBase *env);
 
-	void workerSetupForGC(MM_EnvironmentStandard *env, bool singleThreaded);
+	void workerSetupForGC(MM_EnvironmentStandard *env, bool singleThreaded, bool incremental);
 	void mainSetupForGC(MM_EnvironmentStandard *env);
 	virtual void compact(MM_EnvironmentBase *env, bool rebuildMarkBits, bool aggressive);
 	omrobjectptr_t getForwardingPtr(omrobjectptr_t objectPtr) const;
@@ -45,6 +45,7 @@
 #include "WorkPacketsStandard.hpp"
 #include "MarkingScheme.hpp"
 #include "MemoryManager.hpp"
+#include "ParallelMemsetTask.hpp"
 
 #include "mmprivatehook.h"
 #include "mmprivatehook_internal.h"
@@ -144,14 +145,50 @@ MM_ConcurrentCardTable::allocateCardTableEntriesForHeapRange(MM_EnvironmentBase
 
 	if (commited) {
 		/* Clear the new cards if requested by caller */
-		if (clearNewCards) {
-			//TODO Use gc helpers to do this init
-			clearCardsInRange(env, lowAddress, highAddress);
-		}
+		clearCommittedMetadata(env, (uint8_t *)lowCard, (uint8_t *)highCard, &_lowestCommittedCard, &_highestCommittedCard, clearNewCards);
 	}
 	return commited;
 }
 
+/**
+ * Clear a newly committed range of side metadata (card table or TLH mark map) and record it as committed.
+ * Only the part of the range that has been committed before needs clearing: memory reserved in virtual
+ * memory and never committed since still reads as zero, so initial heap ranges and expansions into fresh
+ * heap are not cleared at all.  What remains is cleared on the dispatcher threads when it is large enough.
+ *
+ * @param low The first byte of the committed range
+ * @param high The end (non-inclusive) of the committed range
+ * @param lowestCommitted The lowest byte of the structure committed so far, updated to include the range
+ * @param highestCommitted The end of the highest byte of the structure committed so far, updated to include the range
+ * @param clear If false the range is only recorded as committed
+ */
+void
+MM_ConcurrentCardTable::clearCommittedMetadata(MM_EnvironmentBase *env, uint8_t *low, uint8_t *high, uint8_t **lowestCommitted, uint8_t **highestCommitted, bool clear)
+{
+	if (clear) {
+		uint8_t *clearLow = low;
+		uint8_t *clearHigh = high;
+		if (_zeroOnFirstCommit) {
+			if (NULL == *lowestCommitted) {
+				clearHigh = clearLow;
+			} else {
+				clearLow = OMR_MAX(low, *lowestCommitted);
+				clearHigh = OMR_MIN(high, *highestCommitted);
+			}
+		}
+		if (clearLow < clearHigh) {
+			MM_ParallelMemsetTask::setMemory(env, clearLow, clearHigh - clearLow, 0);
+		}
+	}
+
+	if ((NULL == *lowestCommitted) || (low < *lowestCommitted)) {
+		*lowestCommitted = low;
+	}
+	if (high > *highestCommitted) {
+		*highestCommitted = high;
+	}
+}
+
 /**
  * Decommit card table entries from memory that correspond to the removed heap range.
  *
@@ -238,13 +275,9 @@ MM_ConcurrentCardTable::allocateTLHMarkMapEntriesForHeapRange(MM_EnvironmentBase
 			commited = memoryManager->commitMemory(&_tlhMarkMapMemoryHandle, (void *) &(_tlhMarkBits[lowTLHMarkMap]), mapSize);
 
 			if (commited) {
-				/* Clear the newly allocated range
-				 *
-				 * N.B We can't use OMRZeroMemory() here as that requires the  area to
-				 * be cleared to be uintptr_t aligned
-				 *
-				 */
-				memset((void *)&(_tlhMarkBits[lowTLHMarkMap]), 0, mapSize);
+				/* Clear the newly allocated range */
+				uint8_t *lowTLHMarkBits = (uint8_t *)&(_tlhMarkBits[lowTLHMarkMap]);
+				clearCommittedMetadata(env, lowTLHMarkBits, lowTLHMarkBits + mapSize, &_lowestCommittedTLHMarkBits, &_highestCommittedTLHMarkBits, true);
 			} else {
 				/* Failed to commit memory */
 				Trc_MM_ConcurrentCardTable_activeTLHMarkMapCommitFailed(env->getLanguageVMThread(), (void *) &(_tlhMarkBits[lowTLHMarkMap]), mapSize);
@@ -457,6 +490,9 @@ MM_ConcurrentCardTable::initialize(MM_EnvironmentBase *env, MM_Heap *heap)
 		assume0(_extensions->heapAlignment % CARD_SIZE == 0);
 	
 		_lastCard = getCardTableStart();
+
+		/* Metadata backed by malloc rather than virtual memory may hold garbage before its first commit */
+		_zeroOnFirstCommit = _extensions->memoryManager->isMetadataAllocatedInVirtualMemory(env);
 	
 		/* We only allocate TLH mark bits if scavenger is NOT active.
 		 * If scavenger is active all TLH's are in NEW space and we don't trace
@@ -485,6 +521,9 @@ MM_ConcurrentCardTable::initialize(MM_EnvironmentBase *env, MM_Heap *heap)
 		/* Set default card cleaning masks used by getNextDirtycard */
 		_concurrentCardCleanMask = CONCURRENT_CARD_CLEAN_MASK;
 		_finalCardCleanMask = FINAL_CARD_CLEAN_MASK;
+
+		/* Clean card table words are all zero so they are skipped with the mark map word scanning kernels */
+		_cardWordScanner.initialize(env);
 	
 		/* How many of the card clean phases do we need to perform ?
 		 *
@@ -565,13 +604,25 @@ MM_ConcurrentCardTable::clearNonConcurrentCards(MM_EnvironmentBase *env)
 	MM_Heap *heap = _extensions->heap;
 	MM_HeapRegionManager *regionManager = heap->getHeapRegionManager();
 	GC_HeapRegionIterator regionIterator(regionManager);
+	MM_MemsetRange ranges[16];
+	uintptr_t rangeCount = 0;
 	while(NULL != (region = regionIterator.nextRegion())) {
 		MM_MemorySubSpace *subspace = region->getSubSpace();
 		if (subspace->isConcurrentCollectable() || !subspace->isActive()) {
 			continue;
 		}
-		//todo this is a single memset. We should really use helper threads to speed it up
-		clearCardsInRange(env, region->getLowAddress(), region->getHighAddress());
+		Card *lowCard = heapAddrToCardAddr(env, region->getLowAddress());
+		Card *highCard = heapAddrToCardAddr(env, region->getHighAddress());
+		ranges[rangeCount].base = (void *)lowCard;
+		ranges[rangeCount].size = (uintptr_t)highCard - (uintptr_t)lowCard;
+		rangeCount += 1;
+		if ((sizeof(ranges) / sizeof(ranges[0])) == rangeCount) {
+			MM_ParallelMemsetTask::setRanges(env, ranges, rangeCount, 0);
+			rangeCount = 0;
+		}
+	}
+	if (0 < rangeCount) {
+		MM_ParallelMemsetTask::setRanges(env, ranges, rangeCount, 0);
 	}
 
 	/* Ensure the next time we clean cards we include these cards */
@@ -1047,6 +1098,8 @@ MM_ConcurrentCardTable::finalCleanCards(MM_EnvironmentBase *env, uintptr_t *byte
 	omrobjectptr_t objectPtr;
 	uintptr_t cards = 0;
 	bool phase2 = false;
+	uintptr_t batchSize = OMR_MAX(_extensions->cardCleaningBatchSize, 1);
+	uintptr_t cardsInBatch = 0;
 
 	/* Set upper limit of refs we push before returning to one packets worth */
 	uintptr_t maxPushes = _markingScheme->getWorkPackets()->getSlotsInPacket();
@@ -1056,28 +1109,39 @@ MM_ConcurrentCardTable::finalCleanCards(MM_EnvironmentBase *env, uintptr_t *byte
 
 	MM_MarkMap *markMap = _markingScheme->getMarkMap();
 	
+	/* The world is stopped so no card can be dirtied behind us; claim whole runs of contiguous dirty
+	 * cards at once to cut down on contention for the next card of the cleaning range.
+	 */
 	for ( ;
-		(nextDirtyCard= getNextDirtyCard(env, _finalCardCleanMask, false)) != NULL;
+		(nextDirtyCard= getNextDirtyCard(env, _finalCardCleanMask, false, batchSize, &cardsInBatch)) != NULL;
 		) {
 
 		/* Should never get EXCLUSIVE_VMACCESS_REQUESTED in final clean cards phase */
 		assume0(nextDirtyCard != (Card *)EXCLUSIVE_VMACCESS_REQUESTED);
 
-		/* Reset counters if we are now cleaning phase 2 cards */
-		if(!phase2 && nextDirtyCard >= _firstCardInPhase2) {
-			incFinalCleanedCards(cards, phase2);
-			cards = 0;
+		Card *batchTop = nextDirtyCard + cardsInBatch;
+
+		/* Reset counters if we are now cleaning phase 2 cards. A batch may straddle the
+		 * first phase 2 card so only the cards ahead of it are counted as phase 1 cards.
+		 */
+		if(!phase2 && batchTop > _firstCardInPhase2) {
+			uintptr_t phase1Cards = (nextDirtyCard < _firstCardInPhase2) ? (uintptr_t)(_firstCardInPhase2 - nextDirtyCard) : 0;
+			incFinalCleanedCards(cards + phase1Cards, phase2);
+			cards = cardsInBatch - phase1Cards;
 			phase2 = true;
+		} else {
+			cards += cardsInBatch;
 		}
 
-		/* Clean the card before we trace into it */
-		finalCleanCard(nextDirtyCard);
-		cards += 1;
+		/* Clean the cards before we trace into them */
+		for (Card *card = nextDirtyCard; card < batchTop; card++) {
+			finalCleanCard(card);
+		}
 
-		/* Calculate address of first slot heap for the card to be cleaned... */
+		/* Calculate address of first slot heap for the cards to be cleaned... */
 		uintptr_t *heapBase = (uintptr_t *)cardAddrToHeapAddr(env,nextDirtyCard);
 		/* ..and address of last slot N.B Range is EXCLUSIVE */
-		uintptr_t *heapTop = (uintptr_t *)((uint8_t *)heapBase + CARD_SIZE);
+		uintptr_t *heapTop = (uintptr_t *)((uint8_t *)heapBase + (CARD_SIZE * cardsInBatch));
 
 		/* prevent loading mark bits prematurely */
 		MM_AtomicOperations::readBarrier();
@@ -1526,16 +1590,29 @@ MM_ConcurrentCardTable::determineCleaningRanges(MM_EnvironmentBase *env)
 
 			/* Do we need to include this segments cards  */
 			if (subspace->isActive() && (_cleanAllCards || subspace->isConcurrentCollectable())) {
-				numRanges += 1;
-
-				/* If there is space in cleaningRanges array so add it... */
-				if (numRanges <= _maxCleaningRanges) {
-					nextRange->baseCard = heapAddrToCardAddr(env, region->getLowAddress());
-					nextRange->topCard = heapAddrToCardAddr(env, region->getHighAddress());
-					nextRange->nextCard = nextRange->baseCard;
-					nextRange->numCards = (uintptr_t)(nextRange->topCard - nextRange->baseCard);
-					_cardTableStats.totalCards += nextRange->numCards;
-					nextRange += 1;
+				Card *baseCard = heapAddrToCardAddr(env, region->getLowAddress());
+				Card *topCard = heapAddrToCardAddr(env, region->getHighAddress());
+				CleaningRange *previousRange = nextRange - 1;
+
+				/* Regions which abut the previous range extend it rather than start a new one, so
+				 * word scans and batches of dirty cards are not cut short at region boundaries
+				 */
+				if ((0 < numRanges) && (numRanges <= _maxCleaningRanges) && (previousRange->topCard == baseCard)) {
+					previousRange->topCard = topCard;
+					previousRange->numCards += (uintptr_t)(topCard - baseCard);
+					_cardTableStats.totalCards += (uintptr_t)(topCard - baseCard);
+				} else {
+					numRanges += 1;
+
+					/* If there is space in cleaningRanges array so add it... */
+					if (numRanges <= _maxCleaningRanges) {
+						nextRange->baseCard = baseCard;
+						nextRange->topCard = topCard;
+						nextRange->nextCard = nextRange->baseCard;
+						nextRange->numCards = (uintptr_t)(nextRange->topCard - nextRange->baseCard);
+						_cardTableStats.totalCards += nextRange->numCards;
+						nextRange += 1;
+					}
 				}
 			}
 		}
@@ -1595,13 +1672,16 @@ MM_ConcurrentCardTable::resetCleaningRanges(MM_EnvironmentBase *env)
  *
  * @param cardMask - mask to apply to cards to identify those cards the caller
  * 					 is interested in
+ * @param maxCards - maximum number of contiguous dirty cards to claim
+ * @param cardsClaimed - if not NULL, returns the number of contiguous dirty cards
+ * 					 claimed starting at the returned card
  *
  * @return Routine either returns address of next dirty card, NULL if no
  * more dirty cards, EXCLUSIVE_VMACCESS_REQUESTED if another thread waiting
  * for exclusive VM access.
  */
 Card*
-MM_ConcurrentCardTable::getNextDirtyCard(MM_EnvironmentBase *env, Card cardMask, bool concurrentCardClean)
+MM_ConcurrentCardTable::getNextDirtyCard(MM_EnvironmentBase *env, Card cardMask, bool concurrentCardClean, uintptr_t maxCards, uintptr_t *cardsClaimed)
 {
 	/* Get a local copy of next current range being cleaned */
 	CleaningRange *currentRange = (CleaningRange *)_currentCleaningRange;
@@ -1627,11 +1707,10 @@ MM_ConcurrentCardTable::getNextDirtyCard(MM_EnvironmentBase *env, Card cardMask,
 
 		for (currentCard = firstCard; currentCard < lastCardToClean; currentCard++) {
 
-			/* Are we are on an uintptr_t boundary? If so scan the card table a uintptr_t
-	 		 * at a time until we find a slot which is non-zero or the end of card table
-	 		 * found. This is based on the premise that the card table will be mostly
-	 		 * empty and scanning an uintptr_t at a time will reduce the time taken to
-	 		 * scan the card table.
+			/* Are we are on an uintptr_t boundary? If so scan the card table as many uintptr_t
+	 		 * at a time as the processor allows until we find a slot which is non-zero or the
+	 		 * end of card table found. This is based on the premise that the card table will be
+	 		 * mostly empty and scanning whole slots will reduce the time taken to scan the card table.
 	 		 */
 			if (((Card)CARD_CLEAN == *currentCard) && (0 == (uintptr_t)currentCard % sizeof(uintptr_t))) {
 				uintptr_t *nextSlot = (uintptr_t *)currentCard;
@@ -1639,9 +1718,7 @@ MM_ConcurrentCardTable::getNextDirtyCard(MM_EnvironmentBase *env, Card cardMask,
 				 * complete slots worth of cards; then go card at a time
 				 **/
 				uintptr_t *lastSlot = (uintptr_t *)MM_Math::roundToFloor(sizeof(uintptr_t), (uintptr_t)lastCardToClean);
-				while ((nextSlot < lastSlot) && (SLOT_ALL_CLEAN == *nextSlot)) {
-					nextSlot += 1;
-				}
+				nextSlot = _cardWordScanner.findNonEmptyWord(nextSlot, lastSlot);
 				/*
 			     * Either end of scan or a slot which contains a dirty card found. Reset scan ptr
 				 */
@@ -1663,9 +1740,13 @@ MM_ConcurrentCardTable::getNextDirtyCard(MM_EnvironmentBase *env, Card cardMask,
 				/* Yes..so re-sync with race winner and start scan again */
 				break;
 			} else {
-				/* No .. so attempt to grab this card*/
+				/* No .. so attempt to grab this card and any dirty cards immediately following it */
 				nextDirtyCard = currentCard;
 				currentCard += 1;
+				Card *lastCardInRun = nextDirtyCard + OMR_MIN(maxCards, (uintptr_t)(lastCardToClean - nextDirtyCard));
+				while ((currentCard < lastCardInRun) && (0 != (*currentCard & cardMask))) {
+					currentCard += 1;
+				}
 				if (concurrentCardClean && env->isExclusiveAccessRequestWaiting()) {
 					return (Card *)EXCLUSIVE_VMACCESS_REQUESTED;
 				}
@@ -1678,7 +1759,10 @@ MM_ConcurrentCardTable::getNextDirtyCard(MM_EnvironmentBase *env, Card cardMask,
 											  							  (uintptr_t)currentCard)) {
 					break;
 				}
-				
+
+				if (NULL != cardsClaimed) {
+					*cardsClaimed = (uintptr_t)(currentCard - nextDirtyCard);
+				}
 				return nextDirtyCard;
 			}
 		} /* of currentCard < lastCardToClean */
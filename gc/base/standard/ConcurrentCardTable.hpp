@@ -31,6 +31,7 @@
 #include "Debug.hpp"
 #include "EnvironmentStandard.hpp"
 #include "GCExtensionsBase.hpp"
+#include "MarkMapWordScanner.hpp"
 #include "MemoryManager.hpp"
 
 /**
@@ -151,6 +152,11 @@ private:
 	MM_MemoryHandle _tlhMarkMapMemoryHandle;
 	
 	uintptr_t *_tlhMarkBits;
+	uint8_t *_lowestCommittedCard; /**< lowest card table byte committed since the table was reserved */
+	uint8_t *_highestCommittedCard; /**< end of the highest card table byte committed since the table was reserved */
+	uint8_t *_lowestCommittedTLHMarkBits; /**< lowest TLH mark map byte committed since the map was reserved */
+	uint8_t *_highestCommittedTLHMarkBits; /**< end of the highest TLH mark map byte committed since the map was reserved */
+	bool _zeroOnFirstCommit; /**< true if side metadata is reserved in virtual memory, so memory never committed before reads as zero */
 	bool _cardTableReconfigured;
 	bool _cleanAllCards;
 protected:
@@ -174,6 +180,8 @@ protected:
 	Card *_firstCardInPhase;
 	Card * volatile _lastCardInPhase;
 	Card *_firstCardInPhase2;
+
+	MM_MarkMapWordScanner _cardWordScanner; /**< Skips runs of clean card table words using the widest kernel the processor supports */
 public:
 	
 	/*
@@ -186,6 +194,7 @@ private:
 	bool freeCardTableEntriesForHeapRange(MM_EnvironmentBase *env, uintptr_t size, void *lowAddress, void *highAddress, void *lowValidAddress, void *highValidAddress);
 	bool allocateTLHMarkMapEntriesForHeapRange(MM_EnvironmentBase *env, MM_MemorySubSpace *subspace, uintptr_t size, void *lowAddress, void *highAddress);
 	bool freeTLHMarkMapEntriesForHeapRange(MM_EnvironmentBase *env, uintptr_t size, void *lowAddress, void *highAddress, void *lowValidAddress, void *highValidAddress);
+	void clearCommittedMetadata(MM_EnvironmentBase *env, uint8_t *low, uint8_t *high, uint8_t **lowestCommitted, uint8_t **highestCommitted, bool clear);
 	
 	void setTLHMarkBits(MM_EnvironmentBase *env, uintptr_t slotIndex, uintptr_t slotBits);
 	void clearTLHMarkBits(MM_EnvironmentBase *env, uintptr_t slotIndex, uintptr_t slotBits);
@@ -230,7 +239,7 @@ protected:
 	bool initialize(MM_EnvironmentBase *env, MM_Heap *heap);
 	
 	bool cleanSingleCard(MM_EnvironmentBase *env, Card *card, uintptr_t bytesToClean, uintptr_t *totalBytesCleaned);
-	Card* getNextDirtyCard(MM_EnvironmentBase *env, Card cardMask, bool concurrentCardClean);
+	Card* getNextDirtyCard(MM_EnvironmentBase *env, Card cardMask, bool concurrentCardClean, uintptr_t maxCards = 1, uintptr_t *cardsClaimed = NULL);
 	
 	bool cardHasMarkedObjects(MM_EnvironmentBase *env, Card *card);
 	
@@ -474,6 +483,11 @@ public:
 		MM_CardTable(),
 		_tlhMarkMapMemoryHandle(),
 		_tlhMarkBits(NULL),
+		_lowestCommittedCard(NULL),
+		_highestCommittedCard(NULL),
+		_lowestCommittedTLHMarkBits(NULL),
+		_highestCommittedTLHMarkBits(NULL),
+		_zeroOnFirstCommit(false),
 		_cardTableReconfigured(false),
 		_cleanAllCards(false),
 		_omrVM(env->getOmrVM()),
@@ -490,7 +504,8 @@ public:
 		_lastCard(NULL),
 		_firstCardInPhase(NULL),
 		_lastCardInPhase(NULL),
-		_firstCardInPhase2(NULL)
+		_firstCardInPhase2(NULL),
+		_cardWordScanner()
 	{
 		_typeId = __FUNCTION__;
 	}
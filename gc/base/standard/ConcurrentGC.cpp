@@ -177,7 +177,7 @@ MM_ConcurrentGC::reportConcurrentKickoff(MM_EnvironmentBase *env)
 
 	Trc_MM_ConcurrentKickoff(env->getLanguageVMThread(),
 		_stats.getTraceSizeTarget(),
-		_stats.getKickoffThreshold(),
+		getKickoffThreshold(),
 		_stats.getRemainingFree()
 	);
 
@@ -190,7 +190,7 @@ MM_ConcurrentGC::reportConcurrentKickoff(MM_EnvironmentBase *env)
 		J9HOOK_MM_PRIVATE_CONCURRENT_KICKOFF,
 		_extensions->getHeap()->initializeCommonGCData(env, &commonData),
 		_stats.getTraceSizeTarget(),
-		_stats.getKickoffThreshold(),
+		getKickoffThreshold(),
 		_stats.getRemainingFree(),
 		_stats.getKickoffReason(),
 		_languageKickoffReason
@@ -1125,7 +1125,7 @@ MM_ConcurrentGC::calculateTraceSize(MM_EnvironmentBase *env, MM_AllocateDescript
 	 */
 	if ((remainingFree > 0) && (workCompleteSoFar < traceTarget)) {
 
-		thisTraceRate = (float)((traceTarget - workCompleteSoFar) / (float)(remainingFree));
+		thisTraceRate = _kickoffController.scaleTraceRate((float)((traceTarget - workCompleteSoFar) / (float)(remainingFree)));
 
 		if (thisTraceRate > _allocToTraceRate) {
 	    /* The "over tracing" should not only adjust to the current ratio between
@@ -1664,7 +1664,8 @@ MM_ConcurrentGC::timeToKickoffConcurrent(MM_EnvironmentBase *env, MM_AllocateDes
 		return false;
 	}
 
-	if ((remainingFree < _stats.getKickoffThreshold()) || _forcedKickoff) {
+	/* Bring the KO point forward if recent final collections have exceeded the pause target */
+	if ((remainingFree < getKickoffThreshold()) || _forcedKickoff) {
 #if defined(OMR_GC_CONCURRENT_SWEEP)
 		/* Finish off any sweep work that was still in progress */
 		completeConcurrentSweepForKickoff(env);
@@ -1940,6 +1941,8 @@ MM_ConcurrentGC::internalPreCollect(MM_EnvironmentBase *env, MM_MemorySubSpace *
 	Assert_MM_mustHaveExclusiveVMAccess(env->getOmrVMThread());
 	Assert_MM_true(_stwCollectionInProgress);
 
+	_kickoffController.finalCollectionStarted(env);
+
 	/* Assume for now we will need to initialize the mark map. If we subsequently find
 	 * we got far enough through the concurrent mark cycle then we will reset this flag
 	 */
@@ -2114,6 +2117,11 @@ MM_ConcurrentGC::internalPostCollect(MM_EnvironmentBase *env, MM_MemorySubSpace
 	 /* Reset concurrent work stack overflow flags for next cycle */
 	clearWorkStackOverflow();
 
+	/* Feed the pause of the collection ending this concurrent cycle back before re-tuning, so the new kickoff threshold reflects it */
+	if ((CONCURRENT_OFF < _stats.getExecutionModeAtGC()) && (NULL != env->_cycleState) && !env->_cycleState->_gcCode.isExplicitGC()) {
+		_kickoffController.finalCollectionCompleted(env, &_stats);
+	}
+
 	/* Re tune for next concurrent cycle if we have had a heap resize or we got far enough
 	 * last time. We only re-tune on a system GC in the event of a heap resize.
 	 */
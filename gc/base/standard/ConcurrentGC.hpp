@@ -35,6 +35,7 @@
 #include "Collector.hpp"
 #include "CollectorLanguageInterface.hpp"
 #include "ConcurrentGCStats.hpp"
+#include "ConcurrentKickoffController.hpp"
 #include "CycleState.hpp"
 #include "EnvironmentStandard.hpp"
 #include "ParallelGlobalGC.hpp"
@@ -224,6 +225,7 @@ protected:
 	MM_ConcurrentSafepointCallback *_callback;
 	MM_ConcurrentGCStats _stats;
 	MM_ConcurrentMarkPhaseStats _concurrentPhaseStats;
+	MM_ConcurrentKickoffController _kickoffController; /**< adjusts kickoff and allocation tax towards the final pause target */
 
 	/*
 	 * Function members
@@ -458,6 +460,11 @@ public:
 
 	MMINLINE MM_ConcurrentGCStats *getConcurrentGCStats() { return &_stats; };
 
+	/**
+	 * @return the kickoff threshold derived by tuneToHeap, brought forward by the pause target controller
+	 */
+	MMINLINE uintptr_t getKickoffThreshold() { return _kickoffController.scaleKickoffThreshold(_stats.getKickoffThreshold()); }
+
 	virtual void workStackOverflow();
 	virtual void notifyAcquireExclusiveVMAccess(MM_EnvironmentBase *env);
 	
@@ -510,6 +517,7 @@ public:
 		,_callback(NULL)
 		,_stats()
 		,_concurrentPhaseStats()
+		,_kickoffController()
 		{
 			_typeId = __FUNCTION__;
 		}
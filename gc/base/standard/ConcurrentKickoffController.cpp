@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#include "omrcfg.h"
+#include "omrport.h"
+#include "ModronAssertions.h"
+
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+
+#include "ConcurrentKickoffController.hpp"
+
+#include "ConcurrentGCStats.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+
+#define KICKOFF_CONTROLLER_PROPORTIONAL_GAIN ((float)0.5)
+#define KICKOFF_CONTROLLER_INTEGRAL_GAIN ((float)0.25)
+#define KICKOFF_CONTROLLER_DERIVATIVE_GAIN ((float)0.1)
+#define KICKOFF_CONTROLLER_INTEGRAL_LIMIT ((float)12.0)
+#define KICKOFF_CONTROLLER_HALTED_ERROR ((float)1.0) /* a halted cycle is treated as a pause of at least twice the target */
+#define KICKOFF_CONTROLLER_MAX_KICKOFF_SCALE ((float)4.0)
+#define KICKOFF_CONTROLLER_TRACE_RATE_SHARE ((float)0.5) /* share of the controller output applied to the trace rate */
+
+void
+MM_ConcurrentKickoffController::finalCollectionStarted(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+	_finalCollectionStartTime = omrtime_hires_clock();
+}
+
+void
+MM_ConcurrentKickoffController::finalCollectionCompleted(MM_EnvironmentBase *env, MM_ConcurrentGCStats *stats)
+{
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+
+	_lastFinalPauseMillis = omrtime_hires_delta(_finalCollectionStartTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MILLISECONDS);
+
+	if (0 == extensions->concurrentFinalPauseTarget) {
+		return;
+	}
+
+	/* Concurrent mark is halted when the heap is exhausted before tracing and card cleaning were complete */
+	uintptr_t executionModeAtGC = stats->getExecutionModeAtGC();
+	bool halted = (CONCURRENT_OFF < executionModeAtGC) && (CONCURRENT_EXHAUSTED > executionModeAtGC);
+
+	float target = (float)extensions->concurrentFinalPauseTarget;
+	float error = ((float)_lastFinalPauseMillis - target) / target;
+	if (halted) {
+		error = OMR_MAX(error, KICKOFF_CONTROLLER_HALTED_ERROR);
+	}
+
+	/* The controller output can not reduce the scales below 1, so the integral is kept non-negative to avoid wind up */
+	_integralError = OMR_MIN(OMR_MAX(_integralError + error, 0.0f), KICKOFF_CONTROLLER_INTEGRAL_LIMIT);
+	float derivative = error - _lastError;
+	_lastError = error;
+
+	float output = (KICKOFF_CONTROLLER_PROPORTIONAL_GAIN * error) + (KICKOFF_CONTROLLER_INTEGRAL_GAIN * _integralError) + (KICKOFF_CONTROLLER_DERIVATIVE_GAIN * derivative);
+
+	/* Kicking off earlier costs only more frequent cycles so it takes the whole output; the trace
+	 * rate, which slows the mutators down, takes a share of it up to the allocation tax limit.
+	 */
+	_kickoffScale = OMR_MIN(OMR_MAX(1.0f + output, 1.0f), KICKOFF_CONTROLLER_MAX_KICKOFF_SCALE);
+	_traceRateScale = OMR_MIN(OMR_MAX(1.0f + (KICKOFF_CONTROLLER_TRACE_RATE_SHARE * output), 1.0f), OMR_MAX(extensions->concurrentAllocationTaxLimit, 1.0f));
+
+	Trc_MM_ConcurrentKickoffController_finalCollectionCompleted(env->getLanguageVMThread(), _lastFinalPauseMillis, extensions->concurrentFinalPauseTarget, halted ? "true" : "false", (double)_kickoffScale, (double)_traceRateScale);
+}
+
+#endif /* OMR_GC_MODRON_CONCURRENT_MARK */
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#if !defined(CONCURRENTKICKOFFCONTROLLER_HPP_)
+#define CONCURRENTKICKOFFCONTROLLER_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "modronbase.h"
+
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+
+class MM_ConcurrentGCStats;
+class MM_EnvironmentBase;
+
+/**
+ * Feedback controller which steers concurrent mark towards a target duration for the stop-the-world
+ * collection ending each concurrent cycle.
+ *
+ * The kickoff threshold and allocation to trace rate derived from the trace target assume a steady
+ * allocation rate; an allocation burst exhausts the heap before tracing completes, halting concurrent
+ * mark and leaving the remaining work to a long final collection. At the end of each cycle the final
+ * collection pause is compared with the target (a halted cycle counts as at least one target over)
+ * and a PID controller brings the next kickoff forward, then raises the allocation tax up to the limit
+ * allowed by concurrentAllocationTaxLimit. The controller relaxes back to the fixed tuning as pauses
+ * fall below the target.
+ * @ingroup GC_Modron_Standard
+ */
+class MM_ConcurrentKickoffController
+{
+	/*
+	 * Data members
+	 */
+private:
+	float _kickoffScale; /**< factor applied to the kickoff threshold derived from the trace target */
+	float _traceRateScale; /**< factor applied to the allocation to trace rate required to meet the trace target */
+	float _integralError; /**< accumulated pause error, bounded to prevent wind up */
+	float _lastError; /**< pause error of the previous cycle */
+	uint64_t _finalCollectionStartTime; /**< hires clock at the start of the current stop-the-world collection */
+	uint64_t _lastFinalPauseMillis; /**< duration of the last final collection of a concurrent cycle */
+
+	/*
+	 * Function members
+	 */
+public:
+	/**
+	 * Record the start of a stop-the-world collection.
+	 */
+	void finalCollectionStarted(MM_EnvironmentBase *env);
+
+	/**
+	 * Update the controller once the collection ending a concurrent cycle has completed.
+	 * @param stats statistics of the concurrent cycle which has just completed
+	 */
+	void finalCollectionCompleted(MM_EnvironmentBase *env, MM_ConcurrentGCStats *stats);
+
+	/**
+	 * @param kickoffThreshold kickoff threshold derived from the trace target
+	 * @return the kickoff threshold to use
+	 */
+	MMINLINE uintptr_t
+	scaleKickoffThreshold(uintptr_t kickoffThreshold)
+	{
+		return (1.0f == _kickoffScale) ? kickoffThreshold : (uintptr_t)((float)kickoffThreshold * _kickoffScale);
+	}
+
+	/**
+	 * @param traceRate allocation to trace rate required to meet the trace target
+	 * @return the allocation to trace rate to tax the allocation at
+	 */
+	MMINLINE float scaleTraceRate(float traceRate) { return traceRate * _traceRateScale; }
+
+	MMINLINE float getKickoffScale() { return _kickoffScale; }
+	MMINLINE float getTraceRateScale() { return _traceRateScale; }
+	MMINLINE uint64_t getLastFinalPauseMillis() { return _lastFinalPauseMillis; }
+
+	MM_ConcurrentKickoffController()
+		: _kickoffScale(1.0f)
+		, _traceRateScale(1.0f)
+		, _integralError(0.0f)
+		, _lastError(0.0f)
+		, _finalCollectionStartTime(0)
+		, _lastFinalPauseMillis(0)
+	{
+	}
+};
+
+#endif /* OMR_GC_MODRON_CONCURRENT_MARK */
+
+#endif /* CONCURRENTKICKOFFCONTROLLER_HPP_ */
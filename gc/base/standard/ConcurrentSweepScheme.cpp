@@ -1081,7 +1081,7 @@ MM_ConcurrentSweepScheme::calculateTax(MM_EnvironmentBase *envModron, UDATA allo
 
 #if defined(OMR_GC_MODRON_CONCURRENT_MARK)
 	if(_extensions->concurrentMark) {
-		UDATA kickoffThreshold = ((MM_ConcurrentGC *)_collector)->getConcurrentGCStats()->getKickoffThreshold();
+		UDATA kickoffThreshold = ((MM_ConcurrentGC *)_collector)->getKickoffThreshold();
 		
 		/* Another thread may have pushed us over the kickoffThreshold leaving us with a 
 		 * negative difference between remainingFree and kickoffThreshold 
@@ -207,7 +207,7 @@ MM_ConfigurationStandard::createMemoryPool(MM_EnvironmentBase* env, bool appendC
 			return NULL;
 		}
 
-		memoryPoolLargeObjects = MM_MemoryPoolAddressOrderedList::newInstance(env, extensions->largeObjectMinimumSize, "LOA");
+		memoryPoolLargeObjects = MM_MemoryPoolAddressOrderedList::newInstance(env, extensions->largeObjectMinimumSize, "LOA", extensions->largeObjectAreaBestFit);
 		if (NULL == memoryPoolLargeObjects) {
 			memoryPoolSmallObjects->kill(env);
 			return NULL;
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#include "CopyScanCacheDeque.hpp"
+#include "EnvironmentBase.hpp"
+#include "Forge.hpp"
+#include "GCExtensionsBase.hpp"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+bool
+MM_CopyScanCacheDeque::initialize(MM_EnvironmentBase *env, uintptr_t capacity, uintptr_t seed)
+{
+	uintptr_t roundedCapacity = 1;
+	while (roundedCapacity < capacity) {
+		roundedCapacity <<= 1;
+	}
+
+	_buffer = (MM_CopyScanCacheStandard **)env->getForge()->allocate(sizeof(MM_CopyScanCacheStandard *) * roundedCapacity, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL == _buffer) {
+		return false;
+	}
+
+	_mask = roundedCapacity - 1;
+	_top = 0;
+	_bottom = 0;
+	_victimSeed = (0 == seed) ? 1 : seed;
+	return true;
+}
+
+void
+MM_CopyScanCacheDeque::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _buffer) {
+		env->getForge()->free(_buffer);
+		_buffer = NULL;
+	}
+}
+
+#endif /* OMR_GC_MODRON_SCAVENGER */
@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#if !defined(COPYSCANCACHEDEQUE_HPP_)
+#define COPYSCANCACHEDEQUE_HPP_
+
+#include "omrcfg.h"
+#include "modronopt.h"
+
+#include "AtomicOperations.hpp"
+#include "BaseNonVirtual.hpp"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+class MM_CopyScanCacheStandard;
+class MM_EnvironmentBase;
+
+/**
+ * Bounded work-stealing deque (Chase-Lev) of scan caches owned by a single GC thread.
+ * The owning thread pushes and pops at the bottom (LIFO, for locality) without any locking,
+ * while other GC threads steal from the top (FIFO) with a single compare-and-swap.
+ * The backing buffer never grows: a push onto a full deque fails and the caller is expected
+ * to fall back to the shared scan list.
+ * @ingroup GC_Modron_Standard
+ */
+class MM_CopyScanCacheDeque : public MM_BaseNonVirtual
+{
+	/*
+	 * Data members
+	 */
+private:
+	MM_CopyScanCacheStandard **_buffer; /**< circular buffer of caches, (_mask + 1) entries long */
+	uintptr_t _mask; /**< capacity of _buffer minus one (capacity is a power of 2) */
+	volatile uintptr_t _top; /**< index of the oldest entry, advanced by thieves (or by the owner taking the last entry) through compare-and-swap */
+	volatile uintptr_t _bottom; /**< index one past the newest entry, only ever written by the owning thread */
+	uintptr_t _victimSeed; /**< state of the owning thread's pseudo-random victim selection */
+
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+private:
+protected:
+public:
+	/**
+	 * Allocate the backing buffer.
+	 * @param env[in] the current thread
+	 * @param capacity[in] requested capacity, rounded up to a power of 2
+	 * @param seed[in] initial (non-zero) seed for victim selection
+	 * @return true on success
+	 */
+	bool initialize(MM_EnvironmentBase *env, uintptr_t capacity, uintptr_t seed);
+	void tearDown(MM_EnvironmentBase *env);
+
+	/**
+	 * Push a cache to the bottom of the deque. Must only be called by the owning thread.
+	 * @param cache[in] the cache to push
+	 * @return true if pushed, false if the deque is full
+	 */
+	MMINLINE bool
+	push(MM_CopyScanCacheStandard *cache)
+	{
+		uintptr_t bottom = _bottom;
+		if ((bottom - _top) > _mask) {
+			return false;
+		}
+		_buffer[bottom & _mask] = cache;
+		/* the entry must be visible before thieves can observe the new bottom */
+		MM_AtomicOperations::storeSync();
+		_bottom = bottom + 1;
+		return true;
+	}
+
+	/**
+	 * Pop the most recently pushed cache. Must only be called by the owning thread.
+	 * @return the cache, or NULL if the deque is empty (or the last entry was lost to a thief)
+	 */
+	MMINLINE MM_CopyScanCacheStandard *
+	pop()
+	{
+		uintptr_t bottom = _bottom;
+		if (bottom == _top) {
+			return NULL;
+		}
+
+		bottom -= 1;
+		_bottom = bottom;
+		/* publish the reservation before reading top, so a racing thief either sees it or loses the CAS below */
+		MM_AtomicOperations::sync();
+		uintptr_t top = _top;
+
+		MM_CopyScanCacheStandard *cache = NULL;
+		if (top < bottom) {
+			/* more than one entry left - no thief can reach this slot */
+			cache = _buffer[bottom & _mask];
+		} else {
+			if (top == bottom) {
+				/* last entry - race with thieves for it */
+				cache = _buffer[bottom & _mask];
+				if (top != MM_AtomicOperations::lockCompareExchange(&_top, top, top + 1)) {
+					cache = NULL;
+				}
+			}
+			/* deque is now empty, leave it in canonical form (bottom == top) */
+			_bottom = bottom + 1;
+		}
+		return cache;
+	}
+
+	/**
+	 * Steal the oldest cache. May be called by any thread.
+	 * @return the cache, or NULL if the deque is empty or another thread won the race for the entry
+	 */
+	MMINLINE MM_CopyScanCacheStandard *
+	steal()
+	{
+		uintptr_t top = _top;
+		MM_AtomicOperations::sync();
+		uintptr_t bottom = _bottom;
+
+		MM_CopyScanCacheStandard *cache = NULL;
+		if (top < bottom) {
+			cache = _buffer[top & _mask];
+			if (top != MM_AtomicOperations::lockCompareExchange(&_top, top, top + 1)) {
+				cache = NULL;
+			}
+		}
+		return cache;
+	}
+
+	/**
+	 * @return true if the deque appeared to be empty at the time of the call
+	 */
+	MMINLINE bool
+	isEmpty()
+	{
+		return _bottom <= _top;
+	}
+
+	/**
+	 * Pick the index of the first deque to steal from. Must only be called by the owning thread.
+	 * @param dequeCount[in] number of deques to pick from
+	 * @return an index in [0, dequeCount)
+	 */
+	MMINLINE uintptr_t
+	nextVictim(uintptr_t dequeCount)
+	{
+		/* xorshift - cheap, and good enough to spread thieves over victims */
+		uintptr_t seed = _victimSeed;
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		_victimSeed = seed;
+		return seed % dequeCount;
+	}
+
+	MM_CopyScanCacheDeque()
+		: MM_BaseNonVirtual()
+		, _buffer(NULL)
+		, _mask(0)
+		, _top(0)
+		, _bottom(0)
+		, _victimSeed(1)
+	{
+		_typeId = __FUNCTION__;
+	}
+};
+
+#endif /* OMR_GC_MODRON_SCAVENGER */
+#endif /* COPYSCANCACHEDEQUE_HPP_ */
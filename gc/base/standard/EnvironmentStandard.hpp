@@ -60,6 +60,7 @@ public:
 	
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	J9VMGC_SublistFragment _scavengerRememberedSet;
+	uintptr_t _hotFieldSampleCountdown; /**< hot field dereferences this thread will report before the next one is sampled */
 #endif
 	void *_tenureTLHRemainderBase;  /**< base and top pointers of the last unused tenure TLH copy cache, that might be reused  on next copy refresh */
 	void *_tenureTLHRemainderTop;
@@ -93,6 +94,9 @@ public:
 		,_inactiveDeferredCopyCache(NULL)
 		,_inactiveTenureCopyScanCache(NULL)
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		,_hotFieldSampleCountdown(0)
+#endif /* OMR_GC_MODRON_SCAVENGER */
 		,_tenureTLHRemainderBase(NULL)
 		,_tenureTLHRemainderTop(NULL)
 		,_loaAllocation(false)
@@ -0,0 +1,546 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#include "omrcfg.h"
+#include "omr.h"
+#include "omrport.h"
+#include "mmprivatehook.h"
+#include "ut_j9mm.h"
+
+#include "HeapUncommitService.hpp"
+
+#include "EnvironmentBase.hpp"
+#include "Forge.hpp"
+#include "GCExtensionsBase.hpp"
+#include "Heap.hpp"
+#include "HeapLinkedFreeHeader.hpp"
+#include "HeapMemoryPoolIterator.hpp"
+#include "Math.hpp"
+#include "MemoryPool.hpp"
+#include "MemorySubSpace.hpp"
+#include "ModronAssertions.h"
+
+typedef struct HeapUncommitServiceThreadInfo {
+	OMR_VM *omrVM;
+	MM_HeapUncommitService *service;
+	volatile uintptr_t threadFlags;
+} HeapUncommitServiceThreadInfo;
+
+#define UNCOMMIT_THREAD_INFO_FLAG_OK 1
+#define UNCOMMIT_THREAD_INFO_FLAG_FAIL 2
+
+/**
+ * Heap uncommit service thread procedure
+ *
+ * @parm info Address of HeapUncommitServiceThreadInfo structure
+ */
+static int J9THREAD_PROC
+heap_uncommit_thread_proc(void *info)
+{
+	HeapUncommitServiceThreadInfo *threadInfo = (HeapUncommitServiceThreadInfo *)info;
+	MM_HeapUncommitService *service = threadInfo->service;
+
+	/* Attach the thread as a system daemon thread */
+	OMR_VMThread *omrThread = MM_EnvironmentBase::attachVMThread(threadInfo->omrVM, "Heap Uncommit", MM_EnvironmentBase::ATTACH_GC_HELPER_THREAD);
+
+	/* Signal that the service thread has started (or not); threadInfo must not be touched after this point */
+	service->signalStarted(threadInfo, NULL != omrThread);
+
+	if (NULL != omrThread) {
+		service->serviceEntryPoint(omrThread);
+	}
+
+	return 0;
+}
+
+MM_HeapUncommitService *
+MM_HeapUncommitService::newInstance(MM_EnvironmentBase *env)
+{
+	MM_HeapUncommitService *service = (MM_HeapUncommitService *)env->getForge()->allocate(sizeof(MM_HeapUncommitService), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != service) {
+		new(service) MM_HeapUncommitService(env);
+		if (!service->initialize(env)) {
+			service->kill(env);
+			service = NULL;
+		}
+	}
+	return service;
+}
+
+void
+MM_HeapUncommitService::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+bool
+MM_HeapUncommitService::initialize(MM_EnvironmentBase *env)
+{
+	/* Walks record at most HEAP_UNCOMMIT_RANGE_CAPACITY ranges, the rest of each table is room to merge in the previous ranges */
+	uintptr_t tableSize = 2 * HEAP_UNCOMMIT_RANGE_CAPACITY * sizeof(MM_HeapUncommitRange);
+	_ranges = (MM_HeapUncommitRange *)env->getForge()->allocate(tableSize, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	_nextRanges = (MM_HeapUncommitRange *)env->getForge()->allocate(tableSize, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if ((NULL == _ranges) || (NULL == _nextRanges)) {
+		return false;
+	}
+
+	return (0 == omrthread_monitor_init_with_name(&_monitor, 0, "MM_HeapUncommitService::monitor"));
+}
+
+void
+MM_HeapUncommitService::tearDown(MM_EnvironmentBase *env)
+{
+	Assert_MM_true(!_threadStarted);
+
+	if (NULL != _ranges) {
+		env->getForge()->free(_ranges);
+		_ranges = NULL;
+	}
+	if (NULL != _nextRanges) {
+		env->getForge()->free(_nextRanges);
+		_nextRanges = NULL;
+	}
+	if (NULL != _monitor) {
+		omrthread_monitor_destroy(_monitor);
+		_monitor = NULL;
+	}
+}
+
+bool
+MM_HeapUncommitService::startup()
+{
+	HeapUncommitServiceThreadInfo threadInfo;
+	threadInfo.omrVM = _extensions->getOmrVM();
+	threadInfo.service = this;
+	threadInfo.threadFlags = 0;
+
+	OMRPORT_ACCESS_FROM_OMRVM(threadInfo.omrVM);
+
+	omrthread_monitor_enter(_monitor);
+	/* With a delay the initial free heap is released once the heap has been quiet for as long, whether or not a global GC runs */
+	_request = (0 != _extensions->heapUncommitDelay) ? UNCOMMIT_REQUEST_UNCOMMIT : UNCOMMIT_REQUEST_WAIT;
+	_lastGlobalGCEndTime = omrtime_hires_clock();
+
+	intptr_t forkResult = createThreadWithCategory(&_thread, OMR_OS_STACK_SIZE, J9THREAD_PRIORITY_MIN, 0,
+			heap_uncommit_thread_proc, (void *)&threadInfo, J9THREAD_CATEGORY_SYSTEM_GC_THREAD);
+	if (0 == forkResult) {
+		while (0 == threadInfo.threadFlags) {
+			omrthread_monitor_wait(_monitor);
+		}
+		_threadStarted = (UNCOMMIT_THREAD_INFO_FLAG_OK == threadInfo.threadFlags);
+	}
+	omrthread_monitor_exit(_monitor);
+
+	return _threadStarted;
+}
+
+void
+MM_HeapUncommitService::signalStarted(void *info, bool attached)
+{
+	HeapUncommitServiceThreadInfo *threadInfo = (HeapUncommitServiceThreadInfo *)info;
+
+	omrthread_monitor_enter(_monitor);
+	threadInfo->threadFlags = attached ? UNCOMMIT_THREAD_INFO_FLAG_OK : UNCOMMIT_THREAD_INFO_FLAG_FAIL;
+	omrthread_monitor_notify_all(_monitor);
+	omrthread_monitor_exit(_monitor);
+}
+
+void
+MM_HeapUncommitService::shutdown()
+{
+	if (_threadStarted) {
+		omrthread_monitor_enter(_monitor);
+		_request = UNCOMMIT_REQUEST_SHUTDOWN;
+		omrthread_monitor_notify_all(_monitor);
+		while (UNCOMMIT_REQUEST_TERMINATED != _request) {
+			omrthread_monitor_wait(_monitor);
+		}
+		omrthread_monitor_exit(_monitor);
+		_threadStarted = false;
+		_thread = NULL;
+	}
+}
+
+void
+MM_HeapUncommitService::globalGCStart(MM_EnvironmentBase *env)
+{
+	/* Memory allocated from a released range may be dead by the end of this GC, so look before the sweep */
+	if (0 != _rangeCount) {
+		walkTenureFreeEntries(env, false);
+	}
+}
+
+void
+MM_HeapUncommitService::globalGCEnd(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+
+	omrthread_monitor_enter(_monitor);
+	_lastGlobalGCEndTime = omrtime_hires_clock();
+	if (UNCOMMIT_REQUEST_WAIT == _request) {
+		_request = UNCOMMIT_REQUEST_UNCOMMIT;
+	}
+	omrthread_monitor_notify_all(_monitor);
+	omrthread_monitor_exit(_monitor);
+}
+
+void
+MM_HeapUncommitService::heapReconfigured(MM_EnvironmentBase *env, HeapReconfigReason reason, void *lowAddress, void *highAddress)
+{
+	if ((HEAP_RECONFIG_CONTRACT == reason) && (0 != _rangeCount)) {
+		/* Contracted memory has been decommitted with the heap, it was not refaulted */
+		uintptr_t low = (uintptr_t)lowAddress;
+		uintptr_t high = (uintptr_t)highAddress;
+		_nextRangeCount = 0;
+		for (uintptr_t index = 0; index < _rangeCount; index++) {
+			MM_HeapUncommitRange *range = &_ranges[index];
+			if ((range->top <= low) || (range->base >= high)) {
+				recordRange(range->base, range->top);
+			} else {
+				if (range->base < low) {
+					recordRange(range->base, low);
+				}
+				if (range->top > high) {
+					recordRange(high, range->top);
+				}
+			}
+		}
+		/* nothing was walked, so the ranges left are all carried over */
+		_coveredBytes = _rangeBytes;
+		finishWalk(true);
+	}
+}
+
+void
+MM_HeapUncommitService::heapCleared(MM_EnvironmentBase *env)
+{
+	_stats._refaultedBytes += _rangeBytes;
+	_stats._totalRefaultedBytes += _rangeBytes;
+	_stats._trackedBytes = 0;
+	_rangeCount = 0;
+	_rangeBytes = 0;
+}
+
+bool
+MM_HeapUncommitService::shouldYield(MM_EnvironmentBase *env)
+{
+	return _decommit && env->isExclusiveAccessRequestWaiting();
+}
+
+bool
+MM_HeapUncommitService::walkTenureFreeEntries(MM_EnvironmentBase *env, bool decommit)
+{
+	bool complete = true;
+	_decommit = decommit;
+	_nextRangeCount = 0;
+	_coveredBytes = 0;
+
+	MM_HeapMemoryPoolIterator poolIterator(env, _extensions->heap);
+	MM_MemoryPool *memoryPool = NULL;
+	while (complete && (NULL != (memoryPool = poolIterator.nextPool()))) {
+		if (MEMORY_TYPE_OLD == (memoryPool->getSubSpace()->getTypeFlags() & MEMORY_TYPE_OLD)) {
+			complete = memoryPool->uncommitFreeMemoryPages(env, this);
+		}
+	}
+
+	finishWalk(complete);
+	return complete;
+}
+
+void
+MM_HeapUncommitService::finishWalk(bool complete)
+{
+	if (complete) {
+		/* Whatever the walk did not find in a free entry has been allocated since it was released */
+		uintptr_t refaultedBytes = _rangeBytes - _coveredBytes;
+		_stats._refaultedBytes += refaultedBytes;
+		_stats._totalRefaultedBytes += refaultedBytes;
+	} else {
+		/* Ranges in the part of the heap which was not walked are still released */
+		memcpy(&_nextRanges[_nextRangeCount], _ranges, _rangeCount * sizeof(MM_HeapUncommitRange));
+		_nextRangeCount += _rangeCount;
+	}
+
+	_nextRangeCount = OMR_MIN(sortAndCoalesce(_nextRanges, _nextRangeCount), HEAP_UNCOMMIT_RANGE_CAPACITY);
+
+	MM_HeapUncommitRange *ranges = _ranges;
+	_ranges = _nextRanges;
+	_rangeCount = _nextRangeCount;
+	_nextRanges = ranges;
+	_nextRangeCount = 0;
+
+	_rangeBytes = 0;
+	for (uintptr_t index = 0; index < _rangeCount; index++) {
+		_rangeBytes += _ranges[index].top - _ranges[index].base;
+	}
+	_stats._trackedBytes = _rangeBytes;
+}
+
+int
+MM_HeapUncommitService::compareRanges(const void *left, const void *right)
+{
+	uintptr_t leftBase = ((MM_HeapUncommitRange *)left)->base;
+	uintptr_t rightBase = ((MM_HeapUncommitRange *)right)->base;
+	if (leftBase < rightBase) {
+		return -1;
+	}
+	return (leftBase > rightBase) ? 1 : 0;
+}
+
+uintptr_t
+MM_HeapUncommitService::sortAndCoalesce(MM_HeapUncommitRange *ranges, uintptr_t count)
+{
+	uintptr_t merged = 0;
+
+	if (0 != count) {
+		J9_SORT(ranges, count, sizeof(MM_HeapUncommitRange), compareRanges);
+		for (uintptr_t index = 1; index < count; index++) {
+			if (ranges[index].base <= ranges[merged].top) {
+				ranges[merged].top = OMR_MAX(ranges[merged].top, ranges[index].top);
+			} else {
+				merged += 1;
+				ranges[merged] = ranges[index];
+			}
+		}
+		merged += 1;
+	}
+
+	return merged;
+}
+
+uintptr_t
+MM_HeapUncommitService::findRange(uintptr_t address)
+{
+	uintptr_t low = 0;
+	uintptr_t high = _rangeCount;
+	while (low < high) {
+		uintptr_t middle = low + ((high - low) / 2);
+		if (_ranges[middle].top <= address) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+bool
+MM_HeapUncommitService::recordRange(uintptr_t base, uintptr_t top)
+{
+	bool recorded = false;
+	if (_nextRangeCount < HEAP_UNCOMMIT_RANGE_CAPACITY) {
+		_nextRanges[_nextRangeCount].base = base;
+		_nextRanges[_nextRangeCount].top = top;
+		_nextRangeCount += 1;
+		recorded = true;
+	}
+	return recorded;
+}
+
+void
+MM_HeapUncommitService::carryReleasedRanges(uintptr_t base, uintptr_t top)
+{
+	for (uintptr_t index = findRange(base); (index < _rangeCount) && (_ranges[index].base < top); index++) {
+		uintptr_t carriedBase = OMR_MAX(base, _ranges[index].base);
+		uintptr_t carriedTop = OMR_MIN(top, _ranges[index].top);
+		_coveredBytes += carriedTop - carriedBase;
+		recordRange(carriedBase, carriedTop);
+	}
+}
+
+uintptr_t
+MM_HeapUncommitService::releasePages(MM_EnvironmentBase *env, uintptr_t base, uintptr_t top, void *highValidAddress)
+{
+	uintptr_t releasedBytes = 0;
+	uintptr_t cursor = base;
+	uintptr_t index = findRange(base);
+
+	while (cursor < top) {
+		/* release the gap up to the next range which is already released, then skip over that range */
+		uintptr_t gapTop = top;
+		uintptr_t nextCursor = top;
+		if ((index < _rangeCount) && (_ranges[index].base < top)) {
+			gapTop = OMR_MAX(cursor, _ranges[index].base);
+			nextCursor = OMR_MIN(top, _ranges[index].top);
+			index += 1;
+		}
+		if (cursor < gapTop) {
+			uintptr_t gapSize = gapTop - cursor;
+			if (_extensions->heap->decommitMemory((void *)cursor, gapSize, NULL, highValidAddress)) {
+				releasedBytes += gapSize;
+				if (!recordRange(cursor, gapTop)) {
+					_stats._untrackedBytes += gapSize;
+				}
+			}
+		}
+		cursor = nextCursor;
+	}
+
+	return releasedBytes;
+}
+
+MM_HeapLinkedFreeHeader *
+MM_HeapUncommitService::uncommitFreeEntries(MM_EnvironmentBase *env, MM_HeapLinkedFreeHeader *freeEntry, uintptr_t committedHeaderSize, void **resumeAddress)
+{
+	bool const compressed = env->compressObjectReferences();
+	uintptr_t pageSize = _extensions->heap->getPageSize();
+	uintptr_t minimumFreeEntrySize = OMR_MAX(pageSize, _extensions->heapUncommitMinimumFreeEntrySize);
+	uintptr_t batchBytes = 0;
+	uintptr_t batchEntries = 0;
+	MM_HeapLinkedFreeHeader *lastFreeEntry = NULL;
+
+	if (_decommit) {
+		_stats._batchCount += 1;
+	}
+
+	while ((NULL != freeEntry) && (batchBytes < _extensions->heapUncommitBatchSize) && (batchEntries < _extensions->heapUncommitBatchEntryCount)) {
+		/* Entries below the resume address were visited by a previous batch, before the entry the walk resumed from moved */
+		if ((void *)freeEntry >= *resumeAddress) {
+			/* the head of the entry stays committed, the pool writes it whenever the free list changes */
+			uintptr_t base = MM_Math::roundToCeiling(pageSize, (uintptr_t)freeEntry + committedHeaderSize);
+			uintptr_t top = MM_Math::roundToFloor(pageSize, (uintptr_t)freeEntry->afterEnd());
+			if (base < top) {
+				carryReleasedRanges(base, top);
+				if (_decommit && (minimumFreeEntrySize <= freeEntry->getSize())) {
+					uintptr_t retainedPages = ((top - base) / pageSize) * _extensions->decommitMinimumFree / 100;
+					batchBytes += releasePages(env, base + (retainedPages * pageSize), top, freeEntry->afterEnd());
+				}
+			}
+			*resumeAddress = freeEntry->afterEnd();
+		}
+		batchEntries += 1;
+		lastFreeEntry = freeEntry;
+		freeEntry = freeEntry->getNext(compressed);
+	}
+
+	_stats._releasedBytes += batchBytes;
+	return (NULL == freeEntry) ? NULL : lastFreeEntry;
+}
+
+void
+MM_HeapUncommitService::uncommit(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+
+	_stats.clearPass();
+	_stats._passCount += 1;
+	omrvmem_get_process_memory_size(OMRPORT_VMEM_PROCESS_PHYSICAL, &_stats._rssBefore);
+	uint64_t startTime = omrtime_hires_clock();
+
+	_stats._yielded = !walkTenureFreeEntries(env, true);
+
+	_stats._time = omrtime_hires_clock() - startTime;
+	omrvmem_get_process_memory_size(OMRPORT_VMEM_PROCESS_PHYSICAL, &_stats._rssAfter);
+	_stats._totalReleasedBytes += _stats._releasedBytes;
+
+	Trc_MM_HeapUncommitService_uncommit(env->getLanguageVMThread(), _stats._releasedBytes, _stats._batchCount,
+			_stats._yielded ? "yielded" : "complete", _stats._refaultedBytes, _stats._trackedBytes);
+
+	TRIGGER_J9HOOK_MM_PRIVATE_HEAP_UNCOMMIT(
+		_extensions->privateHookInterface,
+		env->getOmrVMThread(),
+		omrtime_hires_clock(),
+		J9HOOK_MM_PRIVATE_HEAP_UNCOMMIT,
+		_stats._releasedBytes,
+		_stats._batchCount,
+		_stats._yielded ? 1 : 0,
+		omrtime_hires_delta(0, _stats._time, OMRPORT_TIME_DELTA_IN_MICROSECONDS),
+		_stats._rssBefore,
+		_stats._rssAfter,
+		_stats._refaultedBytes,
+		_stats._trackedBytes,
+		_stats._totalReleasedBytes,
+		_stats._totalRefaultedBytes);
+
+	_stats.clearRefaults();
+}
+
+void
+MM_HeapUncommitService::serviceEntryPoint(OMR_VMThread *omrThread)
+{
+	MM_EnvironmentBase *env = MM_EnvironmentBase::getEnvironment(omrThread);
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+
+	/* Thread not a mutator so identify its type */
+	env->initializeGCThread();
+	env->setThreadType(GC_SERVICE_THREAD);
+
+	omrthread_monitor_enter(_monitor);
+	while (UNCOMMIT_REQUEST_SHUTDOWN != _request) {
+		if (UNCOMMIT_REQUEST_UNCOMMIT != _request) {
+			omrthread_monitor_wait(_monitor);
+			continue;
+		}
+		if (0 != _extensions->heapUncommitDelay) {
+			/* Pages freed by a busy heap are soon allocated again, so wait until global GCs stop for the delay */
+			uint64_t quietMillis = omrtime_hires_delta(_lastGlobalGCEndTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MILLISECONDS);
+			if (quietMillis < _extensions->heapUncommitDelay) {
+				omrthread_monitor_wait_timed(_monitor, (int64_t)(_extensions->heapUncommitDelay - quietMillis), 0);
+				continue;
+			}
+		}
+		/* Claim the request. A global GC which completes during this pass posts a new one. */
+		_request = UNCOMMIT_REQUEST_WAIT;
+		omrthread_monitor_exit(_monitor);
+
+		/* Shared VM access keeps global GCs, and so free list rebuilds, out while the pools are walked */
+		env->acquireVMAccess();
+		uncommit(env);
+		env->releaseVMAccess();
+
+		omrthread_monitor_enter(_monitor);
+	}
+	omrthread_monitor_exit(_monitor);
+
+	MM_EnvironmentBase::detachVMThread(_extensions->getOmrVM(), omrThread, MM_EnvironmentBase::ATTACH_GC_HELPER_THREAD);
+
+	omrthread_monitor_enter(_monitor);
+	_request = UNCOMMIT_REQUEST_TERMINATED;
+	omrthread_monitor_notify_all(_monitor);
+	omrthread_exit(_monitor);
+}
+
+MM_HeapUncommitService::MM_HeapUncommitService(MM_EnvironmentBase *env)
+	: MM_BaseNonVirtual()
+	, _extensions(env->getExtensions())
+	, _monitor(NULL)
+	, _thread(NULL)
+	, _request(UNCOMMIT_REQUEST_WAIT)
+	, _threadStarted(false)
+	, _lastGlobalGCEndTime(0)
+	, _ranges(NULL)
+	, _rangeCount(0)
+	, _rangeBytes(0)
+	, _nextRanges(NULL)
+	, _nextRangeCount(0)
+	, _coveredBytes(0)
+	, _decommit(false)
+	, _stats()
+{
+	_typeId = __FUNCTION__;
+}
@@ -0,0 +1,233 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#if !defined(HEAPUNCOMMITSERVICE_HPP_)
+#define HEAPUNCOMMITSERVICE_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrthread.h"
+#include "modronbase.h"
+
+#include "BaseNonVirtual.hpp"
+#include "HeapUncommitStats.hpp"
+
+class MM_EnvironmentBase;
+class MM_GCExtensionsBase;
+class MM_HeapLinkedFreeHeader;
+struct OMR_VMThread;
+
+/**
+ * Maximum number of released page ranges remembered between uncommit passes.
+ * Pages released beyond this are still returned to the OS, but are not tracked for refaults and are released again by the next pass.
+ */
+#define HEAP_UNCOMMIT_RANGE_CAPACITY 1024
+
+/**
+ * A page aligned range of free tenure memory which has been released to the OS.
+ */
+typedef struct MM_HeapUncommitRange {
+	uintptr_t base; /**< first byte of the range */
+	uintptr_t top; /**< first byte after the range */
+} MM_HeapUncommitRange;
+
+/**
+ * Background service which returns the pages of free tenure memory to the OS.
+ *
+ * After a global GC, or after startup when heapUncommitDelay is set, the service thread waits until no global GC has completed
+ * for heapUncommitDelay milliseconds and then walks the free lists of the tenure memory pools with shared VM access. Pages of
+ * free entries of at least heapUncommitMinimumFreeEntrySize bytes are decommitted in batches of at most heapUncommitBatchSize
+ * bytes and heapUncommitBatchEntryCount entries. The free list lock is released between batches so that allocating threads and
+ * exclusive access requests are not held up by the whole walk, and each batch resumes after the last entry visited, which the
+ * pool keeps current as allocations move or remove it.
+ *
+ * The released page ranges are remembered in a sorted table. Each walk intersects the table with the current free entries:
+ * ranges which are still free are not decommitted again, and ranges which are no longer free have been allocated, so their
+ * pages were faulted back in. The same accounting runs at the start of every global GC, before the sweep can make memory
+ * allocated and freed since the last pass look untouched.
+ * @ingroup GC_Modron_Standard
+ */
+class MM_HeapUncommitService : public MM_BaseNonVirtual
+{
+	/*
+	 * Data members
+	 */
+public:
+	enum UncommitRequest {
+		UNCOMMIT_REQUEST_WAIT = 0, /**< idle until the next global GC completes */
+		UNCOMMIT_REQUEST_UNCOMMIT, /**< a global GC completed or the service started, release pages once the delay has passed */
+		UNCOMMIT_REQUEST_SHUTDOWN, /**< the service thread must exit */
+		UNCOMMIT_REQUEST_TERMINATED /**< the service thread has exited */
+	};
+
+private:
+	MM_GCExtensionsBase *_extensions;
+	omrthread_monitor_t _monitor; /**< protects _request and _lastGlobalGCEndTime and is used to park the service thread */
+	omrthread_t _thread;
+	volatile UncommitRequest _request;
+	bool _threadStarted;
+	uint64_t _lastGlobalGCEndTime; /**< hi-res time at which the last global GC completed, or the service started */
+
+	MM_HeapUncommitRange *_ranges; /**< sorted, disjoint ranges released by previous passes */
+	uintptr_t _rangeCount;
+	uintptr_t _rangeBytes; /**< total size of _ranges */
+	MM_HeapUncommitRange *_nextRanges; /**< ranges still released after the walk in progress */
+	uintptr_t _nextRangeCount;
+	uintptr_t _coveredBytes; /**< bytes of _ranges found in free entries by the walk in progress */
+	bool _decommit; /**< true if the walk in progress releases pages, false if it only accounts for refaults */
+	MM_HeapUncommitStats _stats;
+
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+private:
+	/**
+	 * Walk the free entries of all tenure memory pools and finish the walk.
+	 * @param decommit true to release pages, false to only account for refaulted ranges
+	 * @return true if all pools were walked, false if the walk yielded
+	 */
+	bool walkTenureFreeEntries(MM_EnvironmentBase *env, bool decommit);
+
+	/**
+	 * Replace the released range table by the ranges found by the walk.
+	 * @param complete true if the whole tenure space was walked
+	 */
+	void finishWalk(bool complete);
+
+	/**
+	 * @return index of the first released range which ends after address, or _rangeCount
+	 */
+	uintptr_t findRange(uintptr_t address);
+
+	/**
+	 * Append a range to the table being built by the walk. Ranges which do not fit are dropped.
+	 * @return true if the range was recorded
+	 */
+	bool recordRange(uintptr_t base, uintptr_t top);
+
+	/**
+	 * Carry the parts of previously released ranges which lie within the free pages [base, top) over to the next table.
+	 */
+	void carryReleasedRanges(uintptr_t base, uintptr_t top);
+
+	/**
+	 * Decommit the pages within [base, top) which are not already released.
+	 * @param highValidAddress end of the free entry containing the pages
+	 * @return bytes decommitted
+	 */
+	uintptr_t releasePages(MM_EnvironmentBase *env, uintptr_t base, uintptr_t top, void *highValidAddress);
+
+	/**
+	 * Sort ranges by address and merge the ones which overlap or touch.
+	 * @return the number of ranges left
+	 */
+	static uintptr_t sortAndCoalesce(MM_HeapUncommitRange *ranges, uintptr_t count);
+	static int compareRanges(const void *left, const void *right);
+
+	/**
+	 * Release free tenure pages and report the pass. Called by the service thread with shared VM access.
+	 */
+	void uncommit(MM_EnvironmentBase *env);
+
+protected:
+	bool initialize(MM_EnvironmentBase *env);
+	void tearDown(MM_EnvironmentBase *env);
+
+public:
+	static MM_HeapUncommitService *newInstance(MM_EnvironmentBase *env);
+	void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Start the service thread.
+	 * @return true if the service thread attached successfully
+	 */
+	bool startup();
+
+	/**
+	 * Ask the service thread to exit and wait for it to terminate.
+	 */
+	void shutdown();
+
+	/**
+	 * Account for released pages the heap has allocated from since the last walk.
+	 * Called at the start of a global GC with exclusive access held.
+	 */
+	void globalGCStart(MM_EnvironmentBase *env);
+
+	/**
+	 * Wake the service thread to release the pages freed by the global GC which just completed.
+	 * Called with exclusive access held; the service thread starts once exclusive access is released.
+	 */
+	void globalGCEnd(MM_EnvironmentBase *env);
+
+	/**
+	 * Forget released ranges which are no longer part of the heap.
+	 * @param reason the reason for the reconfiguration; only contraction is of interest
+	 * @param lowAddress base of the memory added or removed
+	 * @param highAddress top of the memory added or removed
+	 */
+	void heapReconfigured(MM_EnvironmentBase *env, HeapReconfigReason reason, void *lowAddress, void *highAddress);
+
+	/**
+	 * Forget all released ranges after free memory was written, and account for them as refaulted.
+	 */
+	void heapCleared(MM_EnvironmentBase *env);
+
+	/**
+	 * Visit one batch of a free list on behalf of MM_MemoryPool::uncommitFreeMemoryPages(), with the lock of the list held.
+	 * A batch ends after heapUncommitBatchSize bytes have been released or heapUncommitBatchEntryCount entries have been visited.
+	 * @param freeEntry the head of the address ordered free list, or the entry after the one the previous batch of this list stopped at
+	 * @param committedHeaderSize bytes at the start of each free entry which the pool writes, and which stay committed
+	 * @param[in,out] resumeAddress end of the last entry visited by the previous batches of this list, NULL to start a list
+	 * @return the last entry visited by the batch, which the pool keeps current until the next batch, or NULL if the list has been walked completely
+	 */
+	MM_HeapLinkedFreeHeader *uncommitFreeEntries(MM_EnvironmentBase *env, MM_HeapLinkedFreeHeader *freeEntry, uintptr_t committedHeaderSize, void **resumeAddress);
+
+	/**
+	 * @return true if a releasing walk should give up the rest of the heap to a pending exclusive access request
+	 */
+	bool shouldYield(MM_EnvironmentBase *env);
+
+	/**
+	 * Report the attach result of a starting service thread to startup().
+	 * @param info the startup record passed to the thread procedure
+	 * @param attached true if the thread attached to the VM
+	 */
+	void signalStarted(void *info, bool attached);
+
+	/**
+	 * Entry point of the service thread.
+	 */
+	void serviceEntryPoint(OMR_VMThread *omrThread);
+
+	MM_HeapUncommitService(MM_EnvironmentBase *env);
+};
+
+#endif /* HEAPUNCOMMITSERVICE_HPP_ */
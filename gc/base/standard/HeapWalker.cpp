@@ -36,6 +36,10 @@
 #include "ObjectModel.hpp"
 #include "OMRVMInterface.hpp"
 #include "ParallelDispatcher.hpp"
+#if defined(OMR_GC_MODRON_SCAVENGER)
+#include "EnvironmentStandard.hpp"
+#include "Scavenger.hpp"
+#endif /* OMR_GC_MODRON_SCAVENGER */
 #include "SlotObject.hpp"
 #include "SublistIterator.hpp"
 #include "SublistSlotIterator.hpp"
@@ -157,6 +161,17 @@ MM_HeapWalker::rememberedObjectSlotsDo(MM_EnvironmentBase *env, MM_HeapWalkerSlo
 	omrobjectptr_t* slotPtr = NULL;
 	MM_SublistPuddle *puddle = NULL;
 	OMR_VMThread *omrVMThread = env->getOmrVMThread();
+	MM_Scavenger *scavenger = env->getExtensions()->scavenger;
+
+	/* Puddles still held for concurrent pruning are not on the list; put them back before walking it */
+	if (NULL != scavenger) {
+		if (!parallel) {
+			scavenger->completeConcurrentRememberedSetPrune(MM_EnvironmentStandard::getEnvironment(env));
+		} else if (env->_currentTask->synchronizeGCThreadsAndReleaseMain(env, UNIQUE_ID)) {
+			scavenger->completeConcurrentRememberedSetPrune(MM_EnvironmentStandard::getEnvironment(env));
+			env->_currentTask->releaseSynchronizedGCThreads(env);
+		}
+	}
 
 	GC_SublistIterator remSetIterator(&(env->getExtensions()->rememberedSet));
 	while ((puddle = remSetIterator.nextList()) != NULL) {
@@ -233,3 +248,41 @@ MM_HeapWalker::allObjectsDo(MM_EnvironmentBase *env, MM_HeapWalkerObjectFunc fun
 		}
 	}
 }
+
+void
+MM_HeapWalker::allObjectsDoBatched(MM_EnvironmentBase *env, MM_HeapWalkerObjectBatchFunc function, void *userData, uintptr_t walkFlags, bool parallel, bool prepareHeapForWalk)
+{
+	uintptr_t typeFlags = 0;
+
+	GC_OMRVMInterface::flushCachesForWalk(env->getOmrVM());
+
+	if (walkFlags & J9_MU_WALK_NEW_AND_REMEMBERED_ONLY) {
+		typeFlags |= MEMORY_TYPE_NEW;
+	}
+
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	MM_HeapRegionManager *regionManager = extensions->heap->getHeapRegionManager();
+	GC_HeapRegionIterator regionIterator(regionManager);
+	MM_HeapRegionDescriptor *region = NULL;
+	OMR_VMThread *omrVMThread = env->getOmrVMThread();
+	omrobjectptr_t batch[HEAP_WALKER_OBJECT_BATCH_SIZE];
+
+	while (NULL != (region = regionIterator.nextRegion())) {
+		if (typeFlags == (region->getTypeFlags() & typeFlags)) {
+			uintptr_t batchCount = 0;
+			omrobjectptr_t object = NULL;
+			GC_ObjectHeapIteratorAddressOrderedList liveObjectIterator(extensions, region, false);
+
+			while (NULL != (object = liveObjectIterator.nextObject())) {
+				batch[batchCount++] = object;
+				if (HEAP_WALKER_OBJECT_BATCH_SIZE == batchCount) {
+					function(omrVMThread, region, batch, batchCount, userData);
+					batchCount = 0;
+				}
+			}
+			if (0 != batchCount) {
+				function(omrVMThread, region, batch, batchCount, userData);
+			}
+		}
+	}
+}
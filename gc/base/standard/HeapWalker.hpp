@@ -35,8 +35,11 @@ class MM_Heap;
 class MM_HeapRegionDescriptor;
 class MM_MemorySubSpace;
 
+/* Most objects handed to a MM_HeapWalkerObjectBatchFunc in one call */
+#define HEAP_WALKER_OBJECT_BATCH_SIZE 256
 
 typedef void (*MM_HeapWalkerObjectFunc)(OMR_VMThread *, MM_HeapRegionDescriptor *, omrobjectptr_t, void *);
+typedef void (*MM_HeapWalkerObjectBatchFunc)(OMR_VMThread *, MM_HeapRegionDescriptor *, omrobjectptr_t *, uintptr_t, void *);
 typedef void (*MM_HeapWalkerSlotFunc)(OMR_VM *, omrobjectptr_t *, void *, uint32_t);
 
 class MM_HeapWalker : public MM_BaseVirtual
@@ -53,6 +56,14 @@ public:
 	virtual void allObjectSlotsDo(MM_EnvironmentBase *env, MM_HeapWalkerSlotFunc function, void *userData, uintptr_t walkFlags, bool parallel, bool prepareHeapForWalk);
 	virtual void allObjectsDo(MM_EnvironmentBase *env, MM_HeapWalkerObjectFunc function, void *userData, uintptr_t walkFlags, bool parallel, bool prepareHeapForWalk, bool includeDeadObjects);
 
+	/**
+	 * Walk through all live objects of the heap, handing them to the provided function in batches of up to
+	 * HEAP_WALKER_OBJECT_BATCH_SIZE objects from the same region. Heap inspection tools that do little work per
+	 * object should prefer this to allObjectsDo(). When the walk is parallel the function is called concurrently
+	 * by the GC threads, which can keep per thread state indexed by MM_EnvironmentBase::getWorkerID().
+	 */
+	virtual void allObjectsDoBatched(MM_EnvironmentBase *env, MM_HeapWalkerObjectBatchFunc function, void *userData, uintptr_t walkFlags, bool parallel, bool prepareHeapForWalk);
+
 	static MM_HeapWalker *newInstance(MM_EnvironmentBase *env); 	
 	virtual void kill(MM_EnvironmentBase *env);
 	
@@ -0,0 +1,273 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#include "ObjectHistogram.hpp"
+
+#include "EnvironmentBase.hpp"
+#include "Forge.hpp"
+#include "GCExtensionsBase.hpp"
+#include "HeapWalker.hpp"
+#include "ModronAssertions.h"
+#include "ObjectModel.hpp"
+#include "ParallelDispatcher.hpp"
+
+/**
+ * Helper function used by J9_SORT to order merged entries by decreasing total size.
+ */
+static int
+compareEntryBytesFunc(const void *element1, const void *element2)
+{
+	const MM_ObjectHistogram::Entry *entry1 = (const MM_ObjectHistogram::Entry *)element1;
+	const MM_ObjectHistogram::Entry *entry2 = (const MM_ObjectHistogram::Entry *)element2;
+
+	if (entry1->bytes == entry2->bytes) {
+		return (entry1->key < entry2->key) ? -1 : ((entry1->key > entry2->key) ? 1 : 0);
+	} else if (entry1->bytes > entry2->bytes) {
+		return -1;
+	} else {
+		return 1;
+	}
+}
+
+MM_ObjectHistogram *
+MM_ObjectHistogram::newInstance(MM_EnvironmentBase *env, KeyFunction keyFunction, void *keyUserData)
+{
+	MM_ObjectHistogram *histogram = (MM_ObjectHistogram *)env->getForge()->allocate(sizeof(MM_ObjectHistogram), OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if (NULL != histogram) {
+		new(histogram) MM_ObjectHistogram(keyFunction, keyUserData);
+		if (!histogram->initialize(env)) {
+			histogram->kill(env);
+			histogram = NULL;
+		}
+	}
+	return histogram;
+}
+
+void
+MM_ObjectHistogram::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+bool
+MM_ObjectHistogram::initialize(MM_EnvironmentBase *env)
+{
+	_extensions = env->getExtensions();
+	_threadTableCount = _extensions->dispatcher->threadCountMaximum();
+
+	_threadTables = (Table *)env->getForge()->allocate(sizeof(Table) * _threadTableCount, OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if (NULL == _threadTables) {
+		return false;
+	}
+	for (uintptr_t i = 0; i < _threadTableCount; i++) {
+		_threadTables[i].entries = NULL;
+		_threadTables[i].entryMask = 0;
+		_threadTables[i].used = 0;
+		_threadTables[i].failed = false;
+	}
+
+	return true;
+}
+
+void
+MM_ObjectHistogram::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _threadTables) {
+		for (uintptr_t i = 0; i < _threadTableCount; i++) {
+			tearDownTable(env, &_threadTables[i]);
+		}
+		env->getForge()->free(_threadTables);
+		_threadTables = NULL;
+	}
+	if (NULL != _entries) {
+		env->getForge()->free(_entries);
+		_entries = NULL;
+	}
+}
+
+bool
+MM_ObjectHistogram::initializeTable(MM_EnvironmentBase *env, Table *table, uintptr_t size)
+{
+	table->entries = (Entry *)env->getForge()->allocate(sizeof(Entry) * size, OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	table->entryMask = 0;
+	table->used = 0;
+	table->failed = (NULL == table->entries);
+	if (!table->failed) {
+		table->entryMask = size - 1;
+		for (uintptr_t i = 0; i < size; i++) {
+			table->entries[i].count = 0;
+		}
+	}
+	return !table->failed;
+}
+
+void
+MM_ObjectHistogram::tearDownTable(MM_EnvironmentBase *env, Table *table)
+{
+	if (NULL != table->entries) {
+		env->getForge()->free(table->entries);
+		table->entries = NULL;
+	}
+	table->entryMask = 0;
+	table->used = 0;
+}
+
+void
+MM_ObjectHistogram::addToTable(MM_EnvironmentBase *env, Table *table, uintptr_t key, uintptr_t count, uintptr_t bytes)
+{
+	if (NULL == table->entries) {
+		if (!initializeTable(env, table, INITIAL_TABLE_SIZE)) {
+			return;
+		}
+	}
+
+	uintptr_t index = hashKey(key, table->entryMask);
+	while (true) {
+		Entry *entry = &table->entries[index];
+		if (0 == entry->count) {
+			break;
+		} else if (key == entry->key) {
+			entry->count += count;
+			entry->bytes += bytes;
+			return;
+		}
+		index = (index + 1) & table->entryMask;
+	}
+
+	/* new key: keep the load factor under 3/4 so that probe sequences stay short */
+	uintptr_t size = table->entryMask + 1;
+	if (((table->used + 1) * 4) > (size * 3)) {
+		Table grown;
+		if (!initializeTable(env, &grown, size * 2)) {
+			/* keep counting the keys already present, but remember that the histogram is incomplete */
+			table->failed = true;
+			return;
+		}
+		for (uintptr_t i = 0; i < size; i++) {
+			Entry *entry = &table->entries[i];
+			if (0 != entry->count) {
+				uintptr_t newIndex = hashKey(entry->key, grown.entryMask);
+				while (0 != grown.entries[newIndex].count) {
+					newIndex = (newIndex + 1) & grown.entryMask;
+				}
+				grown.entries[newIndex] = *entry;
+			}
+		}
+		grown.used = table->used;
+		tearDownTable(env, table);
+		*table = grown;
+
+		index = hashKey(key, table->entryMask);
+		while (0 != table->entries[index].count) {
+			index = (index + 1) & table->entryMask;
+		}
+	}
+
+	Entry *entry = &table->entries[index];
+	entry->key = key;
+	entry->count = count;
+	entry->bytes = bytes;
+	table->used += 1;
+}
+
+void
+MM_ObjectHistogram::addObjectBatch(OMR_VMThread *omrVMThread, MM_HeapRegionDescriptor *region, omrobjectptr_t *objects, uintptr_t objectCount, void *userData)
+{
+	MM_ObjectHistogram *histogram = (MM_ObjectHistogram *)userData;
+	MM_EnvironmentBase *env = MM_EnvironmentBase::getEnvironment(omrVMThread);
+	GC_ObjectModel *objectModel = &histogram->_extensions->objectModel;
+	uintptr_t workerID = env->getWorkerID();
+	Table *table = &histogram->_threadTables[(workerID < histogram->_threadTableCount) ? workerID : 0];
+
+	for (uintptr_t i = 0; i < objectCount; i++) {
+		omrobjectptr_t object = objects[i];
+		uintptr_t bytes = objectModel->getConsumedSizeInBytesWithHeader(object);
+		uintptr_t key = (NULL == histogram->_keyFunction) ? bytes : histogram->_keyFunction(omrVMThread, object, histogram->_keyUserData);
+		histogram->addToTable(env, table, key, 1, bytes);
+	}
+}
+
+bool
+MM_ObjectHistogram::collect(MM_EnvironmentBase *env, MM_HeapWalker *heapWalker, uintptr_t walkFlags, bool parallel, bool prepareHeapForWalk)
+{
+	for (uintptr_t i = 0; i < _threadTableCount; i++) {
+		tearDownTable(env, &_threadTables[i]);
+		_threadTables[i].failed = false;
+	}
+	if (NULL != _entries) {
+		env->getForge()->free(_entries);
+		_entries = NULL;
+	}
+	_entryCount = 0;
+	_totalObjectCount = 0;
+	_totalBytes = 0;
+
+	heapWalker->allObjectsDoBatched(env, addObjectBatch, this, walkFlags, parallel, prepareHeapForWalk);
+
+	/* merge the thread tables into the first one, which is the largest when the walk was not parallel */
+	Table *merged = &_threadTables[0];
+	bool complete = !merged->failed;
+	for (uintptr_t i = 1; i < _threadTableCount; i++) {
+		Table *table = &_threadTables[i];
+		complete = complete && !table->failed;
+		if (NULL != table->entries) {
+			for (uintptr_t j = 0; j <= table->entryMask; j++) {
+				Entry *entry = &table->entries[j];
+				if (0 != entry->count) {
+					addToTable(env, merged, entry->key, entry->count, entry->bytes);
+				}
+			}
+			tearDownTable(env, table);
+		}
+	}
+	complete = complete && !merged->failed;
+
+	if (0 != merged->used) {
+		_entries = (Entry *)env->getForge()->allocate(sizeof(Entry) * merged->used, OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+		if (NULL == _entries) {
+			complete = false;
+		} else {
+			for (uintptr_t j = 0; j <= merged->entryMask; j++) {
+				Entry *entry = &merged->entries[j];
+				if (0 != entry->count) {
+					_entries[_entryCount] = *entry;
+					_entryCount += 1;
+					_totalObjectCount += entry->count;
+					_totalBytes += entry->bytes;
+				}
+			}
+			Assert_MM_true(_entryCount == merged->used);
+			J9_SORT(_entries, _entryCount, sizeof(Entry), compareEntryBytesFunc);
+		}
+	}
+	tearDownTable(env, merged);
+
+	Trc_MM_ObjectHistogram_collected(env->getLanguageVMThread(), _threadTableCount, _entryCount, _totalObjectCount, _totalBytes);
+
+	return complete;
+}
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#if !defined(OBJECTHISTOGRAM_HPP_)
+#define OBJECTHISTOGRAM_HPP_
+
+#include "omr.h"
+#include "omrcfg.h"
+#include "modronbase.h"
+#include "objectdescription.h"
+
+#include "BaseNonVirtual.hpp"
+
+class MM_EnvironmentBase;
+class MM_GCExtensionsBase;
+class MM_HeapRegionDescriptor;
+class MM_HeapWalker;
+
+/**
+ * Histogram of the live objects of the heap, built from a (parallel) batched heap walk.
+ *
+ * Objects are counted under a key chosen by the language through a KeyFunction, typically the class of the object,
+ * or under their consumed size when no function is supplied. Every GC thread counts into its own open addressed table,
+ * selected by worker ID, so the walk needs no synchronization; the tables are merged once the walk is complete and
+ * the merged entries are sorted by decreasing total size.
+ * @ingroup GC_Modron_Standard
+ */
+class MM_ObjectHistogram : public MM_BaseNonVirtual
+{
+	/*
+	 * Data members
+	 */
+public:
+	typedef uintptr_t (*KeyFunction)(OMR_VMThread *omrVMThread, omrobjectptr_t object, void *userData);
+
+	struct Entry {
+		uintptr_t key;
+		uintptr_t count; /**< number of objects with this key, 0 if the entry is unused */
+		uintptr_t bytes; /**< consumed size of those objects */
+	};
+
+private:
+	struct Table {
+		Entry *entries;
+		uintptr_t entryMask; /**< table size - 1, the table size being a power of 2 */
+		uintptr_t used; /**< entries with a non zero count */
+		bool failed; /**< the table could not grow and objects were dropped */
+	};
+
+	enum {
+		INITIAL_TABLE_SIZE = 256
+	};
+
+	MM_GCExtensionsBase *_extensions;
+	KeyFunction _keyFunction;
+	void *_keyUserData;
+	Table *_threadTables; /**< one table per GC thread, indexed by worker ID */
+	uintptr_t _threadTableCount;
+	Entry *_entries; /**< merged and sorted result of the last collect() */
+	uintptr_t _entryCount;
+	uintptr_t _totalObjectCount;
+	uintptr_t _totalBytes;
+
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+private:
+	MMINLINE uintptr_t hashKey(uintptr_t key, uintptr_t entryMask) const
+	{
+		return (uintptr_t)(((uint64_t)key * (uint64_t)0x9E3779B97F4A7C15ULL) >> 32) & entryMask;
+	}
+
+	bool initializeTable(MM_EnvironmentBase *env, Table *table, uintptr_t size);
+	void tearDownTable(MM_EnvironmentBase *env, Table *table);
+
+	/**
+	 * Add count objects totalling bytes under key, doubling the table when it becomes 3/4 full.
+	 */
+	void addToTable(MM_EnvironmentBase *env, Table *table, uintptr_t key, uintptr_t count, uintptr_t bytes);
+
+	static void addObjectBatch(OMR_VMThread *omrVMThread, MM_HeapRegionDescriptor *region, omrobjectptr_t *objects, uintptr_t objectCount, void *userData);
+
+protected:
+	bool initialize(MM_EnvironmentBase *env);
+	void tearDown(MM_EnvironmentBase *env);
+
+public:
+	/**
+	 * @param keyFunction function naming the bucket of an object, or NULL to bucket objects by consumed size
+	 * @param keyUserData passed through to keyFunction
+	 */
+	static MM_ObjectHistogram *newInstance(MM_EnvironmentBase *env, KeyFunction keyFunction, void *keyUserData);
+	void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Walk the heap and replace the histogram with its live objects.
+	 * @see MM_HeapWalker::allObjectsDoBatched()
+	 * @return false if memory ran out and the histogram is incomplete
+	 */
+	bool collect(MM_EnvironmentBase *env, MM_HeapWalker *heapWalker, uintptr_t walkFlags, bool parallel, bool prepareHeapForWalk);
+
+	MMINLINE uintptr_t getEntryCount() const { return _entryCount; }
+	MMINLINE const Entry *getEntries() const { return _entries; }
+	MMINLINE uintptr_t getTotalObjectCount() const { return _totalObjectCount; }
+	MMINLINE uintptr_t getTotalBytes() const { return _totalBytes; }
+
+	MM_ObjectHistogram(KeyFunction keyFunction, void *keyUserData)
+		: MM_BaseNonVirtual()
+		, _extensions(NULL)
+		, _keyFunction(keyFunction)
+		, _keyUserData(keyUserData)
+		, _threadTables(NULL)
+		, _threadTableCount(0)
+		, _entries(NULL)
+		, _entryCount(0)
+		, _totalObjectCount(0)
+		, _totalBytes(0)
+	{
+		_typeId = __FUNCTION__;
+	}
+};
+
+#endif /* OBJECTHISTOGRAM_HPP_ */
@@ -43,6 +43,7 @@
 #include "HeapMapIterator.hpp"
 #include "HeapRegionDescriptorStandard.hpp"
 #include "HeapRegionIteratorStandard.hpp"
+#include "HeapUncommitService.hpp"
 #include "MarkingScheme.hpp"
 #include "MemorySpace.hpp"
 #include "MemorySubSpace.hpp"
@@ -351,6 +352,14 @@ MM_ParallelGlobalGC::initialize(MM_EnvironmentBase *env)
 		goto error_no_memory;
 	}
 
+	/* A concurrent sweep leaves the free lists incomplete after the GC, so released ranges could not be accounted for */
+	if (_extensions->heapUncommit && !_extensions->isConcurrentSweepEnabled()) {
+		_heapUncommitService = MM_HeapUncommitService::newInstance(env);
+		if (NULL == _heapUncommitService) {
+			goto error_no_memory;
+		}
+	}
+
 	/* Attach to hooks required by the global collector's
 	 * heap resize (expand/contraction) functions
 	 */
@@ -415,6 +424,11 @@ MM_ParallelGlobalGC::tearDown(MM_EnvironmentBase *env)
 		_heapWalker->kill(env);
 		_heapWalker = NULL;
 	}
+
+	if (NULL != _heapUncommitService) {
+		_heapUncommitService->kill(env);
+		_heapUncommitService = NULL;
+	}
 }
 
 uintptr_t
@@ -763,7 +777,10 @@ MM_ParallelGlobalGC::shouldCompactThisCycle(MM_EnvironmentBase *env, MM_Allocate
 		uintptr_t totalSize = memorySubSpace->getActiveMemorySize();
 		MM_MemoryPool *memoryPool= memorySubSpace->getMemoryPool();
 		uintptr_t darkMatterBytes = 0;
-		if (!_extensions->concurrentSweep) {
+#if defined(OMR_GC_CONCURRENT_SWEEP)
+		if (!_extensions->concurrentSweep)
+#endif /* OMR_GC_CONCURRENT_SWEEP */
+		{
 			darkMatterBytes = memoryPool->getDarkMatterBytes();
 		}
 		uintptr_t freeMemorySize = memoryPool->getActualFreeMemorySize();
@@ -1104,6 +1121,10 @@ MM_ParallelGlobalGC::internalPreCollect(MM_EnvironmentBase *env, MM_MemorySubSpa
 		processLargeAllocateStatsBeforeGC(env);
 	}
 
+	if (NULL != _heapUncommitService) {
+		_heapUncommitService->globalGCStart(env);
+	}
+
 	reportGCCycleStart(env);
 	reportGCStart(env);
 	reportGCIncrementStart(env);
@@ -1133,6 +1154,9 @@ MM_ParallelGlobalGC::internalPostCollect(MM_EnvironmentBase *env, MM_MemorySubSp
 	/* The clear pass should execute before reporting the cycle end, where heap walks and fixups are reported */
 	if (env->_cycleState->_gcCode.shouldClearHeap()) {
 		clearHeap(env, clearFreeEntry);
+		if (NULL != _heapUncommitService) {
+			_heapUncommitService->heapCleared(env);
+		}
 	}
 	reportGCCycleFinalIncrementEnding(env);
 	reportGlobalGCIncrementEnd(env);
@@ -1172,6 +1196,9 @@ MM_ParallelGlobalGC::internalPostCollect(MM_EnvironmentBase *env, MM_MemorySubSp
 	}
 #endif /* defined(OMR_ENV_DATA64) && defined(OMR_GC_FULL_POINTERS) */
 
+	if (NULL != _heapUncommitService) {
+		_heapUncommitService->globalGCEnd(env);
+	}
 }
 
 void
@@ -1428,6 +1455,10 @@ void
 MM_ParallelGlobalGC::heapReconfigured(MM_EnvironmentBase *env, HeapReconfigReason reason, MM_MemorySubSpace *subspace, void *lowAddress, void *highAddress)
 {
 	_sweepScheme->heapReconfigured(env);
+
+	if (NULL != _heapUncommitService) {
+		_heapUncommitService->heapReconfigured(env, reason, lowAddress, highAddress);
+	}
 }
 
 bool
@@ -1438,12 +1469,20 @@ MM_ParallelGlobalGC::collectorStartup(MM_GCExtensionsBase* extensions)
 		extensions->scavenger->collectorStartup(extensions);
 	}
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
+	if (NULL != _heapUncommitService) {
+		if (!_heapUncommitService->startup()) {
+			return false;
+		}
+	}
 	return true;
 }
 
 void
 MM_ParallelGlobalGC::collectorShutdown(MM_GCExtensionsBase *extensions)
 {
+	if (NULL != _heapUncommitService) {
+		_heapUncommitService->shutdown();
+	}
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	if (extensions->scavengerEnabled && (NULL != extensions->scavenger)) {
 		extensions->scavenger->collectorShutdown(extensions);
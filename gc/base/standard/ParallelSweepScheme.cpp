@@ -191,6 +191,8 @@ MM_ParallelSweepScheme::initialize(MM_EnvironmentBase *env)
 	}
 	_sweepHeapSectioning = extensions->sweepHeapSectioning;
 
+	_markMapWordScanner.initialize(env);
+
 	if (0 != omrthread_monitor_init_with_name(&_mutexSweepPoolState, 0, "SweepPoolState Monitor")) {
 		return false;
 	}
@@ -328,6 +330,62 @@ MM_ParallelSweepScheme::setupForSweep(MM_EnvironmentBase *env)
  ****************************************
  */
 
+/**
+ * Read a word of the mark map being swept.
+ * A word in a stale chunk of an epoch tagged mark map is read as empty, the chunk is not zeroed.
+ */
+MMINLINE uintptr_t
+MM_ParallelSweepScheme::readMarkMapWord(uintptr_t *markMapWord)
+{
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	return _currentMarkMap->readSlotAt(markMapWord);
+#else /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+	return *markMapWord;
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+}
+
+/**
+ * Find the first non-empty word of the mark map being swept in [markMapCurrent, markMapTop).
+ * @return the address of the first non-empty word, or markMapTop if all words in the range are empty
+ */
+MMINLINE uintptr_t *
+MM_ParallelSweepScheme::findNonEmptyMarkMapWord(uintptr_t *markMapCurrent, uintptr_t *markMapTop)
+{
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	if (_currentMarkMap->isEpochTagged()) {
+		return findNonEmptyCurrentMarkMapWord(markMapCurrent, markMapTop);
+	}
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+	return _markMapWordScanner.findNonEmptyWord(markMapCurrent, markMapTop);
+}
+
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+/**
+ * Find the first non-empty word of an epoch tagged mark map in [markMapCurrent, markMapTop).
+ * Only chunks of the current epoch are scanned, each stale chunk is skipped whole as it is clear.
+ */
+uintptr_t *
+MM_ParallelSweepScheme::findNonEmptyCurrentMarkMapWord(uintptr_t *markMapCurrent, uintptr_t *markMapTop)
+{
+	uintptr_t *markMapBits = (uintptr_t *)_currentSweepBits;
+
+	while (markMapCurrent < markMapTop) {
+		uintptr_t slotIndex = markMapCurrent - markMapBits;
+		uintptr_t *markMapChunkTop = markMapBits + MM_Math::roundToFloor(J9MODRON_HEAPMAP_EPOCH_SLOTS_PER_CHUNK, slotIndex) + J9MODRON_HEAPMAP_EPOCH_SLOTS_PER_CHUNK;
+		markMapChunkTop = OMR_MIN(markMapChunkTop, markMapTop);
+		if (_currentMarkMap->isSlotCurrent(slotIndex)) {
+			uintptr_t *markMapFound = _markMapWordScanner.findNonEmptyWord(markMapCurrent, markMapChunkTop);
+			if (markMapFound < markMapChunkTop) {
+				return markMapFound;
+			}
+		}
+		markMapCurrent = markMapChunkTop;
+	}
+
+	return markMapTop;
+}
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+
 MMINLINE void
 MM_ParallelSweepScheme::sweepMarkMapBody(
 	uintptr_t * &markMapCurrent,
@@ -337,18 +395,11 @@ MM_ParallelSweepScheme::sweepMarkMapBody(
 	uintptr_t * &heapSlotFreeCurrent,
 	uintptr_t * &heapSlotFreeHead )
 {
-	if(*markMapCurrent == J9MODRON_OBM_SLOT_EMPTY) {
+	if(readMarkMapWord(markMapCurrent) == J9MODRON_OBM_SLOT_EMPTY) {
 		markMapFreeHead = markMapCurrent;
 		heapSlotFreeHead = heapSlotFreeCurrent;
 
-		markMapCurrent += 1;
-
-		while(markMapCurrent < markMapChunkTop) {
-			if(*markMapCurrent != J9MODRON_OBM_SLOT_EMPTY) {
-				break;
-			}
-			markMapCurrent += 1;
-		}
+		markMapCurrent = findNonEmptyMarkMapWord(markMapCurrent + 1, markMapChunkTop);
 
 		/* Find the number of slots we've walked
 		 * (pointer math makes this the number of slots)
@@ -370,7 +421,7 @@ MM_ParallelSweepScheme::sweepMarkMapHead(
 	uintptr_t markMapFreeBitIndexHead;
 
 	if(markMapFreeHead > markMapChunkBase) {
-		markMapHeadValue = *(markMapFreeHead - 1);
+		markMapHeadValue = readMarkMapWord(markMapFreeHead - 1);
 		markMapFreeBitIndexHead = J9MODRON_HEAP_SLOTS_PER_MARK_BIT * MM_Bits::trailingZeroes(markMapHeadValue);
 		if(markMapFreeBitIndexHead) {
 			heapSlotFreeHead -= markMapFreeBitIndexHead;
@@ -389,7 +440,7 @@ MM_ParallelSweepScheme::sweepMarkMapTail(
 	uintptr_t markMapFreeBitIndexTail;
 
 	if(markMapCurrent < markMapChunkTop) {
-		markMapTailValue = *markMapCurrent;
+		markMapTailValue = readMarkMapWord(markMapCurrent);
 		markMapFreeBitIndexTail = J9MODRON_HEAP_SLOTS_PER_MARK_BIT * MM_Bits::leadingZeroes(markMapTailValue);
 
 		if(markMapFreeBitIndexTail) {
@@ -405,7 +456,7 @@ MM_ParallelSweepScheme::performSamplingCalculations(MM_ParallelSweepChunk *sweep
 	uintptr_t darkMatter = 0;
 
 	/* this word has objects in it. Sample them for dark matter */
-	MM_HeapMapWordIterator markedObjectIterator(*markMapCurrent, heapSlotFreeCurrent);
+	MM_HeapMapWordIterator markedObjectIterator(readMarkMapWord(markMapCurrent), heapSlotFreeCurrent);
 
 	/* Hole at the beginning of the sample is not considered, since we do not know
 	 * if that's part of a preceding object or part of hole.
@@ -543,7 +594,7 @@ MM_ParallelSweepScheme::sweepChunk(MM_EnvironmentBase *env, MM_ParallelSweepChun
 	}
 
 	/* Process the trailing free entry - The body processing will handle trailing entries that cover a map slot or more */
-	if(*(markMapCurrent - 1) != J9MODRON_OBM_SLOT_EMPTY) {
+	if(readMarkMapWord(markMapCurrent - 1) != J9MODRON_OBM_SLOT_EMPTY) {
 		heapSlotFreeCount = 0;
 		heapSlotFreeHead = heapSlotFreeCurrent;
 		sweepMarkMapHead(markMapCurrent, markMapChunkBase, heapSlotFreeHead, heapSlotFreeCount);
@@ -37,6 +37,7 @@
 
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
+#include "MarkMapWordScanner.hpp"
 #include "MemoryPool.hpp"
 #include "ParallelTask.hpp"
 
@@ -104,6 +105,7 @@ protected:
 	uint8_t *_currentSweepBits;	/*< The base address of the raw bits used by the _currentMarkMap (sweep knows about this in order to perform some optimized types of map walking) */
 
 	void *_heapBase;
+	MM_MarkMapWordScanner _markMapWordScanner; /**< Finds the end of runs of empty mark map words using the widest kernel the processor supports */
 
 	MM_SweepHeapSectioning *_sweepHeapSectioning;	/**< pointer to Sweep Heap Sectioning */
 
@@ -122,6 +124,12 @@ protected:
 
 	void initializeSweepChunkTable(MM_EnvironmentBase *env);
 
+	uintptr_t readMarkMapWord(uintptr_t *markMapWord);
+	uintptr_t *findNonEmptyMarkMapWord(uintptr_t *markMapCurrent, uintptr_t *markMapTop);
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	uintptr_t *findNonEmptyCurrentMarkMapWord(uintptr_t *markMapCurrent, uintptr_t *markMapTop);
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+
 	void sweepMarkMapBody(uintptr_t * &markMapCurrent, uintptr_t * &markMapChunkTop, uintptr_t * &markMapFreeHead, uintptr_t &heapSlotFreeCount, uintptr_t * &heapSlotFreeCurrent, uintptr_t * &heapSlotFreeHead);
 	void sweepMarkMapHead(uintptr_t *markMapFreeHead, uintptr_t *markMapChunkBase, uintptr_t * &heapSlotFreeHead, uintptr_t &heapSlotFreeCount);
 	void sweepMarkMapTail(uintptr_t *markMapCurrent, uintptr_t *markMapChunkTop, uintptr_t &heapSlotFreeCount);
@@ -222,6 +230,7 @@ public:
 		, _currentMarkMap(NULL)
 		, _currentSweepBits(NULL)
 		, _heapBase(NULL)
+		, _markMapWordScanner()
 		, _sweepHeapSectioning(NULL)
 		, _poolSweepPoolState(NULL)
 		, _mutexSweepPoolState(0)
@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#include "omrcfg.h"
+#include "omr.h"
+#include "omrport.h"
+#include "ut_j9mm.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include "RememberedSetPruner.hpp"
+
+#include "EnvironmentStandard.hpp"
+#include "GCExtensionsBase.hpp"
+#include "ModronAssertions.h"
+#include "Scavenger.hpp"
+#include "SublistPool.hpp"
+
+typedef struct RememberedSetPrunerThreadInfo {
+	OMR_VM *omrVM;
+	MM_RememberedSetPruner *pruner;
+	volatile uintptr_t threadFlags;
+} RememberedSetPrunerThreadInfo;
+
+#define PRUNER_THREAD_INFO_FLAG_OK 1
+#define PRUNER_THREAD_INFO_FLAG_FAIL 2
+
+/**
+ * Remembered set pruner helper thread procedure
+ *
+ * @parm info Address of RememberedSetPrunerThreadInfo structure
+ */
+static int J9THREAD_PROC
+remembered_set_pruner_thread_proc(void *info)
+{
+	RememberedSetPrunerThreadInfo *threadInfo = (RememberedSetPrunerThreadInfo *)info;
+	MM_RememberedSetPruner *pruner = threadInfo->pruner;
+
+	/* Attach the thread as a system daemon thread */
+	OMR_VMThread *omrThread = MM_EnvironmentBase::attachVMThread(threadInfo->omrVM, "Remembered Set Pruner", MM_EnvironmentBase::ATTACH_GC_HELPER_THREAD);
+
+	/* Signal that the helper thread has started (or not); threadInfo must not be touched after this point */
+	pruner->signalStarted(threadInfo, NULL != omrThread);
+
+	if (NULL != omrThread) {
+		pruner->helperEntryPoint(omrThread);
+	}
+
+	return 0;
+}
+
+MM_RememberedSetPruner *
+MM_RememberedSetPruner::newInstance(MM_EnvironmentBase *env, MM_Scavenger *scavenger)
+{
+	MM_RememberedSetPruner *pruner = (MM_RememberedSetPruner *)env->getForge()->allocate(sizeof(MM_RememberedSetPruner), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != pruner) {
+		new(pruner) MM_RememberedSetPruner(env, scavenger);
+		if (!pruner->initialize(env)) {
+			pruner->kill(env);
+			pruner = NULL;
+		}
+	}
+	return pruner;
+}
+
+void
+MM_RememberedSetPruner::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+bool
+MM_RememberedSetPruner::initialize(MM_EnvironmentBase *env)
+{
+	return (0 == omrthread_monitor_init_with_name(&_monitor, 0, "MM_RememberedSetPruner::monitor"));
+}
+
+void
+MM_RememberedSetPruner::tearDown(MM_EnvironmentBase *env)
+{
+	Assert_MM_true(!_threadStarted);
+
+	if (NULL != _monitor) {
+		omrthread_monitor_destroy(_monitor);
+		_monitor = NULL;
+	}
+}
+
+bool
+MM_RememberedSetPruner::startup()
+{
+	RememberedSetPrunerThreadInfo threadInfo;
+	threadInfo.omrVM = _extensions->getOmrVM();
+	threadInfo.pruner = this;
+	threadInfo.threadFlags = 0;
+
+	omrthread_monitor_enter(_monitor);
+	_request = PRUNER_REQUEST_WAIT;
+
+	/* Run at minimum priority, like the concurrent mark helpers, so that pruning only consumes otherwise idle cycles */
+	intptr_t forkResult = createThreadWithCategory(&_thread, OMR_OS_STACK_SIZE, J9THREAD_PRIORITY_MIN, 0,
+			remembered_set_pruner_thread_proc, (void *)&threadInfo, J9THREAD_CATEGORY_SYSTEM_GC_THREAD);
+	if (0 == forkResult) {
+		while (0 == threadInfo.threadFlags) {
+			omrthread_monitor_wait(_monitor);
+		}
+		_threadStarted = (PRUNER_THREAD_INFO_FLAG_OK == threadInfo.threadFlags);
+	}
+	omrthread_monitor_exit(_monitor);
+
+	return _threadStarted;
+}
+
+void
+MM_RememberedSetPruner::signalStarted(void *info, bool attached)
+{
+	RememberedSetPrunerThreadInfo *threadInfo = (RememberedSetPrunerThreadInfo *)info;
+
+	omrthread_monitor_enter(_monitor);
+	threadInfo->threadFlags = attached ? PRUNER_THREAD_INFO_FLAG_OK : PRUNER_THREAD_INFO_FLAG_FAIL;
+	omrthread_monitor_notify_all(_monitor);
+	omrthread_monitor_exit(_monitor);
+}
+
+void
+MM_RememberedSetPruner::shutdown()
+{
+	if (_threadStarted) {
+		omrthread_monitor_enter(_monitor);
+		_request = PRUNER_REQUEST_SHUTDOWN;
+		omrthread_monitor_notify_all(_monitor);
+		while (PRUNER_REQUEST_TERMINATED != _request) {
+			omrthread_monitor_wait(_monitor);
+		}
+		omrthread_monitor_exit(_monitor);
+		_threadStarted = false;
+		_thread = NULL;
+	}
+}
+
+void
+MM_RememberedSetPruner::resume(MM_EnvironmentBase *env)
+{
+	omrthread_monitor_enter(_monitor);
+	if (PRUNER_REQUEST_WAIT == _request) {
+		_request = PRUNER_REQUEST_PRUNE;
+		omrthread_monitor_notify_all(_monitor);
+	}
+	omrthread_monitor_exit(_monitor);
+}
+
+void
+MM_RememberedSetPruner::consumeStats(uint64_t *pruneTime, uintptr_t *prunedCount)
+{
+	*pruneTime += _pruneTime;
+	*prunedCount += _prunedCount;
+	_pruneTime = 0;
+	_prunedCount = 0;
+}
+
+void
+MM_RememberedSetPruner::helperEntryPoint(OMR_VMThread *omrThread)
+{
+	MM_EnvironmentStandard *env = MM_EnvironmentStandard::getEnvironment(omrThread);
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+
+	/* Thread not a mutator so identify its type */
+	env->initializeGCThread();
+	env->setThreadType(CON_MARK_HELPER_THREAD);
+
+	omrthread_monitor_enter(_monitor);
+	while (PRUNER_REQUEST_SHUTDOWN != _request) {
+		if (PRUNER_REQUEST_PRUNE != _request) {
+			omrthread_monitor_wait(_monitor);
+			continue;
+		}
+		/* Claim the request. A scavenge that completes while this pass is yielded posts a new one. */
+		_request = PRUNER_REQUEST_WAIT;
+		omrthread_monitor_exit(_monitor);
+
+		/* Shared VM access keeps exclusive access (and so the next collection) out while a puddle is claimed */
+		env->acquireVMAccess();
+		uint64_t startTime = omrtime_hires_clock();
+		uintptr_t puddleCount = 0;
+		uintptr_t prunedCount = 0;
+		bool complete = _scavenger->pruneRememberedSetConcurrently(env, &puddleCount, &prunedCount);
+		_pruneTime += omrtime_hires_clock() - startTime;
+		_prunedCount += prunedCount;
+		Trc_MM_RememberedSetPruner_helperPass(env->getLanguageVMThread(), prunedCount, puddleCount, complete ? "complete" : "yielded");
+		env->releaseVMAccess();
+
+		omrthread_monitor_enter(_monitor);
+	}
+	omrthread_monitor_exit(_monitor);
+
+	MM_EnvironmentBase::detachVMThread(_extensions->getOmrVM(), omrThread, MM_EnvironmentBase::ATTACH_GC_HELPER_THREAD);
+
+	omrthread_monitor_enter(_monitor);
+	_request = PRUNER_REQUEST_TERMINATED;
+	omrthread_monitor_notify_all(_monitor);
+	omrthread_exit(_monitor);
+}
+
+MM_RememberedSetPruner::MM_RememberedSetPruner(MM_EnvironmentBase *env, MM_Scavenger *scavenger)
+	: MM_BaseNonVirtual()
+	, _extensions(env->getExtensions())
+	, _scavenger(scavenger)
+	, _monitor(NULL)
+	, _thread(NULL)
+	, _request(PRUNER_REQUEST_WAIT)
+	, _threadStarted(false)
+	, _pruneTime(0)
+	, _prunedCount(0)
+{
+	_typeId = __FUNCTION__;
+}
+
+#endif /* OMR_GC_MODRON_SCAVENGER */
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#if !defined(REMEMBEREDSETPRUNER_HPP_)
+#define REMEMBEREDSETPRUNER_HPP_
+
+#include "omrcfg.h"
+#include "omrthread.h"
+#include "modronbase.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include "BaseNonVirtual.hpp"
+
+class MM_EnvironmentBase;
+class MM_GCExtensionsBase;
+class MM_Scavenger;
+struct OMR_VMThread;
+
+/**
+ * Background helper which prunes the scavenger remembered set between scavenges.
+ *
+ * At the end of a scavenge the puddles of the remembered set are detached (see MM_SublistPool::startProcessingSublist())
+ * and entries flagged for deferred removal are left in place. The helper thread claims one detached puddle at a time,
+ * prunes it while holding shared VM access, and returns it to the pool. Mutators never append to detached puddles, so the
+ * only coordination with the write barrier is on the remembered state in the object header (see MM_Scavenger::prunePuddleConcurrently()).
+ * Whatever the helper has not processed by the time exclusive access is next requested is drained inside that pause.
+ * @ingroup GC_Modron_Standard
+ */
+class MM_RememberedSetPruner : public MM_BaseNonVirtual
+{
+	/*
+	 * Data members
+	 */
+public:
+	enum PrunerRequest {
+		PRUNER_REQUEST_WAIT = 0, /**< idle until the next scavenge hands over puddles */
+		PRUNER_REQUEST_PRUNE, /**< detached puddles are pending */
+		PRUNER_REQUEST_SHUTDOWN, /**< the helper thread must exit */
+		PRUNER_REQUEST_TERMINATED /**< the helper thread has exited */
+	};
+
+private:
+	MM_GCExtensionsBase *_extensions;
+	MM_Scavenger *_scavenger;
+	omrthread_monitor_t _monitor; /**< protects _request and is used to park the helper thread */
+	omrthread_t _thread;
+	volatile PrunerRequest _request;
+	bool _threadStarted;
+	uint64_t _pruneTime; /**< hi-res ticks spent pruning by the helper since stats were last consumed */
+	uintptr_t _prunedCount; /**< entries removed by the helper since stats were last consumed */
+
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+private:
+protected:
+	bool initialize(MM_EnvironmentBase *env);
+	void tearDown(MM_EnvironmentBase *env);
+
+public:
+	static MM_RememberedSetPruner *newInstance(MM_EnvironmentBase *env, MM_Scavenger *scavenger);
+	void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Start the helper thread. Failure to start leaves all pending puddles to be drained at the next pause.
+	 * @return true if the helper thread attached successfully
+	 */
+	bool startup();
+
+	/**
+	 * @return true if the helper thread is running
+	 */
+	MMINLINE bool isStarted() const { return _threadStarted; }
+
+	/**
+	 * Ask the helper thread to exit and wait for it to terminate.
+	 */
+	void shutdown();
+
+	/**
+	 * Wake the helper thread to prune the puddles detached by the scavenge which just completed.
+	 * Called with exclusive access held; the helper starts once exclusive access is released.
+	 */
+	void resume(MM_EnvironmentBase *env);
+
+	/**
+	 * Fetch and reset the work done by the helper thread since the previous call.
+	 * Must be called with exclusive access held so the helper is not concurrently pruning.
+	 * @param[out] pruneTime hi-res ticks spent pruning
+	 * @param[out] prunedCount entries removed
+	 */
+	void consumeStats(uint64_t *pruneTime, uintptr_t *prunedCount);
+
+	/**
+	 * Report the attach result of a starting helper thread to startup().
+	 * @param info the startup record passed to the thread procedure
+	 * @param attached true if the thread attached to the VM
+	 */
+	void signalStarted(void *info, bool attached);
+
+	/**
+	 * Entry point of the helper thread.
+	 */
+	void helperEntryPoint(OMR_VMThread *omrThread);
+
+	MM_RememberedSetPruner(MM_EnvironmentBase *env, MM_Scavenger *scavenger);
+};
+
+#endif /* OMR_GC_MODRON_SCAVENGER */
+#endif /* REMEMBEREDSETPRUNER_HPP_ */
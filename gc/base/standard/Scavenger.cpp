@@ -76,6 +76,8 @@
 #include "ParallelDispatcher.hpp"
 #include "ParallelScavengeTask.hpp"
 #include "PhysicalSubArena.hpp"
+#include "RememberedSetPruner.hpp"
+#include "ScavengerHotFieldTable.hpp"
 #include "RSOverflow.hpp"
 #include "Scavenger.hpp"
 #include "ScavengerBackOutScanner.hpp"
@@ -239,6 +241,23 @@ MM_Scavenger::initialize(MM_EnvironmentBase *env)
 	/* do not spin when acquiring monitor to notify blocking thread about new work */
 	((J9ThreadAbstractMonitor *)_scanCacheMonitor)->flags &= ~J9THREAD_MONITOR_TRY_ENTER_SPIN;
 
+	if (_extensions->scavengerWorkStealing) {
+		_scanCacheDequeCount = _extensions->gcThreadCount;
+		_scanCacheDeques = (MM_CopyScanCacheDeque *)_extensions->getForge()->allocate(sizeof(MM_CopyScanCacheDeque) * _scanCacheDequeCount, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+		if (NULL == _scanCacheDeques) {
+			_scanCacheDequeCount = 0;
+			return false;
+		}
+		for (uintptr_t i = 0; i < _scanCacheDequeCount; i++) {
+			new (&_scanCacheDeques[i]) MM_CopyScanCacheDeque();
+		}
+		for (uintptr_t i = 0; i < _scanCacheDequeCount; i++) {
+			if (!_scanCacheDeques[i].initialize(env, _extensions->scavengerWorkStealingDequeSize, i + 1)) {
+				return false;
+			}
+		}
+	}
+
 	if (omrthread_monitor_init_with_name(&_freeCacheMonitor, 0, "MM_Scavenger::freeCacheMonitor")) {
 		return false;
 	}
@@ -296,6 +315,21 @@ MM_Scavenger::initialize(MM_EnvironmentBase *env)
 		return false;
 	}
 
+	if (_extensions->scavengerConcurrentRememberedSetPrune && !IS_CONCURRENT_ENABLED) {
+		/* Concurrent Scavenger already processes the remembered set outside of the pause */
+		_rememberedSetPruner = MM_RememberedSetPruner::newInstance(env, this);
+		if (NULL == _rememberedSetPruner) {
+			return false;
+		}
+	}
+
+	if (_extensions->scavengerLearnHotFields) {
+		_hotFieldTable = MM_ScavengerHotFieldTable::newInstance(env, _extensions->scavengerHotFieldTableSize);
+		if (NULL == _hotFieldTable) {
+			return false;
+		}
+	}
+
 	return true;
 }
 
@@ -304,9 +338,28 @@ MM_Scavenger::tearDown(MM_EnvironmentBase *env)
 {
 	_delegate.tearDown(env);
 
+	if (NULL != _rememberedSetPruner) {
+		_rememberedSetPruner->kill(env);
+		_rememberedSetPruner = NULL;
+	}
+
+	if (NULL != _hotFieldTable) {
+		_hotFieldTable->kill(env);
+		_hotFieldTable = NULL;
+	}
+
 	_scavengeCacheFreeList.tearDown(env);
 	_scavengeCacheScanList.tearDown(env);
 
+	if (NULL != _scanCacheDeques) {
+		for (uintptr_t i = 0; i < _scanCacheDequeCount; i++) {
+			_scanCacheDeques[i].tearDown(env);
+		}
+		_extensions->getForge()->free(_scanCacheDeques);
+		_scanCacheDeques = NULL;
+		_scanCacheDequeCount = 0;
+	}
+
 	if (NULL != _scanCacheMonitor) {
 		omrthread_monitor_destroy(_scanCacheMonitor);
 		_scanCacheMonitor = NULL;
@@ -352,6 +405,11 @@ MM_Scavenger::collectorStartup(MM_GCExtensionsBase* extensions)
 		}
 	}
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */
+	if (NULL != _rememberedSetPruner) {
+		if (!_rememberedSetPruner->startup()) {
+			return false;
+		}
+	}
 	return true;
 }
 
@@ -375,6 +433,9 @@ MM_Scavenger::collectorShutdown(MM_GCExtensionsBase* extensions)
 		_concurrentPhase = concurrent_phase_idle;
 	}
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */
+	if (NULL != _rememberedSetPruner) {
+		_rememberedSetPruner->shutdown();
+	}
 }
 
 /****************************************
@@ -402,6 +463,7 @@ MM_Scavenger::mainSetupForGC(MM_EnvironmentStandard *env)
 	/* Reinitialize the copy scan caches */
 	Assert_MM_true(_scavengeCacheFreeList.areAllCachesReturned());
 	Assert_MM_true(0 == _cachedEntryCount);
+	Assert_MM_true(0 == _dequeCachedEntryCount);
 	_extensions->copyScanRatio.reset(env, true);
 
 	/* Cache heap ranges for fast "valid object" checks (this can change in an expanding heap situation, so we refetch every cycle) */
@@ -459,6 +521,12 @@ MM_Scavenger::mainSetupForGC(MM_EnvironmentStandard *env)
 	/* Record the tenure mask */
 	_tenureMask = calculateTenureMask();
 
+	if (NULL != _hotFieldTable) {
+		/* Mutators are stopped, so the copy path can read the learned hot fields without racing samples */
+		uintptr_t classCount = _hotFieldTable->publish(env);
+		Trc_MM_Scavenger_publishLearnedHotFields(env->getLanguageVMThread(), classCount, _hotFieldTable->getDroppedSamples());
+	}
+
 	_activeSubSpace->mainSetupForGC(env);
 
 	_activeSubSpace->cacheRanges(_evacuateMemorySubSpace, &_evacuateSpaceBase, &_evacuateSpaceTop);
@@ -466,6 +534,18 @@ MM_Scavenger::mainSetupForGC(MM_EnvironmentStandard *env)
 
 	/* assume that value of RS Overflow flag will not be changed until scavengeRememberedSet() call, so handle it first */
 	_isRememberedSetInOverflowAtTheBeginning = isRememberedSetInOverflowState();
+
+	if (NULL != _rememberedSetPruner) {
+		/* Finish the pruning the background helper did not get to since the previous scavenge */
+		OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+		MM_ScavengerStats *scavengerStats = &_extensions->scavengerStats;
+		uint64_t drainStartTime = omrtime_hires_clock();
+		uintptr_t drainedCount = completeConcurrentRememberedSetPrune(env);
+		scavengerStats->_rememberedSetPruneTime += omrtime_hires_clock() - drainStartTime;
+		scavengerStats->_rememberedSetPrunedCount += drainedCount;
+		_rememberedSetPruner->consumeStats(&scavengerStats->_rememberedSetConcurrentPruneTime, &scavengerStats->_rememberedSetConcurrentPrunedCount);
+		Trc_MM_Scavenger_completeConcurrentRememberedSetPrune(env->getLanguageVMThread(), drainedCount, scavengerStats->_rememberedSetConcurrentPrunedCount);
+	}
 	_extensions->rememberedSet.startProcessingSublist();
 }
 
@@ -501,6 +581,11 @@ MM_Scavenger::workerSetupForGC(MM_EnvironmentStandard *env)
 	Assert_MM_false(env->_loaAllocation);
 	Assert_MM_true(NULL == env->_survivorTLHRemainderBase);
 	Assert_MM_true(NULL == env->_survivorTLHRemainderTop);
+
+	if (_extensions->numaAwareNursery) {
+		/* GC threads may be rebound between cycles; survivor copy TLHs are taken from the slice of the current node */
+		env->cacheNumaAffinity();
+	}
 }
 
 uintptr_t
@@ -606,6 +691,7 @@ MM_Scavenger::scavenge(MM_EnvironmentBase *envBase)
 
 	Assert_MM_true(_scavengeCacheFreeList.areAllCachesReturned());
 	Assert_MM_true(0 == _cachedEntryCount);
+	Assert_MM_true(0 == _dequeCachedEntryCount);
 }
 
 void
@@ -826,6 +912,9 @@ MM_Scavenger::mergeGCStatsBase(MM_EnvironmentBase *env, MM_ScavengerStats *final
 	finalGCStats->_flipDiscardBytes += scavStats->_flipDiscardBytes;
 	finalGCStats->_tenureDiscardBytes += scavStats->_tenureDiscardBytes;
 
+	finalGCStats->_workStealAttemptCount += scavStats->_workStealAttemptCount;
+	finalGCStats->_workStealCount += scavStats->_workStealCount;
+
 	finalGCStats->_survivorTLHRemainderCount += scavStats->_survivorTLHRemainderCount;
 	finalGCStats->_tenureTLHRemainderCount += scavStats->_tenureTLHRemainderCount;
 
@@ -847,6 +936,9 @@ MM_Scavenger::mergeGCStatsBase(MM_EnvironmentBase *env, MM_ScavengerStats *final
 	finalGCStats->_tenureExpandedCount += scavStats->_tenureExpandedCount;
 	finalGCStats->_tenureExpandedTime += scavStats->_tenureExpandedTime;
 
+	finalGCStats->_rememberedSetPruneTime += scavStats->_rememberedSetPruneTime;
+	finalGCStats->_rememberedSetPrunedCount += scavStats->_rememberedSetPrunedCount;
+
 #if defined(OMR_SCAVENGER_TRACK_COPY_DISTANCE)
 	for (uintptr_t i = 0; i < OMR_SCAVENGER_DISTANCE_BINS; i++) {
 		finalGCStats->_copy_distance_counts[i] += scavStats->_copy_distance_counts[i];
@@ -1067,7 +1159,7 @@ MM_Scavenger::calculateOptimumCopyScanCacheSize(MM_EnvironmentStandard *env)
 		cacheSize = OMR_MIN(cacheSizeBasedOnWaitingCount, cacheSize);
 	}
 
-	env->approxScanCacheCount = _scavengeCacheScanList.getApproximateEntryCount();
+	env->approxScanCacheCount = getApproximateScanCacheCount();
 	if (env->approxScanCacheCount < threadCount) {
 		uintptr_t cacheSizeBasedOnScanCacheCount = calculateCopyScanCacheSizeForQueueLength(maxCacheSize, threadCount, env->approxScanCacheCount);
 		cacheSize = OMR_MIN(cacheSizeBasedOnScanCacheCount, cacheSize);
@@ -1869,8 +1961,20 @@ MM_Scavenger::depthCopyHotFields(MM_EnvironmentStandard *env, MM_ForwardedHeader
 					copyHotField(env, destinationObjectPtr, hotFieldOffset3);
 				}
 			}
-		} else if (_extensions->alwaysDepthCopyFirstOffset && !_extensions->objectModel.isIndexable(forwardedHeader)) {
-			copyHotField(env, destinationObjectPtr, DEFAULT_HOT_FIELD_OFFSET);
+		} else {
+			const uint8_t *learnedHotFieldOffsets = NULL;
+			/* Learned offsets name fields of a class, they say nothing about the elements of an array */
+			if ((NULL != _hotFieldTable) && !_extensions->objectModel.isIndexable(forwardedHeader)) {
+				learnedHotFieldOffsets = _hotFieldTable->getHotFieldOffsets(_extensions->objectModel.getHotFieldClassKey(destinationObjectPtr));
+			}
+			if (NULL != learnedHotFieldOffsets) {
+				/* the object model declares no hot fields for the class, use those learned from the mutators */
+				for (uintptr_t i = 0; (i < MM_ScavengerHotFieldTable::HOT_FIELD_COUNT) && (U_8_MAX != learnedHotFieldOffsets[i]); i++) {
+					copyHotField(env, destinationObjectPtr, learnedHotFieldOffsets[i]);
+				}
+			} else if (_extensions->alwaysDepthCopyFirstOffset && !_extensions->objectModel.isIndexable(forwardedHeader)) {
+				copyHotField(env, destinationObjectPtr, DEFAULT_HOT_FIELD_OFFSET);
+			}
 		}
 	}
 }
@@ -1974,7 +2078,7 @@ MM_Scavenger::updateCopyScanCounts(MM_EnvironmentBase* env, uint64_t slotsScanne
 	env->_scavengerStats._slotsCopied += slotsCopied;
 	uint64_t updateResult = _extensions->copyScanRatio.update(env, &(env->_scavengerStats._slotsScanned), &(env->_scavengerStats._slotsCopied), _waitingCount, &(env->_scavengerStats._copyScanUpdates));
 	if (0 != updateResult) {
-		_extensions->copyScanRatio.majorUpdate(env, updateResult, _cachedEntryCount, _scavengeCacheScanList.getApproximateEntryCount());
+		_extensions->copyScanRatio.majorUpdate(env, updateResult, _cachedEntryCount, getApproximateScanCacheCount());
 	}
 }
 
@@ -1988,9 +2092,9 @@ MM_Scavenger::flushCopyScanCounts(MM_EnvironmentBase* env, bool majorFlush)
 	}
 
 	if (majorFlush) {
-		_extensions->copyScanRatio.flush(env, _cachedEntryCount, _scavengeCacheScanList.getApproximateEntryCount());
+		_extensions->copyScanRatio.flush(env, _cachedEntryCount, getApproximateScanCacheCount());
 	} else if (0 != updateResult) {
-		_extensions->copyScanRatio.majorUpdate(env, updateResult, _cachedEntryCount, _scavengeCacheScanList.getApproximateEntryCount());
+		_extensions->copyScanRatio.majorUpdate(env, updateResult, _cachedEntryCount, getApproximateScanCacheCount());
 	}
 }
 
@@ -2268,7 +2372,7 @@ MM_Scavenger::shouldDoFinalNotify(MM_EnvironmentStandard *env)
 
 		/* If no work has been created and no one requested to yeild meanwhile, go and wait for new work */
 		if (!checkAndSetShouldYieldFlag(env)) {
-			if (0 == _cachedEntryCount) {
+			if (!isScanCacheAvailable()) {
 				Assert_MM_true(!_scavengeCacheFreeList.areAllCachesReturned());
 
 				/* The only known reason for timeout is a rare case if Exclusive VM Access request came from a nonGC party. If we did not have a timeout,
@@ -2340,17 +2444,29 @@ MM_Scavenger::getNextScanCache(MM_EnvironmentStandard *env)
 		return cache;
 	}
 
+	MM_CopyScanCacheDeque *deque = getScanCacheDeque(env);
+	if (NULL != deque) {
+		cache = deque->pop();
+		if (NULL != cache) {
+			MM_AtomicOperations::subtract(&_dequeCachedEntryCount, 1);
+			return cache;
+		}
+	}
+
 #if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
 	env->_scavengerStats._acquireScanListCount += 1;
 #endif /* J9MODRON_TGC_PARALLEL_STATISTICS */
 
  	while (!doneFlag && !shouldAbortScanLoop(env)) {
- 		while (_cachedEntryCount > 0) {
+ 		while (isScanCacheAvailable()) {
  			cache = getNextScanCacheFromList(env);
+			if ((NULL == cache) && (NULL != deque)) {
+				cache = stealScanCache(env, deque);
+			}
 
 			if (NULL != cache) {
  				/* Check if there are threads waiting that should be notified because of pending entries */
- 				if((_cachedEntryCount > 0) && _waitingCount) {
+ 				if(isScanCacheAvailable() && _waitingCount) {
 					if (0 == omrthread_monitor_try_enter(_scanCacheMonitor)) {
 						if(0 != _waitingCount) {
 							omrthread_monitor_notify(_scanCacheMonitor);
@@ -2371,7 +2487,7 @@ MM_Scavenger::getNextScanCache(MM_EnvironmentStandard *env)
 		_waitingCount += 1;
 
 		if(doneIndex == _doneIndex) {
-			if((env->_currentTask->getThreadCount() == _waitingCount) && (0 == _cachedEntryCount)) {
+			if((env->_currentTask->getThreadCount() == _waitingCount) && !isScanCacheAvailable()) {
 				flushBuffersForGetNextScanCache(env, true);
 
 				if (shouldDoFinalNotify(env)) {
@@ -2382,7 +2498,7 @@ MM_Scavenger::getNextScanCache(MM_EnvironmentStandard *env)
 					env->_scavengerStats.addToNotifyStallTime(notifyStartTime, omrtime_hires_clock());
 				}
 			} else {
-				while((0 == _cachedEntryCount) && (doneIndex == _doneIndex) && !shouldAbortScanLoop(env)) {
+				while(!isScanCacheAvailable() && (doneIndex == _doneIndex) && !shouldAbortScanLoop(env)) {
 					flushBuffersForGetNextScanCache(env);
 #if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
 					uint64_t waitEndTime, waitStartTime;
@@ -2904,11 +3020,181 @@ MM_Scavenger::flushRememberedSet(MM_EnvironmentStandard *env)
 void
 MM_Scavenger::pruneRememberedSet(MM_EnvironmentStandard *env)
 {
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+	uint64_t startTime = omrtime_hires_clock();
+
 	if(isRememberedSetInOverflowState()) {
 		pruneRememberedSetOverflow(env);
+	} else if ((NULL != _rememberedSetPruner) && _rememberedSetPruner->isStarted()
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+		/* The concurrent marker must hear of every pruned parent inside this pause, see pruneRememberedSetList() */
+		&& !_extensions->shouldScavengeNotifyGlobalGCOfOldToOldReference()
+#endif /* OMR_GC_MODRON_CONCURRENT_MARK */
+	) {
+		deferRememberedSetPrune(env);
 	} else {
 		pruneRememberedSetList(env);
 	}
+
+	/* Threads prune in parallel, so the main thread's time stands for the pause */
+	if (env->isMainThread()) {
+		env->_scavengerStats._rememberedSetPruneTime += omrtime_hires_clock() - startTime;
+	}
+}
+
+void
+MM_Scavenger::deferRememberedSetPrune(MM_EnvironmentStandard *env)
+{
+	/* Disconnect the local fragment so that nothing is appended to a puddle once the pruner owns it */
+	flushRememberedSet(env);
+	env->_scavengerRememberedSet.fragmentCurrent = NULL;
+	env->_scavengerRememberedSet.fragmentTop = NULL;
+
+	if (env->_currentTask->synchronizeGCThreadsAndReleaseMain(env, UNIQUE_ID)) {
+		/* Mutators will allocate fragments from fresh puddles while the detached ones are pruned */
+		_extensions->rememberedSet.startProcessingSublist();
+		/* The helper needs shared VM access, so it starts once this pause ends */
+		_rememberedSetPruner->resume(env);
+		env->_currentTask->releaseSynchronizedGCThreads(env);
+	}
+}
+
+bool
+MM_Scavenger::shouldRememberObjectConcurrently(MM_EnvironmentStandard *env, omrobjectptr_t objectPtr)
+{
+	Assert_MM_true((NULL != objectPtr) && _extensions->isOld(objectPtr));
+
+	GC_ObjectScannerState objectScannerState;
+	uintptr_t scannerFlags = GC_ObjectScanner::scanRoots | GC_ObjectScanner::indexableObjectNoSplit;
+	bool shouldRemember = false;
+
+	GC_ObjectScanner *objectScanner = getObjectScanner(env, objectPtr, &objectScannerState, scannerFlags, SCAN_REASON_SHOULDREMEMBER, &shouldRemember);
+	if (shouldRemember) {
+		return true;
+	}
+	if (NULL != objectScanner) {
+		GC_SlotObject *slotPtr;
+		while (NULL != (slotPtr = objectScanner->getNextSlot())) {
+			/* Same test as the generational write barrier, which is what re-remembers the object after we clear it */
+			omrobjectptr_t slotObjectPtr = slotPtr->readReferenceFromSlot();
+			if ((NULL != slotObjectPtr) && !_extensions->isOld(slotObjectPtr)) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+uintptr_t
+MM_Scavenger::prunePuddleConcurrently(MM_EnvironmentStandard *env, MM_SublistPuddle *puddle)
+{
+	uintptr_t prunedCount = 0;
+	omrobjectptr_t *slotPtr = NULL;
+
+	GC_SublistSlotIterator remSetSlotIterator(puddle);
+	while (NULL != (slotPtr = (omrobjectptr_t *)remSetSlotIterator.nextSlot())) {
+		omrobjectptr_t objectPtr = *slotPtr;
+
+		if (NULL == objectPtr) {
+			remSetSlotIterator.removeSlot();
+		} else if (0 != ((uintptr_t)objectPtr & DEFERRED_RS_REMOVE_FLAG)) {
+			objectPtr = (omrobjectptr_t)((uintptr_t)objectPtr & ~(uintptr_t)DEFERRED_RS_REMOVE_FLAG);
+
+			/* Indirect referents can not be checked outside of a scavenge - keep the object, the next scavenge will revisit it */
+			bool keep = _extensions->objectModel.hasIndirectObjectReferents((CLI_THREAD_TYPE*)env->getLanguageVMThread(), objectPtr);
+			if (!keep) {
+				/* A mutator which stored a nursery reference since the pause found the object remembered and did not record it.
+				 * Clear the remembered state first, so that any later store remembers the object again, then rescan for earlier stores.
+				 * As in pruneRememberedSetList(), the entry goes whatever remembered state the object is in; only this thread changes
+				 * the state of a remembered object between scavenges.
+				 */
+				uintptr_t rememberedState = _extensions->objectModel.getRememberedBits(objectPtr);
+				Assert_MM_true(STATE_REMEMBERED <= rememberedState);
+				_extensions->objectModel.atomicSwitchReferencedState(objectPtr, rememberedState, STATE_NOT_REMEMBERED);
+				/* Order the clear before the rescan. The write barrier fences its slot store before it reads the remembered state
+				 * (see standardWriteBarrier()), so either the rescan sees the store or the barrier sees the cleared state.
+				 */
+				MM_AtomicOperations::readWriteBarrier();
+				if (shouldRememberObjectConcurrently(env, objectPtr)) {
+					/* Remember it again. If a mutator beat us to it, the object already has a new entry and this one is redundant. */
+					keep = _extensions->objectModel.atomicSetRememberedState(objectPtr, STATE_REMEMBERED);
+				}
+			}
+
+			if (keep) {
+				*slotPtr = objectPtr;
+			} else {
+				remSetSlotIterator.removeSlot();
+				prunedCount += 1;
+			}
+		} else {
+			/* Age objects tenured from the stack, as processRememberedThreadReference() does in the pause */
+			switch (_extensions->objectModel.getRememberedBits(objectPtr)) {
+			case OMR_TENURED_STACK_OBJECT_CURRENTLY_REFERENCED:
+				_extensions->objectModel.atomicSwitchReferencedState(objectPtr, OMR_TENURED_STACK_OBJECT_CURRENTLY_REFERENCED, OMR_TENURED_STACK_OBJECT_RECENTLY_REFERENCED);
+				break;
+			case OMR_TENURED_STACK_OBJECT_RECENTLY_REFERENCED:
+				_extensions->objectModel.atomicSwitchReferencedState(objectPtr, OMR_TENURED_STACK_OBJECT_RECENTLY_REFERENCED, STATE_REMEMBERED);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	return prunedCount;
+}
+
+bool
+MM_Scavenger::pruneRememberedSetConcurrently(MM_EnvironmentStandard *env, uintptr_t *puddleCount, uintptr_t *prunedCount)
+{
+	MM_SublistPool *rememberedSet = &_extensions->rememberedSet;
+	MM_SublistPuddle *puddle = NULL;
+	bool complete = true;
+
+	while (NULL != (puddle = rememberedSet->popPreviousPuddle(puddle))) {
+		*prunedCount += prunePuddleConcurrently(env, puddle);
+		*puddleCount += 1;
+		if (env->isExclusiveAccessRequestWaiting()) {
+			/* Give the puddle back without claiming another; the pause drains the rest */
+			rememberedSet->returnPreviousPuddle(puddle);
+			complete = false;
+			break;
+		}
+	}
+
+	return complete;
+}
+
+void
+MM_Scavenger::sampleHotFieldDereference(MM_EnvironmentStandard *env, omrobjectptr_t objectPtr, fomrobject_t *slotPtr)
+{
+	if ((NULL != _hotFieldTable) && !_extensions->objectModel.isIndexable(objectPtr)) {
+		if (0 != env->_hotFieldSampleCountdown) {
+			env->_hotFieldSampleCountdown -= 1;
+		} else {
+			env->_hotFieldSampleCountdown = _extensions->scavengerHotFieldSampleInterval;
+			uintptr_t referenceSize = _extensions->compressObjectReferences() ? sizeof(uint32_t) : sizeof(uintptr_t);
+			uintptr_t offset = ((uintptr_t)slotPtr - (uintptr_t)objectPtr) / referenceSize;
+			_hotFieldTable->recordSample(_extensions->objectModel.getHotFieldClassKey(objectPtr), offset);
+		}
+	}
+}
+
+uintptr_t
+MM_Scavenger::completeConcurrentRememberedSetPrune(MM_EnvironmentStandard *env)
+{
+	uintptr_t prunedCount = 0;
+
+	if (NULL != _rememberedSetPruner) {
+		MM_SublistPuddle *puddle = NULL;
+		while (NULL != (puddle = _extensions->rememberedSet.popPreviousPuddle(puddle))) {
+			prunedCount += prunePuddleConcurrently(env, puddle);
+		}
+	}
+
+	return prunedCount;
 }
 
 void
@@ -3021,6 +3307,7 @@ MM_Scavenger::pruneRememberedSetList(MM_EnvironmentStandard *env)
 						/* A simple mask out can be used - we are guaranteed to be the only manipulator of the object */
 						_extensions->objectModel.clearRemembered(objectPtr);
 						remSetSlotIterator.removeSlot();
+						env->_scavengerStats._rememberedSetPrunedCount += 1;
 						/* Inform interested parties (Concurrent Marker) that an object has been removed from the remembered set.
 						 * In non-concurrent Scavenger this is the only way to create an old-to-old reference, that has parent object being marked.
 						 * In Concurrent Scavenger, it can be created even with parent object that was not in RS to start with. So this is handled
@@ -3615,7 +3902,19 @@ MM_Scavenger::returnEmptyCopyCachesToFreeList(MM_EnvironmentStandard *env)
 MMINLINE void
 MM_Scavenger::addCacheEntryToScanListAndNotify(MM_EnvironmentStandard *env, MM_CopyScanCacheStandard *newCacheEntry)
 {
-	_scavengeCacheScanList.pushCache(env, newCacheEntry);
+	MM_CopyScanCacheDeque *deque = getScanCacheDeque(env);
+	/* count the entry before it becomes visible, so a thief can never take the count below zero */
+	if (NULL != deque) {
+		MM_AtomicOperations::add(&_dequeCachedEntryCount, 1);
+		if (!deque->push(newCacheEntry)) {
+			MM_AtomicOperations::subtract(&_dequeCachedEntryCount, 1);
+			deque = NULL;
+		}
+	}
+	if (NULL == deque) {
+		/* no deque, or it is full - overflow to the shared scan list */
+		_scavengeCacheScanList.pushCache(env, newCacheEntry);
+	}
 	if (0 != _waitingCount) {
 		/* Added an entry to the list - notify any other threads that a new entry has appeared on the list */
 		if (0 == omrthread_monitor_try_enter(_scanCacheMonitor)) {
@@ -3697,6 +3996,46 @@ MM_Scavenger::getNextScanCacheFromList(MM_EnvironmentStandard *env)
 	return _scavengeCacheScanList.popCache(env);
 }
 
+MMINLINE MM_CopyScanCacheDeque *
+MM_Scavenger::getScanCacheDeque(MM_EnvironmentStandard *env)
+{
+	MM_CopyScanCacheDeque *deque = NULL;
+	if (NULL != _scanCacheDeques) {
+		ThreadType threadType = env->getThreadType();
+		if ((GC_MAIN_THREAD == threadType) || (GC_WORKER_THREAD == threadType)) {
+			uintptr_t workerID = env->getWorkerID();
+			/* the GC thread count may have grown since startup (e.g. on restore), such threads use the shared list */
+			if (workerID < _scanCacheDequeCount) {
+				deque = &_scanCacheDeques[workerID];
+			}
+		}
+	}
+	return deque;
+}
+
+MM_CopyScanCacheStandard *
+MM_Scavenger::stealScanCache(MM_EnvironmentStandard *env, MM_CopyScanCacheDeque *ownDeque)
+{
+	MM_CopyScanCacheStandard *cache = NULL;
+	uintptr_t victim = ownDeque->nextVictim(_scanCacheDequeCount);
+
+	for (uintptr_t i = 0; (i < _scanCacheDequeCount) && (0 != _dequeCachedEntryCount); i++) {
+		MM_CopyScanCacheDeque *victimDeque = &_scanCacheDeques[victim];
+		if ((victimDeque != ownDeque) && !victimDeque->isEmpty()) {
+			env->_scavengerStats._workStealAttemptCount += 1;
+			cache = victimDeque->steal();
+			if (NULL != cache) {
+				MM_AtomicOperations::subtract(&_dequeCachedEntryCount, 1);
+				env->_scavengerStats._workStealCount += 1;
+				break;
+			}
+		}
+		victim = (victim + 1) % _scanCacheDequeCount;
+	}
+
+	return cache;
+}
+
 /**
  * Determine whether a scavenge that has been started did complete successfully.
  * @return true if the scavenge completed successfully, false otherwise.
@@ -4116,8 +4455,16 @@ MM_Scavenger::completeBackOut(MM_EnvironmentStandard *env)
 			while (NULL != (cache = _scavengeCacheScanList.popCache(env))) {
 				flushCache(env, cache);
 			}
+			/* other GC threads are synchronized, so their deques can be drained from here */
+			for (uintptr_t i = 0; i < _scanCacheDequeCount; i++) {
+				while (NULL != (cache = _scanCacheDeques[i].steal())) {
+					MM_AtomicOperations::subtract(&_dequeCachedEntryCount, 1);
+					flushCache(env, cache);
+				}
+			}
 		}
 		Assert_MM_true(0 == _cachedEntryCount);
+		Assert_MM_true(0 == _dequeCachedEntryCount);
 
 		/* 2
 		 * a) Mark the overflow scan as invalid (backing out of objects moved into old space)
@@ -4859,6 +5206,9 @@ MM_Scavenger::percolateGarbageCollect(MM_EnvironmentBase *env,  MM_MemorySubSpac
 void
 MM_Scavenger::globalCollectionStart(MM_EnvironmentBase *env)
 {
+	/* The global collector walks the remembered set, so deferred entries must be resolved first */
+	completeConcurrentRememberedSetPrune(MM_EnvironmentStandard::getEnvironment(env));
+
 	/* Hold on to allocation stats that are useful but cleared on global collects. */
 	MM_ScavengerStats* scavengerStats = &_extensions->scavengerStats;
 	MM_HeapStats heapStatsSemiSpace;
@@ -34,6 +34,7 @@
 #include "CollectionStatisticsStandard.hpp"
 #include "Collector.hpp"
 #include "ConcurrentPhaseStatsBase.hpp"
+#include "CopyScanCacheDeque.hpp"
 #include "CopyScanCacheList.hpp"
 #include "CopyScanCacheStandard.hpp"
 #include "CycleState.hpp"
@@ -54,8 +55,11 @@ class MM_MemorySubSpace;
 class MM_MemorySubSpaceSemiSpace;
 class MM_ParallelDispatcher;
 class MM_PhysicalSubArena;
+class MM_RememberedSetPruner;
+class MM_ScavengerHotFieldTable;
 class MM_RSOverflow;
 class MM_SublistPool;
+class MM_SublistPuddle;
 
 struct OMR_VM;
 
@@ -117,6 +121,11 @@ private:
 	MM_CopyScanCacheList _scavengeCacheFreeList; /**< pool of unused copy-scan caches */
 	MM_CopyScanCacheList _scavengeCacheScanList; /**< scan lists */
 	volatile uintptr_t _cachedEntryCount; /**< non-empty scanCacheList count (not the total count of caches in the lists) */
+	MM_CopyScanCacheDeque *_scanCacheDeques; /**< per-GC-thread work-stealing deques of scan caches, indexed by worker ID (NULL unless scavengerWorkStealing is enabled) */
+	uintptr_t _scanCacheDequeCount; /**< number of entries in _scanCacheDeques */
+	MM_RememberedSetPruner *_rememberedSetPruner; /**< background helper pruning the remembered set between scavenges (NULL unless scavengerConcurrentRememberedSetPrune is enabled and the helper started) */
+	MM_ScavengerHotFieldTable *_hotFieldTable; /**< hot fields learned from sampled mutator dereferences (NULL unless scavengerLearnHotFields is enabled) */
+	volatile uintptr_t _dequeCachedEntryCount; /**< total number of caches held in _scanCacheDeques */
 	uintptr_t _cachesPerThread; /**< maximum number of copy and scan caches required per thread at any one time */
 	omrthread_monitor_t _scanCacheMonitor; /**< monitor to synchronize threads on scan lists */
 	omrthread_monitor_t _freeCacheMonitor; /**< monitor to synchronize threads on free list */
@@ -363,6 +372,33 @@ public:
 	void pruneRememberedSetList(MM_EnvironmentStandard *env);
 	void pruneRememberedSetOverflow(MM_EnvironmentStandard *env);
 
+	/**
+	 * Hand the remembered set over to the background pruner instead of pruning it inside the pause.
+	 * All puddles are detached from the pool; entries flagged for deferred removal stay in place.
+	 * @param env Standard Environment
+	 */
+	void deferRememberedSetPrune(MM_EnvironmentStandard *env);
+
+	/**
+	 * Prune one detached remembered set puddle, removing NULL entries and entries flagged for deferred removal,
+	 * and aging the remembered state of objects tenured from the stack.
+	 * Safe to run concurrently with mutators: an entry is only dropped once the remembered state of its object
+	 * has been cleared atomically and a rescan (which follows the clear and a full fence) finds no nursery references.
+	 * @param env Standard Environment
+	 * @param puddle a puddle owned by the caller (obtained from MM_SublistPool::popPreviousPuddle())
+	 * @return the number of flagged entries removed
+	 */
+	uintptr_t prunePuddleConcurrently(MM_EnvironmentStandard *env, MM_SublistPuddle *puddle);
+
+	/**
+	 * Checks if an object has references to new space, using heap ranges rather than the cached survivor
+	 * range so the result remains valid between scavenges.
+	 * @param env Standard Environment
+	 * @param objectPtr The pointer to the Object in Tenured Space.
+	 * @return True If Object should be remembered
+	 */
+	bool shouldRememberObjectConcurrently(MM_EnvironmentStandard *env, omrobjectptr_t objectPtr);
+
 	/**
 	 * Checks if the  Object should be remembered or not
 	 * @param env Standard Environment
@@ -437,6 +473,42 @@ public:
 	MMINLINE uintptr_t copyCacheDistanceMetric(MM_CopyScanCacheStandard* cache);
 
 	MMINLINE MM_CopyScanCacheStandard *getNextScanCacheFromList(MM_EnvironmentStandard *env);
+
+	/**
+	 * Return the work-stealing deque owned by the given thread, if it may use one.
+	 * Only GC threads own deques; mutator threads (and GC threads acting on behalf of a mutator) use the shared scan list.
+	 * @param env[in] the thread that will push to / pop from the deque
+	 * @return the deque, or NULL if the thread must use the shared scan list
+	 */
+	MMINLINE MM_CopyScanCacheDeque *getScanCacheDeque(MM_EnvironmentStandard *env);
+
+	/**
+	 * Take a scan cache from another GC thread's deque. Victims are visited starting at a random index
+	 * and then round robin, so that any cache present in some deque for the duration of the call is found.
+	 * @param env[in] the stealing GC thread
+	 * @param ownDeque[in] the deque owned by the stealing thread
+	 * @return the stolen cache, or NULL if none could be taken
+	 */
+	MM_CopyScanCacheStandard *stealScanCache(MM_EnvironmentStandard *env, MM_CopyScanCacheDeque *ownDeque);
+
+	/**
+	 * @return true if there are caches in the shared scan lists or in any of the work-stealing deques
+	 */
+	MMINLINE bool
+	isScanCacheAvailable()
+	{
+		return (0 != _cachedEntryCount) || (0 != _dequeCachedEntryCount);
+	}
+
+	/**
+	 * @return approximate number of caches waiting to be scanned, in the shared scan lists and in the work-stealing deques
+	 */
+	MMINLINE uintptr_t
+	getApproximateScanCacheCount()
+	{
+		return _scavengeCacheScanList.getApproximateEntryCount() + _dequeCachedEntryCount;
+	}
+
 	/**
 	 * Called at the end of a task to return empty caches to the global free pool
 	 */
@@ -861,6 +933,35 @@ public:
 
 	void pruneRememberedSet(MM_EnvironmentStandard *env);
 
+	/**
+	 * Prune detached remembered set puddles from the background pruner thread, which holds shared VM access.
+	 * Stops between puddles as soon as exclusive access is requested.
+	 * @param env environment of the pruner thread
+	 * @param[out] puddleCount the number of puddles processed
+	 * @param[out] prunedCount the number of entries removed
+	 * @return true if no detached puddles remain, false if the pass yielded to exclusive access
+	 */
+	bool pruneRememberedSetConcurrently(MM_EnvironmentStandard *env, uintptr_t *puddleCount, uintptr_t *prunedCount);
+
+	/**
+	 * Finish any remembered set pruning left by the background pruner. Must be called with exclusive access
+	 * held before anything walks the remembered set, since deferred entries are still flagged and detached
+	 * puddles are invisible to GC_SublistIterator.
+	 * @param env Standard Environment
+	 * @return the number of entries removed
+	 */
+	uintptr_t completeConcurrentRememberedSetPrune(MM_EnvironmentStandard *env);
+
+	/**
+	 * Report a mutator dereference of an object slot to the learned hot field table.
+	 * Each thread records one report in every scavengerHotFieldSampleInterval + 1 and ignores the others.
+	 * Reports on indexable objects are ignored: array elements are not fields of a class.
+	 * @param env the mutator environment
+	 * @param objectPtr the object holding the slot
+	 * @param slotPtr the dereferenced reference slot
+	 */
+	void sampleHotFieldDereference(MM_EnvironmentStandard *env, omrobjectptr_t objectPtr, fomrobject_t *slotPtr);
+
 	virtual uintptr_t getVMStateID();
 
 	bool completeScan(MM_EnvironmentStandard *env);
@@ -964,6 +1065,11 @@ public:
 		, _cycleState()
 		, _collectionStatistics()
 		, _cachedEntryCount(0)
+		, _scanCacheDeques(NULL)
+		, _scanCacheDequeCount(0)
+		, _rememberedSetPruner(NULL)
+		, _hotFieldTable(NULL)
+		, _dequeCachedEntryCount(0)
 		, _cachesPerThread(0)
 		, _scanCacheMonitor(NULL)
 		, _freeCacheMonitor(NULL)
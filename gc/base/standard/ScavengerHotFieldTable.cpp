@@ -0,0 +1,198 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include "ScavengerHotFieldTable.hpp"
+
+#include "AtomicOperations.hpp"
+#include "EnvironmentBase.hpp"
+#include "Forge.hpp"
+
+MM_ScavengerHotFieldTable *
+MM_ScavengerHotFieldTable::newInstance(MM_EnvironmentBase *env, uintptr_t tableSize)
+{
+	MM_ScavengerHotFieldTable *hotFieldTable = (MM_ScavengerHotFieldTable *)env->getForge()->allocate(sizeof(MM_ScavengerHotFieldTable), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != hotFieldTable) {
+		new(hotFieldTable) MM_ScavengerHotFieldTable();
+		if (!hotFieldTable->initialize(env, tableSize)) {
+			hotFieldTable->kill(env);
+			hotFieldTable = NULL;
+		}
+	}
+	return hotFieldTable;
+}
+
+void
+MM_ScavengerHotFieldTable::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+bool
+MM_ScavengerHotFieldTable::initialize(MM_EnvironmentBase *env, uintptr_t tableSize)
+{
+	uintptr_t roundedSize = 1;
+	while (roundedSize < tableSize) {
+		roundedSize <<= 1;
+	}
+
+	_entries = (Entry *)env->getForge()->allocate(sizeof(Entry) * roundedSize, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL == _entries) {
+		return false;
+	}
+	_entryMask = roundedSize - 1;
+
+	for (uintptr_t i = 0; i < roundedSize; i++) {
+		Entry *entry = &_entries[i];
+		entry->classKey = 0;
+		for (uintptr_t j = 0; j < HOT_FIELD_COUNT; j++) {
+			entry->hotFieldOffsets[j] = U_8_MAX;
+		}
+		for (uintptr_t j = 0; j < CANDIDATE_COUNT; j++) {
+			entry->candidateOffsets[j] = U_8_MAX;
+			entry->candidateCounts[j] = 0;
+		}
+	}
+
+	return true;
+}
+
+void
+MM_ScavengerHotFieldTable::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _entries) {
+		env->getForge()->free(_entries);
+		_entries = NULL;
+	}
+}
+
+MM_ScavengerHotFieldTable::Entry *
+MM_ScavengerHotFieldTable::findEntry(uintptr_t classKey, bool claim)
+{
+	uintptr_t index = hashClassKey(classKey);
+	for (uintptr_t probe = 0; probe < MAX_PROBES; probe++) {
+		Entry *entry = &_entries[(index + probe) & _entryMask];
+		uintptr_t entryKey = entry->classKey;
+		if (0 == entryKey) {
+			if (!claim) {
+				break;
+			}
+			entryKey = MM_AtomicOperations::lockCompareExchange(&entry->classKey, 0, classKey);
+			if (0 == entryKey) {
+				return entry;
+			}
+		}
+		if (classKey == entryKey) {
+			return entry;
+		}
+	}
+	return NULL;
+}
+
+void
+MM_ScavengerHotFieldTable::recordSample(uintptr_t classKey, uintptr_t offset)
+{
+	if ((0 == classKey) || (offset >= U_8_MAX)) {
+		return;
+	}
+
+	Entry *entry = findEntry(classKey, true);
+	if (NULL == entry) {
+		_droppedSamples += 1;
+		return;
+	}
+
+	/* Heavy hitters count: bump a tracked slot, track a new one in a free candidate, or age every candidate */
+	uintptr_t freeCandidate = CANDIDATE_COUNT;
+	for (uintptr_t i = 0; i < CANDIDATE_COUNT; i++) {
+		if (0 == entry->candidateCounts[i]) {
+			freeCandidate = i;
+		} else if (offset == entry->candidateOffsets[i]) {
+			entry->candidateCounts[i] += 1;
+			return;
+		}
+	}
+	if (CANDIDATE_COUNT != freeCandidate) {
+		entry->candidateOffsets[freeCandidate] = (uint8_t)offset;
+		entry->candidateCounts[freeCandidate] = 1;
+	} else {
+		for (uintptr_t i = 0; i < CANDIDATE_COUNT; i++) {
+			/* A racing sample may have aged the candidate to 0 since it was read above; never let the count wrap */
+			uint32_t count = entry->candidateCounts[i];
+			if (0 != count) {
+				entry->candidateCounts[i] = count - 1;
+			}
+		}
+	}
+}
+
+uintptr_t
+MM_ScavengerHotFieldTable::publish(MM_EnvironmentBase *env)
+{
+	uintptr_t classesWithHotFields = 0;
+
+	for (uintptr_t i = 0; i <= _entryMask; i++) {
+		Entry *entry = &_entries[i];
+		if (0 == entry->classKey) {
+			continue;
+		}
+
+		/* Select the hottest candidates in order; a candidate is only published once */
+		uint32_t published = 0;
+		for (uintptr_t rank = 0; rank < HOT_FIELD_COUNT; rank++) {
+			uintptr_t hottest = CANDIDATE_COUNT;
+			for (uintptr_t j = 0; j < CANDIDATE_COUNT; j++) {
+				if ((0 != entry->candidateCounts[j]) && (0 == (published & (1 << j)))) {
+					if ((CANDIDATE_COUNT == hottest) || (entry->candidateCounts[j] > entry->candidateCounts[hottest])) {
+						hottest = j;
+					}
+				}
+			}
+			if (CANDIDATE_COUNT == hottest) {
+				entry->hotFieldOffsets[rank] = U_8_MAX;
+			} else {
+				entry->hotFieldOffsets[rank] = entry->candidateOffsets[hottest];
+				published |= 1 << hottest;
+			}
+		}
+		if (U_8_MAX != entry->hotFieldOffsets[0]) {
+			classesWithHotFields += 1;
+		}
+
+		for (uintptr_t j = 0; j < CANDIDATE_COUNT; j++) {
+			entry->candidateCounts[j] >>= 1;
+		}
+	}
+
+	return classesWithHotFields;
+}
+
+#endif /* OMR_GC_MODRON_SCAVENGER */
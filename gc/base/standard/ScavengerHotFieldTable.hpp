@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#if !defined(SCAVENGERHOTFIELDTABLE_HPP_)
+#define SCAVENGERHOTFIELDTABLE_HPP_
+
+#include "omrcfg.h"
+#include "modronbase.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include "BaseNonVirtual.hpp"
+
+class MM_EnvironmentBase;
+
+/**
+ * Hot fields learned at runtime from sampled mutator dereferences.
+ *
+ * Entries are keyed by the class key supplied by the object model (see GC_ObjectModel::getHotFieldClassKey()) and live
+ * in a fixed size, open addressed table. Each entry tracks a handful of candidate slots with a heavy hitters count and
+ * publishes the hottest ones at the start of every scavenge, when the copy path reads them through getHotFieldOffsets().
+ * Samples are recorded without locking; a racing update can only skew the counts, which the next publish tolerates.
+ * @ingroup GC_Modron_Standard
+ */
+class MM_ScavengerHotFieldTable : public MM_BaseNonVirtual
+{
+	/*
+	 * Data members
+	 */
+public:
+	enum {
+		HOT_FIELD_COUNT = 3, /**< hot fields published per class, matching the static hot field offsets of the object model */
+		CANDIDATE_COUNT = 4, /**< slots tracked per class while sampling */
+		MAX_PROBES = 8 /**< table slots searched for a class before a sample is dropped */
+	};
+
+private:
+	struct Entry {
+		volatile uintptr_t classKey; /**< 0 if the entry is unused */
+		uint8_t hotFieldOffsets[HOT_FIELD_COUNT]; /**< published slot offsets, hottest first, U_8_MAX terminated */
+		uint8_t candidateOffsets[CANDIDATE_COUNT];
+		uint32_t candidateCounts[CANDIDATE_COUNT];
+	};
+
+	Entry *_entries;
+	uintptr_t _entryMask; /**< table size - 1, the table size being a power of 2 */
+	uintptr_t _droppedSamples; /**< samples lost because the table was full (racy, statistics only) */
+
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+private:
+	MMINLINE uintptr_t hashClassKey(uintptr_t classKey) const
+	{
+		return (uintptr_t)(((uint64_t)classKey * (uint64_t)0x9E3779B97F4A7C15ULL) >> 32) & _entryMask;
+	}
+
+	/**
+	 * Find the entry for a class, optionally claiming an unused one.
+	 * @return the entry or NULL if none was found (or could be claimed) within MAX_PROBES
+	 */
+	Entry *findEntry(uintptr_t classKey, bool claim);
+
+protected:
+	bool initialize(MM_EnvironmentBase *env, uintptr_t tableSize);
+	void tearDown(MM_EnvironmentBase *env);
+
+public:
+	/**
+	 * @param tableSize number of classes that can be tracked, rounded up to a power of 2
+	 */
+	static MM_ScavengerHotFieldTable *newInstance(MM_EnvironmentBase *env, uintptr_t tableSize);
+	void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Record that a mutator dereferenced the given slot of an instance of the class.
+	 * @param classKey class key of the object, 0 if the object model can not name its class
+	 * @param offset slot offset of the field from the start of the object, in references
+	 */
+	void recordSample(uintptr_t classKey, uintptr_t offset);
+
+	/**
+	 * Publish the hottest candidates of every class for the copy path and decay the counts so that the table follows
+	 * phase changes. Must be called while mutators are stopped.
+	 * @return the number of classes with at least one published hot field
+	 */
+	uintptr_t publish(MM_EnvironmentBase *env);
+
+	/**
+	 * @return the published hot field offsets of the class (U_8_MAX terminated, at most HOT_FIELD_COUNT), or NULL if none were learned
+	 */
+	MMINLINE const uint8_t *getHotFieldOffsets(uintptr_t classKey)
+	{
+		if (0 != classKey) {
+			uintptr_t index = hashClassKey(classKey);
+			for (uintptr_t probe = 0; probe < MAX_PROBES; probe++) {
+				Entry *entry = &_entries[(index + probe) & _entryMask];
+				if (classKey == entry->classKey) {
+					return (U_8_MAX == entry->hotFieldOffsets[0]) ? NULL : entry->hotFieldOffsets;
+				} else if (0 == entry->classKey) {
+					break;
+				}
+			}
+		}
+		return NULL;
+	}
+
+	MMINLINE uintptr_t getDroppedSamples() const { return _droppedSamples; }
+
+	MM_ScavengerHotFieldTable()
+		: MM_BaseNonVirtual()
+		, _entries(NULL)
+		, _entryMask(0)
+		, _droppedSamples(0)
+	{
+		_typeId = __FUNCTION__;
+	}
+};
+
+#endif /* OMR_GC_MODRON_SCAVENGER */
+#endif /* SCAVENGERHOTFIELDTABLE_HPP_ */
@@ -25,6 +25,7 @@
 
 #include "objectdescription.h"
 
+#include "AtomicOperations.hpp"
 #include "CardTable.hpp"
 #include "Configuration.hpp"
 #include "EnvironmentStandard.hpp"
@@ -55,6 +56,10 @@ standardWriteBarrier(OMR_VMThread *omrThread, omrobjectptr_t parentObject, omrob
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	if (extensions->scavengerEnabled) {
 		if (extensions->isOld(parentObject) && !extensions->isOld(childObject)) {
+			if (extensions->scavengerConcurrentRememberedSetPrune) {
+				/* The background pruner clears the remembered state and then rescans the object, so the store must be visible before the state is read */
+				MM_AtomicOperations::readWriteBarrier();
+			}
 			if (extensions->objectModel.atomicSetRememberedState(parentObject, STATE_REMEMBERED)) {
 				/* The object has been successfully marked as REMEMBERED - allocate an entry in the remembered set */
 				extensions->scavenger->addToRememberedSetFragment((MM_EnvironmentStandard *)env, parentObject);
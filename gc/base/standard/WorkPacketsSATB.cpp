@@ -26,8 +26,12 @@
 
 #include "WorkPacketsSATB.hpp"
 
+#include "ModronAssertions.h"
+
+#include "AtomicOperations.hpp"
 #include "Debug.hpp"
 #include "GCExtensionsBase.hpp"
+#include "OMRVMThreadListIterator.hpp"
 #include "OverflowStandard.hpp"
 
 /**
@@ -67,6 +71,11 @@ MM_WorkPacketsSATB::initialize(MM_EnvironmentBase *env)
 		return false;
 	}
 
+	/* The locked, doubly linked in use list is a point of contention on the barrier path, so in use
+	 * packets may instead be held by the thread filling them and only published once full.
+	 */
+	_threadOwnedBarrierPackets = _extensions->sATBBarrierPacketsThreadOwned;
+
 	return true;
 }
 
@@ -164,19 +173,54 @@ MM_WorkPacketsSATB::getPacketByOverflowing(MM_EnvironmentBase *env)
 }
 
 /**
- * Put the packet on the inUseBarrierPacket list.
+ * Put the packet on the inUseBarrierPacket list, or hand it to the filling thread if
+ * barrier packets are thread owned.
  * @param packet the packet to put on the list
  */
 void
 MM_WorkPacketsSATB::putInUsePacket(MM_EnvironmentBase *env, MM_Packet *packet)
 {
-	_inUseBarrierPacketList.push(env, packet);
+	if (_threadOwnedBarrierPackets) {
+		/* Never drop a packet the thread still owned; make it available for processing */
+		publishThreadOwnedPacket(env);
+		env->_satbBarrierPacket = packet;
+		env->_satbBarrierPacketOwner = this;
+		MM_AtomicOperations::add(&_barrierPacketsInUse, 1);
+	} else {
+		_inUseBarrierPacketList.push(env, packet);
+	}
 }
 
 void
 MM_WorkPacketsSATB::removePacketFromInUseList(MM_EnvironmentBase *env, MM_Packet *packet)
 {
-	_inUseBarrierPacketList.remove(packet);
+	if (_threadOwnedBarrierPackets) {
+		Assert_MM_true(packet == env->_satbBarrierPacket);
+		takeThreadOwnedPacket(env);
+	} else {
+		_inUseBarrierPacketList.remove(packet);
+	}
+}
+
+MM_Packet *
+MM_WorkPacketsSATB::takeThreadOwnedPacket(MM_EnvironmentBase *walkEnv)
+{
+	MM_Packet *packet = walkEnv->_satbBarrierPacket;
+	if (NULL != packet) {
+		walkEnv->_satbBarrierPacket = NULL;
+		walkEnv->_satbBarrierPacketOwner = NULL;
+		MM_AtomicOperations::subtract(&_barrierPacketsInUse, 1);
+	}
+	return packet;
+}
+
+void
+MM_WorkPacketsSATB::publishThreadOwnedPacket(MM_EnvironmentBase *ownerEnv)
+{
+	MM_Packet *packet = takeThreadOwnedPacket(ownerEnv);
+	if (NULL != packet) {
+		_nonEmptyPacketList.push(ownerEnv, packet);
+	}
 }
 
 void
@@ -196,6 +240,15 @@ MM_WorkPacketsSATB::moveInUseToNonEmpty(MM_EnvironmentBase *env)
 	UDATA count;
 	bool didPop;
 
+	if (_threadOwnedBarrierPackets) {
+		GC_OMRVMThreadListIterator vmThreadListIterator(env->getOmrVMThread());
+		OMR_VMThread *walkThread = NULL;
+		while (NULL != (walkThread = vmThreadListIterator.nextOMRVMThread())) {
+			publishThreadOwnedPacket(MM_EnvironmentBase::getEnvironment(walkThread));
+		}
+		return;
+	}
+
 	/* pop the inUseList */
 	didPop = _inUseBarrierPacketList.popList(&head, &tail, &count);
 	/* push the values from the inUseList onto the processingList */
@@ -253,6 +306,17 @@ MM_WorkPacketsSATB::resetAllPackets(MM_EnvironmentBase *env)
 {
 	MM_Packet *packet;
 
+	if (_threadOwnedBarrierPackets) {
+		GC_OMRVMThreadListIterator vmThreadListIterator(env->getOmrVMThread());
+		OMR_VMThread *walkThread = NULL;
+		while (NULL != (walkThread = vmThreadListIterator.nextOMRVMThread())) {
+			if (NULL != (packet = takeThreadOwnedPacket(MM_EnvironmentBase::getEnvironment(walkThread)))) {
+				packet->resetData(env);
+				putPacket(env, packet);
+			}
+		}
+	}
+
 	while (NULL != (packet = getPacket(env, &_inUseBarrierPacketList))) {
 		packet->resetData(env);
 		putPacket(env, packet);
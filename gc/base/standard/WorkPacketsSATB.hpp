@@ -35,6 +35,8 @@ class MM_WorkPacketsSATB : public MM_WorkPackets
 {
 protected:
 	MM_PacketList _inUseBarrierPacketList;  /**< List for packets currently being used for the remembered set*/
+	volatile uintptr_t _barrierPacketsInUse; /**< Count of packets privately owned by filling threads (only used when sATBBarrierPacketsThreadOwned is set) */
+	bool _threadOwnedBarrierPackets; /**< If true, in use barrier packets are held by their filling thread rather than on _inUseBarrierPacketList */
 
 public:
 	static MM_WorkPacketsSATB *newInstance(MM_EnvironmentBase *env);
@@ -49,17 +51,20 @@ public:
 
 	MMINLINE bool effectiveTraceExhausted()
 	{
-		return ((_emptyPacketList.getCount() + _inUseBarrierPacketList.getCount()) == _activePackets);
+		return ((_emptyPacketList.getCount() + getBarrierPacketCount()) == _activePackets);
 	}
 
 	MMINLINE uintptr_t getBarrierPacketCount()
 	{
+		if (_threadOwnedBarrierPackets) {
+			return _barrierPacketsInUse;
+		}
 		return (_inUseBarrierPacketList.getCount());
 	}
 
 	MMINLINE bool inUsePacketsAvailable(MM_EnvironmentBase *env)
 	{
-		return (!_inUseBarrierPacketList.isEmpty());
+		return (0 != getBarrierPacketCount());
 	}
 
 	virtual MM_Packet *getBarrierPacket(MM_EnvironmentBase *env);
@@ -67,6 +72,17 @@ public:
 	virtual void removePacketFromInUseList(MM_EnvironmentBase *env, MM_Packet *packet);
 	virtual void putFullPacket(MM_EnvironmentBase *env, MM_Packet *packet);
 
+	/**
+	 * Make the barrier packet privately owned by a thread available for processing. Must be called
+	 * when the owning thread detaches, or with exclusive access, so that the packet is no longer filled.
+	 * @param ownerEnv environment of the thread owning the packet
+	 */
+	void publishThreadOwnedPacket(MM_EnvironmentBase *ownerEnv);
+
+	/**
+	 * Make every in use barrier packet available for processing. When barrier packets are owned by
+	 * their filling threads, all threads are walked, so this must be called with exclusive access.
+	 */
 	void moveInUseToNonEmpty(MM_EnvironmentBase *env);
 
 	void resetAllPackets(MM_EnvironmentBase *env);
@@ -87,6 +103,8 @@ public:
 	MM_WorkPacketsSATB(MM_EnvironmentBase *env) :
 		MM_WorkPackets(env)
 		, _inUseBarrierPacketList(NULL)
+		, _barrierPacketsInUse(0)
+		, _threadOwnedBarrierPackets(false)
 	{
 		_typeId = __FUNCTION__;
 	};
@@ -98,6 +116,11 @@ protected:
 	virtual MM_Packet *getInputPacketFromOverflow(MM_EnvironmentBase *env);
 
 private:
+	/**
+	 * Detach the barrier packet privately owned by the given thread.
+	 * @return the packet, or NULL if the thread did not own one
+	 */
+	MM_Packet *takeThreadOwnedPacket(MM_EnvironmentBase *walkEnv);
 };
 #endif /* OMR_GC_REALTIME */
 #endif /* WORKPACKETSSATB_HPP_ */
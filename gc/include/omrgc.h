@@ -42,6 +42,9 @@ omrobjectptr_t OMR_GC_AllocateObject(OMR_VMThread * omrVMThread, uintptr_t alloc
 
 omr_error_t OMR_GC_SystemCollect(OMR_VMThread* omrVMThread, uint32_t gcCode);
 
+/* Report a mutator dereference of a reference slot; sampled to learn hot fields when scavengerLearnHotFields is enabled */
+void OMR_GC_SampleHotFieldDereference(OMR_VMThread *omrVMThread, omrobjectptr_t objectPtr, fomrobject_t *slotPtr);
+
 #ifdef __cplusplus
 } /* extern "C" { */
 #endif
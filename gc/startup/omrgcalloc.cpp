@@ -28,6 +28,10 @@
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
 #include "Heap.hpp"
+#if defined(OMR_GC_MODRON_SCAVENGER)
+#include "EnvironmentStandard.hpp"
+#include "Scavenger.hpp"
+#endif /* OMR_GC_MODRON_SCAVENGER */
 #include "omrgcstartup.hpp"
 #include "ModronAssertions.h"
 
@@ -60,3 +64,15 @@ OMR_GC_SystemCollect(OMR_VMThread* omrVMThread, uint32_t gcCode)
 	}
 	return result;
 }
+
+void
+OMR_GC_SampleHotFieldDereference(OMR_VMThread *omrVMThread, omrobjectptr_t objectPtr, fomrobject_t *slotPtr)
+{
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	MM_EnvironmentStandard *env = MM_EnvironmentStandard::getEnvironment(omrVMThread);
+	MM_Scavenger *scavenger = env->getExtensions()->scavenger;
+	if (NULL != scavenger) {
+		scavenger->sampleHotFieldDereference(env, objectPtr, slotPtr);
+	}
+#endif /* OMR_GC_MODRON_SCAVENGER */
+}
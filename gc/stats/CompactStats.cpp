@@ -48,6 +48,11 @@ MM_CompactStats::clear()
 	_fixupEndTime = 0;
 	_rootFixupStartTime = 0;
 	_rootFixupEndTime = 0;
+
+	_incrementSubAreas = 0;
+	_incrementFreeBytes = 0;
+	_incrementBase = NULL;
+	_incrementTop = NULL;
 };
 
 void
@@ -65,6 +70,13 @@ MM_CompactStats::merge(MM_CompactStats *statsToMerge)
 	_fixupEndTime = OMR_MAX(_fixupEndTime, statsToMerge->_fixupEndTime);
 	_rootFixupStartTime = (0 == _rootFixupStartTime) ? statsToMerge->_rootFixupStartTime : OMR_MIN(_rootFixupStartTime, statsToMerge->_rootFixupStartTime);
 	_rootFixupEndTime = OMR_MAX(_rootFixupEndTime, statsToMerge->_rootFixupEndTime);
+	/* the increment window is selected by a single thread, so only one set of stats carries it */
+	if (0 != statsToMerge->_incrementSubAreas) {
+		_incrementSubAreas = statsToMerge->_incrementSubAreas;
+		_incrementFreeBytes = statsToMerge->_incrementFreeBytes;
+		_incrementBase = statsToMerge->_incrementBase;
+		_incrementTop = statsToMerge->_incrementTop;
+	}
 };
 
 #endif /* OMR_GC_MODRON_COMPACTION */
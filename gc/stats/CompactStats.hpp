@@ -58,6 +58,11 @@ public:
 	uint64_t _fixupEndTime;
 	uint64_t _rootFixupStartTime;
 	uint64_t _rootFixupEndTime;
+
+	uintptr_t _incrementSubAreas; /**< Number of sub areas evacuated by an incremental compaction (0 if the whole heap was compacted) */
+	uintptr_t _incrementFreeBytes; /**< Free bytes found in the evacuated window before compaction */
+	void *_incrementBase; /**< Lowest address of the evacuated window */
+	void *_incrementTop; /**< Highest address (exclusive) of the evacuated window */
 		
 	/* Remember gc count on last compaction of heap */
 	uintptr_t _lastHeapCompaction;
@@ -63,6 +63,13 @@ private:
 
 	MM_LightweightNonReentrantLock _lock;  /**< lock used during merge of thread local stats */
 	bool guarantyEnoughPoolSizeForVeryLargeEntry; /**< true for all memory pool, false for thread base */
+
+	/* Lookups in a memory pool's size class index (see GCExtensionsBase::freeListSizeClassIndex).
+	 * Owned by the pool; neither merged nor cleared together with the size class counts.
+	 */
+	uintptr_t _indexHitCount; /**< lookups satisfied from a size class bin */
+	uintptr_t _indexMissCount; /**< lookups for which no bin held a large enough entry */
+	uintptr_t _indexScanCount; /**< entries examined while searching the requested size class itself */
 private:
 	/**
 	 * Take a snapshot of this structure stats. 
@@ -88,6 +95,30 @@ public:
 	uintptr_t getPageAlignedFreeMemory(const uintptr_t sizeClassSizes[], uintptr_t pageSize);
 
 	uintptr_t getMaxSizeClasses() { return _maxSizeClasses; }
+
+	/**
+	 * Record the outcome of a size class index lookup.
+	 * @param[in] hit true if the lookup found a large enough free entry
+	 * @param[in] scanCount number of entries of the requested size class examined during the lookup
+	 */
+	MMINLINE void recordIndexLookup(bool hit, uintptr_t scanCount)
+	{
+		if (hit) {
+			_indexHitCount += 1;
+		} else {
+			_indexMissCount += 1;
+		}
+		_indexScanCount += scanCount;
+	}
+	uintptr_t getIndexHitCount() { return _indexHitCount; }
+	uintptr_t getIndexMissCount() { return _indexMissCount; }
+	uintptr_t getIndexScanCount() { return _indexScanCount; }
+	void resetIndexCounts()
+	{
+		_indexHitCount = 0;
+		_indexMissCount = 0;
+		_indexScanCount = 0;
+	}
 	/**< @param factorVeryLargeEntryPool : multiple factor for _maxVeryLargeEntrySizes, default = 1, double for splitFreeList case 
 	 *   @param simulation : if true, generate _fractionFrequentAllocation array for cumulating fraction of frequentAllocation during estimating fragmentation, default = false
 	 */
@@ -138,7 +169,10 @@ public:
 		_maxFrequentAllocateSizes(0),
 		_maxVeryLargeEntrySizes(0),
 		_veryLargeEntrySizeClass(0),
-		_frequentAllocateSizeCounters(0)
+		_frequentAllocateSizeCounters(0),
+		_indexHitCount(0),
+		_indexMissCount(0),
+		_indexScanCount(0)
 	{
 	}
 };
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Stats
+ */
+
+#if !defined(HEAPUNCOMMITSTATS_HPP_)
+#define HEAPUNCOMMITSTATS_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+
+#include "Base.hpp"
+
+/**
+ * Statistics for the heap uncommit service.
+ * The pass fields describe the most recent uncommit pass, the refault fields cover the time since the previous pass
+ * was reported, and the totals accumulate for the life of the heap.
+ */
+class MM_HeapUncommitStats : public MM_Base
+{
+private:
+protected:
+public:
+	uintptr_t _passCount; /**< Number of uncommit passes run */
+
+	/**
+	 * Last pass statistics.
+	 * @{
+	 */
+	uintptr_t _releasedBytes; /**< Bytes decommitted by the pass */
+	uintptr_t _untrackedBytes; /**< Bytes decommitted by the pass which did not fit in the released range table */
+	uintptr_t _batchCount; /**< Number of times the pass took a free list lock */
+	bool _yielded; /**< True if the pass stopped early for an exclusive access request */
+	uint64_t _time; /**< Hi-res ticks spent in the pass */
+	uint64_t _rssBefore; /**< Resident set size of the process before the pass, 0 if not available */
+	uint64_t _rssAfter; /**< Resident set size of the process after the pass, 0 if not available */
+	/**
+	 * @}
+	 */
+
+	uintptr_t _refaultedBytes; /**< Released bytes the heap allocated from (and so faulted back in) since the last report */
+	uintptr_t _trackedBytes; /**< Released bytes still free in the heap after the pass */
+
+	/**
+	 * Cumulative statistics.
+	 * @{
+	 */
+	uintptr_t _totalReleasedBytes; /**< Bytes decommitted by all passes */
+	uintptr_t _totalRefaultedBytes; /**< Released bytes faulted back in over all passes */
+	/**
+	 * @}
+	 */
+
+	/**
+	 * Reset the statistics of a single pass before it starts.
+	 */
+	MMINLINE void clearPass()
+	{
+		_releasedBytes = 0;
+		_untrackedBytes = 0;
+		_batchCount = 0;
+		_yielded = false;
+		_time = 0;
+		_rssBefore = 0;
+		_rssAfter = 0;
+	}
+
+	/**
+	 * Reset the refault statistics once they have been reported.
+	 */
+	MMINLINE void clearRefaults()
+	{
+		_refaultedBytes = 0;
+	}
+
+	MM_HeapUncommitStats()
+		: MM_Base()
+		, _passCount(0)
+		, _releasedBytes(0)
+		, _untrackedBytes(0)
+		, _batchCount(0)
+		, _yielded(false)
+		, _time(0)
+		, _rssBefore(0)
+		, _rssAfter(0)
+		, _refaultedBytes(0)
+		, _trackedBytes(0)
+		, _totalReleasedBytes(0)
+		, _totalRefaultedBytes(0)
+	{}
+};
+
+#endif /* HEAPUNCOMMITSTATS_HPP_ */
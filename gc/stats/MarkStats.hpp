@@ -48,6 +48,8 @@ public:
 	uintptr_t _objectsMarked;  /**< The number of objects found through scanning during marking */
 	uintptr_t _objectsScanned;  /**< The number of objects popped and scanned during marking (e.g., non-base type arrays) */
 	uintptr_t _bytesScanned; /**< The number of bytes scanned by the owning thread (or globally) during marking */
+	uint64_t _cacheReferences; /**< The number of last level cache references made while scanning, if cache miss statistics are enabled and available */
+	uint64_t _cacheMisses; /**< The number of last level cache misses incurred while scanning, if cache miss statistics are enabled and available */
 
 #if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
 	uintptr_t _syncStallCount; /**< The number of times the thread stalled at a sync point */
@@ -110,6 +112,8 @@ public:
 		,_objectsMarked(0)
 		,_objectsScanned(0)
 		,_bytesScanned(0)
+		,_cacheReferences(0)
+		,_cacheMisses(0)
 #if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
 		,_syncStallCount(0)
 		,_syncStallTime(0)
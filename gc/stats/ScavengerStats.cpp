@@ -78,6 +78,8 @@ MM_ScavengerStats::MM_ScavengerStats()
 #endif /* OMR_GC_LARGE_OBJECT_AREA */
 	,_flipDiscardBytes(0)
 	,_tenureDiscardBytes(0)
+	,_workStealAttemptCount(0)
+	,_workStealCount(0)
 	,_survivorTLHRemainderCount(0)
 	,_tenureTLHRemainderCount(0)
 	,_semiSpaceAllocBytesAcumulation(0)
@@ -89,6 +91,10 @@ MM_ScavengerStats::MM_ScavengerStats()
 	,_tenureExpandedBytes(0)
 	,_tenureExpandedCount(0)
 	,_tenureExpandedTime(0)
+	,_rememberedSetPruneTime(0)
+	,_rememberedSetPrunedCount(0)
+	,_rememberedSetConcurrentPruneTime(0)
+	,_rememberedSetConcurrentPrunedCount(0)
 	,_leafObjectCount(0)
 	,_copy_cachesize_sum(0)
 	,_slotsCopied(0)
@@ -181,6 +187,8 @@ MM_ScavengerStats::clear(bool firstIncrement)
 	 */
 	_flipDiscardBytes = 0;
 	_tenureDiscardBytes = 0;
+	_workStealAttemptCount = 0;
+	_workStealCount = 0;
 
 	_survivorTLHRemainderCount = 0;
 	_tenureTLHRemainderCount = 0;
@@ -194,6 +202,11 @@ MM_ScavengerStats::clear(bool firstIncrement)
 	_tenureExpandedCount = 0;
 	_tenureExpandedTime = 0;
 
+	_rememberedSetPruneTime = 0;
+	_rememberedSetPrunedCount = 0;
+	_rememberedSetConcurrentPruneTime = 0;
+	_rememberedSetConcurrentPrunedCount = 0;
+
 	_slotsCopied = 0;
 	_slotsScanned = 0;
 
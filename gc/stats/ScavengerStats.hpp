@@ -126,6 +126,9 @@ public:
 	uintptr_t _flipDiscardBytes;		/**< Bytes of survivor discarded by copy scan cache */
 	uintptr_t _tenureDiscardBytes;		/**< Bytes of tenure discarded by copy scan cache */
 
+	uintptr_t _workStealAttemptCount; /**< The number of times a thread tried to steal a scan cache from another thread's deque */
+	uintptr_t _workStealCount; /**< The number of scan caches successfully stolen from other threads' deques */
+
 	uintptr_t _survivorTLHRemainderCount;
 	uintptr_t _tenureTLHRemainderCount;
 
@@ -141,6 +144,11 @@ public:
 	uintptr_t _tenureExpandedCount; /**< The number of times the heap was expanded in order to complete the collection */
 	uint64_t _tenureExpandedTime; /**< Time taken expanding the heap in order to complete the collection, in hi-res ticks */
 
+	uint64_t _rememberedSetPruneTime; /**< Time, in hi-res ticks, spent pruning the remembered set inside the pause */
+	uintptr_t _rememberedSetPrunedCount; /**< The number of remembered set entries removed inside the pause */
+	uint64_t _rememberedSetConcurrentPruneTime; /**< Time, in hi-res ticks, the background helper spent pruning the remembered set since the previous scavenge (pause time saved) */
+	uintptr_t _rememberedSetConcurrentPrunedCount; /**< The number of remembered set entries removed by the background helper since the previous scavenge */
+
 	uint64_t _leafObjectCount;
 	uint64_t _copy_distance_counts[OMR_SCAVENGER_DISTANCE_BINS];
 	uint64_t _copy_cachesize_counts[OMR_SCAVENGER_CACHESIZE_BINS];
@@ -438,17 +438,7 @@ MM_SublistPool::popPreviousPuddle(MM_SublistPuddle * returnedPuddle)
 
 	/* return returnedPuddle to the list of used puddles */
 	if (NULL != returnedPuddle) {
-		Assert_MM_true(NULL == returnedPuddle->getNext());
-		returnedPuddle->setNext(_list);
-		_list = returnedPuddle;
-
-		/* It's illegal to have a non-empty list without an _allocPuddle. If 
-		 * this is the only puddle in the pool, make it the _allocPuddle. 
-		 */
-		if (NULL == _allocPuddle) {
-			_allocPuddle = returnedPuddle;
-			Assert_MM_true(NULL == _allocPuddle->getNext());
-		}
+		returnPuddleNoLock(returnedPuddle);
 	}
 
 	/* pop an element from the previous list */
@@ -462,3 +452,27 @@ MM_SublistPool::popPreviousPuddle(MM_SublistPuddle * returnedPuddle)
 	
 	return result;
 }
+
+void
+MM_SublistPool::returnPreviousPuddle(MM_SublistPuddle *returnedPuddle)
+{
+	omrthread_monitor_enter(_mutex);
+	returnPuddleNoLock(returnedPuddle);
+	omrthread_monitor_exit(_mutex);
+}
+
+void
+MM_SublistPool::returnPuddleNoLock(MM_SublistPuddle *returnedPuddle)
+{
+	Assert_MM_true(NULL == returnedPuddle->getNext());
+	returnedPuddle->setNext(_list);
+	_list = returnedPuddle;
+
+	/* It's illegal to have a non-empty list without an _allocPuddle. If 
+	 * this is the only puddle in the pool, make it the _allocPuddle. 
+	 */
+	if (NULL == _allocPuddle) {
+		_allocPuddle = returnedPuddle;
+		Assert_MM_true(NULL == _allocPuddle->getNext());
+	}
+}
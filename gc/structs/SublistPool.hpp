@@ -75,6 +75,7 @@ public:
 private:
 	MM_SublistPuddle *createNewPuddle(MM_EnvironmentBase *env);
 	void freePuddles(MM_EnvironmentBase *env, MM_SublistPuddle *list);
+	void returnPuddleNoLock(MM_SublistPuddle *returnedPuddle);
 
 protected:
 public:
@@ -125,6 +126,14 @@ public:
 	 * @return a puddle to process, or NULL if the list is empty
 	 */
 	MM_SublistPuddle *popPreviousPuddle(MM_SublistPuddle * returnedPuddle);
+
+	/**
+	 * Return a puddle obtained from #popPreviousPuddle() to the list of puddles without popping another one.
+	 * This is protected by a lock, so may safely be called by multiple threads.
+	 *
+	 * @param returnedPuddle[in] a puddle which has already been processed
+	 */
+	void returnPreviousPuddle(MM_SublistPuddle *returnedPuddle);
 	
 	MM_SublistPool() 
 		: _list(NULL)
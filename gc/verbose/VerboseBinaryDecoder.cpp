@@ -0,0 +1,668 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "VerboseBinaryDecoder.hpp"
+
+#include "VerboseBinaryFormat.hpp"
+
+#include <string.h>
+
+#define INDENT_SPACER "  "
+#define CSV_HEADER "record,depth,element,attribute,value\n"
+
+/**
+ * Read a varint.
+ * @return the number of bytes consumed, 0 if the input ends first, or -1 if the varint is malformed
+ */
+static intptr_t
+readVarint(const uint8_t *cursor, const uint8_t *limit, uint64_t *value)
+{
+	uintptr_t length = MM_VerboseBinaryFormat::decodeVarint(cursor, limit, value);
+	if (0 != length) {
+		return (intptr_t)length;
+	}
+	return ((limit - cursor) >= VERBOSE_BINARY_VARINT_MAX_LENGTH) ? -1 : 0;
+}
+
+/* Read a varint at cursor into value, returning from the calling decode function if it is incomplete or malformed */
+#define DECODE_VARINT(cursor, limit, value) \
+	do { \
+		intptr_t varintLength = readVarint((cursor), (limit), &(value)); \
+		if (varintLength <= 0) { \
+			return varintLength; \
+		} \
+		(cursor) += varintLength; \
+	} while (0)
+
+/**
+ * Format a number in the given base, zero padded to at least minDigits digits.
+ * @param[out] buffer receives the digits, must have room for 64 characters
+ * @return the number of characters written
+ */
+static uintptr_t
+formatNumber(char *buffer, uint64_t value, uintptr_t base, uintptr_t minDigits, bool upperCase)
+{
+	const char *digits = upperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+	char reversed[64];
+	uintptr_t length = 0;
+	do {
+		reversed[length++] = digits[value % base];
+		value /= base;
+	} while ((0 != value) && (length < sizeof(reversed)));
+	while ((length < minDigits) && (length < sizeof(reversed))) {
+		reversed[length++] = '0';
+	}
+	for (uintptr_t i = 0; i < length; i++) {
+		buffer[i] = reversed[length - i - 1];
+	}
+	return length;
+}
+
+MM_VerboseBinaryDecoder::MM_VerboseBinaryDecoder(OMRPortLibrary *portLibrary, OutputFormat format, OutputFunction output, void *userData)
+	: MM_Base()
+	, _portLibrary(portLibrary)
+	, _format(format)
+	, _output(output)
+	, _userData(userData)
+	, _pending(NULL)
+	, _pendingSize(0)
+	, _pendingUsed(0)
+	, _strings(NULL)
+	, _stringCount(0)
+	, _stringCapacity(0)
+	, _stringData(NULL)
+	, _stringDataUsed(0)
+	, _stringDataSize(0)
+	, _depth(0)
+	, _segmentCount(0)
+	, _elementCount(0)
+	, _isCorrupt(false)
+{}
+
+MM_VerboseBinaryDecoder *
+MM_VerboseBinaryDecoder::newInstance(OMRPortLibrary *portLibrary, OutputFormat format, OutputFunction output, void *userData)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+
+	MM_VerboseBinaryDecoder *decoder = (MM_VerboseBinaryDecoder *)omrmem_allocate_memory(sizeof(MM_VerboseBinaryDecoder), OMRMEM_CATEGORY_MM);
+	if (NULL != decoder) {
+		new(decoder) MM_VerboseBinaryDecoder(portLibrary, format, output, userData);
+	}
+	return decoder;
+}
+
+void
+MM_VerboseBinaryDecoder::kill()
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(_portLibrary);
+
+	tearDown();
+	omrmem_free_memory(this);
+}
+
+void
+MM_VerboseBinaryDecoder::tearDown()
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(_portLibrary);
+
+	if (NULL != _pending) {
+		omrmem_free_memory(_pending);
+		_pending = NULL;
+	}
+	if (NULL != _strings) {
+		omrmem_free_memory(_strings);
+		_strings = NULL;
+	}
+	if (NULL != _stringData) {
+		omrmem_free_memory(_stringData);
+		_stringData = NULL;
+	}
+}
+
+bool
+MM_VerboseBinaryDecoder::decode(const uint8_t *bytes, uintptr_t length)
+{
+	if (_isCorrupt) {
+		return false;
+	}
+
+	/* Complete the record left over from the last call, if any, by decoding from the carry over buffer */
+	bool fromPending = (0 != _pendingUsed);
+	if (fromPending) {
+		if (!appendPending(bytes, length)) {
+			return false;
+		}
+		bytes = _pending;
+		length = _pendingUsed;
+	}
+
+	const uint8_t *cursor = bytes;
+	const uint8_t *limit = bytes + length;
+	while (cursor < limit) {
+		intptr_t consumed = decodeRecord(cursor, limit);
+		if (consumed < 0) {
+			_isCorrupt = true;
+			return false;
+		}
+		if (0 == consumed) {
+			break;
+		}
+		cursor += consumed;
+	}
+
+	uintptr_t remaining = limit - cursor;
+	if (fromPending) {
+		memmove(_pending, cursor, remaining);
+		_pendingUsed = remaining;
+	} else if (0 != remaining) {
+		if (!appendPending(cursor, remaining)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool
+MM_VerboseBinaryDecoder::finish()
+{
+	bool result = !_isCorrupt && (0 == _pendingUsed) && (0 != _segmentCount);
+
+	if (!_isCorrupt) {
+		closeOpenElements();
+	}
+	_pendingUsed = 0;
+
+	return result;
+}
+
+bool
+MM_VerboseBinaryDecoder::decodeFile(const char *fileName)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(_portLibrary);
+
+	intptr_t fd = omrfile_open(fileName, EsOpenRead, 0);
+	if (-1 == fd) {
+		return false;
+	}
+
+	bool result = false;
+	uint8_t *chunk = (uint8_t *)omrmem_allocate_memory(READ_CHUNK_SIZE, OMRMEM_CATEGORY_MM);
+	if (NULL != chunk) {
+		result = true;
+		intptr_t bytesRead = 0;
+		/* omrfile_read() returns -1 at the end of the file as well as on error */
+		while (result && (0 < (bytesRead = omrfile_read(fd, chunk, READ_CHUNK_SIZE)))) {
+			result = decode(chunk, (uintptr_t)bytesRead);
+		}
+		omrmem_free_memory(chunk);
+	}
+	omrfile_close(fd);
+
+	return finish() && result;
+}
+
+bool
+MM_VerboseBinaryDecoder::isBinaryFile(OMRPortLibrary *portLibrary, const char *fileName)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	uint8_t magic[VERBOSE_BINARY_MAGIC_LENGTH];
+	bool result = false;
+
+	intptr_t fd = omrfile_open(fileName, EsOpenRead, 0);
+	if (-1 != fd) {
+		intptr_t bytesRead = omrfile_read(fd, magic, sizeof(magic));
+		result = (0 < bytesRead) && MM_VerboseBinaryFormat::hasMagic(magic, (uintptr_t)bytesRead);
+		omrfile_close(fd);
+	}
+
+	return result;
+}
+
+intptr_t
+MM_VerboseBinaryDecoder::decodeRecord(const uint8_t *cursor, const uint8_t *limit)
+{
+	/* A preamble may also appear between records when a log has been appended to */
+	if ((0 == _segmentCount) || (VERBOSE_BINARY_MAGIC_0 == *cursor)) {
+		return decodePreamble(cursor, limit);
+	}
+
+	const uint8_t *next = cursor + 1;
+	uint64_t operand = 0;
+	uint8_t type = *cursor;
+
+	switch (type) {
+	case VERBOSE_BINARY_RECORD_ELEMENT_START:
+		return decodeElement(cursor, limit, false);
+	case VERBOSE_BINARY_RECORD_ELEMENT_EMPTY:
+		return decodeElement(cursor, limit, true);
+	case VERBOSE_BINARY_RECORD_ELEMENT_END:
+		DECODE_VARINT(next, limit, operand);
+		if ((0 == _depth) || (operand >= _stringCount)) {
+			return -1;
+		}
+		_depth -= 1;
+		if (OUTPUT_XML == _format) {
+			emitIndent();
+			emit("</");
+			emitString((uintptr_t)operand);
+			emit(">\n");
+			if (1 == _depth) {
+				/* End of a stanza */
+				emit("\n");
+			}
+		}
+		return next - cursor;
+	case VERBOSE_BINARY_RECORD_STRING:
+	case VERBOSE_BINARY_RECORD_TEXT:
+	case VERBOSE_BINARY_RECORD_COMMENT:
+	case VERBOSE_BINARY_RECORD_RAW:
+		break;
+	default:
+		return -1;
+	}
+
+	DECODE_VARINT(next, limit, operand);
+	if (MAX_STRING_LENGTH < operand) {
+		return -1;
+	}
+	if ((uintptr_t)(limit - next) < operand) {
+		return 0;
+	}
+	const char *text = (const char *)next;
+	uintptr_t length = (uintptr_t)operand;
+	next += length;
+
+	if (VERBOSE_BINARY_RECORD_STRING == type) {
+		if (!defineString((const uint8_t *)text, length)) {
+			return -1;
+		}
+	} else if (OUTPUT_XML == _format) {
+		if (VERBOSE_BINARY_RECORD_RAW == type) {
+			emit(text, length);
+		} else if (VERBOSE_BINARY_RECORD_TEXT == type) {
+			emitIndent();
+			emit(text, length);
+		} else {
+			emitIndent();
+			emit("<!--");
+			emit(text, length);
+			emit("-->");
+		}
+		emit("\n");
+	} else if (VERBOSE_BINARY_RECORD_RAW != type) {
+		_elementCount += 1;
+		const char *element = (VERBOSE_BINARY_RECORD_TEXT == type) ? "#text" : "#comment";
+		emitRowPrefix(element, strlen(element));
+		emit(",");
+		emitCSVField(text, length);
+		emit("\n");
+	}
+
+	return next - cursor;
+}
+
+intptr_t
+MM_VerboseBinaryDecoder::decodePreamble(const uint8_t *cursor, const uint8_t *limit)
+{
+	uintptr_t available = limit - cursor;
+	if (available < VERBOSE_BINARY_MAGIC_LENGTH) {
+		const char magic[] = { VERBOSE_BINARY_MAGIC_0, VERBOSE_BINARY_MAGIC_1, VERBOSE_BINARY_MAGIC_2, VERBOSE_BINARY_MAGIC_3 };
+		return (0 == memcmp(cursor, magic, available)) ? 0 : -1;
+	}
+	if (!MM_VerboseBinaryFormat::hasMagic(cursor, available)) {
+		return -1;
+	}
+
+	const uint8_t *next = cursor + VERBOSE_BINARY_MAGIC_LENGTH;
+	uint64_t version = 0;
+	DECODE_VARINT(next, limit, version);
+	if ((0 == version) || (VERBOSE_BINARY_SCHEMA_VERSION < version)) {
+		/* Written by a newer encoder */
+		return -1;
+	}
+
+	startSegment();
+
+	return next - cursor;
+}
+
+intptr_t
+MM_VerboseBinaryDecoder::decodeElement(const uint8_t *cursor, const uint8_t *limit, bool isEmpty)
+{
+	const uint8_t *next = cursor + 1;
+	uint64_t nameId = 0;
+	uint64_t count = 0;
+
+	DECODE_VARINT(next, limit, nameId);
+	DECODE_VARINT(next, limit, count);
+	if ((nameId >= _stringCount) || (MAX_ATTRIBUTES < count) || (!isEmpty && (MAX_DEPTH == _depth))) {
+		return -1;
+	}
+
+	/* Read the whole element before producing any output, it may not all be here yet */
+	for (uintptr_t i = 0; i < count; i++) {
+		Value *value = &_values[i];
+		uint64_t attributeNameId = 0;
+		DECODE_VARINT(next, limit, attributeNameId);
+		if (attributeNameId >= _stringCount) {
+			return -1;
+		}
+		if (next == limit) {
+			return 0;
+		}
+		value->nameId = (uintptr_t)attributeNameId;
+		value->type = *next;
+		next += 1;
+		value->operand = 0;
+		value->number = 0;
+		value->bytes = NULL;
+
+		switch (value->type) {
+		case VERBOSE_BINARY_VALUE_STRING_REF:
+			DECODE_VARINT(next, limit, value->operand);
+			if (value->operand >= _stringCount) {
+				return -1;
+			}
+			break;
+		case VERBOSE_BINARY_VALUE_STRING:
+			DECODE_VARINT(next, limit, value->operand);
+			if (MAX_STRING_LENGTH < value->operand) {
+				return -1;
+			}
+			if ((uintptr_t)(limit - next) < value->operand) {
+				return 0;
+			}
+			value->bytes = next;
+			next += value->operand;
+			break;
+		case VERBOSE_BINARY_VALUE_UNSIGNED:
+			DECODE_VARINT(next, limit, value->number);
+			break;
+		case VERBOSE_BINARY_VALUE_HEX:
+		case VERBOSE_BINARY_VALUE_HEX_UPPER:
+			DECODE_VARINT(next, limit, value->operand);
+			DECODE_VARINT(next, limit, value->number);
+			if ((0 == value->operand) || (16 < value->operand)) {
+				return -1;
+			}
+			break;
+		case VERBOSE_BINARY_VALUE_DECIMAL:
+			DECODE_VARINT(next, limit, value->operand);
+			DECODE_VARINT(next, limit, value->number);
+			if ((0 == value->operand) || (18 < value->operand)) {
+				return -1;
+			}
+			break;
+		default:
+			return -1;
+		}
+	}
+
+	if (OUTPUT_XML == _format) {
+		emitIndent();
+		emit("<");
+		emitString((uintptr_t)nameId);
+		for (uintptr_t i = 0; i < count; i++) {
+			emit(" ");
+			emitString(_values[i].nameId);
+			emit("=\"");
+			emitValue(&_values[i], false);
+			emit("\"");
+		}
+		emit(isEmpty ? " />\n" : ">\n");
+		if ((isEmpty && (1 == _depth)) || (!isEmpty && (0 == _depth))) {
+			/* A stanza without content, or the start of the log */
+			emit("\n");
+		}
+	} else {
+		const char *name = _stringData + _strings[nameId].offset;
+		uintptr_t nameLength = _strings[nameId].length;
+		_elementCount += 1;
+		if (0 == count) {
+			emitRowPrefix(name, nameLength);
+			emit(",\n");
+		}
+		for (uintptr_t i = 0; i < count; i++) {
+			emitRowPrefix(name, nameLength);
+			StringEntry *attributeName = &_strings[_values[i].nameId];
+			emitCSVField(_stringData + attributeName->offset, attributeName->length);
+			emit(",");
+			emitValue(&_values[i], true);
+			emit("\n");
+		}
+	}
+
+	if (!isEmpty) {
+		_openElements[_depth] = (uintptr_t)nameId;
+		_depth += 1;
+	}
+
+	return next - cursor;
+}
+
+bool
+MM_VerboseBinaryDecoder::defineString(const uint8_t *bytes, uintptr_t length)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(_portLibrary);
+
+	if (_stringCount == _stringCapacity) {
+		uintptr_t capacity = (0 == _stringCapacity) ? 256 : (2 * _stringCapacity);
+		StringEntry *strings = (StringEntry *)omrmem_reallocate_memory(_strings, capacity * sizeof(StringEntry), OMRMEM_CATEGORY_MM);
+		if (NULL == strings) {
+			return false;
+		}
+		_strings = strings;
+		_stringCapacity = capacity;
+	}
+	if ((_stringDataSize - _stringDataUsed) < length) {
+		uintptr_t size = (0 == _stringDataSize) ? (16 * 1024) : _stringDataSize;
+		while ((size - _stringDataUsed) < length) {
+			size *= 2;
+		}
+		char *data = (char *)omrmem_reallocate_memory(_stringData, size, OMRMEM_CATEGORY_MM);
+		if (NULL == data) {
+			return false;
+		}
+		_stringData = data;
+		_stringDataSize = size;
+	}
+
+	memcpy(_stringData + _stringDataUsed, bytes, length);
+	_strings[_stringCount].offset = _stringDataUsed;
+	_strings[_stringCount].length = length;
+	_stringDataUsed += length;
+	_stringCount += 1;
+
+	return true;
+}
+
+void
+MM_VerboseBinaryDecoder::startSegment()
+{
+	if (0 == _segmentCount) {
+		if (OUTPUT_CSV == _format) {
+			emit(CSV_HEADER);
+		}
+	} else {
+		/* The previous log was not shut down cleanly */
+		closeOpenElements();
+	}
+	_stringCount = 0;
+	_stringDataUsed = 0;
+	_segmentCount += 1;
+}
+
+void
+MM_VerboseBinaryDecoder::closeOpenElements()
+{
+	while (0 < _depth) {
+		_depth -= 1;
+		if (OUTPUT_XML == _format) {
+			emitIndent();
+			emit("</");
+			emitString(_openElements[_depth]);
+			emit(">\n");
+		}
+	}
+}
+
+void
+MM_VerboseBinaryDecoder::emit(const char *text, uintptr_t length)
+{
+	if (0 != length) {
+		_output(_userData, text, length);
+	}
+}
+
+void
+MM_VerboseBinaryDecoder::emit(const char *text)
+{
+	emit(text, strlen(text));
+}
+
+void
+MM_VerboseBinaryDecoder::emitString(uintptr_t id)
+{
+	emit(_stringData + _strings[id].offset, _strings[id].length);
+}
+
+void
+MM_VerboseBinaryDecoder::emitCSVField(const char *text, uintptr_t length)
+{
+	bool needsQuotes = false;
+	for (uintptr_t i = 0; !needsQuotes && (i < length); i++) {
+		needsQuotes = (',' == text[i]) || ('"' == text[i]) || ('\n' == text[i]) || ('\r' == text[i]);
+	}
+	if (!needsQuotes) {
+		emit(text, length);
+	} else {
+		emit("\"");
+		const char *run = text;
+		for (uintptr_t i = 0; i < length; i++) {
+			if ('"' == text[i]) {
+				/* Emit up to and including the quote, which starts the next run so that it is doubled */
+				emit(run, (text + i + 1) - run);
+				run = text + i;
+			}
+		}
+		emit(run, (text + length) - run);
+		emit("\"");
+	}
+}
+
+void
+MM_VerboseBinaryDecoder::emitIndent()
+{
+	for (uintptr_t i = 1; i < _depth; i++) {
+		emit(INDENT_SPACER);
+	}
+}
+
+void
+MM_VerboseBinaryDecoder::emitValue(Value *value, bool isCSV)
+{
+	char buffer[96];
+	uintptr_t length = 0;
+
+	switch (value->type) {
+	case VERBOSE_BINARY_VALUE_STRING_REF:
+	case VERBOSE_BINARY_VALUE_STRING:
+	{
+		const char *text = (const char *)value->bytes;
+		uintptr_t textLength = (uintptr_t)value->operand;
+		if (VERBOSE_BINARY_VALUE_STRING_REF == value->type) {
+			text = _stringData + _strings[value->operand].offset;
+			textLength = _strings[value->operand].length;
+		}
+		if (isCSV) {
+			emitCSVField(text, textLength);
+		} else {
+			emit(text, textLength);
+		}
+		return;
+	}
+	case VERBOSE_BINARY_VALUE_UNSIGNED:
+		length = formatNumber(buffer, value->number, 10, 1, false);
+		break;
+	case VERBOSE_BINARY_VALUE_HEX:
+	case VERBOSE_BINARY_VALUE_HEX_UPPER:
+		buffer[0] = '0';
+		buffer[1] = 'x';
+		length = 2 + formatNumber(buffer + 2, value->number, 16, (uintptr_t)value->operand, VERBOSE_BINARY_VALUE_HEX_UPPER == value->type);
+		break;
+	case VERBOSE_BINARY_VALUE_DECIMAL:
+	{
+		uint64_t scale = 1;
+		for (uint64_t i = 0; i < value->operand; i++) {
+			scale *= 10;
+		}
+		length = formatNumber(buffer, value->number / scale, 10, 1, false);
+		buffer[length++] = '.';
+		length += formatNumber(buffer + length, value->number % scale, 10, (uintptr_t)value->operand, false);
+		break;
+	}
+	default:
+		break;
+	}
+
+	emit(buffer, length);
+}
+
+void
+MM_VerboseBinaryDecoder::emitRowPrefix(const char *element, uintptr_t length)
+{
+	char buffer[64];
+	uintptr_t used = formatNumber(buffer, _elementCount, 10, 1, false);
+	buffer[used++] = ',';
+	used += formatNumber(buffer + used, _depth, 10, 1, false);
+	buffer[used++] = ',';
+	emit(buffer, used);
+	emit(element, length);
+	emit(",");
+}
+
+bool
+MM_VerboseBinaryDecoder::appendPending(const uint8_t *bytes, uintptr_t length)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(_portLibrary);
+
+	if ((_pendingSize - _pendingUsed) < length) {
+		uintptr_t size = (0 == _pendingSize) ? 4096 : _pendingSize;
+		while ((size - _pendingUsed) < length) {
+			size *= 2;
+		}
+		uint8_t *pending = (uint8_t *)omrmem_reallocate_memory(_pending, size, OMRMEM_CATEGORY_MM);
+		if (NULL == pending) {
+			_isCorrupt = true;
+			return false;
+		}
+		_pending = pending;
+		_pendingSize = size;
+	}
+	memcpy(_pending + _pendingUsed, bytes, length);
+	_pendingUsed += length;
+
+	return true;
+}
+
+#undef DECODE_VARINT
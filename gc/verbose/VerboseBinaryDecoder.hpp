@@ -0,0 +1,176 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#if !defined(VERBOSEBINARYDECODER_HPP_)
+#define VERBOSEBINARYDECODER_HPP_
+
+#include "omrcfg.h"
+#include "omrport.h"
+#include "modronbase.h"
+
+#include "Base.hpp"
+
+/**
+ * Streaming decoder for binary verbose GC logs (see VerboseBinaryFormat.hpp).
+ * Input may be handed over in arbitrarily sized pieces; every complete record is converted
+ * to XML or CSV text and passed to an output function as soon as it has been read.
+ * The decoder only depends on the port library so that it can be used by offline tools.
+ */
+class MM_VerboseBinaryDecoder : public MM_Base
+{
+	/*
+	 * Data members
+	 */
+public:
+	typedef enum {
+		OUTPUT_XML = 1, /**< the XML text the log was encoded from */
+		OUTPUT_CSV = 2 /**< one "record,depth,element,attribute,value" row per attribute */
+	} OutputFormat;
+
+	/**
+	 * Receives decoded text.
+	 * @param[in] userData the value given to newInstance()
+	 * @param[in] text decoded text, not NUL terminated
+	 * @param[in] length number of characters in text
+	 */
+	typedef void (*OutputFunction)(void *userData, const char *text, uintptr_t length);
+
+protected:
+private:
+	struct StringEntry {
+		uintptr_t offset; /**< offset of the string in _stringData */
+		uintptr_t length; /**< length of the string in bytes */
+	};
+
+	struct Value {
+		uintptr_t nameId; /**< string id of the attribute name */
+		uintptr_t type; /**< one of the VERBOSE_BINARY_VALUE_* types */
+		uint64_t operand; /**< string id, length, digit count or fraction digit count depending on type */
+		uint64_t number; /**< the numeric value for numeric types */
+		const uint8_t *bytes; /**< the characters of an inline string */
+	};
+
+	enum {
+		MAX_ATTRIBUTES = 256, /**< most attributes accepted on one element */
+		MAX_DEPTH = 64, /**< deepest element nesting accepted */
+		MAX_STRING_LENGTH = 64 * 1024 * 1024, /**< longest string accepted in a record */
+		READ_CHUNK_SIZE = 64 * 1024 /**< bytes read at a time by decodeFile() */
+	};
+
+	OMRPortLibrary *_portLibrary;
+	OutputFormat _format;
+	OutputFunction _output;
+	void *_userData;
+
+	uint8_t *_pending; /**< input carried over from the last call: the tail of an incomplete record */
+	uintptr_t _pendingSize; /**< size of _pending in bytes */
+	uintptr_t _pendingUsed; /**< number of bytes held in _pending */
+
+	StringEntry *_strings; /**< the string table of the current segment, indexed by string id */
+	uintptr_t _stringCount; /**< number of strings defined in the current segment */
+	uintptr_t _stringCapacity; /**< number of entries _strings has room for */
+	char *_stringData; /**< contents of the strings */
+	uintptr_t _stringDataUsed; /**< bytes of _stringData in use */
+	uintptr_t _stringDataSize; /**< size of _stringData in bytes */
+
+	uintptr_t _openElements[MAX_DEPTH]; /**< name ids of the open elements, outermost first */
+	uintptr_t _depth; /**< number of open elements */
+	Value _values[MAX_ATTRIBUTES]; /**< attributes of the element being decoded */
+
+	uintptr_t _segmentCount; /**< number of preambles seen, more than one if logs were appended to the same file */
+	uintptr_t _elementCount; /**< number of elements decoded, used to number CSV rows */
+	bool _isCorrupt; /**< set once input which is not a valid binary log has been seen */
+
+	/*
+	 * Function members
+	 */
+public:
+	/**
+	 * Create a new decoder.
+	 * @param[in] portLibrary used for memory and, by decodeFile(), file access
+	 * @param[in] format the text format to produce
+	 * @param[in] output called with the decoded text
+	 * @param[in] userData passed through to output
+	 * @return the new decoder, or NULL if it could not be allocated
+	 */
+	static MM_VerboseBinaryDecoder *newInstance(OMRPortLibrary *portLibrary, OutputFormat format, OutputFunction output, void *userData);
+	void kill();
+
+	/**
+	 * Decode the next piece of a log.
+	 * @param[in] bytes the input
+	 * @param[in] length number of bytes of input
+	 * @return false if the input is not a valid binary verbose log, true otherwise
+	 */
+	bool decode(const uint8_t *bytes, uintptr_t length);
+
+	/**
+	 * Signal the end of the input. Elements which are still open, as in the log of a process
+	 * which has not shut down, are closed so that the XML produced is well formed.
+	 * @return false if the input was invalid or ended part way through a record
+	 */
+	bool finish();
+
+	/**
+	 * Decode a whole file, then call finish().
+	 * @param[in] fileName the binary log to read
+	 * @return false if the file could not be read or is not a valid binary verbose log
+	 */
+	bool decodeFile(const char *fileName);
+
+	/**
+	 * Check whether a file is a binary verbose log.
+	 * @param[in] portLibrary the port library
+	 * @param[in] fileName the file to check
+	 * @return true if the file starts with the binary verbose log magic
+	 */
+	static bool isBinaryFile(OMRPortLibrary *portLibrary, const char *fileName);
+
+protected:
+	MM_VerboseBinaryDecoder(OMRPortLibrary *portLibrary, OutputFormat format, OutputFunction output, void *userData);
+	void tearDown();
+
+private:
+	/**
+	 * Decode one record (or preamble) from the start of the input.
+	 * @return the number of bytes consumed, 0 if the record is incomplete, or -1 if the input is invalid
+	 */
+	intptr_t decodeRecord(const uint8_t *cursor, const uint8_t *limit);
+	intptr_t decodePreamble(const uint8_t *cursor, const uint8_t *limit);
+	intptr_t decodeElement(const uint8_t *cursor, const uint8_t *limit, bool isEmpty);
+	bool defineString(const uint8_t *bytes, uintptr_t length);
+
+	void startSegment();
+	void closeOpenElements();
+
+	void emit(const char *text, uintptr_t length);
+	void emit(const char *text);
+	void emitString(uintptr_t id);
+	void emitCSVField(const char *text, uintptr_t length);
+	void emitIndent();
+	void emitValue(Value *value, bool isCSV);
+	void emitRowPrefix(const char *element, uintptr_t length);
+
+	bool appendPending(const uint8_t *bytes, uintptr_t length);
+};
+
+#endif /* VERBOSEBINARYDECODER_HPP_ */
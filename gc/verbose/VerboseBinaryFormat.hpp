@@ -0,0 +1,157 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#if !defined(VERBOSEBINARYFORMAT_HPP_)
+#define VERBOSEBINARYFORMAT_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "modronbase.h"
+
+/**
+ * @file
+ * Layout of the binary verbose GC log written by MM_VerboseWriterFileLoggingBinary and read
+ * back by MM_VerboseBinaryDecoder.
+ *
+ * The binary log is a tokenized form of the XML verbose stream described by schema.xsd, so a
+ * decoded log can be processed by the same tools as a text log. A file starts with the four
+ * magic bytes followed by the schema version as a varint, and is then a sequence of records,
+ * each introduced by a one byte record type:
+ *
+ *   STRING        <length> <bytes>                  defines the next string table entry (ids count up from 0)
+ *   ELEMENT_START <name id> <count> <attribute>*    opens an element
+ *   ELEMENT_EMPTY <name id> <count> <attribute>*    an element with no content ("<name ... />")
+ *   ELEMENT_END                                     closes the innermost open element
+ *   TEXT          <length> <bytes>                  character data
+ *   COMMENT       <length> <bytes>                  a comment, without the delimiters
+ *   RAW           <length> <bytes>                  markup copied verbatim (e.g. the XML declaration)
+ *
+ * An attribute is a name id followed by a value, which is a one byte value type and its operands:
+ *
+ *   STRING_REF    <id>                              an interned string
+ *   STRING        <length> <bytes>                  an inline string
+ *   UNSIGNED      <value>                           canonical decimal integer
+ *   HEX           <digits> <value>                  "0x" followed by exactly <digits> lower case hex digits
+ *   HEX_UPPER     <digits> <value>                  as HEX, with upper case hex digits
+ *   DECIMAL       <fraction digits> <scaled value>  fixed point decimal, e.g. "12.345" is 3, 12345
+ *
+ * All lengths, ids, counts and values are unsigned LEB128 varints. Strings are stored exactly as
+ * they appear in the XML text, including any character references. The string table is reset at
+ * the start of each file so that every file of a rotating log can be decoded on its own.
+ */
+
+#define VERBOSE_BINARY_MAGIC_0 'O'
+#define VERBOSE_BINARY_MAGIC_1 'V'
+#define VERBOSE_BINARY_MAGIC_2 'G'
+#define VERBOSE_BINARY_MAGIC_3 'B'
+#define VERBOSE_BINARY_MAGIC_LENGTH 4
+
+/* Bump whenever a record or value type is added or changed */
+#define VERBOSE_BINARY_SCHEMA_VERSION 1
+
+#define VERBOSE_BINARY_RECORD_STRING 1
+#define VERBOSE_BINARY_RECORD_ELEMENT_START 2
+#define VERBOSE_BINARY_RECORD_ELEMENT_EMPTY 3
+#define VERBOSE_BINARY_RECORD_ELEMENT_END 4
+#define VERBOSE_BINARY_RECORD_TEXT 5
+#define VERBOSE_BINARY_RECORD_COMMENT 6
+#define VERBOSE_BINARY_RECORD_RAW 7
+
+#define VERBOSE_BINARY_VALUE_STRING_REF 0
+#define VERBOSE_BINARY_VALUE_STRING 1
+#define VERBOSE_BINARY_VALUE_UNSIGNED 2
+#define VERBOSE_BINARY_VALUE_HEX 3
+#define VERBOSE_BINARY_VALUE_HEX_UPPER 4
+#define VERBOSE_BINARY_VALUE_DECIMAL 5
+
+/* A 64 bit value never needs more than 10 varint bytes */
+#define VERBOSE_BINARY_VARINT_MAX_LENGTH 10
+
+/**
+ * Helpers shared by the binary verbose writer and decoder.
+ */
+class MM_VerboseBinaryFormat
+{
+public:
+	/**
+	 * Encode a value as an unsigned LEB128 varint.
+	 * @param[out] cursor where to write the value, must have room for VERBOSE_BINARY_VARINT_MAX_LENGTH bytes
+	 * @param[in] value the value to encode
+	 * @return the number of bytes written
+	 */
+	MMINLINE static uintptr_t
+	encodeVarint(uint8_t *cursor, uint64_t value)
+	{
+		uintptr_t length = 0;
+		while (value >= 0x80) {
+			cursor[length++] = (uint8_t)(value | 0x80);
+			value >>= 7;
+		}
+		cursor[length++] = (uint8_t)value;
+		return length;
+	}
+
+	/**
+	 * Decode an unsigned LEB128 varint.
+	 * @param[in] cursor the first byte of the varint
+	 * @param[in] limit the first byte past the available input
+	 * @param[out] value the decoded value
+	 * @return the number of bytes consumed, or 0 if the input ends before the varint does or the varint is malformed
+	 */
+	MMINLINE static uintptr_t
+	decodeVarint(const uint8_t *cursor, const uint8_t *limit, uint64_t *value)
+	{
+		uint64_t result = 0;
+		uintptr_t length = 0;
+		while ((cursor + length) < limit) {
+			uint8_t byte = cursor[length];
+			result |= ((uint64_t)(byte & 0x7F)) << (7 * length);
+			length += 1;
+			if (0 == (byte & 0x80)) {
+				*value = result;
+				return length;
+			}
+			if (VERBOSE_BINARY_VARINT_MAX_LENGTH == length) {
+				break;
+			}
+		}
+		return 0;
+	}
+
+	/**
+	 * Check whether a buffer starts with the binary verbose log magic.
+	 * @param[in] bytes the start of the buffer
+	 * @param[in] length number of bytes available
+	 * @return true if the buffer holds a binary verbose log
+	 */
+	MMINLINE static bool
+	hasMagic(const uint8_t *bytes, uintptr_t length)
+	{
+		return (length >= VERBOSE_BINARY_MAGIC_LENGTH)
+			&& (VERBOSE_BINARY_MAGIC_0 == bytes[0])
+			&& (VERBOSE_BINARY_MAGIC_1 == bytes[1])
+			&& (VERBOSE_BINARY_MAGIC_2 == bytes[2])
+			&& (VERBOSE_BINARY_MAGIC_3 == bytes[3]);
+	}
+};
+
+#endif /* VERBOSEBINARYFORMAT_HPP_ */
@@ -31,6 +31,13 @@
 #include "HeapRegionManager.hpp"
 #include "ObjectAllocationInterface.hpp"
 #include "ParallelDispatcher.hpp"
+#if defined(OMR_GC_SPARSE_HEAP_ALLOCATION)
+#include "SparseVirtualMemory.hpp"
+#endif /* OMR_GC_SPARSE_HEAP_ALLOCATION */
+#if defined(OMR_GC_SEGREGATED_HEAP)
+#include "SizeClasses.hpp"
+#include "SizeClassTuner.hpp"
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 #include "VerboseHandlerOutput.hpp"
 #include "VerboseManager.hpp"
 #include "VerboseWriterChain.hpp"
@@ -347,11 +354,97 @@ MM_VerboseHandlerOutput::outputInitializedStanza(MM_EnvironmentBase *env, MM_Ver
 #endif /* OMR_GC_MODRON_CONCURRENT_MARK */
 	}
 
+	if (_extensions->adaptiveTaskThreadingEnabled()) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"adaptiveTaskThreadingTolerance\" value=\"%.2f\" />", _extensions->adaptiveTaskThreadingTolerance);
+	}
+
 	buffer->formatAndOutput(env, 1, "<attribute name=\"packetListSplit\" value=\"%zu\" />", _extensions->packetListSplit);
+	if (_extensions->packetListLockFree) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"packetListLockFree\" value=\"true\" />");
+	}
+#if defined(OMR_GC_REALTIME)
+	if (_extensions->sATBBarrierPacketsThreadOwned) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"sATBBarrierPacketsThreadOwned\" value=\"true\" />");
+	}
+#endif /* defined(OMR_GC_REALTIME) */
+	if (0 != _extensions->markingPrefetchDistance) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"markingPrefetchDistance\" value=\"%zu\" />", _extensions->markingPrefetchDistance);
+	}
+	if (_extensions->freeListSizeClassIndex) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"freeListSizeClassIndex\" value=\"true\" />");
+	}
+	if (_extensions->heapUncommit) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"heapUncommit\" value=\"true\" />");
+		buffer->formatAndOutput(env, 1, "<attribute name=\"heapUncommitDelay\" value=\"%zu\" />", _extensions->heapUncommitDelay);
+		buffer->formatAndOutput(env, 1, "<attribute name=\"heapUncommitMinimumFreeEntrySize\" value=\"%zu\" />", _extensions->heapUncommitMinimumFreeEntrySize);
+		buffer->formatAndOutput(env, 1, "<attribute name=\"heapUncommitBatchSize\" value=\"%zu\" />", _extensions->heapUncommitBatchSize);
+		buffer->formatAndOutput(env, 1, "<attribute name=\"heapUncommitBatchEntryCount\" value=\"%zu\" />", _extensions->heapUncommitBatchEntryCount);
+	}
+	if (0 != _extensions->parallelMemsetMinimumSize) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"parallelMemsetMinimumSize\" value=\"%zu\" />", _extensions->parallelMemsetMinimumSize);
+	}
+#if defined(OMR_GC_MARK_MAP_EPOCH_CLEARING)
+	if (_extensions->markMapEpochClearing) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"markMapEpochClearing\" value=\"true\" />");
+	}
+#endif /* OMR_GC_MARK_MAP_EPOCH_CLEARING */
+#if defined(OMR_GC_LARGE_OBJECT_AREA)
+	if (_extensions->largeObjectArea) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"largeObjectAreaBestFit\" value=\"%s\" />", _extensions->largeObjectAreaBestFit ? "true" : "false");
+		buffer->formatAndOutput(env, 1, "<attribute name=\"largeObjectAreaFragmentationThreshold\" value=\"%.2f\" />", _extensions->largeObjectAreaFragmentationThreshold);
+	}
+#endif /* OMR_GC_LARGE_OBJECT_AREA */
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	buffer->formatAndOutput(env, 1, "<attribute name=\"cacheListSplit\" value=\"%zu\" />", _extensions->cacheListSplit);
+	if (_extensions->scavengerWorkStealing) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"scavengerWorkStealingDequeSize\" value=\"%zu\" />", _extensions->scavengerWorkStealingDequeSize);
+	}
+	if (_extensions->numaAwareNursery) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"numaAwareNursery\" value=\"true\" />");
+	}
+	if (_extensions->scavengerLearnHotFields) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"scavengerLearnHotFields\" value=\"true\" />");
+		buffer->formatAndOutput(env, 1, "<attribute name=\"scavengerHotFieldSampleInterval\" value=\"%zu\" />", _extensions->scavengerHotFieldSampleInterval);
+		buffer->formatAndOutput(env, 1, "<attribute name=\"scavengerHotFieldTableSize\" value=\"%zu\" />", _extensions->scavengerHotFieldTableSize);
+	}
+	if (_extensions->scavengerConcurrentRememberedSetPrune) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"scavengerConcurrentRememberedSetPrune\" value=\"true\" />");
+	}
+	if (0 != _extensions->scavengerPauseTarget) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"scavengerPauseTarget\" value=\"%zu\" />", _extensions->scavengerPauseTarget);
+	}
 #endif /* OMR_GC_MODRON_SCAVENGER */
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+	if (_extensions->isConcurrentMarkEnabled() && (1 < _extensions->cardCleaningBatchSize)) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"cardCleaningBatchSize\" value=\"%zu\" />", _extensions->cardCleaningBatchSize);
+		if (0 != _extensions->concurrentFinalPauseTarget) {
+			buffer->formatAndOutput(env, 1, "<attribute name=\"concurrentFinalPauseTarget\" value=\"%zu\" />", _extensions->concurrentFinalPauseTarget);
+			buffer->formatAndOutput(env, 1, "<attribute name=\"concurrentAllocationTaxLimit\" value=\"%.2f\" />", _extensions->concurrentAllocationTaxLimit);
+		}
+	}
+#endif /* OMR_GC_MODRON_CONCURRENT_MARK */
+#if defined(OMR_GC_MODRON_COMPACTION)
+	if (0 != _extensions->compactIncrementSubAreas) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"compactIncrementSubAreas\" value=\"%zu\" />", _extensions->compactIncrementSubAreas);
+	}
+#endif /* OMR_GC_MODRON_COMPACTION */
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	if (_extensions->isSegregatedHeap()) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"sizeClassTuning\" value=\"%s\" />", _extensions->sizeClassTuning ? "true" : "false");
+		if (_extensions->sizeClassTuning) {
+			buffer->formatAndOutput(env, 1, "<attribute name=\"sizeClassTuningWarmupCycles\" value=\"%zu\" />", _extensions->sizeClassTuningWarmupCycles);
+		}
+		if (NULL != _extensions->sizeClassTableFile) {
+			buffer->formatAndOutput(env, 1, "<attribute name=\"sizeClassTableFile\" value=\"%s\" />", _extensions->sizeClassTableFile);
+		}
+		buffer->formatAndOutput(env, 1, "<attribute name=\"segregatedLazySweep\" value=\"%s\" />", _extensions->segregatedLazySweep ? "true" : "false");
+	}
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 	buffer->formatAndOutput(env, 1, "<attribute name=\"splitFreeListSplitAmount\" value=\"%zu\" />", _extensions->splitFreeListSplitAmount);
+	if (_extensions->asyncVerboseLogging) {
+		buffer->formatAndOutput(env, 1, "<attribute name=\"asyncVerboseLoggingBufferSize\" value=\"0x%zx\" />", _extensions->asyncVerboseLoggingBufferSize);
+	}
+	buffer->formatAndOutput(env, 1, "<attribute name=\"binaryVerboseLogging\" value=\"%s\" />", _extensions->binaryVerboseLogging ? "true" : "false");
 	buffer->formatAndOutput(env, 1, "<attribute name=\"numaNodes\" value=\"%zu\" />", _extensions->_numaManager.getAffinityLeaderCount());
 #if defined(J9VM_OPT_CRIU_SUPPORT)
 	if (_extensions->reinitializationInProgress()) {
@@ -407,6 +500,11 @@ MM_VerboseHandlerOutput::outputInitializedRegion(MM_EnvironmentBase *env, MM_Ver
 #if defined(OMR_GC_SPARSE_HEAP_ALLOCATION)
 		buffer->formatAndOutput(env, 2, "<attribute name=\"virtualLargeObjectHeapRequested\" value=\"%s\"/>", virtualLargeObjectHeapRequested);
 		buffer->formatAndOutput(env, 2, "<attribute name=\"virtualLargeObjectHeapStatus\" value=\"%s\"/>", virtualLargeObjectHeapStatus);
+		if (NULL != _extensions->largeObjectVirtualMemory) {
+			buffer->formatAndOutput(env, 2, "<attribute name=\"virtualLargeObjectHeapPageSize\" value=\"%zu\"/>", _extensions->largeObjectVirtualMemory->getPageSize());
+			buffer->formatAndOutput(env, 2, "<attribute name=\"virtualLargeObjectHeapAllocationGranule\" value=\"%zu\"/>", _extensions->largeObjectVirtualMemory->getAllocationGranule());
+			buffer->formatAndOutput(env, 2, "<attribute name=\"virtualLargeObjectHeapDecommitBatchSize\" value=\"%zu\"/>", _extensions->sparseHeapDecommitBatchSize);
+		}
 #endif /* OMR_GC_SPARSE_HEAP_ALLOCATION */
 	}
 	buffer->formatAndOutput(env, 1, "</region>");
@@ -880,6 +978,53 @@ MM_VerboseHandlerOutput::outputMemoryInfoInnerStanza(MM_EnvironmentBase *env, ui
 {
 }
 
+#if defined(OMR_GC_SEGREGATED_HEAP)
+void
+MM_VerboseHandlerOutput::outputSizeClassWasteInfo(MM_EnvironmentBase *env, uintptr_t indent)
+{
+	MM_SizeClassTuner *tuner = _extensions->sizeClassTuner;
+	if (NULL == tuner) {
+		return;
+	}
+
+	MM_VerboseWriterChain* writer = _manager->getWriterChain();
+	MM_SizeClasses *sizeClasses = _extensions->defaultSizeClasses;
+	uintptr_t totalAllocations = 0;
+	uintptr_t totalRequested = 0;
+	uintptr_t totalWasted = 0;
+	for (uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL; sizeClass <= OMR_SIZECLASSES_MAX_SMALL; sizeClass++) {
+		const MM_SizeClassTuner::SizeClassWaste *waste = tuner->getCycleWaste(sizeClass);
+		totalAllocations += waste->allocations;
+		totalRequested += waste->requestedBytes;
+		totalWasted += waste->wastedBytes;
+	}
+
+	writer->formatAndOutput(env, indent, "<size-class-waste allocations=\"%zu\" requestedBytes=\"%zu\" wastedBytes=\"%zu\" percent=\"%zu\">",
+			totalAllocations, totalRequested, totalWasted, (0 == totalRequested) ? 0 : (uintptr_t)(((uint64_t)totalWasted * 100) / (totalRequested + totalWasted)));
+	for (uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL; sizeClass <= OMR_SIZECLASSES_MAX_SMALL; sizeClass++) {
+		const MM_SizeClassTuner::SizeClassWaste *waste = tuner->getCycleWaste(sizeClass);
+		if (0 != waste->allocations) {
+			writer->formatAndOutput(env, indent + 1, "<size-class index=\"%zu\" cellSize=\"%zu\" allocations=\"%zu\" wastedBytes=\"%zu\" percent=\"%zu\" />",
+					sizeClass, sizeClasses->getCellSize(sizeClass), waste->allocations, waste->wastedBytes,
+					(uintptr_t)(((uint64_t)waste->wastedBytes * 100) / (waste->requestedBytes + waste->wastedBytes)));
+		}
+	}
+	writer->formatAndOutput(env, indent, "</size-class-waste>");
+
+	if (tuner->tunedTableComputed()) {
+		char cellSizes[MM_SizeClassTuner::CELL_SIZES_BUFFER_SIZE];
+		uintptr_t length = 0;
+		const uintptr_t *tunedCellSizes = tuner->getTunedCellSizes();
+		OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+		for (uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL; sizeClass <= OMR_SIZECLASSES_MAX_SMALL; sizeClass++) {
+			length += omrstr_printf(cellSizes + length, sizeof(cellSizes) - length, (OMR_SIZECLASSES_MIN_SMALL == sizeClass) ? "%zu" : " %zu", tunedCellSizes[sizeClass]);
+		}
+		writer->formatAndOutput(env, indent, "<size-class-table cellSizes=\"%s\" requestedBytes=\"%zu\" currentWastedBytes=\"%zu\" tunedWastedBytes=\"%zu\" />",
+				cellSizes, tuner->getWarmupRequestedBytes(), tuner->getCurrentWastedBytes(), tuner->getTunedWastedBytes());
+	}
+}
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
+
 void
 MM_VerboseHandlerOutput::printAllocationStats(MM_EnvironmentBase* env)
 {
@@ -994,6 +1139,9 @@ MM_VerboseHandlerOutput::handleGCEnd(J9HookInterface** hook, uintptr_t eventNum,
 	}
 	writer->formatAndOutput(env, 0, "<gc-end %s activeThreads=\"%zu\">", tagTemplate, activeThreads);
 	outputMemoryInfo(env, _manager->getIndentLevel() + 1, stats);
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	outputSizeClassWasteInfo(env, _manager->getIndentLevel() + 1);
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 	writer->formatAndOutput(env, 0, "</gc-end>");
 	exitAtomicReportingBlock();
 }
@@ -203,6 +203,16 @@ protected:
 
 	virtual bool hasOutputMemoryInfoInnerStanza();
 
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	/**
+	 * Output the internal fragmentation of each segregated size class over the last collection interval,
+	 * and the tuned size class table once it has been computed.
+	 * @param env GC thread used for output.
+	 * @param indent base level of indentation for the summary.
+	 */
+	void outputSizeClassWasteInfo(MM_EnvironmentBase *env, uintptr_t indent);
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
+
 	virtual void outputMemoryInfoInnerStanza(MM_EnvironmentBase *env, uintptr_t indent, MM_CollectionStatistics *stats);
 
 	/**
@@ -35,7 +35,9 @@ typedef enum {
 	VERBOSE_WRITER_FILE_LOGGING_SYNCHRONOUS = 2,
 	VERBOSE_WRITER_FILE_LOGGING_BUFFERED = 3,
 	VERBOSE_WRITER_TRACE = 4,
-	VERBOSE_WRITER_HOOK = 5
+	VERBOSE_WRITER_HOOK = 5,
+	VERBOSE_WRITER_FILE_LOGGING_ASYNCHRONOUS = 6,
+	VERBOSE_WRITER_FILE_LOGGING_BINARY = 7
 } WriterType;
 
 /**
@@ -75,6 +77,13 @@ public:
 
 	virtual void closeStream(MM_EnvironmentBase *env) = 0;
 
+	/**
+	 * Wait until output handed to the writer has reached its destination.
+	 * Only writers which defer their output need to implement this.
+	 * @param[in] env the current environment.
+	 */
+	virtual void flushPendingOutput(MM_EnvironmentBase *env) {}
+
 	/**
 	 * Open the output mechanism for the writer.
 	 * @param[in] env the current environment.
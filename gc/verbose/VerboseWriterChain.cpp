@@ -128,3 +128,13 @@ MM_VerboseWriterChain::endOfCycle(MM_EnvironmentBase *env)
 }
 
 
+
+void
+MM_VerboseWriterChain::flushPendingOutput(MM_EnvironmentBase *env)
+{
+	MM_VerboseWriter* writer = _writers;
+	while (NULL != writer) {
+		writer->flushPendingOutput(env);
+		writer = writer->getNextWriter();
+	}
+}
@@ -73,6 +73,12 @@ public:
 	 * @param env[in] the current thread 
 	 */
 	void endOfCycle(MM_EnvironmentBase *env);
+
+	/**
+	 * Wait for each of the writers in the chain to write out any output it has deferred
+	 * @param env[in] the current thread
+	 */
+	void flushPendingOutput(MM_EnvironmentBase *env);
 	
 protected:
 	MM_VerboseWriterChain();
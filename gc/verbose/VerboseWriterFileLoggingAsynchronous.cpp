@@ -0,0 +1,532 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "modronapicore.hpp"
+#include "VerboseManager.hpp"
+#include "VerboseWriterFileLoggingAsynchronous.hpp"
+
+#include "AtomicOperations.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "VerboseBuffer.hpp"
+#include "VerboseHandlerOutput.hpp"
+
+#include <string.h>
+
+/* Longest time published records wait in the ring before the flusher writes them */
+#define ASYNC_VERBOSE_FLUSH_INTERVAL_MILLIS 100
+/* Smallest ring which can hold a typical cycle worth of verbose output */
+#define ASYNC_VERBOSE_MINIMUM_RING_SIZE (64 * 1024)
+
+/**
+ * Flusher thread procedure
+ *
+ * @parm writer Address of the MM_VerboseWriterFileLoggingAsynchronous that owns the thread
+ */
+static int J9THREAD_PROC
+verbose_flusher_thread_proc(void *writer)
+{
+	((MM_VerboseWriterFileLoggingAsynchronous *)writer)->flusherEntryPoint();
+	return 0;
+}
+
+MM_VerboseWriterFileLoggingAsynchronous::MM_VerboseWriterFileLoggingAsynchronous(MM_EnvironmentBase *env, MM_VerboseManager *manager)
+	:MM_VerboseWriterFileLogging(env, manager, VERBOSE_WRITER_FILE_LOGGING_ASYNCHRONOUS)
+	,_logFileStream(NULL)
+	,_omrVM(env->getOmrVM())
+	,_ring(NULL)
+	,_ringSize(0)
+	,_reserveCursor(0)
+	,_readCursor(0)
+	,_droppedEvents(0)
+	,_droppedBytes(0)
+	,_reportedDroppedEvents(0)
+	,_deferredRotations(0)
+	,_monitor(NULL)
+	,_flusherThread(NULL)
+	,_flusherState(FLUSHER_NOT_STARTED)
+	,_flushRequests(0)
+	,_flushesCompleted(0)
+{
+	/* No implementation */
+}
+
+/**
+ * Create a new MM_VerboseWriterFileLoggingAsynchronous instance.
+ * @return Pointer to the new MM_VerboseWriterFileLoggingAsynchronous.
+ */
+MM_VerboseWriterFileLoggingAsynchronous *
+MM_VerboseWriterFileLoggingAsynchronous::newInstance(MM_EnvironmentBase *env, MM_VerboseManager *manager, char *filename, uintptr_t numFiles, uintptr_t numCycles)
+{
+	MM_GCExtensionsBase *extensions = MM_GCExtensionsBase::getExtensions(env->getOmrVM());
+
+	MM_VerboseWriterFileLoggingAsynchronous *agent = (MM_VerboseWriterFileLoggingAsynchronous *)extensions->getForge()->allocate(sizeof(MM_VerboseWriterFileLoggingAsynchronous), OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if(agent) {
+		new(agent) MM_VerboseWriterFileLoggingAsynchronous(env, manager);
+		if(!agent->initialize(env, filename, numFiles, numCycles)) {
+			agent->kill(env);
+			agent = NULL;
+		}
+	}
+	return agent;
+}
+
+/**
+ * Initializes the MM_VerboseWriterFileLoggingAsynchronous instance.
+ * The ring and monitor are created before the file is opened, since opening the file starts the flusher.
+ * @return true on success, false otherwise
+ */
+bool
+MM_VerboseWriterFileLoggingAsynchronous::initialize(MM_EnvironmentBase *env, const char *filename, uintptr_t numFiles, uintptr_t numCycles)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+
+	if (NULL == _monitor) {
+		if (0 != omrthread_monitor_init_with_name(&_monitor, 0, "MM_VerboseWriterFileLoggingAsynchronous::monitor")) {
+			return false;
+		}
+	}
+
+	if (NULL == _ring) {
+		_ringSize = ASYNC_VERBOSE_MINIMUM_RING_SIZE;
+		while (_ringSize < extensions->asyncVerboseLoggingBufferSize) {
+			_ringSize <<= 1;
+		}
+		_ring = (uint8_t *)extensions->getForge()->allocate(_ringSize, OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+		if (NULL == _ring) {
+			return false;
+		}
+		memset(_ring, 0, _ringSize);
+		_reserveCursor = 0;
+		_readCursor = 0;
+	}
+
+	return MM_VerboseWriterFileLogging::initialize(env, filename, numFiles, numCycles);
+}
+
+/**
+ * Tear down the structures managed by the MM_VerboseWriterFileLoggingAsynchronous.
+ * Stops the flusher thread and frees the ring.
+ */
+void
+MM_VerboseWriterFileLoggingAsynchronous::tearDown(MM_EnvironmentBase *env)
+{
+	closeFile(env);
+
+	if (NULL != _ring) {
+		env->getExtensions()->getForge()->free(_ring);
+		_ring = NULL;
+	}
+
+	if (NULL != _monitor) {
+		omrthread_monitor_destroy(_monitor);
+		_monitor = NULL;
+	}
+
+	MM_VerboseWriterFileLogging::tearDown(env);
+}
+
+bool
+MM_VerboseWriterFileLoggingAsynchronous::openFile(MM_EnvironmentBase *env, bool printInitializedHeader)
+{
+	bool result = (NULL != _logFileStream) || openLogFile(env, printInitializedHeader);
+	if (result && (FLUSHER_RUNNING != _flusherState)) {
+		/* Without a flusher thread output is written synchronously by outputString() */
+		startFlusher(env);
+	}
+	return result;
+}
+
+void
+MM_VerboseWriterFileLoggingAsynchronous::closeFile(MM_EnvironmentBase *env)
+{
+	stopFlusher(env);
+	closeLogFile(env);
+}
+
+/**
+ * Opens the file to log output to and prints the header.
+ * @return true on sucess, false otherwise
+ */
+bool
+MM_VerboseWriterFileLoggingAsynchronous::openLogFile(MM_EnvironmentBase *env, bool printInitializedHeader)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	MM_GCExtensionsBase* extensions = env->getExtensions();
+	const char* version = omrgc_get_version(env->getOmrVM());
+
+	char *filenameToOpen = expandFilename(env, _currentFile);
+	if (NULL == filenameToOpen) {
+		return false;
+	}
+
+	int32_t openFlags =  EsOpenWrite | EsOpenCreate | _manager->fileOpenMode(env);
+
+	_logFileStream = omrfilestream_open(filenameToOpen, openFlags, 0666);
+	if(NULL == _logFileStream) {
+		char *cursor = filenameToOpen;
+		/**
+		 * This may have failed due to directories in the path not being available.
+		 * Try to create these directories and attempt to open again before failing.
+		 */
+		while ( (cursor = strchr(++cursor, DIR_SEPARATOR)) != NULL ) {
+			*cursor = '\0';
+			omrfile_mkdir(filenameToOpen);
+			*cursor = DIR_SEPARATOR;
+		}
+
+		/* Try again */
+		_logFileStream = omrfilestream_open(filenameToOpen, openFlags, 0666);
+		if (NULL == _logFileStream) {
+			_manager->handleFileOpenError(env, filenameToOpen);
+			extensions->getForge()->free(filenameToOpen);
+			return false;
+		}
+	}
+
+	extensions->getForge()->free(filenameToOpen);
+
+	omrfilestream_printf(_logFileStream, getHeader(env), version);
+	/* Print an Initialized Stanza in new file */
+	if (printInitializedHeader) {
+		MM_VerboseBuffer* buffer = MM_VerboseBuffer::newInstance(env, INITIAL_BUFFER_SIZE);
+		if (NULL != buffer) {
+			_manager->getVerboseHandlerOutput()->outputInitializedStanza(env, buffer);
+			writeToLogFile(env, buffer->contents(), strlen(buffer->contents()));
+			buffer->kill(env);
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Prints the footer and closes the file being logged to.
+ */
+void
+MM_VerboseWriterFileLoggingAsynchronous::closeLogFile(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	if(NULL != _logFileStream) {
+		omrfilestream_write_text(_logFileStream, getFooter(env), strlen(getFooter(env)), J9STR_CODE_PLATFORM_RAW);
+		omrfilestream_write_text(_logFileStream, "\n", strlen("\n"), J9STR_CODE_PLATFORM_RAW);
+		omrfilestream_close(_logFileStream);
+		_logFileStream = NULL;
+	}
+}
+
+void
+MM_VerboseWriterFileLoggingAsynchronous::writeToLogFile(MM_EnvironmentBase *env, const char *string, uintptr_t length)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	if(NULL == _logFileStream) {
+		/**
+		 * Under normal circumstances, new file should be opened during rotation.
+		 * This path works as one backup, in case we failed to open the file,  we'll attempt to open it again before outputting the string.
+		 */
+		openLogFile(env, false);
+	}
+
+	if(NULL != _logFileStream){
+		omrfilestream_write_text(_logFileStream, string, length, J9STR_CODE_PLATFORM_RAW);
+	} else {
+		omrfilestream_write_text(OMRPORT_STREAM_ERR, string, length, J9STR_CODE_PLATFORM_RAW);
+	}
+}
+
+bool
+MM_VerboseWriterFileLoggingAsynchronous::startFlusher(MM_EnvironmentBase *env)
+{
+	omrthread_monitor_enter(_monitor);
+	if ((FLUSHER_NOT_STARTED == _flusherState) || (FLUSHER_TERMINATED == _flusherState)) {
+		_flusherState = FLUSHER_NOT_STARTED;
+		/* Run at minimum priority so that writing the log only consumes otherwise idle cycles */
+		intptr_t forkResult = createThreadWithCategory(&_flusherThread, OMR_OS_STACK_SIZE, J9THREAD_PRIORITY_MIN, 0,
+				verbose_flusher_thread_proc, (void *)this, J9THREAD_CATEGORY_SYSTEM_GC_THREAD);
+		if (0 == forkResult) {
+			while (FLUSHER_NOT_STARTED == _flusherState) {
+				omrthread_monitor_wait(_monitor);
+			}
+		} else {
+			_flusherThread = NULL;
+		}
+	}
+	bool started = (FLUSHER_RUNNING == _flusherState);
+	omrthread_monitor_exit(_monitor);
+
+	return started;
+}
+
+void
+MM_VerboseWriterFileLoggingAsynchronous::signalStarted(bool started)
+{
+	omrthread_monitor_enter(_monitor);
+	_flusherState = started ? FLUSHER_RUNNING : FLUSHER_TERMINATED;
+	omrthread_monitor_notify_all(_monitor);
+	omrthread_monitor_exit(_monitor);
+}
+
+void
+MM_VerboseWriterFileLoggingAsynchronous::stopFlusher(MM_EnvironmentBase *env)
+{
+	if (NULL == _monitor) {
+		return;
+	}
+
+	omrthread_monitor_enter(_monitor);
+	if (FLUSHER_RUNNING == _flusherState) {
+		_flusherState = FLUSHER_SHUTDOWN;
+		omrthread_monitor_notify_all(_monitor);
+		while (FLUSHER_TERMINATED != _flusherState) {
+			omrthread_monitor_wait(_monitor);
+		}
+		_flusherThread = NULL;
+	}
+	omrthread_monitor_exit(_monitor);
+}
+
+void
+MM_VerboseWriterFileLoggingAsynchronous::flusherEntryPoint()
+{
+	signalStarted(true);
+
+	{
+		/* The flusher only does file I/O so it does not attach to the VM */
+		MM_EnvironmentBase env(_omrVM);
+
+		omrthread_monitor_enter(_monitor);
+		while (FLUSHER_RUNNING == _flusherState) {
+			uintptr_t flushRequests = _flushRequests;
+			omrthread_monitor_exit(_monitor);
+
+			drain(&env, 0 != (flushRequests - _flushesCompleted));
+
+			omrthread_monitor_enter(_monitor);
+			if (flushRequests != _flushesCompleted) {
+				_flushesCompleted = flushRequests;
+				omrthread_monitor_notify_all(_monitor);
+			}
+			if ((FLUSHER_RUNNING == _flusherState) && (_flushRequests == _flushesCompleted)) {
+				omrthread_monitor_wait_timed(_monitor, ASYNC_VERBOSE_FLUSH_INTERVAL_MILLIS, 0);
+			}
+		}
+		omrthread_monitor_exit(_monitor);
+
+		/* Nothing reports verbose output while the writer is being closed, so this empties the ring */
+		drain(&env, true);
+	}
+
+	omrthread_monitor_enter(_monitor);
+	_flushesCompleted = _flushRequests;
+	_flusherState = FLUSHER_TERMINATED;
+	omrthread_monitor_notify_all(_monitor);
+	omrthread_exit(_monitor);
+}
+
+void
+MM_VerboseWriterFileLoggingAsynchronous::flushPendingOutput(MM_EnvironmentBase *env)
+{
+	omrthread_monitor_enter(_monitor);
+	if (FLUSHER_RUNNING == _flusherState) {
+		uintptr_t request = ++_flushRequests;
+		omrthread_monitor_notify_all(_monitor);
+		while ((FLUSHER_RUNNING == _flusherState) && ((intptr_t)(request - _flushesCompleted) > 0)) {
+			omrthread_monitor_wait(_monitor);
+		}
+	}
+	omrthread_monitor_exit(_monitor);
+}
+
+void
+MM_VerboseWriterFileLoggingAsynchronous::outputString(MM_EnvironmentBase *env, const char* string)
+{
+	if (FLUSHER_RUNNING == _flusherState) {
+		uintptr_t length = strlen(string);
+		if (0 != length) {
+			publishRecord(RECORD_TEXT, string, length);
+		}
+	} else {
+		writeToLogFile(env, string, strlen(string));
+	}
+}
+
+/**
+ * Rotation is performed by the flusher, in order with the output of the cycle which filled the file.
+ * The initialized stanza of the next file is formatted here since formatting it consumes stanza ids.
+ */
+void
+MM_VerboseWriterFileLoggingAsynchronous::endOfCycle(MM_EnvironmentBase *env)
+{
+	if (FLUSHER_RUNNING != _flusherState) {
+		MM_VerboseWriterFileLogging::endOfCycle(env);
+	} else if ((0 != _numFiles) && (0 != _numCycles)) {
+		_currentCycle = (_currentCycle + 1) % _numCycles;
+		if (0 == _currentCycle) {
+			if (publishRecord(RECORD_ROTATE, NULL, 0)) {
+				MM_VerboseBuffer* buffer = MM_VerboseBuffer::newInstance(env, INITIAL_BUFFER_SIZE);
+				if (NULL != buffer) {
+					_manager->getVerboseHandlerOutput()->outputInitializedStanza(env, buffer);
+					outputString(env, buffer->contents());
+					buffer->kill(env);
+				}
+			} else {
+				MM_AtomicOperations::add(&_deferredRotations, 1);
+			}
+		}
+	}
+
+	/* Hurry the flusher along at the end of each cycle, but never wait for it */
+	if (0 == omrthread_monitor_try_enter(_monitor)) {
+		omrthread_monitor_notify(_monitor);
+		omrthread_monitor_exit(_monitor);
+	}
+}
+
+bool
+MM_VerboseWriterFileLoggingAsynchronous::publishRecord(RecordKind kind, const char *payload, uintptr_t length)
+{
+	uintptr_t size = recordSize(length);
+	uintptr_t offset = 0;
+
+	do {
+		offset = _reserveCursor;
+		if ((offset + size - _readCursor) > _ringSize) {
+			MM_AtomicOperations::add(&_droppedEvents, 1);
+			MM_AtomicOperations::add(&_droppedBytes, length);
+			return false;
+		}
+	} while (offset != MM_AtomicOperations::lockCompareExchange(&_reserveCursor, offset, offset + size));
+
+	if (0 != length) {
+		copyToRing(offset + sizeof(uintptr_t), (const uint8_t *)payload, length);
+	}
+
+	/* Publish the header only once the payload is visible to the flusher */
+	MM_AtomicOperations::storeSync();
+	*recordHeader(offset) = (length << 2) | (uintptr_t)kind;
+
+	return true;
+}
+
+void
+MM_VerboseWriterFileLoggingAsynchronous::drain(MM_EnvironmentBase *env, bool waitForReserved)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	char chunk[512];
+	bool wrote = false;
+
+	while (_readCursor != _reserveCursor) {
+		uintptr_t header = *recordHeader(_readCursor);
+		if (0 == header) {
+			if (!waitForReserved) {
+				/* The producer which reserved this record is still copying it; pick it up on the next pass */
+				break;
+			}
+			omrthread_yield();
+			continue;
+		}
+		MM_AtomicOperations::loadSync();
+
+		uintptr_t length = header >> 2;
+		uintptr_t size = recordSize(length);
+		if (RECORD_ROTATE == (header & 3)) {
+			rotateLogFile(env);
+		} else {
+			/* Records may wrap around the end of the ring, so they are written in chunks */
+			for (uintptr_t written = 0; written < length; ) {
+				uintptr_t count = OMR_MIN(length - written, sizeof(chunk));
+				copyFromRing(_readCursor + sizeof(uintptr_t) + written, (uint8_t *)chunk, count);
+				writeToLogFile(env, chunk, count);
+				written += count;
+			}
+		}
+		wrote = true;
+
+		clearRing(_readCursor, size);
+		/* The zeroed space must be visible before it can be reserved again */
+		MM_AtomicOperations::storeSync();
+		_readCursor += size;
+	}
+
+	uintptr_t deferredRotations = _deferredRotations;
+	if (0 != deferredRotations) {
+		MM_AtomicOperations::subtract(&_deferredRotations, deferredRotations);
+		while (0 != deferredRotations) {
+			rotateLogFile(env);
+			deferredRotations -= 1;
+		}
+		wrote = true;
+	}
+
+	uintptr_t droppedEvents = _droppedEvents;
+	if (droppedEvents != _reportedDroppedEvents) {
+		char comment[128];
+		uintptr_t droppedBytes = _droppedBytes;
+		uintptr_t length = omrstr_printf(comment, sizeof(comment), "<!-- verbose output dropped %zu events (%zu bytes) because the asynchronous buffer was full -->\n",
+				droppedEvents - _reportedDroppedEvents, droppedBytes);
+		writeToLogFile(env, comment, length);
+		_reportedDroppedEvents = droppedEvents;
+		MM_AtomicOperations::subtract(&_droppedBytes, droppedBytes);
+		wrote = true;
+	}
+
+	if (wrote && (NULL != _logFileStream)) {
+		omrfilestream_sync(_logFileStream);
+	}
+}
+
+void
+MM_VerboseWriterFileLoggingAsynchronous::rotateLogFile(MM_EnvironmentBase *env)
+{
+	closeLogFile(env);
+	_currentFile = (_currentFile + 1) % _numFiles;
+	openLogFile(env, false);
+}
+
+void
+MM_VerboseWriterFileLoggingAsynchronous::copyFromRing(uintptr_t offset, uint8_t *destination, uintptr_t length)
+{
+	uintptr_t start = offset & (_ringSize - 1);
+	uintptr_t firstPart = OMR_MIN(length, _ringSize - start);
+	memcpy(destination, _ring + start, firstPart);
+	memcpy(destination + firstPart, _ring, length - firstPart);
+}
+
+void
+MM_VerboseWriterFileLoggingAsynchronous::copyToRing(uintptr_t offset, const uint8_t *source, uintptr_t length)
+{
+	uintptr_t start = offset & (_ringSize - 1);
+	uintptr_t firstPart = OMR_MIN(length, _ringSize - start);
+	memcpy(_ring + start, source, firstPart);
+	memcpy(_ring, source + firstPart, length - firstPart);
+}
+
+void
+MM_VerboseWriterFileLoggingAsynchronous::clearRing(uintptr_t offset, uintptr_t length)
+{
+	uintptr_t start = offset & (_ringSize - 1);
+	uintptr_t firstPart = OMR_MIN(length, _ringSize - start);
+	memset(_ring + start, 0, firstPart);
+	memset(_ring, 0, length - firstPart);
+}
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#if !defined(VERBOSEWRITERFILELOGGINGASYNCHRONOUS_HPP_)
+#define VERBOSEWRITERFILELOGGINGASYNCHRONOUS_HPP_
+
+#include "omrcfg.h"
+#include "omrthread.h"
+
+#include "Math.hpp"
+#include "VerboseWriterFileLogging.hpp"
+
+/**
+ * Output agent which directs verbosegc output to file without doing any I/O on the reporting thread.
+ *
+ * Events are copied into a lock-free ring buffer and written to disk, with file rotation, by a minimum
+ * priority flusher thread. When the ring has no room for an event the event is dropped and counted rather
+ * than blocking the (typically main GC) thread that reported it; drops are noted in the log as a comment.
+ *
+ * Each record in the ring starts on a uintptr_t boundary with a header word holding the payload length and
+ * record kind. A zero header means the record has been reserved but not yet published, so producers fill in
+ * the payload first and publish the header last. The flusher zeroes every record it consumes before releasing
+ * the space, which keeps all unreserved space zero.
+ */
+class MM_VerboseWriterFileLoggingAsynchronous : public MM_VerboseWriterFileLogging
+{
+	/*
+	 * Data members
+	 */
+public:
+	enum FlusherState {
+		FLUSHER_NOT_STARTED = 0, /**< no flusher thread; output is written directly by the reporting thread */
+		FLUSHER_RUNNING, /**< the flusher thread owns the log file */
+		FLUSHER_SHUTDOWN, /**< the flusher thread must drain the ring and exit */
+		FLUSHER_TERMINATED /**< the flusher thread has exited */
+	};
+
+protected:
+private:
+	enum RecordKind {
+		RECORD_TEXT = 1, /**< payload is verbose output */
+		RECORD_ROTATE = 2 /**< the cycle which ended filled the current file */
+	};
+
+	OMRFileStream *_logFileStream; /**< the filestream being written to, owned by the flusher thread while it runs */
+	OMR_VM *_omrVM;
+
+	uint8_t *_ring; /**< record storage */
+	uintptr_t _ringSize; /**< size of _ring in bytes (power of two) */
+	volatile uintptr_t _reserveCursor; /**< monotonic offset of the next record to be reserved by a producer */
+	volatile uintptr_t _readCursor; /**< monotonic offset of the next record to be consumed by the flusher */
+
+	volatile uintptr_t _droppedEvents; /**< events dropped because the ring was full */
+	volatile uintptr_t _droppedBytes; /**< payload bytes of the dropped events */
+	uintptr_t _reportedDroppedEvents; /**< drops already noted in the log by the flusher */
+	volatile uintptr_t _deferredRotations; /**< rotations whose record was dropped, performed by the flusher once the ring has drained */
+
+	omrthread_monitor_t _monitor; /**< protects _flusherState and the flush handshake, and parks the flusher thread */
+	omrthread_t _flusherThread;
+	volatile FlusherState _flusherState;
+	uintptr_t _flushRequests; /**< flushPendingOutput() calls issued */
+	uintptr_t _flushesCompleted; /**< flushPendingOutput() calls satisfied by the flusher */
+
+	/*
+	 * Function members
+	 */
+public:
+	static MM_VerboseWriterFileLoggingAsynchronous *newInstance(MM_EnvironmentBase *env, MM_VerboseManager *manager, char* filename, uintptr_t fileCount, uintptr_t iterations);
+
+	virtual void outputString(MM_EnvironmentBase *env, const char* string);
+
+	virtual void endOfCycle(MM_EnvironmentBase *env);
+
+	/**
+	 * Wait until everything published to the ring before the call has been written to the log.
+	 */
+	virtual void flushPendingOutput(MM_EnvironmentBase *env);
+
+	/**
+	 * @return the number of events dropped because the ring was full
+	 */
+	MMINLINE uintptr_t getDroppedEventCount() const { return _droppedEvents; }
+
+	/**
+	 * Report the attach result of a starting flusher thread to startFlusher().
+	 * @param started true if the thread is ready to consume records
+	 */
+	void signalStarted(bool started);
+
+	/**
+	 * Entry point of the flusher thread.
+	 */
+	void flusherEntryPoint();
+
+protected:
+	MM_VerboseWriterFileLoggingAsynchronous(MM_EnvironmentBase *env, MM_VerboseManager *manager);
+
+	virtual bool initialize(MM_EnvironmentBase *env, const char *filename, uintptr_t numFiles, uintptr_t numCycles);
+
+private:
+	virtual void tearDown(MM_EnvironmentBase *env);
+
+	/**
+	 * Open the log file and start the flusher thread if it is not running.
+	 */
+	bool openFile(MM_EnvironmentBase *env, bool printInitializedHeader = false);
+
+	/**
+	 * Stop the flusher thread, once it has drained the ring, and close the log file.
+	 */
+	void closeFile(MM_EnvironmentBase *env);
+
+	bool openLogFile(MM_EnvironmentBase *env, bool printInitializedHeader);
+	void closeLogFile(MM_EnvironmentBase *env);
+	void writeToLogFile(MM_EnvironmentBase *env, const char *string, uintptr_t length);
+
+	bool startFlusher(MM_EnvironmentBase *env);
+	void stopFlusher(MM_EnvironmentBase *env);
+
+	/**
+	 * Reserve and publish a record. Never blocks: when the ring is full the record is dropped.
+	 * @return true if the record was published
+	 */
+	bool publishRecord(RecordKind kind, const char *payload, uintptr_t length);
+
+	/**
+	 * Write every published record to the log.
+	 * @param waitForReserved if true, wait for records that are reserved but not yet published
+	 */
+	void drain(MM_EnvironmentBase *env, bool waitForReserved);
+
+	void rotateLogFile(MM_EnvironmentBase *env);
+	void copyFromRing(uintptr_t offset, uint8_t *destination, uintptr_t length);
+	void copyToRing(uintptr_t offset, const uint8_t *source, uintptr_t length);
+	void clearRing(uintptr_t offset, uintptr_t length);
+
+	MMINLINE uintptr_t recordSize(uintptr_t length) const { return MM_Math::roundToSizeofUDATA(sizeof(uintptr_t) + length); }
+	MMINLINE uintptr_t *recordHeader(uintptr_t offset) const { return (uintptr_t *)(_ring + (offset & (_ringSize - 1))); }
+};
+
+#endif /* VERBOSEWRITERFILELOGGINGASYNCHRONOUS_HPP_ */
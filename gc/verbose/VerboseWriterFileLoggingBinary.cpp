@@ -0,0 +1,670 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#include "modronapicore.hpp"
+#include "VerboseManager.hpp"
+#include "VerboseWriterFileLoggingBinary.hpp"
+
+#include "GCExtensionsBase.hpp"
+#include "EnvironmentBase.hpp"
+#include "VerboseBinaryFormat.hpp"
+#include "VerboseBuffer.hpp"
+#include "VerboseHandlerOutput.hpp"
+
+#include <string.h>
+
+static MMINLINE bool
+isXMLSpace(char c)
+{
+	return (' ' == c) || ('\n' == c) || ('\r' == c) || ('\t' == c);
+}
+
+static MMINLINE bool
+isDecimalDigit(char c)
+{
+	return ('0' <= c) && ('9' >= c);
+}
+
+static MMINLINE uint32_t
+hashString(const char *string, uintptr_t length)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261U;
+	for (uintptr_t i = 0; i < length; i++) {
+		hash = (hash ^ (uint8_t)string[i]) * 16777619U;
+	}
+	return hash;
+}
+
+static const char *
+findSubstring(const char *cursor, const char *end, const char *pattern)
+{
+	uintptr_t patternLength = strlen(pattern);
+	while ((uintptr_t)(end - cursor) >= patternLength) {
+		if (0 == memcmp(cursor, pattern, patternLength)) {
+			return cursor;
+		}
+		cursor += 1;
+	}
+	return NULL;
+}
+
+MM_VerboseWriterFileLoggingBinary::MM_VerboseWriterFileLoggingBinary(MM_EnvironmentBase *env, MM_VerboseManager *manager)
+	:MM_VerboseWriterFileLogging(env, manager, VERBOSE_WRITER_FILE_LOGGING_BINARY)
+	,_logFileStream(NULL)
+	,_encodeBuffer(NULL)
+	,_encodeBufferSize(0)
+	,_encodeBufferUsed(0)
+	,_outOfMemory(false)
+	,_strings(NULL)
+	,_stringSlots(NULL)
+	,_stringData(NULL)
+	,_stringCount(0)
+	,_stringDataUsed(0)
+{
+	/* No implementation */
+}
+
+/**
+ * Create a new MM_VerboseWriterFileLoggingBinary instance.
+ * @return Pointer to the new MM_VerboseWriterFileLoggingBinary.
+ */
+MM_VerboseWriterFileLoggingBinary *
+MM_VerboseWriterFileLoggingBinary::newInstance(MM_EnvironmentBase *env, MM_VerboseManager *manager, char *filename, uintptr_t numFiles, uintptr_t numCycles)
+{
+	MM_GCExtensionsBase *extensions = MM_GCExtensionsBase::getExtensions(env->getOmrVM());
+
+	MM_VerboseWriterFileLoggingBinary *agent = (MM_VerboseWriterFileLoggingBinary *)extensions->getForge()->allocate(sizeof(MM_VerboseWriterFileLoggingBinary), OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if(agent) {
+		new(agent) MM_VerboseWriterFileLoggingBinary(env, manager);
+		if(!agent->initialize(env, filename, numFiles, numCycles)) {
+			agent->kill(env);
+			agent = NULL;
+		}
+	}
+	return agent;
+}
+
+/**
+ * Initializes the MM_VerboseWriterFileLoggingBinary instance.
+ * The encoding structures are allocated before the superclass opens the first file.
+ * @return true on success, false otherwise
+ */
+bool
+MM_VerboseWriterFileLoggingBinary::initialize(MM_EnvironmentBase *env, const char *filename, uintptr_t numFiles, uintptr_t numCycles)
+{
+	OMR::GC::Forge *forge = env->getExtensions()->getForge();
+
+	_encodeBuffer = (uint8_t *)forge->allocate(INITIAL_ENCODE_BUFFER_SIZE, OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	_strings = (StringEntry *)forge->allocate(MAX_STRINGS * sizeof(StringEntry), OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	_stringSlots = (uint32_t *)forge->allocate(STRING_SLOTS * sizeof(uint32_t), OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	_stringData = (char *)forge->allocate(STRING_DATA_SIZE, OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if ((NULL == _encodeBuffer) || (NULL == _strings) || (NULL == _stringSlots) || (NULL == _stringData)) {
+		return false;
+	}
+	_encodeBufferSize = INITIAL_ENCODE_BUFFER_SIZE;
+	_encodeBufferUsed = 0;
+	resetStringTable();
+
+	return MM_VerboseWriterFileLogging::initialize(env, filename, numFiles, numCycles);
+}
+
+/**
+ * Tear down the structures managed by the MM_VerboseWriterFileLoggingBinary.
+ */
+void
+MM_VerboseWriterFileLoggingBinary::tearDown(MM_EnvironmentBase *env)
+{
+	OMR::GC::Forge *forge = env->getExtensions()->getForge();
+
+	if (NULL != _encodeBuffer) {
+		forge->free(_encodeBuffer);
+		_encodeBuffer = NULL;
+		_encodeBufferSize = 0;
+	}
+	if (NULL != _strings) {
+		forge->free(_strings);
+		_strings = NULL;
+	}
+	if (NULL != _stringSlots) {
+		forge->free(_stringSlots);
+		_stringSlots = NULL;
+	}
+	if (NULL != _stringData) {
+		forge->free(_stringData);
+		_stringData = NULL;
+	}
+	MM_VerboseWriterFileLogging::tearDown(env);
+}
+
+/**
+ * Opens the file to log output to and writes the binary preamble and the header.
+ * @return true on sucess, false otherwise
+ */
+bool
+MM_VerboseWriterFileLoggingBinary::openFile(MM_EnvironmentBase *env, bool printInitializedHeader)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	MM_GCExtensionsBase* extensions = env->getExtensions();
+	const char* version = omrgc_get_version(env->getOmrVM());
+
+	char *filenameToOpen = expandFilename(env, _currentFile);
+	if (NULL == filenameToOpen) {
+		return false;
+	}
+
+	int32_t openFlags =  EsOpenWrite | EsOpenCreate | _manager->fileOpenMode(env);
+
+	_logFileStream = omrfilestream_open(filenameToOpen, openFlags, 0666);
+	if(NULL == _logFileStream) {
+		char *cursor = filenameToOpen;
+		/**
+		 * This may have failed due to directories in the path not being available.
+		 * Try to create these directories and attempt to open again before failing.
+		 */
+		while ( (cursor = strchr(++cursor, DIR_SEPARATOR)) != NULL ) {
+			*cursor = '\0';
+			omrfile_mkdir(filenameToOpen);
+			*cursor = DIR_SEPARATOR;
+		}
+
+		/* Try again */
+		_logFileStream = omrfilestream_open(filenameToOpen, openFlags, 0666);
+		if (NULL == _logFileStream) {
+			_manager->handleFileOpenError(env, filenameToOpen);
+			extensions->getForge()->free(filenameToOpen);
+			return false;
+		}
+	}
+
+	extensions->getForge()->free(filenameToOpen);
+
+	/* Every file (or appended segment) starts a new string table so it can be decoded on its own */
+	resetStringTable();
+	uint8_t preamble[VERBOSE_BINARY_MAGIC_LENGTH + VERBOSE_BINARY_VARINT_MAX_LENGTH];
+	preamble[0] = VERBOSE_BINARY_MAGIC_0;
+	preamble[1] = VERBOSE_BINARY_MAGIC_1;
+	preamble[2] = VERBOSE_BINARY_MAGIC_2;
+	preamble[3] = VERBOSE_BINARY_MAGIC_3;
+	uintptr_t preambleLength = VERBOSE_BINARY_MAGIC_LENGTH + MM_VerboseBinaryFormat::encodeVarint(preamble + VERBOSE_BINARY_MAGIC_LENGTH, VERBOSE_BINARY_SCHEMA_VERSION);
+	omrfilestream_write(_logFileStream, preamble, preambleLength);
+
+	MM_VerboseBuffer* buffer = MM_VerboseBuffer::newInstance(env, INITIAL_BUFFER_SIZE);
+	if (NULL != buffer) {
+		buffer->formatAndOutput(env, 0, getHeader(env), version);
+		/* Print an Initialized Stanza in new file */
+		if (printInitializedHeader) {
+			_manager->getVerboseHandlerOutput()->outputInitializedStanza(env, buffer);
+		}
+		encodeAndWrite(env, buffer->contents());
+		buffer->kill(env);
+	}
+
+	return true;
+}
+
+/**
+ * Writes the footer and closes the file being logged to.
+ */
+void
+MM_VerboseWriterFileLoggingBinary::closeFile(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	if(NULL != _logFileStream) {
+		encodeAndWrite(env, getFooter(env));
+		omrfilestream_close(_logFileStream);
+		_logFileStream = NULL;
+	}
+}
+
+void
+MM_VerboseWriterFileLoggingBinary::outputString(MM_EnvironmentBase *env, const char* string)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	if(NULL == _logFileStream) {
+		/**
+		 * Under normal circumstances, new file should be opened during endOfCycle call.
+		 * This path works as one backup, in case we failed to open the file,  we'll attempt to open it again before outputting the string.
+		 */
+		openFile(env);
+	}
+
+	if(NULL != _logFileStream){
+		encodeAndWrite(env, string);
+	} else {
+		omrfilestream_write_text(OMRPORT_STREAM_ERR, string, strlen(string), J9STR_CODE_PLATFORM_RAW);
+	}
+}
+
+void
+MM_VerboseWriterFileLoggingBinary::encodeAndWrite(MM_EnvironmentBase *env, const char *string)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	uintptr_t length = strlen(string);
+	uintptr_t stringCount = _stringCount;
+
+	_encodeBufferUsed = 0;
+	_outOfMemory = false;
+	if (encode(env, string, string + length)) {
+		omrfilestream_write(_logFileStream, _encodeBuffer, _encodeBufferUsed);
+	} else {
+		/* Forget the strings defined by the discarded records before falling back to a raw record */
+		for (uintptr_t id = stringCount; id < _stringCount; id++) {
+			StringEntry *entry = &_strings[id];
+			uintptr_t slot = hashString(_stringData + entry->offset, entry->length) & (STRING_SLOTS - 1);
+			while ((id + 1) != _stringSlots[slot]) {
+				slot = (slot + 1) & (STRING_SLOTS - 1);
+			}
+			_stringSlots[slot] = 0;
+		}
+		if (stringCount < _stringCount) {
+			_stringDataUsed = _strings[stringCount].offset;
+			_stringCount = stringCount;
+		}
+		writeRecord(env, VERBOSE_BINARY_RECORD_RAW, string, length);
+	}
+	_encodeBufferUsed = 0;
+}
+
+bool
+MM_VerboseWriterFileLoggingBinary::encode(MM_EnvironmentBase *env, const char *cursor, const char *end)
+{
+	while (cursor < end) {
+		while ((cursor < end) && isXMLSpace(*cursor)) {
+			cursor += 1;
+		}
+		if (cursor == end) {
+			break;
+		}
+
+		if ('<' != *cursor) {
+			/* Character data runs to the next tag; surrounding white space is layout and is not kept */
+			const char *textEnd = cursor;
+			while ((textEnd < end) && ('<' != *textEnd)) {
+				textEnd += 1;
+			}
+			const char *next = textEnd;
+			while (isXMLSpace(textEnd[-1])) {
+				textEnd -= 1;
+			}
+			if (!appendRecord(env, VERBOSE_BINARY_RECORD_TEXT, cursor, textEnd - cursor)) {
+				return false;
+			}
+			cursor = next;
+			continue;
+		}
+
+		const char *tagEnd = NULL;
+		bool tokenized = true;
+		if ('?' == cursor[1]) {
+			tagEnd = findSubstring(cursor, end, "?>");
+			if (NULL != tagEnd) {
+				tagEnd += 2;
+				if (!appendRecord(env, VERBOSE_BINARY_RECORD_RAW, cursor, tagEnd - cursor)) {
+					return false;
+				}
+				cursor = tagEnd;
+			} else {
+				tokenized = false;
+			}
+		} else if ((end - cursor >= 4) && (0 == memcmp(cursor, "<!--", 4))) {
+			tagEnd = findSubstring(cursor + 4, end, "-->");
+			if (NULL != tagEnd) {
+				if (!appendRecord(env, VERBOSE_BINARY_RECORD_COMMENT, cursor + 4, tagEnd - (cursor + 4))) {
+					return false;
+				}
+				cursor = tagEnd + 3;
+			} else {
+				tokenized = false;
+			}
+		} else if ('/' == cursor[1]) {
+			const char *name = cursor + 2;
+			tagEnd = (const char *)memchr(name, '>', end - name);
+			const char *nameEnd = tagEnd;
+			if (NULL != nameEnd) {
+				while ((nameEnd > name) && isXMLSpace(nameEnd[-1])) {
+					nameEnd -= 1;
+				}
+			}
+			intptr_t nameId = -1;
+			if ((NULL != nameEnd) && (nameEnd > name)) {
+				nameId = internString(env, name, nameEnd - name);
+			}
+			if (-1 != nameId) {
+				if (!appendByte(env, VERBOSE_BINARY_RECORD_ELEMENT_END) || !appendVarint(env, nameId)) {
+					return false;
+				}
+				cursor = tagEnd + 1;
+			} else {
+				tokenized = false;
+			}
+		} else {
+			const char *tag = cursor + 1;
+			if (encodeStartTag(env, &tag, end)) {
+				cursor = tag;
+			} else {
+				tokenized = false;
+			}
+		}
+
+		if (_outOfMemory) {
+			return false;
+		}
+		if (!tokenized) {
+			/* Markup this encoder does not understand is kept verbatim, up to the end of the stanza */
+			return appendRecord(env, VERBOSE_BINARY_RECORD_RAW, cursor, end - cursor);
+		}
+	}
+
+	return true;
+}
+
+bool
+MM_VerboseWriterFileLoggingBinary::encodeStartTag(MM_EnvironmentBase *env, const char **tagCursor, const char *end)
+{
+	Attribute attributes[MAX_ATTRIBUTES];
+	uintptr_t attributeCount = 0;
+	const char *cursor = *tagCursor;
+	const char *name = cursor;
+	bool isEmpty = false;
+
+	while ((cursor < end) && !isXMLSpace(*cursor) && ('/' != *cursor) && ('>' != *cursor)) {
+		cursor += 1;
+	}
+	uintptr_t nameLength = cursor - name;
+	if (0 == nameLength) {
+		return false;
+	}
+
+	for (;;) {
+		while ((cursor < end) && isXMLSpace(*cursor)) {
+			cursor += 1;
+		}
+		if (cursor == end) {
+			return false;
+		}
+		if ('>' == *cursor) {
+			cursor += 1;
+			break;
+		}
+		if ('/' == *cursor) {
+			if (((cursor + 1) == end) || ('>' != cursor[1])) {
+				return false;
+			}
+			isEmpty = true;
+			cursor += 2;
+			break;
+		}
+		if (MAX_ATTRIBUTES == attributeCount) {
+			return false;
+		}
+
+		Attribute *attribute = &attributes[attributeCount];
+		attribute->name = cursor;
+		while ((cursor < end) && !isXMLSpace(*cursor) && ('=' != *cursor)) {
+			cursor += 1;
+		}
+		attribute->nameLength = cursor - attribute->name;
+		while ((cursor < end) && isXMLSpace(*cursor)) {
+			cursor += 1;
+		}
+		if ((0 == attribute->nameLength) || (cursor == end) || ('=' != *cursor)) {
+			return false;
+		}
+		cursor += 1;
+		while ((cursor < end) && isXMLSpace(*cursor)) {
+			cursor += 1;
+		}
+		if ((cursor == end) || (('"' != *cursor) && ('\'' != *cursor))) {
+			return false;
+		}
+		char quote = *cursor;
+		attribute->value = cursor + 1;
+		const char *valueEnd = (const char *)memchr(attribute->value, quote, end - attribute->value);
+		if (NULL == valueEnd) {
+			return false;
+		}
+		attribute->valueLength = valueEnd - attribute->value;
+		if (('\'' == quote) && (NULL != memchr(attribute->value, '"', attribute->valueLength))) {
+			/* Decoded values are always double quoted */
+			return false;
+		}
+		cursor = valueEnd + 1;
+		attributeCount += 1;
+	}
+
+	/* The tag is well formed: define any new strings, then write the element record */
+	intptr_t nameId = internString(env, name, nameLength);
+	if (-1 == nameId) {
+		return false;
+	}
+	intptr_t attributeNameIds[MAX_ATTRIBUTES];
+	intptr_t valueIds[MAX_ATTRIBUTES];
+	for (uintptr_t i = 0; i < attributeCount; i++) {
+		attributeNameIds[i] = internString(env, attributes[i].name, attributes[i].nameLength);
+		if (-1 == attributeNameIds[i]) {
+			return false;
+		}
+		/* Words such as collection types and reasons recur in every cycle; values with digits rarely do */
+		valueIds[i] = -1;
+		if (MAX_INTERNED_VALUE_LENGTH >= attributes[i].valueLength) {
+			bool isWord = true;
+			for (uintptr_t j = 0; isWord && (j < attributes[i].valueLength); j++) {
+				isWord = !isDecimalDigit(attributes[i].value[j]);
+			}
+			if (isWord) {
+				valueIds[i] = internString(env, attributes[i].value, attributes[i].valueLength);
+			}
+		}
+	}
+
+	uint8_t type = isEmpty ? VERBOSE_BINARY_RECORD_ELEMENT_EMPTY : VERBOSE_BINARY_RECORD_ELEMENT_START;
+	if (!appendByte(env, type) || !appendVarint(env, nameId) || !appendVarint(env, attributeCount)) {
+		return false;
+	}
+	for (uintptr_t i = 0; i < attributeCount; i++) {
+		if (!appendVarint(env, attributeNameIds[i]) || !encodeValue(env, attributes[i].value, attributes[i].valueLength, valueIds[i])) {
+			return false;
+		}
+	}
+
+	*tagCursor = cursor;
+	return true;
+}
+
+bool
+MM_VerboseWriterFileLoggingBinary::encodeValue(MM_EnvironmentBase *env, const char *value, uintptr_t length, intptr_t valueId)
+{
+	if (-1 != valueId) {
+		return appendByte(env, VERBOSE_BINARY_VALUE_STRING_REF) && appendVarint(env, valueId);
+	}
+
+	/* Canonical unsigned integers and fixed point decimals: no sign, no redundant leading zeros */
+	uintptr_t integerDigits = 0;
+	while ((integerDigits < length) && isDecimalDigit(value[integerDigits])) {
+		integerDigits += 1;
+	}
+	if ((0 < integerDigits) && ((1 == integerDigits) || ('0' != value[0]))) {
+		uint64_t scaled = 0;
+		for (uintptr_t i = 0; i < integerDigits; i++) {
+			scaled = (scaled * 10) + (value[i] - '0');
+		}
+		if ((integerDigits == length) && (19 >= integerDigits)) {
+			return appendByte(env, VERBOSE_BINARY_VALUE_UNSIGNED) && appendVarint(env, scaled);
+		}
+		uintptr_t fractionDigits = length - integerDigits - 1;
+		if ((integerDigits < length) && ('.' == value[integerDigits]) && (0 < fractionDigits) && (9 >= fractionDigits) && (18 >= (integerDigits + fractionDigits))) {
+			const char *fraction = value + integerDigits + 1;
+			bool isDecimal = true;
+			for (uintptr_t i = 0; isDecimal && (i < fractionDigits); i++) {
+				isDecimal = isDecimalDigit(fraction[i]);
+				scaled = (scaled * 10) + (fraction[i] - '0');
+			}
+			if (isDecimal) {
+				return appendByte(env, VERBOSE_BINARY_VALUE_DECIMAL) && appendVarint(env, fractionDigits) && appendVarint(env, scaled);
+			}
+		}
+	}
+
+	/* Hexadecimal with a consistent letter case, e.g. addresses and sizes */
+	if ((2 < length) && (18 >= length) && ('0' == value[0]) && ('x' == value[1])) {
+		uint64_t hex = 0;
+		bool hasLower = false;
+		bool hasUpper = false;
+		bool isHex = true;
+		for (uintptr_t i = 2; isHex && (i < length); i++) {
+			char c = value[i];
+			if (isDecimalDigit(c)) {
+				hex = (hex << 4) | (uint64_t)(c - '0');
+			} else if (('a' <= c) && ('f' >= c)) {
+				hex = (hex << 4) | (uint64_t)(c - 'a' + 10);
+				hasLower = true;
+			} else if (('A' <= c) && ('F' >= c)) {
+				hex = (hex << 4) | (uint64_t)(c - 'A' + 10);
+				hasUpper = true;
+			} else {
+				isHex = false;
+			}
+		}
+		if (isHex && !(hasLower && hasUpper)) {
+			uint8_t type = hasUpper ? VERBOSE_BINARY_VALUE_HEX_UPPER : VERBOSE_BINARY_VALUE_HEX;
+			return appendByte(env, type) && appendVarint(env, length - 2) && appendVarint(env, hex);
+		}
+	}
+
+	return appendByte(env, VERBOSE_BINARY_VALUE_STRING) && appendVarint(env, length) && appendBytes(env, value, length);
+}
+
+intptr_t
+MM_VerboseWriterFileLoggingBinary::internString(MM_EnvironmentBase *env, const char *string, uintptr_t length)
+{
+	uintptr_t slot = hashString(string, length) & (STRING_SLOTS - 1);
+	while (0 != _stringSlots[slot]) {
+		uintptr_t id = _stringSlots[slot] - 1;
+		StringEntry *entry = &_strings[id];
+		if ((entry->length == length) && (0 == memcmp(_stringData + entry->offset, string, length))) {
+			return id;
+		}
+		slot = (slot + 1) & (STRING_SLOTS - 1);
+	}
+
+	if ((MAX_STRINGS == _stringCount) || ((STRING_DATA_SIZE - _stringDataUsed) < length)) {
+		return -1;
+	}
+	if (!appendRecord(env, VERBOSE_BINARY_RECORD_STRING, string, length)) {
+		return -1;
+	}
+
+	uintptr_t id = _stringCount;
+	_strings[id].offset = (uint32_t)_stringDataUsed;
+	_strings[id].length = (uint32_t)length;
+	memcpy(_stringData + _stringDataUsed, string, length);
+	_stringDataUsed += length;
+	_stringSlots[slot] = (uint32_t)(id + 1);
+	_stringCount += 1;
+
+	return id;
+}
+
+void
+MM_VerboseWriterFileLoggingBinary::resetStringTable()
+{
+	memset(_stringSlots, 0, STRING_SLOTS * sizeof(uint32_t));
+	_stringCount = 0;
+	_stringDataUsed = 0;
+}
+
+bool
+MM_VerboseWriterFileLoggingBinary::ensureCapacity(MM_EnvironmentBase *env, uintptr_t bytes)
+{
+	if ((_encodeBufferSize - _encodeBufferUsed) >= bytes) {
+		return true;
+	}
+
+	uintptr_t newSize = _encodeBufferSize * 2;
+	while ((newSize - _encodeBufferUsed) < bytes) {
+		newSize *= 2;
+	}
+	OMR::GC::Forge *forge = env->getExtensions()->getForge();
+	uint8_t *newBuffer = (uint8_t *)forge->allocate(newSize, OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if (NULL == newBuffer) {
+		_outOfMemory = true;
+		return false;
+	}
+	memcpy(newBuffer, _encodeBuffer, _encodeBufferUsed);
+	forge->free(_encodeBuffer);
+	_encodeBuffer = newBuffer;
+	_encodeBufferSize = newSize;
+
+	return true;
+}
+
+bool
+MM_VerboseWriterFileLoggingBinary::appendByte(MM_EnvironmentBase *env, uint8_t value)
+{
+	if (!ensureCapacity(env, 1)) {
+		return false;
+	}
+	_encodeBuffer[_encodeBufferUsed++] = value;
+	return true;
+}
+
+bool
+MM_VerboseWriterFileLoggingBinary::appendVarint(MM_EnvironmentBase *env, uint64_t value)
+{
+	if (!ensureCapacity(env, VERBOSE_BINARY_VARINT_MAX_LENGTH)) {
+		return false;
+	}
+	_encodeBufferUsed += MM_VerboseBinaryFormat::encodeVarint(_encodeBuffer + _encodeBufferUsed, value);
+	return true;
+}
+
+bool
+MM_VerboseWriterFileLoggingBinary::appendBytes(MM_EnvironmentBase *env, const void *bytes, uintptr_t length)
+{
+	if (!ensureCapacity(env, length)) {
+		return false;
+	}
+	memcpy(_encodeBuffer + _encodeBufferUsed, bytes, length);
+	_encodeBufferUsed += length;
+	return true;
+}
+
+bool
+MM_VerboseWriterFileLoggingBinary::appendRecord(MM_EnvironmentBase *env, uint8_t type, const char *bytes, uintptr_t length)
+{
+	return appendByte(env, type) && appendVarint(env, length) && appendBytes(env, bytes, length);
+}
+
+void
+MM_VerboseWriterFileLoggingBinary::writeRecord(MM_EnvironmentBase *env, uint8_t type, const char *bytes, uintptr_t length)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	uint8_t header[1 + VERBOSE_BINARY_VARINT_MAX_LENGTH];
+
+	header[0] = type;
+	uintptr_t headerLength = 1 + MM_VerboseBinaryFormat::encodeVarint(header + 1, length);
+	omrfilestream_write(_logFileStream, header, headerLength);
+	omrfilestream_write(_logFileStream, bytes, length);
+}
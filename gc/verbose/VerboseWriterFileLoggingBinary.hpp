@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#if !defined(VERBOSEWRITERFILELOGGINGBINARY_HPP_)
+#define VERBOSEWRITERFILELOGGINGBINARY_HPP_
+
+#include "omrcfg.h"
+
+#include "VerboseWriterFileLogging.hpp"
+
+/**
+ * Output agent which writes verbosegc output to file in the binary format described in
+ * VerboseBinaryFormat.hpp. Element and attribute names and recurring attribute values are
+ * interned in a per file string table and numeric attribute values are stored as varints,
+ * which makes the log several times smaller than the XML it encodes.
+ * Use MM_VerboseBinaryDecoder to turn the log back into XML or CSV.
+ */
+class MM_VerboseWriterFileLoggingBinary : public MM_VerboseWriterFileLogging
+{
+	/*
+	 * Data members
+	 */
+public:
+protected:
+private:
+	/**
+	 * An entry of the string table, naming a range of _stringData.
+	 */
+	struct StringEntry {
+		uint32_t offset; /**< offset of the string in _stringData */
+		uint32_t length; /**< length of the string in bytes */
+	};
+
+	/**
+	 * A parsed attribute of the element being encoded.
+	 */
+	struct Attribute {
+		const char *name; /**< first character of the attribute name */
+		uintptr_t nameLength; /**< length of the attribute name */
+		const char *value; /**< first character of the attribute value, without the quotes */
+		uintptr_t valueLength; /**< length of the attribute value */
+	};
+
+	enum {
+		MAX_STRINGS = 4096, /**< capacity of the string table */
+		STRING_SLOTS = 2 * MAX_STRINGS, /**< size of the open addressed index over the string table */
+		STRING_DATA_SIZE = 64 * 1024, /**< bytes available for interned string contents */
+		MAX_INTERNED_VALUE_LENGTH = 64, /**< longest attribute value considered for interning */
+		MAX_ATTRIBUTES = 64, /**< most attributes an element may have before its stanza is stored as raw text */
+		INITIAL_ENCODE_BUFFER_SIZE = 4096 /**< initial size of the buffer a stanza is encoded into */
+	};
+
+	OMRFileStream *_logFileStream; /**< the filestream being written to */
+
+	uint8_t *_encodeBuffer; /**< the current stanza is encoded here before being written out */
+	uintptr_t _encodeBufferSize; /**< size of _encodeBuffer in bytes */
+	uintptr_t _encodeBufferUsed; /**< bytes of the current stanza in _encodeBuffer */
+	bool _outOfMemory; /**< set when _encodeBuffer could not be grown while encoding the current stanza */
+
+	StringEntry *_strings; /**< the string table, indexed by string id */
+	uint32_t *_stringSlots; /**< hash index over _strings, holding string id + 1 or 0 for an empty slot */
+	char *_stringData; /**< contents of the interned strings */
+	uintptr_t _stringCount; /**< number of strings defined in the current file */
+	uintptr_t _stringDataUsed; /**< bytes of _stringData used by the current file */
+
+	/*
+	 * Function members
+	 */
+public:
+	static MM_VerboseWriterFileLoggingBinary *newInstance(MM_EnvironmentBase *env, MM_VerboseManager *manager, char* filename, uintptr_t fileCount, uintptr_t iterations);
+
+	virtual void outputString(MM_EnvironmentBase *env, const char* string);
+
+protected:
+	MM_VerboseWriterFileLoggingBinary(MM_EnvironmentBase *env, MM_VerboseManager *manager);
+
+	virtual bool initialize(MM_EnvironmentBase *env, const char *filename, uintptr_t numFiles, uintptr_t numCycles);
+
+private:
+	virtual void tearDown(MM_EnvironmentBase *env);
+
+	bool openFile(MM_EnvironmentBase *env, bool printInitializedHeader = false);
+	void closeFile(MM_EnvironmentBase *env);
+
+	/**
+	 * Encode XML text into _encodeBuffer and write it to the file.
+	 * @param[in] env the current environment
+	 * @param[in] string the XML text, one or more complete stanzas
+	 */
+	void encodeAndWrite(MM_EnvironmentBase *env, const char *string);
+
+	/**
+	 * Encode XML text into _encodeBuffer.
+	 * @return false if the encode buffer could not be grown, in which case the caller writes the text as a single raw record instead
+	 */
+	bool encode(MM_EnvironmentBase *env, const char *cursor, const char *end);
+
+	/**
+	 * Encode a start tag, from just past the '<' to just past the closing '>'.
+	 * @param[in,out] cursor the first character of the element name, moved past the tag on success
+	 * @return false if the tag can not be tokenized
+	 */
+	bool encodeStartTag(MM_EnvironmentBase *env, const char **cursor, const char *end);
+
+	/**
+	 * Encode an attribute value, picking the most compact value type which decodes to identical text.
+	 * @param[in] valueId the string id of the value if it has been interned, -1 otherwise
+	 */
+	bool encodeValue(MM_EnvironmentBase *env, const char *value, uintptr_t length, intptr_t valueId);
+
+	/**
+	 * Look up a string in the string table, defining it if it is not there yet.
+	 * @return the string id, or -1 if the string table is full
+	 */
+	intptr_t internString(MM_EnvironmentBase *env, const char *string, uintptr_t length);
+
+	void resetStringTable();
+
+	bool ensureCapacity(MM_EnvironmentBase *env, uintptr_t bytes);
+	bool appendByte(MM_EnvironmentBase *env, uint8_t value);
+	bool appendVarint(MM_EnvironmentBase *env, uint64_t value);
+	bool appendBytes(MM_EnvironmentBase *env, const void *bytes, uintptr_t length);
+	bool appendRecord(MM_EnvironmentBase *env, uint8_t type, const char *bytes, uintptr_t length);
+
+	/**
+	 * Write a record straight to the file, bypassing the encode buffer.
+	 */
+	void writeRecord(MM_EnvironmentBase *env, uint8_t type, const char *bytes, uintptr_t length);
+};
+
+#endif /* VERBOSEWRITERFILELOGGINGBINARY_HPP_ */
@@ -49,6 +49,7 @@ static void verboseHandlerAllocationFailureEnd(J9HookInterface** hook, uintptr_t
 static void verboseHandlerAcquiredExclusiveToSatisfyAllocation(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData);
 static void verboseHandlerMarkEnd(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData);
 static void verboseHandlerSweepEnd(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData);
+static void verboseHandlerHeapUncommit(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData);
 static void verboseHandlerExcessiveGCRaised(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData);
 
 #if defined(OMR_GC_MODRON_COMPACTION)
@@ -59,6 +60,7 @@ static void verboseHandlerCompactEnd(J9HookInterface** hook, uintptr_t eventNum,
 #if defined(OMR_GC_MODRON_SCAVENGER)
 static void verboseHandlerScavengeEnd(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData);
 static void verboseHandlerScavengePercolate(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData);
+static void verboseHandlerNurserySizing(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData);
 
 static void verboseHandlerConcurrentStart(J9HookInterface** hook, UDATA eventNum, void* eventData, void* userData);
 static void verboseHandlerConcurrentEnd(J9HookInterface** hook, UDATA eventNum, void* eventData, void* userData);
@@ -131,6 +133,7 @@ MM_VerboseHandlerOutputStandard::enableVerbose()
 	/* GCOps */
 	(*_mmPrivateHooks)->J9HookRegisterWithCallSite(_mmPrivateHooks, J9HOOK_MM_PRIVATE_MARK_END, verboseHandlerMarkEnd, OMR_GET_CALLSITE(), (void *)this);
 	(*_mmPrivateHooks)->J9HookRegisterWithCallSite(_mmPrivateHooks, J9HOOK_MM_PRIVATE_SWEEP_END, verboseHandlerSweepEnd, OMR_GET_CALLSITE(), (void *)this);
+	(*_mmPrivateHooks)->J9HookRegisterWithCallSite(_mmPrivateHooks, J9HOOK_MM_PRIVATE_HEAP_UNCOMMIT, verboseHandlerHeapUncommit, OMR_GET_CALLSITE(), (void *)this);
 #if defined(OMR_GC_MODRON_COMPACTION)
 
 	(*_mmPrivateHooks)->J9HookRegisterWithCallSite(_mmPrivateHooks, J9HOOK_MM_PRIVATE_COMPACT_START, verboseHandlerCompactStart, OMR_GET_CALLSITE(), (void *)this);
@@ -140,6 +143,7 @@ MM_VerboseHandlerOutputStandard::enableVerbose()
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	(*_mmPrivateHooks)->J9HookRegisterWithCallSite(_mmPrivateHooks, J9HOOK_MM_PRIVATE_SCAVENGE_END, verboseHandlerScavengeEnd, OMR_GET_CALLSITE(), (void *)this);
 	(*_mmPrivateHooks)->J9HookRegisterWithCallSite(_mmPrivateHooks, J9HOOK_MM_PRIVATE_PERCOLATE_COLLECT, verboseHandlerScavengePercolate, OMR_GET_CALLSITE(), (void *)this);
+	(*_mmPrivateHooks)->J9HookRegisterWithCallSite(_mmPrivateHooks, J9HOOK_MM_PRIVATE_NURSERY_SIZING, verboseHandlerNurserySizing, OMR_GET_CALLSITE(), (void *)this);
 
 	(*_mmPrivateHooks)->J9HookRegisterWithCallSite(_mmPrivateHooks, J9HOOK_MM_PRIVATE_CONCURRENT_PHASE_START, verboseHandlerConcurrentStart, OMR_GET_CALLSITE(), this);
 	(*_mmPrivateHooks)->J9HookRegisterWithCallSite(_mmPrivateHooks, J9HOOK_MM_PRIVATE_CONCURRENT_PHASE_END, verboseHandlerConcurrentEnd, OMR_GET_CALLSITE(), this);
@@ -188,6 +192,7 @@ MM_VerboseHandlerOutputStandard::disableVerbose()
 	/* GCOps */
 	(*_mmPrivateHooks)->J9HookUnregister(_mmPrivateHooks, J9HOOK_MM_PRIVATE_MARK_END, verboseHandlerMarkEnd, NULL);
 	(*_mmPrivateHooks)->J9HookUnregister(_mmPrivateHooks, J9HOOK_MM_PRIVATE_SWEEP_END, verboseHandlerSweepEnd, NULL);
+	(*_mmPrivateHooks)->J9HookUnregister(_mmPrivateHooks, J9HOOK_MM_PRIVATE_HEAP_UNCOMMIT, verboseHandlerHeapUncommit, NULL);
 #if defined(OMR_GC_MODRON_COMPACTION)
 
 	(*_mmPrivateHooks)->J9HookUnregister(_mmPrivateHooks, J9HOOK_MM_PRIVATE_COMPACT_START, verboseHandlerCompactStart, NULL);
@@ -197,6 +202,7 @@ MM_VerboseHandlerOutputStandard::disableVerbose()
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	(*_mmPrivateHooks)->J9HookUnregister(_mmPrivateHooks, J9HOOK_MM_PRIVATE_SCAVENGE_END, verboseHandlerScavengeEnd, NULL);
 	(*_mmPrivateHooks)->J9HookUnregister(_mmPrivateHooks, J9HOOK_MM_PRIVATE_PERCOLATE_COLLECT, verboseHandlerScavengePercolate, NULL);
+	(*_mmPrivateHooks)->J9HookUnregister(_mmPrivateHooks, J9HOOK_MM_PRIVATE_NURSERY_SIZING, verboseHandlerNurserySizing, NULL);
 
 	/* Concurrent GMP */
 	(*_mmPrivateHooks)->J9HookUnregister(_mmPrivateHooks, J9HOOK_MM_PRIVATE_CONCURRENT_PHASE_START, verboseHandlerConcurrentStart, NULL);
@@ -297,6 +303,10 @@ MM_VerboseHandlerOutputStandard::handleMarkEnd(J9HookInterface** hook, uintptr_t
 
 	writer->formatAndOutput(env, 1, "<trace-info objectcount=\"%zu\" scancount=\"%zu\" scanbytes=\"%zu\" />",
 			markStats->_objectsMarked, markStats->_objectsScanned, markStats->_bytesScanned);
+	if (0 != markStats->_cacheReferences) {
+		writer->formatAndOutput(env, 1, "<cache-info references=\"%llu\" misses=\"%llu\" missrate=\"%.3f\" />",
+				markStats->_cacheReferences, markStats->_cacheMisses, (double)markStats->_cacheMisses / (double)markStats->_cacheReferences);
+	}
 
 	handleMarkEndInternal(env, eventData);
 
@@ -334,6 +344,32 @@ MM_VerboseHandlerOutputStandard::handleSweepEndInternal(MM_EnvironmentBase* env,
 	/* Empty stub */
 }
 
+void
+MM_VerboseHandlerOutputStandard::handleHeapUncommit(J9HookInterface** hook, uintptr_t eventNum, void* eventData)
+{
+	MM_HeapUncommitEvent* event = (MM_HeapUncommitEvent*)eventData;
+	MM_VerboseManager* manager = getManager();
+	MM_VerboseWriterChain* writer = manager->getWriterChain();
+	MM_EnvironmentBase* env = MM_EnvironmentBase::getEnvironment(event->currentThread);
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+	/* the RSS is sampled while mutators run, so it may have grown in spite of the release */
+	uint64_t rssReclaimed = (event->rssBefore > event->rssAfter) ? (event->rssBefore - event->rssAfter) : 0;
+	char tagTemplate[100];
+
+	enterAtomicReportingBlock();
+	getTagTemplate(tagTemplate, sizeof(tagTemplate), manager->getIdAndIncrement(), omrtime_current_time_millis());
+	writer->formatAndOutput(env, 0, "<heap-uncommit %s>", tagTemplate);
+	writer->formatAndOutput(env, 1, "<released bytes=\"%zu\" batches=\"%zu\" yielded=\"%s\" timems=\"%llu.%03llu\" totalbytes=\"%zu\" />",
+			event->releasedBytes, event->batchCount, (0 != event->yielded) ? "true" : "false",
+			event->time / 1000, event->time % 1000, event->totalReleasedBytes);
+	writer->formatAndOutput(env, 1, "<rss before=\"%llu\" after=\"%llu\" reclaimed=\"%llu\" />", event->rssBefore, event->rssAfter, rssReclaimed);
+	writer->formatAndOutput(env, 1, "<refaulted bytes=\"%zu\" totalbytes=\"%zu\" trackedbytes=\"%zu\" />",
+			event->refaultedBytes, event->totalRefaultedBytes, event->trackedBytes);
+	writer->formatAndOutput(env, 0, "</heap-uncommit>");
+	writer->flush(env);
+	exitAtomicReportingBlock();
+}
+
 #if defined(OMR_GC_MODRON_COMPACTION)
 
 void
@@ -372,6 +408,10 @@ MM_VerboseHandlerOutputStandard::handleCompactEnd(J9HookInterface** hook, uintpt
 	if(COMPACT_PREVENTED_NONE == compactStats->_compactPreventedReason) {
 		writer->formatAndOutput(env, 1, "<compact-info movecount=\"%zu\" movebytes=\"%zu\" reason=\"%s\" />",
 				compactStats->_movedObjects, compactStats->_movedBytes, getCompactionReasonAsString(compactStats->_compactReason));
+		if (0 != compactStats->_incrementSubAreas) {
+			writer->formatAndOutput(env, 1, "<compact-increment subareas=\"%zu\" base=\"%p\" top=\"%p\" freebytes=\"%zu\" movebytes=\"%zu\" />",
+					compactStats->_incrementSubAreas, compactStats->_incrementBase, compactStats->_incrementTop, compactStats->_incrementFreeBytes, compactStats->_movedBytes);
+		}
 	} else {
 		writer->formatAndOutput(env, 1, "<compact-info reason=\"%s\" />", getCompactionReasonAsString(compactStats->_compactReason));
 		writer->formatAndOutput(env, 1, "<warning details=\"compaction prevented due to %s\" />", getCompactionPreventedReasonAsString(compactStats->_compactPreventedReason));
@@ -430,6 +470,17 @@ MM_VerboseHandlerOutputStandard::handleScavengeEndNoLock(J9HookInterface** hook,
 		writer->formatAndOutput(env, 1, "<copy-failed type=\"tenure\" objects=\"%zu\" bytes=\"%zu\" />",
 				scavengerStats->_failedTenureCount, scavengerStats->_failedTenureBytes);
 	}
+	if (extensions->scavengerWorkStealing) {
+		writer->formatAndOutput(env, 1, "<work-stealing attempts=\"%zu\" steals=\"%zu\" />",
+				scavengerStats->_workStealAttemptCount, scavengerStats->_workStealCount);
+	}
+	if (event->cycleEnd && ((0 != cycleScavengerStats->_rememberedSetPruneTime) || (0 != cycleScavengerStats->_rememberedSetConcurrentPruneTime))) {
+		uint64_t pauseMicros = omrtime_hires_delta(0, cycleScavengerStats->_rememberedSetPruneTime, OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+		uint64_t concurrentMicros = omrtime_hires_delta(0, cycleScavengerStats->_rememberedSetConcurrentPruneTime, OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+		writer->formatAndOutput(env, 1, "<remembered-set-prune pausems=\"%llu.%03llu\" pruned=\"%zu\" concurrentms=\"%llu.%03llu\" concurrentpruned=\"%zu\" />",
+				pauseMicros / 1000, pauseMicros % 1000, cycleScavengerStats->_rememberedSetPrunedCount,
+				concurrentMicros / 1000, concurrentMicros % 1000, cycleScavengerStats->_rememberedSetConcurrentPrunedCount);
+	}
 
 	handleScavengeEndInternal(env, eventData);
 	
@@ -517,6 +568,30 @@ MM_VerboseHandlerOutputStandard::handleScavengePercolateInternal(MM_EnvironmentB
 {
 	/* Empty stub */
 }
+
+void
+MM_VerboseHandlerOutputStandard::handleNurserySizing(J9HookInterface** hook, uintptr_t eventNum, void* eventData)
+{
+	MM_NurserySizingEvent *event = (MM_NurserySizingEvent *)eventData;
+	MM_EnvironmentBase* env = MM_EnvironmentBase::getEnvironment(event->currentThread);
+	MM_VerboseManager* manager = getManager();
+	MM_VerboseWriterChain* writer = manager->getWriterChain();
+	const char *action = "none";
+	if (0 < event->resizeAmount) {
+		action = "expand";
+	} else if (0 > event->resizeAmount) {
+		action = "contract";
+	}
+
+	enterAtomicReportingBlock();
+	writer->formatAndOutput(env, manager->getIndentLevel(), "<nursery-sizing reason=\"%s\" action=\"%s\" currentsize=\"%zu\" desiredsize=\"%zu\" survivorratio=\"%.3f\" survivalrate=\"%.3f\" fliprate=\"%.3f\" allocationrate=\"%zu\" pausems=\"%llu.%03llu\" fixedpausems=\"%llu.%03llu\" predictedpausems=\"%llu.%03llu\" targetms=\"%zu\" />",
+			getNurserySizingReasonAsString((NurserySizingReason)event->reason), action, event->currentSize, event->desiredSize, event->survivorSpaceRatio,
+			event->survivalRate, event->flipRate, event->allocationRate,
+			event->pauseTime / 1000, event->pauseTime % 1000, event->fixedPauseTime / 1000, event->fixedPauseTime % 1000,
+			event->predictedPauseTime / 1000, event->predictedPauseTime % 1000, event->pauseTarget);
+	writer->flush(env);
+	exitAtomicReportingBlock();
+}
 #endif /*defined(OMR_GC_MODRON_SCAVENGER) */
 
 #if defined(OMR_GC_MODRON_CONCURRENT_MARK)
@@ -1060,6 +1135,12 @@ verboseHandlerSweepEnd(J9HookInterface** hook, uintptr_t eventNum, void* eventDa
 	((MM_VerboseHandlerOutputStandard *)userData)->handleSweepEnd(hook, eventNum, eventData);
 }
 
+void
+verboseHandlerHeapUncommit(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData)
+{
+	((MM_VerboseHandlerOutputStandard *)userData)->handleHeapUncommit(hook, eventNum, eventData);
+}
+
 #if defined(OMR_GC_MODRON_COMPACTION)
 void
 verboseHandlerCompactStart(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData)
@@ -1087,6 +1168,12 @@ verboseHandlerScavengePercolate(J9HookInterface** hook, uintptr_t eventNum, void
 	((MM_VerboseHandlerOutputStandard *)userData)->handleScavengePercolate(hook, eventNum, eventData);
 }
 
+void
+verboseHandlerNurserySizing(J9HookInterface** hook, uintptr_t eventNum, void* eventData, void* userData)
+{
+	((MM_VerboseHandlerOutputStandard *)userData)->handleNurserySizing(hook, eventNum, eventData);
+}
+
 void
 verboseHandlerConcurrentStart(J9HookInterface** hook, UDATA eventNum, void* eventData, void* userData)
 {
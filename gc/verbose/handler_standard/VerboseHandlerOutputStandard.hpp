@@ -119,6 +119,14 @@ public:
 	 */
 	void handleSweepEnd(J9HookInterface** hook, uintptr_t eventNum, void* eventData);
 
+	/**
+	 * Write verbose stanza for a pass of the heap uncommit service.
+	 * @param hook Hook interface used by the JVM.
+	 * @param eventNum The hook event number.
+	 * @param eventData hook specific event data.
+	 */
+	void handleHeapUncommit(J9HookInterface** hook, uintptr_t eventNum, void* eventData);
+
 #if defined(OMR_GC_MODRON_COMPACTION)
 
 	void handleCompactStart(J9HookInterface** hook, uintptr_t eventNum, void* eventData);
@@ -148,6 +156,14 @@ public:
 	 * @param eventData hook specific event data.
 	 */
 	void handleScavengePercolate(J9HookInterface** hook, uintptr_t eventNum, void* eventData);
+
+	/**
+	 * Write verbose stanza for a nursery sizing model decision.
+	 * @param hook Hook interface used by the JVM.
+	 * @param eventNum The hook event number.
+	 * @param eventData hook specific event data.
+	 */
+	void handleNurserySizing(J9HookInterface** hook, uintptr_t eventNum, void* eventData);
 	
 	virtual void handleConcurrentEndInternal(J9HookInterface** hook, uintptr_t eventNum, void* eventData);
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
@@ -442,6 +442,7 @@ typedef enum {
 	SATISFY_EXPAND,
 	FORCED_NURSERY_CONTRACT,
 	SOFT_MX_CONTRACT,
+	NURSERY_SIZING_MODEL_CONTRACT,
 } ContractReason;
 
 typedef enum {
@@ -454,14 +455,24 @@ typedef enum {
 	SATISFY_COLLECTOR,
 	EXPAND_DESPERATE,
 	FORCED_NURSERY_EXPAND,
-	HINT_PREVIOUS_RUNS
+	HINT_PREVIOUS_RUNS,
+	NURSERY_SIZING_MODEL_EXPAND
 } ExpandReason;
 
+typedef enum {
+	NURSERY_SIZING_WARMING_UP = 1,
+	NURSERY_SIZING_SCAVENGE_RATIO,
+	NURSERY_SIZING_PAUSE_TARGET,
+	NURSERY_SIZING_PAUSE_TARGET_UNREACHABLE,
+	NURSERY_SIZING_SIZE_FIXED
+} NurserySizingReason;
+
 typedef enum {
 	NO_LOA_RESIZE = 1,
 	LOA_EXPAND_HEAP_ALIGNMENT,
 	LOA_EXPAND_FAILED_ALLOCATE,
-	LOA_EXPAND_LAST_RESIZE_REASON = LOA_EXPAND_FAILED_ALLOCATE,
+	LOA_EXPAND_FRAGMENTED,
+	LOA_EXPAND_LAST_RESIZE_REASON = LOA_EXPAND_FRAGMENTED,
 	LOA_CONTRACT_AGGRESSIVE,
 	LOA_CONTRACT_MIN_SOA,
 	LOA_CONTRACT_UNDERUTILIZED,
@@ -0,0 +1,257 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/*
+ * Microbenchmark for final card cleaning.
+ *
+ * A card table is replayed the way the final (stop the world) card cleaning phase walks it: runs of
+ * clean card table words are skipped by the mark map word scanning kernels and dirty cards are claimed
+ * from a shared next card, one batch of contiguous dirty cards per claim, and cleaned. The card table is
+ * either a raw dump of a recorded card table (one byte per card) given on the command line, or a
+ * synthetic table with clusters of dirty cards at several densities.
+ *
+ * The elapsed time and the number of claims are reported for each kernel and batch size; the number of
+ * cards cleaned must agree with the number of dirty cards in the table.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "omr.h"
+#include "omrmodroncore.h"
+#include "omrport.h"
+#include "omrthread.h"
+
+#include "gcBenchmarks.hpp"
+
+#include "AtomicOperations.hpp"
+#include "MarkMapWordScanner.hpp"
+
+#define SYNTHETIC_CARDS ((uintptr_t)16 * 1024 * 1024)
+#define MAX_DIRTY_RUN 64
+#define ITERATIONS 10
+
+static const char *kernelNames[] = { "scalar", "avx2", "avx512" };
+
+/* density of dirty cards in the synthetic card tables, in dirty cards per 1000 cards before clustering */
+static const uintptr_t dirtyCardsPerThousand[] = { 1, 10, 50 };
+
+/* maximum number of contiguous dirty cards claimed at once, 1 being the card at a time behaviour */
+static const uintptr_t batchSizes[] = { 1, 4, 16, 64 };
+
+/**
+ * Walk the card table as final card cleaning does, returning the number of claims made.
+ */
+static uintptr_t
+replayCardTable(MM_MarkMapWordScanner::FindNonEmptyWordFunction findNonEmptyWord, Card *cards, Card *cardsTop, uintptr_t batchSize, uintptr_t *cardsCleaned)
+{
+	volatile uintptr_t nextCard = (uintptr_t)cards;
+	uintptr_t claims = 0;
+	Card *currentCard = cards;
+
+	while (currentCard < cardsTop) {
+		if ((CARD_CLEAN == *currentCard) && (0 == ((uintptr_t)currentCard % sizeof(uintptr_t)))) {
+			uintptr_t *nextSlot = (uintptr_t *)currentCard;
+			if (0 == *nextSlot) {
+				nextSlot = findNonEmptyWord(nextSlot + 1, (uintptr_t *)cardsTop);
+			}
+			currentCard = (Card *)nextSlot;
+			if (currentCard >= cardsTop) {
+				break;
+			}
+		}
+
+		if (0 == (*currentCard & CARD_DIRTY)) {
+			currentCard += 1;
+			continue;
+		}
+
+		Card *dirtyCard = currentCard;
+		Card *lastCardInRun = dirtyCard + OMR_MIN(batchSize, (uintptr_t)(cardsTop - dirtyCard));
+		currentCard += 1;
+		while ((currentCard < lastCardInRun) && (0 != (*currentCard & CARD_DIRTY))) {
+			currentCard += 1;
+		}
+		MM_AtomicOperations::lockCompareExchange(&nextCard, nextCard, (uintptr_t)currentCard);
+		claims += 1;
+
+		for (Card *card = dirtyCard; card < currentCard; card++) {
+			*card = CARD_CLEAN;
+		}
+		*cardsCleaned += (uintptr_t)(currentCard - dirtyCard);
+	}
+
+	return claims;
+}
+
+/**
+ * Populate the card table with clusters of dirty cards at the given density, using a fixed seed so
+ * that every configuration replays the same table.
+ */
+static void
+populateCardTable(Card *cards, uintptr_t cardCount, uintptr_t dirtyPerThousand)
+{
+	uint32_t seed = 0x9E3779B9;
+	uintptr_t averageRun = (MAX_DIRTY_RUN + 1) / 2;
+
+	memset(cards, CARD_CLEAN, cardCount);
+	for (uintptr_t i = 0; i < cardCount; i++) {
+		seed = (seed * 1103515245) + 12345;
+		if (((seed >> 8) % (1000 * averageRun)) < dirtyPerThousand) {
+			uintptr_t runLength = 1 + ((seed >> 4) % MAX_DIRTY_RUN);
+			for (uintptr_t j = 0; (j < runLength) && (i < cardCount); j++, i++) {
+				cards[i] = CARD_DIRTY;
+			}
+		}
+	}
+}
+
+/**
+ * Read a recorded card table, rounding its size up to a whole number of card table words.
+ */
+static Card *
+loadCardTable(OMRPortLibrary *portLibrary, const char *fileName, uintptr_t *cardCount)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	Card *cards = NULL;
+
+	intptr_t fd = omrfile_open(fileName, EsOpenRead, 0);
+	if (-1 != fd) {
+		int64_t fileSize = omrfile_flength(fd);
+		if (0 < fileSize) {
+			uintptr_t size = (uintptr_t)fileSize;
+			uintptr_t paddedSize = (size + sizeof(uintptr_t) - 1) & ~(sizeof(uintptr_t) - 1);
+			cards = (Card *)omrmem_allocate_memory(paddedSize, OMRMEM_CATEGORY_MM);
+			if (NULL != cards) {
+				memset(cards + size, CARD_CLEAN, paddedSize - size);
+				if ((intptr_t)size == omrfile_read(fd, cards, (intptr_t)size)) {
+					*cardCount = paddedSize;
+				} else {
+					omrmem_free_memory(cards);
+					cards = NULL;
+				}
+			}
+		}
+		omrfile_close(fd);
+	}
+
+	return cards;
+}
+
+/**
+ * Replay the card table with every supported kernel and batch size.
+ * @return 0 if every replay cleaned all of the dirty cards, -1 otherwise
+ */
+static int
+replayAll(OMRPortLibrary *portLibrary, const char *tableName, Card *recorded, Card *cards, uintptr_t cardCount)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	int result = 0;
+
+	uintptr_t dirtyCards = 0;
+	for (uintptr_t i = 0; i < cardCount; i++) {
+		if (0 != (recorded[i] & CARD_DIRTY)) {
+			dirtyCards += 1;
+		}
+	}
+
+	uint64_t baselineMicros = 0;
+	for (uintptr_t kernel = MM_MarkMapWordScanner::kernel_scalar; kernel <= MM_MarkMapWordScanner::kernel_avx512; kernel++) {
+		if (!MM_MarkMapWordScanner::isKernelSupported(portLibrary, (MM_MarkMapWordScanner::Kernel)kernel)) {
+			continue;
+		}
+		MM_MarkMapWordScanner::FindNonEmptyWordFunction findNonEmptyWord = MM_MarkMapWordScanner::getKernelFunction((MM_MarkMapWordScanner::Kernel)kernel);
+
+		for (uintptr_t batch = 0; batch < sizeof(batchSizes) / sizeof(batchSizes[0]); batch++) {
+			uintptr_t claims = 0;
+			uint64_t elapsedMicros = 0;
+			for (uintptr_t i = 0; i < ITERATIONS; i++) {
+				uintptr_t cardsCleaned = 0;
+				memcpy(cards, recorded, cardCount);
+				uint64_t startTime = omrtime_hires_clock();
+				claims = replayCardTable(findNonEmptyWord, cards, cards + cardCount, batchSizes[batch], &cardsCleaned);
+				elapsedMicros += omrtime_hires_delta(startTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+				if (dirtyCards != cardsCleaned) {
+					fprintf(stderr, "%s kernel with batch size %zu cleaned %zu cards, table has %zu dirty cards\n",
+						kernelNames[kernel], (size_t)batchSizes[batch], (size_t)cardsCleaned, (size_t)dirtyCards);
+					result = -1;
+				}
+			}
+
+			if ((MM_MarkMapWordScanner::kernel_scalar == kernel) && (0 == batch)) {
+				baselineMicros = elapsedMicros;
+			}
+
+			printf("table=%-12s dirty=%9zu kernel=%-6s batch=%2zu claims=%9zu time=%8lluus speedup=%.2f\n",
+				tableName, (size_t)dirtyCards, kernelNames[kernel], (size_t)batchSizes[batch], (size_t)claims,
+				(unsigned long long)(elapsedMicros / ITERATIONS),
+				(0 == elapsedMicros) ? 0.0 : ((double)baselineMicros / (double)elapsedMicros));
+		}
+	}
+
+	return result;
+}
+
+int
+cardTableReplayBenchmark(OMRPortLibrary *portLibrary, int argc, char *argv[])
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	int result = 0;
+
+	if (0 < argc) {
+		/* replay each recorded card table given on the command line */
+		for (int arg = 0; arg < argc; arg++) {
+			uintptr_t cardCount = 0;
+			Card *recorded = loadCardTable(portLibrary, argv[arg], &cardCount);
+			Card *cards = (NULL == recorded) ? NULL : (Card *)omrmem_allocate_memory(cardCount, OMRMEM_CATEGORY_MM);
+			if (NULL == cards) {
+				fprintf(stderr, "Failed to load card table %s\n", argv[arg]);
+				result = -1;
+			} else if (0 != replayAll(portLibrary, argv[arg], recorded, cards, cardCount)) {
+				result = -1;
+			}
+			omrmem_free_memory(cards);
+			omrmem_free_memory(recorded);
+		}
+	} else {
+		Card *recorded = (Card *)omrmem_allocate_memory(SYNTHETIC_CARDS, OMRMEM_CATEGORY_MM);
+		Card *cards = (Card *)omrmem_allocate_memory(SYNTHETIC_CARDS, OMRMEM_CATEGORY_MM);
+		if ((NULL == recorded) || (NULL == cards)) {
+			fprintf(stderr, "Failed to allocate %zu card card table\n", (size_t)SYNTHETIC_CARDS);
+			result = -1;
+		} else {
+			for (uintptr_t density = 0; density < sizeof(dirtyCardsPerThousand) / sizeof(dirtyCardsPerThousand[0]); density++) {
+				char tableName[32];
+				populateCardTable(recorded, SYNTHETIC_CARDS, dirtyCardsPerThousand[density]);
+				omrstr_printf(tableName, sizeof(tableName), "synthetic%zu", (size_t)dirtyCardsPerThousand[density]);
+				if (0 != replayAll(portLibrary, tableName, recorded, cards, SYNTHETIC_CARDS)) {
+					result = -1;
+				}
+			}
+		}
+		omrmem_free_memory(cards);
+		omrmem_free_memory(recorded);
+	}
+
+
+	return result;
+}
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/*
+ * Driver for the collector microbenchmarks.
+ *
+ * Usage: omrperfgcbench [<benchmark> [<benchmark arguments>]]
+ *
+ * With no arguments every benchmark is run with its default inputs. A benchmark named on the
+ * command line is run alone and is given the remaining arguments (for example the card table
+ * replay benchmark takes recorded card table files).
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "omr.h"
+#include "omrport.h"
+#include "omrthread.h"
+
+#include "gcBenchmarks.hpp"
+
+typedef struct GCBenchmark {
+	const char *name;
+	GCBenchmarkFunction function;
+} GCBenchmark;
+
+static const GCBenchmark benchmarks[] = {
+	{ "markmapscan", markMapScanBenchmark },
+	{ "cardtablereplay", cardTableReplayBenchmark },
+	{ "sparseheap", sparseHeapBenchmark },
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	{ "hotfieldcopy", hotFieldCopyBenchmark },
+#endif /* OMR_GC_MODRON_SCAVENGER */
+};
+
+#define BENCHMARK_COUNT (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+int
+main(int argc, char *argv[])
+{
+	const GCBenchmark *selected = NULL;
+	if (1 < argc) {
+		for (uintptr_t i = 0; i < BENCHMARK_COUNT; i++) {
+			if (0 == strcmp(argv[1], benchmarks[i].name)) {
+				selected = &benchmarks[i];
+				break;
+			}
+		}
+		if (NULL == selected) {
+			fprintf(stderr, "Usage: %s [<benchmark> [<benchmark arguments>]]\nBenchmarks:", argv[0]);
+			for (uintptr_t i = 0; i < BENCHMARK_COUNT; i++) {
+				fprintf(stderr, " %s", benchmarks[i].name);
+			}
+			fprintf(stderr, "\n");
+			return 1;
+		}
+	}
+
+	OMRPortLibrary portLibrary;
+	intptr_t rc = omrthread_attach_ex(NULL, J9THREAD_ATTR_DEFAULT);
+	if (0 != rc) {
+		fprintf(stderr, "omrthread_attach_ex(NULL, J9THREAD_ATTR_DEFAULT) failed, rc=%d\n", (int)rc);
+		return -1;
+	}
+
+	rc = omrport_init_library(&portLibrary, sizeof(OMRPortLibrary));
+	if (0 != rc) {
+		fprintf(stderr, "omrport_init_library(&portLibrary, sizeof(OMRPortLibrary)), rc=%d\n", (int)rc);
+		omrthread_detach(NULL);
+		return -1;
+	}
+
+	int result = 0;
+	if (NULL != selected) {
+		result = selected->function(&portLibrary, argc - 2, argv + 2);
+	} else {
+		for (uintptr_t i = 0; i < BENCHMARK_COUNT; i++) {
+			printf("== %s\n", benchmarks[i].name);
+			fflush(stdout);
+			if (0 != benchmarks[i].function(&portLibrary, 0, argv + argc)) {
+				fprintf(stderr, "%s benchmark failed\n", benchmarks[i].name);
+				result = -1;
+			}
+		}
+	}
+
+	portLibrary.port_shutdown_library(&portLibrary);
+	omrthread_detach(NULL);
+
+	return result;
+}
@@ -0,0 +1,46 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+#if !defined(GCBENCHMARKS_HPP_INCLUDED)
+#define GCBENCHMARKS_HPP_INCLUDED
+
+#include "omrcfg.h"
+#include "omrport.h"
+
+/**
+ * Entry point of one collector benchmark.
+ *
+ * @param portLibrary the port library of the benchmark driver
+ * @param argc number of benchmark specific arguments
+ * @param argv benchmark specific arguments
+ * @return 0 on success, non-zero if the benchmark failed or found a result mismatch
+ */
+typedef int (*GCBenchmarkFunction)(OMRPortLibrary *portLibrary, int argc, char *argv[]);
+
+int markMapScanBenchmark(OMRPortLibrary *portLibrary, int argc, char *argv[]);
+int cardTableReplayBenchmark(OMRPortLibrary *portLibrary, int argc, char *argv[]);
+int sparseHeapBenchmark(OMRPortLibrary *portLibrary, int argc, char *argv[]);
+#if defined(OMR_GC_MODRON_SCAVENGER)
+int hotFieldCopyBenchmark(OMRPortLibrary *portLibrary, int argc, char *argv[]);
+#endif /* OMR_GC_MODRON_SCAVENGER */
+
+#endif /* GCBENCHMARKS_HPP_INCLUDED */
@@ -0,0 +1,337 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/*
+ * Benchmark for hot field learning in the scavenger.
+ *
+ * A graph of parents, each holding one hot and several cold children, is built in the nursery with the hot children
+ * allocated last, far from their parents. The mutator walks the graph, dereferencing the hot child of every parent
+ * and occasionally a cold one, and reports each dereference with OMR_GC_SampleHotFieldDereference(). Garbage is then
+ * allocated to drive scavenges, and the walk is timed again to measure mutator throughput after the objects have been
+ * copied. The run is repeated with scavengerLearnHotFields disabled and enabled; with learning the scavenger depth
+ * copies each hot child next to its parent.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include "omr.h"
+#include "omrgc.h"
+#include "omrport.h"
+#include "omrthread.h"
+#include "omrvm.h"
+
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "ObjectAllocationModel.hpp"
+#include "omrExampleVM.hpp"
+#include "omrgcstartup.hpp"
+#include "SlotObject.hpp"
+#include "StandardWriteBarrier.hpp"
+#include "StartupManagerImpl.hpp"
+
+#include "gcBenchmarks.hpp"
+
+#define SPINE_COUNT 127 /* slots of the root object, each holding a spine */
+#define PARENTS_PER_SPINE 511
+#define PARENT_SLOTS 7
+#define CHILD_SLOTS 3
+#define HOT_SLOT 5 /* slot of the parent holding the hot child */
+#define COLD_WALK_INTERVAL 16 /* one parent in this many also has a cold child dereferenced */
+#define GARBAGE_SLOTS 63
+#define LEARNING_WALKS 4
+#define TIMED_WALKS 20
+#define NURSERY_SIZE ((uintptr_t)128 * 1024 * 1024)
+#define TENURE_SIZE ((uintptr_t)128 * 1024 * 1024)
+
+/**
+ * Starts a generational collector using dynamic breadth first scan ordering, with or without hot field learning.
+ */
+class MM_HotFieldBenchmarkStartupManager : public MM_StartupManagerImpl
+{
+private:
+	bool _learnHotFields;
+
+public:
+	virtual bool
+	parseLanguageOptions(MM_GCExtensionsBase *extensions)
+	{
+		extensions->scavengerEnabled = true;
+		extensions->scavengerScanOrdering = MM_GCExtensionsBase::OMR_GC_SCAVENGER_SCANORDERING_DYNAMIC_BREADTH_FIRST;
+		extensions->scavengerLearnHotFields = _learnHotFields;
+		extensions->initialMemorySize = NURSERY_SIZE + TENURE_SIZE;
+		extensions->memoryMax = NURSERY_SIZE + TENURE_SIZE;
+		extensions->maxSizeDefaultMemorySpace = NURSERY_SIZE + TENURE_SIZE;
+		extensions->minNewSpaceSize = NURSERY_SIZE;
+		extensions->newSpaceSize = NURSERY_SIZE;
+		extensions->maxNewSpaceSize = NURSERY_SIZE;
+		extensions->minOldSpaceSize = TENURE_SIZE;
+		extensions->oldSpaceSize = TENURE_SIZE;
+		extensions->maxOldSpaceSize = TENURE_SIZE;
+		return true;
+	}
+
+	MM_HotFieldBenchmarkStartupManager(OMR_VM *omrVM, bool learnHotFields)
+		: MM_StartupManagerImpl(omrVM)
+		, _learnHotFields(learnHotFields)
+	{
+	}
+};
+
+static omrobjectptr_t
+allocateObject(OMR_VMThread *omrVMThread, uintptr_t slots)
+{
+	MM_ObjectAllocationModel allocationModel(MM_EnvironmentBase::getEnvironment(omrVMThread), (slots + 1) * sizeof(fomrobject_t), 0);
+	return OMR_GC_AllocateObject(omrVMThread, &allocationModel);
+}
+
+static MMINLINE fomrobject_t *
+slotAddress(omrobjectptr_t objectPtr, uintptr_t slot)
+{
+	return (fomrobject_t *)objectPtr + 1 + slot;
+}
+
+static MMINLINE omrobjectptr_t
+readSlot(OMR_VM *omrVM, omrobjectptr_t objectPtr, uintptr_t slot)
+{
+	GC_SlotObject slotObject(omrVM, slotAddress(objectPtr, slot));
+	return slotObject.readReferenceFromSlot();
+}
+
+static MMINLINE void
+writeSlot(OMR_VMThread *omrVMThread, omrobjectptr_t objectPtr, uintptr_t slot, omrobjectptr_t value)
+{
+	standardWriteBarrierStore(omrVMThread, objectPtr, slotAddress(objectPtr, slot), value);
+}
+
+/**
+ * Allocate a child for the given slot of every parent. Objects move when an allocation scavenges, so the graph is
+ * always reached again from the root entry.
+ */
+static bool
+allocateChildren(OMR_VMThread *omrVMThread, RootEntry *rootEntry, uintptr_t slot)
+{
+	OMR_VM *omrVM = omrVMThread->_vm;
+	for (uintptr_t spine = 0; spine < SPINE_COUNT; spine++) {
+		for (uintptr_t parent = 0; parent < PARENTS_PER_SPINE; parent++) {
+			omrobjectptr_t child = allocateObject(omrVMThread, CHILD_SLOTS);
+			if (NULL == child) {
+				return false;
+			}
+			omrobjectptr_t parentPtr = readSlot(omrVM, readSlot(omrVM, rootEntry->rootPtr, spine), parent);
+			writeSlot(omrVMThread, parentPtr, slot, child);
+		}
+	}
+	return true;
+}
+
+static bool
+buildGraph(OMR_VMThread *omrVMThread, RootEntry *rootEntry)
+{
+	OMR_VM *omrVM = omrVMThread->_vm;
+	for (uintptr_t spine = 0; spine < SPINE_COUNT; spine++) {
+		omrobjectptr_t spinePtr = allocateObject(omrVMThread, PARENTS_PER_SPINE);
+		if (NULL == spinePtr) {
+			return false;
+		}
+		writeSlot(omrVMThread, rootEntry->rootPtr, spine, spinePtr);
+	}
+	for (uintptr_t spine = 0; spine < SPINE_COUNT; spine++) {
+		for (uintptr_t parent = 0; parent < PARENTS_PER_SPINE; parent++) {
+			omrobjectptr_t parentPtr = allocateObject(omrVMThread, PARENT_SLOTS);
+			if (NULL == parentPtr) {
+				return false;
+			}
+			writeSlot(omrVMThread, readSlot(omrVM, rootEntry->rootPtr, spine), parent, parentPtr);
+		}
+	}
+	/* hot children last, so that allocation order keeps them away from their parents */
+	for (uintptr_t slot = 0; slot < PARENT_SLOTS; slot++) {
+		if ((HOT_SLOT != slot) && !allocateChildren(omrVMThread, rootEntry, slot)) {
+			return false;
+		}
+	}
+	return allocateChildren(omrVMThread, rootEntry, HOT_SLOT);
+}
+
+/**
+ * Walk the graph as the mutator would, touching the header of each child dereferenced.
+ */
+static uintptr_t
+walkGraph(OMR_VMThread *omrVMThread, RootEntry *rootEntry, bool sample)
+{
+	OMR_VM *omrVM = omrVMThread->_vm;
+	uintptr_t checksum = 0;
+	for (uintptr_t spine = 0; spine < SPINE_COUNT; spine++) {
+		omrobjectptr_t spinePtr = readSlot(omrVM, rootEntry->rootPtr, spine);
+		for (uintptr_t parent = 0; parent < PARENTS_PER_SPINE; parent++) {
+			omrobjectptr_t parentPtr = readSlot(omrVM, spinePtr, parent);
+			omrobjectptr_t hotChild = readSlot(omrVM, parentPtr, HOT_SLOT);
+			checksum += (uintptr_t)hotChild->header.raw();
+			if (sample) {
+				OMR_GC_SampleHotFieldDereference(omrVMThread, parentPtr, slotAddress(parentPtr, HOT_SLOT));
+			}
+			if (0 == (parent % COLD_WALK_INTERVAL)) {
+				uintptr_t coldSlot = (spine + parent) % (PARENT_SLOTS - 1);
+				omrobjectptr_t coldChild = readSlot(omrVM, parentPtr, coldSlot);
+				checksum += (uintptr_t)coldChild->header.raw();
+				if (sample) {
+					OMR_GC_SampleHotFieldDereference(omrVMThread, parentPtr, slotAddress(parentPtr, coldSlot));
+				}
+			}
+		}
+	}
+	return checksum;
+}
+
+/**
+ * Run the benchmark for one setting of scavengerLearnHotFields.
+ * @return elapsed time of the timed walks in microseconds, or 0 on failure
+ */
+static uint64_t
+runBenchmark(OMR_VM_Example *exampleVM, bool learnHotFields)
+{
+	OMRPORT_ACCESS_FROM_OMRVM(exampleVM->_omrVM);
+	MM_HotFieldBenchmarkStartupManager startupManager(exampleVM->_omrVM, learnHotFields);
+	uint64_t elapsedMicros = 0;
+
+	omr_error_t rc = OMR_GC_IntializeHeapAndCollector(exampleVM->_omrVM, &startupManager);
+	if (OMR_ERROR_NONE != rc) {
+		fprintf(stderr, "OMR_GC_IntializeHeapAndCollector failed, rc=%d\n", (int)rc);
+		return 0;
+	}
+	rc = OMR_Thread_Init(exampleVM->_omrVM, NULL, &exampleVM->_omrVMThread, "HotFieldBenchmark");
+	if (OMR_ERROR_NONE != rc) {
+		fprintf(stderr, "OMR_Thread_Init failed, rc=%d\n", (int)rc);
+		OMR_GC_ShutdownHeapAndCollector(exampleVM->_omrVM);
+		return 0;
+	}
+	OMR_VMThread *omrVMThread = exampleVM->_omrVMThread;
+	rc = OMR_GC_InitializeDispatcherThreads(omrVMThread);
+
+	exampleVM->rootTable = hashTableNew(
+			exampleVM->_omrVM->_runtime->_portLibrary, OMR_GET_CALLSITE(), 0, sizeof(RootEntry), 0, 0, OMRMEM_CATEGORY_MM,
+			rootTableHashFn, rootTableHashEqualFn, NULL, NULL);
+
+	RootEntry *rootEntry = NULL;
+	if ((OMR_ERROR_NONE == rc) && (NULL != exampleVM->rootTable)) {
+		RootEntry entry = { "hotFieldBenchmarkRoot", allocateObject(omrVMThread, SPINE_COUNT) };
+		if (NULL != entry.rootPtr) {
+			rootEntry = (RootEntry *)hashTableAdd(exampleVM->rootTable, &entry);
+		}
+	}
+
+	if ((NULL != rootEntry) && buildGraph(omrVMThread, rootEntry)) {
+		MM_GCExtensionsBase *extensions = MM_GCExtensionsBase::getExtensions(exampleVM->_omrVM);
+		uintptr_t checksum = 0;
+		for (uintptr_t i = 0; i < LEARNING_WALKS; i++) {
+			checksum += walkGraph(omrVMThread, rootEntry, true);
+		}
+
+		/* drive the copying of the graph by filling the nursery with garbage a few times over */
+		uintptr_t scavengeCountBefore = extensions->scavengerStats._gcCount;
+		uintptr_t garbageBytes = 0;
+		while (garbageBytes < (3 * NURSERY_SIZE)) {
+			if (NULL == allocateObject(omrVMThread, GARBAGE_SLOTS)) {
+				break;
+			}
+			garbageBytes += (GARBAGE_SLOTS + 1) * sizeof(fomrobject_t);
+		}
+		uintptr_t scavengeCount = extensions->scavengerStats._gcCount - scavengeCountBefore;
+
+		uint64_t startTime = omrtime_hires_clock();
+		for (uintptr_t i = 0; i < TIMED_WALKS; i++) {
+			checksum += walkGraph(omrVMThread, rootEntry, false);
+		}
+		elapsedMicros = omrtime_hires_delta(startTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+		if (0 == elapsedMicros) {
+			elapsedMicros = 1;
+		}
+
+		uintptr_t walkedObjects = (uintptr_t)TIMED_WALKS * SPINE_COUNT * PARENTS_PER_SPINE;
+		printf("learnHotFields=%-5s scavenges=%3zu walk=%8llums %.2f ns/parent (checksum %zx)\n",
+			learnHotFields ? "true" : "false", (size_t)scavengeCount, (unsigned long long)(elapsedMicros / 1000),
+			((double)elapsedMicros * 1000.0) / (double)walkedObjects, (size_t)checksum);
+	} else {
+		fprintf(stderr, "Failed to build the benchmark object graph (learnHotFields=%s)\n", learnHotFields ? "true" : "false");
+	}
+
+	if (NULL != exampleVM->rootTable) {
+		hashTableFree(exampleVM->rootTable);
+		exampleVM->rootTable = NULL;
+	}
+	OMR_GC_ShutdownDispatcherThreads(omrVMThread);
+	OMR_Thread_Free(omrVMThread);
+	exampleVM->_omrVMThread = NULL;
+	OMR_GC_ShutdownHeapAndCollector(exampleVM->_omrVM);
+
+	return elapsedMicros;
+}
+
+int
+hotFieldCopyBenchmark(OMRPortLibrary *portLibrary, int argc, char *argv[])
+{
+	/* the collector under test runs in its own VM, which brings up its own port library */
+	OMR_VM_Example exampleVM;
+	exampleVM._omrVM = NULL;
+	exampleVM._omrVMThread = NULL;
+	exampleVM.rootTable = NULL;
+	exampleVM.objectTable = NULL;
+	exampleVM._vmAccessMutex = NULL;
+	exampleVM._vmExclusiveAccessCount = 0;
+
+	intptr_t irc = omrthread_attach_ex(&exampleVM.self, J9THREAD_ATTR_DEFAULT);
+	if (0 != irc) {
+		fprintf(stderr, "omrthread_attach_ex(&exampleVM.self, J9THREAD_ATTR_DEFAULT) failed, rc=%d\n", (int)irc);
+		return -1;
+	}
+
+	omr_error_t rc = OMR_Initialize(&exampleVM, &exampleVM._omrVM);
+	if (OMR_ERROR_NONE != rc) {
+		fprintf(stderr, "OMR_Initialize failed, rc=%d\n", (int)rc);
+		omrthread_detach(exampleVM.self);
+		return -1;
+	}
+	omrthread_rwmutex_init(&exampleVM._vmAccessMutex, 0, "VM exclusive access");
+
+	uint64_t baselineMicros = runBenchmark(&exampleVM, false);
+	uint64_t learnedMicros = runBenchmark(&exampleVM, true);
+	int result = 0;
+	if ((0 == baselineMicros) || (0 == learnedMicros)) {
+		result = -1;
+	} else {
+		printf("post-GC mutator walk speedup with learned hot fields: %.2f\n", (double)baselineMicros / (double)learnedMicros);
+	}
+
+	omrthread_rwmutex_destroy(exampleVM._vmAccessMutex);
+	exampleVM._vmAccessMutex = NULL;
+	omrthread_detach(exampleVM.self);
+	OMR_Shutdown(exampleVM._omrVM);
+
+	return result;
+}
+
+#endif /* OMR_GC_MODRON_SCAVENGER */
@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/*
+ * Microbenchmark for the sweep mark map scanning kernels.
+ *
+ * A mark map is populated with live objects at several densities and each kernel supported by the
+ * processor walks it the way sweep does, skipping runs of empty words. The elapsed time and the
+ * number of runs found are reported for each kernel; the runs found, and where each of them ends,
+ * must agree with the scalar kernel.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "omr.h"
+#include "omrport.h"
+#include "omrthread.h"
+
+#include "gcBenchmarks.hpp"
+
+#include "MarkMapWordScanner.hpp"
+
+#define MARK_MAP_WORDS ((uintptr_t)16 * 1024 * 1024)
+#define ITERATIONS 10
+
+static const char *kernelNames[] = { "scalar", "avx2", "avx512" };
+
+/* live words per 1000 words of mark map, from an almost empty heap to a half live one */
+static const uintptr_t liveWordsPerThousand[] = { 1, 10, 100, 500 };
+
+/**
+ * Walk the mark map as sweep does, returning the number of runs of empty words found.
+ * The word offset at which each run ends is folded into positionHash, so that kernels which
+ * find the same number of runs in different places are told apart.
+ */
+static uintptr_t
+walkMarkMap(MM_MarkMapWordScanner::FindNonEmptyWordFunction findNonEmptyWord, uintptr_t *markMap, uintptr_t *markMapTop, uint64_t *positionHash)
+{
+	uintptr_t runs = 0;
+	uint64_t hash = 0;
+	uintptr_t *current = markMap;
+
+	while (current < markMapTop) {
+		if (0 == *current) {
+			current = findNonEmptyWord(current + 1, markMapTop);
+			runs += 1;
+			hash = (hash * J9CONST64(0x100000001B3)) ^ (uint64_t)(current - markMap);
+		} else {
+			current += 1;
+		}
+	}
+
+	*positionHash = hash;
+	return runs;
+}
+
+/**
+ * Populate the mark map with non-empty words at the given density, using a fixed seed so that
+ * every kernel walks the same map.
+ */
+static void
+populateMarkMap(uintptr_t *markMap, uintptr_t words, uintptr_t livePerThousand)
+{
+	uint32_t seed = 0x9E3779B9;
+
+	memset(markMap, 0, words * sizeof(uintptr_t));
+	for (uintptr_t i = 0; i < words; i++) {
+		seed = (seed * 1103515245) + 12345;
+		if (((seed >> 8) % 1000) < livePerThousand) {
+			markMap[i] = (uintptr_t)1 << (seed & 0x1F);
+		}
+	}
+}
+
+int
+markMapScanBenchmark(OMRPortLibrary *portLibrary, int argc, char *argv[])
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+
+	uintptr_t *markMap = (uintptr_t *)omrmem_allocate_memory(MARK_MAP_WORDS * sizeof(uintptr_t), OMRMEM_CATEGORY_MM);
+	if (NULL == markMap) {
+		fprintf(stderr, "Failed to allocate %zu word mark map\n", (size_t)MARK_MAP_WORDS);
+		return -1;
+	}
+	uintptr_t *markMapTop = markMap + MARK_MAP_WORDS;
+	int result = 0;
+
+	for (uintptr_t density = 0; density < sizeof(liveWordsPerThousand) / sizeof(liveWordsPerThousand[0]); density++) {
+		populateMarkMap(markMap, MARK_MAP_WORDS, liveWordsPerThousand[density]);
+
+		uintptr_t expectedRuns = 0;
+		uint64_t expectedPositionHash = 0;
+		uint64_t scalarMillis = 0;
+		for (uintptr_t kernel = MM_MarkMapWordScanner::kernel_scalar; kernel <= MM_MarkMapWordScanner::kernel_avx512; kernel++) {
+			if (!MM_MarkMapWordScanner::isKernelSupported(portLibrary, (MM_MarkMapWordScanner::Kernel)kernel)) {
+				continue;
+			}
+			MM_MarkMapWordScanner::FindNonEmptyWordFunction findNonEmptyWord = MM_MarkMapWordScanner::getKernelFunction((MM_MarkMapWordScanner::Kernel)kernel);
+
+			uintptr_t runs = 0;
+			uint64_t positionHash = 0;
+			uint64_t startTime = omrtime_hires_clock();
+			for (uintptr_t i = 0; i < ITERATIONS; i++) {
+				runs = walkMarkMap(findNonEmptyWord, markMap, markMapTop, &positionHash);
+			}
+			uint64_t elapsedMillis = omrtime_hires_delta(startTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MILLISECONDS);
+
+			if (MM_MarkMapWordScanner::kernel_scalar == kernel) {
+				expectedRuns = runs;
+				expectedPositionHash = positionHash;
+				scalarMillis = elapsedMillis;
+			} else if (expectedRuns != runs) {
+				fprintf(stderr, "%s kernel found %zu runs, scalar kernel found %zu\n", kernelNames[kernel], (size_t)runs, (size_t)expectedRuns);
+				result = -1;
+			} else if (expectedPositionHash != positionHash) {
+				fprintf(stderr, "%s kernel found runs ending at different words than the scalar kernel\n", kernelNames[kernel]);
+				result = -1;
+			}
+
+			printf("live=%4zu/1000 kernel=%-6s runs=%9zu time=%6llums speedup=%.2f\n",
+				(size_t)liveWordsPerThousand[density], kernelNames[kernel], (size_t)runs, (unsigned long long)elapsedMillis,
+				(0 == elapsedMillis) ? 0.0 : ((double)scalarMillis / (double)elapsedMillis));
+		}
+	}
+
+	omrmem_free_memory(markMap);
+
+	return result;
+}
@@ -0,0 +1,366 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 1991
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/*
+ * Microbenchmark for the sparse (off heap) large array data region.
+ *
+ * Large arrays are allocated and freed in a reserved region the way MM_SparseVirtualMemory manages it.
+ * Each cycle allocates arrays one after another, committing (and first touching, as the array is zeroed
+ * and filled) each one, reads random words of the live arrays and then frees them in a random order,
+ * as a collection would. Each free is decommitted either at once or in batches sorted by address with
+ * adjacent arrays decommitted together; what is left in the batch is decommitted at the end of the cycle.
+ * The region is backed by default pages, by default pages with allocations rounded and aligned to 2M
+ * so that transparent huge pages can back them, or by explicit 2M pages when the port library reports them.
+ *
+ * The allocate/free throughput, the number of decommit calls and, on Linux, the data TLB misses
+ * taken by the random reads are reported for each configuration.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(LINUX)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif /* defined(LINUX) */
+
+#include "omr.h"
+#include "omrport.h"
+#include "omrthread.h"
+
+#include "gcBenchmarks.hpp"
+
+#define TWO_MB ((uintptr_t)2 * 1024 * 1024)
+#define MAXIMUM_ARRAY_SIZE ((uintptr_t)16 * 1024 * 1024)
+#define ARRAYS_PER_CYCLE 48
+#define REGION_SIZE (MAXIMUM_ARRAY_SIZE * ARRAYS_PER_CYCLE)
+#define CYCLES 50
+#define READS_PER_CYCLE ((uintptr_t)256 * 1024)
+#define DECOMMIT_BATCH_BYTES ((uintptr_t)32 * 1024 * 1024)
+#define DECOMMIT_BATCH_MAXIMUM_RANGES 64
+
+/* array sizes allocated, in KB: from just over a 1M region to the maximum */
+static const uintptr_t arraySizesKB[] = { 1028, 2048, 3000, 6000, 8192, 16384 };
+
+typedef struct BenchmarkConfig {
+	const char *name;
+	bool explicitHugePages; /**< reserve the region with 2M pages */
+	uintptr_t granule; /**< allocation size and alignment, 0 for the page size */
+	uintptr_t decommitBatchBytes; /**< 0 to decommit each array as it is freed */
+} BenchmarkConfig;
+
+static const BenchmarkConfig configs[] = {
+	{ "default", false, 0, 0 },
+	{ "default-batched", false, 0, DECOMMIT_BATCH_BYTES },
+	{ "thp", false, TWO_MB, 0 },
+	{ "thp-batched", false, TWO_MB, DECOMMIT_BATCH_BYTES },
+	{ "2M-batched", true, TWO_MB, DECOMMIT_BATCH_BYTES },
+};
+
+typedef struct SparseArray {
+	uintptr_t address;
+	uintptr_t size; /**< committed size */
+} SparseArray;
+
+typedef struct SparseRegion {
+	J9PortVmemIdentifier identifier;
+	uintptr_t base;
+	uintptr_t pageSize;
+	uintptr_t granule;
+	uintptr_t decommitBatchBytes;
+	SparseArray arrays[ARRAYS_PER_CYCLE];
+	uintptr_t arrayCount;
+	SparseArray pending[DECOMMIT_BATCH_MAXIMUM_RANGES];
+	uintptr_t pendingCount;
+	uintptr_t pendingBytes;
+	uintptr_t decommitCalls;
+} SparseRegion;
+
+static uint64_t randomState = 0x2545F4914F6CDD1DULL;
+
+static uintptr_t
+nextRandom()
+{
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 7;
+	randomState ^= randomState << 17;
+	return (uintptr_t)randomState;
+}
+
+static int
+compareArrays(const void *left, const void *right)
+{
+	uintptr_t leftAddress = ((SparseArray *)left)->address;
+	uintptr_t rightAddress = ((SparseArray *)right)->address;
+	if (leftAddress < rightAddress) {
+		return -1;
+	}
+	return (leftAddress > rightAddress) ? 1 : 0;
+}
+
+/**
+ * Decommit the pending freed arrays, adjacent ones with a single call, as MM_SparseVirtualMemory does.
+ */
+static void
+decommitPending(OMRPortLibrary *portLibrary, SparseRegion *region)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+
+	J9_SORT(region->pending, region->pendingCount, sizeof(SparseArray), compareArrays);
+	uintptr_t index = 0;
+	while (index < region->pendingCount) {
+		uintptr_t rangeBase = region->pending[index].address;
+		uintptr_t rangeSize = region->pending[index].size;
+		index += 1;
+		while ((index < region->pendingCount) && ((rangeBase + rangeSize) == region->pending[index].address)) {
+			rangeSize += region->pending[index].size;
+			index += 1;
+		}
+		omrvmem_decommit_memory((void *)rangeBase, rangeSize, &region->identifier);
+		region->decommitCalls += 1;
+	}
+	region->pendingCount = 0;
+	region->pendingBytes = 0;
+}
+
+static void
+freeArray(OMRPortLibrary *portLibrary, SparseRegion *region, SparseArray *array)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+
+	if (0 == region->decommitBatchBytes) {
+		omrvmem_decommit_memory((void *)array->address, array->size, &region->identifier);
+		region->decommitCalls += 1;
+	} else {
+		region->pending[region->pendingCount] = *array;
+		region->pendingCount += 1;
+		region->pendingBytes += array->size;
+		if ((DECOMMIT_BATCH_MAXIMUM_RANGES == region->pendingCount) || (region->pendingBytes >= region->decommitBatchBytes)) {
+			decommitPending(portLibrary, region);
+		}
+	}
+}
+
+static bool
+allocateArray(OMRPortLibrary *portLibrary, SparseRegion *region, uintptr_t address, uintptr_t size, SparseArray *array)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	uintptr_t granule = (0 == region->granule) ? region->pageSize : region->granule;
+	uintptr_t committedSize = (size + granule - 1) & ~(granule - 1);
+
+	if (NULL == omrvmem_commit_memory((void *)address, committedSize, &region->identifier)) {
+		return false;
+	}
+	/* first touch, as the array is zeroed and filled */
+	for (uintptr_t offset = 0; offset < size; offset += 4096) {
+		*(uintptr_t *)(address + offset) = offset;
+	}
+	array->address = address;
+	array->size = committedSize;
+	return true;
+}
+
+#if defined(LINUX)
+static int
+openTLBMissCounter()
+{
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HW_CACHE;
+	attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif /* defined(LINUX) */
+
+/**
+ * Read random words of the live arrays, counting data TLB misses with tlbCounter if it is not -1.
+ */
+static uintptr_t
+readLiveArrays(SparseRegion *region, int tlbCounter)
+{
+	uintptr_t sum = 0;
+
+#if defined(LINUX)
+	if (-1 != tlbCounter) {
+		ioctl(tlbCounter, PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif /* defined(LINUX) */
+
+	for (uintptr_t i = 0; i < READS_PER_CYCLE; i++) {
+		SparseArray *array = &region->arrays[nextRandom() % region->arrayCount];
+		uintptr_t offset = (nextRandom() % array->size) & ~(sizeof(uintptr_t) - 1);
+		sum += *(volatile uintptr_t *)(array->address + offset);
+	}
+
+#if defined(LINUX)
+	if (-1 != tlbCounter) {
+		ioctl(tlbCounter, PERF_EVENT_IOC_DISABLE, 0);
+	}
+#endif /* defined(LINUX) */
+
+	return sum;
+}
+
+/**
+ * Allocate and free arrays in a region reserved for the configuration.
+ * @return 0 on success, -1 if the region could not be committed
+ */
+static int
+runConfig(OMRPortLibrary *portLibrary, const BenchmarkConfig *config, uintptr_t *checksum)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	uintptr_t *pageSizes = omrvmem_supported_page_sizes();
+	uintptr_t *pageFlags = omrvmem_supported_page_flags();
+	uintptr_t pageSize = pageSizes[0];
+	uintptr_t pageFlag = pageFlags[0];
+
+	if (config->explicitHugePages) {
+		pageSize = 0;
+		for (uintptr_t i = 0; 0 != pageSizes[i]; i++) {
+			if (TWO_MB == pageSizes[i]) {
+				pageSize = pageSizes[i];
+				pageFlag = pageFlags[i];
+			}
+		}
+		if (0 == pageSize) {
+			printf("config=%-16s skipped, 2M pages are not supported\n", config->name);
+			return 0;
+		}
+	}
+
+	SparseRegion *region = (SparseRegion *)omrmem_allocate_memory(sizeof(SparseRegion), OMRMEM_CATEGORY_MM);
+	if (NULL == region) {
+		return -1;
+	}
+	memset(region, 0, sizeof(SparseRegion));
+
+	J9PortVmemParams params;
+	omrvmem_vmem_params_init(&params);
+	params.byteAmount = REGION_SIZE;
+	params.mode = OMRPORT_VMEM_MEMORY_MODE_READ | OMRPORT_VMEM_MEMORY_MODE_WRITE;
+	params.pageSize = pageSize;
+	params.pageFlags = pageFlag;
+	params.alignmentInBytes = OMR_MAX(pageSize, config->granule);
+	params.options |= OMRPORT_VMEM_STRICT_PAGE_SIZE;
+	params.category = OMRMEM_CATEGORY_MM;
+	region->base = (uintptr_t)omrvmem_reserve_memory_ex(&region->identifier, &params);
+	if (0 == region->base) {
+		printf("config=%-16s skipped, the region could not be reserved\n", config->name);
+		omrmem_free_memory(region);
+		return 0;
+	}
+	region->pageSize = omrvmem_get_page_size(&region->identifier);
+	region->granule = config->granule;
+	region->decommitBatchBytes = config->decommitBatchBytes;
+
+	int tlbCounter = -1;
+#if defined(LINUX)
+	tlbCounter = openTLBMissCounter();
+#endif /* defined(LINUX) */
+
+	int result = 0;
+	uint64_t allocateFreeMicros = 0;
+	uint64_t readMicros = 0;
+	for (uintptr_t cycle = 0; (cycle < CYCLES) && (0 == result); cycle++) {
+		uint64_t startTime = omrtime_hires_clock();
+		uintptr_t top = region->base;
+		region->arrayCount = 0;
+		for (uintptr_t i = 0; i < ARRAYS_PER_CYCLE; i++) {
+			uintptr_t size = arraySizesKB[nextRandom() % (sizeof(arraySizesKB) / sizeof(arraySizesKB[0]))] * 1024;
+			if (!allocateArray(portLibrary, region, top, size, &region->arrays[i])) {
+				fprintf(stderr, "config=%s failed to commit %zu bytes\n", config->name, (size_t)size);
+				result = -1;
+				break;
+			}
+			top += region->arrays[i].size;
+			region->arrayCount += 1;
+		}
+		allocateFreeMicros += omrtime_hires_delta(startTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+
+		if (0 != region->arrayCount) {
+			uint64_t readStartTime = omrtime_hires_clock();
+			*checksum += readLiveArrays(region, tlbCounter);
+			readMicros += omrtime_hires_delta(readStartTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+		}
+
+		startTime = omrtime_hires_clock();
+		/* free in a random order */
+		for (uintptr_t remaining = region->arrayCount; remaining > 0; remaining--) {
+			uintptr_t index = nextRandom() % remaining;
+			freeArray(portLibrary, region, &region->arrays[index]);
+			region->arrays[index] = region->arrays[remaining - 1];
+		}
+		if (0 != region->pendingCount) {
+			decommitPending(portLibrary, region);
+		}
+		allocateFreeMicros += omrtime_hires_delta(startTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+	}
+
+	if (0 == result) {
+		char tlbMissesText[32];
+		omrstr_printf(tlbMissesText, sizeof(tlbMissesText), "n/a");
+#if defined(LINUX)
+		uint64_t tlbMisses = 0;
+		if ((-1 != tlbCounter) && (sizeof(tlbMisses) == read(tlbCounter, &tlbMisses, sizeof(tlbMisses)))) {
+			omrstr_printf(tlbMissesText, sizeof(tlbMissesText), "%llu", (unsigned long long)tlbMisses);
+		}
+#endif /* defined(LINUX) */
+		uintptr_t operations = CYCLES * ARRAYS_PER_CYCLE * 2;
+		printf("config=%-16s page=%8zu allocs+frees/s=%9.0f decommits=%6zu reads=%6llums dTLB-misses=%s\n",
+			config->name, (size_t)region->pageSize,
+			(0 == allocateFreeMicros) ? 0.0 : ((double)operations * 1000000.0 / (double)allocateFreeMicros),
+			(size_t)region->decommitCalls, (unsigned long long)(readMicros / 1000), tlbMissesText);
+	}
+
+#if defined(LINUX)
+	if (-1 != tlbCounter) {
+		close(tlbCounter);
+	}
+#endif /* defined(LINUX) */
+	omrvmem_free_memory((void *)region->base, REGION_SIZE, &region->identifier);
+	omrmem_free_memory(region);
+
+	return result;
+}
+
+int
+sparseHeapBenchmark(OMRPortLibrary *portLibrary, int argc, char *argv[])
+{
+	int result = 0;
+	uintptr_t checksum = 0;
+	for (uintptr_t config = 0; config < sizeof(configs) / sizeof(configs[0]); config++) {
+		if (0 != runConfig(portLibrary, &configs[config], &checksum)) {
+			result = -1;
+		}
+	}
+	printf("checksum=%zx\n", (size_t)checksum);
+
+
+	return result;
+}
@@ -25,6 +25,7 @@
 #include <vector>
 #include <iterator>
 #include <numeric>
+#include <string>
 #include <stdio.h>
 
 #include "pugixml.hpp"
@@ -33,6 +34,8 @@
 #include "omrport.h"
 #include "omrthread.h"
 
+#include "VerboseBinaryDecoder.hpp"
+
 const char* XPATH_GET_ALL_MARK_TIME = "/verbosegc/gc-op[@type='mark']";
 const char* XPATH_GET_ALL_SWEEP_TIME = "/verbosegc/gc-op[@type='sweep']";
 const char* XPATH_GET_ALL_EXPAND_TIME = "/verbosegc/heap-resize[@type='expand']";
@@ -42,6 +45,7 @@ const char* VERBOSE_GC_FILE_PREFIX = "VerboseGC";
 
 double getAvg(std::vector<double> v);
 void analyze(char* fileName, OMRPortLibrary portLibrary);
+pugi::xml_parse_result loadVerboseLog(pugi::xml_document *doc, char* fileName, OMRPortLibrary *portLibrary);
 
 int main(void)
 {
@@ -102,6 +106,38 @@ getAvg(std::vector<double> v)
 	return avg;
 }
 
+static void
+appendDecodedText(void *userData, const char *text, uintptr_t length)
+{
+	((std::string *)userData)->append(text, length);
+}
+
+/**
+ * Load a verbose GC log, decoding it to XML first if it was written with -Xgc:binaryLogging.
+ */
+pugi::xml_parse_result
+loadVerboseLog(pugi::xml_document *doc, char* fileName, OMRPortLibrary *portLibrary)
+{
+	if (!MM_VerboseBinaryDecoder::isBinaryFile(portLibrary, fileName)) {
+		return doc->load_file(fileName);
+	}
+
+	pugi::xml_parse_result result;
+	std::string text;
+	MM_VerboseBinaryDecoder *decoder = MM_VerboseBinaryDecoder::newInstance(portLibrary, MM_VerboseBinaryDecoder::OUTPUT_XML, appendDecodedText, &text);
+	if (NULL == decoder) {
+		result.status = pugi::status_out_of_memory;
+	} else {
+		if (decoder->decodeFile(fileName)) {
+			result = doc->load_buffer(text.data(), text.size());
+		} else {
+			result.status = pugi::status_io_error;
+		}
+		decoder->kill();
+	}
+	return result;
+}
+
 void
 analyze(char* fileName, OMRPortLibrary portLibrary)
 {
@@ -132,7 +168,7 @@ analyze(char* fileName, OMRPortLibrary portLibrary)
 	double avgGCDuration = 0;
 
 	pugi::xml_document doc;
-	pugi::xml_parse_result result = doc.load_file(fileName);
+	pugi::xml_parse_result result = loadVerboseLog(&doc, fileName, &portLibrary);
 
 	OMRPORT_ACCESS_FROM_OMRPORT(&portLibrary);
 	if(!result) {
@@ -45,5 +45,6 @@ all: test
 omr_perfgctest:
 	./omrgctest --gtest_filter="perfTest*" -keepVerboseLog
 	./omrperfgctest
+	./omrperfgcbench
 
 .PHONY: all test omr_perfgctest 
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * Copyright IBM Corp. and others 2016
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] https://openjdk.org/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0-only WITH Classpath-exception-2.0 OR GPL-2.0-only WITH OpenJDK-assembly-exception-1.0
+ *******************************************************************************/
+
+/**
+ * Offline converter for binary verbose GC logs (-Xgc:binaryLogging).
+ *
+ * Usage: omrverbosedecode [-csv] <binary log> [<output file>]
+ *
+ * Writes the XML the log was encoded from, or with -csv one row per attribute, to the output
+ * file or to stdout. The log is decoded in fixed size pieces, so logs of any size can be converted.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include "omr.h"
+#include "omrport.h"
+#include "omrthread.h"
+
+#include "VerboseBinaryDecoder.hpp"
+
+typedef struct DecodeOutput {
+	OMRPortLibrary *portLibrary;
+	intptr_t fd;
+	bool failed;
+} DecodeOutput;
+
+static void
+writeDecodedText(void *userData, const char *text, uintptr_t length)
+{
+	DecodeOutput *output = (DecodeOutput *)userData;
+	OMRPORT_ACCESS_FROM_OMRPORT(output->portLibrary);
+
+	if (!output->failed && ((intptr_t)length != omrfile_write(output->fd, text, (intptr_t)length))) {
+		output->failed = true;
+	}
+}
+
+int
+main(int argc, char **argv)
+{
+	intptr_t rc = 0;
+	int result = 0;
+	OMRPortLibrary portLibrary;
+	MM_VerboseBinaryDecoder::OutputFormat format = MM_VerboseBinaryDecoder::OUTPUT_XML;
+	int argIndex = 1;
+
+	if ((argIndex < argc) && (0 == strcmp(argv[argIndex], "-csv"))) {
+		format = MM_VerboseBinaryDecoder::OUTPUT_CSV;
+		argIndex += 1;
+	}
+	if ((argIndex >= argc) || ((argc - argIndex) > 2)) {
+		fprintf(stderr, "Usage: %s [-csv] <binary verbose GC log> [<output file>]\n", argv[0]);
+		return 1;
+	}
+	const char *inputFileName = argv[argIndex];
+	const char *outputFileName = ((argIndex + 1) < argc) ? argv[argIndex + 1] : NULL;
+
+	rc = omrthread_attach_ex(NULL, J9THREAD_ATTR_DEFAULT);
+	if (0 != rc) {
+		fprintf(stderr, "omrthread_attach_ex(NULL, J9THREAD_ATTR_DEFAULT) failed, rc=%d\n", (int)rc);
+		return -1;
+	}
+
+	rc = omrport_init_library(&portLibrary, sizeof(OMRPortLibrary));
+	if (0 != rc) {
+		fprintf(stderr, "omrport_init_library(&portLibrary, sizeof(OMRPortLibrary)), rc=%d\n", (int)rc);
+		return -1;
+	}
+
+	OMRPORT_ACCESS_FROM_OMRPORT(&portLibrary);
+
+	DecodeOutput output = { &portLibrary, OMRPORT_TTY_OUT, false };
+	if (NULL != outputFileName) {
+		output.fd = omrfile_open(outputFileName, EsOpenWrite | EsOpenCreate | EsOpenTruncate, 0666);
+	}
+
+	if (-1 == output.fd) {
+		omrtty_err_printf("Failed to open output file : %s\n", outputFileName);
+		result = 1;
+	} else if (!MM_VerboseBinaryDecoder::isBinaryFile(&portLibrary, inputFileName)) {
+		omrtty_err_printf("Not a binary verbose GC log : %s\n", inputFileName);
+		result = 1;
+	} else {
+		MM_VerboseBinaryDecoder *decoder = MM_VerboseBinaryDecoder::newInstance(&portLibrary, format, writeDecodedText, &output);
+		if (NULL == decoder) {
+			omrtty_err_printf("Failed to allocate the decoder\n");
+			result = 1;
+		} else {
+			if (!decoder->decodeFile(inputFileName)) {
+				omrtty_err_printf("Error decoding file : %s (the log may be truncated or corrupt)\n", inputFileName);
+				result = 1;
+			}
+			decoder->kill();
+		}
+		if (output.failed) {
+			omrtty_err_printf("Error writing decoded output\n");
+			result = 1;
+		}
+	}
+
+	if ((NULL != outputFileName) && (-1 != output.fd)) {
+		omrfile_close(output.fd);
+	}
+
+	portLibrary.port_shutdown_library(&portLibrary);
+	omrthread_detach(NULL);
+
+	return result;
+}